@@ -337,7 +337,7 @@ public:
 	/**
 	\brief Sets the environment ID for this actor.
 
-	The environment ID is an extra built-in filter group for the GPU broadphase. Actors will only collide with each-other if they have the
+	The environment ID is an extra built-in filter group for the GPU and ABP broadphases. Actors will only collide with each-other if they have the
 	same environment ID.
 	
 	The default value is PX_INVALID_U32. Actors with this ID will collide with other actors, regardless of which environment they are a part of.
@@ -348,7 +348,7 @@ public:
 
 	<b>Default:</b> PX_INVALID_U32
 
-	\note	This is not available for CPU broadphases.
+	\note	Among CPU broadphases this is only supported by PxBroadPhaseType::eABP and PxBroadPhaseType::ePABP.
 
 	\param[in]	envID	 Environment ID for this actor.
 	\return True if success.
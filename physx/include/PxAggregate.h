@@ -230,7 +230,7 @@ public:
 	/**
 	\brief Sets the environment ID for this aggregate.
 
-	The environment ID is an extra built-in filter group for the GPU broadphase. Aggregates will only collide with actors or aggregates that
+	The environment ID is an extra built-in filter group for the GPU and ABP broadphases. Aggregates will only collide with actors or aggregates that
 	have the same environment ID.
 	
 	The default value is PX_INVALID_U32. Aggregates with this ID will collide with other actors or aggregates, regardless of which environment
@@ -245,7 +245,7 @@ public:
 
 	<b>Default:</b> PX_INVALID_U32
 
-	\note	This is not available for CPU broadphases.
+	\note	Among CPU broadphases this is only supported by PxBroadPhaseType::eABP and PxBroadPhaseType::ePABP.
 
 	\param[in]	envID	 Environment ID for this aggregate.
 	\return True if success.
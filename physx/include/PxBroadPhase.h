@@ -63,6 +63,10 @@ namespace physx
 	ePABP is a parallel implementation of ABP. It can often be the fastest (CPU) broadphase, but it
 	can use more memory than ABP.
 
+	eABP and ePABP are the only CPU broadphases supporting environment IDs (see PxActor::setEnvironmentID()).
+	Each environment is pruned separately, in parallel tasks for ePABP, so the cost grows with the number of
+	objects per environment rather than with the total number of objects in the scene.
+
 	eGPU is a GPU implementation of the incremental sweep and prune approach. Additionally, it uses a ABP-style
 	initial pair generation approach to avoid large spikes when inserting shapes. It not only has the advantage 
 	of traditional SAP approch which is good for when many objects are sleeping, but due to being fully parallel, 
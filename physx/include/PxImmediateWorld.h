@@ -0,0 +1,398 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_IMMEDIATE_WORLD_H
+#define PX_IMMEDIATE_WORLD_H
+
+#include "PxImmediateMode.h"
+#include "PxSceneDesc.h"
+#include "PxConstraint.h"
+#include "common/PxTolerancesScale.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxCpuDispatcher;
+
+#if !PX_DOXYGEN
+namespace immediate
+{
+#endif
+
+	typedef PxU32 PxImmediateBodyHandle;		//!< Handle of a body in a PxImmediateWorld
+	typedef PxU32 PxImmediateJointHandle;		//!< Handle of a joint in a PxImmediateWorld
+	#define PX_IMMEDIATE_INVALID_HANDLE	0xffffffff	//!< Invalid body or joint handle
+
+	/**
+	\brief Descriptor for PxImmediateWorld.
+
+	\see PxCreateImmediateWorld
+	*/
+	class PxImmediateWorldDesc
+	{
+		public:
+
+		/**
+		\brief Sets the distance-based parameters from a tolerances scale, with the same defaults as PxSceneDesc.
+		\param	[in] scale	The tolerances scale
+		*/
+		PxImmediateWorldDesc(const PxTolerancesScale& scale) :
+			gravity						(0.0f),
+			solverType					(PxSolverType::ePGS),
+			cpuDispatcher				(NULL),
+			nbPositionIterations		(4),
+			nbVelocityIterations		(1),
+			contactDistance				(0.02f * scale.length),
+			meshContactMargin			(0.01f * scale.length),
+			toleranceLength				(scale.length),
+			bounceThresholdVelocity		(0.2f * scale.speed),
+			frictionOffsetThreshold		(0.04f * scale.length),
+			frictionCorrelationDistance	(0.025f * scale.length),
+			nbPairsPerTask				(256),
+			nbBodiesPerBatch			(128),
+			contextID					(0)
+		{
+		}
+
+		PxVec3				gravity;					//!< Gravity applied to dynamic bodies
+		PxSolverType::Enum	solverType;					//!< PGS or TGS
+		PxCpuDispatcher*	cpuDispatcher;				//!< Dispatcher used to run narrowphase and island solves in parallel, or NULL for single-threaded stepping
+		PxU32				nbPositionIterations;		//!< Solver position iterations, range [1, 255]
+		PxU32				nbVelocityIterations;		//!< Solver velocity iterations, range [0, 255]
+		PxReal				contactDistance;			//!< Distance at which contacts begin to be generated. Also used to inflate the broadphase bounds.
+		PxReal				meshContactMargin;			//!< Mesh contact margin, see PxGenerateContacts
+		PxReal				toleranceLength;			//!< Tolerance length, see PxGenerateContacts
+		PxReal				bounceThresholdVelocity;	//!< Relative velocity below which contacts do not bounce, see PxSceneDesc::bounceThresholdVelocity
+		PxReal				frictionOffsetThreshold;	//!< See PxSceneDesc::frictionOffsetThreshold
+		PxReal				frictionCorrelationDistance;//!< See PxSceneDesc::frictionCorrelationDistance
+
+		/**
+		\brief Number of broadphase pairs processed by each narrowphase task.
+
+		Pairs are always split in the same chunks regardless of the number of worker threads, so results do not depend on the dispatcher.
+		*/
+		PxU32				nbPairsPerTask;
+
+		/**
+		\brief Minimum number of bodies per solver batch.
+
+		Independent islands are merged in batches of at least this many bodies (except the last one), and each batch is solved by one task.
+		*/
+		PxU32				nbBodiesPerBatch;
+
+		PxU64				contextID;					//!< Context ID for the profiler and the broadphase
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!gravity.isFinite())
+				return false;
+			if(!nbPositionIterations || nbPositionIterations>255 || nbVelocityIterations>255)
+				return false;
+			if(contactDistance<0.0f || meshContactMargin<0.0f || toleranceLength<=0.0f)
+				return false;
+			if(bounceThresholdVelocity<=0.0f || frictionOffsetThreshold<0.0f || frictionCorrelationDistance<0.0f)
+				return false;
+			if(!nbPairsPerTask || !nbBodiesPerBatch)
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief Descriptor for a body of a PxImmediateWorld.
+
+	Each body has a single shape. The body pose is the center-of-mass frame: the inertia tensor is diagonal in that frame, and the shape is placed
+	relative to it with shapeLocalPose. Bodies with a zero inverse mass are static.
+
+	\see PxImmediateWorld::addBody
+	*/
+	struct PxImmediateBodyDesc
+	{
+		PxImmediateBodyDesc() :
+			geometry				(NULL),
+			pose					(PxIdentity),
+			shapeLocalPose			(PxIdentity),
+			linearVelocity			(0.0f),
+			angularVelocity			(0.0f),
+			invMass					(0.0f),
+			invInertia				(0.0f),
+			linearDamping			(0.0f),
+			angularDamping			(0.05f),
+			maxLinearVelocitySq		(PX_MAX_F32),
+			maxAngularVelocitySq	(100.0f * 100.0f),
+			maxDepenetrationVelocity(PX_MAX_F32),
+			maxContactImpulse		(PX_MAX_F32),
+			staticFriction			(0.5f),
+			dynamicFriction			(0.5f),
+			restitution				(0.0f),
+			userData				(NULL)
+		{
+		}
+
+		const PxGeometry*	geometry;					//!< The body's geometry. It is copied, but referenced meshes must outlive the body.
+		PxTransform			pose;						//!< World pose of the body, i.e. of its center of mass
+		PxTransform			shapeLocalPose;				//!< Pose of the geometry relative to the body
+		PxVec3				linearVelocity;				//!< Initial linear velocity
+		PxVec3				angularVelocity;			//!< Initial angular velocity, in world space
+		PxReal				invMass;					//!< Inverse mass. Zero for static bodies.
+		PxVec3				invInertia;					//!< Mass-space inverse inertia diagonal
+		PxReal				linearDamping;				//!< Linear damping coefficient
+		PxReal				angularDamping;				//!< Angular damping coefficient
+		PxReal				maxLinearVelocitySq;		//!< Squared maximum linear velocity
+		PxReal				maxAngularVelocitySq;		//!< Squared maximum angular velocity
+		PxReal				maxDepenetrationVelocity;	//!< Maximum de-penetration velocity
+		PxReal				maxContactImpulse;			//!< Maximum contact impulse
+		PxReal				staticFriction;				//!< Static friction coefficient, averaged with the other body's
+		PxReal				dynamicFriction;			//!< Dynamic friction coefficient, averaged with the other body's
+		PxReal				restitution;				//!< Restitution coefficient, averaged with the other body's
+		void*				userData;					//!< User data
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!geometry || !pose.isSane() || !shapeLocalPose.isSane())
+				return false;
+			if(!linearVelocity.isFinite() || !angularVelocity.isFinite() || !invInertia.isFinite())
+				return false;
+			if(!PxIsFinite(invMass) || invMass<0.0f || invInertia.minElement()<0.0f)
+				return false;
+			if(staticFriction<0.0f || dynamicFriction<0.0f || restitution<0.0f || restitution>1.0f)
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief Descriptor for a joint of a PxImmediateWorld.
+
+	The joint is defined by a solver prep function and its constant block, as for PxCreateJointConstraintsWithImmediateShaders. The constant
+	block is not copied and must outlive the joint. Joint frames stored in the constant block are relative to the bodies' poses.
+
+	\see PxImmediateWorld::addJoint
+	*/
+	struct PxImmediateJointDesc
+	{
+		PxImmediateJointDesc() :
+			body0				(PX_IMMEDIATE_INVALID_HANDLE),
+			body1				(PX_IMMEDIATE_INVALID_HANDLE),
+			minResponseThreshold(0.0f)
+		{
+			constraint.prep = NULL;
+			constraint.constantBlock = NULL;
+		}
+
+		PxImmediateBodyHandle	body0;					//!< First body, or PX_IMMEDIATE_INVALID_HANDLE for the world frame
+		PxImmediateBodyHandle	body1;					//!< Second body, or PX_IMMEDIATE_INVALID_HANDLE for the world frame
+		PxImmediateConstraint	constraint;				//!< Solver prep function and constant block
+		PxConstraintFlags		flags;					//!< Only eDISABLE_PREPROCESSING, eIMPROVED_SLERP and eDRIVE_LIMITS_ARE_FORCES are used
+		PxReal					minResponseThreshold;	//!< See PxConstraint::setMinResponseThreshold
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!constraint.prep || body0 == body1)
+				return false;
+			return PxIsFinite(minResponseThreshold) && minResponseThreshold>=0.0f;
+		}
+	};
+
+	/**
+	\brief Simulation statistics of a PxImmediateWorld, for the last call to PxImmediateWorld::step.
+	*/
+	struct PxImmediateWorldStats
+	{
+		PxU32	nbBroadPhasePairs;	//!< Number of overlapping pairs reported by the broadphase
+		PxU32	nbTouchingPairs;	//!< Number of pairs with contacts
+		PxU32	nbContacts;			//!< Total number of contacts
+		PxU32	nbIslands;			//!< Number of islands
+		PxU32	nbSolverBatches;	//!< Number of solver batches, i.e. of island groups solved by one task
+	};
+
+	/**
+	\brief A self-contained rigid body world built on the immediate mode functions.
+
+	The world owns the body data (stored as structure-of-arrays, indexed by body handle), a standalone broadphase, and the persistent contact
+	caches and friction patches of overlapping pairs. Each step runs collision detection, groups bodies in islands, and solves the islands in
+	batches on the world's CPU dispatcher. It is a lean alternative to PxScene when the high-level features (scene queries, events, filtering,
+	sleeping, CCD, articulations) are not needed.
+
+	\note Not thread-safe. No function should be called while PxImmediateWorld::step is running.
+
+	\see PxCreateImmediateWorld
+	*/
+	class PxImmediateWorld
+	{
+		protected:
+											PxImmediateWorld()	{}
+		virtual								~PxImmediateWorld()	{}
+
+		public:
+		/**
+		\brief Releases the world.
+		*/
+		virtual	void						release()	= 0;
+
+		/**
+		\brief Adds a body to the world.
+		\param	[in] desc	The body descriptor
+		\return	The body handle, or PX_IMMEDIATE_INVALID_HANDLE if the descriptor is invalid.
+		*/
+		virtual	PxImmediateBodyHandle		addBody(const PxImmediateBodyDesc& desc)	= 0;
+
+		/**
+		\brief Removes a body from the world. Joints connected to the body are removed as well.
+
+		The handle can be reused by bodies added after the next step.
+
+		\param	[in] body	The body handle
+		*/
+		virtual	void						removeBody(PxImmediateBodyHandle body)	= 0;
+
+		/**
+		\brief Adds a joint to the world.
+		\param	[in] desc	The joint descriptor
+		\return	The joint handle, or PX_IMMEDIATE_INVALID_HANDLE if the descriptor is invalid.
+		*/
+		virtual	PxImmediateJointHandle		addJoint(const PxImmediateJointDesc& desc)	= 0;
+
+		/**
+		\brief Removes a joint from the world.
+		\param	[in] joint	The joint handle
+		*/
+		virtual	void						removeJoint(PxImmediateJointHandle joint)	= 0;
+
+		/**
+		\brief Returns the number of bodies in the world.
+		*/
+		virtual	PxU32						getNbBodies()	const	= 0;
+
+		/**
+		\brief Returns the number of joints in the world.
+		*/
+		virtual	PxU32						getNbJoints()	const	= 0;
+
+		/**
+		\brief Returns the size of the body arrays, i.e. one more than the largest body handle ever returned.
+		\see getPoses getLinearVelocities getAngularVelocities
+		*/
+		virtual	PxU32						getBodyCapacity()	const	= 0;
+
+		/**
+		\brief Returns the body poses, indexed by body handle. Entries for removed bodies are undefined.
+
+		The returned pointer is invalidated by addBody.
+		*/
+		virtual	const PxTransform*			getPoses()	const	= 0;
+
+		/**
+		\brief Returns the body linear velocities, indexed by body handle. Entries for removed bodies are undefined.
+
+		The returned pointer is invalidated by addBody.
+		*/
+		virtual	const PxVec3*				getLinearVelocities()	const	= 0;
+
+		/**
+		\brief Returns the body angular velocities in world space, indexed by body handle. Entries for removed bodies are undefined.
+
+		The returned pointer is invalidated by addBody.
+		*/
+		virtual	const PxVec3*				getAngularVelocities()	const	= 0;
+
+		/**
+		\brief Teleports a body.
+		\param	[in] body	The body handle
+		\param	[in] pose	The new pose
+		*/
+		virtual	void						setPose(PxImmediateBodyHandle body, const PxTransform& pose)	= 0;
+
+		/**
+		\brief Sets the velocities of a dynamic body.
+		\param	[in] body				The body handle
+		\param	[in] linearVelocity		The new linear velocity
+		\param	[in] angularVelocity	The new angular velocity, in world space
+		*/
+		virtual	void						setVelocities(PxImmediateBodyHandle body, const PxVec3& linearVelocity, const PxVec3& angularVelocity)	= 0;
+
+		/**
+		\brief Returns the user data of a body.
+		\param	[in] body	The body handle
+		*/
+		virtual	void*						getUserData(PxImmediateBodyHandle body)	const	= 0;
+
+		/**
+		\brief Sets the gravity.
+		\param	[in] gravity	The new gravity
+		*/
+		virtual	void						setGravity(const PxVec3& gravity)	= 0;
+
+		/**
+		\brief Returns the gravity.
+		*/
+		virtual	PxVec3						getGravity()	const	= 0;
+
+		/**
+		\brief Advances the simulation by dt. The call blocks until the step is complete.
+		\param	[in] dt	The timestep
+		*/
+		virtual	void						step(PxReal dt)	= 0;
+
+		/**
+		\brief Returns the statistics of the last step.
+		\param	[out] stats	The statistics
+		*/
+		virtual	void						getStats(PxImmediateWorldStats& stats)	const	= 0;
+	};
+
+	/**
+	\brief Creates a PxImmediateWorld.
+
+	The foundation must have been created. PxPhysics is not needed.
+
+	\param	[in] desc	The world descriptor
+	\return	The new world, or NULL if the descriptor is invalid.
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API PxImmediateWorld* PxCreateImmediateWorld(const PxImmediateWorldDesc& desc);
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#endif
@@ -133,9 +133,11 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "geometry/PxHeightFieldFlag.h"
 #include "geometry/PxHeightFieldGeometry.h"
 #include "geometry/PxHeightFieldSample.h"
+#include "geometry/PxHeightFieldTileLoader.h"
 #include "geometry/PxMeshQuery.h"
 #include "geometry/PxMeshScale.h"
 #include "geometry/PxPlaneGeometry.h"
+#include "geometry/PxRayPacket.h"
 #include "geometry/PxSimpleTriangleMesh.h"
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxTriangle.h"
@@ -173,6 +175,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "PxPBDMaterial.h"
 #include "PxPhysics.h"
 #include "PxPhysXConfig.h"
+#include "PxQueryCandidateCache.h"
 #include "PxQueryFiltering.h"
 #include "PxQueryReport.h"
 #include "PxRigidActor.h"
@@ -202,6 +205,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "cooking/Pxc.h"
 #include "cooking/PxConvexMeshDesc.h"
 #include "cooking/PxCooking.h"
+#include "cooking/PxCookingCache.h"
 #include "cooking/PxTriangleMeshDesc.h"
 #include "cooking/PxBVH33MidphaseDesc.h"
 #include "cooking/PxBVH34MidphaseDesc.h"
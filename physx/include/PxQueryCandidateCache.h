@@ -0,0 +1,131 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_QUERY_CANDIDATE_CACHE_H
+#define PX_QUERY_CANDIDATE_CACHE_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Temporally coherent candidate cache for scene queries that repeat every frame.
+
+Many queries are issued each frame with nearly the same parameters, e.g. wheel raycasts, AI sight lines or camera collision
+sweeps. For such queries the set of static shapes that can possibly be hit barely changes from one frame to the next.
+
+A candidate cache stores, for each caller-supplied query ID, the static shapes whose bounds touch an inflated version of
+the query's bounds. The next query with the same ID reuses that candidate set instead of traversing the static pruner, as long
+as:
+- the query's bounds are still contained in the inflated bounds captured when the set was gathered, and
+- the static pruner did not change since then (see PxSceneQuerySystemBase::getStaticTimestamp()).
+
+Otherwise the candidates are gathered again from the static pruner, using the new query bounds. Results are the same as for
+regular queries: filtering and hit processing are not cached, only the static traversal is. Dynamic objects move every frame,
+so the dynamic and compound pruners are always traversed as usual.
+
+To use the cache, pass a PxQueryCache referencing it and a query ID to the scene query functions. Query IDs are arbitrary
+values chosen by the caller; the same ID should be used for the same logical query from frame to frame.
+
+\note A candidate cache is not thread safe. Queries using the same cache must not run concurrently. Use one cache per thread
+if queries are issued from multiple threads.
+\note The cache is only used for queries that include static objects (PxQueryFlag::eSTATIC), and whose bounds are finite
+(for example raycasts with a finite maximum distance).
+\note The cache is ignored by custom scene query systems (see PxCustomSceneQuerySystem).
+
+\see PxCreateQueryCandidateCache PxQueryCache
+*/
+class PxQueryCandidateCache
+{
+public:
+
+	/**
+	\brief Releases the cache.
+	*/
+	virtual	void	release()	= 0;
+
+	/**
+	\brief Discards the candidates stored for a given query ID.
+
+	The next query using this ID gathers its candidates again.
+
+	\param[in]	queryID	The query ID
+	*/
+	virtual	void	invalidate(PxU32 queryID)	= 0;
+
+	/**
+	\brief Discards all stored candidates.
+
+	Releases the memory used by the cache entries.
+	*/
+	virtual	void	invalidateAll()	= 0;
+
+	/**
+	\brief Returns the number of queries that reused their cached candidates.
+
+	\return	Number of cache hits since the cache was created or the statistics were reset.
+	*/
+	virtual	PxU32	getNbHits()		const	= 0;
+
+	/**
+	\brief Returns the number of queries that had to gather their candidates again.
+
+	\return	Number of cache misses since the cache was created or the statistics were reset.
+	*/
+	virtual	PxU32	getNbMisses()	const	= 0;
+
+	/**
+	\brief Resets the hit and miss counters.
+	*/
+	virtual	void	resetStats()	= 0;
+
+protected:
+	virtual	~PxQueryCandidateCache()	{}
+};
+
+/**
+\brief Creates a scene query candidate cache.
+
+\param[in]	inflation	Distance by which the query bounds are inflated when gathering candidates. Larger values let
+						queries move further before the candidates need to be gathered again, at the cost of larger
+						candidate sets. Must be positive.
+\return	Newly created cache, or NULL if the parameters are invalid.
+
+\see PxQueryCandidateCache PxQueryCache
+*/
+PX_C_EXPORT PX_PHYSX_CORE_API PxQueryCandidateCache* PxCreateQueryCandidateCache(PxReal inflation);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
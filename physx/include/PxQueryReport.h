@@ -42,6 +42,7 @@ namespace physx
 
 class PxShape;
 class PxRigidActor;
+class PxQueryCandidateCache;
 
 /**
 \brief Combines a shape pointer and the actor the shape belongs to into one memory location.
@@ -255,23 +256,35 @@ when deleting shapes to invalidate cached references.
 
 The faceIndex field is an additional hint for a mesh or height field which is not currently used.
 
-\see PxScene.raycast
+The cache can also (or instead) reference a PxQueryCandidateCache and a query ID. In that case the static candidates found
+by the previous query with the same ID are reused when possible, see PxQueryCandidateCache. The shape/actor pair is optional
+when a candidate cache is used. Unlike the single hit cache, the candidate cache is used for all types of queries and does
+not change their results.
+
+\see PxScene.raycast PxQueryCandidateCache
 */
 struct PxQueryCache
 {
 	/**
 	\brief constructor sets to default 
 	*/
-	PX_INLINE PxQueryCache() : shape(NULL), actor(NULL), faceIndex(0xffffffff) {}
+	PX_INLINE PxQueryCache() : shape(NULL), actor(NULL), faceIndex(0xffffffff), candidateCache(NULL), queryID(0) {}
 
 	/**
 	\brief constructor to set properties
 	*/
-	PX_INLINE PxQueryCache(PxShape* s, PxU32 findex) : shape(s), actor(NULL), faceIndex(findex) {}
+	PX_INLINE PxQueryCache(PxShape* s, PxU32 findex) : shape(s), actor(NULL), faceIndex(findex), candidateCache(NULL), queryID(0) {}
+
+	/**
+	\brief constructor for queries using a candidate cache
+	*/
+	PX_INLINE PxQueryCache(PxQueryCandidateCache* cache, PxU32 id) : shape(NULL), actor(NULL), faceIndex(0xffffffff), candidateCache(cache), queryID(id) {}
 
-	PxShape*		shape;		//!< Shape to test for intersection first
-	PxRigidActor*	actor;		//!< Actor to which the shape belongs
-	PxU32			faceIndex;	//!< Triangle index to test first - NOT CURRENTLY SUPPORTED
+	PxShape*				shape;			//!< Shape to test for intersection first
+	PxRigidActor*			actor;			//!< Actor to which the shape belongs
+	PxU32					faceIndex;		//!< Triangle index to test first - NOT CURRENTLY SUPPORTED
+	PxQueryCandidateCache*	candidateCache;	//!< Optional candidate cache, see PxQueryCandidateCache
+	PxU32					queryID;		//!< Caller-supplied ID of the query in the candidate cache
 };
 
 #if !PX_DOXYGEN
@@ -61,6 +61,7 @@ class PxRenderBuffer;
 class PxArticulationReducedCoordinate;
 
 struct PxContactPairHeader;
+struct PxContactPairAggregateBuffers;
 
 class PxPvdSceneClient;
 
@@ -117,6 +118,35 @@ struct PxActorTypeFlag
 typedef PxFlags<PxActorTypeFlag::Enum,PxU16> PxActorTypeFlags;
 PX_FLAGS_OPERATORS(PxActorTypeFlag::Enum,PxU16)
 
+/**
+\brief Optional data captured by a scene snapshot.
+
+\see PxScene::saveSnapshot()
+*/
+struct PxSceneSnapshotFlag
+{
+	enum Enum
+	{
+		/**
+		\brief Capture the persistent contact caches and friction anchors of the colliding shape pairs.
+
+		Without this flag the contact caches are reset on restore, and the first simulation step after a restore regenerates the
+		contacts from scratch. Use this flag when the replay must match the original run exactly.
+
+		\note Only supported with CPU narrow phase. The flag is ignored when GPU dynamics are enabled.
+		*/
+		eCONTACT_CACHES		= (1 << 0)
+	};
+};
+
+/**
+\brief Collection of set bits defined in PxSceneSnapshotFlag.
+
+\see PxSceneSnapshotFlag
+*/
+typedef PxFlags<PxSceneSnapshotFlag::Enum,PxU32> PxSceneSnapshotFlags;
+PX_FLAGS_OPERATORS(PxSceneSnapshotFlag::Enum,PxU32)
+
 class PxActor;
 
 /**
@@ -1627,6 +1657,33 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual			PxU32				getContactReportStreamBufferSize() const = 0;
 
+	/**
+	\brief Registers caller-provided buffers for the flat contact pair export.
+
+	While buffers are registered, each simulation step reduces every reported contact pair to an aggregate record (total and maximum
+	impulse, average contact point and normal, material pair, ...) and writes it to the provided structure-of-arrays buffers. The
+	records are available once fetchResults() has returned. This is independent of PxSimulationEventCallback::onContact(), which keeps
+	receiving the full contact streams if a callback is set.
+
+	\note Do not use this method while the simulation is running.
+
+	\param[in] buffers The buffers to write to. The struct is copied, the arrays it points to are not. Use NULL to disable the export.
+
+	\see PxContactPairAggregateBuffers getNbContactPairAggregates()
+	*/
+	virtual			void				setContactPairAggregateBuffers(const PxContactPairAggregateBuffers* buffers) = 0;
+
+	/**
+	\brief Returns the number of contact pair aggregates written by the last simulation step.
+
+	\note Do not use this method while the simulation is running.
+
+	\return Number of valid entries in the registered PxContactPairAggregateBuffers arrays.
+
+	\see PxContactPairAggregateBuffers setContactPairAggregateBuffers()
+	*/
+	virtual			PxU32				getNbContactPairAggregates() const = 0;
+
 	/**
 	\brief Sets the number of actors required to spawn a separate rigid body solver thread.
 
@@ -1696,6 +1753,58 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual	void					shiftOrigin(const PxVec3& shift) = 0;
 
+	/**
+	\brief Returns the size of the buffer needed by saveSnapshot().
+
+	\note Do not use this method while the simulation is running.
+
+	\param[in] flags Optional data to capture, see #PxSceneSnapshotFlag.
+	\return Size of the snapshot in bytes.
+
+	\see saveSnapshot()
+	*/
+	virtual	PxU32					getSnapshotSize(PxSceneSnapshotFlags flags = PxSceneSnapshotFlags()) const = 0;
+
+	/**
+	\brief Saves the dynamic state of the scene to a contiguous buffer.
+
+	The snapshot captures the pose, velocities, sleep state and internal sleep filters of each rigid dynamic, the joint and root state
+	of each articulation and, optionally, the contact caches. It can be restored with restoreSnapshot() to rewind the scene, e.g. for
+	networked rollback or to replay a simulation step.
+
+	The snapshot does not contain the scene's topology. Actors, shapes, joints and parameters set through the API (masses, materials,
+	filtering, kinematic targets, ...) are not captured and must be the same when the snapshot is restored. Broken joints are not restored.
+
+	\note Do not use this method while the simulation is running.
+	\note Not supported when PxSceneFlag::eENABLE_DIRECT_GPU_API is set.
+
+	\param[out] buffer Buffer to write the snapshot to. Should be 16-byte aligned.
+	\param[in] bufferSize Size of the buffer in bytes, see getSnapshotSize().
+	\param[in] flags Optional data to capture, see #PxSceneSnapshotFlag.
+	\return Number of bytes written, or 0 if the buffer is too small or the snapshot is not supported.
+
+	\see getSnapshotSize() restoreSnapshot()
+	*/
+	virtual	PxU32					saveSnapshot(void* buffer, PxU32 bufferSize, PxSceneSnapshotFlags flags = PxSceneSnapshotFlags()) const = 0;
+
+	/**
+	\brief Restores the dynamic state of the scene from a snapshot saved with saveSnapshot().
+
+	The state is written back into the existing objects. No actor, broad-phase entry or scene query structure is re-created.
+	The snapshot is validated before anything is modified: if the rigid dynamics or articulations of the scene do not match the saved
+	ones, the function fails and the scene is left untouched.
+
+	\note Do not use this method while the simulation is running.
+	\note The simulation is only bit-exact after a restore if the snapshot was saved with PxSceneSnapshotFlag::eCONTACT_CACHES.
+
+	\param[in] buffer The snapshot.
+	\param[in] bufferSize Size of the snapshot in bytes.
+	\return True on success.
+
+	\see saveSnapshot()
+	*/
+	virtual	bool					restoreSnapshot(const void* buffer, PxU32 bufferSize) = 0;
+
 	/**
 	\brief Returns the Pvd client associated with the scene.
 	\return the client, NULL if no PVD supported.
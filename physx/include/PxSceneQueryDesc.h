@@ -38,6 +38,7 @@ namespace physx
 #endif
 
 	class PxSceneQuerySystem;
+	class PxCpuDispatcher;
 
 /**
 \brief Pruning structure used to accelerate scene queries.
@@ -55,6 +56,12 @@ dynamic AABB tree, without the per-frame overhead. This can be a good choice for
 objects, if no static objects are added, moved or removed after the scene has been
 created. If there is no such guarantee (e.g. when streaming parts of the world in and out),
 then the dynamic version is a better choice even for static objects.
+
+eDYNAMIC_WIDE_AABB_TREE and eSTATIC_WIDE_AABB_TREE are the same as eDYNAMIC_AABB_TREE and
+eSTATIC_AABB_TREE, but queries run on an 8-wide tree with quantized child bounds. Each tree
+node tests all its children at once using SIMD, and the tree is much shallower and more
+compact than the default binary tree. This is usually faster for scenes with a large number
+of objects, at the cost of some extra memory and extra work when the structure is updated.
 */
 struct PxPruningStructureType
 {
@@ -63,8 +70,10 @@ struct PxPruningStructureType
 		eNONE,					//!< Using a simple data structure
 		eDYNAMIC_AABB_TREE,		//!< Using a dynamic AABB tree
 		eSTATIC_AABB_TREE,		//!< Using a static AABB tree
+		eDYNAMIC_WIDE_AABB_TREE,	//!< Using a dynamic AABB tree, queried through a wide tree with quantized bounds
+		eSTATIC_WIDE_AABB_TREE,		//!< Using a static AABB tree, queried through a wide tree with quantized bounds
 
-		eLAST
+		eLAST	//!< Not a valid structure type. Its value changes when types are added, so do not store it.
 	};
 };
 
@@ -151,7 +160,9 @@ public:
 
 	<b>Default:</b> PxPruningStructureType::eDYNAMIC_AABB_TREE
 
-	\note Only PxPruningStructureType::eSTATIC_AABB_TREE and PxPruningStructureType::eDYNAMIC_AABB_TREE are allowed here.
+	\note Only PxPruningStructureType::eSTATIC_AABB_TREE, PxPruningStructureType::eDYNAMIC_AABB_TREE and their
+	wide versions (PxPruningStructureType::eSTATIC_WIDE_AABB_TREE, PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE)
+	are allowed here.
 
 	\see PxPruningStructureType PxSceneSQSystem.getStaticStructure()
 	*/
@@ -270,6 +281,24 @@ public:
 	*/
 	PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode;
 
+	/**
+	\brief Optional dispatcher used to rebuild the scene query trees over several threads.
+
+	When set, AABB-tree rebuilds are split into tasks submitted to this dispatcher, and the calling thread takes part in
+	the build. For the dynamic structure, when a large number of objects has been added since the last rebuild (e.g. when
+	streaming objects in), the new tree is built in a single (multithreaded) build step instead of being spread over
+	PxSceneQueryDesc::dynamicTreeRebuildRateHint steps. Rebuilds caused by moving objects keep the regular progressive
+	rebuild, during which the current tree is refit.
+
+	The resulting trees do not depend on the number of worker threads. The dispatcher can be the scene's own dispatcher.
+	It must outlive the scene query system.
+
+	<b>Default:</b> NULL (single-threaded builds)
+
+	\see PxCpuDispatcher PxSceneQueryDesc::dynamicTreeRebuildRateHint
+	*/
+	PxCpuDispatcher*	treeBuildDispatcher;
+
 public:
 	/**
 	\brief constructor sets to default.
@@ -297,7 +326,8 @@ PX_INLINE PxSceneQueryDesc::PxSceneQueryDesc():
 	dynamicBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	staticNbObjectsPerNode		(4),
 	dynamicNbObjectsPerNode		(4),
-	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
+	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED),
+	treeBuildDispatcher			(NULL)
 {
 }
 
@@ -308,7 +338,8 @@ PX_INLINE void PxSceneQueryDesc::setToDefault()
 
 PX_INLINE bool PxSceneQueryDesc::isValid() const
 {
-	if(staticStructure!=PxPruningStructureType::eSTATIC_AABB_TREE && staticStructure!=PxPruningStructureType::eDYNAMIC_AABB_TREE)
+	if(		staticStructure!=PxPruningStructureType::eSTATIC_AABB_TREE && staticStructure!=PxPruningStructureType::eDYNAMIC_AABB_TREE
+		&&	staticStructure!=PxPruningStructureType::eSTATIC_WIDE_AABB_TREE && staticStructure!=PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE)
 		return false;
 
 	if(dynamicTreeRebuildRateHint < 4)
@@ -46,6 +46,7 @@ class PxActor;
 class PxRigidActor;
 class PxRigidBody;
 class PxConstraint;
+class PxMaterial;
 
 
 /**
@@ -760,6 +761,112 @@ PX_INLINE const PxU32* PxContactPair::getInternalFaceIndices() const
 	return reinterpret_cast<const PxU32*>(contactImpulses + contactCount);
 }
 
+
+/**
+\brief Caller-provided structure-of-arrays buffers for the flat contact pair export.
+
+When registered with #PxScene::setContactPairAggregateBuffers(), the simulation reduces every reported contact pair to a single
+aggregate record and writes it to entry i of each provided array, where i runs over [0, PxScene::getNbContactPairAggregates()).
+This happens at the end of the simulation step, in parallel on the worker threads, so that a gameplay system which only needs
+impulses per pair does not have to walk the contact stream of each pair in PxSimulationEventCallback::onContact().
+
+Each array pointer is optional. A NULL pointer means the corresponding attribute is not written. Non-NULL arrays must be able to
+store #maxNbPairs entries. Pairs that do not fit are dropped and a debug warning is emitted.
+
+Only pairs that are reported through the contact report mechanism are exported. This is decided by the PxPairFlag flags returned
+by the simulation filter shader. The contact-based attributes (#nbContacts, #totalImpulses, #maxImpulses, #averagePoints,
+#averageNormals, #materials0, #materials1) require PxPairFlag::eNOTIFY_CONTACT_POINTS and are zero or NULL otherwise.
+
+\note The export describes the contact report stream as it is when the simulation step completes. Lost-touch events that only get
+generated in fetchResults(), because actors or shapes were removed while the simulation was running, are still reported through
+PxSimulationEventCallback::onContact() but are not part of the export.
+
+\note The buffers must remain valid until fetchResults() has returned for every simulation step that runs while they are registered.
+
+\see PxScene::setContactPairAggregateBuffers() PxScene::getNbContactPairAggregates() PxContactPair
+*/
+struct PxContactPairAggregateBuffers
+{
+	PX_INLINE	PxContactPairAggregateBuffers() :
+		maxNbPairs		(0),
+		actors0			(NULL),
+		actors1			(NULL),
+		shapes0			(NULL),
+		shapes1			(NULL),
+		events			(NULL),
+		flags			(NULL),
+		nbContacts		(NULL),
+		totalImpulses	(NULL),
+		maxImpulses		(NULL),
+		averagePoints	(NULL),
+		averageNormals	(NULL),
+		materials0		(NULL),
+		materials1		(NULL)
+	{
+	}
+
+	/**
+	\brief Capacity of each of the provided arrays.
+	*/
+	PxU32					maxNbPairs;
+
+	/**
+	\brief The two actors of each pair. Same as PxContactPairHeader::actors.
+	*/
+	PxActor**				actors0;
+	PxActor**				actors1;
+
+	/**
+	\brief The two shapes of each pair. Same as PxContactPair::shapes.
+	*/
+	PxShape**				shapes0;
+	PxShape**				shapes1;
+
+	/**
+	\brief The events of each pair. Same as PxContactPair::events.
+	*/
+	PxPairFlags*			events;
+
+	/**
+	\brief The flags of each pair. Same as PxContactPair::flags.
+	*/
+	PxContactPairFlags*		flags;
+
+	/**
+	\brief Number of contact points of each pair.
+	*/
+	PxU32*					nbContacts;
+
+	/**
+	\brief Sum of the contact impulses applied to the first shape of each pair, i.e. the sum of PxContactPairPoint::impulse.
+	*/
+	PxVec3*					totalImpulses;
+
+	/**
+	\brief Largest impulse magnitude applied at a single contact point of each pair.
+	*/
+	PxReal*					maxImpulses;
+
+	/**
+	\brief Average of the contact point positions of each pair, in world space.
+	*/
+	PxVec3*					averagePoints;
+
+	/**
+	\brief Normalized average of the contact normals of each pair. Points from the second shape to the first shape.
+	*/
+	PxVec3*					averageNormals;
+
+	/**
+	\brief The materials of the first and second shape of each pair.
+
+	For pairs with several contact patches (e.g. against a triangle mesh with per-triangle materials), the materials of the patch
+	that received the largest impulse are used, or the materials of the first patch if no impulses are available.
+	*/
+	PxMaterial**			materials0;
+	PxMaterial**			materials1;
+};
+
 /**
 \brief Collection of flags providing information on trigger report pairs.
 
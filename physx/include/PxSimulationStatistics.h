@@ -306,6 +306,18 @@ public:
 	*/
 	PxU32	nbPartitions;
 
+	/**
+	\brief Number of times a thread had to wait for the lock of the 16K contact/constraint data block pool this frame
+
+	\note Threads normally take blocks from per-thread reservoirs and only need the lock to refill them.
+	*/
+	PxU32	nbDataBlockLockContentions;
+
+	/**
+	\brief Number of times a per-thread reservoir of 16K contact/constraint data blocks was refilled from the shared pool this frame
+	*/
+	PxU32	nbDataBlockReservoirRefills;
+
 	/**
 	\brief GPU device memory in bytes allocated for particle state accessible through API
 	*/
@@ -436,6 +448,8 @@ public:
 		nbNewTouches							(0),
 		nbLostTouches							(0),
 		nbPartitions							(0),
+		nbDataBlockLockContentions				(0),
+		nbDataBlockReservoirRefills				(0),
 		gpuMemParticles							(0),
 		gpuMemDeformableSurfaces				(0),
 		gpuMemDeformableVolumes					(0),
@@ -33,6 +33,7 @@
 #include "foundation/PxFlags.h"
 #include "foundation/PxErrorCallback.h"
 #include "common/PxRenderBuffer.h"
+#include "characterkinematic/PxController.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -45,6 +46,7 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxCpuDispatcher;
 
 /**
 \brief specifies debug-rendering flags
@@ -71,6 +73,34 @@ typedef PxFlags<PxControllerDebugRenderFlag::Enum, PxU32> PxControllerDebugRende
 PX_FLAGS_OPERATORS(PxControllerDebugRenderFlag::Enum, PxU32)
 
 
+/**
+\brief Describes one controller move for PxControllerManager::moveAll().
+
+The input members are the parameters of PxController::move(). The resulting collision flags are written back to the descriptor.
+
+\see PxControllerManager::moveAll() PxController::move()
+*/
+class PxControllerMoveDesc
+{
+public:
+	PX_INLINE					PxControllerMoveDesc() :
+									controller		(NULL),
+									disp			(0.0f),
+									minDist			(0.0f),
+									elapsedTime		(0.0f),
+									obstacles		(NULL),
+									collisionFlags	(0)
+								{}
+
+	PxController*				controller;		//!< Controller to move. Must belong to the manager and appear only once per moveAll() call.
+	PxVec3						disp;			//!< Displacement vector, see PxController::move()
+	PxF32						minDist;		//!< The minimum travelled distance to consider, see PxController::move()
+	PxF32						elapsedTime;	//!< Time elapsed since last call
+	PxControllerFilters			filters;		//!< User-defined filters for this move
+	const PxObstacleContext*	obstacles;		//!< Potential additional obstacles the CCT should collide with
+	PxControllerCollisionFlags	collisionFlags;	//!< [out] Collision flags returned by the move, see PxController::move()
+};
+
 /**
 \brief Manages an array of character controllers.
 
@@ -187,6 +217,34 @@ public:
 	*/
 	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL) = 0;
 
+	/**
+	\brief Moves a set of characters, possibly in parallel.
+
+	This is the batched equivalent of calling PxController::move() for each descriptor. Each controller is moved against the
+	world and against the other controllers as they were when moveAll() was called, so the moves are independent of each other
+	and can be distributed over the worker threads of the dispatcher. Static world geometry is gathered once per spatial cell
+	of size cellSize and shared by all the controllers moved from that cell.
+
+	Overlaps between characters created by moving them simultaneously are resolved by a second, single-threaded pass once
+	all moves are done. That pass follows the rules of #computeInteractions() and only concerns pairs involving at least one
+	moved controller. The results do not depend on the number of worker threads.
+
+	\note The user callbacks (filter, hit report and behavior callbacks) can be called concurrently from several threads
+	when a dispatcher is used. They must be thread-safe.
+
+	\note The kinematic actors of the controllers are updated by the calling thread once all moves are done.
+
+	\note Moves are single-threaded when debug rendering is enabled.
+
+	\param[in] nbDescs		Number of descriptors
+	\param[in,out] descs	Move descriptors. Collision flags are written back to them.
+	\param[in] dispatcher	Dispatcher used to run the moves in parallel. Can be NULL.
+	\param[in] cellSize		Size of the cells used to share static geometry. Zero picks a size from the controllers' volumes.
+
+	\see PxController::move() PxControllerMoveDesc computeInteractions()
+	*/
+	virtual	void				moveAll(PxU32 nbDescs, PxControllerMoveDesc* descs, PxCpuDispatcher* dispatcher=NULL, PxReal cellSize=0.0f) = 0;
+
 	/**
 	\brief Enables or disables runtime tessellation.
 
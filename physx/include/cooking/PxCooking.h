@@ -33,6 +33,7 @@
 #include "cooking/Pxc.h"
 
 #include "cooking/PxConvexMeshDesc.h"
+#include "cooking/PxCookingCache.h"
 #include "cooking/PxTriangleMeshDesc.h"
 #include "cooking/PxTetrahedronMeshDesc.h"
 #include "cooking/PxMidphaseDesc.h"
@@ -50,6 +51,7 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -344,6 +346,8 @@ struct PxCookingParams
 	Computing the extra structures all the time does not guarantee optimal performance. There is a per-platform break-even point below which the
 	extra structures actually hurt performance.
 
+	Computing these structures is also the most expensive part of cooking small convex meshes, so increasing the limit speeds up runtime cooking.
+
 	<b>Default value:</b> 32
 	*/
 	PxU32	gaussMapLimit;
@@ -357,6 +361,21 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional CPU dispatcher used to parallelize triangle mesh cooking.
+
+	If set, mesh cleaning and vertex welding, the active edges computation and the BVH34 / GPU midphase builds
+	are split into tasks submitted to this dispatcher. The calling thread takes part in the work and the functions still
+	return when cooking is complete. The cooked data is identical to the data produced without a dispatcher.
+
+	The batch cooking functions also use this dispatcher to cook several meshes concurrently.
+
+	Cooking can be called from a task running on the same dispatcher.
+
+	<b>Default value:</b> NULL
+	*/
+	PxCpuDispatcher*	cpuDispatcher;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -370,7 +389,8 @@ struct PxCookingParams
 		meshAreaMinLimit				(0.0f),
 		meshEdgeLengthMaxLimit			(500.0f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		cpuDispatcher					(NULL)
 	{
 	}
 };
@@ -507,6 +527,30 @@ suitable for loading and performing collision detection at runtime.
 */
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookConvexMesh(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc& desc, physx::PxOutputStream& stream, physx::PxConvexMeshCookingResult::Enum* condition=NULL);
 
+/**
+\brief Cooks a batch of convex meshes. The results are written to the streams.
+
+This does the same as calling PxCookConvexMesh() for each descriptor, but:
+- meshes are cooked concurrently on #PxCookingParams::cpuDispatcher if it is set, and serially otherwise.
+- descriptors with identical data are only cooked once, and the cooked data is written to all their streams.
+- if a cache is provided, cooked data is looked up in the cache before cooking, and successfully cooked data is stored
+in the cache. The cache key is a hash of the descriptor data and of the cooking parameters.
+
+\note The streams must be distinct objects, since they can be written to concurrently.
+
+\param[in] params		The cooking parameters
+\param[in] nbMeshes		Number of meshes to cook.
+\param[in] descs		Array of nbMeshes convex mesh descriptors.
+\param[in] streams		Array of nbMeshes user streams to output the cooked data.
+\param[out] conditions	Optional array of nbMeshes results from convex mesh cooking.
+\param[in] cache		Optional cache for the cooked data.
+\return true if all meshes have been cooked successfully.
+
+\see PxCookConvexMesh() PxCookingCache PxDefaultCookingCache
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxOutputStream* const* streams,
+																	physx::PxConvexMeshCookingResult::Enum* conditions=NULL, physx::PxCookingCache* cache=NULL);
+
 /**
 \brief Cooks and creates a convex mesh without going through a stream.
 
@@ -527,6 +571,32 @@ or PxGetStandaloneInsertionCallback().
 */
 PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxConvexMesh* PxCreateConvexMesh(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc& desc, physx::PxInsertionCallback& insertionCallback, physx::PxConvexMeshCookingResult::Enum* condition=NULL);
 
+/**
+\brief Cooks and creates a batch of convex meshes without going through streams.
+
+This does the same as calling PxCreateConvexMesh() for each descriptor, but the meshes are cooked concurrently on
+#PxCookingParams::cpuDispatcher if it is set. The calling thread takes part in the work. Use this to cook many hulls
+at runtime, e.g. for the pieces of a fractured object.
+
+\note Hulls with up to #PxCookingParams::gaussMapLimit vertices are cooked without the additional acceleration
+structures, which are the most expensive part of cooking small hulls. Raise the limit to cook small hulls faster.
+
+\note The insertion callback is called concurrently. The callbacks returned by PxPhysics::getPhysicsInsertionCallback()
+and PxGetStandaloneInsertionCallback() support this.
+
+\param[in] params				The cooking parameters
+\param[in] nbMeshes				Number of meshes to create.
+\param[in] descs				Array of nbMeshes convex mesh descriptors.
+\param[in] insertionCallback	The insertion interface from PxPhysics.
+\param[out] meshes				Array of nbMeshes created meshes. Meshes that could not be created are set to NULL.
+\param[out] conditions			Optional array of nbMeshes results from convex mesh cooking.
+\return true if all meshes have been created successfully.
+
+\see PxCreateConvexMesh() PxCookConvexMeshes() PxInsertionCallback
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCreateConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxInsertionCallback& insertionCallback,
+																	physx::PxConvexMesh** meshes, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 /**
 \brief Cooks and creates a convex mesh without going through a stream. Convenience function for standalone objects.
 	
@@ -622,6 +692,31 @@ suitable for loading and performing collision detection at runtime.
 */
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookTriangleMesh(const physx::PxCookingParams& params, const physx::PxTriangleMeshDesc& desc, physx::PxOutputStream& stream, physx::PxTriangleMeshCookingResult::Enum* condition=NULL);
 
+/**
+\brief Cooks a batch of triangle meshes. The results are written to the streams.
+
+This does the same as calling PxCookTriangleMesh() for each descriptor, but:
+- meshes are cooked concurrently on #PxCookingParams::cpuDispatcher if it is set, and serially otherwise.
+- descriptors with identical data are only cooked once, and the cooked data is written to all their streams.
+- if a cache is provided, cooked data is looked up in the cache before cooking, and successfully cooked data is stored
+in the cache. The cache key is a hash of the descriptor data and of the cooking parameters.
+
+\note The streams must be distinct objects, since they can be written to concurrently.
+\note Descriptors with a PxTriangleMeshDesc::sdfDesc are cooked individually and bypass the cache.
+
+\param[in] params		The cooking parameters
+\param[in] nbMeshes		Number of meshes to cook.
+\param[in] descs		Array of nbMeshes triangle mesh descriptors.
+\param[in] streams		Array of nbMeshes user streams to output the cooked data.
+\param[out] conditions	Optional array of nbMeshes results from triangle mesh cooking.
+\param[in] cache		Optional cache for the cooked data.
+\return true if all meshes have been cooked successfully.
+
+\see PxCookTriangleMesh() PxCookingCache PxDefaultCookingCache
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookTriangleMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxTriangleMeshDesc* descs, physx::PxOutputStream* const* streams,
+																	physx::PxTriangleMeshCookingResult::Enum* conditions=NULL, physx::PxCookingCache* cache=NULL);
+
 /**
 \brief Cooks and creates a triangle mesh without going through a stream.
 
@@ -0,0 +1,100 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_COOKING_CACHE_H
+#define PX_COOKING_CACHE_H
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxOutputStream;
+
+/**
+\brief Key identifying a cooked mesh in a #PxCookingCache.
+
+The key is a 128-bit hash of the mesh descriptor data and of all the #PxCookingParams members that can change the cooked
+data. It also covers the SDK version, so cached data produced by a different SDK version is never returned.
+
+\see PxCookingCache PxCookConvexMeshes PxCookTriangleMeshes
+*/
+struct PxCookingCacheKey
+{
+	PxU64	hash[2];
+
+	PX_FORCE_INLINE	bool	operator==(const PxCookingCacheKey& other)	const
+	{
+		return hash[0]==other.hash[0] && hash[1]==other.hash[1];
+	}
+};
+
+/**
+\brief User-provided storage for cooked mesh data, used by the batch cooking functions.
+
+The batch cooking functions look up each mesh in the cache before cooking it, and store the cooked data in the cache after
+a successful cook. The stored blobs are opaque: they are only meaningful to the batch cooking functions and should be
+returned unchanged by #load(). Each blob contains a checksum of the cooked data. Blobs that do not pass the check, e.g. because
+they were truncated or corrupted, are ignored and the mesh is cooked again.
+
+\note Both functions are called concurrently from the threads of the cooking dispatcher, see #PxCookingParams::cpuDispatcher.
+
+\see PxCookConvexMeshes PxCookTriangleMeshes PxDefaultCookingCache
+*/
+class PxCookingCache
+{
+public:
+	/**
+	\brief Looks up cooked data.
+
+	\param[in] key		The key identifying the cooked data.
+	\param[in] stream	Stream to write the data previously passed to #store() to.
+	\return true if the data was found and written to the stream, false otherwise.
+	*/
+	virtual	bool	load(const PxCookingCacheKey& key, PxOutputStream& stream)	= 0;
+
+	/**
+	\brief Stores cooked data.
+
+	\param[in] key	The key identifying the cooked data.
+	\param[in] data	The data to store.
+	\param[in] size	Size of the data in bytes.
+	*/
+	virtual	void	store(const PxCookingCacheKey& key, const void* data, PxU32 size)	= 0;
+
+protected:
+	virtual			~PxCookingCache()	{}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
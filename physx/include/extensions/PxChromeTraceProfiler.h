@@ -0,0 +1,104 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_CHROME_TRACE_PROFILER_H
+#define PX_CHROME_TRACE_PROFILER_H
+
+#include "extensions/PxDefaultProfiler.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxScene;
+
+/**
+\brief Profiler that directly writes the Chrome Trace Event JSON format.
+
+The output can be opened in chrome://tracing or in the Perfetto UI, without the conversion step needed by the binary
+format of #PxDefaultProfilerCreate. The mapping of profiler callbacks to trace events is as follows:
+
+\li Nested PxProfilerCallback::zoneStart / zoneEnd pairs become complete ("X") events on the thread's track.
+\li Cross-thread zones (detached set to true) become async ("b" / "e") events, using the context as id.
+\li PxProfilerCallback::recordData values and sampled PxSimulationStatistics become counter ("C") tracks.
+\li PxProfilerCallback::recordFrame becomes a global instant ("i") event.
+
+Each thread records into its own fixed-size ring buffer, without locks. Events are converted to JSON and written to the
+stream by #flush, which can be called at any time, including while the simulation is running. Memory use is capped: if a
+thread fills its ring buffer before the next flush, or if more threads than the maximum record events, the new events are
+dropped and counted (see #getNbDroppedEvents). The number of dropped events is also written to the trace as a counter.
+
+Event names are interned: names are stored as pointers in the ring buffers and only converted to JSON strings once.
+As for PxDefaultProfiler, all names must therefore be global or static strings.
+
+The JSON array is closed by #release. A trace truncated by a crash can still be loaded by the viewers.
+
+\see PxChromeTraceProfilerCreate()
+*/
+class PxChromeTraceProfiler : public PxDefaultProfiler
+{
+public:
+
+	/**
+	\brief Samples the simulation statistics of a scene, as counter tracks.
+
+	Call this after PxScene::fetchResults(), for example once per frame.
+
+	\param[in] scene	The scene to sample.
+
+	\see PxScene::getSimulationStatistics()
+	*/
+	virtual void recordSimulationStatistics(const PxScene& scene) = 0;
+
+	/**
+	\brief Returns the total number of events dropped so far because a ring buffer was full, or because too many threads were used.
+
+	\return The number of dropped events.
+	*/
+	virtual PxU64 getNbDroppedEvents() const = 0;
+};
+
+/**
+\brief Creates a profiler writing Chrome Trace Event JSON.
+
+\note The PhysXExtensions SDK needs to be initialized first before using this method (see #PxInitExtensions)
+
+\param[in] outputStream			Stream receiving the JSON data. Writing to the stream occurs when flush or release is called.
+\param[in] maxNbThreads			The maximum number of threads that can record events. Events from additional threads are dropped.
+\param[in] nbEventsPerThread	The capacity of each thread's ring buffer. Rounded up to a power of two, and to at least 1024. Each event
+								uses 40 bytes, and ring buffers are allocated when a thread records its first event.
+\return The new profiler.
+
+\see PxChromeTraceProfiler
+*/
+PxChromeTraceProfiler* PxChromeTraceProfilerCreate(PxOutputStream& outputStream, PxU32 maxNbThreads = 32, PxU32 nbEventsPerThread = 16384);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -173,12 +173,13 @@ namespace physx
 	\param[in] contextID				Context ID parameter, sent to the profiler
 	\param[in] adapter					Adapter class implementing our extended API
 	\param[in] usesTreeOfPruners		True to keep pruners themselves in a BVH, which might increase query performance if a lot of pruners are involved
+	\param[in] treeBuildDispatcher		Optional dispatcher used by all pruners to rebuild their trees over several threads. See PxSceneQueryDesc::treeBuildDispatcher
 
 	\return	A custom SQ system instance
 
-	\see PxCustomSceneQuerySystem PxSceneQueryUpdateMode PxCustomSceneQuerySystemAdapter PxSceneDesc::sceneQuerySystem
+	\see PxCustomSceneQuerySystem PxSceneQueryUpdateMode PxCustomSceneQuerySystemAdapter PxSceneDesc::sceneQuerySystem PxSceneQueryDesc::treeBuildDispatcher
 	*/
-	PxCustomSceneQuerySystem* PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners=false);
+	PxCustomSceneQuerySystem* PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners=false, PxCpuDispatcher* treeBuildDispatcher=NULL);
 
 #if !PX_DOXYGEN
 } // namespace physx
@@ -0,0 +1,74 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_DEFAULT_COOKING_CACHE_H
+#define PX_DEFAULT_COOKING_CACHE_H
+
+#include "cooking/PxCookingCache.h"
+#include "foundation/PxArray.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Default implementation of a cooking cache, storing cooked data in a directory.
+
+Each entry is stored in its own file named after the cache key. Entries are first written to a temporary file which is
+then renamed, so that readers never see partially written entries. The directory can be reused across runs, e.g. between
+asset builds. Entries never need to be invalidated: changing the mesh data, the cooking parameters or the SDK version
+changes the key.
+
+\note The directory must exist. It can be shared by the threads of a single process, but not by concurrent processes.
+
+\see PxCookingCache PxCookConvexMeshes PxCookTriangleMeshes
+*/
+class PxDefaultCookingCache : public PxCookingCache
+{
+public:
+	/**
+	\param[in] directory	Path of the directory containing the cached files.
+	*/
+						PxDefaultCookingCache(const char* directory);
+	virtual				~PxDefaultCookingCache();
+
+	virtual		bool	load(const PxCookingCacheKey& key, PxOutputStream& stream)	PX_OVERRIDE;
+	virtual		void	store(const PxCookingCacheKey& key, const void* data, PxU32 size)	PX_OVERRIDE;
+
+private:
+				void	getFilename(PxArray<char>& filename, const PxCookingCacheKey& key, const char* extension)	const;
+
+		PxArray<char>	mDirectory;
+};
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#endif
@@ -79,6 +79,11 @@ The strategies are as follows:
 a) wait until a work task signals the end of the spin-wait period.
 b) yield the thread by providing a hint to reschedule thread execution, thereby allowing other threads to run.
 c) yield the processor by informing it that it is waiting for work and requesting it to more efficiently use compute resources.
+
+eWORK_STEALING is a different scheduling scheme rather than a pure waiting strategy: each worker thread owns a deque to which
+it pushes the tasks it submits and from which it pops them in LIFO order. Idle threads steal from randomly selected workers,
+spin for a short while and eventually park until new work is submitted. This scales better than the shared queue when many
+small tasks are spawned from worker threads, e.g. with a large number of threads.
 */
 struct PxDefaultCpuDispatcherWaitForWorkMode
 {
@@ -86,7 +91,8 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 	{
 		eWAIT_FOR_WORK,
 		eYIELD_THREAD,
-		eYIELD_PROCESSOR
+		eYIELD_PROCESSOR,
+		eWORK_STEALING
 	};
 };
 
@@ -98,12 +104,13 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 \param[in] affinityMasks Array with affinity mask for each thread. If not defined, default masks will be used.
 \param[in] mode is the strategy employed when a busy-wait is encountered. 
 \param[in] yieldProcessorCount specifies the number of times a OS-specific yield processor command will be executed
-during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR
+during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR. For eWORK_STEALING it is the number
+of unsuccessful spin rounds before an idle thread parks, zero meaning a default value.
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
 
-\note yieldProcessorCount must be greater than zero if eYIELD_PROCESSOR is the chosen mode and equal to zero for all other modes.
+\note yieldProcessorCount must be greater than zero if eYIELD_PROCESSOR is the chosen mode and equal to zero for eWAIT_FOR_WORK and eYIELD_THREAD.
 
 \note eYIELD_THREAD and eYIELD_PROCESSOR modes will use compute resources even if the simulation is not running.
 It is left to users to keep threads inactive, if so desired, when no simulation is running.
@@ -43,6 +43,7 @@
 #include "extensions/PxDefaultSimulationFilterShader.h"
 #include "extensions/PxDefaultErrorCallback.h"
 #include "extensions/PxDefaultStreams.h"
+#include "extensions/PxDefaultCookingCache.h"
 #include "extensions/PxRigidActorExt.h"
 #include "extensions/PxRigidBodyExt.h"
 #include "extensions/PxShapeExt.h"
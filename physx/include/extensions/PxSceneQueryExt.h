@@ -434,9 +434,32 @@ public:
 		PxU16 maxNbTouches = 0,
 		const PxQueryFilterData& filterData = PxQueryFilterData(),
 		const PxQueryCache* cache = NULL) = 0;
-		
+
 	virtual void execute() = 0;
 
+	/**
+	\brief Executes the queued queries in parallel using the tasks of a CPU dispatcher.
+
+	The queued raycasts, sweeps and overlaps are split into chunks that are submitted to the dispatcher. Each chunk
+	records its touches in a scratch buffer of its own. Once all chunks have completed, the touches are compacted
+	into the touch buffers of the batch, in query order, and the result buffers returned by raycast(), sweep() and
+	overlap() are updated. The results are identical to those produced by execute(), including the distribution of
+	touch buffer space among queries when the touch buffers are too small.
+
+	\note The query filter callback passed to PxCreateBatchQueryExt() must be thread safe, as it is called from the
+	worker threads of the dispatcher.
+	\note The scene must not be modified and no query must be added to the batch until the results are available.
+
+	\param[in] dispatcher	The dispatcher that runs the query tasks.
+	\param[in] continuation	Optional task that is released when the results are available. A reference is added to the
+	continuation by this call and removed once all queries have completed and the results have been compacted. If NULL, the
+	call blocks until the results are available. The calling thread then runs chunks as well and only waits for chunks already
+	started by worker threads, so a blocking call can be made from a worker thread of the same dispatcher.
+
+	\see execute() PxCpuDispatcher
+	*/
+	virtual void executeAsync(PxCpuDispatcher& dispatcher, PxBaseTask* continuation) = 0;
+
 protected:
 
 	virtual ~PxBatchQueryExt() {}
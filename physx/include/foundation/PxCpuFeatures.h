@@ -0,0 +1,90 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_CPU_FEATURES_H
+#define PX_CPU_FEATURES_H
+
+#include "foundation/PxFoundationConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Instruction set extensions that SDK kernels can select at runtime.
+
+\see PxGetCpuFeatures
+*/
+struct PxCpuFeature
+{
+	enum Enum
+	{
+		eSSE4_2		= (1<<0),
+		eAVX		= (1<<1),
+		eAVX2		= (1<<2),	//!< AVX2 and FMA3, with the AVX state enabled by the operating system
+		eAVX512F	= (1<<3)	//!< AVX-512 foundation, with the AVX-512 state enabled by the operating system
+	};
+};
+
+/**
+\brief Returns the PxCpuFeature flags supported by the CPU and the operating system, restricted by the mask set
+with #PxSetCpuFeatureMask.
+
+The CPU is queried on the first call, later calls return the cached result. Returns 0 on non-Intel platforms and
+when PX_SIMD_DISABLED is defined.
+
+\return A combination of PxCpuFeature flags.
+*/
+PX_FOUNDATION_API PxU32 PxGetCpuFeatures();
+
+/**
+\brief Restricts the features reported by #PxGetCpuFeatures.
+
+This can be used to select the SSE2 code paths on a machine supporting AVX2, for example to compare both paths or to
+get the same code paths on all machines of a mixed fleet. Kernels read the features when they run, so the mask should
+be set before the simulation starts.
+
+\param[in] mask A combination of PxCpuFeature flags. Defaults to all features.
+*/
+PX_FOUNDATION_API void PxSetCpuFeatureMask(PxU32 mask);
+
+/**
+\brief Returns true if a feature is reported by #PxGetCpuFeatures.
+*/
+PX_INLINE bool PxIsCpuFeatureSupported(PxCpuFeature::Enum feature)
+{
+	return (PxGetCpuFeatures() & feature) != 0;
+}
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -46,6 +46,51 @@ class PxTempAllocator
 	PX_FOUNDATION_API void deallocate(void* ptr);
 };
 
+/**
+\brief Statistics for the per-thread caches of the temp allocator.
+
+Small temp allocations are served from a cache owned by the calling thread, which refills from and drains to
+a shared free table in batches. Only cache misses need to take the shared lock. Only threads that called
+PxTempAllocatorAcquireThreadCache() own a cache.
+*/
+struct PxTempAllocatorThreadStats
+{
+	PxU64	nbHits;		//!< Number of allocations served from the thread cache
+	PxU64	nbMisses;	//!< Number of allocations that had to go to the shared free table or the base allocator
+	PxU64	bytesHeld;	//!< Number of bytes currently held in the thread cache
+	bool	active;		//!< False if the owner thread released its cache
+};
+
+/**
+\brief Retrieves statistics for all temp allocator thread caches.
+
+\param[out] stats Buffer receiving the statistics, can be NULL to only query the number of caches
+\param[in] maxNbStats Capacity of the stats buffer
+\return Number of thread caches
+*/
+PX_FOUNDATION_API PxU32 PxTempAllocatorGetThreadStats(PxTempAllocatorThreadStats* stats, PxU32 maxNbStats);
+
+/**
+\brief Gives the calling thread its own temp allocator cache.
+
+Threads without a cache allocate from the shared free table, under a lock. A thread that calls this function must call
+PxTempAllocatorReleaseThreadCache() before it terminates, otherwise the memory held by its cache is only reclaimed when the
+foundation is released. Threads of the default CPU dispatcher do both automatically.
+
+\see PxTempAllocatorReleaseThreadCache
+*/
+PX_FOUNDATION_API void PxTempAllocatorAcquireThreadCache();
+
+/**
+\brief Returns the memory cached by the calling thread to the shared free table.
+
+The cache can then be recycled by another thread calling PxTempAllocatorAcquireThreadCache(). Does nothing if the calling
+thread has no cache.
+
+\see PxTempAllocatorAcquireThreadCache
+*/
+PX_FOUNDATION_API void PxTempAllocatorReleaseThreadCache();
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
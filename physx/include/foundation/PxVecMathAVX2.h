@@ -0,0 +1,131 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_VEC_MATH_AVX2_H
+#define PX_VEC_MATH_AVX2_H
+
+// 8-lane float vectors for AVX2 kernels.
+//
+// The SDK is built for SSE2, so these functions are compiled for AVX2 with a function attribute rather than with
+// compiler flags. Functions using them must be marked with PX_AVX2_TARGET, and must only be called when
+// PxGetCpuFeatures() reports PxCpuFeature::eAVX2. This allows a single binary to select AVX2 kernels at runtime.
+
+#include "foundation/PxPreprocessor.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED) && !PX_EMSCRIPTEN && (PX_VC || PX_GCC_FAMILY)
+	#define PX_AVX2_SUPPORTED 1
+#else
+	#define PX_AVX2_SUPPORTED 0
+#endif
+
+#if PX_AVX2_SUPPORTED
+
+#include <immintrin.h>
+
+#if PX_VC
+	// MSVC compiles AVX intrinsics in any function.
+	#define PX_AVX2_TARGET
+#else
+	#define PX_AVX2_TARGET	__attribute__((target("avx2,fma")))
+#endif
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+namespace aos
+{
+
+typedef __m256 Vec8V;	// 8 floats. Comparison results are lane masks, as for Vec4V.
+
+#define PX_AVX2_FORCE_INLINE	PX_FORCE_INLINE PX_AVX2_TARGET
+
+PX_AVX2_FORCE_INLINE Vec8V V8Zero()									{ return _mm256_setzero_ps();						}
+PX_AVX2_FORCE_INLINE Vec8V V8Load(const PxF32 f)						{ return _mm256_set1_ps(f);							}
+PX_AVX2_FORCE_INLINE Vec8V V8LoadA(const PxF32* f)						{ return _mm256_load_ps(f);							}	// 32-byte aligned
+PX_AVX2_FORCE_INLINE Vec8V V8LoadU(const PxF32* f)						{ return _mm256_loadu_ps(f);						}
+PX_AVX2_FORCE_INLINE void V8StoreA(const Vec8V a, PxF32* f)				{ _mm256_store_ps(f, a);							}	// 32-byte aligned
+PX_AVX2_FORCE_INLINE void V8StoreU(const Vec8V a, PxF32* f)				{ _mm256_storeu_ps(f, a);							}
+
+// Lanes 0-3 from lo, lanes 4-7 from hi.
+PX_AVX2_FORCE_INLINE Vec8V V8Merge(const __m128 lo, const __m128 hi)	{ return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);	}
+// The same 4 floats in both halves.
+PX_AVX2_FORCE_INLINE Vec8V V8Broadcast4(const __m128 a)				{ return V8Merge(a, a);								}
+PX_AVX2_FORCE_INLINE __m128 V8GetLow(const Vec8V a)					{ return _mm256_castps256_ps128(a);					}
+PX_AVX2_FORCE_INLINE __m128 V8GetHigh(const Vec8V a)					{ return _mm256_extractf128_ps(a, 1);				}
+
+PX_AVX2_FORCE_INLINE Vec8V V8Add(const Vec8V a, const Vec8V b)			{ return _mm256_add_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Sub(const Vec8V a, const Vec8V b)			{ return _mm256_sub_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Mul(const Vec8V a, const Vec8V b)			{ return _mm256_mul_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Div(const Vec8V a, const Vec8V b)			{ return _mm256_div_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Neg(const Vec8V a)						{ return _mm256_sub_ps(_mm256_setzero_ps(), a);		}
+PX_AVX2_FORCE_INLINE Vec8V V8Abs(const Vec8V a)						{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);	}
+PX_AVX2_FORCE_INLINE Vec8V V8Min(const Vec8V a, const Vec8V b)			{ return _mm256_min_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Max(const Vec8V a, const Vec8V b)			{ return _mm256_max_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Sqrt(const Vec8V a)						{ return _mm256_sqrt_ps(a);							}
+PX_AVX2_FORCE_INLINE Vec8V V8Recip(const Vec8V a)						{ return _mm256_div_ps(_mm256_set1_ps(1.0f), a);	}
+
+// a*b + c and c - a*b, fused.
+PX_AVX2_FORCE_INLINE Vec8V V8MulAdd(const Vec8V a, const Vec8V b, const Vec8V c)		{ return _mm256_fmadd_ps(a, b, c);	}
+PX_AVX2_FORCE_INLINE Vec8V V8NegMulSub(const Vec8V a, const Vec8V b, const Vec8V c)	{ return _mm256_fnmadd_ps(a, b, c);	}
+
+// Dot product of 8 pairs of 3-vectors stored as structures of arrays.
+PX_AVX2_FORCE_INLINE Vec8V V8Dot3(const Vec8V ax, const Vec8V ay, const Vec8V az, const Vec8V bx, const Vec8V by, const Vec8V bz)
+{
+	return V8MulAdd(az, bz, V8MulAdd(ay, by, V8Mul(ax, bx)));
+}
+
+PX_AVX2_FORCE_INLINE Vec8V V8IsGrtr(const Vec8V a, const Vec8V b)		{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ);			}
+PX_AVX2_FORCE_INLINE Vec8V V8IsGrtrOrEq(const Vec8V a, const Vec8V b)	{ return _mm256_cmp_ps(a, b, _CMP_GE_OQ);			}
+PX_AVX2_FORCE_INLINE Vec8V V8IsEq(const Vec8V a, const Vec8V b)		{ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);			}
+PX_AVX2_FORCE_INLINE Vec8V V8And(const Vec8V a, const Vec8V b)			{ return _mm256_and_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8Or(const Vec8V a, const Vec8V b)			{ return _mm256_or_ps(a, b);						}
+PX_AVX2_FORCE_INLINE Vec8V V8AndNot(const Vec8V a, const Vec8V b)		{ return _mm256_andnot_ps(b, a);					}	// a & ~b
+
+// Lanes of a where c is set, lanes of b elsewhere.
+PX_AVX2_FORCE_INLINE Vec8V V8Sel(const Vec8V c, const Vec8V a, const Vec8V b)	{ return _mm256_blendv_ps(b, a, c);	}
+
+// One bit per lane, lane 0 in bit 0.
+PX_AVX2_FORCE_INLINE PxU32 V8GetMask(const Vec8V c)					{ return PxU32(_mm256_movemask_ps(c));				}
+PX_AVX2_FORCE_INLINE bool V8AllTrue(const Vec8V c)						{ return V8GetMask(c) == 0xff;						}
+PX_AVX2_FORCE_INLINE bool V8AnyTrue(const Vec8V c)						{ return V8GetMask(c) != 0;							}
+
+// Avoids the AVX to SSE transition penalty when returning to SSE code. Compilers usually insert this automatically.
+PX_AVX2_FORCE_INLINE void V8ZeroUpper()								{ _mm256_zeroupper();								}
+
+#undef PX_AVX2_FORCE_INLINE
+
+} // namespace aos
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif // PX_AVX2_SUPPORTED
+
+#endif
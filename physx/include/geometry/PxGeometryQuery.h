@@ -43,6 +43,7 @@ The reason for this is GJK support cannot be evaluated near infinity. A viable a
 #include "geometry/PxGeometryHit.h"
 #include "geometry/PxGeometryQueryFlags.h"
 #include "geometry/PxGeometryQueryContext.h"
+#include "geometry/PxRayPacket.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -87,6 +88,30 @@ public:
 												PxU32 maxHits, PxGeomRaycastHit* PX_RESTRICT rayHits, PxU32 stride = sizeof(PxGeomRaycastHit), PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT,
 												PxRaycastThreadContext* threadContext = NULL);
 
+	/**
+	\brief Raycast test of a packet of rays against a geometry object.
+
+	Triangle meshes use a packet traversal of their midphase structure, see PxMeshQuery::raycastPacket(). Other geometry types
+	are tested one ray at a time. In all cases each ray returns the same closest hit as the corresponding raycast() call with maxHits = 1.
+
+	\param[in] packet			The rays to test the geometry object against. Directions must be normalized.
+	\param[in] geom				The geometry object to test the rays against
+	\param[in] pose				Pose of the geometry object
+	\param[in] hitFlags			Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags
+	\param[out] rayHits			Raycast hits, one per ray of the packet (packet.nbRays entries). rayHits[i] is only written if ray i hits the object.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Bit mask of the rays hitting the geometry object: bit i is set if ray i has a hit.
+
+	\see PxRayPacket PxMeshQuery::raycastPacket raycast
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycastPacket(	const PxRayPacket& packet,
+													const PxGeometry& geom, const PxTransform& pose,
+													PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT rayHits,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT,
+													PxRaycastThreadContext* threadContext = NULL);
+
 	/**
 	\brief Overlap test for two geometry objects.
 
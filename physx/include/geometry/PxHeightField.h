@@ -224,6 +224,40 @@ class PxHeightField : public PxRefCounted
 	*/
 	virtual		PxU32	getTimestamp()	const	= 0;
 
+	/**
+	\brief Returns the number of samples per side of the tiles of a tiled heightfield.
+
+	\return The tile size, or 0 if the heightfield is not tiled.
+
+	\see PxHeightFieldDesc.tileLoader PxHeightFieldDesc.tileSize
+	*/
+	virtual		PxU32	getTileSize()	const	= 0;
+
+	/**
+	\brief Returns the number of tiles currently paged in, for tiled heightfields.
+
+	\return The number of resident tiles.
+
+	\see PxHeightFieldDesc.maxNbResidentTiles trimTileCache()
+	*/
+	virtual		PxU32	getNbResidentTiles()	const	= 0;
+
+	/**
+	\brief Evicts tiles from the tile cache of a tiled heightfield.
+
+	Tiles are paged in on demand but they are never evicted while the heightfield is in use, since the collision detection
+	and the scene queries keep references to the samples. This function evicts the least recently used tiles until no more
+	than PxHeightFieldDesc::maxNbResidentTiles tiles are resident. Tiles used since the previous call are evicted last.
+
+	\note This function must not be called while a scene using this heightfield is simulating, or while scene queries
+	against it are running. A good place for it is after PxScene::fetchResults().
+
+	\return The number of evicted tiles.
+
+	\see PxHeightFieldDesc.maxNbResidentTiles getNbResidentTiles()
+	*/
+	virtual		PxU32	trimTileCache()	= 0;
+
 	virtual	const char*	getConcreteTypeName() const	PX_OVERRIDE	PX_FINAL	{ return "PxHeightField"; }
 
 protected:
@@ -32,6 +32,7 @@
 #include "common/PxPhysXCommonConfig.h"
 #include "geometry/PxHeightFieldFlag.h"
 #include "common/PxCoreUtilityTypes.h"
+#include "geometry/PxHeightFieldTileLoader.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -126,6 +127,59 @@ public:
 	*/
 	PxHeightFieldFlags		flags;
 
+	/**
+	\brief Optional loader for tiled heightfields.
+
+	If set, the heightfield does not copy any sample data. The samples are paged in by tiles of tileSize x tileSize samples
+	when they are needed by the collision detection or the scene queries, and kept in a tile cache. The samples member must
+	then be left empty. This is meant for very large terrains that would not fit in memory, or that would otherwise have to
+	be split into many heightfield actors.
+
+	\note Tiled heightfields cannot be modified with PxHeightField::modifySamples() or used with GPU dynamics. Cooking them
+	to a stream or serializing them pages in all the tiles and produces a regular heightfield.
+
+	<b>Default:</b> NULL
+
+	\see PxHeightFieldTileLoader PxHeightField::trimTileCache()
+	*/
+	PxHeightFieldTileLoader*		tileLoader;
+
+	/**
+	\brief Number of samples per side of a tile, for tiled heightfields.
+
+	<b>Range:</b> power of two in [16, 4096]<br>
+	<b>Default:</b> 256
+
+	\see tileLoader
+	*/
+	PxU32							tileSize;
+
+	/**
+	\brief Number of tiles kept in memory, for tiled heightfields.
+
+	The memory for these tiles is allocated when the heightfield is created. If a simulation step or a query needs more
+	tiles, the extra tiles are temporarily allocated and released by the next call to PxHeightField::trimTileCache().
+
+	<b>Range:</b> [1, PX_MAX_U32)<br>
+	<b>Default:</b> 64
+
+	\see tileLoader PxHeightField::trimTileCache()
+	*/
+	PxU32							maxNbResidentTiles;
+
+	/**
+	\brief Height range of each tile, required for tiled heightfields.
+
+	Array of ceil(nbRows / tileSize) * ceil(nbColumns / tileSize) entries, in row-major order. The bounds let the collision
+	detection and the scene queries reject tiles without paging them in, so no tile is paged in when the heightfield is created.
+	The array is only read during creation.
+
+	<b>Default:</b> NULL
+
+	\see tileLoader PxHeightFieldTileBounds
+	*/
+	const PxHeightFieldTileBounds*	tileBounds;
+
 	/**
 	\brief Constructor sets to default.
 	*/
@@ -150,6 +204,10 @@ PX_INLINE PxHeightFieldDesc::PxHeightFieldDesc()	//constructor sets to default
 	format						= PxHeightFieldFormat::eS16_TM;
 	convexEdgeThreshold			= 0.0f;
 	flags						= PxHeightFieldFlags();
+	tileLoader					= NULL;
+	tileSize					= 256;
+	maxNbResidentTiles			= 64;
+	tileBounds					= NULL;
 }
 
 PX_INLINE void PxHeightFieldDesc::setToDefault()
@@ -165,7 +223,16 @@ PX_INLINE bool PxHeightFieldDesc::isValid() const
 		return false;
 	if(format != PxHeightFieldFormat::eS16_TM)
 		return false;
-	if (samples.stride < 4)
+	if (tileLoader)
+	{
+		if (samples.data || !tileBounds)
+			return false;
+		if (tileSize < 16 || tileSize > 4096 || (tileSize & (tileSize - 1)))
+			return false;
+		if (maxNbResidentTiles < 1)
+			return false;
+	}
+	else if (samples.stride < 4)
 		return false;
 	if (convexEdgeThreshold < 0)
 		return false;
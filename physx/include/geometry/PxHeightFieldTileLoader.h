@@ -0,0 +1,90 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_HEIGHT_FIELD_TILE_LOADER_H
+#define PX_HEIGHT_FIELD_TILE_LOADER_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "geometry/PxHeightFieldSample.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Height range of the samples of a heightfield tile.
+
+\see PxHeightFieldDesc.tileBounds
+*/
+struct PxHeightFieldTileBounds
+{
+	PxI16	minHeight;	//!< Smallest PxHeightFieldSample::height of the tile
+	PxI16	maxHeight;	//!< Largest PxHeightFieldSample::height of the tile
+};
+
+/**
+\brief Callback used to page in the samples of a tiled heightfield.
+
+A tiled heightfield does not store its samples. It is divided into square tiles of PxHeightFieldDesc::tileSize
+samples per side, which are requested from this callback the first time a query or the collision detection
+touches them, and which are kept in a cache of PxHeightFieldDesc::maxNbResidentTiles tiles.
+
+The callback is called from the threads running the simulation or the scene queries. Calls are serialized
+by the heightfield, so the implementation does not need to be thread-safe itself. It must not call the PhysX API.
+
+\see PxHeightFieldDesc.tileLoader PxHeightField::trimTileCache()
+*/
+class PxHeightFieldTileLoader
+{
+public:
+	/**
+	\brief Loads the samples of a tile.
+
+	The tile covers the sample rows [firstRow, firstRow + nbRows) and the sample columns [firstColumn, firstColumn + nbColumns).
+	Tiles on the last row or column of tiles can be smaller than the tile size.
+
+	\param[in] firstRow First sample row of the tile
+	\param[in] firstColumn First sample column of the tile
+	\param[in] nbRows Number of sample rows in the tile
+	\param[in] nbColumns Number of sample columns in the tile
+	\param[out] samples Destination buffer. Sample (row, column) of the tile must be written to samples[(row - firstRow) * rowStride + column - firstColumn].
+	\param[in] rowStride Number of samples between two rows in the destination buffer
+	\return True on success. If the tile cannot be loaded, its cells are treated as holes.
+	*/
+	virtual	bool	loadTile(PxU32 firstRow, PxU32 firstColumn, PxU32 nbRows, PxU32 nbColumns, PxHeightFieldSample* samples, PxU32 rowStride) = 0;
+
+protected:
+	virtual			~PxHeightFieldTileLoader() {}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -35,6 +35,7 @@
 #include "geometry/PxGeometryHit.h"
 #include "geometry/PxGeometryQueryFlags.h"
 #include "geometry/PxReportCallback.h"
+#include "geometry/PxRayPacket.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -273,6 +274,35 @@ public:
 							const PxReal inflation = 0.0f,
 							bool doubleSided = false,
 							PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
+	/**
+	\brief Raycasts a packet of rays against a triangle mesh.
+
+	For meshes using the BVH34 midphase, the rays of the packet traverse the mesh's BV4 tree together: each tree node is
+	fetched once for the whole packet and culled against the packet's bounds before the rays are tested individually. Rays
+	are grouped by direction octant, and a ray that ends up alone in a group or in a subtree continues with the regular
+	single-ray traversal. Each ray returns the same hit as the corresponding PxGeometryQuery::raycast() call.
+
+	For meshes using the BVH33 midphase, or when PxHitFlag::eANY_HIT or PxHitFlag::eMESH_MULTIPLE is requested, the rays
+	are processed one at a time.
+
+	\param[in] packet			The rays to test against the mesh. Directions must be normalized.
+	\param[in] meshGeom		The triangle mesh geometry
+	\param[in] pose			Pose of the triangle mesh
+	\param[in] hitFlags		Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags
+	\param[out] rayHits		Raycast hits, one per ray of the packet (packet.nbRays entries). rayHits[i] is only written if ray i hits the mesh.
+	\param[in] queryFlags		Optional flags controlling the query.
+
+	\return Bit mask of the rays hitting the mesh: bit i is set if ray i has a hit.
+
+	\note Only the closest hit is reported for each ray. PxHitFlag::eMESH_MULTIPLE is ignored.
+
+	\see PxRayPacket PxGeometryQuery::raycast PxGeometryQuery::raycastPacket
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycastPacket(	const PxRayPacket& packet,
+													const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+													PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT rayHits,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 };
 
 
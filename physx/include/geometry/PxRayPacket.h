@@ -0,0 +1,102 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_RAY_PACKET_H
+#define PX_RAY_PACKET_H
+
+#include "foundation/PxVec3.h"
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Maximum number of rays in a PxRayPacket.
+*/
+#define PX_RAY_PACKET_MAX_SIZE	16
+
+/**
+\brief A packet of rays in SoA layout, for packet raycast queries.
+
+Packets of 4, 8 or 16 rays are the typical use case. Rays of a packet should be coherent, i.e. have similar origins and
+directions (for example neighbouring rays of a sensor fan), for the packet traversal to be efficient. Incoherent rays are
+supported but processed individually.
+
+\see PxMeshQuery::raycastPacket PxGeometryQuery::raycastPacket
+*/
+struct PxRayPacket
+{
+	PxReal	originX[PX_RAY_PACKET_MAX_SIZE];	//!< X coordinates of ray origins
+	PxReal	originY[PX_RAY_PACKET_MAX_SIZE];	//!< Y coordinates of ray origins
+	PxReal	originZ[PX_RAY_PACKET_MAX_SIZE];	//!< Z coordinates of ray origins
+	PxReal	dirX[PX_RAY_PACKET_MAX_SIZE];		//!< X coordinates of normalized ray directions
+	PxReal	dirY[PX_RAY_PACKET_MAX_SIZE];		//!< Y coordinates of normalized ray directions
+	PxReal	dirZ[PX_RAY_PACKET_MAX_SIZE];		//!< Z coordinates of normalized ray directions
+	PxReal	maxDist[PX_RAY_PACKET_MAX_SIZE];	//!< Ray lengths, in the [0, inf) range
+	PxU32	nbRays;								//!< Number of rays in the packet, at most PX_RAY_PACKET_MAX_SIZE
+
+	PX_INLINE	PxRayPacket() : nbRays(0)	{}
+
+	/**
+	\brief Sets ray i of the packet.
+	*/
+	PX_INLINE	void	setRay(PxU32 i, const PxVec3& origin, const PxVec3& unitDir, PxReal distance)
+	{
+		PX_ASSERT(i<PX_RAY_PACKET_MAX_SIZE);
+		originX[i] = origin.x;	originY[i] = origin.y;	originZ[i] = origin.z;
+		dirX[i] = unitDir.x;	dirY[i] = unitDir.y;	dirZ[i] = unitDir.z;
+		maxDist[i] = distance;
+	}
+
+	PX_INLINE	PxVec3	getOrigin(PxU32 i)	const	{ return PxVec3(originX[i], originY[i], originZ[i]);	}
+	PX_INLINE	PxVec3	getDir(PxU32 i)		const	{ return PxVec3(dirX[i], dirY[i], dirZ[i]);				}
+
+	/**
+	\brief Returns true if the packet is valid.
+	*/
+	PX_INLINE	bool	isValid()	const
+	{
+		if(nbRays>PX_RAY_PACKET_MAX_SIZE)
+			return false;
+		for(PxU32 i=0;i<nbRays;i++)
+		{
+			const PxVec3 dir = getDir(i);
+			if(!getOrigin(i).isFinite() || !dir.isFinite() || PxAbs(dir.magnitudeSquared()-1.0f)>=1e-4f)
+				return false;
+			if(!(maxDist[i]>=0.0f) || !PxIsFinite(maxDist[i]))
+				return false;
+		}
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#endif
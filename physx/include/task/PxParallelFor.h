@@ -0,0 +1,199 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_PARALLEL_FOR_H
+#define PX_PARALLEL_FOR_H
+
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxMath.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+#define PX_PARALLEL_FOR_MAX_NB_HELPERS	64
+
+/**
+\brief Work items processed by PxParallelFor().
+
+process() is called exactly once for each index, possibly from several threads at the same time.
+
+\see PxParallelFor
+*/
+class PxParallelForWork
+{
+public:
+	/**
+	\brief Processes one work item.
+	\param[in] index The index of the work item, in [0, nb) where nb is the count passed to PxParallelFor().
+	*/
+	virtual	void	process(PxU32 index)	= 0;
+
+protected:
+	virtual			~PxParallelForWork()	{}
+};
+
+#if !PX_DOXYGEN
+class PxParallelForJob;
+
+// Helper task of PxParallelFor(). The tasks are stored in, and owned by, their job.
+class PxParallelForTask : public PxBaseTask
+{
+public:
+	virtual	void		run()			PX_OVERRIDE;
+	virtual	const char*	getName()		const	PX_OVERRIDE;
+	virtual	void		addReference()			PX_OVERRIDE	{}
+	virtual	void		removeReference()		PX_OVERRIDE	{}
+	virtual	int32_t		getReference()	const	PX_OVERRIDE	{ return 1;	}
+	virtual	void		release()				PX_OVERRIDE;
+
+	PxParallelForJob*	mJob;
+};
+
+// Helper tasks are fire-and-forget: the dispatcher can run them long after PxParallelFor() returned. So the job is
+// ref-counted and freed by whoever releases it last, and the work object is only accessed for indices that have been
+// claimed before all of them were processed.
+class PxParallelForJob
+{
+public:
+	PxParallelForJob(PxParallelForWork& work, PxU32 nb, PxU32 nbTasks, const char* name, PxAllocatorCallback* allocator) :
+		mWork(&work), mName(name), mAllocator(allocator), mNext(0), mDone(0), mNb(PxI32(nb)), mRefCount(PxI32(nbTasks + 1))
+	{
+		for(PxU32 i = 0; i < nbTasks; i++)
+			mTasks[i].mJob = this;
+	}
+
+	void execute()
+	{
+		PxI32 index;
+		while((index = PxAtomicIncrement(&mNext) - 1) < mNb)
+		{
+			mWork->process(PxU32(index));
+			PxAtomicIncrement(&mDone);
+		}
+	}
+
+	void releaseReference()
+	{
+		if(PxAtomicDecrement(&mRefCount))
+			return;
+
+		PxAllocatorCallback* allocator = mAllocator;
+		this->~PxParallelForJob();
+		if(allocator)
+			allocator->deallocate(this);
+		else
+			PxAllocator::deallocate(this);
+	}
+
+	PxParallelForWork*		mWork;
+	const char*				mName;
+	PxAllocatorCallback*	mAllocator;
+	volatile PxI32			mNext;
+	volatile PxI32			mDone;
+	const PxI32				mNb;
+	volatile PxI32			mRefCount;
+	PxParallelForTask		mTasks[PX_PARALLEL_FOR_MAX_NB_HELPERS];
+};
+
+PX_INLINE void PxParallelForTask::run()
+{
+	mJob->execute();
+}
+
+PX_INLINE const char* PxParallelForTask::getName() const
+{
+	return mJob->mName;
+}
+
+PX_INLINE void PxParallelForTask::release()
+{
+	mJob->releaseReference();
+}
+#endif
+
+/**
+\brief Calls work.process(i) for each i in [0, nb), on the calling thread and on up to one helper task per worker thread of the dispatcher.
+
+The calling thread processes work items as well, and only waits for the items already claimed by running helper tasks. It never waits
+for tasks that have not started, so this function can be called from a worker thread of the same dispatcher without deadlocking.
+Everything runs on the calling thread if the dispatcher is NULL or if there is a single work item.
+
+Work items are claimed in index order but can complete in any order. Split the work in a number of items that does not depend on the
+number of threads to get deterministic results.
+
+\param[in] dispatcher	The dispatcher running the helper tasks, or NULL.
+\param[in] work			The work items. Only accessed until the function returns.
+\param[in] nb			The number of work items.
+\param[in] name			Name of the helper tasks, as returned by PxBaseTask::getName(). Must be a string literal or outlive the helper tasks.
+\param[in] allocator	Allocator for the helper tasks, or NULL to use the foundation allocator.
+
+\see PxParallelForWork PxCpuDispatcher
+*/
+PX_INLINE void PxParallelFor(PxCpuDispatcher* dispatcher, PxParallelForWork& work, PxU32 nb, const char* name = "PxParallelFor", PxAllocatorCallback* allocator = NULL)
+{
+	const PxU32 nbTasks = (dispatcher && nb) ? PxMin(PxMin(dispatcher->getWorkerCount(), nb - 1), PxU32(PX_PARALLEL_FOR_MAX_NB_HELPERS)) : 0;
+	if(!nbTasks)
+	{
+		for(PxU32 i = 0; i < nb; i++)
+			work.process(i);
+		return;
+	}
+
+	void* memory = allocator ? allocator->allocate(sizeof(PxParallelForJob), "PxParallelForJob", PX_FL) : PxAllocator::allocate(sizeof(PxParallelForJob), PX_FL);
+	PxParallelForJob* job = PX_PLACEMENT_NEW(memory, PxParallelForJob)(work, nb, nbTasks, name, allocator);
+	for(PxU32 i = 0; i < nbTasks; i++)
+		dispatcher->submitTask(job->mTasks[i]);
+
+	job->execute();
+
+	while(job->mDone != PxI32(nb))
+		PxThread::yield();
+	PxMemoryBarrier();
+
+	job->releaseReference();
+}
+
+/**
+\brief Returns the number of chunks of chunkSize elements needed for nb elements, i.e. a work item count for PxParallelFor().
+*/
+PX_FORCE_INLINE PxU32 PxParallelForGetNbChunks(PxU32 nb, PxU32 chunkSize)
+{
+	return (nb + chunkSize - 1) / chunkSize;
+}
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
+
@@ -63,6 +63,52 @@ struct PxTaskType
 
 class PxCpuDispatcher;
 
+/**
+\brief Invalid task ID, returned when a task cannot be found or created.
+
+\see PxTaskManager::getNamedTask
+*/
+#define PX_INVALID_TASK_ID	PxTaskID(0xffffffff)
+
+/**
+\brief Per-task timing callback for heavyweight PxTask objects.
+
+Timestamps are raw counter values, see PxTime::getCurrentCounterValue(). The time between taskReady() and taskCompleted()
+includes the time spent by the task in the CPU dispatcher's queue. Together with the dependencies of a frozen task graph
+(see PxTaskManager::getSuccessors()) this gives the critical path through the PxTask objects of a frame.
+
+\note Only PxTask objects submitted with PxTaskManager::submitNamedTask() or PxTaskManager::submitUnnamedTask() are
+reported. PxLightCpuTask objects bypass the task manager's dependency tracking and are not reported. This includes the
+simulation tasks of PxScene, so the callback does not time the SDK's own work.
+
+The callbacks are called from the threads resolving dependencies and completing tasks, i.e. possibly from several threads
+at the same time. Implementations must be thread-safe and should be cheap.
+
+\see PxTaskManager::setTimingCallback
+*/
+class PxTaskTimingCallback
+{
+public:
+	/**
+	\brief Called when all dependencies of a task are resolved and the task is submitted to the CPU dispatcher.
+
+	\param[in] task		The task
+	\param[in] timestamp	Counter value at dispatch time
+	*/
+	virtual void	taskReady(const PxTask& task, PxU64 timestamp) = 0;
+
+	/**
+	\brief Called when a task has completed, before its dependencies are resolved.
+
+	\param[in] task		The task
+	\param[in] timestamp	Counter value at completion time
+	*/
+	virtual void	taskCompleted(const PxTask& task, PxU64 timestamp) = 0;
+
+protected:
+	virtual ~PxTaskTimingCallback() {}
+};
+
 /** 
  \brief The PxTaskManager interface
  
@@ -130,7 +176,8 @@ public:
 	\brief Retrieve a task by name
 
 	\param[in] name The unique name of a task
-	\return The ID of the task with that name, or eNOT_PRESENT if not found
+	\return The ID of the task with that name. Unknown names are registered as placeholder tasks, unless the task graph
+	is frozen in which case PX_INVALID_TASK_ID is returned.
 	*/
 	virtual PxTaskID  getNamedTask(const char* name) = 0;
 
@@ -163,6 +210,56 @@ public:
 	*/
 	virtual PxTask*   getTaskFromID(PxTaskID id) = 0;
 
+	/**
+	\brief Freeze the task graph.
+
+	Call this once all tasks of the frame have been submitted and all dependencies declared, before startSimulation().
+	The dependencies are then compacted into per-task successor arrays and resolved with atomic operations only:
+	taskCompleted(), dispatching and reference counting no longer take the task manager's lock. This helps large graphs
+	of PxTask objects executed by many threads.
+
+	Until the next resetDependencies() call the graph cannot be modified: submitting new tasks, declaring dependencies
+	and looking up unknown names are invalid operations and are ignored with an error.
+
+	\note The frozen graph only lasts until the next resetDependencies() call, and has to be rebuilt and frozen again
+	for each frame. It is meant for applications that drive the task manager themselves. A task manager controlled by a
+	PxScene is reset by every PxScene::simulate() call. The SDK does not freeze it, and its simulation tasks are
+	PxLightCpuTask objects that are not part of the graph.
+
+	\see resetDependencies isFrozen getSuccessors
+	*/
+	virtual void	freezeDependencies() = 0;
+
+	/**
+	\brief Returns true if the task graph has been frozen with freezeDependencies().
+	*/
+	virtual bool	isFrozen() const = 0;
+
+	/**
+	\brief Retrieve the successors of a task, i.e. the tasks that depend on it, in a frozen task graph.
+
+	\param[in] taskID		The ID of the task
+	\param[out] successors	Pointer to the IDs of the successors. Valid until the next resetDependencies() call.
+	\return The number of successors, or 0 if the task graph is not frozen.
+
+	\see freezeDependencies
+	*/
+	virtual PxU32	getSuccessors(PxTaskID taskID, const PxTaskID*& successors) const = 0;
+
+	/**
+	\brief Set the per-task timing callback.
+
+	\param[in] callback	The callback, or NULL to disable timing.
+
+	\see PxTaskTimingCallback
+	*/
+	virtual void	setTimingCallback(PxTaskTimingCallback* callback) = 0;
+
+	/**
+	\brief Get the per-task timing callback.
+	*/
+	virtual PxTaskTimingCallback*	getTimingCallback() const = 0;
+
 	/**
 	\brief Release the PxTaskManager object, referenced dispatchers will not be released
 	*/
@@ -36,6 +36,9 @@
 #include "vehicle2/PxVehicleFunctions.h"
 #include "vehicle2/PxVehicleMaths.h"
 
+#include "vehicle2/batch/PxVehicleBatchParams.h"
+#include "vehicle2/batch/PxVehicleBatch.h"
+
 #include "vehicle2/braking/PxVehicleBrakingParams.h"
 #include "vehicle2/braking/PxVehicleBrakingFunctions.h"
 
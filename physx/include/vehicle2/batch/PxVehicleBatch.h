@@ -0,0 +1,172 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+#include "foundation/PxFoundation.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/batch/PxVehicleBatchParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+
+class PxAllocatorCallback;
+class PxCpuDispatcher;
+
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleCommandState;
+struct PxVehicleDirectDriveTransmissionCommandState;
+struct PxVehicleRigidBodyState;
+struct PxVehicleRoadGeometryState;
+struct PxVehicleSuspensionState;
+struct PxVehicleSuspensionForce;
+struct PxVehicleTireForce;
+struct PxVehicleWheelRigidBody1dState;
+
+/**
+\brief A batch of direct drive vehicles that share the same PxVehicleBatchParams layout.
+
+The vehicles of a batch are stored in structure-of-arrays form, in groups of 4 vehicles. Each call to update()
+runs the command response, road geometry query, suspension, tire, direct drivetrain, rigid body and wheel stages
+of all vehicles of the batch, one stage at a time over all wheels of a group:
+
+\li The road geometry queries of all wheels of all vehicles are issued as a single PxBatchQueryExt.
+\li The suspension force, tire, direct drivetrain, rigid body and wheel rotation stages process 4 vehicles per SIMD lane.
+\li The stages that depend on the steer and compliance rotations of each wheel (suspension jounce, tire directions and
+camber angle) reuse the scalar vehicle2 functions, one vehicle at a time.
+\li If a PxCpuDispatcher is provided, the groups are simulated in parallel.
+
+A batch produces the same results as the equivalent per-vehicle component sequence simulated with
+PxVehicleRigidBodyComponent, up to floating-point rounding. The simulation of a vehicle does not depend on the other
+vehicles of the batch or on the number of worker threads.
+
+\note Vehicles are referenced by their index in the batch, in range [0, getNbVehicles()). Removing a vehicle moves the
+last vehicle of the batch to the index of the removed vehicle.
+\note Anti-roll bars and PhysX sticky tire constraints are not supported. As with PxVehicleTireComponent, active sticky
+tire states only zero the corresponding tire slips.
+\see PxVehicleBatchCreate PxVehicleBatchParams
+*/
+class PxVehicleBatch
+{
+public:
+
+	/**
+	\brief Release the batch and all its vehicles.
+	*/
+	virtual void release() = 0;
+
+	virtual const PxVehicleBatchParams& getParams() const = 0;
+
+	virtual PxU32 getNbVehicles() const = 0;
+
+	virtual PxU32 getMaxNbVehicles() const = 0;
+
+	/**
+	\brief Add a vehicle to the batch.
+	\param[in] rigidBodyState is the initial state of the vehicle's rigid body.
+	\return The index of the new vehicle or 0xffffffff if the batch is full.
+	\note The suspension, tire and wheel states of the new vehicle are set to their default values and its commands are zero.
+	*/
+	virtual PxU32 addVehicle(const PxVehicleRigidBodyState& rigidBodyState) = 0;
+
+	/**
+	\brief Remove a vehicle from the batch.
+	\param[in] vehicleIndex is the index of the vehicle to remove.
+	\note The last vehicle of the batch is moved to vehicleIndex.
+	*/
+	virtual void removeVehicle(PxU32 vehicleIndex) = 0;
+
+	/**
+	\brief Set the commands that will be applied to a vehicle during the next update().
+	*/
+	virtual void setCommands(PxU32 vehicleIndex, const PxVehicleCommandState& commands,
+		const PxVehicleDirectDriveTransmissionCommandState& transmissionCommands) = 0;
+
+	virtual void setRigidBodyState(PxU32 vehicleIndex, const PxVehicleRigidBodyState& rigidBodyState) = 0;
+
+	/**
+	\note previousLinearVelocity and previousAngularVelocity are the velocities at the start of the last update().
+	*/
+	virtual void getRigidBodyState(PxU32 vehicleIndex, PxVehicleRigidBodyState& rigidBodyState) const = 0;
+
+	/**
+	\brief Set the road geometry under a wheel.
+	\note This is only needed if the road geometry query type is PxVehiclePhysXRoadGeometryQueryType::eNONE. With eRAYCAST,
+	update() overwrites the road geometry states.
+	*/
+	virtual void setRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, const PxVehicleRoadGeometryState& roadGeometryState) = 0;
+
+	virtual void getRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleRoadGeometryState& roadGeometryState) const = 0;
+
+	virtual void getSuspensionState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionState& suspensionState) const = 0;
+
+	virtual void getSuspensionForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionForce& suspensionForce) const = 0;
+
+	virtual void getTireForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleTireForce& tireForce) const = 0;
+
+	virtual void getWheelRigidBody1dState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleWheelRigidBody1dState& wheelState) const = 0;
+
+	/**
+	\brief Simulate all vehicles of the batch.
+	\param[in] dt is the timestep of the update. The suspension, tire, drivetrain and rigid body stages run
+	PxVehicleBatchParams::nbSubsteps substeps of dt/nbSubsteps.
+	\param[in] context is the simulation context. context.physxScene is queried if the road geometry query type is
+	PxVehiclePhysXRoadGeometryQueryType::eRAYCAST.
+	\param[in] dispatcher is an optional CPU dispatcher. If provided, the road geometry queries and the vehicle groups are
+	processed in parallel, and the calling thread takes part in the work.
+	\note The scene must not be modified during the update.
+	*/
+	virtual void update(const PxReal dt, const PxVehiclePhysXSimulationContext& context, PxCpuDispatcher* dispatcher = NULL) = 0;
+
+protected:
+
+	virtual ~PxVehicleBatch() {}
+};
+
+/**
+\brief Create a batch of vehicles that share the same layout.
+\param[in] params is the layout shared by all vehicles of the batch. It is copied by the batch.
+\param[in] maxNbVehicles is the maximum number of vehicles of the batch.
+\param[in] allocator is used for all allocations of the batch.
+\return The new batch, or NULL if the parameters are invalid.
+\note The pointers in params (material frictions, filter data entries, filter callback) are not copied and must
+remain valid for the lifetime of the batch.
+\see PxVehicleBatch::release
+*/
+PxVehicleBatch* PxVehicleBatchCreate(const PxVehicleBatchParams& params, const PxU32 maxNbVehicles, PxAllocatorCallback& allocator);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
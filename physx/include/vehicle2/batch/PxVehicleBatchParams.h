@@ -0,0 +1,177 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+#include "foundation/PxFoundation.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/braking/PxVehicleBrakingParams.h"
+#include "vehicle2/drivetrain/PxVehicleDrivetrainParams.h"
+#include "vehicle2/physxRoadGeometry/PxVehiclePhysXRoadGeometryParams.h"
+#include "vehicle2/rigidBody/PxVehicleRigidBodyParams.h"
+#include "vehicle2/steering/PxVehicleSteeringParams.h"
+#include "vehicle2/suspension/PxVehicleSuspensionParams.h"
+#include "vehicle2/tire/PxVehicleTireParams.h"
+#include "vehicle2/wheel/PxVehicleWheelParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief The layout shared by all vehicles of a PxVehicleBatch.
+
+A batch simulates many direct drive vehicles that share the same axle description, wheels, suspension, tires and
+command responses. Only the rigid body state, the commands and the per wheel states differ from one vehicle to the next.
+Vehicles with different layouts are simulated with one batch per layout.
+
+\note The parameters mirror the parameters of the vehicle components that make up a direct drive vehicle simulated
+with PxVehicleRigidBodyComponent: PxVehicleDirectDriveCommandResponseComponent, PxVehiclePhysXRoadGeometrySceneQueryComponent,
+PxVehicleSuspensionComponent, PxVehicleTireComponent, PxVehicleDirectDrivetrainComponent, PxVehicleRigidBodyComponent and
+PxVehicleWheelComponent.
+\see PxVehicleBatch PxVehicleBatchCreate
+*/
+struct PxVehicleBatchParams
+{
+	PxVehicleAxleDescription axleDescription;
+
+	/**
+	\brief The brake command responses. brakeResponseParams[i] is paired with PxVehicleCommandState::brakes[i].
+	*/
+	PxVehicleBrakeCommandResponseParams brakeResponseParams[2];
+
+	PxVehicleSteerCommandResponseParams steerResponseParams;
+
+	/**
+	\brief Optional Ackermann steer correction.
+	\note Ackermann correction is only applied if nbAckermannParams is greater than zero.
+	*/
+	PxVehicleAckermannParams ackermannParams[1];
+	PxU32 nbAckermannParams;
+
+	PxVehicleDirectDriveThrottleCommandResponseParams throttleResponseParams;
+
+	/**
+	\brief The type of road geometry query issued for each wheel and the filter data used by the query.
+	\note Only PxVehiclePhysXRoadGeometryQueryType::eRAYCAST and PxVehiclePhysXRoadGeometryQueryType::eNONE are supported.
+	With eNONE, the road geometry state of each wheel is provided with PxVehicleBatch::setRoadGeometryState().
+	\note The filter callback must be thread safe if a PxCpuDispatcher is passed to PxVehicleBatch::update().
+	*/
+	PxVehiclePhysXRoadGeometryQueryParams roadGeometryQueryParams;
+
+	/**
+	\brief The mapping from PxMaterial to friction, per wheel.
+	*/
+	PxVehiclePhysXMaterialFrictionParams materialFrictionParams[PxVehicleLimits::eMAX_NB_WHEELS];
+
+	/**
+	\note Only PxVehicleSuspensionJounceCalculationType::eRAYCAST is supported.
+	*/
+	PxVehicleSuspensionStateCalculationParams suspensionStateCalculationParams;
+
+	PxVehicleSuspensionParams suspensionParams[PxVehicleLimits::eMAX_NB_WHEELS];
+	PxVehicleSuspensionComplianceParams suspensionComplianceParams[PxVehicleLimits::eMAX_NB_WHEELS];
+	PxVehicleSuspensionForceParams suspensionForceParams[PxVehicleLimits::eMAX_NB_WHEELS];
+
+	PxVehicleTireForceParams tireForceParams[PxVehicleLimits::eMAX_NB_WHEELS];
+
+	PxVehicleWheelParams wheelParams[PxVehicleLimits::eMAX_NB_WHEELS];
+
+	PxVehicleRigidBodyParams rigidBodyParams;
+
+	/**
+	\brief The number of substeps of the suspension, tire, drivetrain and rigid body stages per call to PxVehicleBatch::update().
+	<b>Range:</b> [1, inf)<br>
+	*/
+	PxU32 nbSubsteps;
+
+	PX_FORCE_INLINE bool isValid() const
+	{
+		if (!axleDescription.isValid())
+			return false;
+		PX_CHECK_AND_RETURN_VAL(nbSubsteps > 0, "PxVehicleBatchParams.nbSubsteps must be greater than zero", false);
+
+		if (!brakeResponseParams[0].isValid(axleDescription))
+			return false;
+		if (!brakeResponseParams[1].isValid(axleDescription))
+			return false;
+		if (!steerResponseParams.isValid(axleDescription))
+			return false;
+		PX_CHECK_AND_RETURN_VAL(nbAckermannParams <= 1, "PxVehicleBatchParams.nbAckermannParams must be 0 or 1", false);
+		if (nbAckermannParams && !ackermannParams[0].isValid(axleDescription))
+			return false;
+		if (!throttleResponseParams.isValid(axleDescription))
+			return false;
+
+		if (!roadGeometryQueryParams.isValid())
+			return false;
+		PX_CHECK_AND_RETURN_VAL(roadGeometryQueryParams.roadGeometryQueryType != PxVehiclePhysXRoadGeometryQueryType::eSWEEP,
+			"PxVehicleBatchParams.roadGeometryQueryParams.roadGeometryQueryType must be eRAYCAST or eNONE", false);
+
+		if (!suspensionStateCalculationParams.isValid())
+			return false;
+		PX_CHECK_AND_RETURN_VAL(suspensionStateCalculationParams.suspensionJounceCalculationType == PxVehicleSuspensionJounceCalculationType::eRAYCAST,
+			"PxVehicleBatchParams.suspensionStateCalculationParams.suspensionJounceCalculationType must be eRAYCAST", false);
+
+		for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription.wheelIdsInAxleOrder[i];
+
+			if (!materialFrictionParams[wheelId].isValid())
+				return false;
+
+			if (!suspensionParams[wheelId].isValid())
+				return false;
+			if (!suspensionComplianceParams[wheelId].isValid())
+				return false;
+			if (!suspensionForceParams[wheelId].isValid())
+				return false;
+
+			if (!tireForceParams[wheelId].isValid())
+				return false;
+
+			if (!wheelParams[wheelId].isValid())
+				return false;
+		}
+
+		if (!rigidBodyParams.isValid())
+			return false;
+
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
@@ -57,6 +57,10 @@ SET(PVDRUNTIME_SOURCES
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdDefinesInternal.h
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdHelpers.h
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdHelpers.cpp
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdCompression.h
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdCompression.cpp
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdDeltaCache.h
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdDeltaCache.cpp
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdLibraryFunctionsImpl.cpp
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdLog.h
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdLog.cpp
@@ -66,6 +70,8 @@ SET(PVDRUNTIME_SOURCES
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdWriterImpl.cpp
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdFileReadStreamImpl.h
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdFileReadStreamImpl.cpp
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdCompressedReadStreamImpl.h
+  ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdCompressedReadStreamImpl.cpp
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdFileWriteStreamImpl.h
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdFileWriteStreamImpl.cpp
   ${PHYSX_ROOT_DIR}/pvdruntime/src/OmniPvdMemoryStreamImpl.h
@@ -41,4 +41,5 @@ SET(PVDRUNTIME_COMPILE_DEFS
 )
 
 SET(PVDRUNTIME_PLATFORM_LINKED_LIBS 
+	pthread
 )
@@ -46,7 +46,8 @@ struct OmniPvdCommand
 		eDESTROY_OBJECT,
 		eSTART_FRAME,
 		eSTOP_FRAME,
-		eRECORD_MESSAGE
+		eRECORD_MESSAGE,
+		eSET_ATTRIBUTE_DELTA // stream only, the reader returns it as eSET_ATTRIBUTE
 	};
 };
 
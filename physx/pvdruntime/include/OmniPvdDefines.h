@@ -32,12 +32,17 @@
 #define OMNI_PVD_INVALID_HANDLE 0
 
 #define OMNI_PVD_VERSION_MAJOR 0
-#define OMNI_PVD_VERSION_MINOR 4
+#define OMNI_PVD_VERSION_MINOR 5
 #define OMNI_PVD_VERSION_PATCH 0
 
 ////////////////////////////////////////////////////////////////////////////////
 // Versions so far : (major, minor, patch), top one is newest
 //
+// [0, 5,  0]
+//   add new eSET_ATTRIBUTE_DELTA command, small attribute values are written as a byte mask
+//   against the previously set value of the same object attribute. only written when enabled with
+//   OmniPvdWriter::setDeltaEncoding().
+//   streams can optionally be wrapped in a compressed block container (see OmniPvdFileWriteStream)
 // [0, 4,  0]
 //   add new eRECORD_MESSAGE command to record messages in the OVD stream.
 // [0, 3,  0]
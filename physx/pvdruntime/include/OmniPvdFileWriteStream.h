@@ -63,6 +63,24 @@ public:
 	 * \return True if the file closing was successfull
 	 */
 	virtual bool OMNI_PVD_CALL closeFile() = 0;
+
+	/**
+	 * \brief Enables asynchronous compressed writing
+	 *
+	 * Written bytes are then only copied into an in-memory block. Full blocks are compressed and written
+	 * to the file by a background thread while the next block is being filled, so writeBytes() only waits
+	 * when the background thread falls behind by more than a block. flush() and closeFile() wait for all
+	 * pending blocks to be written. The file is decoded transparently by OmniPvdReader.
+	 *
+	 * Has to be set before the file is opened, it is disabled by default. Streams that do not support it
+	 * ignore the call and keep writing synchronously.
+	 *
+	 * \param enabled True to enable asynchronous compressed writing
+	 */
+	virtual void OMNI_PVD_CALL setAsyncCompression(bool enabled)
+	{
+		(void)enabled;
+	}
 };
 
 #endif
@@ -390,7 +390,22 @@ public:
 	 *
 	 */	
 	virtual void OMNI_PVD_CALL clearStatus() = 0;
-	
+
+	/**
+	 * \brief Enables delta encoding of small attribute values
+	 *
+	 * Small attribute values (poses, velocities, bounds...) are then written as a byte mask against the previous value of the
+	 * same object attribute, plus the bytes that changed. This makes the stream smaller, but it can only be read by readers
+	 * supporting stream version 0.5 or newer.
+	 *
+	 * Disabled by default. Writers that do not support it ignore the call.
+	 *
+	 * \param enabled True to enable delta encoding
+	 */
+	virtual void OMNI_PVD_CALL setDeltaEncoding(bool enabled)
+	{
+		(void)enabled;
+	}
 };
 
 #endif
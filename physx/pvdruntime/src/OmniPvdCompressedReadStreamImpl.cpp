@@ -0,0 +1,172 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "OmniPvdCompressedReadStreamImpl.h"
+#include "OmniPvdCompression.h"
+#include "OmniPvdDefinesInternal.h"
+#include <string.h>
+
+OmniPvdCompressedReadStreamImpl::OmniPvdCompressedReadStreamImpl()
+{
+	mPackedBuffer = 0;
+	mRawBuffer = 0;
+	reset();
+}
+
+OmniPvdCompressedReadStreamImpl::~OmniPvdCompressedReadStreamImpl()
+{
+	reset();
+}
+
+void OmniPvdCompressedReadStreamImpl::reset()
+{
+	delete[] mPackedBuffer;
+	delete[] mRawBuffer;
+	mPackedBuffer = 0;
+	mRawBuffer = 0;
+	mSourceStream = 0;
+	mBlockSize = 0;
+	mRawSize = 0;
+	mReadPos = 0;
+	mIsCorrupt = false;
+}
+
+bool OmniPvdCompressedReadStreamImpl::readHeader(OmniPvdReadStream& sourceStream)
+{
+	reset();
+	uint32_t containerVersion = 0;
+	uint32_t blockSize = 0;
+	if ((sourceStream.readBytes((uint8_t*)&containerVersion, sizeof(uint32_t)) != sizeof(uint32_t)) ||
+		(sourceStream.readBytes((uint8_t*)&blockSize, sizeof(uint32_t)) != sizeof(uint32_t)))
+	{
+		return false;
+	}
+	if ((containerVersion > OMNI_PVD_COMPRESSED_STREAM_VERSION) || (blockSize == 0))
+	{
+		return false;
+	}
+	mSourceStream = &sourceStream;
+	mBlockSize = blockSize;
+	mRawBuffer = new uint8_t[mBlockSize];
+	mPackedBuffer = new uint8_t[mBlockSize];
+	return true;
+}
+
+bool OmniPvdCompressedReadStreamImpl::readNextBlock()
+{
+	mRawSize = 0;
+	mReadPos = 0;
+	if (!mSourceStream || mIsCorrupt)
+	{
+		return false;
+	}
+	uint32_t rawSize = 0;
+	uint32_t packedSize = 0;
+	if ((mSourceStream->readBytes((uint8_t*)&rawSize, sizeof(uint32_t)) != sizeof(uint32_t)) ||
+		(mSourceStream->readBytes((uint8_t*)&packedSize, sizeof(uint32_t)) != sizeof(uint32_t)))
+	{
+		// End of the stream
+		return false;
+	}
+	if ((rawSize > mBlockSize) || (packedSize > rawSize))
+	{
+		mIsCorrupt = true;
+		return false;
+	}
+	if (packedSize == rawSize)
+	{
+		// Stored block
+		if (mSourceStream->readBytes(mRawBuffer, rawSize) != rawSize)
+		{
+			mIsCorrupt = true;
+			return false;
+		}
+	}
+	else
+	{
+		if ((mSourceStream->readBytes(mPackedBuffer, packedSize) != packedSize) ||
+			!omniPvdDecompressBlock(mPackedBuffer, packedSize, mRawBuffer, rawSize))
+		{
+			mIsCorrupt = true;
+			return false;
+		}
+	}
+	mRawSize = rawSize;
+	return true;
+}
+
+uint64_t OMNI_PVD_CALL OmniPvdCompressedReadStreamImpl::readBytes(uint8_t* bytes, uint64_t nbrBytes)
+{
+	uint64_t nbrBytesRead = 0;
+	while (nbrBytesRead < nbrBytes)
+	{
+		if ((mReadPos == mRawSize) && !readNextBlock())
+		{
+			break;
+		}
+		uint64_t n = mRawSize - mReadPos;
+		if (n > (nbrBytes - nbrBytesRead))
+		{
+			n = nbrBytes - nbrBytesRead;
+		}
+		memcpy(bytes + nbrBytesRead, mRawBuffer + mReadPos, size_t(n));
+		mReadPos += uint32_t(n);
+		nbrBytesRead += n;
+	}
+	return nbrBytesRead;
+}
+
+uint64_t OMNI_PVD_CALL OmniPvdCompressedReadStreamImpl::skipBytes(uint64_t nbrBytes)
+{
+	uint64_t nbrBytesSkipped = 0;
+	while (nbrBytesSkipped < nbrBytes)
+	{
+		if ((mReadPos == mRawSize) && !readNextBlock())
+		{
+			break;
+		}
+		uint64_t n = mRawSize - mReadPos;
+		if (n > (nbrBytes - nbrBytesSkipped))
+		{
+			n = nbrBytes - nbrBytesSkipped;
+		}
+		mReadPos += uint32_t(n);
+		nbrBytesSkipped += n;
+	}
+	return nbrBytesSkipped;
+}
+
+bool OMNI_PVD_CALL OmniPvdCompressedReadStreamImpl::openStream()
+{
+	return mSourceStream ? mSourceStream->openStream() : false;
+}
+
+bool OMNI_PVD_CALL OmniPvdCompressedReadStreamImpl::closeStream()
+{
+	return mSourceStream ? mSourceStream->closeStream() : false;
+}
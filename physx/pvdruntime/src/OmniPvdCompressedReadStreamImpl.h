@@ -0,0 +1,66 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef OMNI_PVD_COMPRESSED_READ_STREAM_IMPL_H
+#define OMNI_PVD_COMPRESSED_READ_STREAM_IMPL_H
+
+#include "OmniPvdReadStream.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Decodes a compressed stream container (see OmniPvdDefinesInternal.h) read from
+// a source stream. Used internally by OmniPvdReaderImpl once the container magic
+// has been found at the start of the stream.
+////////////////////////////////////////////////////////////////////////////////
+class OmniPvdCompressedReadStreamImpl : public OmniPvdReadStream
+{
+public:
+	OmniPvdCompressedReadStreamImpl();
+	~OmniPvdCompressedReadStreamImpl();
+
+	void reset();
+	// Reads the container header following the magic word, returns false if the container version is not supported
+	bool readHeader(OmniPvdReadStream& sourceStream);
+
+	uint64_t OMNI_PVD_CALL readBytes(uint8_t* bytes, uint64_t nbrBytes);
+	uint64_t OMNI_PVD_CALL skipBytes(uint64_t nbrBytes);
+	bool OMNI_PVD_CALL openStream();
+	bool OMNI_PVD_CALL closeStream();
+
+	bool readNextBlock();
+
+	OmniPvdReadStream* mSourceStream;
+	uint32_t mBlockSize;
+
+	uint8_t* mPackedBuffer;
+	uint8_t* mRawBuffer;
+	uint32_t mRawSize;
+	uint32_t mReadPos;
+	bool mIsCorrupt;
+};
+
+#endif
@@ -0,0 +1,210 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "OmniPvdCompression.h"
+#include <string.h>
+
+#define OMNI_PVD_LZ_MIN_MATCH		4
+#define OMNI_PVD_LZ_MAX_OFFSET		65535
+#define OMNI_PVD_LZ_LAST_LITERALS	5	// the last bytes are always literals, so that matches never need to be bounds checked against the end
+
+static inline uint32_t readU32(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(uint32_t));
+	return v;
+}
+
+static inline uint32_t hashU32(uint32_t v)
+{
+	return (v * 2654435761u) >> (32 - OMNI_PVD_LZ_HASH_BITS);
+}
+
+static inline uint8_t* writeLength(uint8_t* op, uint32_t len)
+{
+	while (len >= 255)
+	{
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = uint8_t(len);
+	return op;
+}
+
+static uint8_t* writeGroup(uint8_t* op, const uint8_t* literals, uint32_t nbLiterals, uint32_t offset, uint32_t matchLen)
+{
+	uint8_t* token = op++;
+	const uint32_t litCode = nbLiterals < 15 ? nbLiterals : 15;
+	if (litCode == 15)
+	{
+		op = writeLength(op, nbLiterals - 15);
+	}
+	memcpy(op, literals, nbLiterals);
+	op += nbLiterals;
+
+	uint32_t matchCode = 0;
+	if (matchLen)
+	{
+		*op++ = uint8_t(offset & 0xff);
+		*op++ = uint8_t(offset >> 8);
+		const uint32_t len = matchLen - OMNI_PVD_LZ_MIN_MATCH;
+		matchCode = len < 15 ? len : 15;
+		if (matchCode == 15)
+		{
+			op = writeLength(op, len - 15);
+		}
+	}
+	*token = uint8_t((litCode << 4) | matchCode);
+	return op;
+}
+
+uint32_t omniPvdCompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstCapacity, uint32_t* hashTable)
+{
+	if (dstCapacity < omniPvdCompressBound(srcSize))
+	{
+		return 0;
+	}
+
+	// Positions are stored +1 so that the zero initialized table means "no candidate"
+	uint32_t* table = hashTable;
+	memset(table, 0, OMNI_PVD_LZ_HASH_TABLE_SIZE * sizeof(uint32_t));
+
+	uint8_t* op = dst;
+	uint32_t anchor = 0;
+	uint32_t pos = 0;
+	const uint32_t matchLimit = srcSize > OMNI_PVD_LZ_LAST_LITERALS ? srcSize - OMNI_PVD_LZ_LAST_LITERALS : 0;
+
+	while (pos + OMNI_PVD_LZ_MIN_MATCH <= matchLimit)
+	{
+		const uint32_t seq = readU32(src + pos);
+		const uint32_t h = hashU32(seq);
+		const uint32_t candidate = table[h];
+		table[h] = pos + 1;
+
+		if (candidate && (pos - (candidate - 1)) <= OMNI_PVD_LZ_MAX_OFFSET && readU32(src + candidate - 1) == seq)
+		{
+			const uint32_t ref = candidate - 1;
+			uint32_t matchLen = OMNI_PVD_LZ_MIN_MATCH;
+			while (pos + matchLen < matchLimit && src[ref + matchLen] == src[pos + matchLen])
+			{
+				matchLen++;
+			}
+			op = writeGroup(op, src + anchor, pos - anchor, pos - ref, matchLen);
+
+			// Feed the table with the position just before the end of the match, cheap and improves the next lookups
+			pos += matchLen;
+			anchor = pos;
+			if (pos - 2 + OMNI_PVD_LZ_MIN_MATCH <= matchLimit)
+			{
+				table[hashU32(readU32(src + pos - 2))] = pos - 2 + 1;
+			}
+		}
+		else
+		{
+			pos++;
+		}
+	}
+
+	// Trailing literals
+	op = writeGroup(op, src + anchor, srcSize - anchor, 0, 0);
+
+	const uint32_t packedSize = uint32_t(op - dst);
+	return packedSize < srcSize ? packedSize : 0;
+}
+
+static inline bool readLength(const uint8_t*& ip, const uint8_t* ipEnd, uint32_t& len)
+{
+	uint8_t b;
+	do
+	{
+		if (ip >= ipEnd)
+		{
+			return false;
+		}
+		b = *ip++;
+		len += b;
+	} while (b == 255);
+	return true;
+}
+
+bool omniPvdDecompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize)
+{
+	const uint8_t* ip = src;
+	const uint8_t* ipEnd = src + srcSize;
+	uint8_t* op = dst;
+	uint8_t* opEnd = dst + dstSize;
+
+	while (ip < ipEnd)
+	{
+		const uint8_t token = *ip++;
+
+		uint32_t nbLiterals = token >> 4;
+		if (nbLiterals == 15 && !readLength(ip, ipEnd, nbLiterals))
+		{
+			return false;
+		}
+		if (nbLiterals > uint32_t(ipEnd - ip) || nbLiterals > uint32_t(opEnd - op))
+		{
+			return false;
+		}
+		memcpy(op, ip, nbLiterals);
+		ip += nbLiterals;
+		op += nbLiterals;
+
+		if (ip == ipEnd)
+		{
+			// Last group, literals only
+			break;
+		}
+
+		if (ipEnd - ip < 2)
+		{
+			return false;
+		}
+		const uint32_t offset = uint32_t(ip[0]) | (uint32_t(ip[1]) << 8);
+		ip += 2;
+		uint32_t matchLen = token & 15;
+		if (matchLen == 15 && !readLength(ip, ipEnd, matchLen))
+		{
+			return false;
+		}
+		matchLen += OMNI_PVD_LZ_MIN_MATCH;
+		if (offset == 0 || offset > uint32_t(op - dst) || matchLen > uint32_t(opEnd - op))
+		{
+			return false;
+		}
+		// Byte by byte, matches can overlap their own output
+		const uint8_t* ref = op - offset;
+		for (uint32_t i = 0; i < matchLen; i++)
+		{
+			op[i] = ref[i];
+		}
+		op += matchLen;
+	}
+	return op == opEnd;
+}
@@ -0,0 +1,65 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef OMNI_PVD_COMPRESSION_H
+#define OMNI_PVD_COMPRESSION_H
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Built-in LZ77 block codec used by the compressed stream container.
+//
+// A packed block is a sequence of (token, literals, match) groups, the same layout
+// as LZ4 blocks : the high nibble of the token is the literal count, the low nibble
+// the match length minus 4, both extended by 255-bytes when saturated (15). The
+// match is a 16 bit little endian backward offset. The last group only has literals.
+//
+// The OVD stream is dominated by repeated command headers, context and object
+// handles and attribute handle paths, which this matches very well at a cost far
+// below the file IO it saves.
+////////////////////////////////////////////////////////////////////////////////
+
+// Size of the hash table used by omniPvdCompressBlock, in uint32_t entries
+#define OMNI_PVD_LZ_HASH_BITS		14
+#define OMNI_PVD_LZ_HASH_TABLE_SIZE	(1u << OMNI_PVD_LZ_HASH_BITS)
+
+// Worst case packed size for a block of rawSize bytes
+inline uint32_t omniPvdCompressBound(uint32_t rawSize)
+{
+	return rawSize + rawSize / 255 + 16;
+}
+
+// Returns the packed size, or 0 if the block does not compress (in which case it should be stored raw).
+// dst must be at least omniPvdCompressBound(srcSize) bytes. hashTable is scratch memory of OMNI_PVD_LZ_HASH_TABLE_SIZE
+// entries, allocated by the caller so that it can be reused for all the blocks.
+uint32_t omniPvdCompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstCapacity, uint32_t* hashTable);
+
+// Returns true if exactly dstSize bytes were decoded from the packed block
+bool omniPvdDecompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize);
+
+#endif
@@ -36,5 +36,28 @@
 typedef uint8_t OmniPvdCommandStorageType;
 typedef uint16_t OmniPvdDataTypeStorageType;
 
+////////////////////////////////////////////////////////////////////////////////
+// Compressed stream container, see OmniPvdCompression.h
+//
+// A compressed stream starts with the magic word (which can never be a valid
+// major version), the container version and the uncompressed block size,
+// followed by blocks of (rawSize, packedSize, packed bytes). A block with
+// packedSize equal to rawSize is stored uncompressed.
+////////////////////////////////////////////////////////////////////////////////
+#define OMNI_PVD_COMPRESSED_STREAM_MAGIC	0x5A44564F	// "OVDZ"
+#define OMNI_PVD_COMPRESSED_STREAM_VERSION	1
+#define OMNI_PVD_COMPRESSED_BLOCK_SIZE		(1024 * 1024)
+
+////////////////////////////////////////////////////////////////////////////////
+// Attribute delta encoding, see OmniPvdDeltaCache.h
+//
+// Only small attributes (transforms, velocities, bounds...) addressed by a short
+// attribute handle path are delta-encoded. The byte mask of the delta command is
+// a uint32_t, one bit per data byte.
+////////////////////////////////////////////////////////////////////////////////
+#define OMNI_PVD_DELTA_MAX_DATA_BYTES		32
+#define OMNI_PVD_DELTA_MAX_HANDLES			4
+#define OMNI_PVD_DELTA_MAX_ENTRIES			(256 * 1024)
+
 
 #endif
@@ -0,0 +1,138 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "OmniPvdDeltaCache.h"
+#include <string.h>
+
+#define OMNI_PVD_DELTA_INITIAL_CAPACITY 1024
+
+static inline uint64_t mix64(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return h;
+}
+
+static uint32_t hashKey(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles)
+{
+	uint64_t h = mix64(contextHandle ^ mix64(objectHandle));
+	for (uint8_t i = 0; i < nbAttributeHandles; i++)
+	{
+		h = mix64(h ^ attributeHandles[i]);
+	}
+	return uint32_t(h);
+}
+
+static inline bool keyMatches(const OmniPvdDeltaEntry& entry, OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles)
+{
+	return (entry.mObjectHandle == objectHandle) && (entry.mContextHandle == contextHandle) && (entry.mNbAttributeHandles == nbAttributeHandles) &&
+		(memcmp(entry.mAttributeHandles, attributeHandles, nbAttributeHandles * sizeof(OmniPvdAttributeHandle)) == 0);
+}
+
+OmniPvdDeltaCache::OmniPvdDeltaCache()
+{
+	mEntries = 0;
+	mCapacity = 0;
+	mNbEntries = 0;
+}
+
+OmniPvdDeltaCache::~OmniPvdDeltaCache()
+{
+	delete[] mEntries;
+}
+
+void OmniPvdDeltaCache::reset()
+{
+	delete[] mEntries;
+	mEntries = 0;
+	mCapacity = 0;
+	mNbEntries = 0;
+}
+
+uint32_t OmniPvdDeltaCache::findSlot(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles) const
+{
+	// Linear probing, the load factor is kept at or below 1/2 so there always is a free slot
+	const uint32_t mask = mCapacity - 1;
+	uint32_t slot = hashKey(contextHandle, objectHandle, attributeHandles, nbAttributeHandles) & mask;
+	while (mEntries[slot].mNbAttributeHandles && !keyMatches(mEntries[slot], contextHandle, objectHandle, attributeHandles, nbAttributeHandles))
+	{
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+OmniPvdDeltaEntry* OmniPvdDeltaCache::find(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles)
+{
+	if (!mNbEntries)
+	{
+		return 0;
+	}
+	OmniPvdDeltaEntry& entry = mEntries[findSlot(contextHandle, objectHandle, attributeHandles, nbAttributeHandles)];
+	return entry.mNbAttributeHandles ? &entry : 0;
+}
+
+void OmniPvdDeltaCache::grow()
+{
+	OmniPvdDeltaEntry* oldEntries = mEntries;
+	const uint32_t oldCapacity = mCapacity;
+
+	mCapacity = oldCapacity ? oldCapacity * 2 : OMNI_PVD_DELTA_INITIAL_CAPACITY;
+	mEntries = new OmniPvdDeltaEntry[mCapacity];
+	memset(mEntries, 0, mCapacity * sizeof(OmniPvdDeltaEntry));
+
+	for (uint32_t i = 0; i < oldCapacity; i++)
+	{
+		const OmniPvdDeltaEntry& entry = oldEntries[i];
+		if (entry.mNbAttributeHandles)
+		{
+			mEntries[findSlot(entry.mContextHandle, entry.mObjectHandle, entry.mAttributeHandles, entry.mNbAttributeHandles)] = entry;
+		}
+	}
+	delete[] oldEntries;
+}
+
+OmniPvdDeltaEntry* OmniPvdDeltaCache::insert(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles)
+{
+	if (mNbEntries >= OMNI_PVD_DELTA_MAX_ENTRIES)
+	{
+		return 0;
+	}
+	if ((mNbEntries + 1) * 2 > mCapacity)
+	{
+		grow();
+	}
+	OmniPvdDeltaEntry& entry = mEntries[findSlot(contextHandle, objectHandle, attributeHandles, nbAttributeHandles)];
+	entry.mContextHandle = contextHandle;
+	entry.mObjectHandle = objectHandle;
+	memcpy(entry.mAttributeHandles, attributeHandles, nbAttributeHandles * sizeof(OmniPvdAttributeHandle));
+	entry.mNbAttributeHandles = nbAttributeHandles;
+	entry.mNbBytes = 0;
+	mNbEntries++;
+	return &entry;
+}
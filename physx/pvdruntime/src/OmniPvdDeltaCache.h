@@ -0,0 +1,83 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef OMNI_PVD_DELTA_CACHE_H
+#define OMNI_PVD_DELTA_CACHE_H
+
+#include "OmniPvdDefines.h"
+#include "OmniPvdDefinesInternal.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Last value set for each small object attribute, keyed by (context, object,
+// attribute handle path). The writer uses it to emit eSET_ATTRIBUTE_DELTA
+// commands, the reader keeps an identical copy to decode them.
+//
+// Both sides must make the exact same insertion decisions, so entries are never
+// removed (handles of destroyed objects may be reused, a delta against a stale
+// value still decodes correctly) and new keys are only added as long as
+// OMNI_PVD_DELTA_MAX_ENTRIES is not reached.
+////////////////////////////////////////////////////////////////////////////////
+struct OmniPvdDeltaEntry
+{
+	OmniPvdContextHandle	mContextHandle;
+	OmniPvdObjectHandle		mObjectHandle;
+	OmniPvdAttributeHandle	mAttributeHandles[OMNI_PVD_DELTA_MAX_HANDLES];
+	uint8_t					mNbAttributeHandles;	// 0 for an unused slot
+	uint8_t					mNbBytes;
+	uint8_t					mData[OMNI_PVD_DELTA_MAX_DATA_BYTES];
+};
+
+class OmniPvdDeltaCache
+{
+public:
+	OmniPvdDeltaCache();
+	~OmniPvdDeltaCache();
+
+	void reset();
+
+	static bool isEligible(uint8_t nbAttributeHandles, uint32_t nbBytes)
+	{
+		return (nbAttributeHandles > 0) && (nbAttributeHandles <= OMNI_PVD_DELTA_MAX_HANDLES) && (nbBytes > 0) && (nbBytes <= OMNI_PVD_DELTA_MAX_DATA_BYTES);
+	}
+
+	// Returns the entry for the key, NULL if it isn't in the cache. Only for eligible keys.
+	OmniPvdDeltaEntry* find(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles);
+
+	// Adds a key that find() did not return, returns NULL if the cache is full. The data must be set by the caller.
+	OmniPvdDeltaEntry* insert(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles);
+
+private:
+	uint32_t findSlot(OmniPvdContextHandle contextHandle, OmniPvdObjectHandle objectHandle, const OmniPvdAttributeHandle* attributeHandles, uint8_t nbAttributeHandles) const;
+	void grow();
+
+	OmniPvdDeltaEntry* mEntries;
+	uint32_t mCapacity;	// power of two
+	uint32_t mNbEntries;
+};
+
+#endif
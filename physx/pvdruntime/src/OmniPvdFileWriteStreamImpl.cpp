@@ -27,10 +27,18 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "OmniPvdFileWriteStreamImpl.h"
+#include "OmniPvdCompression.h"
+#include "OmniPvdDefinesInternal.h"
 
 OmniPvdFileWriteStreamImpl::OmniPvdFileWriteStreamImpl()
 {
-	mFileName = 0;	
+	mFileName = 0;
+	mAsyncCompression = false;
+	mWorkerRunning = false;
+	mBlocks[0] = 0;
+	mBlocks[1] = 0;
+	mPackedBlock = 0;
+	mHashTable = 0;
 	resetFileParams();
 }
 
@@ -62,6 +70,15 @@ void OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::setFileName(const char* fileName)
 	mFileName[n - 1] = 0;
 }
 
+void OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::setAsyncCompression(bool enabled)
+{
+	if (mFileOpenAttempted)
+	{
+		return;
+	}
+	mAsyncCompression = enabled;
+}
+
 bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::openFile()
 {
 	if (mFileOpenAttempted)
@@ -84,6 +101,19 @@ bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::openFile()
 #else
 	mPFile = fopen(mFileName, "wb");
 #endif
+	if (mPFile && mAsyncCompression)
+	{
+		const uint32_t header[3] = { OMNI_PVD_COMPRESSED_STREAM_MAGIC, OMNI_PVD_COMPRESSED_STREAM_VERSION, OMNI_PVD_COMPRESSED_BLOCK_SIZE };
+		if (fwrite(header, sizeof(header), 1, mPFile) != 1)
+		{
+			fclose(mPFile);
+			mPFile = 0;
+		}
+		else
+		{
+			startWorker();
+		}
+	}
 	return (mPFile!=0);
 }
 
@@ -92,6 +122,10 @@ bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::closeFile()
 	bool returnOK = true;
 	if (mFileOpenAttempted && (mPFile!=0))
 	{
+		if (mWorkerRunning)
+		{
+			stopWorker();
+		}
 		fclose(mPFile);
 	}
 	else
@@ -107,7 +141,34 @@ uint64_t OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::writeBytes(const uint8_t *byt
 	size_t result = 0;
 	if (mPFile!=0)
 	{
-		result = fwrite(bytes, 1, nbrBytes, mPFile);
+		if (mWorkerRunning)
+		{
+			while (nbrBytes > 0)
+			{
+				uint64_t n = OMNI_PVD_COMPRESSED_BLOCK_SIZE - mFillSize;
+				if (n > nbrBytes)
+				{
+					n = nbrBytes;
+				}
+				memcpy(mBlocks[mFillBlock] + mFillSize, bytes, size_t(n));
+				mFillSize += uint32_t(n);
+				bytes += n;
+				nbrBytes -= n;
+				result += size_t(n);
+				if (mFillSize == OMNI_PVD_COMPRESSED_BLOCK_SIZE)
+				{
+					submitFillBlock();
+				}
+			}
+			if (mWriteFailed)
+			{
+				result = 0;
+			}
+		}
+		else
+		{
+			result = fwrite(bytes, 1, nbrBytes, mPFile);
+		}
 	}
 	return result;
 }
@@ -118,6 +179,15 @@ bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::flush()
 	{
 		return false;
 	}
+	if (mWorkerRunning)
+	{
+		if (mFillSize > 0)
+		{
+			submitFillBlock();
+		}
+		std::unique_lock<std::mutex> lock(mMutex);
+		waitForPendingBlock(lock);
+	}
 	return fflush(mPFile) != 0;
 }
 
@@ -130,3 +200,112 @@ bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::closeStream()
 {
 	return closeFile();
 }
+
+void OmniPvdFileWriteStreamImpl::startWorker()
+{
+	mBlocks[0] = new uint8_t[OMNI_PVD_COMPRESSED_BLOCK_SIZE];
+	mBlocks[1] = new uint8_t[OMNI_PVD_COMPRESSED_BLOCK_SIZE];
+	mPackedBlock = new uint8_t[omniPvdCompressBound(OMNI_PVD_COMPRESSED_BLOCK_SIZE)];
+	mHashTable = new uint32_t[OMNI_PVD_LZ_HASH_TABLE_SIZE];
+	mFillBlock = 0;
+	mFillSize = 0;
+	mPendingBlock = -1;
+	mPendingSize = 0;
+	mQuitWorker = false;
+	mWriteFailed = false;
+	mWorker = std::thread(&OmniPvdFileWriteStreamImpl::workerLoop, this);
+	mWorkerRunning = true;
+}
+
+void OmniPvdFileWriteStreamImpl::stopWorker()
+{
+	if (mFillSize > 0)
+	{
+		submitFillBlock();
+	}
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		waitForPendingBlock(lock);
+		mQuitWorker = true;
+	}
+	mCondition.notify_all();
+	mWorker.join();
+	mWorkerRunning = false;
+
+	delete[] mBlocks[0];
+	delete[] mBlocks[1];
+	delete[] mPackedBlock;
+	delete[] mHashTable;
+	mBlocks[0] = 0;
+	mBlocks[1] = 0;
+	mPackedBlock = 0;
+	mHashTable = 0;
+}
+
+void OmniPvdFileWriteStreamImpl::waitForPendingBlock(std::unique_lock<std::mutex>& lock)
+{
+	while (mPendingBlock >= 0)
+	{
+		mCondition.wait(lock);
+	}
+}
+
+void OmniPvdFileWriteStreamImpl::submitFillBlock()
+{
+	{
+		// Only blocks if the worker is still busy with the previous block
+		std::unique_lock<std::mutex> lock(mMutex);
+		waitForPendingBlock(lock);
+		mPendingBlock = int(mFillBlock);
+		mPendingSize = mFillSize;
+	}
+	mCondition.notify_all();
+	mFillBlock ^= 1;
+	mFillSize = 0;
+}
+
+void OmniPvdFileWriteStreamImpl::workerLoop()
+{
+	for (;;)
+	{
+		int block;
+		uint32_t size;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			while ((mPendingBlock < 0) && !mQuitWorker)
+			{
+				mCondition.wait(lock);
+			}
+			if (mPendingBlock < 0)
+			{
+				return;
+			}
+			block = mPendingBlock;
+			size = mPendingSize;
+		}
+
+		const bool success = writeBlock(mBlocks[block], size);
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			if (!success)
+			{
+				mWriteFailed = true;
+			}
+			mPendingBlock = -1;
+		}
+		mCondition.notify_all();
+	}
+}
+
+bool OmniPvdFileWriteStreamImpl::writeBlock(const uint8_t* rawBlock, uint32_t rawSize)
+{
+	const uint32_t packedSize = omniPvdCompressBlock(rawBlock, rawSize, mPackedBlock, omniPvdCompressBound(OMNI_PVD_COMPRESSED_BLOCK_SIZE), mHashTable);
+	const uint32_t blockHeader[2] = { rawSize, packedSize ? packedSize : rawSize };
+	if (fwrite(blockHeader, sizeof(blockHeader), 1, mPFile) != 1)
+	{
+		return false;
+	}
+	const uint8_t* payload = packedSize ? mPackedBlock : rawBlock;
+	return fwrite(payload, 1, blockHeader[1], mPFile) == blockHeader[1];
+}
@@ -33,6 +33,10 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 class OmniPvdFileWriteStreamImpl : public OmniPvdFileWriteStream {
 public:
@@ -42,6 +46,7 @@ public:
 	void OMNI_PVD_CALL setFileName(const char *fileName);
 	bool OMNI_PVD_CALL openFile();
 	bool OMNI_PVD_CALL closeFile();
+	void OMNI_PVD_CALL setAsyncCompression(bool enabled);
 	uint64_t OMNI_PVD_CALL writeBytes(const uint8_t* bytes, uint64_t nbrBytes);
 	bool OMNI_PVD_CALL flush();
 	bool OMNI_PVD_CALL openStream();
@@ -50,6 +55,33 @@ public:
 	char *mFileName;
 	FILE *mPFile;
 	bool mFileOpenAttempted;
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Asynchronous compressed writing. The caller fills mBlocks[mFillBlock] while
+	// the worker thread compresses and writes mBlocks[mPendingBlock], if any.
+	////////////////////////////////////////////////////////////////////////////////
+	void startWorker();
+	void stopWorker();
+	void submitFillBlock();
+	void waitForPendingBlock(std::unique_lock<std::mutex>& lock);
+	void workerLoop();
+	bool writeBlock(const uint8_t* rawBlock, uint32_t rawSize);
+
+	bool mAsyncCompression;
+	bool mWorkerRunning;
+	uint8_t* mBlocks[2];
+	uint8_t* mPackedBlock;
+	uint32_t* mHashTable; // scratch memory of the compressor, only used by the worker thread
+	uint32_t mFillBlock;
+	uint32_t mFillSize;
+
+	std::thread mWorker;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	int mPendingBlock; // -1 when the worker is idle
+	uint32_t mPendingSize;
+	bool mQuitWorker;
+	std::atomic<bool> mWriteFailed;
 };
 
 #endif
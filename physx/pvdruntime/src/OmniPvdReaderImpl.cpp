@@ -30,6 +30,7 @@
 #include "OmniPvdReaderImpl.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 
 OmniPvdReaderImpl::OmniPvdReaderImpl()
@@ -61,6 +62,8 @@ void OMNI_PVD_CALL OmniPvdReaderImpl::setReadStream(OmniPvdReadStream& stream)
 {
 	mStream = &stream;
 	mStream->openStream();
+	mCompressedStream.reset();
+	mDeltaCache.reset();
 }
 
 bool OMNI_PVD_CALL OmniPvdReaderImpl::startReading(OmniPvdVersionType& majorVersion, OmniPvdVersionType& minorVersion, OmniPvdVersionType& patch)
@@ -72,6 +75,20 @@ bool OMNI_PVD_CALL OmniPvdReaderImpl::startReading(OmniPvdVersionType& majorVers
 	if (mStream)
 	{
 		mStream->readBytes((uint8_t*)&majorVersion, sizeof(OmniPvdVersionType));
+		////////////////////////////////////////////////////////////////////////////////
+		// A compressed stream container is decoded transparently, the OVD stream with
+		// its version header follows inside the compressed blocks
+		////////////////////////////////////////////////////////////////////////////////
+		if (majorVersion == OMNI_PVD_COMPRESSED_STREAM_MAGIC)
+		{
+			if (!mCompressedStream.readHeader(*mStream))
+			{
+				mLog.outputLine("[parser] unsupported compressed stream version\n");
+				return false;
+			}
+			mStream = &mCompressedStream;
+			mStream->readBytes((uint8_t*)&majorVersion, sizeof(OmniPvdVersionType));
+		}
 		mStream->readBytes((uint8_t*)&minorVersion, sizeof(OmniPvdVersionType));
 		mStream->readBytes((uint8_t*)&patch, sizeof(OmniPvdVersionType));
 
@@ -237,17 +254,56 @@ OmniPvdCommand::Enum OMNI_PVD_CALL OmniPvdReaderImpl::getNextCommand()
 					cmdType = OmniPvdCommand::eSET_ATTRIBUTE;
 					mStream->readBytes((uint8_t*)&mCmdContextHandle, sizeof(OmniPvdContextHandle));
 					mStream->readBytes((uint8_t*)&mCmdObjectHandle, sizeof(OmniPvdObjectHandle));
-					mStream->readBytes((uint8_t*)&mCmdAttributeHandleDepth, sizeof(uint8_t));
-					uint32_t* attributeHandleStack = mCmdAttributeHandleStack;
-					for (int i = 0; i < mCmdAttributeHandleDepth; i++) {
-						mStream->readBytes((uint8_t*)&mCmdAttributeHandle, sizeof(OmniPvdAttributeHandle));
-						attributeHandleStack++;
-					}
+					readAttributeHandlesFromStream();
 					mStream->readBytes((uint8_t*)&mCmdAttributeDataLen, sizeof(uint32_t));
 					readLongDataFromStream(mCmdAttributeDataLen);
+					updateDeltaCache();
 					mLog.outputLine("[parser] set attribute (contextHandle:%d, objectHandle: %d, attributeHandle: %d, dataLen: %d)\n", mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandle, mCmdAttributeDataLen);
 				}
 				break;
+				case OmniPvdCommand::eSET_ATTRIBUTE_DELTA:
+				{
+					////////////////////////////////////////////////////////////////////////////////
+					// Decoded against the previous value and returned as a regular eSET_ATTRIBUTE
+					////////////////////////////////////////////////////////////////////////////////
+					cmdType = OmniPvdCommand::eSET_ATTRIBUTE;
+					mStream->readBytes((uint8_t*)&mCmdContextHandle, sizeof(OmniPvdContextHandle));
+					mStream->readBytes((uint8_t*)&mCmdObjectHandle, sizeof(OmniPvdObjectHandle));
+					readAttributeHandlesFromStream();
+					uint8_t nbrBytes = 0;
+					uint32_t changedMask = 0;
+					mStream->readBytes(&nbrBytes, sizeof(uint8_t));
+					mStream->readBytes((uint8_t*)&changedMask, sizeof(uint32_t));
+
+					OmniPvdDeltaEntry* entry = 0;
+					if (OmniPvdDeltaCache::isEligible(mCmdAttributeHandleDepth, nbrBytes))
+					{
+						entry = mDeltaCache.find(mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandleStack, mCmdAttributeHandleDepth);
+					}
+					if (!entry || (entry->mNbBytes != nbrBytes))
+					{
+						mLog.outputLine("[parser] ERROR: attribute delta without a previous value (contextHandle:%d, objectHandle: %d, attributeHandle: %d)\n", mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandle);
+						cmdType = OmniPvdCommand::eINVALID;
+						break;
+					}
+					for (uint32_t i = 0; i < nbrBytes; i++)
+					{
+						if (changedMask & (1u << i))
+						{
+							mStream->readBytes(&entry->mData[i], sizeof(uint8_t));
+						}
+					}
+					mCmdAttributeDataLen = nbrBytes;
+					if (mCmdAttributeDataLen > mDataBuffAllocatedLen) {
+						delete[] mDataBuffer;
+						mDataBuffAllocatedLen = OMNI_PVD_DELTA_MAX_DATA_BYTES;
+						mDataBuffer = new uint8_t[mDataBuffAllocatedLen];
+					}
+					mCmdAttributeDataPtr = mDataBuffer;
+					memcpy(mCmdAttributeDataPtr, entry->mData, nbrBytes);
+					mLog.outputLine("[parser] set attribute delta (contextHandle:%d, objectHandle: %d, attributeHandle: %d, dataLen: %d)\n", mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandle, mCmdAttributeDataLen);
+				}
+				break;
 				case OmniPvdCommand::eADD_TO_UNIQUE_LIST_ATTRIBUTE:
 				{
 					cmdType = OmniPvdCommand::eADD_TO_UNIQUE_LIST_ATTRIBUTE;
@@ -474,6 +530,38 @@ uint32_t OMNI_PVD_CALL OmniPvdReaderImpl::getEnumValue()
 	return mCmdEnumValue;
 }
 
+void OmniPvdReaderImpl::readAttributeHandlesFromStream()
+{
+	mStream->readBytes((uint8_t*)&mCmdAttributeHandleDepth, sizeof(uint8_t));
+	const uint8_t maxDepth = sizeof(mCmdAttributeHandleStack) / sizeof(OmniPvdAttributeHandle);
+	for (int i = 0; i < mCmdAttributeHandleDepth; i++) {
+		mStream->readBytes((uint8_t*)&mCmdAttributeHandle, sizeof(OmniPvdAttributeHandle));
+		if (i < maxDepth)
+		{
+			mCmdAttributeHandleStack[i] = mCmdAttributeHandle;
+		}
+	}
+}
+
+void OmniPvdReaderImpl::updateDeltaCache()
+{
+	// Mirrors the insertions done by OmniPvdWriterImpl::setAttribute
+	if (!OmniPvdDeltaCache::isEligible(mCmdAttributeHandleDepth, mCmdAttributeDataLen))
+	{
+		return;
+	}
+	OmniPvdDeltaEntry* entry = mDeltaCache.find(mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandleStack, mCmdAttributeHandleDepth);
+	if (!entry)
+	{
+		entry = mDeltaCache.insert(mCmdContextHandle, mCmdObjectHandle, mCmdAttributeHandleStack, mCmdAttributeHandleDepth);
+	}
+	if (entry)
+	{
+		entry->mNbBytes = uint8_t(mCmdAttributeDataLen);
+		memcpy(entry->mData, mCmdAttributeDataPtr, mCmdAttributeDataLen);
+	}
+}
+
 void OmniPvdReaderImpl::readLongDataFromStream(uint32_t streamByteLen)
 {
 	if (streamByteLen < 1) return;
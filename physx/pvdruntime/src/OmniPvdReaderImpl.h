@@ -31,6 +31,8 @@
 
 #include "OmniPvdReader.h"
 #include "OmniPvdLog.h"
+#include "OmniPvdDeltaCache.h"
+#include "OmniPvdCompressedReadStreamImpl.h"
 
 
 class OmniPvdReaderImpl : public OmniPvdReader {
@@ -77,12 +79,16 @@ public:
 
 	// Internal helper
 	void readLongDataFromStream(uint32_t streamByteLen);
+	void readAttributeHandlesFromStream();
+	void updateDeltaCache();
 	bool readStringFromStream(char* string, uint16_t& stringLength);
 	void resetCommandParams();
 
 	OmniPvdLog mLog;
 
 	OmniPvdReadStream *mStream;
+	OmniPvdCompressedReadStreamImpl mCompressedStream;
+	OmniPvdDeltaCache mDeltaCache;
 
 	OmniPvdVersionType mMajorVersion;
 	OmniPvdVersionType mMinorVersion;
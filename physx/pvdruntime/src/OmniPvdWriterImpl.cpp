@@ -33,6 +33,7 @@
 OmniPvdWriterImpl::OmniPvdWriterImpl()
 {	
 	resetParams();
+	mDeltaEncoding = false;
 }
 
 OmniPvdWriterImpl::~OmniPvdWriterImpl()
@@ -86,6 +87,7 @@ void OMNI_PVD_CALL OmniPvdWriterImpl::setWriteStream(OmniPvdWriteStream& stream)
 {
 	mLog.outputLine("OmniPvdRuntimeWriterImpl::setWriteStream");
 	mStream = &stream;
+	mDeltaCache.reset();
 }
 
 OmniPvdWriteStream* OMNI_PVD_CALL OmniPvdWriterImpl::getWriteStream()
@@ -225,6 +227,59 @@ void OMNI_PVD_CALL OmniPvdWriterImpl::setAttribute(OmniPvdContextHandle contextH
 	setVersionHelper();
 	if (mStream)
 	{
+		////////////////////////////////////////////////////////////////////////////////
+		// Small attributes (poses, velocities, bounds...) are re-sent for every active
+		// object each frame and usually only differ from the previous value in a few
+		// bytes, so they are written as a byte mask plus the changed bytes.
+		////////////////////////////////////////////////////////////////////////////////
+		if (mDeltaEncoding && OmniPvdDeltaCache::isEligible(nbAttributeHandles, nbrBytes))
+		{
+			OmniPvdDeltaEntry* entry = mDeltaCache.find(contextHandle, objectHandle, attributeHandles, nbAttributeHandles);
+			if (entry && (entry->mNbBytes == nbrBytes))
+			{
+				// Assembled locally and written at once, these are by far the most frequent commands
+				uint8_t command[sizeof(OmniPvdCommandStorageType) + sizeof(OmniPvdContextHandle) + sizeof(OmniPvdObjectHandle) + sizeof(uint8_t) +
+					OMNI_PVD_DELTA_MAX_HANDLES * sizeof(OmniPvdAttributeHandle) + sizeof(uint8_t) + sizeof(uint32_t) + OMNI_PVD_DELTA_MAX_DATA_BYTES];
+				uint8_t* dst = command;
+				*dst = static_cast<OmniPvdCommandStorageType>(OmniPvdCommand::eSET_ATTRIBUTE_DELTA);
+				dst += sizeof(OmniPvdCommandStorageType);
+				memcpy(dst, &contextHandle, sizeof(OmniPvdContextHandle));
+				dst += sizeof(OmniPvdContextHandle);
+				memcpy(dst, &objectHandle, sizeof(OmniPvdObjectHandle));
+				dst += sizeof(OmniPvdObjectHandle);
+				*dst++ = nbAttributeHandles;
+				memcpy(dst, attributeHandles, nbAttributeHandles * sizeof(OmniPvdAttributeHandle));
+				dst += nbAttributeHandles * sizeof(OmniPvdAttributeHandle);
+				*dst++ = uint8_t(nbrBytes);
+				uint8_t* changedMaskDst = dst;
+				dst += sizeof(uint32_t);
+
+				uint32_t changedMask = 0;
+				for (uint32_t i = 0; i < nbrBytes; i++)
+				{
+					if (data[i] != entry->mData[i])
+					{
+						changedMask |= 1u << i;
+						*dst++ = data[i];
+					}
+				}
+				memcpy(changedMaskDst, &changedMask, sizeof(uint32_t));
+				memcpy(entry->mData, data, nbrBytes);
+
+				writeWithStatus(command, uint64_t(dst - command));
+				return;
+			}
+			if (!entry)
+			{
+				entry = mDeltaCache.insert(contextHandle, objectHandle, attributeHandles, nbAttributeHandles);
+			}
+			if (entry)
+			{
+				entry->mNbBytes = uint8_t(nbrBytes);
+				memcpy(entry->mData, data, nbrBytes);
+			}
+		}
+
 		writeCommand(OmniPvdCommand::eSET_ATTRIBUTE);
 		writeWithStatus((const uint8_t*)&contextHandle, sizeof(OmniPvdContextHandle));
 		writeWithStatus((const uint8_t*)&objectHandle, sizeof(OmniPvdObjectHandle));
@@ -381,4 +436,15 @@ uint32_t OMNI_PVD_CALL OmniPvdWriterImpl::getStatus()
 void OMNI_PVD_CALL OmniPvdWriterImpl::clearStatus()
 {
 	mStatusFlags = 0;
+}
+
+void OMNI_PVD_CALL OmniPvdWriterImpl::setDeltaEncoding(bool enabled)
+{
+	// The reader updates its cache for all full values, while the writer only does it when delta encoding is enabled.
+	// Start from an empty cache so that the first delta of each attribute follows a full value seen by both.
+	if (enabled != mDeltaEncoding)
+	{
+		mDeltaCache.reset();
+	}
+	mDeltaEncoding = enabled;
 }
\ No newline at end of file
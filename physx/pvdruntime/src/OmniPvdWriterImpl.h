@@ -33,6 +33,7 @@
 #include "OmniPvdCommands.h"
 #include "OmniPvdDefinesInternal.h"
 #include "OmniPvdLog.h"
+#include "OmniPvdDeltaCache.h"
 
 class OmniPvdWriterImpl : public OmniPvdWriter {
 public:
@@ -65,6 +66,7 @@ public:
 
 	uint32_t OMNI_PVD_CALL getStatus();
 	void OMNI_PVD_CALL clearStatus();
+	void OMNI_PVD_CALL setDeltaEncoding(bool enabled);
 
 	void resetParams();
 
@@ -124,6 +126,9 @@ public:
 	int mLastAttributeHandle;
 
 	uint32_t mStatusFlags;
+
+	bool mDeltaEncoding;
+	OmniPvdDeltaCache mDeltaCache;
 };
 
 #endif
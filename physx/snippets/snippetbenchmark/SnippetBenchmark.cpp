@@ -0,0 +1,389 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+// ****************************************************************************
+// This snippet is a headless CPU benchmark for the core SDK. It runs a set of
+// canonical scenarios for a fixed number of steps, once for each number of
+// worker threads, and writes a JSON report so that results from different SDK
+// drops can be compared:
+//
+//  - boxStacks:             pyramids of boxes, some knocked over by projectiles
+//  - convexPile:            convex hulls dropped into a walled pit
+//  - ragdollArticulations:  ragdolls made of reduced-coordinate articulations
+//  - vehiclesOnHeightfield: direct-drive vehicles driving over a heightfield
+//  - cctCrowd:              capsule character controllers walking over a heightfield
+//  - raycastStorm:          batches of raycasts executed with PxBatchQueryExt::executeAsync
+//
+// For each run the report contains the wall-clock time of each stage of a step,
+// step time statistics, the speedup relative to the first thread count, the
+// peak memory allocated through the SDK allocator, and the time accumulated in
+// each profiler zone. Profiler zones are only emitted by debug, checked and
+// profile builds; the other values are available in all builds.
+//
+// SnippetBenchmark supports the following options:
+//
+//  --steps=<n>                  Number of measured simulation steps per run (default: 300)
+//  --warmupSteps=<n>            Number of steps simulated before measuring (default: 30)
+//  --maxThreads=<n>             Largest number of worker threads. Runs use 1, 2, 4, ... and n threads
+//                               (default: number of physical cores)
+//  --scenario=<name>            Only run the named scenario
+//  --vehicleDataPath=<path>     Path to the [PHYSX_ROOT]/snippets/media/vehicledata folder. The vehicle
+//                               scenario is skipped if this is not provided.
+//  --dstFile=<filename>         Destination JSON file (default: PhysXBenchmark.json)
+//
+// ****************************************************************************
+
+#include "SnippetBenchmark.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxTime.h"
+#include "../snippetutils/SnippetUtils.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace physx;
+using namespace SnippetBenchmark;
+
+static BenchmarkAllocator		gAllocator;
+static BenchmarkProfiler		gProfiler;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+
+static const PxReal gTimestep = 1.0f/60.0f;
+
+struct Options
+{
+	PxU32		nbSteps;
+	PxU32		nbWarmupSteps;
+	PxU32		maxNbThreads;
+	const char*	scenarioName;
+	const char*	vehicleDataPath;
+	const char*	dstFile;
+};
+
+struct Stage
+{
+	enum Enum
+	{
+		ePRE_SIMULATE,
+		eSIMULATE,
+		eFETCH_RESULTS,
+		ePOST_SIMULATE,
+		eCOUNT
+	};
+};
+
+static const char* gStageNames[Stage::eCOUNT] =
+{
+	"preSimulate",
+	"simulate",
+	"fetchResults",
+	"postSimulate"
+};
+
+static PxF64 getElapsedTimeInMilliseconds(PxU64 ticks)
+{
+	return PxF64(PxTime::getCounterFrequency().toTensOfNanos(ticks)) / 100000.0;
+}
+
+static void stepScenario(BenchmarkScenario& scenario, BenchmarkContext& context, PxU64* stageTicks)
+{
+	PxU64 times[Stage::eCOUNT + 1];
+	times[0] = PxTime::getCurrentCounterValue();
+
+	scenario.preSimulate(context, gTimestep);
+	times[1] = PxTime::getCurrentCounterValue();
+
+	context.scene->simulate(gTimestep);
+	times[2] = PxTime::getCurrentCounterValue();
+
+	context.scene->fetchResults(true);
+	times[3] = PxTime::getCurrentCounterValue();
+
+	scenario.postSimulate(context, gTimestep);
+	times[4] = PxTime::getCurrentCounterValue();
+
+	for(PxU32 i=0; i<Stage::eCOUNT; i++)
+		stageTicks[i] = times[i+1] - times[i];
+}
+
+// Runs one scenario with the given number of threads and writes the results as a JSON object.
+// referenceStepMs is the mean step time of the first run of the scenario, used to compute the speedup.
+static void runScenario(BenchmarkScenario& scenario, PxU32 nbThreads, const Options& options, JsonWriter& writer, PxF64& referenceStepMs)
+{
+	gAllocator.resetPeak();
+	const PxU64 baselineBytes = gAllocator.getCurrentBytes();
+	const PxU64 baselineNbAllocations = gAllocator.getNbAllocations();
+
+	const PxU64 setUpStart = PxTime::getCurrentCounterValue();
+
+	BenchmarkContext context;
+	context.physics = gPhysics;
+	context.nbThreads = nbThreads;
+	context.vehicleDataPath = options.vehicleDataPath;
+	context.dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher = context.dispatcher;
+	sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	scenario.setUpSceneDesc(sceneDesc);
+	context.scene = gPhysics->createScene(sceneDesc);
+	context.material = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+
+	const PxU32 nbObjects = scenario.setUp(context);
+	const PxF64 setUpMs = getElapsedTimeInMilliseconds(PxTime::getCurrentCounterValue() - setUpStart);
+
+	PxU64 stageTicks[Stage::eCOUNT];
+	for(PxU32 i=0; i<options.nbWarmupSteps; i++)
+		stepScenario(scenario, context, stageTicks);
+
+	// Only the measured steps are reported in the zone statistics.
+	gProfiler.reset();
+
+	PxU64 totalStageTicks[Stage::eCOUNT] = { 0 };
+	PxF64* stepMs = new PxF64[options.nbSteps];
+	const PxU64 runStart = PxTime::getCurrentCounterValue();
+	for(PxU32 i=0; i<options.nbSteps; i++)
+	{
+		stepScenario(scenario, context, stageTicks);
+
+		PxU64 ticks = 0;
+		for(PxU32 j=0; j<Stage::eCOUNT; j++)
+		{
+			totalStageTicks[j] += stageTicks[j];
+			ticks += stageTicks[j];
+		}
+		stepMs[i] = getElapsedTimeInMilliseconds(ticks);
+	}
+	const PxF64 totalMs = getElapsedTimeInMilliseconds(PxTime::getCurrentCounterValue() - runStart);
+
+	scenario.tearDown(context);
+	PX_RELEASE(context.scene);
+	PX_RELEASE(context.material);
+	PX_RELEASE(context.dispatcher);
+
+	PxSort(stepMs, options.nbSteps, PxLess<PxF64>());
+	const PxF64 meanStepMs = totalMs / PxF64(options.nbSteps);
+	if(referenceStepMs == 0.0)
+		referenceStepMs = meanStepMs;
+
+	writer.beginObject();
+	writer.writeUInt("nbThreads", nbThreads);
+	writer.writeUInt("nbObjects", nbObjects);
+	writer.writeFloat("setUpMs", setUpMs);
+	writer.writeFloat("totalMs", totalMs);
+	writer.writeFloat("speedup", referenceStepMs / meanStepMs);
+
+	writer.beginObject("stepMs");
+	writer.writeFloat("mean", meanStepMs);
+	writer.writeFloat("min", stepMs[0]);
+	writer.writeFloat("median", stepMs[options.nbSteps / 2]);
+	writer.writeFloat("p95", stepMs[(options.nbSteps * 95) / 100]);
+	writer.writeFloat("max", stepMs[options.nbSteps - 1]);
+	writer.endObject();
+
+	writer.beginObject("stagesMs");
+	for(PxU32 i=0; i<Stage::eCOUNT; i++)
+		writer.writeFloat(gStageNames[i], getElapsedTimeInMilliseconds(totalStageTicks[i]));
+	writer.endObject();
+
+	// Peak memory is measured from the creation of the dispatcher to the release of the scene.
+	writer.beginObject("memory");
+	writer.writeUInt("baselineBytes", baselineBytes);
+	writer.writeUInt("peakBytes", gAllocator.getPeakBytes());
+	writer.writeUInt("peakScenarioBytes", gAllocator.getPeakBytes() - baselineBytes);
+	writer.writeUInt("nbAllocations", gAllocator.getNbAllocations() - baselineNbAllocations);
+	// Signed, since the scenario can release memory that was allocated before the baseline was taken.
+	writer.writeInt("leakedBytes", PxI64(gAllocator.getCurrentBytes()) - PxI64(baselineBytes));
+	writer.endObject();
+
+	// Zone times are summed over all threads, so they can exceed the wall-clock time of the run.
+	static BenchmarkProfiler::ZoneStats zoneStats[1024];
+	const PxU32 nbZones = gProfiler.getZoneStats(zoneStats, 1024);
+	writer.writeUInt("nbDroppedZones", gProfiler.getNbDroppedZones());
+	writer.beginArray("zones");
+	for(PxU32 i=0; i<nbZones; i++)
+	{
+		writer.beginObject();
+		writer.writeString("name", zoneStats[i].name);
+		writer.writeUInt("nbCalls", zoneStats[i].nbCalls);
+		writer.writeFloat("totalMs", getElapsedTimeInMilliseconds(zoneStats[i].totalTicks));
+		writer.endObject();
+	}
+	writer.endArray();
+	writer.endObject();
+
+	printf("%-24s %2u threads: %6u objects, step mean %8.3f ms, median %8.3f ms, max %8.3f ms, speedup %5.2f, peak %8.2f MB\n",
+		scenario.getName(), nbThreads, nbObjects, meanStepMs, stepMs[options.nbSteps / 2], stepMs[options.nbSteps - 1],
+		referenceStepMs / meanStepMs, PxF64(gAllocator.getPeakBytes() - baselineBytes) / (1024.0 * 1024.0));
+
+	delete [] stepMs;
+}
+
+static const char* getBuildName()
+{
+#if PX_DEBUG
+	return "debug";
+#elif PX_CHECKED
+	return "checked";
+#elif PX_PROFILE
+	return "profile";
+#else
+	return "release";
+#endif
+}
+
+static bool parseOptions(int argc, const char*const* argv, Options& options)
+{
+	options.nbSteps = 300;
+	options.nbWarmupSteps = 30;
+	options.maxNbThreads = PxMax(SnippetUtils::getNbPhysicalCores(), 1u);
+	options.scenarioName = NULL;
+	options.vehicleDataPath = NULL;
+	options.dstFile = "PhysXBenchmark.json";
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strncmp(argv[i], "--steps=", 8))
+			options.nbSteps = PxU32(atoi(argv[i] + 8));
+		else if(!strncmp(argv[i], "--warmupSteps=", 14))
+			options.nbWarmupSteps = PxU32(atoi(argv[i] + 14));
+		else if(!strncmp(argv[i], "--maxThreads=", 13))
+			options.maxNbThreads = PxU32(atoi(argv[i] + 13));
+		else if(!strncmp(argv[i], "--scenario=", 11))
+			options.scenarioName = argv[i] + 11;
+		else if(!strncmp(argv[i], "--vehicleDataPath=", 18))
+			options.vehicleDataPath = argv[i] + 18;
+		else if(!strncmp(argv[i], "--dstFile=", 10))
+			options.dstFile = argv[i] + 10;
+		else
+		{
+			printf("Unknown option: %s\n", argv[i]);
+			return false;
+		}
+	}
+
+	if(!options.nbSteps || !options.maxNbThreads)
+	{
+		printf("The number of steps and the number of threads must be at least 1.\n");
+		return false;
+	}
+	return true;
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	Options options;
+	if(!parseOptions(argc, argv, options))
+		return 1;
+
+	PxDefaultFileOutputStream stream(options.dstFile);
+	if(!stream.isValid())
+	{
+		printf("Could not open output file, \"%s\"!\n", options.dstFile);
+		return 1;
+	}
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	PxSetProfilerCallback(&gProfiler);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	vehicle2::PxInitVehicleExtension(*gFoundation);
+
+	// 1, 2, 4, ... up to and including the maximum number of threads.
+	PxU32 threadCounts[32];
+	PxU32 nbThreadCounts = 0;
+	for(PxU32 nbThreads=1; nbThreads<options.maxNbThreads && nbThreadCounts<31; nbThreads*=2)
+		threadCounts[nbThreadCounts++] = nbThreads;
+	threadCounts[nbThreadCounts++] = options.maxNbThreads;
+
+	JsonWriter writer(stream);
+	writer.beginObject();
+	writer.writeUInt("sdkVersionMajor", PX_PHYSICS_VERSION_MAJOR);
+	writer.writeUInt("sdkVersionMinor", PX_PHYSICS_VERSION_MINOR);
+	writer.writeUInt("sdkVersionBugfix", PX_PHYSICS_VERSION_BUGFIX);
+	writer.writeString("build", getBuildName());
+	writer.writeBool("profilerZones", PX_DEBUG || PX_CHECKED || PX_PROFILE);
+	writer.writeUInt("nbSteps", options.nbSteps);
+	writer.writeUInt("nbWarmupSteps", options.nbWarmupSteps);
+	writer.writeFloat("timestep", gTimestep);
+	writer.writeUInt("nbPhysicalCores", SnippetUtils::getNbPhysicalCores());
+
+	writer.beginArray("threadCounts");
+	for(PxU32 i=0; i<nbThreadCounts; i++)
+		writer.writeUInt(NULL, threadCounts[i]);
+	writer.endArray();
+
+	BenchmarkScenario* scenarios[16];
+	const PxU32 nbScenarios = getScenarios(scenarios, 16);
+
+	writer.beginArray("scenarios");
+	for(PxU32 i=0; i<nbScenarios; i++)
+	{
+		BenchmarkScenario& scenario = *scenarios[i];
+		if(options.scenarioName && strcmp(options.scenarioName, scenario.getName()))
+			continue;
+
+		BenchmarkContext context;
+		context.physics = gPhysics;
+		context.scene = NULL;
+		context.dispatcher = NULL;
+		context.material = NULL;
+		context.nbThreads = 0;
+		context.vehicleDataPath = options.vehicleDataPath;
+
+		writer.beginObject();
+		writer.writeString("name", scenario.getName());
+		const bool supported = scenario.isSupported(context);
+		writer.writeBool("supported", supported);
+		if(supported)
+		{
+			PxF64 referenceStepMs = 0.0;
+			writer.beginArray("runs");
+			for(PxU32 j=0; j<nbThreadCounts; j++)
+				runScenario(scenario, threadCounts[j], options, writer, referenceStepMs);
+			writer.endArray();
+		}
+		else
+		{
+			printf("%-24s skipped, missing data (see the options in SnippetBenchmark.cpp)\n", scenario.getName());
+		}
+		writer.endObject();
+	}
+	writer.endArray();
+	writer.endObject();
+
+	vehicle2::PxCloseVehicleExtension();
+	PX_RELEASE(gPhysics);
+	PxSetProfilerCallback(NULL);
+	PX_RELEASE(gFoundation);
+
+#if !(PX_DEBUG || PX_CHECKED || PX_PROFILE)
+	printf("Warning: SnippetBenchmark does not capture the profiler zones in release build.\n");
+#endif
+	printf("SnippetBenchmark done. Results written to %s.\n", options.dstFile);
+	return 0;
+}
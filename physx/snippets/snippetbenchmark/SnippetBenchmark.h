@@ -0,0 +1,166 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef SNIPPET_BENCHMARK_H
+#define SNIPPET_BENCHMARK_H
+
+#include "PxPhysicsAPI.h"
+
+namespace physx
+{
+namespace SnippetBenchmark
+{
+	// Objects shared by all scenarios of a run. A new scene and a new dispatcher are
+	// created for each scenario and each thread count.
+	struct BenchmarkContext
+	{
+		PxPhysics*				physics;
+		PxScene*				scene;
+		PxDefaultCpuDispatcher*	dispatcher;
+		PxMaterial*				material;
+		PxU32					nbThreads;
+		const char*				vehicleDataPath;	// NULL if not provided on the command line
+	};
+
+	// A canonical benchmark scenario. Scenarios are deterministic: all random numbers come
+	// from fixed seeds, so that two runs of the same SDK drop simulate the same content.
+	class BenchmarkScenario
+	{
+	public:
+		virtual					~BenchmarkScenario()	{}
+
+		virtual	const char*		getName()	const	= 0;
+
+		// Returns false if the scenario cannot run, for example because external data is missing.
+		virtual	bool			isSupported(const BenchmarkContext& context)	const	{ PX_UNUSED(context); return true;	}
+
+		// Called before the scene is created.
+		virtual	void			setUpSceneDesc(PxSceneDesc& sceneDesc)	const	{ PX_UNUSED(sceneDesc);	}
+
+		// Creates the scenario's content in context.scene. Returns the number of simulated objects.
+		virtual	PxU32			setUp(BenchmarkContext& context) = 0;
+
+		// Game-side work performed before and after PxScene::simulate / fetchResults.
+		virtual	void			preSimulate(BenchmarkContext& context, PxReal dt)	{ PX_UNUSED(context); PX_UNUSED(dt);	}
+		virtual	void			postSimulate(BenchmarkContext& context, PxReal dt)	{ PX_UNUSED(context); PX_UNUSED(dt);	}
+
+		// Releases everything created in setUp, except the scene itself.
+		virtual	void			tearDown(BenchmarkContext& context) = 0;
+	};
+
+	// Returns the scenarios in execution order.
+	PxU32 getScenarios(BenchmarkScenario** scenarios, PxU32 maxNbScenarios);
+
+	// Profiler callback accumulating the time spent in each profiler zone, over all threads.
+	class BenchmarkProfiler : public PxProfilerCallback
+	{
+	public:
+		struct ZoneStats
+		{
+			const char*	name;
+			PxU64		nbCalls;
+			PxU64		totalTicks;
+		};
+
+								BenchmarkProfiler();
+
+		virtual	void*			zoneStart(const char* eventName, bool detached, uint64_t contextId)	PX_OVERRIDE;
+		virtual	void			zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId)	PX_OVERRIDE;
+
+		// Must not be called while the simulation is running.
+				void			reset();
+
+		// Gathers the zones with identical names, sorted by decreasing total time. Returns the number of zones written.
+				PxU32			getZoneStats(ZoneStats* stats, PxU32 maxNbStats)	const;
+
+				PxU64			getNbDroppedZones()	const	{ return PxU64(mNbDroppedZones);	}
+
+	private:
+		enum { TABLE_SIZE = 2048 };
+
+		struct Slot
+		{
+			volatile void*	name;
+			volatile PxI64	nbCalls;
+			volatile PxI64	totalTicks;
+		};
+
+				Slot			mSlots[TABLE_SIZE];
+				volatile PxI64	mNbDroppedZones;
+	};
+
+	// Allocator tracking the number of bytes currently allocated by the SDK, and its peak.
+	class BenchmarkAllocator : public PxAllocatorCallback
+	{
+	public:
+								BenchmarkAllocator() : mCurrentBytes(0), mPeakBytes(0), mNbAllocations(0)	{}
+
+		virtual	void*			allocate(size_t size, const char* typeName, const char* filename, int line)	PX_OVERRIDE;
+		virtual	void			deallocate(void* ptr)	PX_OVERRIDE;
+
+		// Restarts peak tracking from the current allocation level.
+				void			resetPeak();
+
+				PxU64			getCurrentBytes()	const	{ return PxU64(mCurrentBytes);	}
+				PxU64			getPeakBytes()		const	{ return PxU64(mPeakBytes);		}
+				PxU64			getNbAllocations()	const	{ return PxU64(mNbAllocations);	}
+
+	private:
+				PxDefaultAllocator	mAllocator;
+				volatile PxI64		mCurrentBytes;
+				volatile PxI64		mPeakBytes;
+				volatile PxI64		mNbAllocations;
+	};
+
+	// Minimal JSON writer. Keys and string values are written as is, they must not need escaping.
+	class JsonWriter
+	{
+	public:
+								JsonWriter(PxOutputStream& stream) : mStream(stream), mDepth(0), mNeedComma(false)	{}
+
+				void			beginObject(const char* key = NULL);
+				void			endObject();
+				void			beginArray(const char* key = NULL);
+				void			endArray();
+				void			writeString(const char* key, const char* value);
+				void			writeUInt(const char* key, PxU64 value);
+				void			writeInt(const char* key, PxI64 value);
+				void			writeFloat(const char* key, PxF64 value);
+				void			writeBool(const char* key, bool value);
+
+	private:
+				void			writeKey(const char* key);
+				void			newLine();
+				void			print(const char* format, ...);
+
+				PxOutputStream&	mStream;
+				PxU32			mDepth;
+				bool			mNeedComma;
+	};
+}
+}
+
+#endif
@@ -0,0 +1,566 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "SnippetBenchmark.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetvehiclecommon/directdrivetrain/DirectDrivetrain.h"
+#include "../snippetvehiclecommon/serialization/BaseSerialization.h"
+#include "../snippetvehiclecommon/serialization/DirectDrivetrainSerialization.h"
+#include "../snippetvehiclecommon/SnippetVehicleHelpers.h"
+
+using namespace physx;
+using namespace physx::vehicle2;
+using namespace SnippetBenchmark;
+using namespace snippetvehicle;
+
+static PxRigidStatic* createGroundPlane(BenchmarkContext& context)
+{
+	PxRigidStatic* groundPlane = PxCreatePlane(*context.physics, PxPlane(0,1,0,0), *context.material);
+	context.scene->addActor(*groundPlane);
+	return groundPlane;
+}
+
+// Rolling terrain shared by the vehicle and character controller scenarios. The heightfield is centered on the origin.
+static PxRigidStatic* createTerrain(BenchmarkContext& context, PxU32 nbSamples, PxReal sampleSpacing, bool simulationShape)
+{
+	const PxReal heightScale = 0.01f;
+
+	PxHeightFieldSample* samples = new PxHeightFieldSample[nbSamples*nbSamples];
+	for(PxU32 row=0; row<nbSamples; row++)
+	{
+		for(PxU32 col=0; col<nbSamples; col++)
+		{
+			const PxReal x = PxReal(row) * sampleSpacing;
+			const PxReal z = PxReal(col) * sampleSpacing;
+			const PxReal height = 1.5f * PxSin(x * 0.05f) * PxCos(z * 0.07f) + 0.5f * PxSin(x * 0.21f + z * 0.17f);
+
+			PxHeightFieldSample& sample = samples[row*nbSamples + col];
+			sample.height = PxI16(height / heightScale);
+			sample.materialIndex0 = 0;
+			sample.materialIndex1 = 0;
+			sample.clearTessFlag();
+		}
+	}
+
+	PxHeightFieldDesc desc;
+	desc.format = PxHeightFieldFormat::eS16_TM;
+	desc.nbRows = nbSamples;
+	desc.nbColumns = nbSamples;
+	desc.samples.data = samples;
+	desc.samples.stride = sizeof(PxHeightFieldSample);
+
+	PxHeightField* heightField = PxCreateHeightField(desc, context.physics->getPhysicsInsertionCallback());
+	delete [] samples;
+	if(!heightField)
+		return NULL;
+
+	const PxReal halfSize = 0.5f * PxReal(nbSamples - 1) * sampleSpacing;
+	PxRigidStatic* terrain = context.physics->createRigidStatic(PxTransform(PxVec3(-halfSize, 0.0f, -halfSize)));
+	PxShape* shape = PxRigidActorExt::createExclusiveShape(*terrain, PxHeightFieldGeometry(heightField, PxMeshGeometryFlags(), heightScale, sampleSpacing, sampleSpacing), *context.material);
+	shape->setFlag(PxShapeFlag::eSIMULATION_SHAPE, simulationShape);
+	heightField->release();
+
+	context.scene->addActor(*terrain);
+	return terrain;
+}
+
+// Returns the height of the static geometry below (x, z).
+static PxReal getGroundHeight(const PxScene& scene, PxReal x, PxReal z)
+{
+	PxRaycastBuffer hit;
+	if(scene.raycast(PxVec3(x, 100.0f, z), PxVec3(0.0f, -1.0f, 0.0f), 200.0f, hit, PxHitFlag::eDEFAULT, PxQueryFilterData(PxQueryFlag::eSTATIC)))
+		return hit.block.position.y;
+	return 0.0f;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Pyramids of boxes on a plane: contact generation and solver throughput for many small islands.
+class BoxStacksScenario : public BenchmarkScenario
+{
+public:
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "boxStacks";	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		createGroundPlane(context);
+
+		const PxU32 nbStacks = 32;
+		const PxU32 stackSize = 15;
+		const PxReal halfExtent = 0.5f;
+
+		PxShape* shape = context.physics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *context.material);
+		PxU32 nbBodies = 0;
+		for(PxU32 s=0; s<nbStacks; s++)
+		{
+			const PxTransform t(PxVec3(PxReal(s % 8) * 20.0f - 70.0f, 0.0f, PxReal(s / 8) * 10.0f - 15.0f));
+			for(PxU32 i=0; i<stackSize; i++)
+			{
+				for(PxU32 j=0; j<stackSize-i; j++)
+				{
+					const PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(stackSize-i), PxReal(i*2+1), 0) * halfExtent);
+					PxRigidDynamic* body = context.physics->createRigidDynamic(t.transform(localTm));
+					body->attachShape(*shape);
+					PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+					context.scene->addActor(*body);
+					nbBodies++;
+				}
+			}
+		}
+		shape->release();
+
+		// A few projectiles knock some of the stacks over, so that the islands change during the run.
+		for(PxU32 s=0; s<nbStacks; s+=3)
+		{
+			const PxVec3 target(PxReal(s % 8) * 20.0f - 70.0f, 2.0f, PxReal(s / 8) * 10.0f - 15.0f);
+			PxRigidDynamic* ball = PxCreateDynamic(*context.physics, PxTransform(target + PxVec3(0.0f, 3.0f, 30.0f)), PxSphereGeometry(1.0f), *context.material, 10.0f);
+			ball->setLinearVelocity(PxVec3(0.0f, 0.0f, -40.0f));
+			context.scene->addActor(*ball);
+			nbBodies++;
+		}
+		return nbBodies;
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Convex hulls dropped into a walled pit: convex-convex contact generation in a single large island.
+class ConvexPileScenario : public BenchmarkScenario
+{
+public:
+	ConvexPileScenario() : mConvexMesh(NULL)	{}
+
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "convexPile";	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		createGroundPlane(context);
+
+		// Walls around the pit.
+		const PxReal pitHalfSize = 12.0f;
+		for(PxU32 i=0; i<4; i++)
+		{
+			const PxQuat q(PxReal(i) * PxPiDivTwo, PxVec3(0.0f, 1.0f, 0.0f));
+			PxRigidStatic* wall = PxCreateStatic(*context.physics, PxTransform(q.rotate(PxVec3(0.0f, 5.0f, pitHalfSize + 0.5f)), q),
+				PxBoxGeometry(pitHalfSize + 1.0f, 5.0f, 0.5f), *context.material);
+			context.scene->addActor(*wall);
+		}
+
+		SnippetUtils::BasicRandom random(42);
+		PxVec3 points[32];
+		for(PxU32 i=0; i<32; i++)
+			points[i] = random.unitRandomPt().multiply(PxVec3(0.6f, 0.4f, 0.5f));
+
+		PxConvexMeshDesc desc;
+		desc.points.count = 32;
+		desc.points.stride = sizeof(PxVec3);
+		desc.points.data = points;
+		desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+
+		const PxCookingParams params(context.physics->getTolerancesScale());
+		mConvexMesh = PxCreateConvexMesh(params, desc, context.physics->getPhysicsInsertionCallback());
+		if(!mConvexMesh)
+			return 0;
+
+		PxShape* shape = context.physics->createShape(PxConvexMeshGeometry(mConvexMesh), *context.material);
+		PxU32 nbBodies = 0;
+		const PxU32 nbPerSide = 16;
+		const PxU32 nbLayers = 8;
+		for(PxU32 y=0; y<nbLayers; y++)
+		{
+			for(PxU32 x=0; x<nbPerSide; x++)
+			{
+				for(PxU32 z=0; z<nbPerSide; z++)
+				{
+					const PxVec3 pos(PxReal(x) * 1.4f - 10.5f, PxReal(y) * 1.4f + 1.0f, PxReal(z) * 1.4f - 10.5f);
+					PxRigidDynamic* body = context.physics->createRigidDynamic(PxTransform(pos, random.unitRandomQuat()));
+					body->attachShape(*shape);
+					PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+					context.scene->addActor(*body);
+					nbBodies++;
+				}
+			}
+		}
+		shape->release();
+		return nbBodies;
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+		// The shapes still reference the mesh, it is destroyed with the scene's actors.
+		PX_RELEASE(mConvexMesh);
+	}
+
+private:
+	PxConvexMesh*	mConvexMesh;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Ragdolls made of reduced-coordinate articulations falling onto a plane and onto each other.
+class RagdollsScenario : public BenchmarkScenario
+{
+public:
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "ragdollArticulations";	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		createGroundPlane(context);
+
+		SnippetUtils::BasicRandom random(7);
+		PxU32 nbLinks = 0;
+		for(PxU32 layer=0; layer<2; layer++)
+		{
+			for(PxU32 x=0; x<8; x++)
+			{
+				for(PxU32 z=0; z<8; z++)
+				{
+					const PxVec3 pos(PxReal(x) * 2.5f - 8.75f + PxReal(layer), 0.5f + PxReal(layer) * 2.5f + random.randomFloat32(0.0f, 1.0f), PxReal(z) * 2.5f - 8.75f);
+					const PxQuat yaw(random.randomFloat32(-PxPi, PxPi), PxVec3(0.0f, 1.0f, 0.0f));
+					const PxQuat tilt(random.randomFloat32(-0.5f, 0.5f), PxVec3(1.0f, 0.0f, 0.0f));
+					nbLinks += createRagdoll(context, PxTransform(pos, yaw * tilt));
+				}
+			}
+		}
+		return nbLinks;
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+	}
+
+private:
+	static PxArticulationLink* addLink(BenchmarkContext& context, PxArticulationReducedCoordinate& articulation, PxArticulationLink* parent,
+		const PxTransform& ragdollPose, const PxVec3& center, bool vertical, PxReal radius, PxReal halfHeight, const PxVec3& anchor)
+	{
+		const PxTransform linkPose = ragdollPose.transform(PxTransform(center));
+		PxArticulationLink* link = articulation.createLink(parent, linkPose);
+
+		PxShape* shape = PxRigidActorExt::createExclusiveShape(*link, PxCapsuleGeometry(radius, halfHeight), *context.material);
+		if(vertical)
+			shape->setLocalPose(PxTransform(PxQuat(PxPiDivTwo, PxVec3(0.0f, 0.0f, 1.0f))));
+		PxRigidBodyExt::updateMassAndInertia(*link, 1000.0f);
+
+		if(parent)
+		{
+			// Joint frames are aligned with the ragdoll frame and located at the anchor.
+			const PxTransform jointPose = ragdollPose.transform(PxTransform(anchor));
+			PxArticulationJointReducedCoordinate* joint = link->getInboundJoint();
+			joint->setParentPose(parent->getGlobalPose().transformInv(jointPose));
+			joint->setChildPose(linkPose.transformInv(jointPose));
+			joint->setJointType(PxArticulationJointType::eSPHERICAL);
+			joint->setMotion(PxArticulationAxis::eTWIST, PxArticulationMotion::eLIMITED);
+			joint->setMotion(PxArticulationAxis::eSWING1, PxArticulationMotion::eLIMITED);
+			joint->setMotion(PxArticulationAxis::eSWING2, PxArticulationMotion::eLIMITED);
+			joint->setLimitParams(PxArticulationAxis::eTWIST, PxArticulationLimit(-0.3f, 0.3f));
+			joint->setLimitParams(PxArticulationAxis::eSWING1, PxArticulationLimit(-0.8f, 0.8f));
+			joint->setLimitParams(PxArticulationAxis::eSWING2, PxArticulationLimit(-0.8f, 0.8f));
+		}
+		return link;
+	}
+
+	static PxU32 createRagdoll(BenchmarkContext& context, const PxTransform& pose)
+	{
+		PxArticulationReducedCoordinate* articulation = context.physics->createArticulationReducedCoordinate();
+		articulation->setSolverIterationCounts(8, 1);
+
+		PxArticulationLink* pelvis = addLink(context, *articulation, NULL, pose, PxVec3(0.0f, 1.0f, 0.0f), false, 0.12f, 0.10f, PxVec3(0.0f));
+		PxArticulationLink* torso = addLink(context, *articulation, pelvis, pose, PxVec3(0.0f, 1.35f, 0.0f), true, 0.15f, 0.15f, PxVec3(0.0f, 1.12f, 0.0f));
+		addLink(context, *articulation, torso, pose, PxVec3(0.0f, 1.75f, 0.0f), true, 0.10f, 0.02f, PxVec3(0.0f, 1.60f, 0.0f));
+		for(PxU32 side=0; side<2; side++)
+		{
+			const PxReal s = side ? 1.0f : -1.0f;
+			PxArticulationLink* upperArm = addLink(context, *articulation, torso, pose, PxVec3(s * 0.40f, 1.5f, 0.0f), false, 0.06f, 0.13f, PxVec3(s * 0.20f, 1.5f, 0.0f));
+			addLink(context, *articulation, upperArm, pose, PxVec3(s * 0.80f, 1.5f, 0.0f), false, 0.05f, 0.13f, PxVec3(s * 0.60f, 1.5f, 0.0f));
+			PxArticulationLink* thigh = addLink(context, *articulation, pelvis, pose, PxVec3(s * 0.12f, 0.70f, 0.0f), true, 0.08f, 0.15f, PxVec3(s * 0.12f, 0.92f, 0.0f));
+			addLink(context, *articulation, thigh, pose, PxVec3(s * 0.12f, 0.28f, 0.0f), true, 0.06f, 0.15f, PxVec3(s * 0.12f, 0.49f, 0.0f));
+		}
+
+		context.scene->addArticulation(*articulation);
+		return articulation->getNbLinks();
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Direct-drive vehicles driving over a heightfield. The vehicle update runs on the calling thread,
+// only the PhysX scene update uses the worker threads.
+#define BENCHMARK_NB_VEHICLES	128
+
+class VehiclesScenario : public BenchmarkScenario
+{
+public:
+	VehiclesScenario() : mNbVehicles(0)	{}
+
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "vehiclesOnHeightfield";	}
+
+	virtual	bool	isSupported(const BenchmarkContext& context)	const	PX_OVERRIDE
+	{
+		return context.vehicleDataPath != NULL;
+	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		// Query-only terrain: the vehicles are held up by their suspension raycasts.
+		if(!createTerrain(context, 256, 1.0f, false))
+			return 0;
+
+		mMaterialFriction.friction = 1.0f;
+		mMaterialFriction.material = context.material;
+
+		BaseVehicleParams baseParams;
+		DirectDrivetrainParams directDrivetrainParams;
+		if(!readBaseParamsFromJsonFile(context.vehicleDataPath, "Base.json", baseParams))
+			return 0;
+		if(!readDirectDrivetrainParamsFromJsonFile(context.vehicleDataPath, "DirectDrive.json", baseParams.axleDescription, directDrivetrainParams))
+			return 0;
+
+		PhysXIntegrationParams physxParams;
+		setPhysXIntegrationParams(baseParams.axleDescription, &mMaterialFriction, 1, 1.0f, physxParams);
+
+		const PxCookingParams cookingParams(context.physics->getTolerancesScale());
+		for(PxU32 i=0; i<BENCHMARK_NB_VEHICLES; i++)
+		{
+			DirectDriveVehicle& vehicle = mVehicles[i];
+			vehicle.mBaseParams = baseParams;
+			vehicle.mPhysXParams = physxParams;
+			vehicle.mDirectDriveParams = directDrivetrainParams;
+			if(!vehicle.initialize(*context.physics, cookingParams, *context.material))
+				return mNbVehicles;
+			mNbVehicles++;
+
+			const PxReal x = PxReal(i % 16) * 12.0f - 90.0f;
+			const PxReal z = PxReal(i / 16) * 12.0f - 100.0f;
+			vehicle.setUpActor(*context.scene, PxTransform(PxVec3(x, getGroundHeight(*context.scene, x, z) + 0.5f, z)), "benchmarkVehicle");
+		}
+
+		mSimulationContext.setToDefault();
+		mSimulationContext.frame.lngAxis = PxVehicleAxes::ePosZ;
+		mSimulationContext.frame.latAxis = PxVehicleAxes::ePosX;
+		mSimulationContext.frame.vrtAxis = PxVehicleAxes::ePosY;
+		mSimulationContext.scale.scale = 1.0f;
+		mSimulationContext.gravity = context.scene->getGravity();
+		mSimulationContext.physxScene = context.scene;
+		mSimulationContext.physxActorUpdateMode = PxVehiclePhysXActorUpdateMode::eAPPLY_ACCELERATION;
+		return mNbVehicles;
+	}
+
+	virtual	void	preSimulate(BenchmarkContext&, PxReal dt)	PX_OVERRIDE
+	{
+		PX_PROFILE_ZONE("Benchmark.vehicleUpdate", 0);
+		for(PxU32 i=0; i<mNbVehicles; i++)
+		{
+			DirectDriveVehicle& vehicle = mVehicles[i];
+			vehicle.mCommandState.brakes[0] = 0.0f;
+			vehicle.mCommandState.nbBrakes = 1;
+			vehicle.mCommandState.throttle = 0.6f;
+			vehicle.mCommandState.steer = (i & 1) ? 0.1f : -0.1f;
+			vehicle.mTransmissionCommandState.gear = PxVehicleDirectDriveTransmissionCommandState::eFORWARD;
+			vehicle.step(dt, mSimulationContext);
+		}
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+		for(PxU32 i=0; i<mNbVehicles; i++)
+			mVehicles[i].destroy();
+		mNbVehicles = 0;
+	}
+
+private:
+	DirectDriveVehicle					mVehicles[BENCHMARK_NB_VEHICLES];
+	PxU32								mNbVehicles;
+	PxVehiclePhysXSimulationContext		mSimulationContext;
+	PxVehiclePhysXMaterialFriction		mMaterialFriction;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Capsule character controllers walking in circles over a heightfield scattered with crates.
+class CharacterCrowdScenario : public BenchmarkScenario
+{
+public:
+	CharacterCrowdScenario() : mManager(NULL), mTime(0.0f)	{}
+
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "cctCrowd";	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		if(!createTerrain(context, 128, 1.0f, true))
+			return 0;
+
+		SnippetUtils::BasicRandom random(11);
+		for(PxU32 i=0; i<256; i++)
+		{
+			const PxReal x = random.randomFloat32(-50.0f, 50.0f);
+			const PxReal z = random.randomFloat32(-50.0f, 50.0f);
+			PxRigidDynamic* crate = PxCreateDynamic(*context.physics, PxTransform(PxVec3(x, getGroundHeight(*context.scene, x, z) + 1.0f, z)),
+				PxBoxGeometry(0.5f, 0.5f, 0.5f), *context.material, 10.0f);
+			context.scene->addActor(*crate);
+		}
+
+		mManager = PxCreateControllerManager(*context.scene);
+
+		PxCapsuleControllerDesc desc;
+		desc.radius = 0.4f;
+		desc.height = 1.0f;
+		desc.material = context.material;
+		desc.stepOffset = 0.3f;
+
+		const PxU32 nbPerSide = 24;
+		for(PxU32 i=0; i<nbPerSide*nbPerSide; i++)
+		{
+			const PxReal x = PxReal(i % nbPerSide) * 4.0f - 46.0f;
+			const PxReal z = PxReal(i / nbPerSide) * 4.0f - 46.0f;
+			desc.position = PxExtendedVec3(x, getGroundHeight(*context.scene, x, z) + 1.5f, z);
+			if(!mManager->createController(desc))
+				break;
+		}
+		mTime = 0.0f;
+		return mManager->getNbControllers();
+	}
+
+	virtual	void	preSimulate(BenchmarkContext&, PxReal dt)	PX_OVERRIDE
+	{
+		PX_PROFILE_ZONE("Benchmark.cctMove", 0);
+		mTime += dt;
+
+		const PxControllerFilters filters;
+		const PxU32 nbControllers = mManager->getNbControllers();
+		for(PxU32 i=0; i<nbControllers; i++)
+		{
+			// Each character walks its own circle, so that neighbours keep bumping into each other.
+			const PxReal phase = mTime * 0.8f + PxReal(i) * 0.37f;
+			const PxVec3 disp = PxVec3(PxCos(phase), 0.0f, PxSin(phase)) * (2.0f * dt) + PxVec3(0.0f, -9.81f * dt, 0.0f);
+			mManager->getController(i)->move(disp, 0.001f, dt, filters);
+		}
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+		PX_RELEASE(mManager);
+	}
+
+private:
+	PxControllerManager*	mManager;
+	PxReal					mTime;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Large batches of raycasts against a field of static and dynamic shapes, executed in parallel on the dispatcher.
+class RaycastStormScenario : public BenchmarkScenario
+{
+public:
+	RaycastStormScenario() : mBatchQuery(NULL), mRandom(0)	{}
+
+	virtual	const char*	getName()	const	PX_OVERRIDE	{ return "raycastStorm";	}
+
+	virtual	PxU32	setUp(BenchmarkContext& context)	PX_OVERRIDE
+	{
+		createGroundPlane(context);
+
+		SnippetUtils::BasicRandom random(3);
+		PxU32 nbActors = 0;
+		for(PxU32 i=0; i<64*64; i++)
+		{
+			const PxVec3 pos(PxReal(i % 64) * 3.0f - 94.5f, random.randomFloat32(0.5f, 10.0f), PxReal(i / 64) * 3.0f - 94.5f);
+			const PxTransform pose(pos, random.unitRandomQuat());
+			PxRigidStatic* actor = NULL;
+			switch(i % 3)
+			{
+				case 0:	actor = PxCreateStatic(*context.physics, pose, PxBoxGeometry(0.5f, 0.8f, 0.6f), *context.material);	break;
+				case 1:	actor = PxCreateStatic(*context.physics, pose, PxSphereGeometry(0.7f), *context.material);			break;
+				case 2:	actor = PxCreateStatic(*context.physics, pose, PxCapsuleGeometry(0.4f, 0.6f), *context.material);	break;
+			}
+			context.scene->addActor(*actor);
+			nbActors++;
+		}
+
+		// Falling bodies keep the query structure for dynamic objects busy.
+		for(PxU32 i=0; i<1024; i++)
+		{
+			const PxVec3 pos(random.randomFloat32(-90.0f, 90.0f), random.randomFloat32(15.0f, 40.0f), random.randomFloat32(-90.0f, 90.0f));
+			PxRigidDynamic* body = PxCreateDynamic(*context.physics, PxTransform(pos), PxSphereGeometry(0.5f), *context.material, 10.0f);
+			context.scene->addActor(*body);
+			nbActors++;
+		}
+
+		mBatchQuery = PxCreateBatchQueryExt(*context.scene, NULL, NB_RAYS, 0, 0, 0, 0, 0);
+		mRandom.setSeed(5);
+		return nbActors;
+	}
+
+	virtual	void	postSimulate(BenchmarkContext& context, PxReal)	PX_OVERRIDE
+	{
+		if(!mBatchQuery)
+			return;
+
+		PX_PROFILE_ZONE("Benchmark.raycasts", 0);
+		for(PxU32 i=0; i<NB_RAYS; i++)
+		{
+			const PxVec3 origin(mRandom.randomFloat32(-95.0f, 95.0f), 50.0f, mRandom.randomFloat32(-95.0f, 95.0f));
+			const PxVec3 dir = PxVec3(mRandom.randomFloat32(-0.3f, 0.3f), -1.0f, mRandom.randomFloat32(-0.3f, 0.3f)).getNormalized();
+			mBatchQuery->raycast(origin, dir, 100.0f);
+		}
+
+		// A NULL continuation makes the call blocking.
+		mBatchQuery->executeAsync(*context.dispatcher, NULL);
+	}
+
+	virtual	void	tearDown(BenchmarkContext&)	PX_OVERRIDE
+	{
+		PX_RELEASE(mBatchQuery);
+	}
+
+private:
+	enum { NB_RAYS = 16384 };
+
+	PxBatchQueryExt*			mBatchQuery;
+	SnippetUtils::BasicRandom	mRandom;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+static BoxStacksScenario		gBoxStacks;
+static ConvexPileScenario		gConvexPile;
+static RagdollsScenario			gRagdolls;
+static VehiclesScenario			gVehicles;
+static CharacterCrowdScenario	gCharacterCrowd;
+static RaycastStormScenario		gRaycastStorm;
+
+PxU32 SnippetBenchmark::getScenarios(BenchmarkScenario** scenarios, PxU32 maxNbScenarios)
+{
+	BenchmarkScenario* all[] = { &gBoxStacks, &gConvexPile, &gRagdolls, &gVehicles, &gCharacterCrowd, &gRaycastStorm };
+	const PxU32 nbScenarios = PxMin(maxNbScenarios, PxU32(sizeof(all)/sizeof(all[0])));
+	for(PxU32 i=0; i<nbScenarios; i++)
+		scenarios[i] = all[i];
+	return nbScenarios;
+}
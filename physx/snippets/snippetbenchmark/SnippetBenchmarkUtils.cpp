@@ -0,0 +1,263 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "SnippetBenchmark.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxString.h"
+#include "foundation/PxTime.h"
+#include <stdarg.h>
+#include <string.h>
+
+using namespace physx;
+using namespace SnippetBenchmark;
+
+BenchmarkProfiler::BenchmarkProfiler()
+{
+	reset();
+}
+
+void* BenchmarkProfiler::zoneStart(const char* eventName, bool detached, uint64_t contextId)
+{
+	PX_UNUSED(eventName);
+	PX_UNUSED(contextId);
+
+	// Cross-thread zones overlap the nested zones of the stages and are not reported.
+	if(detached)
+		return NULL;
+
+	// The start time is handed back to zoneEnd through the profiler data. On 32-bit platforms only the low
+	// bits are kept, which is fine since durations are computed modulo the pointer size.
+	return reinterpret_cast<void*>(size_t(PxTime::getCurrentCounterValue()));
+}
+
+void BenchmarkProfiler::zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId)
+{
+	PX_UNUSED(contextId);
+
+	if(detached)
+		return;
+
+	const size_t ticks = size_t(PxTime::getCurrentCounterValue()) - reinterpret_cast<size_t>(profilerData);
+
+	// Open addressing on the name pointer. Slots are claimed with a CAS and never released until reset,
+	// so the table is lock-free. Names are static strings, see PxProfilerCallback.
+	void* key = const_cast<char*>(eventName);
+	PxU32 index = PxU32((reinterpret_cast<size_t>(key) >> 3) * 2654435761u) & (TABLE_SIZE - 1);
+	for(PxU32 i=0; i<TABLE_SIZE; i++)
+	{
+		Slot& slot = mSlots[index];
+		void* current = const_cast<void*>(slot.name);
+		if(!current)
+			current = PxAtomicCompareExchangePointer(&slot.name, key, NULL);
+
+		if(!current || current == key)
+		{
+			PxAtomicIncrement(&slot.nbCalls);
+			PxAtomicAdd(&slot.totalTicks, PxI64(ticks));
+			return;
+		}
+		index = (index + 1) & (TABLE_SIZE - 1);
+	}
+	PxAtomicIncrement(&mNbDroppedZones);
+}
+
+void BenchmarkProfiler::reset()
+{
+	PxMemZero(mSlots, sizeof(mSlots));
+	mNbDroppedZones = 0;
+}
+
+PxU32 BenchmarkProfiler::getZoneStats(ZoneStats* stats, PxU32 maxNbStats) const
+{
+	// The same name can appear with different pointers, e.g. when it is used from several libraries.
+	PxU32 nbStats = 0;
+	for(PxU32 i=0; i<TABLE_SIZE; i++)
+	{
+		const char* name = reinterpret_cast<const char*>(const_cast<const void*>(mSlots[i].name));
+		if(!name)
+			continue;
+
+		PxU32 j = 0;
+		while(j<nbStats && strcmp(stats[j].name, name))
+			j++;
+
+		if(j == nbStats)
+		{
+			if(nbStats == maxNbStats)
+				continue;
+			stats[nbStats].name = name;
+			stats[nbStats].nbCalls = 0;
+			stats[nbStats].totalTicks = 0;
+			nbStats++;
+		}
+		stats[j].nbCalls += PxU64(mSlots[i].nbCalls);
+		stats[j].totalTicks += PxU64(mSlots[i].totalTicks);
+	}
+
+	// Insertion sort, there are at most a few hundred zones.
+	for(PxU32 i=1; i<nbStats; i++)
+	{
+		const ZoneStats s = stats[i];
+		PxU32 j = i;
+		while(j>0 && stats[j-1].totalTicks < s.totalTicks)
+		{
+			stats[j] = stats[j-1];
+			j--;
+		}
+		stats[j] = s;
+	}
+	return nbStats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Keeps the 16-byte alignment guaranteed by PxDefaultAllocator.
+static const size_t gAllocationHeaderSize = 16;
+
+void* BenchmarkAllocator::allocate(size_t size, const char* typeName, const char* filename, int line)
+{
+	PxU8* memory = reinterpret_cast<PxU8*>(mAllocator.allocate(size + gAllocationHeaderSize, typeName, filename, line));
+	if(!memory)
+		return NULL;
+
+	*reinterpret_cast<size_t*>(memory) = size;
+
+	const PxI64 currentBytes = PxAtomicAdd(&mCurrentBytes, PxI64(size));
+	PxAtomicMax(&mPeakBytes, currentBytes);
+	PxAtomicIncrement(&mNbAllocations);
+	return memory + gAllocationHeaderSize;
+}
+
+void BenchmarkAllocator::deallocate(void* ptr)
+{
+	if(!ptr)
+		return;
+
+	PxU8* memory = reinterpret_cast<PxU8*>(ptr) - gAllocationHeaderSize;
+	PxAtomicAdd(&mCurrentBytes, -PxI64(*reinterpret_cast<size_t*>(memory)));
+	mAllocator.deallocate(memory);
+}
+
+void BenchmarkAllocator::resetPeak()
+{
+	PxAtomicExchange(&mPeakBytes, PxI64(mCurrentBytes));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void JsonWriter::print(const char* format, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, format);
+	const PxI32 length = Pxvsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	if(length > 0)
+		mStream.write(buffer, PxMin(PxU32(length), PxU32(sizeof(buffer) - 1)));
+}
+
+void JsonWriter::newLine()
+{
+	mStream.write("\n", 1);
+	for(PxU32 i=0; i<mDepth; i++)
+		mStream.write("\t", 1);
+}
+
+void JsonWriter::writeKey(const char* key)
+{
+	if(mNeedComma)
+		mStream.write(",", 1);
+	if(mDepth)
+		newLine();
+	if(key)
+		print("\"%s\": ", key);
+	mNeedComma = true;
+}
+
+void JsonWriter::beginObject(const char* key)
+{
+	writeKey(key);
+	mStream.write("{", 1);
+	mDepth++;
+	mNeedComma = false;
+}
+
+void JsonWriter::endObject()
+{
+	mDepth--;
+	newLine();
+	mStream.write("}", 1);
+	mNeedComma = true;
+	if(!mDepth)
+		newLine();
+}
+
+void JsonWriter::beginArray(const char* key)
+{
+	writeKey(key);
+	mStream.write("[", 1);
+	mDepth++;
+	mNeedComma = false;
+}
+
+void JsonWriter::endArray()
+{
+	mDepth--;
+	newLine();
+	mStream.write("]", 1);
+	mNeedComma = true;
+}
+
+void JsonWriter::writeString(const char* key, const char* value)
+{
+	writeKey(key);
+	print("\"%s\"", value);
+}
+
+void JsonWriter::writeUInt(const char* key, PxU64 value)
+{
+	writeKey(key);
+	print("%llu", static_cast<unsigned long long>(value));
+}
+
+void JsonWriter::writeInt(const char* key, PxI64 value)
+{
+	writeKey(key);
+	print("%lld", static_cast<long long>(value));
+}
+
+void JsonWriter::writeFloat(const char* key, PxF64 value)
+{
+	writeKey(key);
+	print("%.6f", value);
+}
+
+void JsonWriter::writeBool(const char* key, bool value)
+{
+	writeKey(key);
+	print("%s", value ? "true" : "false");
+}
@@ -0,0 +1,201 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+
+// ****************************************************************************
+
+// ****************************************************************************
+// This snippet illustrates how to move a set of character controllers with
+// PxControllerManager::moveAll().
+//
+// The characters walk on a floor made of many small static boxes, so that
+// their scene queries return more shapes than PxController::move() keeps.
+// The same moves are done with PxController::move(), and with moveAll()
+// without a CPU dispatcher and with dispatchers using different numbers of
+// threads. The characters are far enough from each other not to interact,
+// so the snippet checks that all the runs give identical results.
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbTilesPerSide		= 100;	// Floor tiles along each axis
+static const PxReal	gTileSpacing		= 0.1f;
+static const PxU32	gNbCharactersPerSide	= 2;	// Characters along each axis
+static const PxReal	gCharacterSpacing	= 5.0f;
+static const PxU32	gNbSteps			= 200;
+static const PxReal	gTimestep			= 1.0f/60.0f;
+
+static void createFloor(PxScene& scene)
+{
+	// Tiles of pseudo-random heights, low enough for the characters to step over them
+	const PxReal offset = -0.5f * gTileSpacing * PxReal(gNbTilesPerSide-1);
+	for(PxU32 j=0; j<gNbTilesPerSide; j++)
+	{
+		for(PxU32 i=0; i<gNbTilesPerSide; i++)
+		{
+			const PxU32 hash = (i*73856093u) ^ (j*19349663u);
+			const PxReal halfHeight = 0.05f + 0.01f * PxReal(hash % 8);
+
+			const PxVec3 position(offset + PxReal(i)*gTileSpacing, halfHeight, offset + PxReal(j)*gTileSpacing);
+			const PxBoxGeometry tile(gTileSpacing*0.45f, halfHeight, gTileSpacing*0.45f);
+			scene.addActor(*PxCreateStatic(*gPhysics, PxTransform(position), tile, *gMaterial));
+		}
+	}
+	scene.addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+}
+
+// Moves the characters for gNbSteps steps, with moveAll() if useMoveAll is true, or with PxController::move() otherwise
+static void runCharacters(bool useMoveAll, PxCpuDispatcher* dispatcher, PxArray<PxExtendedVec3>& positions, PxArray<PxU8>& flags)
+{
+	PxDefaultCpuDispatcher* sceneDispatcher = PxDefaultCpuDispatcherCreate(0);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= sceneDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	createFloor(*scene);
+
+	PxControllerManager* manager = PxCreateControllerManager(*scene);
+
+	const PxReal offset = -0.5f * gCharacterSpacing * PxReal(gNbCharactersPerSide-1);
+	PxArray<PxControllerMoveDesc> descs;
+	for(PxU32 j=0; j<gNbCharactersPerSide; j++)
+	{
+		for(PxU32 i=0; i<gNbCharactersPerSide; i++)
+		{
+			PxCapsuleControllerDesc desc;
+			desc.radius		= 0.4f;
+			desc.height		= 1.2f;
+			desc.stepOffset	= 0.3f;
+			desc.material	= gMaterial;
+			desc.position	= PxExtendedVec3(offset + PxReal(i)*gCharacterSpacing, 1.5, offset + PxReal(j)*gCharacterSpacing);
+
+			PxControllerMoveDesc& moveDesc = descs.insert();
+			moveDesc.controller		= manager->createController(desc);
+			moveDesc.minDist		= 0.001f;
+			moveDesc.elapsedTime	= gTimestep;
+		}
+	}
+	const PxU32 nbCharacters = descs.size();
+
+	positions.clear();
+	flags.clear();
+	for(PxU32 step=0; step<gNbSteps; step++)
+	{
+		// Each character walks in a circle, well away from the others
+		for(PxU32 i=0; i<nbCharacters; i++)
+		{
+			const PxReal angle = PxReal(step)*0.05f + PxReal(i);
+			descs[i].disp = PxVec3(PxCos(angle), -1.0f, PxSin(angle)) * (2.0f * gTimestep);
+		}
+
+		if(useMoveAll)
+		{
+			manager->moveAll(nbCharacters, descs.begin(), dispatcher);
+		}
+		else
+		{
+			for(PxU32 i=0; i<nbCharacters; i++)
+			{
+				PxControllerMoveDesc& desc = descs[i];
+				desc.collisionFlags = desc.controller->move(desc.disp, desc.minDist, desc.elapsedTime, desc.filters, desc.obstacles);
+			}
+		}
+
+		for(PxU32 i=0; i<nbCharacters; i++)
+			flags.pushBack(PxU8(PxU32(descs[i].collisionFlags)));
+	}
+
+	for(PxU32 i=0; i<nbCharacters; i++)
+		positions.pushBack(descs[i].controller->getPosition());
+
+	manager->release();
+	scene->release();
+	sceneDispatcher->release();
+}
+
+// Runs the reference moves with PxController::move(), then compares them to moveAll() with different numbers of threads
+static void compareMoves()
+{
+	PxArray<PxExtendedVec3> referencePositions;
+	PxArray<PxU8> referenceFlags;
+	runCharacters(false, NULL, referencePositions, referenceFlags);
+
+	const PxU32 nbThreads[] = { 0, 1, 2, 4 };
+	for(PxU32 i=0; i<PX_ARRAY_SIZE(nbThreads); i++)
+	{
+		PxDefaultCpuDispatcher* dispatcher = nbThreads[i] ? PxDefaultCpuDispatcherCreate(nbThreads[i]) : NULL;
+
+		PxArray<PxExtendedVec3> positions;
+		PxArray<PxU8> flags;
+		runCharacters(true, dispatcher, positions, flags);
+
+		PX_RELEASE(dispatcher);
+
+		const bool identical = positions.size()==referencePositions.size() && flags.size()==referenceFlags.size()
+			&& !memcmp(positions.begin(), referencePositions.begin(), positions.size()*sizeof(PxExtendedVec3))
+			&& !memcmp(flags.begin(), referenceFlags.begin(), flags.size()*sizeof(PxU8));
+		printf("moveAll() with %d threads: results %s to PxController::move()\n", nbThreads[i], identical ? "identical" : "DIFFERENT");
+		PX_ASSERT(identical);
+	}
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetCharacterMoveAll done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+
+	compareMoves();
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+// ****************************************************************************
+// This snippet illustrates how to record profiling events in the Chrome Trace
+// Event format, which can be opened directly in chrome://tracing or in the
+// Perfetto UI (ui.perfetto.dev), without a conversion step.
+//
+// SnippetChromeTraceProfiler supports the following options:
+//
+//  --dstFile=<filename>             Specify the destination json file (default: PhysXTrace.json)
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "extensions/PxChromeTraceProfiler.h"
+#include "../snippetutils/SnippetUtils.h"
+#include <string.h>
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+static PxChromeTraceProfiler*	gProfiler	= NULL;
+
+static void createStack(const PxTransform& t, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size;i++)
+	{
+		for(PxU32 j=0;j<size-i;j++)
+		{
+			PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0) * halfExtent);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(t.transform(localTm));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			gScene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static void initPhysics(PxOutputStream& stream)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	// The profiler records events in per-thread ring buffers. At most 16 threads are recorded here, with
+	// 64K events per thread between two flushes. Events that don't fit are dropped and counted.
+	gProfiler = PxChromeTraceProfilerCreate(stream, 16, 65536);
+	PxSetProfilerCallback(gProfiler);
+
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher = PxDefaultCpuDispatcherCreate(4);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial);
+	gScene->addActor(*groundPlane);
+
+	for(PxU32 i=0;i<20;i++)
+		createStack(PxTransform(PxVec3(0,0,-10.0f*PxReal(i))), 10, 1.0f);
+
+	PxRigidDynamic* ball = PxCreateDynamic(*gPhysics, PxTransform(PxVec3(0,20,100)), PxSphereGeometry(5), *gMaterial, 10.0f);
+	ball->setLinearVelocity(PxVec3(0,-20,-100));
+	gScene->addActor(*ball);
+}
+
+static void stepPhysics(PxU32 frame)
+{
+	gScene->simulate(1.0f/60.0f);
+	gScene->fetchResults(true);
+
+	// Sample the simulation statistics as counter tracks.
+	gProfiler->recordSimulationStatistics(*gScene);
+
+	// Flushing regularly keeps the ring buffers from filling up. This is also safe to call while the simulation is running.
+	if((frame % 10) == 9)
+		gProfiler->flush();
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+
+	PxSetProfilerCallback(NULL);
+	printf("Dropped events: %llu\n", (unsigned long long)gProfiler->getNbDroppedEvents());
+	PX_RELEASE(gProfiler);	// This flushes the remaining events and closes the JSON array.
+
+	PX_RELEASE(gFoundation);
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	const char* dstFile = "PhysXTrace.json";
+	for(int i=1; i<argc; i++)
+	{
+		if(!strncmp(argv[i], "--dstFile=", 10))
+			dstFile = argv[i] + 10;
+	}
+
+	PxDefaultFileOutputStream stream(dstFile);
+	if(!stream.isValid())
+	{
+		printf("Could not open output file, \"%s\"!\n", dstFile);
+		return 1;
+	}
+
+	static const PxU32 frameCount = 200;
+	initPhysics(stream);
+	for(PxU32 i=0; i<frameCount; i++)
+		stepPhysics(i);
+	cleanupPhysics();
+
+#if (PX_DEBUG || PX_CHECKED || PX_PROFILE)
+	printf("SnippetChromeTraceProfiler done. Open %s in chrome://tracing or ui.perfetto.dev.\n", dstFile);
+#else
+	printf("Warning: SnippetChromeTraceProfiler does not capture the profiler timings in release build.\n");
+#endif
+
+	return 0;
+}
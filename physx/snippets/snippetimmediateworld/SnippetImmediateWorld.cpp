@@ -0,0 +1,249 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+// ****************************************************************************
+
+// ****************************************************************************
+// This snippet illustrates how to use PxImmediateWorld, a rigid body world
+// built on the immediate mode functions.
+//
+// It creates stacks of boxes on a ground plane and a pendulum made of two
+// boxes connected by spherical joints. Midway through the simulation the
+// bottom box of one stack is removed, and a new box is added, reusing the
+// removed body's handle.
+//
+// The same scene is simulated with the PGS and TGS solvers, without a CPU
+// dispatcher and with dispatchers using different numbers of threads. The
+// snippet checks that the results do not depend on the number of threads.
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+#include "PxImmediateWorld.h"
+
+using namespace physx;
+using namespace immediate;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbStacks		= 4;	// Number of stacks along each axis
+static const PxU32	gStackHeight	= 8;
+static const PxU32	gNbSteps		= 300;
+static const PxU32	gRemovalStep	= 100;	// Step before which the bottom box of the first stack is removed
+static const PxReal	gTimestep		= 1.0f/60.0f;
+static const PxReal	gHalfExtent		= 0.5f;
+
+// Constant block of the spherical joints. The anchors are relative to the bodies' poses, or to the world frame when the body is not set.
+struct SphericalJointData
+{
+	PxVec3	localAnchor0;
+	PxVec3	localAnchor1;
+};
+
+// Solver prep function of the spherical joints: three equality rows keep both anchors at the same position.
+static PxU32 sphericalJointPrep(Px1DConstraint* constraints, PxVec3p& body0WorldOffset, PxU32 /*maxConstraints*/, PxConstraintInvMassScale& invMassScale,
+	const void* constantBlock, const PxTransform& bA2w, const PxTransform& bB2w, bool /*useExtendedLimits*/, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	const SphericalJointData& data = *reinterpret_cast<const SphericalJointData*>(constantBlock);
+
+	invMassScale.linear0 = invMassScale.linear1 = invMassScale.angular0 = invMassScale.angular1 = 1.0f;
+
+	const PxVec3 anchor0 = bA2w.transform(data.localAnchor0);
+	const PxVec3 anchor1 = bB2w.transform(data.localAnchor1);
+	cA2wOut = anchor0;
+	cB2wOut = anchor1;
+
+	const PxVec3 ra = anchor1 - bA2w.p;
+	const PxVec3 rb = anchor1 - bB2w.p;
+	body0WorldOffset = ra;
+
+	for(PxU32 i=0; i<3; i++)
+	{
+		PxVec3 axis(0.0f);
+		axis[i] = 1.0f;
+
+		Px1DConstraint& c = constraints[i];
+		PxMemZero(&c, sizeof(Px1DConstraint));
+		c.solveHint			= PxConstraintSolveHint::eEQUALITY;
+		c.linear0			= axis;
+		c.angular0			= ra.cross(axis);
+		c.linear1			= axis;
+		c.angular1			= rb.cross(axis);
+		c.geometricError	= -axis.dot(anchor1 - anchor0);
+		c.minImpulse		= -PX_MAX_F32;
+		c.maxImpulse		= PX_MAX_F32;
+	}
+	return 3;
+}
+
+static PxImmediateBodyDesc getBoxDesc(const PxBoxGeometry& geometry, const PxVec3& position)
+{
+	// Mass 1 and the inertia of a cube
+	const PxReal side = 2.0f*gHalfExtent;
+	PxImmediateBodyDesc desc;
+	desc.geometry	= &geometry;
+	desc.pose		= PxTransform(position);
+	desc.invMass	= 1.0f;
+	desc.invInertia	= PxVec3(6.0f/(side*side));
+	return desc;
+}
+
+// Simulates the scene and returns the final poses, indexed by body handle.
+static void runSimulation(PxSolverType::Enum solverType, PxCpuDispatcher* dispatcher, PxArray<PxTransform>& poses, PxImmediateWorldStats& stats)
+{
+	PxTolerancesScale scale;
+	PxImmediateWorldDesc worldDesc(scale);
+	worldDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	worldDesc.solverType	= solverType;
+	worldDesc.cpuDispatcher	= dispatcher;
+	// Small tasks and batches, so that even this small scene is split between the threads
+	worldDesc.nbPairsPerTask	= 32;
+	worldDesc.nbBodiesPerBatch	= 16;
+
+	PxImmediateWorld* world = PxCreateImmediateWorld(worldDesc);
+
+	const PxPlaneGeometry planeGeometry;
+	PxImmediateBodyDesc groundDesc;
+	groundDesc.geometry	= &planeGeometry;
+	groundDesc.pose		= PxTransformFromPlaneEquation(PxPlane(0.0f, 1.0f, 0.0f, 0.0f));
+	world->addBody(groundDesc);
+
+	const PxBoxGeometry boxGeometry(gHalfExtent, gHalfExtent, gHalfExtent);
+
+	PxImmediateBodyHandle removedBody = PX_IMMEDIATE_INVALID_HANDLE;
+	for(PxU32 x=0; x<gNbStacks; x++)
+	{
+		for(PxU32 z=0; z<gNbStacks; z++)
+		{
+			for(PxU32 y=0; y<gStackHeight; y++)
+			{
+				const PxVec3 position(PxReal(x)*3.0f, gHalfExtent + PxReal(y)*2.0f*gHalfExtent, PxReal(z)*3.0f);
+				const PxImmediateBodyHandle body = world->addBody(getBoxDesc(boxGeometry, position));
+				if(removedBody==PX_IMMEDIATE_INVALID_HANDLE)
+					removedBody = body;
+			}
+		}
+	}
+
+	// A pendulum hanging from a fixed point in the world, away from the stacks. It starts horizontal.
+	const PxVec3 pivot(-5.0f, 10.0f, 0.0f);
+	const PxImmediateBodyHandle link0 = world->addBody(getBoxDesc(boxGeometry, pivot + PxVec3(2.0f, 0.0f, 0.0f)));
+	const PxImmediateBodyHandle link1 = world->addBody(getBoxDesc(boxGeometry, pivot + PxVec3(4.0f, 0.0f, 0.0f)));
+
+	const SphericalJointData joint0 = { pivot, PxVec3(-2.0f, 0.0f, 0.0f) };
+	const SphericalJointData joint1 = { PxVec3(1.0f, 0.0f, 0.0f), PxVec3(-1.0f, 0.0f, 0.0f) };
+
+	PxImmediateJointDesc jointDesc;
+	jointDesc.constraint.prep			= sphericalJointPrep;
+	jointDesc.constraint.constantBlock	= &joint0;
+	jointDesc.body1						= link0;
+	world->addJoint(jointDesc);
+
+	jointDesc.constraint.constantBlock	= &joint1;
+	jointDesc.body0						= link0;
+	jointDesc.body1						= link1;
+	world->addJoint(jointDesc);
+
+	for(PxU32 i=0; i<gNbSteps; i++)
+	{
+		// Removing the bottom box of a stack drops its persistent pairs. The stack then falls on the ground.
+		if(i==gRemovalStep)
+			world->removeBody(removedBody);
+
+		// Removed handles are recycled once a step has run, so the new box gets the handle of the removed one
+		if(i==gRemovalStep+1)
+		{
+			const PxImmediateBodyHandle body = world->addBody(getBoxDesc(boxGeometry, PxVec3(-3.0f, 3.0f, 6.0f)));
+			PX_ASSERT(body==removedBody);
+			PX_UNUSED(body);
+		}
+
+		world->step(gTimestep);
+	}
+
+	world->getStats(stats);
+
+	const PxTransform* worldPoses = world->getPoses();
+	poses.assign(worldPoses, worldPoses + world->getBodyCapacity());
+
+	const PxVec3 error0 = poses[link0].transform(joint0.localAnchor1) - joint0.localAnchor0;
+	const PxVec3 error1 = poses[link1].transform(joint1.localAnchor1) - poses[link0].transform(joint1.localAnchor0);
+	printf("\t Joint errors: %f %f, ", double(error0.magnitude()), double(error1.magnitude()));
+
+	world->release();
+}
+
+static void runSolver(PxSolverType::Enum solverType)
+{
+	printf("%s solver:\n", solverType==PxSolverType::eTGS ? "TGS" : "PGS");
+
+	PxArray<PxTransform> referencePoses;
+	PxImmediateWorldStats stats;
+	runSimulation(solverType, NULL, referencePoses, stats);
+	printf("%d islands, %d touching pairs, %d contacts\n", stats.nbIslands, stats.nbTouchingPairs, stats.nbContacts);
+
+	const PxU32 nbThreads[] = { 1, 2, 4 };
+	for(PxU32 i=0; i<PX_ARRAY_SIZE(nbThreads); i++)
+	{
+		PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads[i]);
+
+		PxArray<PxTransform> poses;
+		runSimulation(solverType, dispatcher, poses, stats);
+
+		dispatcher->release();
+
+		const bool identical = poses.size()==referencePoses.size()
+			&& !memcmp(poses.begin(), referencePoses.begin(), poses.size()*sizeof(PxTransform));
+		printf("%d solver batches, results with %d threads %s\n", stats.nbSolverBatches, nbThreads[i], identical ? "identical" : "DIFFERENT");
+		PX_ASSERT(identical);
+	}
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetImmediateWorld done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+
+	runSolver(PxSolverType::ePGS);
+	runSolver(PxSolverType::eTGS);
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,240 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+// ****************************************************************************
+// This snippet illustrates packet raycasts against a triangle mesh.
+//
+// It simulates a lidar-like sensor sweeping a random terrain with fans of
+// coherent rays. The same rays are cast one at a time with
+// PxGeometryQuery::raycast() and in packets of 4, 8 and 16 rays with
+// PxGeometryQuery::raycastPacket(). The snippet checks that both methods
+// return the same hits and prints the timings.
+//
+// Packet raycasts are most efficient for meshes using the BVH34 midphase,
+// and for rays with similar origins and directions.
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxTriangleMesh*			gMesh		= NULL;
+
+static const PxU32	gNbSensors			= 256;	// Number of sensor positions
+static const PxU32	gNbRaysPerSensor	= 1024;	// Number of rays per sensor, must be a multiple of 16
+static const PxReal	gSensorRange		= 100.0f;
+
+static float rand(float loVal, float hiVal)
+{
+	return loVal + float(rand()/float(RAND_MAX))*(hiVal - loVal);
+}
+
+// Creates a random terrain mesh using the BVH34 midphase.
+static PxTriangleMesh* createTerrainMesh(PxU32 numRows, PxU32 numColumns, PxReal cellSize, PxReal heightScale)
+{
+	const PxU32 numX = numColumns + 1;
+	const PxU32 numZ = numRows + 1;
+	const PxU32 numVertices = numX*numZ;
+	const PxU32 numTriangles = numRows*numColumns*2;
+
+	PxVec3* vertices = new PxVec3[numVertices];
+	PxU32* indices = new PxU32[numTriangles*3];
+
+	PxU32 currentIdx = 0;
+	for(PxU32 i=0; i<numZ; i++)
+	{
+		for(PxU32 j=0; j<numX; j++)
+			vertices[currentIdx++] = PxVec3(PxReal(j)*cellSize, heightScale*rand(-1.0f, 1.0f), PxReal(i)*cellSize);
+	}
+
+	currentIdx = 0;
+	for(PxU32 i=0; i<numRows; i++)
+	{
+		for(PxU32 j=0; j<numColumns; j++)
+		{
+			const PxU32 base = numX*i + j;
+			indices[currentIdx++] = base + 1;
+			indices[currentIdx++] = base;
+			indices[currentIdx++] = base + numX;
+			indices[currentIdx++] = base + numX + 1;
+			indices[currentIdx++] = base + 1;
+			indices[currentIdx++] = base + numX;
+		}
+	}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= numVertices;
+	meshDesc.points.data		= vertices;
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.triangles.count	= numTriangles;
+	meshDesc.triangles.data		= indices;
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	params.midphaseDesc = PxMeshMidPhase::eBVH34;
+	params.suppressTriangleMeshRemapTable = true;
+
+	PxTriangleMesh* mesh = PxCreateTriangleMesh(params, meshDesc, gPhysics->getPhysicsInsertionCallback());
+
+	delete [] vertices;
+	delete [] indices;
+
+	return mesh;
+}
+
+// Fills packets with the rays of a sensor. Consecutive rays of the fan end up in the same packet.
+static void setupSensorPackets(PxRayPacket* packets, PxU32 packetSize, const PxVec3& sensorPos, PxReal heading)
+{
+	const PxU32 nbPackets = gNbRaysPerSensor/packetSize;
+	for(PxU32 i=0; i<nbPackets; i++)
+	{
+		PxRayPacket& packet = packets[i];
+		packet.nbRays = packetSize;
+		for(PxU32 j=0; j<packetSize; j++)
+		{
+			const PxU32 rayIndex = i*packetSize + j;
+			// 32 scan lines looking down, each covering a 90 degrees arc
+			const PxReal pitch = -0.05f - 0.6f*PxReal(rayIndex/32)/32.0f;
+			const PxReal yaw = heading + PxPiDivTwo*(PxReal(rayIndex%32)/32.0f - 0.5f);
+			const PxVec3 dir(PxCos(pitch)*PxCos(yaw), PxSin(pitch), PxCos(pitch)*PxSin(yaw));
+			packet.setRay(j, sensorPos, dir.getNormalized(), gSensorRange);
+		}
+	}
+}
+
+static bool sameHit(const PxGeomRaycastHit& hit0, const PxGeomRaycastHit& hit1)
+{
+	return hit0.faceIndex==hit1.faceIndex && hit0.distance==hit1.distance && hit0.position==hit1.position && hit0.normal==hit1.normal;
+}
+
+static void runRaycasts(PxU32 packetSize)
+{
+	const PxTriangleMeshGeometry meshGeom(gMesh);
+	const PxTransform pose(PxIdentity);
+
+	const PxU32 nbPackets = gNbRaysPerSensor/packetSize;
+	PxRayPacket* packets = new PxRayPacket[nbPackets];
+	PxGeomRaycastHit* singleHits = new PxGeomRaycastHit[gNbRaysPerSensor];
+	PxGeomRaycastHit* packetHits = new PxGeomRaycastHit[gNbRaysPerSensor];
+	PxU32* singleHitMasks = new PxU32[nbPackets];
+	PxU32* packetHitMasks = new PxU32[nbPackets];
+
+	PxU64 singleTime = 0;
+	PxU64 packetTime = 0;
+	PxU32 nbHits = 0;
+	PxU32 nbErrors = 0;
+
+	srand(42);
+	for(PxU32 s=0; s<gNbSensors; s++)
+	{
+		const PxVec3 sensorPos(rand(20.0f, 236.0f), 4.0f, rand(20.0f, 236.0f));
+		setupSensorPackets(packets, packetSize, sensorPos, rand(0.0f, PxTwoPi));
+
+		PxU64 time = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0; i<nbPackets; i++)
+		{
+			const PxRayPacket& packet = packets[i];
+			PxU32 hitMask = 0;
+			for(PxU32 j=0; j<packetSize; j++)
+			{
+				if(PxGeometryQuery::raycast(packet.getOrigin(j), packet.getDir(j), meshGeom, pose, packet.maxDist[j], PxHitFlag::eDEFAULT, 1, singleHits + i*packetSize + j))
+					hitMask |= 1<<j;
+			}
+			singleHitMasks[i] = hitMask;
+		}
+		singleTime += SnippetUtils::getCurrentTimeCounterValue() - time;
+
+		time = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0; i<nbPackets; i++)
+			packetHitMasks[i] = PxGeometryQuery::raycastPacket(packets[i], meshGeom, pose, PxHitFlag::eDEFAULT, packetHits + i*packetSize);
+		packetTime += SnippetUtils::getCurrentTimeCounterValue() - time;
+
+		for(PxU32 i=0; i<nbPackets; i++)
+		{
+			if(singleHitMasks[i]!=packetHitMasks[i])
+			{
+				nbErrors++;
+				continue;
+			}
+			for(PxU32 j=0; j<packetSize; j++)
+			{
+				if(singleHitMasks[i] & (1<<j))
+				{
+					nbHits++;
+					if(!sameHit(singleHits[i*packetSize + j], packetHits[i*packetSize + j]))
+						nbErrors++;
+				}
+			}
+		}
+	}
+
+	const PxU32 nbRays = gNbSensors*gNbRaysPerSensor;
+	printf("Packets of %2d rays: %d rays, %d hits, single rays: %.2f ms, packets: %.2f ms, mismatches: %d\n",
+		packetSize, nbRays, nbHits, double(SnippetUtils::getElapsedTimeInMilliseconds(singleTime)), double(SnippetUtils::getElapsedTimeInMilliseconds(packetTime)), nbErrors);
+
+	delete [] packetHitMasks;
+	delete [] singleHitMasks;
+	delete [] packetHits;
+	delete [] singleHits;
+	delete [] packets;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	srand(50);
+	gMesh = createTerrainMesh(256, 256, 1.0f, 1.0f);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gMesh);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetRayPacket done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+
+	runRaycasts(4);
+	runRaycasts(8);
+	runRaycasts(16);
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -31,6 +31,9 @@
 //
 // The snippet creates triangle mesh with a different cooking settings 
 // and shows how these settings affect the triangle mesh creation speed.
+//
+// It also cooks a flat grid with and without a CPU dispatcher and checks
+// that the cooked data is identical in both cases.
 // ****************************************************************************
 
 #include <ctype.h>
@@ -297,6 +300,61 @@ void createBV34TriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 num
 	triMesh->release();
 }
 
+// Cooks a triangle mesh using BVH34 midphase with the SAH build strategy, optionally on a CPU dispatcher.
+static void cookBV34SAHTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices,
+	PxCpuDispatcher* dispatcher, PxDefaultMemoryOutputStream& outBuffer)
+{
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count = numVertices;
+	meshDesc.points.data = vertices;
+	meshDesc.points.stride = sizeof(PxVec3);
+	meshDesc.triangles.count = numTriangles;
+	meshDesc.triangles.data = indices;
+	meshDesc.triangles.stride = 3 * sizeof(PxU32);
+
+	PxTolerancesScale scale;
+	PxCookingParams params(scale);
+	params.midphaseDesc = PxMeshMidPhase::eBVH34;
+	params.midphaseDesc.mBVH34Desc.buildStrategy = PxBVH34BuildStrategy::eSAH;
+	params.cpuDispatcher = dispatcher;
+
+	PxCookTriangleMesh(params, meshDesc, outBuffer);
+}
+
+// Cooks a flat grid serially and on a CPU dispatcher, and compares the cooked data. All the triangles of a flat grid have
+// the same height, so the BVH build sorts many equal keys. The result must not depend on how the work is split between threads.
+static void compareParallelCooking()
+{
+	const PxU32 numColumns = 128;
+	const PxU32 numRows = 128;
+	const PxU32 numVertices = (numColumns + 1)*(numRows + 1);
+	const PxU32 numTriangles = numColumns*numRows * 2;
+
+	PxVec3* vertices = new PxVec3[numVertices];
+	PxU32* indices = new PxU32[numTriangles * 3];
+
+	createRandomTerrain(PxVec3(0.0f, 0.0f, 0.0f), numRows, numColumns, 1.0f, 1.0f, 0.0f, vertices, indices);
+
+	PxDefaultMemoryOutputStream serialBuffer;
+	cookBV34SAHTriangleMesh(numVertices, vertices, numTriangles, indices, NULL, serialBuffer);
+
+	PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(4);
+	PxDefaultMemoryOutputStream parallelBuffer;
+	cookBV34SAHTriangleMesh(numVertices, vertices, numTriangles, indices, dispatcher, parallelBuffer);
+	dispatcher->release();
+
+	const bool identical = serialBuffer.getSize() == parallelBuffer.getSize()
+		&& !memcmp(serialBuffer.getData(), parallelBuffer.getData(), serialBuffer.getSize());
+
+	printf("-----------------------------------------------\n");
+	printf("Cook a flat grid with %d triangles with and without a CPU dispatcher: \n\n", numTriangles);
+	printf("\t Cooked data %s (%d bytes)\n", identical ? "identical" : "DIFFERENT", serialBuffer.getSize());
+	PX_ASSERT(identical);
+
+	delete [] vertices;
+	delete [] indices;
+}
+
 void createTriangleMeshes()
 {	
 	const PxU32 numColumns = 128;
@@ -357,6 +415,8 @@ void createTriangleMeshes()
 
 	delete [] vertices;
 	delete [] indices;
+
+	compareParallelCooking();
 }
 
 void initPhysics()
@@ -41,6 +41,7 @@ SET(LLDYNAMICS_INCLUDES
 	${LLDYNAMICS_BASE_DIR}/include/DyArticulationCore.h
 	${LLDYNAMICS_BASE_DIR}/include/DyVArticulation.h
 	${LLDYNAMICS_BASE_DIR}/include/DyArticulationTendon.h
+	${LLDYNAMICS_BASE_DIR}/include/DyArticulationTopology.h
 	${LLDYNAMICS_BASE_DIR}/include/DyArticulationMimicJointCore.h
 	${LLDYNAMICS_BASE_DIR}/include/DyDeformableBodyCore.h
 	${LLDYNAMICS_BASE_DIR}/include/DyDeformableSurface.h
@@ -74,7 +75,9 @@ SET(LLDYNAMICS_SOURCE
 	${LLDYNAMICS_BASE_DIR}/src/DyAllocator.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyArticulationContactPrep.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyArticulationMimicJoint.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DyArticulationTopology.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneArticulation.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneBatchedForwardDynamic.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneForwardDynamic.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneInverseDynamic.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyConstraintPartition.cpp
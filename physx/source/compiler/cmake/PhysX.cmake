@@ -71,6 +71,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxFiltering.h
 	${PHYSX_ROOT_DIR}/include/PxForceMode.h
 	${PHYSX_ROOT_DIR}/include/PxImmediateMode.h
+	${PHYSX_ROOT_DIR}/include/PxImmediateWorld.h
 	${PHYSX_ROOT_DIR}/include/PxLockedData.h
 	${PHYSX_ROOT_DIR}/include/PxNodeIndex.h
 	${PHYSX_ROOT_DIR}/include/PxParticleBuffer.h
@@ -84,6 +85,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxPhysicsSerialization.h
 	${PHYSX_ROOT_DIR}/include/PxPhysXConfig.h
 	${PHYSX_ROOT_DIR}/include/PxPruningStructure.h
+	${PHYSX_ROOT_DIR}/include/PxQueryCandidateCache.h
 	${PHYSX_ROOT_DIR}/include/PxQueryFiltering.h
 	${PHYSX_ROOT_DIR}/include/PxQueryReport.h
 	${PHYSX_ROOT_DIR}/include/PxRigidActor.h
@@ -220,6 +222,7 @@ SOURCE_GROUP(src\\pvd FILES ${PHYSX_PVD_SOURCE})
 
 SET(PHYSX_IMMEDIATEMODE_SOURCE
 	${PHYSX_ROOT_DIR}/source/immediatemode/src/NpImmediateMode.cpp
+	${PHYSX_ROOT_DIR}/source/immediatemode/src/NpImmediateWorld.cpp
 )
 SOURCE_GROUP(src\\immediatemode FILES ${PHYSX_IMMEDIATEMODE_SOURCE})
 
@@ -271,6 +274,7 @@ SET(PHYSX_CORE_SOURCE
 	${PX_SOURCE_DIR}/NpScene.cpp
 	${PX_SOURCE_DIR}/NpSceneFetchResults.cpp
 	${PX_SOURCE_DIR}/NpSceneQueries.cpp
+	${PX_SOURCE_DIR}/NpSceneSnapshot.cpp
 	${PX_SOURCE_DIR}/NpSerializerAdapter.cpp
 	${PX_SOURCE_DIR}/NpShape.cpp
 	${PX_SOURCE_DIR}/NpShapeManager.cpp
@@ -116,9 +116,11 @@ SET(PHYSXCOMMON_GEOMETRY_HEADERS
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldFlag.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldGeometry.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldSample.h
+	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldTileLoader.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxMeshQuery.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxMeshScale.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxPlaneGeometry.h
+	${PHYSX_ROOT_DIR}/include/geometry/PxRayPacket.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxReportCallback.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxSimpleTriangleMesh.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxSphereGeometry.h
@@ -345,12 +347,14 @@ SOURCE_GROUP(geomutils\\src\\gjk FILES ${PHYSXCOMMON_GU_GJK_SOURCE})
 
 SET(PHYSXCOMMON_GU_HF_SOURCE
 	${GU_SOURCE_DIR}/src/hf/GuHeightField.cpp
+	${GU_SOURCE_DIR}/src/hf/GuHeightFieldTileCache.cpp
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldUtil.cpp
 	${GU_SOURCE_DIR}/src/hf/GuOverlapTestsHF.cpp
 	${GU_SOURCE_DIR}/src/hf/GuSweepsHF.cpp
 	${GU_SOURCE_DIR}/src/hf/GuEntityReport.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightField.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldData.h
+	${GU_SOURCE_DIR}/src/hf/GuHeightFieldTileCache.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldUtil.h
 )
 SOURCE_GROUP(geomutils\\src\\hf FILES ${PHYSXCOMMON_GU_HF_SOURCE})
@@ -553,6 +557,11 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuSecondaryPruner.cpp
 	${GU_SOURCE_DIR}/src/GuAABBPruner.h
 	${GU_SOURCE_DIR}/src/GuAABBPruner.cpp
+	${GU_SOURCE_DIR}/src/GuWideAABBTree.h
+	${GU_SOURCE_DIR}/src/GuWideAABBTree.cpp
+	${GU_SOURCE_DIR}/src/GuWideAABBTreeQuery.h
+	${GU_SOURCE_DIR}/src/GuWideAABBPruner.h
+	${GU_SOURCE_DIR}/src/GuWideAABBPruner.cpp
 	${GU_SOURCE_DIR}/src/GuActorShapeMap.cpp
 	${GU_SOURCE_DIR}/src/GuCallbackAdapter.h
 	${GU_SOURCE_DIR}/src/GuQuerySystem.cpp
@@ -563,6 +572,7 @@ SOURCE_GROUP(geomutils\\src\\pruners FILES ${PHYSXCOMMON_GU_PRUNERS_SOURCE})
 SET(PHYSXCOMMON_GU_COOKING_SOURCE
 	${GU_SOURCE_DIR}/src/cooking/GuRTreeCooking.h
 	${GU_SOURCE_DIR}/src/cooking/GuRTreeCooking.cpp
+	${GU_SOURCE_DIR}/src/cooking/GuCookingBatch.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingBVH.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingHF.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingGrbTriangleMesh.h
@@ -36,9 +36,11 @@ include(${PHYSX_ROOT_DIR}/${PROJECT_CMAKE_FILES_DIR}/${TARGET_BUILD_PLATFORM}/Ph
 
 SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtBroadPhase.cpp
+	${LL_SOURCE_DIR}/ExtChromeTraceProfiler.cpp
 	${LL_SOURCE_DIR}/ExtCollection.cpp
 	${LL_SOURCE_DIR}/ExtConvexMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.cpp
+	${LL_SOURCE_DIR}/ExtDefaultCookingCache.cpp
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.cpp
 	${LL_SOURCE_DIR}/ExtDefaultErrorCallback.cpp
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.cpp
@@ -64,6 +66,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtTriangleMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtTetrahedronMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtRemeshingExt.cpp
+	${LL_SOURCE_DIR}/ExtChromeTraceProfiler.h
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.h
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.h
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.h
@@ -73,6 +76,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtSerialization.h
 	${LL_SOURCE_DIR}/ExtSharedQueueEntryPool.h
 	${LL_SOURCE_DIR}/ExtTaskQueueHelper.h
+	${LL_SOURCE_DIR}/ExtWorkStealingDeque.h
 	${LL_SOURCE_DIR}/ExtSampling.cpp
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
@@ -170,10 +174,12 @@ SOURCE_GROUP(src\\omnipvd FILES ${PHYSX_EXTENSIONS_OMNIPVD_SOURCE})
 
 SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxBroadPhaseExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxChromeTraceProfiler.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCollectionExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxConvexMeshExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCudaHelpersExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultAllocator.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultCookingCache.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultCpuDispatcher.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultErrorCallback.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultProfiler.h
@@ -54,6 +54,7 @@ SET(PHYSXFOUNDATION_HEADERS
 	${PHYSX_ROOT_DIR}/include/foundation/PxBounds3.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxBroadcast.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxConstructor.h
+	${PHYSX_ROOT_DIR}/include/foundation/PxCpuFeatures.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxErrorCallback.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxErrors.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxFlags.h
@@ -102,6 +103,7 @@ SET(PHYSXFOUNDATION_HEADERS
 	${PHYSX_ROOT_DIR}/include/foundation/PxVecMathAoSScalar.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxVecMathAoSScalarInline.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxVecMathSSE.h
+	${PHYSX_ROOT_DIR}/include/foundation/PxVecMathAVX2.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxVecQuat.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxVecTransform.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxSIMDHelpers.h
@@ -115,6 +117,7 @@ SET(PHYSXFOUNDATION_SOURCE
 	${LL_SOURCE_DIR}/FdTempAllocator.cpp
 	${LL_SOURCE_DIR}/FdAssert.cpp
 	${LL_SOURCE_DIR}/FdMathUtils.cpp
+	${LL_SOURCE_DIR}/FdCpuFeatures.cpp
 	${LL_SOURCE_DIR}/FdFoundation.cpp
 	${LL_SOURCE_DIR}/FdFoundation.h
 )
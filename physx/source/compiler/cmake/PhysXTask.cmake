@@ -36,6 +36,7 @@ include(${PHYSX_ROOT_DIR}/${PROJECT_CMAKE_FILES_DIR}/${TARGET_BUILD_PLATFORM}/Ph
 
 SET(PHYSXTASK_HEADERS
 	${PHYSX_ROOT_DIR}/include/task/PxCpuDispatcher.h
+	${PHYSX_ROOT_DIR}/include/task/PxParallelFor.h
 	${PHYSX_ROOT_DIR}/include/task/PxTask.h
 	${PHYSX_ROOT_DIR}/include/task/PxTaskManager.h
 )
@@ -43,6 +43,10 @@ SET(PHYSX_VEHICLE_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleParams.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleMaths.h
 )
+SET(PHYSX_VEHICLE_BATCH_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatch.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchParams.h
+)
 SET(PHYSX_VEHICLE_BRAKING_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingFunctions.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingParams.h
@@ -120,6 +124,7 @@ SET(PHYSX_VEHICLE_PVD_HEADERS
 )
 
 SOURCE_GROUP(include FILES ${PHYSX_VEHICLE_HEADERS})
+SOURCE_GROUP(include\\batch FILES ${PHYSX_VEHICLE_BATCH_HEADERS})
 SOURCE_GROUP(include\\braking FILES ${PHYSX_VEHICLE_BRAKING_HEADERS})
 SOURCE_GROUP(include\\commands FILES ${PHYSX_VEHICLE_COMMAND_HEADERS})
 SOURCE_GROUP(include\\drivetrain FILES ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS})
@@ -135,6 +140,9 @@ SOURCE_GROUP(include\\wheel FILES ${PHYSX_VEHICLE_WHEEL_HEADERS})
 SOURCE_GROUP(include\\pvd FILES ${PHYSX_VEHICLE_PVD_HEADERS})
 
 
+SET(PHYSX_VEHICLE_BATCH_SOURCE
+	${LL_SOURCE_DIR}/batch/VhBatch.cpp
+)
 SET(PHYSX_VEHICLE_BRAKING_SOURCE
 )
 SET(PHYSX_VEHICLE_COMMANDS_SOURCE
@@ -182,6 +190,7 @@ SET(PHYSX_VEHICLE_PVD_SOURCE
 	${LL_SOURCE_DIR}/pvd/VhPvdWriter.h
 )
 
+SOURCE_GROUP(src\\batch FILES ${PHYSX_VEHICLE_BATCH_SOURCE})
 SOURCE_GROUP(src\\braking FILES ${PHYSX_VEHICLE_BRAKING_SOURCE})
 SOURCE_GROUP(src\\commands FILES ${PHYSX_VEHICLE_COMMANDS_SOURCE})
 SOURCE_GROUP(src\\drivetrain FILES ${PHYSX_VEHICLE_DRIVETRAIN_SOURCE})
@@ -196,6 +205,7 @@ SOURCE_GROUP(src\\wheel FILES ${PHYSX_VEHICLE_WHEEL_SOURCE})
 SOURCE_GROUP(src\\pvd FILES ${PHYSX_VEHICLE_PVD_SOURCE})
 
 ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE_LIBTYPE}
+	${PHYSX_VEHICLE_BATCH_SOURCE}
 	${PHYSX_VEHICLE_BRAKING_SOURCE}
 	${PHYSX_VEHICLE_COMMANDS_SOURCE}
 	${PHYSX_VEHICLE_DRIVETRAIN_SOURCE}
@@ -209,6 +219,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE_LIBTYPE}
 	${PHYSX_VEHICLE_WHEEL_SOURCE}
 	${PHYSX_VEHICLE_PVD_SOURCE}
 	${PHYSX_VEHICLE_HEADERS}
+	${PHYSX_VEHICLE_BATCH_HEADERS}
 	${PHYSX_VEHICLE_BRAKING_HEADERS}
 	${PHYSX_VEHICLE_COMMAND_HEADERS}
 	${PHYSX_VEHICLE_DRIVETRAIN_HEADERS}
@@ -225,6 +236,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE_LIBTYPE}
 )
 
 INSTALL(FILES ${PHYSX_VEHICLE_HEADERS} DESTINATION include/vehicle2)
+INSTALL(FILES ${PHYSX_VEHICLE_BATCH_HEADERS} DESTINATION include/vehicle2/batch)
 INSTALL(FILES ${PHYSX_VEHICLE_BRAKING_HEADERS} DESTINATION include/vehicle2/braking)
 INSTALL(FILES ${PHYSX_VEHICLE_COMMAND_HEADERS} DESTINATION include/vehicle2/commands)
 INSTALL(FILES ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS} DESTINATION include/vehicle2/drivetrain)
@@ -281,6 +293,7 @@ TARGET_LINK_LIBRARIES(PhysXVehicle2
 
 IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_HEADERS})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BATCH_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BRAKING_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_COMMAND_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS})
@@ -294,6 +307,7 @@ IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_TIRE_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_WHEEL_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PVD_HEADERS})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BATCH_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BRAKING_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_COMMANDS_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_DRIVETRAIN_SOURCE})
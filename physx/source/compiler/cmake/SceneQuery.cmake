@@ -42,6 +42,7 @@ SET(SCENEQUERY_HEADERS
 	${SCENEQUERY_BASE_DIR}/include/SqPrunerData.h
 	${SCENEQUERY_BASE_DIR}/include/SqManager.h
 	${SCENEQUERY_BASE_DIR}/include/SqQuery.h
+	${SCENEQUERY_BASE_DIR}/include/SqQueryCandidateCache.h
 	${SCENEQUERY_BASE_DIR}/include/SqTypedef.h
 )
 SOURCE_GROUP(include FILES ${SCENEQUERY_HEADERS})
@@ -54,6 +55,7 @@ SET(SCENEQUERY_SOURCE
 	${SCENEQUERY_BASE_DIR}/src/SqCompoundPruningPool.h	
 	${SCENEQUERY_BASE_DIR}/src/SqManager.cpp
 	${SCENEQUERY_BASE_DIR}/src/SqQuery.cpp
+	${SCENEQUERY_BASE_DIR}/src/SqQueryCandidateCache.cpp
 )
 SOURCE_GROUP(src FILES ${SCENEQUERY_SOURCE})
 
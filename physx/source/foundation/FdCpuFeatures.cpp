@@ -0,0 +1,133 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "foundation/PxCpuFeatures.h"
+#include "foundation/PxPreprocessor.h"
+
+#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED) && !PX_EMSCRIPTEN
+	#define FD_CPUID_SUPPORTED
+	#if PX_VC
+		#include <intrin.h>
+		#include <immintrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+using namespace physx;
+
+#ifdef FD_CPUID_SUPPORTED
+static void cpuid(PxU32 leaf, PxU32 subLeaf, PxU32* regs)
+{
+#if PX_VC
+	int info[4];
+	__cpuidex(info, int(leaf), int(subLeaf));
+	for(PxU32 i=0; i<4; i++)
+		regs[i] = PxU32(info[i]);
+#else
+	__cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static PxU64 xgetbv(PxU32 index)
+{
+#if PX_VC
+	return PxU64(_xgetbv(index));
+#else
+	PxU32 eax, edx;
+	__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+	return (PxU64(edx) << 32) | eax;
+#endif
+}
+
+static PxU32 detectCpuFeatures()
+{
+	PxU32 regs[4];
+	cpuid(0, 0, regs);
+	const PxU32 maxLeaf = regs[0];
+	if(maxLeaf < 1)
+		return 0;
+
+	PxU32 features = 0;
+
+	cpuid(1, 0, regs);
+	const PxU32 ecx1 = regs[2];
+	if(ecx1 & (1<<20))
+		features |= PxCpuFeature::eSSE4_2;
+
+	// The AVX registers can only be used if the OS saves them on context switches (OSXSAVE and XCR0).
+	const bool osxsave = (ecx1 & (1<<27)) != 0;
+	if(!osxsave)
+		return features;
+
+	const PxU64 xcr0 = xgetbv(0);
+	const bool ymmState = (xcr0 & 0x6) == 0x6;		// SSE and AVX state
+	const bool zmmState = (xcr0 & 0xe6) == 0xe6;	// and opmask, ZMM_Hi256, Hi16_ZMM state
+	if(!ymmState)
+		return features;
+
+	if(ecx1 & (1<<28))
+		features |= PxCpuFeature::eAVX;
+
+	if(maxLeaf >= 7)
+	{
+		cpuid(7, 0, regs);
+		const PxU32 ebx7 = regs[1];
+		const bool fma = (ecx1 & (1<<12)) != 0;
+		if((features & PxCpuFeature::eAVX) && fma && (ebx7 & (1<<5)))
+			features |= PxCpuFeature::eAVX2;
+		if(zmmState && (ebx7 & (1<<16)))
+			features |= PxCpuFeature::eAVX512F;
+	}
+	return features;
+}
+#endif
+
+// Computed on first use. Concurrent first calls compute the same value, so the race is benign.
+static volatile PxI32 gCpuFeatures = -1;
+static volatile PxU32 gCpuFeatureMask = 0xffffffff;
+
+PxU32 physx::PxGetCpuFeatures()
+{
+	PxI32 features = gCpuFeatures;
+	if(features < 0)
+	{
+#ifdef FD_CPUID_SUPPORTED
+		features = PxI32(detectCpuFeatures());
+#else
+		features = 0;
+#endif
+		gCpuFeatures = features;
+	}
+	return PxU32(features) & gCpuFeatureMask;
+}
+
+void physx::PxSetCpuFeatureMask(PxU32 mask)
+{
+	gCpuFeatureMask = mask;
+}
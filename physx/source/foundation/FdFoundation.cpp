@@ -31,6 +31,7 @@
 #include "foundation/PxPhysicsVersion.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxBroadcast.h"
+#include "foundation/PxThread.h"
 
 namespace physx
 {
@@ -76,7 +77,9 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public PxUserAllocated
 	Mutex mErrorMutex;
 
 	AllocFreeTable mTempAllocFreeTable;
+	AllocThreadCacheTable mTempAllocThreadCaches;
 	Mutex mTempAllocMutex;
+	PxU32 mTempAllocTlsIndex;
 
 	Mutex mListenerMutex;
 
@@ -108,6 +111,20 @@ Mutex& getTempAllocMutex()
 	return gInstance->mTempAllocMutex;
 }
 
+// Not in header so that people don't use it, only for temp allocator
+AllocThreadCacheTable& getTempAllocThreadCaches()
+{
+	PX_ASSERT(gInstance);
+	return gInstance->mTempAllocThreadCaches;
+}
+
+// Not in header so that people don't use it, only for temp allocator
+PxU32 getTempAllocTlsIndex()
+{
+	PX_ASSERT(gInstance);
+	return gInstance->mTempAllocTlsIndex;
+}
+
 Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc) :
 	mAllocatorCallback		(alloc),
 	mErrorCallback			(errc),
@@ -121,15 +138,17 @@ Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc) :
     mErrorMask				(PxErrorCode::Enum(~0)),
 	mErrorMutex				("Foundation::mErrorMutex"),
 	mTempAllocMutex			("Foundation::mTempAllocMutex"),
+	mTempAllocTlsIndex		(PxTlsAlloc()),
 	mRefCount				(0)
 {
 }
 
-void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable);
+void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable, AllocThreadCacheTable& mTempAllocThreadCaches);
 
 Foundation::~Foundation()
 {
-	deallocateTempBufferAllocations(mTempAllocFreeTable);
+	deallocateTempBufferAllocations(mTempAllocFreeTable, mTempAllocThreadCaches);
+	PxTlsFree(mTempAllocTlsIndex);
 }
 
 bool Foundation::error(PxErrorCode::Enum c, const char* file, int line, const char* messageFmt, ...)
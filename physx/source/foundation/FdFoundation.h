@@ -36,9 +36,11 @@
 namespace physx
 {
 	union PxTempAllocatorChunk;
+	struct PxTempAllocatorThreadCache;
 
 	typedef PxMutexT<PxAllocator> Mutex;
 	typedef PxArray<PxTempAllocatorChunk*, PxAllocator> AllocFreeTable;
+	typedef PxArray<PxTempAllocatorThreadCache*, PxAllocator> AllocThreadCacheTable;
 
 } // namespace physx
 
@@ -28,11 +28,13 @@
 
 #include "foundation/PxMath.h"
 #include "foundation/PxIntrinsics.h"
+#include "foundation/PxMemory.h"
 #include "foundation/PxBitUtils.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxMutex.h"
 #include "foundation/PxAtomic.h"
 #include "foundation/PxTempAllocator.h"
+#include "foundation/PxThread.h"
 
 #include "FdFoundation.h"
 
@@ -41,7 +43,9 @@
 #endif
 
 physx::AllocFreeTable& getTempAllocFreeTable();
+physx::AllocThreadCacheTable& getTempAllocThreadCaches();
 physx::Mutex& getTempAllocMutex();
+physx::PxU32 getTempAllocTlsIndex();
 
 namespace physx
 {
@@ -59,6 +63,64 @@ const PxU32 sMinIndex = 8;  // 256B min
 const PxU32 sMaxIndex = 17; // 128kB max
 }
 
+namespace
+{
+const PxU32 sNbCachedClasses = sMaxIndex - sMinIndex;
+const PxU32 sThreadCacheBudget = 256 * 1024;	// Per size class, in bytes
+const PxU32 sMinThreadCacheCapacity = 2;
+const PxU32 sMaxThreadCacheCapacity = 16;
+
+// Number of chunks a thread cache holds at most for a given size class. Small chunks are cached
+// in larger numbers, big ones are limited so that idle threads don't sit on too much memory.
+PX_FORCE_INLINE PxU32 getThreadCacheCapacity(PxU32 index)
+{
+	const PxU32 chunkSize = 2u << index;
+	return PxClamp(sThreadCacheBudget / chunkSize, sMinThreadCacheCapacity, sMaxThreadCacheCapacity);
+}
+}
+
+// Per-thread magazines in front of the shared free table. A cache is only ever touched by its
+// owner thread so the fast path needs neither locks nor atomics. Caches refill from and drain to
+// the shared free table in batches, which amortizes the mutex over several allocations.
+struct PxTempAllocatorThreadCache
+{
+	Chunk*		mFreeLists[sNbCachedClasses];
+	PxU32		mCounts[sNbCachedClasses];
+	PxU64		mNbHits;
+	PxU64		mNbMisses;
+	PxU64		mBytesHeld;
+	bool		mInUse;
+};
+
+namespace
+{
+// Threads without a cache, i.e. that did not call PxTempAllocatorAcquireThreadCache(), use the shared free table directly
+PX_FORCE_INLINE PxTempAllocatorThreadCache* getThreadCache()
+{
+	return reinterpret_cast<PxTempAllocatorThreadCache*>(PxTlsGet(getTempAllocTlsIndex()));
+}
+
+// Must be called with the temp alloc mutex held
+void drainThreadCache(PxTempAllocatorThreadCache& cache, PxU32 classIndex, PxU32 nbToKeep)
+{
+	AllocFreeTable& freeTable = getTempAllocFreeTable();
+	if(freeTable.size() <= classIndex)
+		freeTable.resize(classIndex + 1);
+
+	const PxU32 chunkSize = 2u << (classIndex + sMinIndex);
+	while(cache.mCounts[classIndex] > nbToKeep)
+	{
+		Chunk* chunk = cache.mFreeLists[classIndex];
+		cache.mFreeLists[classIndex] = chunk->mNext;
+		cache.mCounts[classIndex]--;
+		cache.mBytesHeld -= chunkSize;
+
+		chunk->mNext = freeTable[classIndex];
+		freeTable[classIndex] = chunk;
+	}
+}
+}
+
 void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
 {
 	if(!size)
@@ -69,6 +131,31 @@ void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
 	Chunk* chunk = 0;
 	if(index < sMaxIndex)
 	{
+		PxTempAllocatorThreadCache* cache = getThreadCache();
+		if(cache)
+		{
+			// find chunk up to 4x bigger than necessary, lock-free
+			const PxU32 first = index - sMinIndex;
+			const PxU32 last = PxMin(first + 3, sNbCachedClasses);
+			for(PxU32 i=first; i<last; i++)
+			{
+				if(cache->mFreeLists[i])
+				{
+					chunk = cache->mFreeLists[i];
+					cache->mFreeLists[i] = chunk->mNext;
+					cache->mCounts[i]--;
+					cache->mBytesHeld -= 2u << (i + sMinIndex);
+					cache->mNbHits++;
+
+					chunk->mIndex = i + sMinIndex;
+					void* ret = chunk + 1;
+					PX_ASSERT((size_t(ret) & 0xf) == 0); // SDK types require at minimum 16 byte alignment.
+					return ret;
+				}
+			}
+			cache->mNbMisses++;
+		}
+
 		Mutex::ScopedLock lock(getTempAllocMutex());
 
 		// find chunk up to 16x bigger than necessary
@@ -84,6 +171,23 @@ void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
 			chunk = *it;
 			*it = chunk->mNext;
 			index = PxU32(it - freeTable.begin() + sMinIndex);
+
+			// refill the thread cache with up to half its capacity, so that the next allocations don't need the lock
+			if(cache)
+			{
+				const PxU32 classIndex = index - sMinIndex;
+				const PxU32 nbToRefill = getThreadCacheCapacity(index) / 2;
+				const PxU32 chunkSize = 2u << index;
+				for(PxU32 i=0; i<nbToRefill && *it; i++)
+				{
+					Chunk* extra = *it;
+					*it = extra->mNext;
+					extra->mNext = cache->mFreeLists[classIndex];
+					cache->mFreeLists[classIndex] = extra;
+					cache->mCounts[classIndex]++;
+					cache->mBytesHeld += chunkSize;
+				}
+			}
 		}
 		else
 			// create new chunk
@@ -112,10 +216,30 @@ void PxTempAllocator::deallocate(void* ptr)
 	if(index >= sMaxIndex)
 		return PxAllocator().deallocate(chunk);
 
-	Mutex::ScopedLock lock(getTempAllocMutex());
+	const PxU32 capacity = getThreadCacheCapacity(index);
 
 	index -= sMinIndex;
 
+	PxTempAllocatorThreadCache* cache = getThreadCache();
+	if(cache)
+	{
+		// push to the local magazine, lock-free
+		chunk->mNext = cache->mFreeLists[index];
+		cache->mFreeLists[index] = chunk;
+		cache->mCounts[index]++;
+		cache->mBytesHeld += 2u << (index + sMinIndex);
+
+		// magazine full: give half of it back to the shared free table in one go
+		if(cache->mCounts[index] > capacity)
+		{
+			Mutex::ScopedLock lock(getTempAllocMutex());
+			drainThreadCache(*cache, index, capacity / 2);
+		}
+		return;
+	}
+
+	Mutex::ScopedLock lock(getTempAllocMutex());
+
 	AllocFreeTable& freeTable = getTempAllocFreeTable();
 
 	if(freeTable.size() <= index)
@@ -125,13 +249,102 @@ void PxTempAllocator::deallocate(void* ptr)
 	freeTable[index] = chunk;
 }
 
+void PxTempAllocatorAcquireThreadCache()
+{
+	const PxU32 tlsIndex = getTempAllocTlsIndex();
+	if(PxTlsGet(tlsIndex))
+		return;
+
+	PxTempAllocatorThreadCache* cache = NULL;
+	{
+		Mutex::ScopedLock lock(getTempAllocMutex());
+
+		// recycle a cache released by a thread that went away, else create a new one
+		AllocThreadCacheTable& caches = getTempAllocThreadCaches();
+		for(PxU32 i=0; i<caches.size(); i++)
+		{
+			if(!caches[i]->mInUse)
+			{
+				cache = caches[i];
+				break;
+			}
+		}
+
+		if(!cache)
+		{
+			cache = reinterpret_cast<PxTempAllocatorThreadCache*>(PxAllocator().allocate(sizeof(PxTempAllocatorThreadCache), PX_FL));
+			if(!cache)
+				return;
+			PxMemZero(cache, sizeof(PxTempAllocatorThreadCache));
+			caches.pushBack(cache);
+		}
+		cache->mInUse = true;
+	}
+
+	PxTlsSet(tlsIndex, cache);
+}
+
+void PxTempAllocatorReleaseThreadCache()
+{
+	const PxU32 tlsIndex = getTempAllocTlsIndex();
+	PxTempAllocatorThreadCache* cache = reinterpret_cast<PxTempAllocatorThreadCache*>(PxTlsGet(tlsIndex));
+	if(!cache)
+		return;
+
+	PxTlsSet(tlsIndex, NULL);
+
+	Mutex::ScopedLock lock(getTempAllocMutex());
+	for(PxU32 i=0; i<sNbCachedClasses; i++)
+		drainThreadCache(*cache, i, 0);
+
+	// Stats are kept so that they stay visible after the thread is gone
+	cache->mInUse = false;
+}
+
+PxU32 PxTempAllocatorGetThreadStats(PxTempAllocatorThreadStats* stats, PxU32 maxNbStats)
+{
+	Mutex::ScopedLock lock(getTempAllocMutex());
+
+	// Counters are written by their owner threads without synchronization, values are approximate
+	const AllocThreadCacheTable& caches = getTempAllocThreadCaches();
+	const PxU32 nbCaches = caches.size();
+	if(stats)
+	{
+		const PxU32 nb = PxMin(nbCaches, maxNbStats);
+		for(PxU32 i=0; i<nb; i++)
+		{
+			stats[i].nbHits		= caches[i]->mNbHits;
+			stats[i].nbMisses	= caches[i]->mNbMisses;
+			stats[i].bytesHeld	= caches[i]->mBytesHeld;
+			stats[i].active		= caches[i]->mInUse;
+		}
+	}
+	return nbCaches;
+}
+
 } // namespace physx
 
 using namespace physx;
 
-void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable)
+void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable, AllocThreadCacheTable& mTempAllocThreadCaches)
 {
 	PxAllocator alloc;
+	for(PxU32 i = 0; i < mTempAllocThreadCaches.size(); ++i)
+	{
+		PxTempAllocatorThreadCache* cache = mTempAllocThreadCaches[i];
+		for(PxU32 j = 0; j < sNbCachedClasses; ++j)
+		{
+			for(PxTempAllocatorChunk* ptr = cache->mFreeLists[j]; ptr;)
+			{
+				PxTempAllocatorChunk* next = ptr->mNext;
+				alloc.deallocate(ptr);
+				ptr = next;
+			}
+		}
+		alloc.deallocate(cache);
+	}
+	mTempAllocThreadCaches.reset();
+
 	for(PxU32 i = 0; i < mTempAllocFreeTable.size(); ++i)
 	{
 		for(PxTempAllocatorChunk* ptr = mTempAllocFreeTable[i]; ptr;)
@@ -99,7 +99,9 @@ namespace physx
 
 		// Convex meshes
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions=NULL, PxCookingCache* cache=NULL);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool createConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions=NULL);
 
 		PX_FORCE_INLINE	PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 		{
@@ -114,6 +116,7 @@ namespace physx
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool validateTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	PxTriangleMesh* createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxInsertionCallback& insertionCallback, PxTriangleMeshCookingResult::Enum* condition=NULL);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions=NULL, PxCookingCache* cache=NULL);
 		
 		PX_FORCE_INLINE	PxTriangleMesh*	createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc)
 		{
@@ -38,6 +38,7 @@ namespace physx
 {
 	class PxRenderOutput;
 	class PxBounds3;
+	class PxCpuDispatcher;
 
 namespace Gu
 {
@@ -193,6 +194,9 @@ namespace Gu
 		// PT: from the SQ branch, maybe temporary, unclear if a getType() function would be better etc
 		virtual	bool					isDynamic()	const	{ return false;	}
 
+		// Optional dispatcher used to build the pruner's tree over several threads. NULL means single-threaded builds.
+		virtual	void					setBuildDispatcher(PxCpuDispatcher*)	{}
+
 		virtual	void					getGlobalBounds(PxBounds3&)	const	= 0;
 	};
 
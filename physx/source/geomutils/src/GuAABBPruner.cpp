@@ -49,6 +49,11 @@ using namespace Cm;
 	#define SQ_PRUNER_EPSILON	0.005f
 	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
 
+float AABBPruner::getCapsuleInflation()
+{
+	return SQ_PRUNER_INFLATION;
+}
+
 AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
 	mAABBTree			(NULL),
 	mNewTree			(NULL),
@@ -61,6 +66,7 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPruner
 	mAdaptiveRebuildTerm(0),
 	mNbObjectsPerNode	(nbObjectsPerNode),
 	mBuildStrategy		(buildStrategy),
+	mBuildDispatcher	(NULL),
 	mPool				(contextID, TRANSFORM_CACHE_GLOBAL),
 	mIncrementalRebuild	(incrementalRebuild),
 	mUncommittedChanges	(false),
@@ -340,7 +346,7 @@ void AABBPruner::commit()
 	if(!mAABBTree || !mIncrementalRebuild)
 	{
 		if(!mIncrementalRebuild && mAABBTree)
-			PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneQueryDesc::staticStructure is set to eSTATIC_AABB_TREE.");
+			PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneQueryDesc::staticStructure is set to eSTATIC_AABB_TREE or eSTATIC_WIDE_AABB_TREE.");
 
 		fullRebuildAABBTree();
 		return;
@@ -474,6 +480,9 @@ void AABBPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 second
 		mBucketPruner.visualize(out, secondaryColor);
 }
 
+// A parallel one-shot build is used when at least 1/Nth of the new tree's objects are waiting in the bucket pruner
+static const PxU32 PARALLEL_BUILD_ADDED_RATIO = 8;
+
 bool AABBPruner::buildStep(bool synchronousCall)
 {
 	PX_PROFILE_ZONE("SceneQuery.prunerBuildStep", mPool.mContextID);
@@ -486,6 +495,18 @@ bool AABBPruner::buildStep(bool synchronousCall)
 			if(!synchronousCall || !prepareBuild())
 				return false;
 		}
+		else if(mProgress==BUILD_INIT && mBuildDispatcher && mBucketPruner.getNbObjects()*PARALLEL_BUILD_ADDED_RATIO >= mBuilder.mNbPrimitives)
+		{
+			// When a large batch of objects was added (e.g. streaming) the whole tree is built at once, using the worker
+			// threads, and we go straight to the remapping. Rebuilds triggered by moved or removed objects, or by a few
+			// added ones, keep the progressive path below so that the current tree is refit over the rebuild frames.
+			mNewTree->build(mBuilder, mNodeAllocator, mBuildDispatcher);
+			mProgress = BUILD_NEW_MAPPING;
+			mNbCalls = 0;
+#if PX_DEBUG
+			mNewTree->validate();
+#endif
+		}
 		else if(mProgress==BUILD_INIT)
 		{
 			mNewTree->progressiveBuild(mBuilder, mNodeAllocator, mBuildStats, 0, 0);
@@ -662,7 +683,7 @@ bool AABBPruner::fullRebuildAABBTree()
 		// Create a new tree
 		mAABBTree = PX_NEW(AABBTree);
 
-		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy), mNodeAllocator);
+		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy), mNodeAllocator, mBuildDispatcher);
 	}
 
 	// No need for the tree map for static pruner
@@ -136,6 +136,7 @@ namespace Gu
 		// Pruner
 												DECLARE_PRUNER_API_COMMON
 		virtual			bool					isDynamic()			const		{ return mIncrementalRebuild;	}
+		virtual			void					setBuildDispatcher(PxCpuDispatcher* dispatcher)	{ mBuildDispatcher = dispatcher;	}
 		//~Pruner
 
 		// DynamicPruner
@@ -152,6 +153,9 @@ namespace Gu
 		PX_FORCE_INLINE	void					setAABBTree(AABBTree* tree)		{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const AABBTree*			hasAABBTree()		const		{ return mAABBTree;	}
 		PX_FORCE_INLINE	BuildStatus				getBuildStatus()	const		{ return mProgress;	}
+
+		// pruner test shape inflation of capsule overlap queries, shared with derived pruners
+		static			float					getCapsuleInflation();
 				
 		// local functions
 //		private:
@@ -201,6 +205,10 @@ namespace Gu
 			const		PxU32					mNbObjectsPerNode;
 			const		BVHBuildStrategy		mBuildStrategy;
 
+		// Optional dispatcher for parallel tree builds. When set and many objects were added, the new tree is built in a
+		// single (multithreaded) BUILD_INIT step instead of being spread over BUILD_IN_PROGRESS frames.
+						PxCpuDispatcher*		mBuildDispatcher;
+
 						PruningPool				mPool; // Pool of AABBs
 
 		// maps pruning pool indices to aabb tree indices
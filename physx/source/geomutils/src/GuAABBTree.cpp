@@ -35,6 +35,8 @@
 #include "foundation/PxMathUtils.h"
 #include "foundation/PxFPU.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxSort.h"
+#include "task/PxParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -403,7 +405,7 @@ static void buildHierarchy(AABBTreeBuildNode* root, const AABBTreeBuildParams& p
 
 	if(useSAH)
 	{
-		SAH_Buffers sah(params.mNbPrimitives);
+		SAH_Buffers sah(root->mNbPrimitives);
 
 		do
 		{
@@ -1127,6 +1129,722 @@ PxU32 AABBTree::progressiveBuild(const AABBTreeBuildParams& params, NodeAllocato
 }
 //~Progressive building
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Parallel building
+//
+// The tree is built in two phases. The top of the tree is built breadth-first by the calling thread, splitting each node
+// with data-parallel passes over fixed-size chunks of its primitives (binned SAH for BVH_SAH, the regular splatter-points
+// heuristic otherwise). Once a node contains few enough primitives it becomes a subtree root, and all subtrees are then
+// built concurrently with the regular single-threaded code, each with its own node allocator. The chunk size and the
+// subtree threshold only depend on the number of primitives, so the resulting tree does not depend on the number of
+// worker threads.
+#define PARALLEL_BUILD_CHUNK_SIZE		4096	// Primitives per chunk in the data-parallel passes
+#define PARALLEL_BUILD_BIG_NODE			(PARALLEL_BUILD_CHUNK_SIZE*4)	// Nodes above this are split with one task per chunk
+#define PARALLEL_BUILD_MIN_SUBTREE		2048	// Minimum subtree threshold, in number of primitives
+#define PARALLEL_BUILD_MAX_NB_SUBTREES	128		// Target number of subtrees for large trees
+#define PARALLEL_BUILD_NB_BINS			32
+
+namespace
+{
+	struct SplitChunk
+	{
+		PxVec4	mMin;		// Box bounds
+		PxVec4	mMax;
+		PxVec4	mSum;		// Sum of box centers
+		PxVec4	mCMin;		// Center bounds
+		PxVec4	mCMax;
+		PxVec4	mVar;		// Sum of squared deviations from the mean
+		PxU32	mNbPos;
+	};
+
+	struct SplitBin
+	{
+		PxBounds3	mBounds;
+		PxU32		mCount;
+	};
+
+	enum SplitPass
+	{
+		SPLIT_PASS_BOUNDS,
+		SPLIT_PASS_SPLIT,
+		SPLIT_PASS_COUNT,
+		SPLIT_PASS_SCATTER,
+		SPLIT_PASS_COPY,
+
+		SPLIT_PASS_NB
+	};
+
+	// Splits one node of the top of the tree. Each pass processes the node's primitives in fixed-size chunks, and is
+	// followed by a serial reduction of the per-chunk results (in chunk order, to keep the results deterministic). Primitives
+	// are partitioned stably through a temporary buffer rather than in-place as in reshuffle().
+	class TopNodeSplitter
+	{
+		public:
+		TopNodeSplitter() : mNode(NULL), mNbChunks(0), mAxis(0), mSplitValue(0.0f), mBinOffset(0.0f), mBinScale(0.0f), mSplitBin(0), mNbPos(0), mUseBins(false), mPartition(true)	{}
+
+		void	init(AABBTreeBuildNode* node, const AABBTreeBuildParams& params, PxU32* indices, PxU32* tmp)
+		{
+			mNode		= node;
+			mParams		= &params;
+			mPrims		= indices + node->mNodeIndex;
+			mTmp		= tmp + node->mNodeIndex;
+			mNbChunks	= (node->mNbPrimitives + PARALLEL_BUILD_CHUNK_SIZE - 1) / PARALLEL_BUILD_CHUNK_SIZE;
+			mChunks.resize(mNbChunks);
+			if(params.mBuildStrategy==BVH_SAH)
+				mBins.resize(mNbChunks*3*PARALLEL_BUILD_NB_BINS);
+		}
+
+		bool	needsPass(PxU32 pass)	const
+		{
+			return pass<SPLIT_PASS_SCATTER || mPartition;
+		}
+
+		void	processChunk(PxU32 pass, PxU32 chunkIndex)
+		{
+			const PxU32 start = chunkIndex*PARALLEL_BUILD_CHUNK_SIZE;
+			const PxU32 nb = PxMin(mNode->mNbPrimitives - start, PxU32(PARALLEL_BUILD_CHUNK_SIZE));
+			SplitChunk& chunk = mChunks[chunkIndex];
+
+			if(pass==SPLIT_PASS_BOUNDS)
+				computeBounds(chunk, start, nb);
+			else if(pass==SPLIT_PASS_SPLIT)
+				computeSplitData(chunk, chunkIndex, start, nb);
+			else if(pass==SPLIT_PASS_COUNT)
+			{
+				PxU32 nbPos = 0;
+				for(PxU32 i=0;i<nb;i++)
+				{
+					if(isPositive(mPrims[start+i]))
+						nbPos++;
+				}
+				chunk.mNbPos = nbPos;
+			}
+			else if(pass==SPLIT_PASS_SCATTER)
+			{
+				// mNbPos has been turned into output offsets in finishPass(SPLIT_PASS_COUNT)
+				PxU32 posOffset = chunk.mNbPos;
+				PxU32 negOffset = mNbPos + start - chunk.mNbPos;
+				for(PxU32 i=0;i<nb;i++)
+				{
+					const PxU32 index = mPrims[start+i];
+					if(isPositive(index))
+						mTmp[posOffset++] = index;
+					else
+						mTmp[negOffset++] = index;
+				}
+			}
+			else
+			{
+				PX_ASSERT(pass==SPLIT_PASS_COPY);
+				PxMemCopy(mPrims + start, mTmp + start, sizeof(PxU32)*nb);
+			}
+		}
+
+		void	finishPass(PxU32 pass)
+		{
+			if(pass==SPLIT_PASS_BOUNDS)
+			{
+				Vec4V minV = V4LoadU(&mChunks[0].mMin.x);
+				Vec4V maxV = V4LoadU(&mChunks[0].mMax.x);
+				Vec4V sumV = V4LoadU(&mChunks[0].mSum.x);
+				Vec4V cminV = V4LoadU(&mChunks[0].mCMin.x);
+				Vec4V cmaxV = V4LoadU(&mChunks[0].mCMax.x);
+				for(PxU32 i=1;i<mNbChunks;i++)
+				{
+					minV = V4Min(minV, V4LoadU(&mChunks[i].mMin.x));
+					maxV = V4Max(maxV, V4LoadU(&mChunks[i].mMax.x));
+					sumV = V4Add(sumV, V4LoadU(&mChunks[i].mSum.x));
+					cminV = V4Min(cminV, V4LoadU(&mChunks[i].mCMin.x));
+					cmaxV = V4Max(cmaxV, V4LoadU(&mChunks[i].mCMax.x));
+				}
+				StoreBounds(mNode->mBV, minV, maxV);
+				V4StoreU(V4Scale(sumV, FLoad(1.0f / float(mNode->mNbPrimitives))), &mMeans.x);
+				V4StoreU(cminV, &mCMin.x);
+				V4StoreU(cmaxV, &mCMax.x);
+			}
+			else if(pass==SPLIT_PASS_SPLIT)
+			{
+				if(mParams->mBuildStrategy==BVH_SAH && findBinnedSAHSplit())
+					return;
+
+				// Same heuristic as in AABBTreeBuildNode::subdivide()
+				Vec4V varsV = V4LoadU(&mChunks[0].mVar.x);
+				for(PxU32 i=1;i<mNbChunks;i++)
+					varsV = V4Add(varsV, V4LoadU(&mChunks[i].mVar.x));
+				PxVec4 vars;
+				V4StoreU(V4Scale(varsV, FLoad(1.0f / float(mNode->mNbPrimitives - 1))), &vars.x);
+
+				mAxis = PxLargestAxis(PxVec3(vars.x, vars.y, vars.z));
+				if(mParams->mBuildStrategy==BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+					mSplitValue = mMeans[mAxis];
+				else
+					mSplitValue = mNode->mBV.getCenter(mAxis);
+				mUseBins = false;
+			}
+			else if(pass==SPLIT_PASS_COUNT)
+			{
+				PxU32 nbPos = 0;
+				for(PxU32 i=0;i<mNbChunks;i++)
+				{
+					const PxU32 nb = mChunks[i].mNbPos;
+					mChunks[i].mNbPos = nbPos;
+					nbPos += nb;
+				}
+
+				if(!nbPos || nbPos==mNode->mNbPrimitives)
+				{
+					// All primitives lie in the same sub-space, make an arbitrary 50-50 split (the node is over the limit)
+					mNbPos = mNode->mNbPrimitives>>1;
+					mPartition = false;
+				}
+				else
+					mNbPos = nbPos;
+			}
+		}
+
+		// Runs all passes on the calling thread
+		void	split()
+		{
+			for(PxU32 pass=0;pass<SPLIT_PASS_NB;pass++)
+			{
+				if(!needsPass(pass))
+					break;
+				for(PxU32 i=0;i<mNbChunks;i++)
+					processChunk(pass, i);
+				finishPass(pass);
+			}
+		}
+
+		AABBTreeBuildNode*				mNode;
+		PxU32							mNbChunks;
+		PxU32							mAxis;
+		float							mSplitValue;
+		float							mBinOffset;
+		float							mBinScale;
+		PxU32							mSplitBin;
+		PxU32							mNbPos;
+		bool							mUseBins;
+		bool							mPartition;
+
+		private:
+		const AABBTreeBuildParams*		mParams;
+		PxU32*							mPrims;
+		PxU32*							mTmp;
+		PxVec4							mMeans;
+		PxVec4							mCMin;
+		PxVec4							mCMax;
+		PxArray<SplitChunk>				mChunks;
+		PxArray<SplitBin>				mBins;
+
+		PX_FORCE_INLINE	PxU32	getBin(float value, float offset, float scale)	const
+		{
+			const float bin = (value - offset) * scale;
+			return bin<=0.0f ? 0 : PxMin(PxU32(bin), PxU32(PARALLEL_BUILD_NB_BINS-1));
+		}
+
+		PX_FORCE_INLINE	bool	isPositive(PxU32 index)	const
+		{
+			const float value = mParams->mCache[index][mAxis];
+			if(mUseBins)
+				return getBin(value, mBinOffset, mBinScale) <= mSplitBin;
+			return value > mSplitValue;
+		}
+
+		void	computeBounds(SplitChunk& chunk, PxU32 start, PxU32 nb)
+		{
+			const PxBounds3* PX_RESTRICT boxes = mParams->mBounds->getBounds();
+			const PxVec3* PX_RESTRICT centers = mParams->mCache;
+			const PxU32* PX_RESTRICT prims = mPrims + start;
+
+			Vec4V minV = V4LoadU(&boxes[prims[0]].minimum.x);
+			Vec4V maxV = V4LoadU(&boxes[prims[0]].maximum.x);
+			Vec4V sumV = V4LoadU(&centers[prims[0]].x);
+			Vec4V cminV = sumV;
+			Vec4V cmaxV = sumV;
+			for(PxU32 i=1;i<nb;i++)
+			{
+				const PxU32 index = prims[i];
+				const Vec4V centerV = V4LoadU(&centers[index].x);
+				minV = V4Min(minV, V4LoadU(&boxes[index].minimum.x));
+				maxV = V4Max(maxV, V4LoadU(&boxes[index].maximum.x));
+				sumV = V4Add(sumV, centerV);
+				cminV = V4Min(cminV, centerV);
+				cmaxV = V4Max(cmaxV, centerV);
+			}
+			V4StoreU(minV, &chunk.mMin.x);
+			V4StoreU(maxV, &chunk.mMax.x);
+			V4StoreU(sumV, &chunk.mSum.x);
+			V4StoreU(cminV, &chunk.mCMin.x);
+			V4StoreU(cmaxV, &chunk.mCMax.x);
+		}
+
+		void	computeSplitData(SplitChunk& chunk, PxU32 chunkIndex, PxU32 start, PxU32 nb)
+		{
+			const PxVec3* PX_RESTRICT centers = mParams->mCache;
+			const PxU32* PX_RESTRICT prims = mPrims + start;
+
+			const Vec4V meansV = V4LoadU(&mMeans.x);
+			Vec4V varsV = V4Zero();
+			for(PxU32 i=0;i<nb;i++)
+			{
+				const Vec4V deltaV = V4Sub(V4LoadU(&centers[prims[i]].x), meansV);
+				varsV = V4Add(varsV, V4Mul(deltaV, deltaV));
+			}
+			V4StoreU(varsV, &chunk.mVar.x);
+
+			if(mParams->mBuildStrategy!=BVH_SAH)
+				return;
+
+			const PxBounds3* PX_RESTRICT boxes = mParams->mBounds->getBounds();
+			SplitBin* bins = mBins.begin() + chunkIndex*3*PARALLEL_BUILD_NB_BINS;
+			for(PxU32 i=0;i<3*PARALLEL_BUILD_NB_BINS;i++)
+			{
+				bins[i].mBounds = PxBounds3::empty();
+				bins[i].mCount = 0;
+			}
+
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				const float extent = mCMax[axis] - mCMin[axis];
+				if(extent<=0.0f)
+					continue;
+				const float scale = float(PARALLEL_BUILD_NB_BINS) / extent;
+
+				SplitBin* axisBins = bins + axis*PARALLEL_BUILD_NB_BINS;
+				for(PxU32 i=0;i<nb;i++)
+				{
+					const PxU32 index = prims[i];
+					SplitBin& bin = axisBins[getBin(centers[index][axis], mCMin[axis], scale)];
+					bin.mBounds.include(boxes[index]);
+					bin.mCount++;
+				}
+			}
+		}
+
+		static PX_FORCE_INLINE float getSurfaceArea(const PxBounds3& bounds)
+		{
+			const PxVec3 e = bounds.maximum - bounds.minimum;
+			return 2.0f * (e.x * e.y + e.x * e.z + e.y * e.z);
+		}
+
+		bool	findBinnedSAHSplit()
+		{
+			float bestCost = PX_MAX_F32;
+			bool found = false;
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				const float extent = mCMax[axis] - mCMin[axis];
+				if(extent<=0.0f)
+					continue;
+
+				SplitBin bins[PARALLEL_BUILD_NB_BINS];
+				for(PxU32 j=0;j<PARALLEL_BUILD_NB_BINS;j++)
+				{
+					bins[j] = mBins[axis*PARALLEL_BUILD_NB_BINS + j];
+					for(PxU32 i=1;i<mNbChunks;i++)
+					{
+						const SplitBin& bin = mBins[(i*3 + axis)*PARALLEL_BUILD_NB_BINS + j];
+						if(bin.mCount)
+						{
+							bins[j].mBounds.include(bin.mBounds);
+							bins[j].mCount += bin.mCount;
+						}
+					}
+				}
+
+				float rightCost[PARALLEL_BUILD_NB_BINS];
+				PxBounds3 bounds = PxBounds3::empty();
+				PxU32 count = 0;
+				for(PxU32 j=PARALLEL_BUILD_NB_BINS-1;j>0;j--)
+				{
+					if(bins[j].mCount)
+						bounds.include(bins[j].mBounds);
+					count += bins[j].mCount;
+					rightCost[j] = count ? getSurfaceArea(bounds) * float(count) : -1.0f;
+				}
+
+				bounds = PxBounds3::empty();
+				count = 0;
+				for(PxU32 j=0;j<PARALLEL_BUILD_NB_BINS-1;j++)
+				{
+					if(bins[j].mCount)
+						bounds.include(bins[j].mBounds);
+					count += bins[j].mCount;
+					if(!count || rightCost[j+1]<0.0f)
+						continue;
+
+					const float cost = getSurfaceArea(bounds) * float(count) + rightCost[j+1];
+					if(cost < bestCost)
+					{
+						bestCost = cost;
+						mAxis = axis;
+						mSplitBin = j;
+						found = true;
+					}
+				}
+			}
+
+			if(!found)
+				return false;
+
+			mBinOffset = mCMin[mAxis];
+			mBinScale = float(PARALLEL_BUILD_NB_BINS) / (mCMax[mAxis] - mCMin[mAxis]);
+			mUseBins = true;
+			return true;
+		}
+	};
+
+	class ParallelBuildInit : public PxParallelForWork
+	{
+		public:
+		ParallelBuildInit(const AABBTreeBuildParams& params, PxU32* indices) : mParams(params), mIndices(indices)	{}
+
+		virtual	void	process(PxU32 chunkIndex)	PX_OVERRIDE
+		{
+			const PxU32 start = chunkIndex*PARALLEL_BUILD_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + PARALLEL_BUILD_CHUNK_SIZE, mParams.mNbPrimitives);
+
+			const PxBounds3* PX_RESTRICT boxes = mParams.mBounds->getBounds();
+			const FloatV halfV = FLoad(0.5f);
+			// V4StoreU writes one float past the center, i.e. into the next chunk's first center. So the last
+			// center of each chunk is written with a regular store to avoid racing with the next chunk.
+			const PxU32 last = end - 1;
+			for(PxU32 i=start;i<last;i++)
+			{
+				mIndices[i] = i;
+				const Vec4V curMinV = V4LoadU(&boxes[i].minimum.x);
+				const Vec4V curMaxV = V4LoadU(&boxes[i].maximum.x);
+				V4StoreU(V4Scale(V4Add(curMaxV, curMinV), halfV), &mParams.mCache[i].x);
+			}
+			mIndices[last] = last;
+			mParams.mCache[last] = boxes[last].getCenter();
+		}
+
+		const AABBTreeBuildParams&	mParams;
+		PxU32*						mIndices;
+		PX_NOCOPY(ParallelBuildInit)
+	};
+
+	// Runs one pass of a single big node, one chunk per index
+	class ParallelSplitPass : public PxParallelForWork
+	{
+		public:
+		ParallelSplitPass(TopNodeSplitter& splitter, PxU32 pass) : mSplitter(splitter), mPass(pass)	{}
+
+		virtual	void	process(PxU32 chunkIndex)	PX_OVERRIDE
+		{
+			mSplitter.processChunk(mPass, chunkIndex);
+		}
+
+		TopNodeSplitter&	mSplitter;
+		const PxU32			mPass;
+		PX_NOCOPY(ParallelSplitPass)
+	};
+
+	// Splits several smaller nodes, one node per index
+	class ParallelSplitNodes : public PxParallelForWork
+	{
+		public:
+		ParallelSplitNodes(TopNodeSplitter** splitters) : mSplitters(splitters)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			mSplitters[index]->split();
+		}
+
+		TopNodeSplitter**	mSplitters;
+	};
+
+	struct Subtree
+	{
+		AABBTreeBuildNode*	mRoot;			// Subtree root, allocated in the top-level node allocator
+		PxU32				mRootIndex;		// Index of the root in the final tree
+		PxU32				mNodeBase;		// Index of the first subtree node (after the root) in the final tree
+		NodeAllocator*		mAllocator;
+		BuildStats			mStats;
+	};
+
+	struct SubtreeSortPredicate
+	{
+		PX_FORCE_INLINE bool operator()(const Subtree& a, const Subtree& b) const
+		{
+			// Biggest subtrees first for better load balancing. The node index is unique and keeps the order deterministic.
+			if(a.mRoot->mNbPrimitives != b.mRoot->mNbPrimitives)
+				return a.mRoot->mNbPrimitives > b.mRoot->mNbPrimitives;
+			return a.mRoot->mNodeIndex < b.mRoot->mNodeIndex;
+		}
+	};
+
+	class ParallelBuildSubtrees : public PxParallelForWork
+	{
+		public:
+		ParallelBuildSubtrees(const AABBTreeBuildParams& params, Subtree* subtrees, PxU32* indices) : mParams(params), mSubtrees(subtrees), mIndices(indices)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			Subtree& subtree = mSubtrees[index];
+
+			// The subtree is built from a copy of its root, allocated as the first node of its own allocator. The copy is
+			// written back to the real root when flattening the tree.
+			NodeAllocator& allocator = *subtree.mAllocator;
+			allocator.init(subtree.mRoot->mNbPrimitives, mParams.mLimit);
+			allocator.mPool->mNodeIndex = subtree.mRoot->mNodeIndex;
+
+			buildHierarchy(allocator.mPool, mParams, subtree.mStats, allocator, mIndices, mParams.mBuildStrategy==BVH_SAH);
+		}
+
+		const AABBTreeBuildParams&	mParams;
+		Subtree*					mSubtrees;
+		PxU32*						mIndices;
+		PX_NOCOPY(ParallelBuildSubtrees)
+	};
+}
+
+// Returns the index of a node within the allocator, i.e. its index in the flattened tree if the allocator had been
+// flattened alone. This is the same search as in flattenTree().
+static PxU32 getNodeIndex(const NodeAllocator& nodeAllocator, const AABBTreeBuildNode* node)
+{
+	PxU32 nodeBase = 0;
+	const PxU32 nbSlabs = nodeAllocator.mSlabs.size();
+	for(PxU32 j=0;j<nbSlabs;j++)
+	{
+		const NodeAllocator::Slab& slab = nodeAllocator.mSlabs[j];
+		if(node >= slab.mPool && node < slab.mPool + slab.mNbUsedNodes)
+			return nodeBase + PxU32(node - slab.mPool);
+		nodeBase += slab.mNbUsedNodes;
+	}
+	PX_ASSERT(0);
+	return 0xffffffff;
+}
+
+static PX_FORCE_INLINE void flattenNode(BVHNode& dest, const AABBTreeBuildNode& node, const NodeAllocator& nodeAllocator, PxU32 offset)
+{
+	dest.mBV = node.mBV;
+	if(node.isLeaf())
+	{
+		const PxU32 nbPrims = node.getNbPrimitives();
+		PX_ASSERT(nbPrims<16);
+		dest.mData = (node.mNodeIndex<<5)|((nbPrims&15)<<1)|1;
+	}
+	else
+		dest.mData = (getNodeIndex(nodeAllocator, node.getPos()) + offset)<<1;
+}
+
+namespace
+{
+	class ParallelFlattenSubtrees : public PxParallelForWork
+	{
+		public:
+		ParallelFlattenSubtrees(const Subtree* subtrees, BVHNode* dest) : mSubtrees(subtrees), mDest(dest)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const Subtree& subtree = mSubtrees[index];
+			const NodeAllocator& allocator = *subtree.mAllocator;
+
+			// The subtree's first node is the copy of its root. Its children are at (mNodeBase + localIndex - 1).
+			const PxU32 offset = subtree.mNodeBase - 1;
+			flattenNode(mDest[subtree.mRootIndex], *allocator.mPool, allocator, offset);
+
+			PxU32 localIndex = 0;
+			const PxU32 nbSlabs = allocator.mSlabs.size();
+			for(PxU32 s=0;s<nbSlabs;s++)
+			{
+				const NodeAllocator::Slab& slab = allocator.mSlabs[s];
+				for(PxU32 i=0;i<slab.mNbUsedNodes;i++, localIndex++)
+				{
+					if(localIndex)
+						flattenNode(mDest[localIndex + offset], slab.mPool[i], allocator, offset);
+				}
+			}
+		}
+
+		const Subtree*	mSubtrees;
+		BVHNode*		mDest;
+	};
+}
+
+bool AABBTree::build(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, PxCpuDispatcher* dispatcher)
+{
+	if(!dispatcher)
+		return build(params, nodeAllocator);
+
+	const PxU32 nbPrimitives = params.mNbPrimitives;
+	if(!nbPrimitives)
+		return false;
+
+	// Release previous tree
+	release();
+
+	const PxU32 nbChunks = (nbPrimitives + PARALLEL_BUILD_CHUNK_SIZE - 1) / PARALLEL_BUILD_CHUNK_SIZE;
+
+	PxU32* indices = PX_ALLOCATE(PxU32, nbPrimitives, "AABB tree indices");
+	params.mCache = PX_ALLOCATE(PxVec3, (nbPrimitives+1), "cache");
+	{
+		ParallelBuildInit work(params, indices);
+		PxParallelFor(dispatcher, work, nbChunks);
+	}
+
+	// The top-level allocator only contains the top of the tree, which is small. So we don't let it preallocate
+	// nodes for the whole tree, and fix the number of primitives in the root afterwards.
+	nodeAllocator.init(PxMin(nbPrimitives, PxU32(PARALLEL_BUILD_MAX_NB_SUBTREES*2)), params.mLimit);
+	nodeAllocator.mPool->mNbPrimitives = nbPrimitives;
+
+	const PxU32 subtreeThreshold = PxMax(PxU32(PARALLEL_BUILD_MIN_SUBTREE), nbPrimitives / PARALLEL_BUILD_MAX_NB_SUBTREES);
+	PX_ASSERT(subtreeThreshold >= params.mLimit);
+
+	BuildStats stats;
+	stats.setCount(1);
+
+	PxArray<Subtree> subtrees;
+	PxArray<AABBTreeBuildNode*> level;
+	PxArray<AABBTreeBuildNode*> nextLevel;
+
+	Subtree subtree;
+	subtree.mAllocator = NULL;
+	subtree.mNodeBase = 0;
+
+	if(nbPrimitives > subtreeThreshold)
+		level.pushBack(nodeAllocator.mPool);
+	else
+	{
+		subtree.mRoot = nodeAllocator.mPool;
+		subtree.mRootIndex = 0;
+		subtrees.pushBack(subtree);
+	}
+
+	// Build the top of the tree, one level at a time
+	if(level.size())
+	{
+		PxU32* tmp = PX_ALLOCATE(PxU32, nbPrimitives, "tmp");
+
+		PxArray<TopNodeSplitter> splitters;
+		PxArray<TopNodeSplitter*> smallNodes;
+		while(level.size())
+		{
+			const PxU32 nbNodes = level.size();
+			splitters.clear();
+			splitters.resize(nbNodes);
+			smallNodes.clear();
+
+			for(PxU32 i=0;i<nbNodes;i++)
+			{
+				TopNodeSplitter& splitter = splitters[i];
+				splitter.init(level[i], params, indices, tmp);
+
+				if(level[i]->mNbPrimitives < PARALLEL_BUILD_BIG_NODE)
+				{
+					smallNodes.pushBack(&splitter);
+					continue;
+				}
+
+				for(PxU32 pass=0;pass<SPLIT_PASS_NB;pass++)
+				{
+					if(!splitter.needsPass(pass))
+						break;
+					ParallelSplitPass work(splitter, pass);
+					PxParallelFor(dispatcher, work, splitter.mNbChunks);
+					splitter.finishPass(pass);
+				}
+			}
+
+			{
+				ParallelSplitNodes work(smallNodes.begin());
+				PxParallelFor(dispatcher, work, smallNodes.size());
+			}
+
+			// Allocate children in a fixed order, so that node indices don't depend on the threads
+			nextLevel.clear();
+			for(PxU32 i=0;i<nbNodes;i++)
+			{
+				AABBTreeBuildNode* node = level[i];
+				stats.mTotalPrims += node->mNbPrimitives;
+
+				AABBTreeBuildNode* pos = nodeAllocator.getBiNode();
+				node->mPos = pos;
+				stats.increaseCount(2);
+
+				const PxU32 nbPos = splitters[i].mNbPos;
+				pos[0].mNodeIndex = node->mNodeIndex;
+				pos[0].mNbPrimitives = nbPos;
+				pos[1].mNodeIndex = node->mNodeIndex + nbPos;
+				pos[1].mNbPrimitives = node->mNbPrimitives - nbPos;
+
+				const PxU32 posIndex = nodeAllocator.mTotalNbNodes - 2;
+				for(PxU32 j=0;j<2;j++)
+				{
+					if(pos[j].mNbPrimitives > subtreeThreshold)
+						nextLevel.pushBack(pos + j);
+					else
+					{
+						subtree.mRoot = pos + j;
+						subtree.mRootIndex = posIndex + j;
+						subtrees.pushBack(subtree);
+					}
+				}
+			}
+			level.swap(nextLevel);
+		}
+
+		PX_FREE(tmp);
+	}
+
+	// Build the subtrees
+	const PxU32 nbSubtrees = subtrees.size();
+	PxSort(subtrees.begin(), nbSubtrees, SubtreeSortPredicate());
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		subtrees[i].mAllocator = PX_NEW(NodeAllocator);
+	{
+		ParallelBuildSubtrees work(params, subtrees.begin(), indices);
+		PxParallelFor(dispatcher, work, nbSubtrees);
+	}
+
+	// Flatten everything. The top of the tree comes first, then each subtree, so children are always stored after their parent.
+	PxU32 nbNodes = nodeAllocator.mTotalNbNodes;
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		Subtree& current = subtrees[i];
+		current.mNodeBase = nbNodes;
+		nbNodes += current.mAllocator->mTotalNbNodes - 1;
+		stats.increaseCount(current.mStats.getCount());
+		stats.mTotalPrims += current.mStats.mTotalPrims;
+	}
+	PX_ASSERT(nbNodes==stats.getCount());
+
+	mNodes = PX_NEW(BVHNode)[nbNodes];
+	mNbNodes = nbNodes;
+	{
+		ParallelFlattenSubtrees work(subtrees.begin(), mNodes);
+		PxParallelFor(dispatcher, work, nbSubtrees);
+	}
+	{
+		PxU32 index = 0;
+		const PxU32 nbSlabs = nodeAllocator.mSlabs.size();
+		for(PxU32 s=0;s<nbSlabs;s++)
+		{
+			const NodeAllocator::Slab& slab = nodeAllocator.mSlabs[s];
+			for(PxU32 i=0;i<slab.mNbUsedNodes;i++, index++)
+			{
+				// Subtree roots have already been written. All the other top-level nodes are internal nodes.
+				if(slab.mPool[i].mPos)
+					flattenNode(mNodes[index], slab.mPool[i], nodeAllocator, 0);
+			}
+		}
+	}
+
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		PX_DELETE(subtrees[i].mAllocator);
+	nodeAllocator.release();
+	PX_FREE(params.mCache);
+
+	mIndices	= indices;
+	mNbIndices	= nbPrimitives;
+	mTotalPrims	= stats.mTotalPrims;
+	return true;
+}
+//~Parallel building
+
 PX_FORCE_INLINE static void setLeafData(PxU32& leafData, const BVHNode& node, const PxU32 indicesOffset)
 {
 	const PxU32 index = indicesOffset + (node.mData >> 5);
@@ -41,6 +41,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	struct BVHNode;
@@ -274,6 +276,10 @@ namespace Gu
 
 		PX_FORCE_INLINE			PxU32*			getUpdateMap()	{ return mUpdateMap;	}
 
+		// Nodes marked for refit, until the next refitMarkedNodes call
+		PX_FORCE_INLINE	const	BitArray&		getRefitBitmask()			const	{ return mRefitBitmask;			}
+		PX_FORCE_INLINE			PxU32			getRefitHighestSetWord()	const	{ return mRefitHighestSetWord;	}
+
 		protected:
 								PxU32*			mParentIndices;		//!< PT: hot/cold split, keep parent data in separate array
 								PxU32*			mUpdateMap;			//!< PT: Local index to tree node index
@@ -294,6 +300,11 @@ namespace Gu
 		PX_PHYSX_COMMON_API						~AABBTree();
 		// Build
 		PX_PHYSX_COMMON_API		bool			build(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator);
+		// Parallel building. The calling thread takes part in the build and never waits for tasks that have not started
+		// yet, so this can also be called from a task running on the dispatcher. The resulting tree only depends on the
+		// input, not on the number of worker threads.
+		PX_PHYSX_COMMON_API		bool			build(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, PxCpuDispatcher* dispatcher);
+		//~Parallel building
 		// Progressive building
 		PX_PHYSX_COMMON_API		PxU32			progressiveBuild(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32 progress, PxU32 limit);
 		//~Progressive building
@@ -30,6 +30,7 @@
 #include "GuAABBPruner.h"
 #include "GuBucketPruner.h"
 #include "GuIncrementalAABBPruner.h"
+#include "GuWideAABBPruner.h"
 
 using namespace physx;
 using namespace Gu;
@@ -49,3 +50,7 @@ Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
 	return PX_NEW(IncrementalAABBPruner)(32, contextID);
 }
 
+Pruner* physx::Gu::createWideAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode)
+{
+	return PX_NEW(WideAABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode);
+}
@@ -200,6 +200,38 @@ PxU32 PxGeometryQuery::raycast(	const PxVec3& rayOrigin, const PxVec3& rayDir,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 PxGeometryQuery::raycastPacket(	const PxRayPacket& packet,
+										const PxGeometry& geom, const PxTransform& pose,
+										PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT rayHits,
+										PxGeometryQueryFlags queryFlags, PxRaycastThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxGeometryQuery::raycastPacket(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxGeometryQuery::isValid(geom), "PxGeometryQuery::raycastPacket(): geometry is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(packet.isValid(), "PxGeometryQuery::raycastPacket(): ray packet is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(rayHits, "PxGeometryQuery::raycastPacket(): rayHits cannot be NULL.", 0);
+
+	if(geom.getType()==PxGeometryType::eTRIANGLEMESH)
+	{
+		const PxTriangleMeshGeometry& meshGeom = static_cast<const PxTriangleMeshGeometry&>(geom);
+		const TriangleMesh* meshData = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+		return Midphase::raycastPacketTriangleMesh(meshData, meshGeom, pose, packet, hitFlags, rayHits);
+	}
+
+	// Other geometries don't have a packet version, we just raycast each ray
+	hitFlags &= ~PxHitFlag::eMESH_MULTIPLE;
+	const RaycastFunc func = gRaycastMap[geom.getType()];
+	PxU32 hitMask = 0;
+	for(PxU32 i=0; i<packet.nbRays; i++)
+	{
+		if(func(geom, pose, packet.getOrigin(i), packet.getDir(i), packet.maxDist[i], hitFlags, 1, rayHits + i, sizeof(PxGeomRaycastHit), threadContext))
+			hitMask |= 1u<<i;
+	}
+	return hitMask;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool pointConvexDistance(PxVec3& normal_, PxVec3& closestPoint_, PxReal& sqDistance, const PxVec3& pt, const ConvexMesh* convexMesh, const PxMeshScale& meshScale, const PxTransform32& convexPose);
 
 PxReal PxGeometryQuery::pointDistance(const PxVec3& point, const PxGeometry& geom, const PxTransform& pose, PxVec3* closestPoint, PxU32* closestIndex, PxGeometryQueryFlags queryFlags)
@@ -0,0 +1,184 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "common/PxProfileZone.h"
+#include "GuWideAABBPruner.h"
+#include "GuWideAABBTreeQuery.h"
+#include "GuCallbackAdapter.h"
+#include "GuQuery.h"
+
+using namespace physx;
+using namespace Gu;
+
+WideAABBPruner::WideAABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
+	AABBPruner(incrementalRebuild, contextID, cpType, buildStrategy, nbObjectsPerNode)
+{
+}
+
+WideAABBPruner::~WideAABBPruner()
+{
+}
+
+void WideAABBPruner::commit()
+{
+	// Same early exit as in AABBPruner::commit()
+	if(!mUncommittedChanges && (mProgress != BUILD_FINISHED))
+		return;
+
+	// These are the cases where AABBPruner::commit() replaces the binary tree. Otherwise it only refits it.
+	const bool newTree = !mAABBTree || !mIncrementalRebuild || mProgress==BUILD_FINISHED;
+
+	// This must happen before the binary tree is refit, since the refit clears the binary tree's refit bitmask
+	if(!newTree)
+		mWideTree.markForRefit(*mAABBTree);
+
+	AABBPruner::commit();
+
+	PX_PROFILE_ZONE("SceneQuery.prunerWideTreeUpdate", mPool.mContextID);
+
+	if(!mAABBTree)
+		mWideTree.release();
+	else if(newTree)
+		mWideTree.build(*mAABBTree);
+	else
+		mWideTree.refitMarkedNodes(*mAABBTree);
+}
+
+void WideAABBPruner::merge(const void* mergeParams)
+{
+	AABBPruner::merge(mergeParams);
+
+	// The static pruner merges the new objects directly into the binary tree, without a commit
+	if(!mIncrementalRebuild && mAABBTree)
+		mWideTree.build(*mAABBTree);
+}
+
+void WideAABBPruner::shiftOrigin(const PxVec3& shift)
+{
+	AABBPruner::shiftOrigin(shift);
+
+	mWideTree.shiftOrigin(shift);
+}
+
+bool WideAABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+
+		// The wide tree's SOA tests use the query's AABB, the actual query volume is then tested on the surviving children
+		const PxBounds3& queryBounds = queryVolume.getPrunerInflatedWorldAABB();
+
+		switch(queryVolume.getType())
+		{
+			case PxGeometryType::eBOX:
+			{
+				if(queryVolume.isOBB())
+				{	
+					const DefaultOBBAABBTest test(queryVolume);
+					again = WideAABBTreeOverlap<OBBAABBTest, true, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryBounds, test, pcb);
+				}
+				else
+				{
+					const DefaultAABBAABBTest test(queryVolume);
+					again = WideAABBTreeOverlap<AABBAABBTest, false, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryBounds, test, pcb);
+				}
+			}
+			break;
+
+			case PxGeometryType::eCAPSULE:
+			{
+				const DefaultCapsuleAABBTest test(queryVolume, getCapsuleInflation());
+				again = WideAABBTreeOverlap<CapsuleAABBTest, true, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryBounds, test, pcb);
+			}
+			break;
+
+			case PxGeometryType::eSPHERE:
+			{
+				const DefaultSphereAABBTest test(queryVolume);
+				again = WideAABBTreeOverlap<SphereAABBTest, true, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryBounds, test, pcb);
+			}
+			break;
+
+			case PxGeometryType::eCONVEXMESH:
+			{
+				const DefaultOBBAABBTest test(queryVolume);
+				again = WideAABBTreeOverlap<OBBAABBTest, true, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryBounds, test, pcb);
+			}
+			break;
+		default:
+			PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+		}
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.overlap(queryVolume, pcbArgName);
+
+	return again;
+}
+
+bool WideAABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+		again = WideAABBTreeRaycast<true, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.sweep(queryVolume, unitDir, inOutDistance, pcbArgName);
+
+	return again;
+}
+
+bool WideAABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		again = WideAABBTreeRaycast<false, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+	}
+		
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.raycast(origin, unitDir, inOutDistance, pcbArgName);
+
+	return again;
+}
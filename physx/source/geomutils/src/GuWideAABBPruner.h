@@ -0,0 +1,70 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_WIDE_AABB_PRUNER_H
+#define GU_WIDE_AABB_PRUNER_H
+
+#include "GuAABBPruner.h"
+#include "GuWideAABBTree.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// This class is an AABBPruner whose queries run on a wide (8-ary) BVH with quantized child bounds
+	// The binary AABB tree is still built, rebuilt and refit exactly as in AABBPruner, and remains the reference for the
+	// pool-to-tree mapping. After each commit() the wide tree is either collapsed again from the new binary tree, or
+	// partially re-quantized from the binary nodes refit during that commit.
+	// Queries on objects not yet in the tree still go through the bucket pruner.
+	class WideAABBPruner : public AABBPruner
+	{
+												PX_NOCOPY(WideAABBPruner)
+		public:
+		PX_PHYSX_COMMON_API						WideAABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4);
+		virtual									~WideAABBPruner();
+
+		// BasePruner
+		virtual			void					shiftOrigin(const PxVec3& shift);
+		//~BasePruner
+
+		// Pruner
+		virtual			void					commit();
+		virtual			void					merge(const void* mergeParams);
+		virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&)					const;
+		virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback&)															const;
+		virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&)				const;
+		//~Pruner
+
+		PX_FORCE_INLINE	const WideAABBTree&		getWideTree()		const		{ PX_ASSERT(!mUncommittedChanges); return mWideTree;	}
+
+						WideAABBTree			mWideTree;	// wide version of mAABBTree, in sync with it after commit()
+	};
+}
+}
+
+#endif
@@ -0,0 +1,356 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxMemory.h"
+#include "GuWideAABBTree.h"
+#include "GuAABBTreeNode.h"
+
+using namespace physx;
+using namespace Gu;
+
+#define INVALID_WIDE_ID	0xffffffff
+
+// The last quantized value is not used by the frame, it is kept as a safety margin (see quantizeMin/quantizeMax).
+static const PxU32	gQuantizedMax	= 0xffff;
+static const float	gNbSteps		= float(gQuantizedMax - 1);
+
+static PX_FORCE_INLINE bool isEmptyBox(const PxBounds3& box)
+{
+	// We don't use PxBounds3::isEmpty() because invalidated tree nodes use GU_EMPTY_BOUNDS_EXTENTS, which doesn't pass PxBounds3::isValid()
+	return box.minimum.x > box.maximum.x;
+}
+
+static PX_FORCE_INLINE float computeSurfaceArea(const PxBounds3& box)
+{
+	if(isEmptyBox(box))
+		return -1.0f;
+	const PxVec3 d = box.maximum - box.minimum;
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+// Returns a scale such that origin + scale*gNbSteps covers maxV, after rounding.
+static PX_FORCE_INLINE float computeScale(float minV, float maxV)
+{
+	const float extent = maxV - minV;
+	if(extent<=0.0f)
+		return 0.0f;
+
+	float scale = extent / gNbSteps;
+	float delta = scale * PX_EPS_F32;
+	while(minV + scale*gNbSteps < maxV)
+	{
+		scale += delta;
+		delta *= 2.0f;
+	}
+	return scale;
+}
+
+// Quantized values are rounded outward, then moved one extra step outward. Dequantization may not use the exact same
+// floating-point operations as this code (e.g. fused multiply-adds), and the extra step guarantees conservative bounds anyway.
+static PX_FORCE_INLINE PxU32 quantizeMin(float v, float origin, float scale)
+{
+	if(scale==0.0f)
+		return 0;
+
+	const float q = PxFloor((v - origin) / scale);
+	PxU32 qi = q<=0.0f ? 0 : q>=float(gQuantizedMax) ? gQuantizedMax : PxU32(q);
+	while(qi && origin + float(qi)*scale > v)
+		qi--;
+	return qi ? qi - 1 : 0;
+}
+
+static PX_FORCE_INLINE PxU32 quantizeMax(float v, float origin, float scale)
+{
+	if(scale==0.0f)
+		return 0;
+
+	const float q = PxCeil((v - origin) / scale);
+	PxU32 qi = q<=0.0f ? 0 : q>=float(gQuantizedMax) ? gQuantizedMax : PxU32(q);
+	while(qi<gQuantizedMax && origin + float(qi)*scale < v)
+		qi++;
+	return qi<gQuantizedMax ? qi + 1 : gQuantizedMax;
+}
+
+static PX_FORCE_INLINE PxU32 quantize(float minV, float maxV, float origin, float scale)
+{
+	return quantizeMin(minV, origin, scale) | (quantizeMax(maxV, origin, scale)<<16);
+}
+
+WideAABBTree::WideAABBTree() : mRefitHighestSetWord(0)
+{
+}
+
+WideAABBTree::~WideAABBTree()
+{
+	release();
+}
+
+void WideAABBTree::release()
+{
+	mNodes.reset();
+	mParents.reset();
+	mSourceNodes.reset();
+	mChildSources.reset();
+	mOwners.reset();
+	mRefitHighestSetWord = 0;
+}
+
+void WideAABBTree::build(const AABBTree& tree)
+{
+	mNodes.clear();
+	mParents.clear();
+	mSourceNodes.clear();
+	mChildSources.clear();
+	mRefitHighestSetWord = 0;
+
+	const PxU32 nbBinaryNodes = tree.getNbNodes();
+	const BVHNode* PX_RESTRICT binaryNodes = tree.getNodes();
+	if(!nbBinaryNodes || !binaryNodes)
+	{
+		mOwners.clear();
+		return;
+	}
+
+	mOwners.resizeUninitialized(nbBinaryNodes);
+	PxMemSet(mOwners.begin(), 0xff, sizeof(PxU32)*nbBinaryNodes);
+
+	// Each wide node consumes at least one internal binary node, usually ~7 of them.
+	const PxU32 estimatedNbNodes = nbBinaryNodes/(GU_WIDE_AABBTREE_WIDTH*2) + 1;
+	mNodes.reserve(estimatedNbNodes);
+	mParents.reserve(estimatedNbNodes);
+	mSourceNodes.reserve(estimatedNbNodes);
+	mChildSources.reserve(estimatedNbNodes*GU_WIDE_AABBTREE_WIDTH);
+
+	// The root is its own parent, as in the binary tree's parent array
+	mNodes.insert();
+	mParents.pushBack(0);
+	mSourceNodes.pushBack(0);
+	mOwners[0] = 0;
+
+	// Breadth-first collapse. New wide nodes are appended while we iterate.
+	for(PxU32 index=0; index<mNodes.size(); index++)
+	{
+		PxU32 children[GU_WIDE_AABBTREE_WIDTH];
+		PxU32 nbChildren;
+
+		const BVHNode& source = binaryNodes[mSourceNodes[index]];
+		if(source.isLeaf())
+		{
+			// Only possible for a tree made of a single leaf
+			children[0] = mSourceNodes[index];
+			nbChildren = 1;
+		}
+		else
+		{
+			children[0] = source.getPosIndex();
+			children[1] = source.getNegIndex();
+			nbChildren = 2;
+
+			// Greedily open the internal child with the largest surface area, until the wide node is full
+			while(nbChildren<GU_WIDE_AABBTREE_WIDTH)
+			{
+				PxU32 best = INVALID_WIDE_ID;
+				float bestArea = -1.0f;
+				for(PxU32 i=0;i<nbChildren;i++)
+				{
+					const BVHNode& child = binaryNodes[children[i]];
+					if(child.isLeaf())
+						continue;
+
+					const float area = computeSurfaceArea(child.mBV);
+					if(area>bestArea)
+					{
+						bestArea = area;
+						best = i;
+					}
+				}
+				if(best==INVALID_WIDE_ID)
+					break;
+
+				const BVHNode& opened = binaryNodes[children[best]];
+				children[best] = opened.getPosIndex();
+				children[nbChildren++] = opened.getNegIndex();
+			}
+		}
+
+		PxU32 childData[GU_WIDE_AABBTREE_WIDTH];
+		for(PxU32 i=0;i<GU_WIDE_AABBTREE_WIDTH;i++)
+		{
+			if(i>=nbChildren)
+			{
+				childData[i] = 0;
+				mChildSources.pushBack(INVALID_WIDE_ID);
+				continue;
+			}
+
+			const PxU32 childIndex = children[i];
+			mOwners[childIndex] = index;
+			mChildSources.pushBack(childIndex);
+
+			if(binaryNodes[childIndex].isLeaf())
+			{
+				childData[i] = (childIndex<<1)|1;
+			}
+			else
+			{
+				const PxU32 newIndex = mNodes.size();
+				mNodes.insert();
+				mParents.pushBack(index);
+				mSourceNodes.pushBack(childIndex);
+				childData[i] = newIndex<<1;
+			}
+		}
+
+		// Written after the loop since 'insert' above can reallocate mNodes
+		PxMemCopy(mNodes[index].mChildData, childData, sizeof(PxU32)*GU_WIDE_AABBTREE_WIDTH);
+	}
+
+	mRefitBitmask.init(mNodes.size());
+
+	fullRefit(tree);
+}
+
+void WideAABBTree::quantizeNode(PxU32 index, const BVHNode* PX_RESTRICT binaryNodes)
+{
+	WideAABBTreeNode& node = mNodes[index];
+
+	const PxBounds3& frame = binaryNodes[mSourceNodes[index]].mBV;
+	if(isEmptyBox(frame))
+	{
+		node.mOrigin = PxVec3(0.0f);
+		node.mScale = PxVec3(0.0f);
+		node.mChildMask = 0;
+		return;
+	}
+
+	const PxVec3 origin = frame.minimum;
+	const PxVec3 scale(	computeScale(frame.minimum.x, frame.maximum.x),
+						computeScale(frame.minimum.y, frame.maximum.y),
+						computeScale(frame.minimum.z, frame.maximum.z));
+
+	const PxU32* PX_RESTRICT sources = mChildSources.begin() + index*GU_WIDE_AABBTREE_WIDTH;
+
+	PxU32 childMask = 0;
+	for(PxU32 i=0;i<GU_WIDE_AABBTREE_WIDTH;i++)
+	{
+		const PxU32 sourceIndex = sources[i];
+		const PxBounds3* box = sourceIndex!=INVALID_WIDE_ID ? &binaryNodes[sourceIndex].mBV : NULL;
+		if(!box || isEmptyBox(*box))
+		{
+			// The child mask is what discards this slot, the quantized values don't matter
+			node.mQX[i] = node.mQY[i] = node.mQZ[i] = 0;
+			continue;
+		}
+
+		node.mQX[i] = quantize(box->minimum.x, box->maximum.x, origin.x, scale.x);
+		node.mQY[i] = quantize(box->minimum.y, box->maximum.y, origin.y, scale.y);
+		node.mQZ[i] = quantize(box->minimum.z, box->maximum.z, origin.z, scale.z);
+		childMask |= 1<<i;
+	}
+
+	node.mOrigin = origin;
+	node.mScale = scale;
+	node.mChildMask = childMask;
+}
+
+void WideAABBTree::fullRefit(const AABBTree& tree)
+{
+	const BVHNode* PX_RESTRICT binaryNodes = tree.getNodes();
+	const PxU32 nbNodes = mNodes.size();
+	for(PxU32 i=0;i<nbNodes;i++)
+		quantizeNode(i, binaryNodes);
+}
+
+void WideAABBTree::markNodeForRefit(PxU32 index)
+{
+	PxU32 refitHighestSetWord = mRefitHighestSetWord;
+	while(!mRefitBitmask.isSet(index))
+	{
+		mRefitBitmask.setBit(index);
+		refitHighestSetWord = PxMax(refitHighestSetWord, index>>5);
+
+		const PxU32 parentIndex = mParents[index];
+		if(parentIndex==index)
+			break;
+		index = parentIndex;
+	}
+	mRefitHighestSetWord = refitHighestSetWord;
+}
+
+void WideAABBTree::markForRefit(const AABBTree& tree)
+{
+	const PxU32* bits = tree.getRefitBitmask().getBits();
+	if(!bits || !mNodes.size())
+		return;
+
+	const PxU32 nbOwners = mOwners.size();
+	const PxU32 nbWords = PxMin(tree.getRefitHighestSetWord()+1, tree.getRefitBitmask().getSize());
+	for(PxU32 w=0; w<nbWords; w++)
+	{
+		for(PxU32 b=bits[w]; b; b &= b-1)
+		{
+			const PxU32 binaryIndex = w<<5|PxLowestSetBit(b);
+			if(binaryIndex<nbOwners)
+			{
+				const PxU32 owner = mOwners[binaryIndex];
+				if(owner!=INVALID_WIDE_ID)
+					markNodeForRefit(owner);
+			}
+		}
+	}
+}
+
+void WideAABBTree::refitMarkedNodes(const AABBTree& tree)
+{
+	PxU32* bits = const_cast<PxU32*>(mRefitBitmask.getBits());
+	if(!bits)
+		return;
+
+	const BVHNode* PX_RESTRICT binaryNodes = tree.getNodes();
+	const PxU32 nbWords = mRefitHighestSetWord+1;
+	for(PxU32 w=0; w<nbWords; w++)
+	{
+		for(PxU32 b=bits[w]; b; b &= b-1)
+			quantizeNode(w<<5|PxLowestSetBit(b), binaryNodes);
+		bits[w] = 0;
+	}
+	mRefitHighestSetWord = 0;
+}
+
+void WideAABBTree::shiftOrigin(const PxVec3& shift)
+{
+	// Quantized values are relative to the node's origin, so they don't change
+	const PxU32 nbNodes = mNodes.size();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		if(mNodes[i].mChildMask)
+			mNodes[i].mOrigin -= shift;
+	}
+}
@@ -0,0 +1,127 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_WIDE_AABBTREE_H
+#define GU_WIDE_AABBTREE_H
+
+#include "foundation/PxArray.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxUserAllocated.h"
+#include "common/PxPhysXCommonConfig.h"
+#include "GuAABBTree.h"
+
+#define GU_WIDE_AABBTREE_WIDTH	8
+
+namespace physx
+{
+namespace Gu
+{
+	// An 8-wide node with quantized child bounds. Quantization follows the BV4 scheme: per-node dequantization coeffs,
+	// 16-bit min/max per axis and per child, stored in SOA form so that 4 children can be decoded & tested at once.
+	//
+	// The node's origin & scale are derived from the bounds of the binary node it has been collapsed from. Quantized values
+	// are always rounded outward so that dequantized boxes are conservative.
+	PX_ALIGN_PREFIX(16)
+	struct WideAABBTreeNode
+	{
+		PX_FORCE_INLINE	PxU32	isLeaf(PxU32 i)			const	{ return mChildData[i]&1;	}
+		PX_FORCE_INLINE	PxU32	getChildIndex(PxU32 i)	const	{ return mChildData[i]>>1;	}
+
+		PxVec3	mOrigin;		//!< Dequantization origin (min of the node's bounds)
+		PxU32	mChildMask;		//!< Bit i is set if child i exists and has non-empty bounds. Keep this right after mOrigin for safe V4 loads
+		PxVec3	mScale;			//!< Dequantization scale
+		PxU32	mPadding;
+		PxU32	mQX[GU_WIDE_AABBTREE_WIDTH];			//!< Quantized child bounds along X, min in low 16 bits, max in high 16 bits
+		PxU32	mQY[GU_WIDE_AABBTREE_WIDTH];			//!< Quantized child bounds along Y
+		PxU32	mQZ[GU_WIDE_AABBTREE_WIDTH];			//!< Quantized child bounds along Z
+		PxU32	mChildData[GU_WIDE_AABBTREE_WIDTH];	//!< Wide node index, or binary leaf node index (leaf bit set)
+	}PX_ALIGN_SUFFIX(16);
+
+	PX_COMPILE_TIME_ASSERT(sizeof(WideAABBTreeNode)==160);
+
+#if PX_VC
+#pragma warning(push)
+#pragma warning( disable : 4251 ) // class needs to have dll-interface to be used by clients of class
+#endif
+
+	// A wide (8-ary) BVH collapsed from a binary AABBTree. The wide tree does not own primitives: its leaves reference
+	// the leaf nodes of the binary tree, so the binary tree's update map and index array remain the reference for which
+	// primitives live where. This lets the AABBPruner's incremental machinery (update map, fixups, partial refit) work
+	// unchanged, while queries traverse the much shallower & more cache-friendly wide tree.
+	//
+	// Refit is done on top of a refitted binary tree: the bounds of each wide node and each of its children are bounds
+	// of binary nodes, so re-quantizing a wide node only needs the (already refitted) binary nodes. The order in which
+	// marked wide nodes are re-quantized doesn't matter.
+	class PX_PHYSX_COMMON_API WideAABBTree : public PxUserAllocated
+	{
+		public:
+												WideAABBTree();
+												~WideAABBTree();
+
+						void					release();
+
+		// Collapses the binary tree into the wide tree. The binary tree must outlive the wide tree (or the next build).
+						void					build(const AABBTree& tree);
+
+		// Marks the wide nodes whose quantized bounds depend on the binary nodes currently marked for refit in 'tree'.
+		// Must be called before tree.refitMarkedNodes(), since the binary tree clears its refit bitmask there.
+						void					markForRefit(const AABBTree& tree);
+
+		// Re-quantizes the marked wide nodes, using the bounds of the (refitted) binary tree.
+						void					refitMarkedNodes(const AABBTree& tree);
+
+		// Re-quantizes all wide nodes.
+						void					fullRefit(const AABBTree& tree);
+
+						void					shiftOrigin(const PxVec3& shift);
+
+		PX_FORCE_INLINE	const WideAABBTreeNode*	getNodes()		const	{ return mNodes.begin();	}
+		PX_FORCE_INLINE	PxU32					getNbNodes()	const	{ return mNodes.size();		}
+
+		private:
+						PxArray<WideAABBTreeNode>	mNodes;
+		// hot/cold split, the data below is only needed for refits
+						PxArray<PxU32>				mParents;		//!< Parent wide node, per wide node
+						PxArray<PxU32>				mSourceNodes;	//!< Binary node each wide node has been collapsed from
+						PxArray<PxU32>				mChildSources;	//!< Binary node of each child slot, GU_WIDE_AABBTREE_WIDTH per wide node
+						PxArray<PxU32>				mOwners;		//!< Wide node whose quantized bounds depend on a given binary node
+						BitArray					mRefitBitmask;	//!< Bit is set for each wide node to re-quantize
+						PxU32						mRefitHighestSetWord;
+
+						void					quantizeNode(PxU32 index, const BVHNode* PX_RESTRICT binaryNodes);
+						void					markNodeForRefit(PxU32 index);
+	};
+
+#if PX_VC
+#pragma warning(pop)
+#endif
+
+}
+}
+
+#endif
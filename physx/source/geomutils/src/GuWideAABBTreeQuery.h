@@ -0,0 +1,314 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_WIDE_AABBTREE_QUERY_H
+#define GU_WIDE_AABBTREE_QUERY_H
+
+#include "foundation/PxBitUtils.h"
+#include "GuWideAABBTree.h"
+#include "GuAABBTreeQuery.h"
+
+namespace physx
+{
+	namespace Gu
+	{
+		// Per-node dequantization data, splatted once per node
+		struct WideNodeFrame
+		{
+			PX_FORCE_INLINE	WideNodeFrame(const WideAABBTreeNode* node) :
+				mOriginX(V4Load(node->mOrigin.x)), mOriginY(V4Load(node->mOrigin.y)), mOriginZ(V4Load(node->mOrigin.z)),
+				mScaleX(V4Load(node->mScale.x)), mScaleY(V4Load(node->mScale.y)), mScaleZ(V4Load(node->mScale.z))
+			{
+			}
+
+			Vec4V	mOriginX, mOriginY, mOriginZ;
+			Vec4V	mScaleX, mScaleY, mScaleZ;
+		};
+
+		// Decodes one axis of 4 children, as in the BV4 code
+		static PX_FORCE_INLINE void decodeWideAxis(const PxU32* PX_RESTRICT q, const Vec4V origin, const Vec4V scale, Vec4V& minV, Vec4V& maxV)
+		{
+			const VecI32V packed = I4LoadA(reinterpret_cast<const PxI32*>(q));
+			const VecI32V mask = I4Load(0x0000ffff);
+			// The shift is arithmetic on some platforms, hence the mask
+			const VecI32V qMin = VecI32V_And(packed, mask);
+			const VecI32V qMax = VecI32V_And(VecI32V_RightShift(packed, 16), mask);
+			minV = V4MulAdd(Vec4V_From_VecI32V(qMin), scale, origin);
+			maxV = V4MulAdd(Vec4V_From_VecI32V(qMax), scale, origin);
+		}
+
+		// Decoded bounds of 8 children, stored in SOA form
+		struct WideNodeBounds
+		{
+			PX_FORCE_INLINE	void	decode(const WideAABBTreeNode* PX_RESTRICT node, const WideNodeFrame& frame, PxU32 offset)
+			{
+				decodeWideAxis(node->mQX + offset, frame.mOriginX, frame.mScaleX, mMinX[offset>>2], mMaxX[offset>>2]);
+				decodeWideAxis(node->mQY + offset, frame.mOriginY, frame.mScaleY, mMinY[offset>>2], mMaxY[offset>>2]);
+				decodeWideAxis(node->mQZ + offset, frame.mOriginZ, frame.mScaleZ, mMinZ[offset>>2], mMaxZ[offset>>2]);
+			}
+
+			// Returns center & extents of child i, for the regular (non-SOA) tests
+			PX_FORCE_INLINE	void	getCenterExtents(PxU32 i, Vec3V& center, Vec3V& extents)	const
+			{
+				const float* minX = reinterpret_cast<const float*>(mMinX);
+				const float* minY = reinterpret_cast<const float*>(mMinY);
+				const float* minZ = reinterpret_cast<const float*>(mMinZ);
+				const float* maxX = reinterpret_cast<const float*>(mMaxX);
+				const float* maxY = reinterpret_cast<const float*>(mMaxY);
+				const float* maxZ = reinterpret_cast<const float*>(mMaxZ);
+
+				const Vec3V minV = V3LoadU(PxVec3(minX[i], minY[i], minZ[i]));
+				const Vec3V maxV = V3LoadU(PxVec3(maxX[i], maxY[i], maxZ[i]));
+
+				const FloatV halfV = FLoad(0.5f);
+				center = V3Scale(V3Add(maxV, minV), halfV);
+				extents = V3Scale(V3Sub(maxV, minV), halfV);
+			}
+
+			Vec4V	mMinX[2], mMinY[2], mMinZ[2];
+			Vec4V	mMaxX[2], mMaxY[2], mMaxZ[2];
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// Overlap traversal. All children of a node are first culled against the query's bounds using SOA tests. When
+		// tExactTest is true, the surviving children are then tested against the actual query volume (e.g. an OBB).
+		template<typename Test, const bool tExactTest, typename QueryCallback>
+		class WideAABBTreeOverlap
+		{
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const AABBTree& tree, const WideAABBTree& wideTree, const PxBounds3& queryBounds, const Test& test, QueryCallback& visitor)
+			{
+				const WideAABBTreeNode* PX_RESTRICT wideNodes = wideTree.getNodes();
+				if(!wideNodes)
+					return true;
+
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const BVHNode* PX_RESTRICT binaryNodes = tree.getNodes();
+				const PxU32* indices = tree.getIndices();
+
+				const Vec4V queryMinX = V4Load(queryBounds.minimum.x);
+				const Vec4V queryMinY = V4Load(queryBounds.minimum.y);
+				const Vec4V queryMinZ = V4Load(queryBounds.minimum.z);
+				const Vec4V queryMaxX = V4Load(queryBounds.maximum.x);
+				const Vec4V queryMaxY = V4Load(queryBounds.maximum.y);
+				const Vec4V queryMaxZ = V4Load(queryBounds.maximum.z);
+
+				PxInlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0] = 0;
+				PxU32 stackIndex = 1;
+
+				WideNodeBounds childBounds;
+				while(stackIndex > 0)
+				{
+					const WideAABBTreeNode* PX_RESTRICT node = wideNodes + stack[--stackIndex];
+					const WideNodeFrame frame(node);
+
+					PxU32 code = 0;
+					for(PxU32 j=0;j<2;j++)
+					{
+						childBounds.decode(node, frame, j*4);
+
+						const BoolV overlapX = BAnd(V4IsGrtrOrEq(queryMaxX, childBounds.mMinX[j]), V4IsGrtrOrEq(childBounds.mMaxX[j], queryMinX));
+						const BoolV overlapY = BAnd(V4IsGrtrOrEq(queryMaxY, childBounds.mMinY[j]), V4IsGrtrOrEq(childBounds.mMaxY[j], queryMinY));
+						const BoolV overlapZ = BAnd(V4IsGrtrOrEq(queryMaxZ, childBounds.mMinZ[j]), V4IsGrtrOrEq(childBounds.mMaxZ[j], queryMinZ));
+						code |= BGetBitMask(BAnd(BAnd(overlapX, overlapY), overlapZ))<<(j*4);
+					}
+					code &= node->mChildMask;
+
+					while(code)
+					{
+						const PxU32 i = PxLowestSetBit(code);
+						code &= code - 1;
+
+						if(tExactTest)
+						{
+							Vec3V center, extents;
+							childBounds.getCenterExtents(i, center, extents);
+							if(!test(center, extents))
+								continue;
+						}
+
+						if(node->isLeaf(i))
+						{
+							if(!doOverlapLeafTest<true, Test, BVHNode>(test, binaryNodes + node->getChildIndex(i), bounds, indices, visitor))
+								return false;
+						}
+						else
+						{
+							stack[stackIndex++] = node->getChildIndex(i);
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// Raycast & sweep traversal (use inflate=true for sweeps, inflate=false for raycasts). Children are tested with
+		// SOA slab tests, and pushed on the stack sorted by entry distance so that the closest one is visited first. Entries
+		// whose distance became larger than the current closest hit are skipped when popped.
+		template <const bool tInflate, typename QueryCallback>
+		class WideAABBTreeRaycast
+		{
+			struct StackEntry
+			{
+				PxU32	mChildData;
+				float	mDistance;
+			};
+
+		public:
+			bool operator()(
+				const AABBTreeBounds& treeBounds, const AABBTree& tree, const WideAABBTree& wideTree,
+				const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
+				QueryCallback& pcb)
+			{
+				const WideAABBTreeNode* PX_RESTRICT wideNodes = wideTree.getNodes();
+				if(!wideNodes)
+					return true;
+
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const BVHNode* PX_RESTRICT binaryNodes = tree.getNodes();
+				const PxU32* indices = tree.getIndices();
+
+				// Used for the primitives within leaves, as in AABBTreeRaycast
+				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+
+				// Clamp the direction away from zero to avoid infinities & NaNs in the slab test
+				const float eps = 1e-9f;
+				const PxVec3 invDir(1.0f / (unitDir.x>=0.0f ? PxMax(unitDir.x, eps) : PxMin(unitDir.x, -eps)),
+									1.0f / (unitDir.y>=0.0f ? PxMax(unitDir.y, eps) : PxMin(unitDir.y, -eps)),
+									1.0f / (unitDir.z>=0.0f ? PxMax(unitDir.z, eps) : PxMin(unitDir.z, -eps)));
+
+				const Vec4V originX = V4Load(origin.x);
+				const Vec4V originY = V4Load(origin.y);
+				const Vec4V originZ = V4Load(origin.z);
+				const Vec4V invDirX = V4Load(invDir.x);
+				const Vec4V invDirY = V4Load(invDir.y);
+				const Vec4V invDirZ = V4Load(invDir.z);
+				const Vec4V inflationX = V4Load(inflation.x);
+				const Vec4V inflationY = V4Load(inflation.y);
+				const Vec4V inflationZ = V4Load(inflation.z);
+				const Vec4V zeroV = V4Zero();
+
+				PxInlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0].mChildData = 0;
+				stack[0].mDistance = 0.0f;
+				PxU32 stackIndex = 1;
+
+				WideNodeBounds childBounds;
+				PX_ALIGN(16, float distances[GU_WIDE_AABBTREE_WIDTH]);
+				while(stackIndex > 0)
+				{
+					const StackEntry entry = stack[--stackIndex];
+					if(entry.mDistance > maxDist)
+						continue;
+
+					if(entry.mChildData & 1)
+					{
+						if(!doLeafTest<tInflate, true, BVHNode>(binaryNodes + (entry.mChildData>>1), test, bounds, indices, maxDist, pcb))
+							return false;
+						continue;
+					}
+
+					const WideAABBTreeNode* PX_RESTRICT node = wideNodes + (entry.mChildData>>1);
+					const WideNodeFrame frame(node);
+					const Vec4V maxDistV = V4Load(maxDist);
+
+					PxU32 code = 0;
+					for(PxU32 j=0;j<2;j++)
+					{
+						childBounds.decode(node, frame, j*4);
+
+						Vec4V minX = childBounds.mMinX[j], minY = childBounds.mMinY[j], minZ = childBounds.mMinZ[j];
+						Vec4V maxX = childBounds.mMaxX[j], maxY = childBounds.mMaxY[j], maxZ = childBounds.mMaxZ[j];
+						if(tInflate)
+						{
+							minX = V4Sub(minX, inflationX);	maxX = V4Add(maxX, inflationX);
+							minY = V4Sub(minY, inflationY);	maxY = V4Add(maxY, inflationY);
+							minZ = V4Sub(minZ, inflationZ);	maxZ = V4Add(maxZ, inflationZ);
+						}
+
+						const Vec4V t0X = V4Mul(V4Sub(minX, originX), invDirX);
+						const Vec4V t1X = V4Mul(V4Sub(maxX, originX), invDirX);
+						const Vec4V t0Y = V4Mul(V4Sub(minY, originY), invDirY);
+						const Vec4V t1Y = V4Mul(V4Sub(maxY, originY), invDirY);
+						const Vec4V t0Z = V4Mul(V4Sub(minZ, originZ), invDirZ);
+						const Vec4V t1Z = V4Mul(V4Sub(maxZ, originZ), invDirZ);
+
+						const Vec4V tNear = V4Max(V4Max(V4Min(t0X, t1X), V4Min(t0Y, t1Y)), V4Min(t0Z, t1Z));
+						const Vec4V tFar = V4Min(V4Min(V4Max(t0X, t1X), V4Max(t0Y, t1Y)), V4Max(t0Z, t1Z));
+
+						const BoolV hit = BAnd(BAnd(V4IsGrtrOrEq(tFar, tNear), V4IsGrtrOrEq(tFar, zeroV)), V4IsGrtrOrEq(maxDistV, tNear));
+						code |= BGetBitMask(hit)<<(j*4);
+
+						V4StoreA(tNear, distances + j*4);
+					}
+					code &= node->mChildMask;
+					if(!code)
+						continue;
+
+					// Gather & sort the hit children by decreasing distance, then push them in that order
+					StackEntry hits[GU_WIDE_AABBTREE_WIDTH];
+					PxU32 nbHits = 0;
+					while(code)
+					{
+						const PxU32 i = PxLowestSetBit(code);
+						code &= code - 1;
+
+						StackEntry hit;
+						hit.mChildData = node->mChildData[i];
+						hit.mDistance = distances[i];
+
+						PxU32 k = nbHits++;
+						while(k && hits[k-1].mDistance < hit.mDistance)
+						{
+							hits[k] = hits[k-1];
+							k--;
+						}
+						hits[k] = hit;
+					}
+
+					if(stackIndex + nbHits >= stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+
+					for(PxU32 i=0;i<nbHits;i++)
+						stack[stackIndex++] = hits[i];
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#endif
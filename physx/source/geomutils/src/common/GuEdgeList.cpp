@@ -33,6 +33,7 @@
 #include "foundation/PxPlane.h"
 #include "CmRadixSort.h"
 #include "CmSerialize.h"
+#include "task/PxParallelFor.h"
 
 // PT: code archeology: this initially came from ICE (IceEdgeList.h/cpp). Consider putting it back the way it was initially.
 // It makes little sense that something like EdgeList is in GeomUtils but some equivalent class like Adjacencies in is Cooking.
@@ -45,6 +46,8 @@ using namespace Cm;
 
 PX_IMPLEMENT_OUTPUT_ERROR
 
+#define EDGE_LIST_CHUNK_SIZE	4096
+
 ///////////////////////////////////////////////////////////////////////////////
 
 EdgeList::EdgeList() :
@@ -111,7 +114,7 @@ bool EdgeList::init(const EDGELISTCREATE& create)
 		return false;
 
 	// Create active edges
-	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon))
+	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon, create.Dispatcher))
 		return false;
 
 	// Get rid of useless data
@@ -293,81 +296,192 @@ static PX_INLINE PxU32 OppositeVertex(PxU32 r0, PxU32 r1, PxU32 r2, PxU32 vref0,
 	return PX_INVALID_U32;
 }
 
-bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon)
+// Returns true if the edge is active. Edges are independent so this can be called from multiple threads.
+static bool isActiveEdge(const EdgeDescData& ED, const EdgeData& Edge, const PxU32* FBE, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon)
 {
-	if(!verts || (!dfaces && !wfaces))
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "EdgeList::ComputeActiveEdges: NULL parameter!");
+	// Get number of triangles sharing current edge
+	const PxU32 Count = ED.Count;
+	// Boundary edges are active => keep them (actually they're silhouette edges directly)
+	// Internal edges can be active => test them
+	// Singular edges ? => discard them
+	bool Active = false;
+	if(Count==1)
+	{
+		Active = true;
+	}
+	else if(Count==2)
+	{
+		const PxU32 FaceIndex0 = FBE[ED.Offset+0]*3;
+		const PxU32 FaceIndex1 = FBE[ED.Offset+1]*3;
 
-	PxU32 NbEdges = getNbEdges();
-	if(!NbEdges)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edges in edge list!");
+		PxU32 VRef00, VRef01, VRef02;
+		PxU32 VRef10, VRef11, VRef12;
 
-	const EdgeData* Edges = getEdges();
-	if(!Edges)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge data in edge list!");
+		if(dfaces)
+		{
+			VRef00 = dfaces[FaceIndex0+0];
+			VRef01 = dfaces[FaceIndex0+1];
+			VRef02 = dfaces[FaceIndex0+2];
+			VRef10 = dfaces[FaceIndex1+0];
+			VRef11 = dfaces[FaceIndex1+1];
+			VRef12 = dfaces[FaceIndex1+2];
+		}
+		else //if(wfaces)
+		{
+			PX_ASSERT(wfaces);
+			VRef00 = wfaces[FaceIndex0+0];
+			VRef01 = wfaces[FaceIndex0+1];
+			VRef02 = wfaces[FaceIndex0+2];
+			VRef10 = wfaces[FaceIndex1+0];
+			VRef11 = wfaces[FaceIndex1+1];
+			VRef12 = wfaces[FaceIndex1+2];
+		}
 
-	const EdgeDescData* ED = getEdgeToTriangles();
-	if(!ED)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge-to-triangle in edge list!");
+		{
+			// We first check the opposite vertex against the plane
 
-	const PxU32* FBE = getFacesByEdges();
-	if(!FBE)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no faces-by-edges in edge list!");
+			const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edge.Ref0, Edge.Ref1);
 
-	// We first create active edges in a temporaray buffer. We have one bool / edge.
-	bool* ActiveEdges = PX_ALLOCATE(bool, NbEdges, "bool");
+			const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
 
-	// Loop through edges and look for convex ones
-	bool* CurrentMark = ActiveEdges;
+			if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+			{
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+				const float a = PxComputeAngle(N0, N1);
+
+				if(fabsf(a)>epsilon)
+					Active = true;
+			}
+			else
+			{
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+
+				if(N0.dot(N1) < -0.999f)
+					Active = true;
+			}
+//Active = true;
+		}
 
-	while(NbEdges--)
+	}
+	else
 	{
-		// Get number of triangles sharing current edge
-		const PxU32 Count = ED->Count;
-		// Boundary edges are active => keep them (actually they're silhouette edges directly)
-		// Internal edges can be active => test them
-		// Singular edges ? => discard them
-		bool Active = false;
-		if(Count==1)
+		//Connected to more than 2 
+		//We need to loop through the triangles and count the number of unique triangles (considering back-face triangles as non-unique). If we end up with more than 2 unique triangles,
+		//then by definition this is an inactive edge. However, if we end up with 2 unique triangles (say like a double-sided tesselated surface), then it depends on the same rules as above
+
+		const PxU32 FaceInd0 = FBE[ED.Offset]*3;
+		PxU32 VRef00, VRef01, VRef02;
+		PxU32 VRef10=0, VRef11=0, VRef12=0;
+		if(dfaces)
 		{
-			Active = true;
+			VRef00 = dfaces[FaceInd0+0];
+			VRef01 = dfaces[FaceInd0+1];
+			VRef02 = dfaces[FaceInd0+2];
 		}
-		else if(Count==2)
+		else //if(wfaces)
 		{
-			const PxU32 FaceIndex0 = FBE[ED->Offset+0]*3;
-			const PxU32 FaceIndex1 = FBE[ED->Offset+1]*3;
+			PX_ASSERT(wfaces);
+			VRef00 = wfaces[FaceInd0+0];
+			VRef01 = wfaces[FaceInd0+1];
+			VRef02 = wfaces[FaceInd0+2];
+		}
+
+		PxU32 numUniqueTriangles = 1;
+		bool doubleSided0 = false;
+		bool doubleSided1 = 0;
 
-			PxU32 VRef00, VRef01, VRef02;
-			PxU32 VRef10, VRef11, VRef12;
+		for(PxU32 a = 1; a < Count; ++a)
+		{
+			const PxU32 FaceInd = FBE[ED.Offset+a]*3;
 
+			PxU32 VRef0, VRef1, VRef2;
 			if(dfaces)
 			{
-				VRef00 = dfaces[FaceIndex0+0];
-				VRef01 = dfaces[FaceIndex0+1];
-				VRef02 = dfaces[FaceIndex0+2];
-				VRef10 = dfaces[FaceIndex1+0];
-				VRef11 = dfaces[FaceIndex1+1];
-				VRef12 = dfaces[FaceIndex1+2];
+				VRef0 = dfaces[FaceInd+0];
+				VRef1 = dfaces[FaceInd+1];
+				VRef2 = dfaces[FaceInd+2];
 			}
 			else //if(wfaces)
 			{
 				PX_ASSERT(wfaces);
-				VRef00 = wfaces[FaceIndex0+0];
-				VRef01 = wfaces[FaceIndex0+1];
-				VRef02 = wfaces[FaceIndex0+2];
-				VRef10 = wfaces[FaceIndex1+0];
-				VRef11 = wfaces[FaceIndex1+1];
-				VRef12 = wfaces[FaceIndex1+2];
+				VRef0 = wfaces[FaceInd+0];
+				VRef1 = wfaces[FaceInd+1];
+				VRef2 = wfaces[FaceInd+2];
 			}
 
+			if(((VRef0 != VRef00) && (VRef0 != VRef01) && (VRef0 != VRef02)) || 
+				((VRef1 != VRef00) && (VRef1 != VRef01) && (VRef1 != VRef02)) || 
+				((VRef2 != VRef00) && (VRef2 != VRef01) && (VRef2 != VRef02)))
 			{
-				// We first check the opposite vertex against the plane
+				//Not the same as trig 0
+				if(numUniqueTriangles == 2)
+				{
+					if(((VRef0 != VRef10) && (VRef0 != VRef11) && (VRef0 != VRef12)) || 
+						((VRef1 != VRef10) && (VRef1 != VRef11) && (VRef1 != VRef12)) || 
+						((VRef2 != VRef10) && (VRef2 != VRef11) && (VRef2 != VRef12)))
+					{
+						//Too many unique triangles - terminate and mark as inactive
+						numUniqueTriangles++;
+						break;
+					}
+					else
+					{
+						const PxTriangle T0(verts[VRef10], verts[VRef11], verts[VRef12]);
+						const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
+						PxVec3 N0, N1;
+						T0.normal(N0);
+						T1.normal(N1);
+
+						if(N0.dot(N1) < -0.999f)
+							doubleSided1 = true;
+					}
+				}
+				else
+				{
+					VRef10 = VRef0;
+					VRef11 = VRef1;
+					VRef12 = VRef2;
+					numUniqueTriangles++;
+				}
+			}
+			else
+			{
+				//Check for double sided...
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+
+				if(N0.dot(N1) < -0.999f)
+					doubleSided0 = true;
+			}
+		}
 
-				const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edges->Ref0, Edges->Ref1);
+		if(numUniqueTriangles == 1)
+			Active = true;
+		if(numUniqueTriangles == 2)
+		{
+			//Potentially active. Let's check the angles between the surfaces...
 
+			if(doubleSided0 || doubleSided1)
+			{
+			
+	//			Plane PL1 = faces[FBE[ED.Offset+1]].PlaneEquation(verts);
 				const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
 
-				if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
+				//if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+				//KS - can't test signed distance for concave edges. This is a double-sided poly
 				{
 					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
 					const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
@@ -377,184 +491,109 @@ bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU
 					T1.normal(N1);
 					const float a = PxComputeAngle(N0, N1);
 
-					if(fabsf(a)>epsilon)
+					if(fabsf(a)>epsilon)	
 						Active = true;
 				}
-				else
+			}
+			else
+			{
+				
+				//Not double sided...must have had a bunch of duplicate triangles!!!!
+				//Treat as normal
+				const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edge.Ref0, Edge.Ref1);
+
+	//			Plane PL1 = faces[FBE[ED.Offset+1]].PlaneEquation(verts);
+				const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
+//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
+				if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
 				{
 					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
 					const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
 					PxVec3 N0, N1;
 					T0.normal(N0);
 					T1.normal(N1);
+					const float a = PxComputeAngle(N0, N1);
 
-					if(N0.dot(N1) < -0.999f)
+					if(fabsf(a)>epsilon)	
 						Active = true;
 				}
-//Active = true;
 			}
-
 		}
 		else
 		{
-			//Connected to more than 2 
-			//We need to loop through the triangles and count the number of unique triangles (considering back-face triangles as non-unique). If we end up with more than 2 unique triangles,
-			//then by definition this is an inactive edge. However, if we end up with 2 unique triangles (say like a double-sided tesselated surface), then it depends on the same rules as above
-
-			const PxU32 FaceInd0 = FBE[ED->Offset]*3;
-			PxU32 VRef00, VRef01, VRef02;
-			PxU32 VRef10=0, VRef11=0, VRef12=0;
-			if(dfaces)
-			{
-				VRef00 = dfaces[FaceInd0+0];
-				VRef01 = dfaces[FaceInd0+1];
-				VRef02 = dfaces[FaceInd0+2];
-			}
-			else //if(wfaces)
-			{
-				PX_ASSERT(wfaces);
-				VRef00 = wfaces[FaceInd0+0];
-				VRef01 = wfaces[FaceInd0+1];
-				VRef02 = wfaces[FaceInd0+2];
-			}
-
-			PxU32 numUniqueTriangles = 1;
-			bool doubleSided0 = false;
-			bool doubleSided1 = 0;
-
-			for(PxU32 a = 1; a < Count; ++a)
-			{
-				const PxU32 FaceInd = FBE[ED->Offset+a]*3;
-
-				PxU32 VRef0, VRef1, VRef2;
-				if(dfaces)
-				{
-					VRef0 = dfaces[FaceInd+0];
-					VRef1 = dfaces[FaceInd+1];
-					VRef2 = dfaces[FaceInd+2];
-				}
-				else //if(wfaces)
-				{
-					PX_ASSERT(wfaces);
-					VRef0 = wfaces[FaceInd+0];
-					VRef1 = wfaces[FaceInd+1];
-					VRef2 = wfaces[FaceInd+2];
-				}
-
-				if(((VRef0 != VRef00) && (VRef0 != VRef01) && (VRef0 != VRef02)) || 
-					((VRef1 != VRef00) && (VRef1 != VRef01) && (VRef1 != VRef02)) || 
-					((VRef2 != VRef00) && (VRef2 != VRef01) && (VRef2 != VRef02)))
-				{
-					//Not the same as trig 0
-					if(numUniqueTriangles == 2)
-					{
-						if(((VRef0 != VRef10) && (VRef0 != VRef11) && (VRef0 != VRef12)) || 
-							((VRef1 != VRef10) && (VRef1 != VRef11) && (VRef1 != VRef12)) || 
-							((VRef2 != VRef10) && (VRef2 != VRef11) && (VRef2 != VRef12)))
-						{
-							//Too many unique triangles - terminate and mark as inactive
-							numUniqueTriangles++;
-							break;
-						}
-						else
-						{
-							const PxTriangle T0(verts[VRef10], verts[VRef11], verts[VRef12]);
-							const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
-							PxVec3 N0, N1;
-							T0.normal(N0);
-							T1.normal(N1);
-
-							if(N0.dot(N1) < -0.999f)
-								doubleSided1 = true;
-						}
-					}
-					else
-					{
-						VRef10 = VRef0;
-						VRef11 = VRef1;
-						VRef12 = VRef2;
-						numUniqueTriangles++;
-					}
-				}
-				else
-				{
-					//Check for double sided...
-					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-					const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
-					PxVec3 N0, N1;
-					T0.normal(N0);
-					T1.normal(N1);
-
-					if(N0.dot(N1) < -0.999f)
-						doubleSided0 = true;
-				}
-			}
+			//Lots of triangles all  smooshed together. Just activate the edge in this case
+			Active = true;
+		}
 
-			if(numUniqueTriangles == 1)
-				Active = true;
-			if(numUniqueTriangles == 2)
-			{
-				//Potentially active. Let's check the angles between the surfaces...
+	}
+	return Active;
+}
 
-				if(doubleSided0 || doubleSided1)
-				{
-				
-		//			Plane PL1 = faces[FBE[ED->Offset+1]].PlaneEquation(verts);
-					const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
+namespace
+{
+	class ComputeActiveEdges : public PxParallelForWork
+	{
+		public:
+		ComputeActiveEdges(PxU32 nbEdges, const EdgeDescData* ED, const EdgeData* edges, const PxU32* FBE, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, bool* activeEdges) :
+			mNbEdges(nbEdges), mED(ED), mEdges(edges), mFBE(FBE), mDFaces(dfaces), mWFaces(wfaces), mVerts(verts), mEpsilon(epsilon), mActiveEdges(activeEdges)	{}
 
-	//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
-					//if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
-					//KS - can't test signed distance for concave edges. This is a double-sided poly
-					{
-						const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-						const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * EDGE_LIST_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + EDGE_LIST_CHUNK_SIZE, mNbEdges);
+			for(PxU32 i=start;i<end;i++)
+				mActiveEdges[i] = isActiveEdge(mED[i], mEdges[i], mFBE, mDFaces, mWFaces, mVerts, mEpsilon);
+		}
 
-						PxVec3 N0, N1;
-						T0.normal(N0);
-						T1.normal(N1);
-						const float a = PxComputeAngle(N0, N1);
+		const PxU32				mNbEdges;
+		const EdgeDescData*		mED;
+		const EdgeData*			mEdges;
+		const PxU32*			mFBE;
+		const PxU32*			mDFaces;
+		const PxU16*			mWFaces;
+		const PxVec3*			mVerts;
+		const float				mEpsilon;
+		bool*					mActiveEdges;
+		PX_NOCOPY(ComputeActiveEdges)
+	};
+}
 
-						if(fabsf(a)>epsilon)	
-							Active = true;
-					}
-				}
-				else
-				{
-					
-					//Not double sided...must have had a bunch of duplicate triangles!!!!
-					//Treat as normal
-					const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edges->Ref0, Edges->Ref1);
+bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, PxCpuDispatcher* dispatcher)
+{
+	if(!verts || (!dfaces && !wfaces))
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "EdgeList::ComputeActiveEdges: NULL parameter!");
 
-		//			Plane PL1 = faces[FBE[ED->Offset+1]].PlaneEquation(verts);
-					const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
+	const PxU32 NbEdges = getNbEdges();
+	if(!NbEdges)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edges in edge list!");
 
-	//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
-					if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
-					{
-						const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-						const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+	const EdgeData* Edges = getEdges();
+	if(!Edges)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge data in edge list!");
 
-						PxVec3 N0, N1;
-						T0.normal(N0);
-						T1.normal(N1);
-						const float a = PxComputeAngle(N0, N1);
+	const EdgeDescData* ED = getEdgeToTriangles();
+	if(!ED)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge-to-triangle in edge list!");
 
-						if(fabsf(a)>epsilon)	
-							Active = true;
-					}
-				}
-			}
-			else
-			{
-				//Lots of triangles all  smooshed together. Just activate the edge in this case
-				Active = true;
-			}
+	const PxU32* FBE = getFacesByEdges();
+	if(!FBE)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no faces-by-edges in edge list!");
 
-		}
+	// We first create active edges in a temporaray buffer. We have one bool / edge.
+	bool* ActiveEdges = PX_ALLOCATE(bool, NbEdges, "bool");
 
-		*CurrentMark++ = Active;
-		ED++;
-		Edges++;
+	// Loop through edges and look for convex ones
+	if(dispatcher)
+	{
+		ComputeActiveEdges work(NbEdges, ED, Edges, FBE, dfaces, wfaces, verts, epsilon, ActiveEdges);
+		PxParallelFor(dispatcher, work, PxParallelForGetNbChunks(NbEdges, EDGE_LIST_CHUNK_SIZE));
+	}
+	else
+	{
+		for(PxU32 i=0;i<NbEdges;i++)
+			ActiveEdges[i] = isActiveEdge(ED[i], Edges[i], FBE, dfaces, wfaces, verts, epsilon);
 	}
 
 	// Now copy bits back into already existing edge structures
@@ -37,6 +37,8 @@
 
 namespace physx
 {
+class PxCpuDispatcher;
+
 namespace Gu
 {
 	enum EdgeType
@@ -118,7 +120,8 @@ namespace Gu
 						FacesToEdges	(false),
 						EdgesToFaces	(false),
 						Verts			(NULL),
-						Epsilon			(0.1f)
+						Epsilon			(0.1f),
+						Dispatcher		(NULL)
 						{}
 				
 		PxU32			NbFaces;	//!< Number of faces in source topo
@@ -129,6 +132,7 @@ namespace Gu
 		bool			EdgesToFaces;
 		const PxVec3*	Verts;
 		float			Epsilon;
+		PxCpuDispatcher*	Dispatcher;	//!< Optional dispatcher used to compute active edges in parallel, or NULL
 	};
 
 	class EdgeList : public PxUserAllocated
@@ -167,7 +171,7 @@ namespace Gu
 
 						bool					createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces);
 						bool					createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces);
-						bool					computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon);
+						bool					computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, PxCpuDispatcher* dispatcher);
 	};
 
 } // namespace Gu
@@ -31,6 +31,7 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxBitUtils.h"
 #include "GuMeshCleaner.h"
+#include "task/PxParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -70,8 +71,48 @@ static PX_FORCE_INLINE PxU32 getHashValue(const Indices& v)
 	return c;
 }
 
-MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit)
+static PX_FORCE_INLINE PxVec3 snapToGrid(const PxVec3& v, PxF32 weldTolerance)
 {
+	return PxVec3(	PxFloor(v.x*weldTolerance + 0.5f),
+					PxFloor(v.y*weldTolerance + 0.5f),
+					PxFloor(v.z*weldTolerance + 0.5f));
+}
+
+// Returns false if the triangle should be discarded, else returns its remapped vertex references
+static PX_FORCE_INLINE bool remapTriangle(const PxU32* srcIndices, const PxVec3* srcVerts, PxU32 nbVerts, const PxU32* remapVerts, PxF32 limit, PxU32& vref0, PxU32& vref1, PxU32& vref2)
+{
+	vref0 = srcIndices[0];
+	vref1 = srcIndices[1];
+	vref2 = srcIndices[2];
+	if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
+		return false;
+
+	// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
+	const PxVec3& p0 = srcVerts[vref0];
+	const PxVec3& p1 = srcVerts[vref1];
+	const PxVec3& p2 = srcVerts[vref2];
+
+	const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
+	if(area2<=limit)
+		return false;
+
+	vref0 = remapVerts[vref0];
+	vref1 = remapVerts[vref1];
+	vref2 = remapVerts[vref2];
+	if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+		return false;
+
+	return true;
+}
+
+MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher)
+{
+	if(dispatcher)
+	{
+		initParallel(nbVerts, srcVerts, nbTris, srcIndices, meshWeldTolerance, areaLimit, dispatcher);
+		return;
+	}
+
 	PxVec3* cleanVerts = PX_ALLOCATE(PxVec3, nbVerts, "MeshCleaner");
 	PX_ASSERT(cleanVerts);
 
@@ -88,9 +129,7 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 		for(PxU32 i=0; i<nbVerts; i++)
 		{
 			vertexIndices[i] = i;
-			cleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
+			cleanVerts[i] = snapToGrid(srcVerts[i], weldTolerance);
 		}
 	}
 	else
@@ -150,25 +189,8 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	PxU32 nbCleanedTris = 0;
 	for(PxU32 i=0;i<nbTris;i++)
 	{
-		PxU32 vref0 = *srcIndices++;
-		PxU32 vref1 = *srcIndices++;
-		PxU32 vref2 = *srcIndices++;
-		if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
-			continue;
-
-		// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
-		const PxVec3& p0 = srcVerts[vref0];
-		const PxVec3& p1 = srcVerts[vref1];
-		const PxVec3& p2 = srcVerts[vref2];
-
-		const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
-		if(area2<=limit)
-			continue;
-
-		vref0 = remapVerts[vref0];
-		vref1 = remapVerts[vref1];
-		vref2 = remapVerts[vref2];
-		if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+		PxU32 vref0, vref1, vref2;
+		if(!remapTriangle(srcIndices + i*3, srcVerts, nbVerts, remapVerts, limit, vref0, vref1, vref2))
 			continue;
 
 		indices[nbCleanedTris*3+0] = vref0;
@@ -229,6 +251,370 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Parallel cleaning
+//
+// This produces exactly the same results as the single-threaded code above. Per-vertex and per-triangle work is done
+// in fixed-size chunks. Duplicate vertices and triangles are found by distributing the elements to shards according to
+// the same masked hash value as the sequential hash table, and by processing each shard in increasing element order.
+// Each element then knows the first element it is a duplicate of, and a final sequential pass assigns the new indices.
+#define MESH_CLEANER_CHUNK_SIZE		16384
+#define MESH_CLEANER_NB_SHARDS		64
+
+namespace
+{
+	struct VertexKey
+	{
+		PX_FORCE_INLINE	VertexKey(const PxVec3* verts) : mVerts(verts)	{}
+		PX_FORCE_INLINE	PxU32	getHashValue(PxU32 i)		const	{ return ::getHashValue(mVerts[i]);	}
+		PX_FORCE_INLINE	bool	equal(PxU32 i, PxU32 j)		const	{ return !(mVerts[i]!=mVerts[j]);	}
+		const PxVec3*	mVerts;
+	};
+
+	struct TriangleKey
+	{
+		PX_FORCE_INLINE	TriangleKey(const Indices* tris) : mTris(tris)	{}
+		PX_FORCE_INLINE	PxU32	getHashValue(PxU32 i)		const	{ return ::getHashValue(mTris[i]);	}
+		PX_FORCE_INLINE	bool	equal(PxU32 i, PxU32 j)		const	{ return !(mTris[i]!=mTris[j]);		}
+		const Indices*	mTris;
+	};
+
+	// Computes the masked hash value of each element
+	template<class Key>
+	class HashElements : public PxParallelForWork
+	{
+		public:
+		HashElements(const Key& key, PxU32 nb, PxU32 hashMask, PxU32* hashValues) : mKey(key), mNb(nb), mHashMask(hashMask), mHashValues(hashValues)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * MESH_CLEANER_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + MESH_CLEANER_CHUNK_SIZE, mNb);
+			for(PxU32 i=start;i<end;i++)
+				mHashValues[i] = mKey.getHashValue(i) & mHashMask;
+		}
+
+		const Key&	mKey;
+		const PxU32	mNb;
+		const PxU32	mHashMask;
+		PxU32*		mHashValues;
+		PX_NOCOPY(HashElements)
+	};
+
+	template<class Key>
+	class FindDuplicates : public PxParallelForWork
+	{
+		public:
+		FindDuplicates(const Key& key, const PxU32* hashValues, const PxU32* sorted, const PxU32* shardOffsets, PxU32* firstOccurrence) :
+			mKey(key), mHashValues(hashValues), mSorted(sorted), mShardOffsets(shardOffsets), mFirstOccurrence(firstOccurrence)	{}
+
+		virtual	void	process(PxU32 shard)	PX_OVERRIDE
+		{
+			const PxU32* elements = mSorted + mShardOffsets[shard];
+			const PxU32 nb = mShardOffsets[shard+1] - mShardOffsets[shard];
+			if(!nb)
+				return;
+
+			// Local hash table, indexed with the bits of the hash value not used to select the shard
+			const PxU32 hashSize = PxNextPowerOfTwo(nb);
+			const PxU32 hashMask = hashSize - 1;
+			PxU32* hashTable = PX_ALLOCATE(PxU32, (hashSize + nb), "MeshCleaner");
+			PxMemSet(hashTable, 0xff, hashSize * sizeof(PxU32));
+			PxU32* const next = hashTable + hashSize;
+
+			for(PxU32 k=0;k<nb;k++)
+			{
+				const PxU32 i = elements[k];
+				const PxU32 hashValue = mHashValues[i];
+				const PxU32 bucket = (hashValue / MESH_CLEANER_NB_SHARDS) & hashMask;
+
+				// Same test as the sequential version: same masked hash value and same value
+				PxU32 offset = hashTable[bucket];
+				while(offset!=0xffffffff && (mHashValues[elements[offset]]!=hashValue || !mKey.equal(elements[offset], i)))
+					offset = next[offset];
+
+				if(offset==0xffffffff)
+				{
+					mFirstOccurrence[i] = i;
+					next[k] = hashTable[bucket];
+					hashTable[bucket] = k;
+				}
+				else
+					mFirstOccurrence[i] = elements[offset];
+			}
+			PX_FREE(hashTable);
+		}
+
+		const Key&		mKey;
+		const PxU32*	mHashValues;
+		const PxU32*	mSorted;
+		const PxU32*	mShardOffsets;
+		PxU32*			mFirstOccurrence;
+		PX_NOCOPY(FindDuplicates)
+	};
+
+	class SnapVertices : public PxParallelForWork
+	{
+		public:
+		SnapVertices(PxU32 nbVerts, const PxVec3* srcVerts, PxVec3* cleanVerts, PxF32 weldTolerance) :
+			mNbVerts(nbVerts), mSrcVerts(srcVerts), mCleanVerts(cleanVerts), mWeldTolerance(weldTolerance)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * MESH_CLEANER_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + MESH_CLEANER_CHUNK_SIZE, mNbVerts);
+			for(PxU32 i=start;i<end;i++)
+				mCleanVerts[i] = snapToGrid(mSrcVerts[i], mWeldTolerance);
+		}
+
+		const PxU32		mNbVerts;
+		const PxVec3*	mSrcVerts;
+		PxVec3*			mCleanVerts;
+		const PxF32		mWeldTolerance;
+		PX_NOCOPY(SnapVertices)
+	};
+
+	// First pass writes the remapped triangles to a temp buffer and counts them, second pass compacts them
+	class RemapTriangles : public PxParallelForWork
+	{
+		public:
+		RemapTriangles(PxU32 nbTris, const PxU32* srcIndices, const PxVec3* srcVerts, PxU32 nbVerts, const PxU32* remapVerts, PxF32 limit, PxU32* tmpIndices, PxU32* chunkCounts) :
+			mNbTris(nbTris), mSrcIndices(srcIndices), mSrcVerts(srcVerts), mNbVerts(nbVerts), mRemapVerts(remapVerts), mLimit(limit), mTmpIndices(tmpIndices), mChunkCounts(chunkCounts),
+			mIndices(NULL), mRemapTriangles(NULL), mCompact(false)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * MESH_CLEANER_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + MESH_CLEANER_CHUNK_SIZE, mNbTris);
+			PxU32* tmp = mTmpIndices + start*3;
+			if(!mCompact)
+			{
+				PxU32 nb = 0;
+				for(PxU32 i=start;i<end;i++)
+				{
+					PxU32 vref0, vref1, vref2;
+					if(!remapTriangle(mSrcIndices + i*3, mSrcVerts, mNbVerts, mRemapVerts, mLimit, vref0, vref1, vref2))
+						vref0 = vref1 = vref2 = 0xffffffff;
+					else
+						nb++;
+					*tmp++ = vref0;
+					*tmp++ = vref1;
+					*tmp++ = vref2;
+				}
+				mChunkCounts[index] = nb;
+			}
+			else
+			{
+				PxU32 offset = mChunkCounts[index];
+				for(PxU32 i=start;i<end;i++)
+				{
+					if(tmp[0]!=0xffffffff)
+					{
+						mIndices[offset*3+0] = tmp[0];
+						mIndices[offset*3+1] = tmp[1];
+						mIndices[offset*3+2] = tmp[2];
+						mRemapTriangles[offset] = i;
+						offset++;
+					}
+					tmp += 3;
+				}
+			}
+		}
+
+		const PxU32		mNbTris;
+		const PxU32*	mSrcIndices;
+		const PxVec3*	mSrcVerts;
+		const PxU32		mNbVerts;
+		const PxU32*	mRemapVerts;
+		const PxF32		mLimit;
+		PxU32*			mTmpIndices;
+		PxU32*			mChunkCounts;
+		PxU32*			mIndices;
+		PxU32*			mRemapTriangles;
+		bool			mCompact;
+		PX_NOCOPY(RemapTriangles)
+	};
+}
+
+// Sets firstOccurrence[i] to the index of the first element equal to element i, for elements whose firstOccurrence
+// is not 0xffffffff on entry. Two elements are equal if they have the same masked hash value and the same value.
+template<class Key>
+static void findFirstOccurrences(PxCpuDispatcher* dispatcher, const Key& key, PxU32 nb, PxU32 hashMask, PxU32* firstOccurrence)
+{
+	PxU32* hashValues = PX_ALLOCATE(PxU32, nb, "MeshCleaner");
+	PxU32* sorted = PX_ALLOCATE(PxU32, nb, "MeshCleaner");
+	{
+		HashElements<Key> work(key, nb, hashMask, hashValues);
+		PxParallelFor(dispatcher, work, PxParallelForGetNbChunks(nb, MESH_CLEANER_CHUNK_SIZE));
+	}
+
+	// Counting sort by shard. Elements stay sorted by index within each shard.
+	PxU32 shardOffsets[MESH_CLEANER_NB_SHARDS+1];
+	PxMemZero(shardOffsets, sizeof(shardOffsets));
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(firstOccurrence[i]!=0xffffffff)
+			shardOffsets[(hashValues[i] & (MESH_CLEANER_NB_SHARDS-1))+1]++;
+	}
+	for(PxU32 i=0;i<MESH_CLEANER_NB_SHARDS;i++)
+		shardOffsets[i+1] += shardOffsets[i];
+	{
+		PxU32 offsets[MESH_CLEANER_NB_SHARDS];
+		PxMemCopy(offsets, shardOffsets, sizeof(offsets));
+		for(PxU32 i=0;i<nb;i++)
+		{
+			if(firstOccurrence[i]!=0xffffffff)
+				sorted[offsets[hashValues[i] & (MESH_CLEANER_NB_SHARDS-1)]++] = i;
+		}
+	}
+
+	{
+		FindDuplicates<Key> work(key, hashValues, sorted, shardOffsets, firstOccurrence);
+		PxParallelFor(dispatcher, work, MESH_CLEANER_NB_SHARDS);
+	}
+
+	PX_FREE(sorted);
+	PX_FREE(hashValues);
+}
+
+void MeshCleaner::initParallel(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher)
+{
+	PxVec3* cleanVerts = PX_ALLOCATE(PxVec3, nbVerts, "MeshCleaner");
+	PX_ASSERT(cleanVerts);
+
+	PxU32* indices = PX_ALLOCATE(PxU32, (nbTris*3), "MeshCleaner");
+
+	PxU32* remapTriangles = PX_ALLOCATE(PxU32, nbTris, "MeshCleaner");
+
+	if(meshWeldTolerance!=0.0f)
+	{
+		SnapVertices work(nbVerts, srcVerts, cleanVerts, 1.0f / meshWeldTolerance);
+		PxParallelFor(dispatcher, work, PxParallelForGetNbChunks(nbVerts, MESH_CLEANER_CHUNK_SIZE));
+	}
+	else
+	{
+		PxMemCopy(cleanVerts, srcVerts, nbVerts*sizeof(PxVec3));
+	}
+
+	// Same table size as the sequential version, since it defines which elements are considered equal
+	const PxU32 maxNbElems = PxMax(nbTris, nbVerts);
+	const PxU32 hashMask = PxNextPowerOfTwo(maxNbElems) - 1;
+
+	PxU32* remapVerts = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
+	PxMemSet(remapVerts, 0xff, nbVerts * sizeof(PxU32));
+
+	for(PxU32 i=0;i<nbTris*3;i++)
+	{
+		const PxU32 vref = srcIndices[i];
+		if(vref<nbVerts)
+			remapVerts[vref] = 0;
+	}
+
+	PxU32 nbCleanedVerts = 0;
+	{
+		PxU32* firstOccurrence = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
+		PxMemCopy(firstOccurrence, remapVerts, nbVerts*sizeof(PxU32));
+		findFirstOccurrences(dispatcher, VertexKey(cleanVerts), nbVerts, hashMask, firstOccurrence);
+
+		// vertexIndices[i] is the source index of cleaned vertex i. We reuse the firstOccurrence buffer for it.
+		PxU32* vertexIndices = firstOccurrence;
+		for(PxU32 i=0;i<nbVerts;i++)
+		{
+			if(remapVerts[i]==0xffffffff)
+				continue;
+
+			const PxU32 first = firstOccurrence[i];
+			if(first==i)
+			{
+				remapVerts[i] = nbCleanedVerts;
+				vertexIndices[nbCleanedVerts++] = i;
+			}
+			else
+			{
+				PX_ASSERT(first<i);
+				remapVerts[i] = remapVerts[first];
+			}
+		}
+
+		// With welding the sequential version keeps the snapped vertices during cleaning, and copies the original ones in the end
+		const PxVec3* src = meshWeldTolerance!=0.0f ? srcVerts : cleanVerts;
+		for(PxU32 i=0;i<nbCleanedVerts;i++)
+			cleanVerts[i] = src[vertexIndices[i]];
+
+		PX_FREE(firstOccurrence);
+	}
+
+	// PT: area = ((p0 - p1).cross(p0 - p2)).magnitude() * 0.5
+	// area < areaLimit
+	// <=> ((p0 - p1).cross(p0 - p2)).magnitude() < areaLimit * 2.0
+	// <=> ((p0 - p1).cross(p0 - p2)).magnitudeSquared() < (areaLimit * 2.0)^2
+	const PxF32 limit = areaLimit * areaLimit * 4.0f;
+
+	PxU32 nbToGo = 0;
+	{
+		const PxU32 nbChunks = PxParallelForGetNbChunks(nbTris, MESH_CLEANER_CHUNK_SIZE);
+		PxU32* tmpIndices = PX_ALLOCATE(PxU32, nbTris*3, "MeshCleaner");
+		PxU32* chunkCounts = PX_ALLOCATE(PxU32, nbChunks, "MeshCleaner");
+
+		RemapTriangles work(nbTris, srcIndices, srcVerts, nbVerts, remapVerts, limit, tmpIndices, chunkCounts);
+		PxParallelFor(dispatcher, work, nbChunks);
+
+		for(PxU32 i=0;i<nbChunks;i++)
+		{
+			const PxU32 nb = chunkCounts[i];
+			chunkCounts[i] = nbToGo;
+			nbToGo += nb;
+		}
+
+		work.mIndices = indices;
+		work.mRemapTriangles = remapTriangles;
+		work.mCompact = true;
+		PxParallelFor(dispatcher, work, nbChunks);
+
+		PX_FREE(chunkCounts);
+		PX_FREE(tmpIndices);
+	}
+	PX_FREE(remapVerts);
+
+	Indices* const I = reinterpret_cast<Indices*>(indices);
+	PxU32 nbCleanedTris = 0;
+	bool idtRemap = true;
+	{
+		PxU32* firstOccurrence = PX_ALLOCATE(PxU32, nbToGo, "MeshCleaner");
+		PxMemZero(firstOccurrence, nbToGo*sizeof(PxU32));
+		findFirstOccurrences(dispatcher, TriangleKey(I), nbToGo, hashMask, firstOccurrence);
+
+		for(PxU32 i=0;i<nbToGo;i++)
+		{
+			if(firstOccurrence[i]==i)
+			{
+				const PxU32 originalIndex = remapTriangles[i];
+				PX_ASSERT(nbCleanedTris<=i);
+				remapTriangles[nbCleanedTris] = originalIndex;
+				if(originalIndex!=nbCleanedTris)
+					idtRemap = false;
+				I[nbCleanedTris++] = I[i];
+			}
+		}
+		PX_FREE(firstOccurrence);
+	}
+
+	mNbVerts	= nbCleanedVerts;
+	mNbTris		= nbCleanedTris;
+	mVerts		= cleanVerts;
+	mIndices	= indices;
+	if(idtRemap)
+	{
+		PX_FREE(remapTriangles);
+		mRemap	= NULL;
+	}
+	else
+	{
+		mRemap	= remapTriangles;
+	}
+}
+
 MeshCleaner::~MeshCleaner()
 {
 	PX_FREE(mRemap);
@@ -33,12 +33,15 @@
 
 namespace physx
 {
+class PxCpuDispatcher;
+
 namespace Gu
 {
 	class MeshCleaner
 	{
 		public:
-			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxF32 areaLimit);
+			// If a dispatcher is provided the work is split into tasks. The results are the same as without it.
+			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher=NULL);
 			~MeshCleaner();
 
 			PxU32	mNbVerts;
@@ -46,6 +49,8 @@ namespace Gu
 			PxVec3*	mVerts;
 			PxU32*	mIndices;
 			PxU32*	mRemap;
+		private:
+			void	initParallel(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher);
 	};
 }
 }
@@ -0,0 +1,427 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "GuCooking.h"
+#include "task/PxParallelFor.h"
+#include "cooking/PxCookingCache.h"
+#include "geometry/PxConvexMesh.h"
+#include "foundation/PxIO.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxPhysicsVersion.h"
+
+using namespace physx;
+
+// Bump this when the hashed data or the layout of the cached blobs changes
+#define COOKING_CACHE_FORMAT_VERSION	2
+
+#define INVALID_INDEX	0xffffffff
+
+namespace
+{
+	// 128-bit hash computed as two independent 64-bit lanes: FNV-1a on 64-bit words, and a multiply-rotate lane.
+	// Deterministic across platforms for the same sequence of calls, which is all the cache needs.
+	class CacheKeyHasher
+	{
+		public:
+		CacheKeyHasher() : mLane0(0xcbf29ce484222325ULL), mLane1(0x9e3779b97f4a7c15ULL), mLength(0)	{}
+
+		PX_FORCE_INLINE	void	addWord(PxU64 w)
+		{
+			mLane0 = (mLane0 ^ w) * 0x100000001b3ULL;
+			mLane1 += w * 0xc2b2ae3d27d4eb4fULL;
+			mLane1 = ((mLane1 << 31) | (mLane1 >> 33)) * 0x9e3779b97f4a7c15ULL;
+		}
+
+		void	add(const void* data, PxU32 size)
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			mLength += size;
+			while(size>=8)
+			{
+				PxU64 w;
+				PxMemCopy(&w, bytes, 8);
+				addWord(w);
+				bytes += 8;
+				size -= 8;
+			}
+			if(size)
+			{
+				PxU64 w = 0;
+				PxMemCopy(&w, bytes, size);
+				addWord(w);
+			}
+		}
+
+		template<class T>
+		PX_FORCE_INLINE	void	add(const T& value)	{ add(&value, sizeof(T));	}
+
+		// Adds nb elements of elemSize bytes from strided data. Elements are always hashed one by one, so that the key
+		// only depends on the elements and not on the stride.
+		void	addStrided(const void* data, PxU32 nb, PxU32 elemSize, PxU32 stride)
+		{
+			add(nb);
+			if(!data)
+				return;
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			while(nb--)
+			{
+				add(bytes, elemSize);
+				bytes += stride;
+			}
+		}
+
+		PxCookingCacheKey	getKey()	const
+		{
+			PxCookingCacheKey key;
+			key.hash[0] = fmix(mLane0 ^ mLength);
+			key.hash[1] = fmix(mLane1 + mLength);
+			return key;
+		}
+
+		private:
+		static PX_FORCE_INLINE	PxU64	fmix(PxU64 k)
+		{
+			k ^= k >> 33;
+			k *= 0xff51afd7ed558ccdULL;
+			k ^= k >> 33;
+			k *= 0xc4ceb9fe1a85ec53ULL;
+			k ^= k >> 33;
+			return k;
+		}
+
+		PxU64	mLane0;
+		PxU64	mLane1;
+		PxU64	mLength;
+	};
+
+	// Header of the blobs stored in the cache, followed by the cooked data as written to the user stream
+	struct BlobHeader
+	{
+		PxU32	condition;	// Cooking condition
+		PxU32	size;		// Size of the cooked data
+		PxU64	checksum;	// Checksum of the cooked data
+	};
+
+	PxU64 computeChecksum(const PxU8* data, PxU32 size)
+	{
+		CacheKeyHasher hasher;
+		hasher.add(data, size);
+		return hasher.getKey().hash[0];
+	}
+
+	// Cached blobs can come from anywhere, e.g. from files written by a previous run, so they are checked before use
+	bool isValidBlob(const PxArray<PxU8>& blob)
+	{
+		if(blob.size()<sizeof(BlobHeader))
+			return false;
+
+		BlobHeader header;
+		PxMemCopy(&header, blob.begin(), sizeof(BlobHeader));
+		const PxU8* data = blob.begin() + sizeof(BlobHeader);
+		return header.size==blob.size()-sizeof(BlobHeader) && header.checksum==computeChecksum(data, header.size);
+	}
+
+	struct CacheKeyHash
+	{
+		PX_FORCE_INLINE	uint32_t	operator()(const PxCookingCacheKey& k)	const	{ return PxU32(k.hash[0]);	}
+		PX_FORCE_INLINE	bool		equal(const PxCookingCacheKey& k0, const PxCookingCacheKey& k1)	const	{ return k0 == k1;	}
+	};
+
+	class BlobStream : public PxOutputStream
+	{
+		public:
+		virtual	PxU32	write(const void* src, PxU32 count)	PX_OVERRIDE
+		{
+			const PxU32 size = mData.size();
+			// PxArray::resizeUninitialized only reserves what it needs, so we grow geometrically ourselves
+			if(size + count > mData.capacity())
+				mData.reserve(PxMax(size + count, mData.capacity()*2));
+			mData.resizeUninitialized(size + count);
+			PxMemCopy(mData.begin() + size, src, count);
+			return count;
+		}
+
+		PxArray<PxU8>	mData;
+	};
+
+	// Everything that can change the cooked data, i.e. all the params except the dispatcher
+	void hashCookingParams(CacheKeyHasher& hasher, const PxCookingParams& params)
+	{
+		hasher.add(PxU32(PX_PHYSICS_VERSION));
+		hasher.add(PxU32(COOKING_CACHE_FORMAT_VERSION));
+		hasher.add(params.areaTestEpsilon);
+		hasher.add(params.planeTolerance);
+		hasher.add(PxU32(params.convexMeshCookingType));
+		hasher.add(PxU8(params.suppressTriangleMeshRemapTable));
+		hasher.add(PxU8(params.buildTriangleAdjacencies));
+		hasher.add(PxU8(params.buildGPUData));
+		hasher.add(params.scale.length);
+		hasher.add(params.scale.speed);
+		hasher.add(PxU32(params.meshPreprocessParams));
+		hasher.add(params.meshWeldTolerance);
+		hasher.add(params.meshAreaMinLimit);
+		hasher.add(params.meshEdgeLengthMaxLimit);
+		hasher.add(PxU32(params.midphaseDesc.getType()));
+		if(params.midphaseDesc.getType() == PxMeshMidPhase::eBVH33)
+		{
+			hasher.add(params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff);
+			hasher.add(PxU32(params.midphaseDesc.mBVH33Desc.meshCookingHint));
+		}
+		else
+		{
+			hasher.add(params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf);
+			hasher.add(PxU32(params.midphaseDesc.mBVH34Desc.buildStrategy));
+			hasher.add(PxU8(params.midphaseDesc.mBVH34Desc.quantized));
+		}
+		hasher.add(params.gaussMapLimit);
+		hasher.add(params.maxWeightRatioInTet);
+	}
+
+	struct ConvexMeshBatch
+	{
+		typedef PxConvexMeshDesc					Desc;
+		typedef PxConvexMeshCookingResult::Enum		Result;
+
+		static PX_FORCE_INLINE	PxU32	getTypeTag()	{ return 0x58564e43;	}	// 'CNVX'
+
+		static void	hashDesc(CacheKeyHasher& hasher, const Desc& desc)
+		{
+			const PxU32 indexSize = (desc.flags & PxConvexFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+			hasher.addStrided(desc.points.data, desc.points.count, sizeof(PxVec3), desc.points.stride);
+			hasher.addStrided(desc.polygons.data, desc.polygons.count, sizeof(PxHullPolygon), desc.polygons.stride);
+			hasher.addStrided(desc.indices.data, desc.indices.count, indexSize, desc.indices.stride);
+			hasher.add(PxU16(desc.flags));
+			hasher.add(desc.vertexLimit);
+			hasher.add(desc.polygonLimit);
+			hasher.add(desc.quantizedCount);
+		}
+
+		static PX_FORCE_INLINE	bool	cook(const PxCookingParams& params, const Desc& desc, PxOutputStream& stream, Result* condition)
+		{
+			return immediateCooking::cookConvexMesh(params, desc, stream, condition);
+		}
+
+		static PX_FORCE_INLINE	Result	getSuccess()	{ return PxConvexMeshCookingResult::eSUCCESS;	}
+	};
+
+	struct TriangleMeshBatch
+	{
+		typedef PxTriangleMeshDesc					Desc;
+		typedef PxTriangleMeshCookingResult::Enum	Result;
+
+		static PX_FORCE_INLINE	PxU32	getTypeTag()	{ return 0x48534d54;	}	// 'TMSH'
+
+		static void	hashDesc(CacheKeyHasher& hasher, const Desc& desc)
+		{
+			const PxU32 indexSize = (desc.flags & PxMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+			hasher.addStrided(desc.points.data, desc.points.count, sizeof(PxVec3), desc.points.stride);
+			hasher.addStrided(desc.triangles.data, desc.triangles.count, indexSize*3, desc.triangles.stride);
+			hasher.add(PxU16(desc.flags));
+			hasher.addStrided(desc.materialIndices.data, desc.materialIndices.data ? desc.triangles.count : 0, sizeof(PxMaterialTableIndex), desc.materialIndices.stride);
+		}
+
+		static PX_FORCE_INLINE	bool	cook(const PxCookingParams& params, const Desc& desc, PxOutputStream& stream, Result* condition)
+		{
+			return immediateCooking::cookTriangleMesh(params, desc, stream, condition);
+		}
+
+		static PX_FORCE_INLINE	Result	getSuccess()	{ return PxTriangleMeshCookingResult::eSUCCESS;	}
+	};
+
+	template<class Batch>
+	class CookingBatch
+	{
+		typedef typename Batch::Desc	Desc;
+		typedef typename Batch::Result	Result;
+
+		public:
+		CookingBatch(const PxCookingParams& params, PxU32 nbMeshes, const Desc* descs, PxOutputStream* const* streams, Result* conditions, PxCookingCache* cache) :
+			mParams(params), mDescs(descs), mStreams(streams), mConditions(conditions), mCache(cache), mNbFailures(0)
+		{
+			mKeys.resizeUninitialized(nbMeshes);
+			mNextDuplicate.resizeUninitialized(nbMeshes);
+		}
+
+		bool	run()
+		{
+			const PxU32 nbMeshes = mKeys.size();
+			PxCpuDispatcher* dispatcher = mParams.cpuDispatcher;
+
+			{
+				ComputeKeys work(*this);
+				PxParallelFor(dispatcher, work, nbMeshes);
+			}
+
+			// Group identical meshes. Each group is cooked once, by its first mesh, and the results are copied to the
+			// other ones. Meshes with an SDF are always cooked individually since SDF cooking writes back to the SDF desc.
+			{
+				PxHashMap<PxCookingCacheKey, PxU32, CacheKeyHash> firstMeshes;
+				for(PxU32 i=0;i<nbMeshes;i++)
+				{
+					mNextDuplicate[i] = INVALID_INDEX;
+					if(!isCacheable(i))
+					{
+						mUniqueMeshes.pushBack(i);
+						continue;
+					}
+
+					const PxHashMap<PxCookingCacheKey, PxU32, CacheKeyHash>::Entry* entry = firstMeshes.find(mKeys[i]);
+					if(entry)
+					{
+						const PxU32 first = entry->second;
+						mNextDuplicate[i] = mNextDuplicate[first];
+						mNextDuplicate[first] = i;
+					}
+					else
+					{
+						firstMeshes.insert(mKeys[i], i);
+						mUniqueMeshes.pushBack(i);
+					}
+				}
+			}
+
+			{
+				CookMeshes work(*this);
+				PxParallelFor(dispatcher, work, mUniqueMeshes.size());
+			}
+
+			return mNbFailures==0;
+		}
+
+		private:
+		PX_FORCE_INLINE	bool	isCacheable(PxU32 i)	const	{ return !mDescs[i].sdfDesc;	}
+
+		void	computeKey(PxU32 i)
+		{
+			if(!isCacheable(i))
+				return;
+
+			CacheKeyHasher hasher;
+			hasher.add(Batch::getTypeTag());
+			hashCookingParams(hasher, mParams);
+			Batch::hashDesc(hasher, mDescs[i]);
+			mKeys[i] = hasher.getKey();
+		}
+
+		void	cookMesh(PxU32 i)
+		{
+			if(!isCacheable(i))
+			{
+				Result* condition = mConditions ? mConditions + i : NULL;
+				if(!Batch::cook(mParams, mDescs[i], *mStreams[i], condition))
+					PxAtomicIncrement(&mNbFailures);
+				return;
+			}
+
+			// Blob layout is a BlobHeader followed by the cooked data. Invalid blobs are ignored and the mesh is cooked again.
+			BlobStream blob;
+			bool success = mCache && mCache->load(mKeys[i], blob) && isValidBlob(blob.mData);
+			if(!success)
+			{
+				blob.mData.clear();
+				BlobHeader header;
+				PxMemZero(&header, sizeof(BlobHeader));
+				blob.write(&header, sizeof(BlobHeader));
+
+				Result condition = Batch::getSuccess();
+				success = Batch::cook(mParams, mDescs[i], blob, &condition);
+				header.condition	= PxU32(condition);
+				header.size			= blob.mData.size() - sizeof(BlobHeader);
+				header.checksum		= computeChecksum(blob.mData.begin() + sizeof(BlobHeader), header.size);
+				PxMemCopy(blob.mData.begin(), &header, sizeof(BlobHeader));
+
+				if(success && mCache)
+					mCache->store(mKeys[i], blob.mData.begin(), blob.mData.size());
+			}
+
+			if(!success)
+				PxAtomicIncrement(&mNbFailures);
+
+			BlobHeader header;
+			PxMemCopy(&header, blob.mData.begin(), sizeof(BlobHeader));
+			const PxU32 condition = header.condition;
+			const PxU8* data = blob.mData.begin() + sizeof(BlobHeader);
+			const PxU32 size = header.size;
+
+			PxU32 mesh = i;
+			do
+			{
+				if(size)
+					mStreams[mesh]->write(data, size);
+				if(mConditions)
+					mConditions[mesh] = Result(condition);
+				mesh = mNextDuplicate[mesh];
+			}
+			while(mesh!=INVALID_INDEX);
+		}
+
+		class ComputeKeys : public PxParallelForWork
+		{
+			public:
+								ComputeKeys(CookingBatch& batch) : mBatch(batch)	{}
+			virtual	void		process(PxU32 index)	PX_OVERRIDE	{ mBatch.computeKey(index);	}
+					CookingBatch&	mBatch;
+			PX_NOCOPY(ComputeKeys)
+		};
+
+		class CookMeshes : public PxParallelForWork
+		{
+			public:
+								CookMeshes(CookingBatch& batch) : mBatch(batch)	{}
+			virtual	void		process(PxU32 index)	PX_OVERRIDE	{ mBatch.cookMesh(mBatch.mUniqueMeshes[index]);	}
+					CookingBatch&	mBatch;
+			PX_NOCOPY(CookMeshes)
+		};
+
+		const PxCookingParams&		mParams;
+		const Desc*					mDescs;
+		PxOutputStream* const*		mStreams;
+		Result*						mConditions;
+		PxCookingCache*				mCache;
+		PxArray<PxCookingCacheKey>	mKeys;
+		PxArray<PxU32>				mNextDuplicate;
+		PxArray<PxU32>				mUniqueMeshes;
+		volatile PxI32				mNbFailures;
+
+		PX_NOCOPY(CookingBatch)
+	};
+}
+
+bool immediateCooking::cookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions, PxCookingCache* cache)
+{
+	CookingBatch<ConvexMeshBatch> batch(params, nbMeshes, descs, streams, conditions, cache);
+	return batch.run();
+}
+
+bool immediateCooking::cookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions, PxCookingCache* cache)
+{
+	CookingBatch<TriangleMeshBatch> batch(params, nbMeshes, descs, streams, conditions, cache);
+	return batch.run();
+}
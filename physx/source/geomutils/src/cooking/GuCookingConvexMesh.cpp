@@ -30,8 +30,10 @@
 #include "GuCookingConvexMeshBuilder.h"
 #include "GuCookingQuickHullConvexHullLib.h"
 #include "GuConvexMesh.h"
+#include "task/PxParallelFor.h"
 #include "foundation/PxAlloca.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxAtomic.h"
 #include "common/PxInsertionCallback.h"
 
 using namespace physx;
@@ -213,6 +215,40 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	return convexMesh;
 }
 
+namespace
+{
+	class CreateConvexMeshes : public PxParallelForWork
+	{
+		public:
+		CreateConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions) :
+			mParams(params), mDescs(descs), mInsertionCallback(insertionCallback), mMeshes(meshes), mConditions(conditions), mNbFailures(0)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			mMeshes[index] = immediateCooking::createConvexMesh(mParams, mDescs[index], mInsertionCallback, mConditions ? mConditions + index : NULL);
+			if(!mMeshes[index])
+				PxAtomicIncrement(&mNbFailures);
+		}
+
+		const PxCookingParams&				mParams;
+		const PxConvexMeshDesc*				mDescs;
+		PxInsertionCallback&				mInsertionCallback;
+		PxConvexMesh**						mMeshes;
+		PxConvexMeshCookingResult::Enum*	mConditions;
+		volatile PxI32						mNbFailures;
+
+		PX_NOCOPY(CreateConvexMeshes)
+	};
+}
+
+bool immediateCooking::createConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions)
+{
+	// One mesh per work item, since runtime batches are usually made of many small hulls
+	CreateConvexMeshes work(params, descs, insertionCallback, meshes, conditions);
+	PxParallelFor(params.cpuDispatcher, work, nbMeshes);
+	return work.mNbFailures==0;
+}
+
 bool immediateCooking::validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	ConvexMeshBuilder mesh(params.buildGPUData);
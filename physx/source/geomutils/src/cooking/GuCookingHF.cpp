@@ -94,6 +94,9 @@ PxHeightField* immediateCooking::createHeightField(const PxHeightFieldDesc& desc
 	heightField->mMinHeight = hf->mMinHeight;
 	heightField->mMaxHeight = hf->mMaxHeight;
 	heightField->mModifyCount = hf->mModifyCount;
+	// The tile cache is owned by the new heightfield
+	heightField->mTileCache = hf->mTileCache;
+	hf->mTileCache = NULL;
 
 	PX_DELETE(hf);
 	return heightField;
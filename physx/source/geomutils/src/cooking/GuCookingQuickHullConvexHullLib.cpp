@@ -39,8 +39,10 @@
 #include "foundation/PxPlane.h"
 #include "foundation/PxBounds3.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxVecMath.h"
 
 using namespace physx;
+using namespace aos;
 
 namespace local
 {		
@@ -78,14 +80,6 @@ namespace local
 			PX_ASSERT(preallocateSize);
 			mPreallocateSize = preallocateSize;
 			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
-			if(useIndexing)
-			{
-				for (PxU32 i = 0; i < mPreallocateSize; i++)
-				{
-					// placement new to index data
-					PX_PLACEMENT_NEW(&block[i], T)(i);
-				}
-			}
 			mBlocks.pushBack(block);
 		}
 
@@ -125,26 +119,23 @@ namespace local
 		{
 			PX_ASSERT(mPreallocateSize);
 			// check if we have enough space in block, otherwise allocate new block
-			if(mCurrentIndex < mPreallocateSize)
-			{
-				return &(mBlocks[mCurrentBlock])[mCurrentIndex++];
-			}
-			else
+			if(mCurrentIndex == mPreallocateSize)
 			{
 				T* block = PX_ALLOCATE(T, mPreallocateSize, "Quickhull MemBlock");
 				mCurrentBlock++;
-				if (useIndexing)
-				{
-					for (PxU32 i = 0; i < mPreallocateSize; i++)
-					{
-						// placement new to index data
-						PX_PLACEMENT_NEW(&block[i], T)(mCurrentBlock*mPreallocateSize + i);
-					}
-				}
-				mBlocks.pushBack(block);				
+				mBlocks.pushBack(block);
 				mCurrentIndex = 0;
-				return &(mBlocks[mCurrentBlock])[mCurrentIndex++];
 			}
+
+			// the blocks are sized for the worst case and most items are never used, so
+			// the indexed items are constructed when they are handed out rather than in init
+			T* item = &(mBlocks[mCurrentBlock])[mCurrentIndex++];
+			if(useIndexing)
+			{
+				// placement new to index data
+				PX_PLACEMENT_NEW(item, T)(mCurrentBlock*mPreallocateSize + mCurrentIndex - 1);
+			}
+			return item;
 		}
 
 	private:
@@ -353,6 +344,43 @@ namespace local
 
 	};
 
+	//////////////////////////////////////////////////////////////////////////
+	// finds the furthest face for 4 points at once. Each point gets the face with the largest distance above minDist, or -1 if
+	// there is none. Faces are tested in order, with the same operations as QuickHullFace::distanceToPlane, so that the results
+	// are the same as testing each point against each face with the scalar code. Planes are stored as (normal, planeOffset).
+	static PX_FORCE_INLINE void findFurthestFaces4(const PxVec4* planes, PxU32 numFaces, const Vec4V x, const Vec4V y, const Vec4V z,
+		float minDist, float* maxDist, float* maxFace)
+	{
+		Vec4V maxDistV = V4Load(minDist);
+		Vec4V maxFaceV = V4Load(-1.0f);
+		for (PxU32 i = 0; i < numFaces; i++)
+		{
+			const PxVec4& plane = planes[i];
+			const Vec4V dot = V4Add(V4Add(V4Mul(V4Load(plane.x), x), V4Mul(V4Load(plane.y), y)), V4Mul(V4Load(plane.z), z));
+			const Vec4V dist = V4Sub(dot, V4Load(plane.w));
+			const BoolV further = V4IsGrtr(dist, maxDistV);
+			maxDistV = V4Sel(further, dist, maxDistV);
+			maxFaceV = V4Sel(further, V4Load(float(i)), maxFaceV);
+		}
+		V4StoreA(maxDistV, maxDist);
+		V4StoreA(maxFaceV, maxFace);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// loads 4 vertices in SoA form. The 4th loaded component is the vertex index, which ends up in w and is ignored.
+	static PX_FORCE_INLINE void loadVertices4(const QuickHullVertex& v0, const QuickHullVertex& v1, const QuickHullVertex& v2, const QuickHullVertex& v3,
+		Vec4V& x, Vec4V& y, Vec4V& z)
+	{
+		Vec4V p0 = V4LoadU(&v0.point.x);
+		Vec4V p1 = V4LoadU(&v1.point.x);
+		Vec4V p2 = V4LoadU(&v2.point.x);
+		Vec4V p3 = V4LoadU(&v3.point.x);
+		V4Transpose(p0, p1, p2, p3);
+		x = p0;
+		y = p1;
+		z = p2;
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	struct QuickHullResult
 	{
@@ -490,6 +518,9 @@ namespace local
 		QuickHullFaceArray		mNewFaces;			// new faces created during horizon computation
 		QuickHullFaceArray		mRemovedFaces;		// removd faces during horizon computation
 		QuickHullFaceArray      mDiscardedFaces;	// discarded faces during face merging
+
+		QuickHullFaceArray			mClaimingFaces;		// visible new faces, used to resolve unclaimed points
+		PxArray<PxVec4>				mClaimingPlanes;	// planes of the claiming faces
 	};
 
 	//////////////////////////////////////////////////////////////////////////
@@ -730,6 +761,8 @@ namespace local
 		// max num vertices = numVertices
 		mMaxVertices = PxMax(PxU32(8), numVertices); // 8 is min, since we can expand to AABB during the clean vertices phase
 		mVerticesList = PX_ALLOCATE(QuickHullVertex, mMaxVertices, "QuickHullVertex");
+		// findSimplex() and addSimplex() load the vertices 4 at a time, including the unused entries past mNumVertices
+		PxMemSet(mVerticesList, 0, mMaxVertices*sizeof(QuickHullVertex));
 
 		// estimate the max half edges
 		PxU32 maxHalfEdges = (3 * mMaxVertices - 6) * 3;
@@ -746,6 +779,8 @@ namespace local
 		mRemovedFaces.reserve(32);
 		mDiscardedFaces.reserve(32);
 		mHorizon.reserve(PxMin(numVertices,PxU32(128)));
+		mClaimingFaces.reserve(32);
+		mClaimingPlanes.reserve(32);
 	}
 
 	//////////////////////////////////////////////////////////////////////////
@@ -879,44 +914,84 @@ namespace local
 
 		// set third vertex to be the vertex farthest from
 		// the line between simplex[0] and simplex[1]
-		PxVec3 normal;
 		float maxDist = 0;
 		PxVec3 u01 = (simplex[1].point - simplex[0].point);
 		u01.normalize();
 
-		for (PxU32 i = 0; i < mNumVertices; i++)
-		{
-			const QuickHullVertex& testVert = mVerticesList[i];
-			const PxVec3& testPoint = testVert.point;
-			const PxVec3 diff = testPoint - simplex[0].point;
-			const PxVec3 xprod = u01.cross(diff);
-			const float lenSqr = xprod.magnitudeSquared();
-			if (lenSqr > maxDist && testVert.index != simplex[0].index && testVert.index != simplex[1].index)
+		// the distances are computed 4 vertices at a time, with the same operations as the scalar code, and then tested in order
+		// so that the selected vertices do not change. mVerticesList holds at least 8 vertices, so we can always load 4 of them.
+		// Entries past mNumVertices are zeroed by preallocate(), and the results of their lanes are ignored.
+		PX_ALIGN(16, float distances[4]);
+		{
+			const Vec4V ux = V4Load(u01.x);
+			const Vec4V uy = V4Load(u01.y);
+			const Vec4V uz = V4Load(u01.z);
+			const Vec4V s0x = V4Load(simplex[0].point.x);
+			const Vec4V s0y = V4Load(simplex[0].point.y);
+			const Vec4V s0z = V4Load(simplex[0].point.z);
+			for (PxU32 i = 0; i < mNumVertices; i += 4)
 			{
-				maxDist = lenSqr;
-				simplex[2] = testVert;
-				normal = xprod;
+				const PxU32 first = PxMin(i, mMaxVertices - 4);
+				Vec4V x, y, z;
+				loadVertices4(mVerticesList[first], mVerticesList[first + 1], mVerticesList[first + 2], mVerticesList[first + 3], x, y, z);
+				const Vec4V dx = V4Sub(x, s0x);
+				const Vec4V dy = V4Sub(y, s0y);
+				const Vec4V dz = V4Sub(z, s0z);
+				// u01.cross(diff).magnitudeSquared()
+				const Vec4V cx = V4Sub(V4Mul(uy, dz), V4Mul(uz, dy));
+				const Vec4V cy = V4Sub(V4Mul(uz, dx), V4Mul(ux, dz));
+				const Vec4V cz = V4Sub(V4Mul(ux, dy), V4Mul(uy, dx));
+				V4StoreA(V4Add(V4Add(V4Mul(cx, cx), V4Mul(cy, cy)), V4Mul(cz, cz)), distances);
+
+				const PxU32 nb = PxMin(mNumVertices - i, PxU32(4));
+				for (PxU32 j = 0; j < nb; j++)
+				{
+					const QuickHullVertex& testVert = mVerticesList[i + j];
+					const float lenSqr = distances[i + j - first];
+					if (lenSqr > maxDist && testVert.index != simplex[0].index && testVert.index != simplex[1].index)
+					{
+						maxDist = lenSqr;
+						simplex[2] = testVert;
+					}
+				}
 			}
 		}
 
 		if (PxSqrt(maxDist) <= mTolerance)
 			return PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, PX_FL, "QuickHullConvexHullLib::findSimplex: Simplex input points appers to be colinear.");
 
+		PxVec3 normal = u01.cross(simplex[2].point - simplex[0].point);
 		normal.normalize();
 
 		// set the forth vertex in the normal direction	
 		const float d0 = simplex[2].point.dot(normal);
 		maxDist = 0.0f;
-		for (PxU32 i = 0; i < mNumVertices; i++)
 		{
-			const QuickHullVertex& testVert = mVerticesList[i];
-			const PxVec3& testPoint = testVert.point;
-			const float dist = PxAbs(testPoint.dot(normal) - d0);
-			if (dist > maxDist && testVert.index != simplex[0].index &&
-				testVert.index != simplex[1].index && testVert.index != simplex[2].index)
+			const Vec4V nx = V4Load(normal.x);
+			const Vec4V ny = V4Load(normal.y);
+			const Vec4V nz = V4Load(normal.z);
+			const Vec4V d0V = V4Load(d0);
+			for (PxU32 i = 0; i < mNumVertices; i += 4)
 			{
-				maxDist = dist;
-				simplex[3] = testVert;
+				const PxU32 first = PxMin(i, mMaxVertices - 4);
+				Vec4V x, y, z;
+				loadVertices4(mVerticesList[first], mVerticesList[first + 1], mVerticesList[first + 2], mVerticesList[first + 3], x, y, z);
+				// PxAbs(testPoint.dot(normal) - d0)
+				const Vec4V dot = V4Add(V4Add(V4Mul(x, nx), V4Mul(y, ny)), V4Mul(z, nz));
+				V4StoreA(V4Abs(V4Sub(dot, d0V)), distances);
+
+				const PxU32 nb = PxMin(mNumVertices - i, PxU32(4));
+				for (PxU32 j = 0; j < nb; j++)
+				{
+					const QuickHullVertex& testVert = mVerticesList[i + j];
+					const float dist = distances[i + j - first];
+					if (dist > maxDist && testVert.index != simplex[0].index &&
+						testVert.index != simplex[1].index && testVert.index != simplex[2].index)
+					{
+						maxDist = dist;
+						simplex[3] = testVert;
+					}
+				}
 			}
 		}
 
@@ -1042,30 +1117,37 @@ namespace local
 		mNumHullFaces = 4;
 
 		// go through points and add point to faces if they are on the plane
-		for (PxU32 i = 0; i < mNumVertices; i++)
+		// the points are processed 4 at a time, see findSimplex
+		PxVec4 planes[4];
+		for (PxU32 k = 0; k < 4; k++)
 		{
-			const QuickHullVertex& v = mVerticesList[i];
+			planes[k] = PxVec4(tris[k]->normal, tris[k]->planeOffset);
+		}
 
-			if (v == simplex[0] || v == simplex[1] || v == simplex[2] || v == simplex[3])
-			{
-				continue;
-			}
+		PX_ALIGN(16, float maxDist[4]);
+		PX_ALIGN(16, float maxFace[4]);
+		for (PxU32 i = 0; i < mNumVertices; i += 4)
+		{
+			const PxU32 first = PxMin(i, mMaxVertices - 4);
+			Vec4V x, y, z;
+			loadVertices4(mVerticesList[first], mVerticesList[first + 1], mVerticesList[first + 2], mVerticesList[first + 3], x, y, z);
+			findFurthestFaces4(planes, 4, x, y, z, mTolerance, maxDist, maxFace);
 
-			float maxDist = mTolerance;
-			QuickHullFace* maxFace = NULL;
-			for (PxU32 k = 0; k < 4; k++)
+			const PxU32 nb = PxMin(mNumVertices - i, PxU32(4));
+			for (PxU32 j = 0; j < nb; j++)
 			{
-				const float dist = tris[k]->distanceToPlane(v.point);
-				if (dist > maxDist)
+				const QuickHullVertex& v = mVerticesList[i + j];
+
+				if (v == simplex[0] || v == simplex[1] || v == simplex[2] || v == simplex[3])
 				{
-					maxFace = tris[k];
-					maxDist = dist;
+					continue;
 				}
-			}
 
-			if (maxFace != NULL)
-			{
-				addPointToFace(*maxFace, &mVerticesList[i], maxDist);
+				const PxU32 lane = i + j - first;
+				if (maxFace[lane] >= 0.0f)
+				{
+					addPointToFace(*tris[PxU32(maxFace[lane])], &mVerticesList[i + j], maxDist[lane]);
+				}
 			}
 		}
 		return true;
@@ -1705,31 +1787,43 @@ namespace local
 
 	//////////////////////////////////////////////////////////////////////////
 	// resolve unclaimed points
+	// the planes of the visible new faces are gathered once, then the points are processed 4 at a time
 	void QuickHull::resolveUnclaimedPoints(const QuickHullFaceArray& newFaces)
 	{
-		for (PxU32 i = 0; i < mUnclaimedPoints.size(); i++)
+		const PxU32 numPoints = mUnclaimedPoints.size();
+		if (!numPoints)
+			return;
+
+		mClaimingFaces.clear();
+		mClaimingPlanes.clear();
+		for (PxU32 j = 0; j < newFaces.size(); j++)
 		{
-			QuickHullVertex* vtx = mUnclaimedPoints[i];
+			const QuickHullFace& newFace = *newFaces[j];
+			if (newFace.state == QuickHullFace::eVISIBLE)
+			{
+				mClaimingFaces.pushBack(newFaces[j]);
+				mClaimingPlanes.pushBack(PxVec4(newFace.normal, newFace.planeOffset));
+			}
+		}
 
-			float maxDist = mTolerance;
-			QuickHullFace* maxFace = NULL;
-			for (PxU32 j = 0; j < newFaces.size(); j++)
+		PX_ALIGN(16, float maxDist[4]);
+		PX_ALIGN(16, float maxFace[4]);
+		for (PxU32 i = 0; i < numPoints; i += 4)
+		{
+			// the last batch is padded with the last point
+			const PxU32 last = numPoints - 1;
+			Vec4V x, y, z;
+			loadVertices4(*mUnclaimedPoints[i], *mUnclaimedPoints[PxMin(i + 1, last)], *mUnclaimedPoints[PxMin(i + 2, last)], *mUnclaimedPoints[PxMin(i + 3, last)], x, y, z);
+			findFurthestFaces4(mClaimingPlanes.begin(), mClaimingPlanes.size(), x, y, z, mTolerance, maxDist, maxFace);
+
+			const PxU32 nb = PxMin(numPoints - i, PxU32(4));
+			for (PxU32 j = 0; j < nb; j++)
 			{
-				const QuickHullFace& newFace = *newFaces[j];
-				if (newFace.state == QuickHullFace::eVISIBLE)
+				if (maxFace[j] >= 0.0f)
 				{
-					const float dist = newFace.distanceToPlane(vtx->point);
-					if (dist > maxDist)
-					{
-						maxDist = dist;
-						maxFace = newFaces[j];
-					}
+					addPointToFace(*mClaimingFaces[PxU32(maxFace[j])], mUnclaimedPoints[i + j], maxDist[j]);
 				}
 			}
-			if (maxFace != NULL)
-			{
-				addPointToFace(*maxFace, vtx, maxDist);
-			}
 		}
 
 		mUnclaimedPoints.clear();
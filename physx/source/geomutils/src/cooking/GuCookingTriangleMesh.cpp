@@ -119,7 +119,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 			meshWeldTolerance = mParams.meshWeldTolerance;
 	}
 
-	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, mParams.meshAreaMinLimit);
+	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, mParams.meshAreaMinLimit, mParams.cpuDispatcher);
 	if(!cleaner.mNbTris)
 	{
 		if(condition)
@@ -221,7 +221,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 	return true;
 }
 
-static EdgeList* createEdgeList(const TriangleMeshData& meshData)
+static EdgeList* createEdgeList(const TriangleMeshData& meshData, PxCpuDispatcher* dispatcher)
 {
 	EDGELISTCREATE create;
 	create.NbFaces		= meshData.mNbTriangles;
@@ -238,6 +238,7 @@ static EdgeList* createEdgeList(const TriangleMeshData& meshData)
 	create.FacesToEdges	= true;
 	create.EdgesToFaces	= true;
 	create.Verts		= meshData.mVertices;
+	create.Dispatcher	= dispatcher;
 	//create.Epsilon = 0.1f;
 	//	create.Epsilon		= convexEdgeThreshold;
 	EdgeList* edgeList = PX_NEW(EdgeList);
@@ -276,7 +277,7 @@ void TriangleMeshBuilder::createSharedEdgeData(bool buildAdjacencies, bool build
 
 	const IndexedTriangle32* trigs = reinterpret_cast<const IndexedTriangle32*>(mMeshData.mTriangles);
 
-	mEdgeList = createEdgeList(mMeshData);
+	mEdgeList = createEdgeList(mMeshData, mParams.cpuDispatcher);
 
 	if(mEdgeList)
 	{
@@ -1057,7 +1058,7 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 		gubs = BV4_SAH;
 	else if(strategy==PxBVH34BuildStrategy::eFAST)
 		gubs = BV4_SPLATTER_POINTS;
-	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs))
+	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs, mParams.cpuDispatcher))
 		return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV4 tree failed to build.");
 
 	{
@@ -1151,7 +1152,7 @@ bool BV32TriangleMeshBuilder::createMidPhaseStructure(const PxCookingParams& par
 
 	const PxU32 nbTrisPerLeaf = 32;
 
-	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTrisPerLeaf))
+	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTrisPerLeaf, params.cpuDispatcher))
 		return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV32 tree failed to build.");
 
 	{
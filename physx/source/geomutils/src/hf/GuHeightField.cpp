@@ -44,6 +44,7 @@ HeightField::HeightField(MeshFactory* factory)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mTileCache	(NULL)
 , mMeshFactory	(factory)
 {
 	mData.format				= PxHeightFieldFormat::eS16_TM;
@@ -63,6 +64,7 @@ HeightField::HeightField(MeshFactory* factory, HeightFieldData& data)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mTileCache	(NULL)
 , mMeshFactory	(factory)
 {
 	mData = data;
@@ -88,11 +90,20 @@ void HeightField::exportExtraData(PxSerializationContext& stream)
 	// PT: warning, order matters for the converter. Needs to export the base stuff first
 	const PxU32 size = mData.rows * mData.columns * sizeof(PxHeightFieldSample);
 	stream.alignData(PX_SERIAL_ALIGN);	// PT: generic align within the generic allocator
-	stream.writeData(mData.samples, size);
+	if(mTileCache)
+	{
+		// Tiled heightfields are exported as regular ones, all tiles are paged in
+		const PxU32 nbVerts = mData.rows * mData.columns;
+		for(PxU32 i=0; i<nbVerts; i++)
+			stream.writeData(&getSample(i), sizeof(PxHeightFieldSample));
+	}
+	else
+		stream.writeData(mData.samples, size);
 }
 
 void HeightField::importExtraData(PxDeserializationContext& context)
 {
+	mTileCache = NULL;
 	mData.samples = context.readExtraData<PxHeightFieldSample, PX_SERIAL_ALIGN>(mData.rows * mData.columns);
 }
 
@@ -127,6 +138,7 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 	const PxU32 nbCols = getNbColumns();
 	const PxU32 nbRows = getNbRows();
 	PX_CHECK_AND_RETURN_NULL(desc.format == mData.format, "Gu::HeightField::modifySamples: desc.format mismatch");
+	PX_CHECK_AND_RETURN_NULL(!mTileCache, "Gu::HeightField::modifySamples: not supported for tiled heightfields");
 	//PX_CHECK_AND_RETURN_NULL(startCol + desc.nbColumns <= nbCols,
 	//	"Gu::HeightField::modifySamples: startCol + nbColumns out of range");
 	//PX_CHECK_AND_RETURN_NULL(startRow + desc.nbRows <= nbRows,
@@ -284,7 +296,20 @@ bool HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
 	mMinHeight = PX_MAX_REAL;
 	mMaxHeight = -PX_MAX_REAL;
 
-	if(nbVerts > 0) 
+	if(desc.tileLoader)
+	{
+		// Tiled heightfield, samples are paged in on demand by the tile cache
+		mSampleStride = sizeof(PxHeightFieldSample);
+		mTileCache = PX_NEW(HeightFieldTileCache);
+		if(!mTileCache->init(desc))
+		{
+			PX_DELETE(mTileCache);
+			return false;
+		}
+		mMinHeight = PxReal(mTileCache->getMinHeight());
+		mMaxHeight = PxReal(mTileCache->getMaxHeight());
+	}
+	else if(nbVerts > 0) 
 	{
 		mData.samples = PX_ALLOCATE(PxHeightFieldSample, nbVerts, "PxHeightFieldSample");
 		if(!mData.samples)
@@ -359,9 +384,10 @@ bool HeightField::save(PxOutputStream& stream, bool endian)
 	writeFloat(mMaxHeight, endian, stream);
 
 	// write samples
+	// Tiled heightfields are saved as regular ones, all tiles are paged in
 	for(PxU32 i=0; i<mNbSamples; i++)
 	{
-		const PxHeightFieldSample& s = hfData.samples[i];
+		const PxHeightFieldSample& s = getSample(i);
 		writeWord(PxU16(s.height), endian, stream);
 		stream.write(&s.materialIndex0, sizeof(s.materialIndex0));
 		stream.write(&s.materialIndex1, sizeof(s.materialIndex1));
@@ -376,6 +402,14 @@ PxU32 HeightField::saveCells(void* destBuffer, PxU32 destBufferSize) const
 {
 	PxU32 n = mData.columns * mData.rows * sizeof(PxHeightFieldSample);
 	if (n > destBufferSize) n = destBufferSize;
+	if(mTileCache)
+	{
+		PxHeightFieldSample* dst = reinterpret_cast<PxHeightFieldSample*>(destBuffer);
+		const PxU32 nbSamples = n / sizeof(PxHeightFieldSample);
+		for(PxU32 i=0; i<nbSamples; i++)
+			dst[i] = getSample(i);
+		return nbSamples * sizeof(PxHeightFieldSample);
+	}
 	PxMemCopy(destBuffer, mData.samples, n);
 
 	return n;
@@ -389,6 +423,7 @@ void HeightField::releaseMemory()
 	{
 		PX_FREE(mData.samples);
 	}
+	PX_DELETE(mTileCache);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 #include "CmRefCountable.h"
 #include "GuSphere.h"
 #include "GuHeightFieldData.h"
+#include "GuHeightFieldTileCache.h"
 
 //#define PX_HEIGHTFIELD_VERSION 0
 //#define PX_HEIGHTFIELD_VERSION 1  // tiled version that was needed for PS3 only has been removed
@@ -55,7 +56,7 @@ class HeightField : public PxHeightField, public PxUserAllocated
 {
 public:
 // PX_SERIALIZATION
-																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0) {}
+																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0), mTileCache(NULL) {}
 
 										void						preExportDataReset() { Cm::RefCountable_preExportDataReset(*this); }
 							virtual		void						exportExtraData(PxSerializationContext& context);
@@ -95,6 +96,9 @@ public:
 																		return getSample(cell);
 																	}
 							 virtual	PxU32						getTimestamp()					const	{ return mModifyCount;	}
+							 virtual	PxU32						getTileSize()					const	{ return mTileCache ? mTileCache->getTileSize() : 0;			}
+							 virtual	PxU32						getNbResidentTiles()			const	{ return mTileCache ? mTileCache->getNbResidentTiles() : 0;	}
+							 virtual	PxU32						trimTileCache()							{ return mTileCache ? mTileCache->trim() : 0;					}
 		//~PxHeightField
 
 		// PxRefCounted
@@ -230,15 +234,20 @@ public:
 	PX_CUDA_CALLABLE	PX_FORCE_INLINE	const PxHeightFieldSample&	getSample(PxU32 vertexIndex) const
 																	{
 																		PX_ASSERT(isValidVertex(vertexIndex));
+																		if(mTileCache)
+																			return mTileCache->getSample(vertexIndex);
 																		return mData.samples[vertexIndex];
 																	}
 
+						PX_FORCE_INLINE	const HeightFieldTileCache*	getTileCache()					const	{ return mTileCache; }
+
 										Gu::HeightFieldData			mData;
 										PxU32						mSampleStride;
 										PxU32						mNbSamples;	// PT: added for platform conversion. Try to remove later.
 										PxReal						mMinHeight;
 										PxReal						mMaxHeight;
 										PxU32						mModifyCount;
+										HeightFieldTileCache*		mTileCache;	// Tiled heightfields only, mData.samples is NULL then
 
 										void						releaseMemory();
 						virtual										~HeightField();
@@ -0,0 +1,354 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "GuHeightFieldTileCache.h"
+#include "geometry/PxHeightFieldDesc.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxMath.h"
+
+using namespace physx;
+using namespace Gu;
+
+HeightFieldTileCache::HeightFieldTileCache() :
+	mLoader				(NULL),
+	mNbRows				(0),
+	mNbColumns			(0),
+	mTileShift			(0),
+	mTileMask			(0),
+	mNbTileRows			(0),
+	mNbTileColumns		(0),
+	mNbTiles			(0),
+	mMaxNbResidentTiles	(0),
+	mMinHeight			(0),
+	mMaxHeight			(0),
+	mTiles				(NULL),
+	mUsedTiles			(NULL),
+	mLastUsed			(NULL),
+	mNbResidentTiles	(0),
+	mSlotMemory			(NULL),
+	mTimestamp			(0)
+{
+}
+
+HeightFieldTileCache::~HeightFieldTileCache()
+{
+	if(mTiles)
+	{
+		const PxHeightFieldSample* slotMemoryEnd = mSlotMemory + (mMaxNbResidentTiles << (mTileShift*2));
+		for(PxU32 i=0; i<mNbTiles; i++)
+		{
+			PxHeightFieldSample* tile = mTiles[i];
+			if(tile && (tile < mSlotMemory || tile >= slotMemoryEnd))
+				PX_FREE(tile);
+		}
+	}
+
+	PX_FREE(mSlotMemory);
+	PX_FREE(mLastUsed);
+	PxU8* usedTiles = const_cast<PxU8*>(mUsedTiles);
+	PX_FREE(usedTiles);
+	PxHeightFieldSample** tiles = const_cast<PxHeightFieldSample**>(mTiles);
+	PX_FREE(tiles);
+}
+
+bool HeightFieldTileCache::init(const PxHeightFieldDesc& desc)
+{
+	PX_ASSERT(desc.tileLoader);
+	PX_ASSERT(PxIsPowerOfTwo(desc.tileSize));
+
+	// Computing the bounds here would page in every tile of the heightfield
+	if(!desc.tileBounds)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "Gu::HeightFieldTileCache::init: tiled heightfields need PxHeightFieldDesc::tileBounds.");
+
+	mLoader				= desc.tileLoader;
+	mNbRows				= desc.nbRows;
+	mNbColumns			= desc.nbColumns;
+	mTileShift			= PxHighestSetBit(desc.tileSize);
+	mTileMask			= desc.tileSize - 1;
+	mNbTileRows			= (mNbRows + mTileMask) >> mTileShift;
+	mNbTileColumns		= (mNbColumns + mTileMask) >> mTileShift;
+	mNbTiles			= mNbTileRows * mNbTileColumns;
+	mMaxNbResidentTiles	= desc.maxNbResidentTiles;
+
+	const PxU32 nbSamplesPerTile = 1<<(mTileShift*2);
+
+	mTiles = PX_ALLOCATE(PxHeightFieldSample*, mNbTiles, "HeightFieldTileCache::mTiles");
+	PxU8* usedTiles = PX_ALLOCATE(PxU8, mNbTiles, "HeightFieldTileCache::mUsedTiles");
+	mUsedTiles = usedTiles;
+	mLastUsed = PX_ALLOCATE(PxU32, mNbTiles, "HeightFieldTileCache::mLastUsed");
+	mSlotMemory = PX_ALLOCATE(PxHeightFieldSample, mMaxNbResidentTiles * nbSamplesPerTile, "HeightFieldTileCache::mSlotMemory");
+	if(!mTiles || !usedTiles || !mLastUsed || !mSlotMemory)
+		return PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "Gu::HeightFieldTileCache::init: PX_ALLOCATE failed!");
+
+	PxMemZero(const_cast<PxHeightFieldSample**>(mTiles), sizeof(PxHeightFieldSample*)*mNbTiles);
+	PxMemZero(usedTiles, sizeof(PxU8)*mNbTiles);
+	PxMemZero(mLastUsed, sizeof(PxU32)*mNbTiles);
+
+	// Push in reverse order so that the slots are used in memory order
+	mFreeSlots.reserve(mMaxNbResidentTiles);
+	for(PxU32 i=mMaxNbResidentTiles; i--;)
+		mFreeSlots.pushBack(mSlotMemory + i * nbSamplesPerTile);
+
+	buildHierarchy(desc.tileBounds);
+	return true;
+}
+
+void HeightFieldTileCache::buildHierarchy(const PxHeightFieldTileBounds* tileBounds)
+{
+	mMinHeight = PX_MAX_I16;
+	mMaxHeight = PX_MIN_I16;
+	for(PxU32 i=0; i<mNbTiles; i++)
+	{
+		mMinHeight = PxMin(mMinHeight, tileBounds[i].minHeight);
+		mMaxHeight = PxMax(mMaxHeight, tileBounds[i].maxHeight);
+	}
+
+	// Level 0 bounds the cells of each tile, which also use the first row and column of samples of the next tiles
+	mBounds.resizeUninitialized(mNbTiles);
+	for(PxU32 tileRow=0; tileRow<mNbTileRows; tileRow++)
+	{
+		for(PxU32 tileColumn=0; tileColumn<mNbTileColumns; tileColumn++)
+		{
+			const PxHeightFieldTileBounds& src = tileBounds[tileRow * mNbTileColumns + tileColumn];
+			PxI16 minHeight = src.minHeight;
+			PxI16 maxHeight = src.maxHeight;
+			for(PxU32 j=1; j<4; j++)
+			{
+				const PxU32 r = tileRow + (j>>1);
+				const PxU32 c = tileColumn + (j&1);
+				if(r < mNbTileRows && c < mNbTileColumns)
+				{
+					minHeight = PxMin(minHeight, tileBounds[r * mNbTileColumns + c].minHeight);
+					maxHeight = PxMax(maxHeight, tileBounds[r * mNbTileColumns + c].maxHeight);
+				}
+			}
+			TileBounds& dst = mBounds[tileRow * mNbTileColumns + tileColumn];
+			dst.minHeight = minHeight;
+			dst.maxHeight = maxHeight;
+		}
+	}
+
+	// Upper levels, each node bounds 2x2 nodes of the level below
+	mLevelOffsets.pushBack(0);
+	mLevelNbColumns.pushBack(mNbTileColumns);
+	PxU32 nbRows = mNbTileRows;
+	PxU32 nbColumns = mNbTileColumns;
+	while(nbRows>1 || nbColumns>1)
+	{
+		const PxU32 prevOffset = mLevelOffsets.back();
+		const PxU32 prevNbRows = nbRows;
+		const PxU32 prevNbColumns = nbColumns;
+		nbRows = (nbRows + 1)>>1;
+		nbColumns = (nbColumns + 1)>>1;
+
+		const PxU32 offset = mBounds.size();
+		mLevelOffsets.pushBack(offset);
+		mLevelNbColumns.pushBack(nbColumns);
+		mBounds.resizeUninitialized(offset + nbRows * nbColumns);
+
+		for(PxU32 r=0; r<nbRows; r++)
+		{
+			for(PxU32 c=0; c<nbColumns; c++)
+			{
+				PxI16 minHeight = PX_MAX_I16;
+				PxI16 maxHeight = PX_MIN_I16;
+				for(PxU32 j=0; j<4; j++)
+				{
+					const PxU32 childRow = r*2 + (j>>1);
+					const PxU32 childColumn = c*2 + (j&1);
+					if(childRow < prevNbRows && childColumn < prevNbColumns)
+					{
+						const TileBounds& child = mBounds[prevOffset + childRow * prevNbColumns + childColumn];
+						minHeight = PxMin(minHeight, child.minHeight);
+						maxHeight = PxMax(maxHeight, child.maxHeight);
+					}
+				}
+				TileBounds& dst = mBounds[offset + r * nbColumns + c];
+				dst.minHeight = minHeight;
+				dst.maxHeight = maxHeight;
+			}
+		}
+	}
+}
+
+bool HeightFieldTileCache::rectOverlapsHeights(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn, PxReal minHeight, PxReal maxHeight) const
+{
+	if(minRow >= maxRow || minColumn >= maxColumn)
+		return false;
+
+	PxU32 minTileRow = minRow >> mTileShift;
+	PxU32 maxTileRow = (maxRow - 1) >> mTileShift;
+	PxU32 minTileColumn = minColumn >> mTileShift;
+	PxU32 maxTileColumn = (maxColumn - 1) >> mTileShift;
+
+	PxU32 level = 0;
+	const PxU32 nbLevels = mLevelOffsets.size();
+	while((maxTileRow - minTileRow > 1 || maxTileColumn - minTileColumn > 1) && level + 1 < nbLevels)
+	{
+		minTileRow >>= 1;
+		maxTileRow >>= 1;
+		minTileColumn >>= 1;
+		maxTileColumn >>= 1;
+		level++;
+	}
+
+	const TileBounds* bounds = mBounds.begin() + mLevelOffsets[level];
+	const PxU32 nbColumns = mLevelNbColumns[level];
+	for(PxU32 r=minTileRow; r<=maxTileRow; r++)
+	{
+		for(PxU32 c=minTileColumn; c<=maxTileColumn; c++)
+		{
+			const TileBounds& b = bounds[r * nbColumns + c];
+			if(!(maxHeight < PxReal(b.minHeight) || minHeight > PxReal(b.maxHeight)))
+				return true;
+		}
+	}
+	return false;
+}
+
+void HeightFieldTileCache::fillTile(PxU32 tileIndex, PxHeightFieldSample* samples) const
+{
+	const PxU32 firstRow = (tileIndex / mNbTileColumns) << mTileShift;
+	const PxU32 firstColumn = (tileIndex % mNbTileColumns) << mTileShift;
+	const PxU32 nbRows = PxMin(mTileMask + 1, mNbRows - firstRow);
+	const PxU32 nbColumns = PxMin(mTileMask + 1, mNbColumns - firstColumn);
+
+	if(!mLoader->loadTile(firstRow, firstColumn, nbRows, nbColumns, samples, mTileMask + 1))
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxHeightFieldTileLoader::loadTile() failed for tile (%u, %u), its cells are treated as holes.", firstRow, firstColumn);
+
+		PxHeightFieldSample hole;
+		hole.height = 0;
+		hole.materialIndex0 = PxBitAndByte(PxHeightFieldMaterial::eHOLE);
+		hole.materialIndex1 = PxBitAndByte(PxHeightFieldMaterial::eHOLE);
+		for(PxU32 i=0; i<(1u<<(mTileShift*2)); i++)
+			samples[i] = hole;
+	}
+}
+
+PxHeightFieldSample* HeightFieldTileCache::allocateTile() const
+{
+	if(mFreeSlots.size())
+		return mFreeSlots.popBack();
+
+	// The working set is larger than the cache. We cannot evict tiles here since other threads may be reading
+	// them, so we allocate a temporary tile. It is released or moved to a preallocated slot in trim(). We only warn
+	// for the first one since the previous trim() call.
+	if(mNbResidentTiles == mMaxNbResidentTiles)
+		PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "Gu::HeightFieldTileCache: more than %u tiles needed, consider increasing PxHeightFieldDesc::maxNbResidentTiles or calling PxHeightField::trimTileCache() more often.", mMaxNbResidentTiles);
+	const PxU32 nbSamplesPerTile = 1u<<(mTileShift*2);
+	return PX_ALLOCATE(PxHeightFieldSample, nbSamplesPerTile, "HeightFieldTileCache::tile");
+}
+
+const PxHeightFieldSample* HeightFieldTileCache::loadTile(PxU32 tileIndex) const
+{
+	PX_ASSERT(tileIndex < mNbTiles);
+
+	PxMutex::ScopedLock lock(mMutex);
+
+	// Another thread may have loaded it while we were waiting
+	PxHeightFieldSample* tile = mTiles[tileIndex];
+	if(tile)
+		return tile;
+
+	tile = allocateTile();
+	fillTile(tileIndex, tile);
+
+	// Make sure the samples are visible to other threads before the tile pointer is
+	PxMemoryBarrier();
+	mTiles[tileIndex] = tile;
+	mNbResidentTiles++;
+	return tile;
+}
+
+PxU32 HeightFieldTileCache::trim()
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	mTimestamp++;
+
+	// Sort the resident tiles by last use, tiles used since the previous call come last
+	PxArray<PxU64> residentTiles;
+	residentTiles.reserve(mNbResidentTiles);
+	for(PxU32 i=0; i<mNbTiles; i++)
+	{
+		if(!mTiles[i])
+			continue;
+
+		if(mUsedTiles[i])
+		{
+			mLastUsed[i] = mTimestamp;
+			mUsedTiles[i] = 0;
+		}
+		residentTiles.pushBack((PxU64(mLastUsed[i])<<32) | i);
+	}
+	PX_ASSERT(residentTiles.size() == mNbResidentTiles);
+
+	const PxU32 nbToEvict = mNbResidentTiles > mMaxNbResidentTiles ? mNbResidentTiles - mMaxNbResidentTiles : 0;
+	if(!nbToEvict)
+		return 0;
+
+	PxSort(residentTiles.begin(), residentTiles.size());
+
+	const PxU32 nbSamplesPerTile = 1u<<(mTileShift*2);
+	const PxHeightFieldSample* slotMemoryEnd = mSlotMemory + mMaxNbResidentTiles * nbSamplesPerTile;
+
+	PxArray<PxHeightFieldSample*> tempTiles;
+	for(PxU32 i=0; i<nbToEvict; i++)
+	{
+		const PxU32 tileIndex = PxU32(residentTiles[i]);
+		PxHeightFieldSample* tile = mTiles[tileIndex];
+		mTiles[tileIndex] = NULL;
+
+		if(tile >= mSlotMemory && tile < slotMemoryEnd)
+			mFreeSlots.pushBack(tile);
+		else
+			PX_FREE(tile);
+	}
+	mNbResidentTiles -= nbToEvict;
+
+	// Move the remaining temporary tiles to the preallocated slots, so that the cache is back to its fixed size
+	for(PxU32 i=nbToEvict; i<residentTiles.size(); i++)
+	{
+		const PxU32 tileIndex = PxU32(residentTiles[i]);
+		PxHeightFieldSample* tile = mTiles[tileIndex];
+		if(tile >= mSlotMemory && tile < slotMemoryEnd)
+			continue;
+
+		PX_ASSERT(mFreeSlots.size());
+		PxHeightFieldSample* slot = mFreeSlots.popBack();
+		PxMemCopy(slot, tile, sizeof(PxHeightFieldSample)*nbSamplesPerTile);
+		mTiles[tileIndex] = slot;
+		PX_FREE(tile);
+	}
+
+	return nbToEvict;
+}
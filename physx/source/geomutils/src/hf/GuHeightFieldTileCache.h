@@ -0,0 +1,147 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef GU_HEIGHTFIELD_TILE_CACHE_H
+#define GU_HEIGHTFIELD_TILE_CACHE_H
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxArray.h"
+#include "geometry/PxHeightFieldSample.h"
+#include "geometry/PxHeightFieldTileLoader.h"
+
+namespace physx
+{
+class PxHeightFieldDesc;
+
+namespace Gu
+{
+	// Sample storage of tiled heightfields. The samples are paged in by square tiles from a user callback,
+	// the first time they are accessed. Lookups are lock-free, only the loading of a new tile is serialized.
+	//
+	// Tiles are never evicted while they can be referenced: the simulation and the queries keep pointers to samples
+	// (see HeightField::getSample()). Eviction only happens in trim(), which must be called when the heightfield is
+	// not in use. The cache preallocates maxNbResidentTiles tiles, and temporarily allocates extra tiles when the
+	// working set is larger than that.
+	//
+	// The cache also keeps a min/max hierarchy of the tile heights, so that queries can skip tiles without loading them.
+	class HeightFieldTileCache : public PxUserAllocated
+	{
+		PX_NOCOPY(HeightFieldTileCache)
+	public:
+											HeightFieldTileCache();
+											~HeightFieldTileCache();
+
+						bool				init(const PxHeightFieldDesc& desc);
+
+		PX_FORCE_INLINE	const PxHeightFieldSample&	getSample(PxU32 vertexIndex)	const
+											{
+												const PxU32 row = vertexIndex / mNbColumns;
+												const PxU32 column = vertexIndex - row * mNbColumns;
+												const PxU32 tileIndex = (row >> mTileShift) * mNbTileColumns + (column >> mTileShift);
+
+												const PxHeightFieldSample* tile = mTiles[tileIndex];
+												if(!tile)
+													tile = loadTile(tileIndex);
+
+												// Only written once per tile between two trim() calls
+												if(!mUsedTiles[tileIndex])
+													mUsedTiles[tileIndex] = 1;
+
+												return tile[((row & mTileMask) << mTileShift) + (column & mTileMask)];
+											}
+
+		// Returns false if the cells of tile (tileRow, tileColumn) are all above maxHeight or all below minHeight.
+		// The bounds of a tile include the first row and column of its neighbors, i.e. all the vertices of its cells.
+		PX_FORCE_INLINE	bool				tileOverlapsHeights(PxU32 tileRow, PxU32 tileColumn, PxReal minHeight, PxReal maxHeight)	const
+											{
+												const TileBounds& bounds = mBounds[tileRow * mNbTileColumns + tileColumn];
+												return !(maxHeight < PxReal(bounds.minHeight) || minHeight > PxReal(bounds.maxHeight));
+											}
+
+		PX_FORCE_INLINE	bool				cellOverlapsHeights(PxU32 vertexIndex, PxReal minHeight, PxReal maxHeight)	const
+											{
+												const PxU32 row = vertexIndex / mNbColumns;
+												const PxU32 column = vertexIndex - row * mNbColumns;
+												return tileOverlapsHeights(row >> mTileShift, column >> mTileShift, minHeight, maxHeight);
+											}
+
+		// Same test for the cells [minRow, maxRow) x [minColumn, maxColumn), using the coarsest level of the hierarchy
+		// that covers the rectangle with at most 2x2 nodes.
+						bool				rectOverlapsHeights(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn, PxReal minHeight, PxReal maxHeight)	const;
+
+		PX_FORCE_INLINE	PxU32				getTileShift()			const	{ return mTileShift;			}
+		PX_FORCE_INLINE	PxU32				getTileSize()			const	{ return 1<<mTileShift;			}
+		PX_FORCE_INLINE	PxU32				getNbResidentTiles()	const	{ return mNbResidentTiles;		}
+		PX_FORCE_INLINE	PxI16				getMinHeight()			const	{ return mMinHeight;			}
+		PX_FORCE_INLINE	PxI16				getMaxHeight()			const	{ return mMaxHeight;			}
+
+						PxU32				trim();
+
+	private:
+		struct TileBounds
+		{
+			PxI16	minHeight;
+			PxI16	maxHeight;
+		};
+
+						PxHeightFieldSample*	allocateTile()	const;
+						void					fillTile(PxU32 tileIndex, PxHeightFieldSample* samples)	const;
+						const PxHeightFieldSample*	loadTile(PxU32 tileIndex)	const;
+						void					buildHierarchy(const PxHeightFieldTileBounds* tileBounds);
+
+						PxHeightFieldTileLoader*	mLoader;
+						PxU32					mNbRows;
+						PxU32					mNbColumns;
+						PxU32					mTileShift;
+						PxU32					mTileMask;
+						PxU32					mNbTileRows;
+						PxU32					mNbTileColumns;
+						PxU32					mNbTiles;
+						PxU32					mMaxNbResidentTiles;
+						PxI16					mMinHeight;
+						PxI16					mMaxHeight;
+
+		// The cache is logically const, tiles are paged in from const queries
+		mutable			PxMutex					mMutex;
+						PxHeightFieldSample* volatile*	mTiles;			// per tile, NULL if not resident
+						volatile PxU8*			mUsedTiles;		// per tile, set when the tile is accessed
+						PxU32*					mLastUsed;		// per tile, trim() timestamp of the last access
+		mutable			PxArray<PxHeightFieldSample*>	mFreeSlots;
+		mutable			PxU32					mNbResidentTiles;
+						PxHeightFieldSample*	mSlotMemory;	// maxNbResidentTiles preallocated tiles
+						PxU32					mTimestamp;
+
+						PxArray<TileBounds>		mBounds;		// hierarchy, level 0 first
+						PxArray<PxU32>			mLevelOffsets;
+						PxArray<PxU32>			mLevelNbColumns;
+	};
+}
+}
+
+#endif
@@ -124,10 +124,26 @@ void Gu::HeightFieldUtil::overlapAABBTriangles(const PxBounds3& bounds, OverlapR
 	const PxReal maxy = localBounds.maximum.y;
 	const PxU32 columnStride = nbColumns - deltaColumn;
 
+	// For tiled heightfields we use the tile height bounds to skip the tiles that cannot overlap the query,
+	// without paging them in. Tiles are skipped per row, so that the triangles are still reported in the same order.
+	const HeightFieldTileCache* tileCache = mHeightField->getTileCache();
+	if(tileCache && !tileCache->rectOverlapsHeights(minRow, maxRow, minColumn, maxColumn, miny, maxy))
+		return;
+	const PxU32 tileShift = tileCache ? tileCache->getTileShift() : 0;
+	const PxU32 tileMask = (1<<tileShift) - 1;
+
 	for(PxU32 row=minRow; row<maxRow; row++)
 	{
 		for(PxU32 column=minColumn; column<maxColumn; column++)
 		{
+			if(tileCache && (column==minColumn || !(column & tileMask)) && !tileCache->tileOverlapsHeights(row>>tileShift, column>>tileShift, miny, maxy))
+			{
+				const PxU32 nextColumn = PxMin(((column>>tileShift) + 1)<<tileShift, maxColumn);
+				offset += nextColumn - column;
+				column = nextColumn - 1;
+				continue;
+			}
+
 			const PxReal h0 = mHeightField->getHeight(offset);
 			const PxReal h1 = mHeightField->getHeight(offset + 1);
 			const PxReal h2 = mHeightField->getHeight(offset + nbColumns);
@@ -396,6 +396,11 @@ namespace Gu
 			// does height check and if succeeded adds to report
 			PX_INLINE bool testVertexIndex(const PxU32 vertexIndex)
 			{
+				// For tiled heightfields, don't page in tiles whose height range doesn't overlap the sweep
+				const HeightFieldTileCache* tileCache = mHf.getTileCache();
+				if(tileCache && !tileCache->cellOverlapsHeights(vertexIndex, mMinY, mMaxY))
+					return true;
+
 				const PxReal h0 = mHf.getHeight(vertexIndex);
 				const PxReal h1 = mHf.getHeight(vertexIndex + 1);
 				const PxReal h2 = mHf.getHeight(vertexIndex + mNumColumns);
@@ -34,6 +34,9 @@
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "task/PxParallelFor.h"
+#include "foundation/PxArray.h"
+#include "task/PxCpuDispatcher.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -267,6 +270,12 @@ static bool local_Subdivide_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stat
 		return false;
 #endif
 
+	// The radix sorters would otherwise start from the ranks of the previously sorted node when it had the same number of
+	// primitives. Equal keys would then be sorted in an order that depends on which node was built before this one, which
+	// is not the same in the single-threaded and multi-threaded builds.
+	for(PxU32 i=0;i<3;i++)
+		buffers.mSorters[i].invalidateRanks();
+
 	PxU32 leftCount;
 	if(!buffers.split(leftCount, nb, prims, boxes, centers))
 	{
@@ -325,24 +334,188 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+namespace
+{
+	#define BV4_BUILD_CHUNK_SIZE	4096
+
+	class ComputeBoxes : public PxParallelForWork
+	{
+		public:
+		ComputeBoxes(SourceMeshBase& mesh, PxU32 nbBoxes, PxBounds3* boxes, PxVec3* centers) : mMesh(mesh), mNbBoxes(nbBoxes), mBoxes(boxes), mCenters(centers)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * BV4_BUILD_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + BV4_BUILD_CHUNK_SIZE, mNbBoxes);
+			computeBoxes(mMesh, start, end, mBoxes, mCenters);
+		}
+
+		static void	computeBoxes(SourceMeshBase& mesh, PxU32 start, PxU32 end, PxBounds3* boxes, PxVec3* centers)
+		{
+			if(start==end)
+				return;
+
+			const FloatV halfV = FLoad(0.5f);
+			const PxU32 last = end - 1;
+			for(PxU32 i=start;i<last;i++)
+			{
+				Vec4V minV, maxV;
+				mesh.getPrimitiveBox(i, minV, maxV);
+
+				V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
+				V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// Safe because the next box is written afterwards
+
+				const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+				V4StoreU_Safe(centerV, &centers[i].x);	// Safe because the next PxVec3 is written afterwards
+			}
+
+			// The next box can belong to another chunk, so we don't write past the last one
+			Vec4V minV, maxV;
+			mesh.getPrimitiveBox(last, minV, maxV);
+			const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+
+			PX_ALIGN_PREFIX(16) PxVec4 tmp PX_ALIGN_SUFFIX(16);
+			V4StoreA(minV, &tmp.x);		boxes[last].minimum = tmp.getXYZ();
+			V4StoreA(maxV, &tmp.x);		boxes[last].maximum = tmp.getXYZ();
+			V4StoreA(centerV, &tmp.x);	centers[last] = tmp.getXYZ();
+		}
+
+		SourceMeshBase&	mMesh;
+		const PxU32		mNbBoxes;
+		PxBounds3*		mBoxes;
+		PxVec3*			mCenters;
+		PX_NOCOPY(ComputeBoxes)
+	};
+
+	// A subtree built by a task. Its nodes are allocated from a dedicated range of the pool.
+	struct SubtreeDesc
+	{
+		AABBTreeNode*	mRoot;
+		AABBTreeNode*	mNodeBase;
+		PxU32			mNbNodes;
+	};
+
+	class BuildSubtrees : public PxParallelForWork
+	{
+		public:
+		BuildSubtrees(SubtreeDesc* subtrees, const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* mesh, bool sah) :
+			mSubtrees(subtrees), mBoxes(boxes), mCenters(centers), mLimit(limit), mMesh(mesh), mSAH(sah)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			SubtreeDesc& desc = mSubtrees[index];
+
+			BuildStats stats;
+			stats.setCount(0);
+			const BuildParams params(mBoxes, mCenters, desc.mNodeBase, mLimit, mMesh);
+			if(mSAH)
+			{
+				SAH_Buffers sah(desc.mRoot->mNbPrimitives);
+				local_BuildHierarchy_SAH(desc.mRoot, stats, params, sah);
+			}
+			else
+				local_BuildHierarchy(desc.mRoot, stats, params);
+
+			desc.mNbNodes = stats.getCount();
+		}
+
+		SubtreeDesc*		mSubtrees;
+		const PxBounds3*	mBoxes;
+		const PxVec3*		mCenters;
+		const PxU32			mLimit;
+		const SourceMesh*	mMesh;
+		const bool			mSAH;
+		PX_NOCOPY(BuildSubtrees)
+	};
+}
+
+// The top of the tree is built on the calling thread, until nodes contain less than nbPrimsPerSubtree primitives. These nodes
+// become the roots of subtrees built in parallel. Each subtree gets its own range of nodes in the pool, so the layout of the pool
+// differs from the single-threaded version, but the tree itself (i.e. what we get when we follow the child pointers) is the same.
+//
+// For the SAH strategy each node is sorted from scratch (see local_Subdivide_SAH), so the subtrees can use their own buffers.
+static PxU32 buildHierarchyParallel(PxCpuDispatcher* dispatcher, AABBTreeNode* pool, PxU32 nbBoxes, PxU32 nbPrimsPerSubtree, const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* mesh, bool sah)
+{
+	PX_ASSERT(nbPrimsPerSubtree>limit);
+
+	BuildStats stats;
+	stats.setCount(1);
+	const BuildParams params(boxes, centers, pool, limit, mesh);
+
+	PxArray<SubtreeDesc> subtrees;
+	PxArray<AABBTreeNode*> stack;
+	stack.pushBack(pool);
+	while(stack.size())
+	{
+		AABBTreeNode* node = stack.popBack();
+		if(node->mNbPrimitives>nbPrimsPerSubtree)
+		{
+			bool split;
+			if(sah)
+			{
+				SAH_Buffers buffers(node->mNbPrimitives);
+				split = local_Subdivide_SAH(node, stats, params, buffers);
+			}
+			else
+				split = local_Subdivide(node, stats, params);
+
+			PX_ASSERT(split);	// Nodes with more than 'limit' primitives are always split
+			if(split)
+			{
+				stack.pushBack(const_cast<AABBTreeNode*>(node->getNeg()));
+				stack.pushBack(const_cast<AABBTreeNode*>(node->getPos()));
+				continue;
+			}
+		}
+		SubtreeDesc desc;
+		desc.mRoot		= node;
+		desc.mNodeBase	= NULL;
+		desc.mNbNodes	= 0;
+		subtrees.pushBack(desc);
+	}
+
+	// A subtree with N primitives needs at most 2*N-2 nodes in addition to its root
+	PxU32 offset = stats.getCount();
+	for(PxU32 i=0;i<subtrees.size();i++)
+	{
+		subtrees[i].mNodeBase = pool + offset;
+		offset += subtrees[i].mRoot->mNbPrimitives*2 - 2;
+	}
+	PX_ASSERT(offset<=nbBoxes*2-1);
+	PX_UNUSED(nbBoxes);
+
+	BuildSubtrees work(subtrees.begin(), boxes, centers, limit, mesh, sah);
+	PxParallelFor(dispatcher, work, subtrees.size());
+
+	PxU32 totalNbNodes = stats.getCount();
+	for(PxU32 i=0;i<subtrees.size();i++)
+		totalNbNodes += subtrees[i].mNbNodes;
+	return totalNbNodes;
+}
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbPrimitives();
 	if(!nbBoxes)
 		return false;
 	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
 	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
-	const FloatV halfV = FLoad(0.5f);
-	for (PxU32 i = 0; i<nbBoxes; i++)
+	if(dispatcher)
 	{
-		Vec4V minV, maxV;
-		mesh.getPrimitiveBox(i, minV, maxV);
-
-		V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
-		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
+		ComputeBoxes work(mesh, nbBoxes, boxes, centers);
+		PxParallelFor(dispatcher, work, PxParallelForGetNbChunks(nbBoxes, BV4_BUILD_CHUNK_SIZE));
+	}
+	else
+		ComputeBoxes::computeBoxes(mesh, 0, nbBoxes, boxes, centers);
 
-		const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
-		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+	// We aim for a few subtrees per worker thread. Subtrees must contain more than 'limit' primitives (see buildHierarchyParallel).
+	PxU32 nbPrimsPerSubtree = 0;
+	if(dispatcher)
+	{
+		const PxU32 nbWorkers = dispatcher->getWorkerCount();
+		nbPrimsPerSubtree = PxMax(nbBoxes / ((nbWorkers + 1) * 4), PxMax(limit + 1, PxU32(BV4_BUILD_CHUNK_SIZE)));
+		if(nbBoxes<=nbPrimsPerSubtree)
+			dispatcher = NULL;
 	}
 
 	{
@@ -378,12 +551,20 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
 					triMesh = static_cast<SourceMesh*>(&mesh);
 			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			if(dispatcher)
+				Stats.setCount(buildHierarchyParallel(dispatcher, mPool, nbBoxes, nbPrimsPerSubtree, boxes, centers, limit, triMesh, false));
+			else
+				local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 		}
 		else if(strategy==BV4_SAH)
 		{
-			SAH_Buffers sah(nbBoxes);
-			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			if(dispatcher)
+				Stats.setCount(buildHierarchyParallel(dispatcher, mPool, nbBoxes, nbPrimsPerSubtree, boxes, centers, limit, NULL, true));
+			else
+			{
+				SAH_Buffers sah(nbBoxes);
+				local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			}
 		}
 		else
 			return false;
@@ -1820,7 +2001,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1828,7 +2009,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
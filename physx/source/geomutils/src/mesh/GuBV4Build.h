@@ -36,6 +36,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	class BV4Tree;
@@ -96,7 +98,7 @@ namespace Gu
 											BV4_AABBTree();
 											~BV4_AABBTree();
 
-						bool				buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS);
+						bool				buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS, PxCpuDispatcher* dispatcher=NULL);
 						void				release();
 
 		PX_FORCE_INLINE	const PxU32*		getIndices()		const	{ return mIndices;		}	//!< Catch the indices
@@ -115,7 +117,8 @@ namespace Gu
 						PxU32				mTotalNbNodes;		//!< Number of nodes in the tree.
 	};
 
-	bool BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS);
+		// If a dispatcher is provided the tree is built using multiple tasks. The results are the same as without it.
+	bool BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS, PxCpuDispatcher* dispatcher=NULL);
 
 } // namespace Gu
 }
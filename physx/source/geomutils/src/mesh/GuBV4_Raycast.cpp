@@ -37,6 +37,8 @@ using namespace Gu;
 //#define USE_SIMD_RAY_VS_TRI
 
 #include "PxQueryReport.h"
+#include "geometry/PxRayPacket.h"
+#include "foundation/PxBitUtils.h"
 #include "GuInternal.h"
 
 #include "GuIntersectionRayTriangle.h"
@@ -748,6 +750,344 @@ PxIntBool BV4_RaycastSingle(const PxVec3& origin, const PxVec3& dir, const BV4Tr
 
 
 
+// Packet version
+
+#ifdef GU_BV4_USE_SLABS
+namespace
+{
+	// Per-ray slab data, i.e. the SLABS_INIT values for each ray of the packet.
+	struct RayPacketLane
+	{
+		Vec4V	mInvDX;
+		Vec4V	mInvDY;
+		Vec4V	mInvDZ;
+		Vec4V	mPInvDX;
+		Vec4V	mPInvDY;
+		Vec4V	mPInvDZ;
+	};
+
+	struct RayPacketBounds
+	{
+		Vec4V	mMinX;
+		Vec4V	mMinY;
+		Vec4V	mMinZ;
+		Vec4V	mMaxX;
+		Vec4V	mMaxY;
+		Vec4V	mMaxZ;
+	};
+}
+
+// Children push order for each PNS code, see SLABS_PNS. The last pushed child is processed first.
+static const PxU8 gPacketPNSOrder[8][4] = {
+	{ 0,1,2,3 },
+	{ 0,1,3,2 },
+	{ 1,0,2,3 },
+	{ 1,0,3,2 },
+	{ 2,3,0,1 },
+	{ 3,2,0,1 },
+	{ 2,3,1,0 },
+	{ 3,2,1,0 },
+};
+
+static PX_FORCE_INLINE PxU32 getRayOctant(const PxVec3& localDir)
+{
+	const PxU32* tmp = reinterpret_cast<const PxU32*>(&localDir);
+	const PxU32 X = tmp[0]>>31;
+	const PxU32 Y = tmp[1]>>31;
+	const PxU32 Z = tmp[2]>>31;
+	return Z|(Y<<1)|(X<<2);
+}
+
+static PX_FORCE_INLINE void setupRayPacketLane(RayPacketLane& lane, const RayParams_Raycast* PX_RESTRICT params)
+{
+	// Must match SLABS_INIT exactly, so that rays of a packet cull the same nodes as single rays
+	const Vec4V rayP = V4LoadU_Safe(&params->mOrigin_Padded.x);
+	Vec4V rayD = V4LoadU_Safe(&params->mLocalDir_Padded.x);
+	const VecU32V raySign = V4U32and(VecU32V_ReinterpretFrom_Vec4V(rayD), signMask);
+	const Vec4V rayDAbs = V4Abs(rayD);
+	Vec4V rayInvD = Vec4V_ReinterpretFrom_VecU32V(V4U32or(raySign, VecU32V_ReinterpretFrom_Vec4V(V4Max(rayDAbs, epsFloat4))));
+	rayD = rayInvD;
+	rayInvD = V4RecipFast(rayInvD);
+	rayInvD = V4Mul(rayInvD, V4NegMulSub(rayD, rayInvD, twos));
+	const Vec4V rayPinvD = V4NegMulSub(rayInvD, rayP, zeroes);
+	lane.mInvDX = V4SplatElement<0>(rayInvD);
+	lane.mInvDY = V4SplatElement<1>(rayInvD);
+	lane.mInvDZ = V4SplatElement<2>(rayInvD);
+	lane.mPInvDX = V4SplatElement<0>(rayPinvD);
+	lane.mPInvDY = V4SplatElement<1>(rayPinvD);
+	lane.mPInvDZ = V4SplatElement<2>(rayPinvD);
+}
+
+// Bounds of the segments of the rays in rayMask, inflated by margin. A node that doesn't touch these bounds cannot
+// contain a hit for any ray of the packet.
+static void computeRayPacketBounds(RayPacketBounds& bounds, const RayParams_Raycast* PX_RESTRICT params, PxU32 rayMask, const Vec4V margin)
+{
+	Vec4V minV = V4Load(PX_MAX_F32);
+	Vec4V maxV = V4Load(-PX_MAX_F32);
+	while(rayMask)
+	{
+		const PxU32 r = PxLowestSetBit(rayMask);
+		rayMask &= rayMask - 1;
+
+		const Vec4V p0 = V4LoadU_Safe(&params[r].mOrigin_Padded.x);
+		const Vec4V p1 = V4ScaleAdd(V4LoadU_Safe(&params[r].mLocalDir_Padded.x), FLoad(params[r].mStabbedFace.mDistance), p0);
+		minV = V4Min(minV, V4Min(p0, p1));
+		maxV = V4Max(maxV, V4Max(p0, p1));
+	}
+	minV = V4Sub(minV, margin);
+	maxV = V4Add(maxV, margin);
+	bounds.mMinX = V4SplatElement<0>(minV);
+	bounds.mMinY = V4SplatElement<1>(minV);
+	bounds.mMinZ = V4SplatElement<2>(minV);
+	bounds.mMaxX = V4SplatElement<0>(maxV);
+	bounds.mMaxY = V4SplatElement<1>(maxV);
+	bounds.mMaxZ = V4SplatElement<2>(maxV);
+}
+
+static PX_FORCE_INLINE void getPacketNodeBoxes(	const BVDataSwizzledQ* PX_RESTRICT tn, const RayParams_Raycast* PX_RESTRICT params,
+												Vec4V& minx4a, Vec4V& miny4a, Vec4V& minz4a, Vec4V& maxx4a, Vec4V& maxy4a, Vec4V& maxz4a)
+{
+	const Vec4V minCoeffV = V4LoadA_Safe(&params->mCenterOrMinCoeff_PaddedAligned.x);
+	const Vec4V maxCoeffV = V4LoadA_Safe(&params->mExtentsOrMaxCoeff_PaddedAligned.x);
+	const Vec4V minCoeffxV = V4SplatElement<0>(minCoeffV);
+	const Vec4V minCoeffyV = V4SplatElement<1>(minCoeffV);
+	const Vec4V minCoeffzV = V4SplatElement<2>(minCoeffV);
+	const Vec4V maxCoeffxV = V4SplatElement<0>(maxCoeffV);
+	const Vec4V maxCoeffyV = V4SplatElement<1>(maxCoeffV);
+	const Vec4V maxCoeffzV = V4SplatElement<2>(maxCoeffV);
+
+	OPC_DEQ4(maxx4a, minx4a, mX, minCoeffxV, maxCoeffxV)
+	OPC_DEQ4(maxy4a, miny4a, mY, minCoeffyV, maxCoeffyV)
+	OPC_DEQ4(maxz4a, minz4a, mZ, minCoeffzV, maxCoeffzV)
+}
+
+static PX_FORCE_INLINE void getPacketNodeBoxes(	const BVDataSwizzledNQ* PX_RESTRICT tn, const RayParams_Raycast* PX_RESTRICT,
+												Vec4V& minx4a, Vec4V& miny4a, Vec4V& minz4a, Vec4V& maxx4a, Vec4V& maxy4a, Vec4V& maxz4a)
+{
+	minx4a = V4LoadA(tn->mMinX);
+	miny4a = V4LoadA(tn->mMinY);
+	minz4a = V4LoadA(tn->mMinZ);
+	maxx4a = V4LoadA(tn->mMaxX);
+	maxy4a = V4LoadA(tn->mMaxY);
+	maxz4a = V4LoadA(tn->mMaxZ);
+}
+
+static PX_FORCE_INLINE void processRaySubtree(const BVDataPackedQ* PX_RESTRICT root, PxU32 childData, RayParams_Raycast* PX_RESTRICT params)
+{
+	BV4_ProcessStreamKajiyaOrderedQ<0, LeafFunction_RaycastClosest>(root, childData, params);
+}
+
+static PX_FORCE_INLINE void processRaySubtree(const BVDataPackedNQ* PX_RESTRICT root, PxU32 childData, RayParams_Raycast* PX_RESTRICT params)
+{
+	BV4_ProcessStreamKajiyaOrderedNQ<0, LeafFunction_RaycastClosest>(root, childData, params);
+}
+
+// Closest-hit traversal of a group of rays sharing the same direction octant. This is the ordered Kajiya traversal
+// of BV4_ProcessStreamKajiyaOrderedQ/NQ, except that stack entries carry the mask of rays that reached the node. Each
+// ray sees the same nodes, in the same order and with the same culling distance as in the single-ray traversal, so it
+// returns the same hit. The packet bounds only reject nodes that cannot contain hits.
+template<class PackedT, class SwizzledT>
+static void processRayPacket(const PackedT* PX_RESTRICT root, PxU32 initData, RayParams_Raycast* PX_RESTRICT params, const RayPacketLane* PX_RESTRICT lanes,
+							PxU32 groupMask, PxU32 octant, const Vec4V margin)
+{
+	const PxU32 dirMask = 1u<<(3+octant);
+
+	PxU32 nb=1;
+	PxU32 stack[GU_BV4_STACK_SIZE];
+	PxU32 stackRays[GU_BV4_STACK_SIZE];
+	stack[0] = initData;
+	stackRays[0] = groupMask;
+
+	RayPacketBounds bounds;
+	bool boundsDirty = true;
+
+	do
+	{
+		--nb;
+		const PxU32 childData = stack[nb];
+		const PxU32 rayMask = stackRays[nb];
+
+		// The packet diverged, only one ray reached this node. Continue with the single-ray traversal.
+		if(!(rayMask & (rayMask - 1)))
+		{
+			processRaySubtree(root, childData, params + PxLowestSetBit(rayMask));
+			boundsDirty = true;
+			continue;
+		}
+
+		if(boundsDirty)
+		{
+			computeRayPacketBounds(bounds, params, groupMask, margin);
+			boundsDirty = false;
+		}
+
+		const SwizzledT* tn = reinterpret_cast<const SwizzledT*>(root + getChildOffset(childData));
+
+		Vec4V minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a;
+		getPacketNodeBoxes(tn, params, minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a);
+
+		// Packet-level culling, against the bounds of all ray segments at once
+		BoolV outside = V4IsGrtr(minx4a, bounds.mMaxX);
+		outside = BOr(outside, V4IsGrtr(miny4a, bounds.mMaxY));
+		outside = BOr(outside, V4IsGrtr(minz4a, bounds.mMaxZ));
+		outside = BOr(outside, V4IsGrtr(bounds.mMinX, maxx4a));
+		outside = BOr(outside, V4IsGrtr(bounds.mMinY, maxy4a));
+		outside = BOr(outside, V4IsGrtr(bounds.mMinZ, maxz4a));
+
+		const PxU32 nodeType = getChildType(childData);
+		const PxU32 validChildren = nodeType>1 ? 15u : (nodeType>0 ? 7u : 3u);
+		const PxU32 packetCode = ~BGetBitMask(outside) & validChildren;
+		if(!packetCode)
+			continue;
+
+		// Per-ray interval culling, i.e. SLABS_TEST & SLABS_TEST2 for each ray
+		PxU32 childRays[4] = { 0, 0, 0, 0 };
+		PxU32 activeRays = rayMask;
+		while(activeRays)
+		{
+			const PxU32 r = PxLowestSetBit(activeRays);
+			activeRays &= activeRays - 1;
+
+			const RayPacketLane& lane = lanes[r];
+			const Vec4V maxT4 = V4Load(params[r].mStabbedFace.mDistance);
+
+			const Vec4V tminxa0 = V4MulAdd(minx4a, lane.mInvDX, lane.mPInvDX);
+			const Vec4V tminya0 = V4MulAdd(miny4a, lane.mInvDY, lane.mPInvDY);
+			const Vec4V tminza0 = V4MulAdd(minz4a, lane.mInvDZ, lane.mPInvDZ);
+			const Vec4V tmaxxa0 = V4MulAdd(maxx4a, lane.mInvDX, lane.mPInvDX);
+			const Vec4V tmaxya0 = V4MulAdd(maxy4a, lane.mInvDY, lane.mPInvDY);
+			const Vec4V tmaxza0 = V4MulAdd(maxz4a, lane.mInvDZ, lane.mPInvDZ);
+			const Vec4V maxOfNeasa = V4Max(V4Max(V4Min(tminxa0, tmaxxa0), V4Min(tminya0, tmaxya0)), V4Min(tminza0, tmaxza0));
+			const Vec4V minOfFarsa = V4Min(V4Min(V4Max(tminxa0, tmaxxa0), V4Max(tminya0, tmaxya0)), V4Max(tminza0, tmaxza0));
+
+			BoolV ignore4a = V4IsGrtr(epsFloat4, minOfFarsa);
+			ignore4a = BOr(ignore4a, V4IsGrtr(maxOfNeasa, maxT4));
+			const BoolV resa4 = BOr(V4IsGrtr(maxOfNeasa, minOfFarsa), ignore4a);
+			const PxU32 code = ~BGetBitMask(resa4) & packetCode;
+
+			const PxU32 rayBit = 1u<<r;
+			if(code & 1)	childRays[0] |= rayBit;
+			if(code & 2)	childRays[1] |= rayBit;
+			if(code & 4)	childRays[2] |= rayBit;
+			if(code & 8)	childRays[3] |= rayBit;
+		}
+
+		// Leaves are processed in the same order as DO_LEAF_TEST in the single-ray traversal
+		PxU32 code2 = 0;
+		for(PxI32 x=3; x>=0; x--)
+		{
+			PxU32 leafRays = childRays[x];
+			if(!leafRays)
+				continue;
+
+			if(tn->isLeaf(PxU32(x)))
+			{
+				const PxU32 primIndex = tn->getPrimitive(PxU32(x));
+				while(leafRays)
+				{
+					const PxU32 r = PxLowestSetBit(leafRays);
+					leafRays &= leafRays - 1;
+
+					const float distance = params[r].mStabbedFace.mDistance;
+					LeafFunction_RaycastClosest::doLeafTest(params + r, primIndex);
+					if(params[r].mStabbedFace.mDistance != distance)
+						boundsDirty = true;
+				}
+			}
+			else
+				code2 |= 1u<<x;
+		}
+
+		if(code2)
+		{
+			const PxU32 bit0 = (tn->decodePNSNoShift(0) & dirMask) ? 4u : 0u;
+			const PxU32 bit1 = (tn->decodePNSNoShift(1) & dirMask) ? 2u : 0u;
+			const PxU32 bit2 = (tn->decodePNSNoShift(2) & dirMask) ? 1u : 0u;
+			const PxU8* PX_RESTRICT order = gPacketPNSOrder[bit0|bit1|bit2];
+			for(PxU32 i=0; i<4; i++)
+			{
+				const PxU32 x = order[i];
+				if(code2 & (1u<<x))
+				{
+					stack[nb] = tn->getChildData(x);
+					stackRays[nb] = childRays[x];
+					nb++;
+				}
+			}
+		}
+	}while(nb);
+}
+#endif
+
+PxU32 BV4_RaycastPacket(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags)
+{
+	PX_ASSERT(nbRays<=PX_RAY_PACKET_MAX_SIZE);
+
+	const SourceMesh* PX_RESTRICT mesh = static_cast<SourceMesh*>(tree.mMeshInterface);
+
+	RayParams_Raycast params[PX_RAY_PACKET_MAX_SIZE];
+	for(PxU32 i=0; i<nbRays; i++)
+		setupRayParams(params + i, origins[i], dirs[i], &tree, worldm_Aligned, mesh, maxDists[i], geomEpsilon, flags);
+
+	// The packet traversal is only for the closest-hit case. Any-hit queries and trees without nodes use the single-ray code.
+	if(!tree.mNodes || params[0].mEarlyExit)
+	{
+		PxU32 hitMask = 0;
+		for(PxU32 i=0; i<nbRays; i++)
+		{
+			if(BV4_RaycastSingle(origins[i], dirs[i], tree, worldm_Aligned, hits + i, maxDists[i], geomEpsilon, flags, hitFlags))
+				hitMask |= 1u<<i;
+		}
+		return hitMask;
+	}
+
+#ifdef GU_BV4_USE_SLABS
+	RayPacketLane lanes[PX_RAY_PACKET_MAX_SIZE];
+	PxU32 octantMasks[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		setupRayPacketLane(lanes[i], params + i);
+		octantMasks[getRayOctant(params[i].mLocalDir_Padded)] |= 1u<<i;
+	}
+
+	// Margin for the packet bounds. Triangle hits can be slightly outside the triangles (geomEpsilon) hence outside
+	// of the node bounds, we keep these nodes as the single-ray traversal would.
+	const LocalBounds& localBounds = tree.mLocalBounds;
+	const float boundsSize = localBounds.mExtentsMagnitude + localBounds.mCenter.abs().maxElement();
+	const Vec4V margin = V4Load(boundsSize * 1e-4f + localBounds.mExtentsMagnitude * geomEpsilon * 4.0f);
+
+	for(PxU32 octant=0; octant<8; octant++)
+	{
+		const PxU32 groupMask = octantMasks[octant];
+		if(!groupMask)
+			continue;
+
+		if(!(groupMask & (groupMask - 1)))
+		{
+			// Single ray in this octant
+			RayParams_Raycast* p = params + PxLowestSetBit(groupMask);
+			processStreamRayOrdered<0, LeafFunction_RaycastClosest>(tree, p);
+		}
+		else if(tree.mQuantized)
+			processRayPacket<BVDataPackedQ, BVDataSwizzledQ>(reinterpret_cast<const BVDataPackedQ*>(tree.mNodes), tree.mInitData, params, lanes, groupMask, octant, margin);
+		else
+			processRayPacket<BVDataPackedNQ, BVDataSwizzledNQ>(reinterpret_cast<const BVDataPackedNQ*>(tree.mNodes), tree.mInitData, params, lanes, groupMask, octant, margin);
+	}
+#else
+	for(PxU32 i=0; i<nbRays; i++)
+		processStreamRayOrdered<0, LeafFunction_RaycastClosest>(tree, params + i);
+#endif
+
+	PxU32 hitMask = 0;
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		if(computeImpactData(hits + i, params + i, worldm_Aligned, hitFlags))
+			hitMask |= 1u<<i;
+	}
+	return hitMask;
+}
+
+
 // Callback-based version
 
 namespace
@@ -329,3 +329,20 @@ bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 physx::PxMeshQuery::raycastPacket(const PxRayPacket& packet, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+										PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT rayHits, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxMeshQuery::raycastPacket(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(meshGeom.isValid(), "PxMeshQuery::raycastPacket(): geometry is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(packet.isValid(), "PxMeshQuery::raycastPacket(): ray packet is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(rayHits, "PxMeshQuery::raycastPacket(): rayHits cannot be NULL.", 0);
+
+	PX_PROFILE_ZONE("MeshQuery.raycastPacket", 0);
+
+	const TriangleMesh* tm = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+	return Midphase::raycastPacketTriangleMesh(tm, meshGeom, pose, packet, hitFlags, rayHits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
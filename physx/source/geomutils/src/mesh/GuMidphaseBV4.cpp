@@ -49,6 +49,7 @@ using namespace aos;
 #include "GuTriangleMeshBV4.h"
 #include "CmScaling.h"
 #include "CmMatrix34.h"
+#include "foundation/PxBitUtils.h"
 
 // This file contains code specific to the BV4 midphase.
 
@@ -57,6 +58,7 @@ using namespace aos;
 using namespace Cm;
 
 PxIntBool	BV4_RaycastSingle		(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hit, float maxDist, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
+PxU32		BV4_RaycastPacket		(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 PxU32		BV4_RaycastAll			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 maxNbHits, float maxDist, PxU32 stride, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 void		BV4_RaycastCB			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, float maxDist, float geomEpsilon, PxU32 flags, MeshRayCallback callback, void* userData);
 
@@ -361,6 +363,58 @@ static HitCode gRayCallback(void* userData, const PxVec3& lp0, const PxVec3& lp1
 	return HIT_NONE;
 }
 
+// Post-processing of a hit returned by raycastVsMesh() with the mesh pose as world matrix
+static PX_FORCE_INLINE void postprocessRaycastHit(PxGeomRaycastHit& hit, const PxVec3& rayDir, PxHitFlags hitFlags, bool isDoubleSided)
+{
+	PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
+
+	// PT: TODO: pass flags to BV4 code (TA34704)
+	if(hitFlags & PxHitFlag::eNORMAL)
+	{
+		dstFlags |= PxHitFlag::eNORMAL;
+		if(isDoubleSided)
+		{
+			PxVec3 normal = hit.normal;
+			// PT: figure out correct normal orientation (DE7458)
+			// - if the mesh is single-sided the normal should be the regular triangle normal N, regardless of eMESH_BOTH_SIDES.
+			// - if the mesh is double-sided the correct normal can be either N or -N. We take the one opposed to ray direction.
+			if(normal.dot(rayDir) > 0.0f)
+				normal = -normal;
+			hit.normal = normal;
+		}
+	}
+	else
+	{
+		hit.normal = PxVec3(0.0f);
+	}
+	hit.flags = dstFlags;
+}
+
+// Post-processing of a hit returned by raycastVsMesh() for a ray transformed to vertex space
+static PX_FORCE_INLINE void postprocessRaycastHitLocal(	PxGeomRaycastHit& hit, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxMat34* world2vertexSkewP,
+														const PxVec3& rayDir, PxReal distCoeff, PxHitFlags hitFlags, bool isDoubleSided)
+{
+	hit.distance	*= distCoeff;
+	hit.position	= pose.transform(meshGeom.scale.transform(hit.position));
+	PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
+
+	if(meshGeom.scale.hasNegativeDeterminant())
+		PxSwap<PxReal>(hit.u, hit.v); // have to swap the UVs though since they were computed in mesh local space
+
+	// PT: TODO: pass flags to BV4 code (TA34704)
+	// Compute additional information if needed
+	if(hitFlags & PxHitFlag::eNORMAL)
+	{
+		dstFlags |= PxHitFlag::eNORMAL;
+		hit.normal = processLocalNormal(world2vertexSkewP, &pose, hit.normal, rayDir, isDoubleSided);
+	}
+	else
+	{
+		hit.normal = PxVec3(0.0f);
+	}
+	hit.flags = dstFlags;
+}
+
 PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 											const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 											PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 stride)
@@ -379,30 +433,7 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	{
 		bool b = raycastVsMesh(*hits, tree, &pose.p.x, &pose.q.x, rayOrigin, rayDir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
 		if(b)
-		{
-			PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
-
-			// PT: TODO: pass flags to BV4 code (TA34704)
-			if(hitFlags & PxHitFlag::eNORMAL)
-			{
-				dstFlags |= PxHitFlag::eNORMAL;
-				if(isDoubleSided)
-				{
-					PxVec3 normal = hits->normal;
-					// PT: figure out correct normal orientation (DE7458)
-					// - if the mesh is single-sided the normal should be the regular triangle normal N, regardless of eMESH_BOTH_SIDES.
-					// - if the mesh is double-sided the correct normal can be either N or -N. We take the one opposed to ray direction.
-					if(normal.dot(rayDir) > 0.0f)
-						normal = -normal;
-					hits->normal = normal;
-				}
-			}
-			else
-			{
-				hits->normal = PxVec3(0.0f);
-			}
-			hits->flags = dstFlags;
-		}
+			postprocessRaycastHit(*hits, rayDir, hitFlags, isDoubleSided);
 		return PxU32(b);
 	}
 
@@ -443,27 +474,7 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	{
 		bool b = raycastVsMesh(*hits, tree, NULL, NULL, orig, dir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
 		if(b)
-		{
-			hits->distance	*= distCoeff;
-			hits->position	= pose.transform(meshGeom.scale.transform(hits->position));
-			PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
-
-			if(meshGeom.scale.hasNegativeDeterminant())
-				PxSwap<PxReal>(hits->u, hits->v); // have to swap the UVs though since they were computed in mesh local space
-
-			// PT: TODO: pass flags to BV4 code (TA34704)
-			// Compute additional information if needed
-			if(hitFlags & PxHitFlag::eNORMAL)
-			{
-				dstFlags |= PxHitFlag::eNORMAL;
-				hits->normal = processLocalNormal(world2vertexSkewP, &pose, hits->normal, rayDir, isDoubleSided);
-			}
-			else
-			{
-				hits->normal = PxVec3(0.0f);
-			}
-			hits->flags = dstFlags;
-		}
+			postprocessRaycastHitLocal(*hits, meshGeom, pose, world2vertexSkewP, rayDir, distCoeff, hitFlags, isDoubleSided);
 		return PxU32(b);
 	}
 
@@ -476,6 +487,80 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	return callback.mHitNum;
 }
 
+PxU32 physx::Gu::raycastPacket_triangleMesh_BV4(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+												const PxRayPacket& packet, PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits)
+{
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	const BV4TriangleMesh* meshData = static_cast<const BV4TriangleMesh*>(mesh);
+
+	const PxU32 nbRays = packet.nbRays;
+	if(!nbRays)
+		return 0;
+
+	const bool idtScale = meshGeom.scale.isIdentity();
+
+	const bool isDoubleSided = meshGeom.meshFlags.isSet(PxMeshGeometryFlag::eDOUBLE_SIDED);
+	const bool bothSides = isDoubleSided || (hitFlags & PxHitFlag::eMESH_BOTH_SIDES);
+	const bool anyHit = hitFlags & PxHitFlag::eANY_HIT;
+	const PxU32 flags = setupFlags(anyHit, bothSides, false);
+
+	const BV4Tree& tree = meshData->getBV4Tree();
+
+	PxVec3 rayDirs[PX_RAY_PACKET_MAX_SIZE];
+	PxVec3 origs[PX_RAY_PACKET_MAX_SIZE];
+	PxVec3 dirs[PX_RAY_PACKET_MAX_SIZE];
+	float maxDists[PX_RAY_PACKET_MAX_SIZE];
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		rayDirs[i] = packet.getDir(i);
+		origs[i] = packet.getOrigin(i);
+		maxDists[i] = packet.maxDist[i];
+	}
+
+	if(idtScale)
+	{
+		// Same as raycastVsMesh() for each ray, the BV4 code transforms the rays to mesh space
+		BV4_ALIGN16(PxMat44 World);
+		const PxMat44* TM = setupWorldMatrix(World, &pose.p.x, &pose.q.x);
+
+		const PxU32 hitMask = BV4_RaycastPacket(nbRays, origs, rayDirs, maxDists, tree, TM, hits, meshData->getGeomEpsilon(), flags, hitFlags);
+
+		PxU32 mask = hitMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			postprocessRaycastHit(hits[i], rayDirs[i], hitFlags, isDoubleSided);
+		}
+		return hitMask;
+	}
+
+	//scaling: transform the rays to vertex space
+	const PxMat34 world2vertexSkew = meshGeom.scale.getInverse() * pose.getInverse();
+	PxReal distCoeffs[PX_RAY_PACKET_MAX_SIZE];
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		origs[i] = world2vertexSkew.transform(origs[i]);
+		dirs[i] = world2vertexSkew.rotate(rayDirs[i]);
+
+		PxReal distCoeff = dirs[i].normalize();
+		maxDists[i] *= distCoeff;
+		maxDists[i] += 1e-3f;
+		distCoeffs[i] = 1.0f/distCoeff;
+	}
+
+	const PxU32 hitMask = BV4_RaycastPacket(nbRays, origs, dirs, maxDists, tree, NULL, hits, meshData->getGeomEpsilon(), flags, hitFlags);
+
+	PxU32 mask = hitMask;
+	while(mask)
+	{
+		const PxU32 i = PxLowestSetBit(mask);
+		mask &= mask - 1;
+		postprocessRaycastHitLocal(hits[i], meshGeom, pose, &world2vertexSkew, rayDirs[i], distCoeffs[i], hitFlags, isDoubleSided);
+	}
+	return hitMask;
+}
+
 namespace
 {
 struct IntersectShapeVsMeshCallback
@@ -154,6 +154,8 @@ namespace Gu
 	PX_PHYSX_COMMON_API PxU32 raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 									const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 									PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 stride);
+	PX_PHYSX_COMMON_API PxU32 raycastPacket_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+									const PxRayPacket& packet, PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits);
 	PX_PHYSX_COMMON_API bool intersectSphereVsMesh_BV4	(const Sphere& sphere,		const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectBoxVsMesh_BV4		(const Box& box,			const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectCapsuleVsMesh_BV4	(const Capsule& capsule,	const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
@@ -269,6 +271,32 @@ namespace Midphase
 		return gMidphaseRaycastTable[index](mesh, meshGeom, meshTransform, rayOrigin, rayDir, maxDist, hitFlags, maxHits, hits, stride);
 	}
 
+	// \param[in]	mesh			triangle mesh to raycast against
+	// \param[in]	meshGeom		geometry object associated with the mesh
+	// \param[in]	meshTransform	pose/transform of geometry object
+	// \param[in]	packet			rays to test, with unit dirs
+	// \param[in]	hitFlags		query behavior flags
+	// \param[out]	hits			result buffer where to write raycast hits, one per ray of the packet
+	// \return		bit mask of rays that hit the mesh
+	// \note		only the closest hit is reported for each ray, eMESH_MULTIPLE is ignored.
+	PX_FORCE_INLINE PxU32 raycastPacketTriangleMesh(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshTransform,
+													const PxRayPacket& packet, PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits)
+	{
+		hitFlags &= ~PxHitFlag::eMESH_MULTIPLE;
+
+		if(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34)
+			return raycastPacket_triangleMesh_BV4(mesh, meshGeom, meshTransform, packet, hitFlags, hits);
+
+		// No packet traversal for the RTree midphase
+		PxU32 hitMask = 0;
+		for(PxU32 i=0; i<packet.nbRays; i++)
+		{
+			if(raycast_triangleMesh_RTREE(mesh, meshGeom, meshTransform, packet.getOrigin(i), packet.getDir(i), packet.maxDist[i], hitFlags, 1, hits + i, sizeof(PxGeomRaycastHit)))
+				hitMask |= 1u<<i;
+		}
+		return hitMask;
+	}
+
 	// \param[in]	sphere			sphere
 	// \param[in]	mesh			triangle mesh
 	// \param[in]	meshTransform	pose/transform of triangle mesh
@@ -86,27 +86,6 @@ static PX_FORCE_INLINE PxgCudaBroadPhaseSap& getGPUBroadPhase(BroadPhase& bp)
 	return static_cast<PxgCudaBroadPhaseSap&>(bp);
 }
 
-static void initEnvEntry(PxInt32ArrayPinned& envIDs, BoundsIndex index, PxU32 envID, PxU32 boundsSize)
-{
-	// PT: we avoid allocating anything when the feature is not used, and allocate everything lazily
-	// as soon as a non-default environment ID is needed. We need 'boundsSize' to make sure we allocate
-	// a large enough array when setEnvironmentID() is called after some objects have already been created
-	// and the scene already simulated. See EnvIDTests_GPU.EnvironmentID_EdgeCase for why is it needed.
-
-	const bool validEntry = envID != PX_INVALID_U32;
-
-	const PxU32 currentSize = envIDs.size();
-
-	if(validEntry || currentSize)
-	{
-		if((index + 1) >= currentSize)
-			envIDs.resize(PxMax(boundsSize, PxNextPowerOfTwo(index + 1)), PX_INVALID_U32);
-	}
-
-	if(validEntry || index < envIDs.size())
-		envIDs[index] = envID;
-}
-
 PxgAggregateBuffer::PxgAggregateBuffer(PxgHeapMemoryAllocatorManager* heapMemoryManager) :
 	updateBoundIndices(heapMemoryManager, PxsHeapStats::eBROADPHASE),
 	boundIndices(heapMemoryManager, PxsHeapStats::eBROADPHASE),
@@ -362,7 +341,7 @@ bool PxgAABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Filter
 		mPersistentStateChanged = true;
 		mAggregatedBoundMap.growAndReset(index);
 
-		initEnvEntry(mEnvIDs, index, envID, mBoundsArray.size());
+		initEnvEntry(index, envID);
 	}
 	else
 	{
@@ -401,7 +380,7 @@ bool PxgAABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Filter
 		}
 
 		// PT: for aggregates we retrieve the environment ID from the aggregate itself.
-		initEnvEntry(mEnvIDs, aggregate.mIndex, aggregate.mEnvID, mBoundsArray.size());
+		initEnvEntry(aggregate.mIndex, aggregate.mEnvID);
 
 		mAddedAggregatedBounds.pushBack(index);
 	}
@@ -705,6 +705,14 @@ static void layOutHeightfield(void* mem, const HeightFieldData& hf)
 	PxU32 nbRows = hf.rows;
 	PxU32 nbCols = hf.columns;
 
+	// Tiled heightfields have no sample array. They are uploaded as empty heightfields.
+	if(!hf.samples)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxgGeometryManager: tiled heightfields are not supported by GPU narrowphase, no contacts will be generated for them.");
+		nbRows = 0;
+		nbCols = 0;
+	}
+
 	*((PxU32* ) m) = nbRows;
 	m += sizeof(PxU32);
 
@@ -0,0 +1,1385 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "PxImmediateWorld.h"
+#include "PxBroadPhase.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxGeometryQuery.h"
+#include "task/PxParallelFor.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxFoundation.h"
+#include "common/PxProfileZone.h"
+
+using namespace physx;
+using namespace immediate;
+
+PX_IMPLEMENT_OUTPUT_ERROR
+
+#define IMM_WORLD_PAGE_SIZE			(32*1024)
+#define IMM_WORLD_BOUNDS_CHUNK_SIZE	256
+
+namespace
+{
+	// Bump allocator for data that lives one or two frames. Pages are kept between frames so that nothing gets
+	// allocated once the simulation has reached a steady state.
+	class FrameAllocator
+	{
+		PX_NOCOPY(FrameAllocator)
+		public:
+					FrameAllocator() : mCurrentPage(0), mOffset(0)	{}
+					~FrameAllocator()
+					{
+						const PxU32 nbPages = mPages.size();
+						for(PxU32 i=0;i<nbPages;i++)
+							PX_FREE(mPages[i].mMemory);
+					}
+
+		PxU8*		allocate(PxU32 size)
+		{
+			size = (size + 15) & ~15;
+			while(mCurrentPage < mPages.size())
+			{
+				const Page& page = mPages[mCurrentPage];
+				if(mOffset + size <= page.mSize)
+				{
+					PxU8* memory = page.mMemory + mOffset;
+					mOffset += size;
+					return memory;
+				}
+				mCurrentPage++;
+				mOffset = 0;
+			}
+
+			// Requests larger than a page get a dedicated page
+			Page page;
+			page.mSize = PxMax(size, PxU32(IMM_WORLD_PAGE_SIZE));
+			page.mMemory = PX_ALLOCATE(PxU8, page.mSize, "FrameAllocator");
+			mPages.pushBack(page);
+			mOffset = size;
+			return page.mMemory;
+		}
+
+		void		reset()
+		{
+			mCurrentPage = 0;
+			mOffset = 0;
+		}
+
+		private:
+		struct Page
+		{
+			PxU8*	mMemory;
+			PxU32	mSize;
+		};
+
+		PxArray<Page>	mPages;
+		PxU32			mCurrentPage;
+		PxU32			mOffset;
+	};
+
+	// Contact caches written in frame N are read in frame N+1, so they are double-buffered
+	class ImmCacheAllocator : public PxCacheAllocator
+	{
+		public:
+						ImmCacheAllocator() : mIndex(0)	{}
+
+		virtual	PxU8*	allocateCacheData(const PxU32 byteSize)	PX_OVERRIDE	{ return mBuffers[mIndex].allocate(byteSize);	}
+
+				void	flip()
+				{
+					mIndex ^= 1;
+					mBuffers[mIndex].reset();
+				}
+
+		FrameAllocator	mBuffers[2];
+		PxU32			mIndex;
+	};
+
+	// Constraint data only lives during the step, but friction patches are retained for one frame, like contact caches
+	class ImmConstraintAllocator : public PxConstraintAllocator
+	{
+		public:
+						ImmConstraintAllocator() : mIndex(0)	{}
+
+		virtual	PxU8*	reserveConstraintData(const PxU32 byteSize)	PX_OVERRIDE	{ return mConstraints.allocate(byteSize);		}
+		virtual	PxU8*	reserveFrictionData(const PxU32 byteSize)	PX_OVERRIDE	{ return mFrictions[mIndex].allocate(byteSize);	}
+
+				void	flip()
+				{
+					mIndex ^= 1;
+					mFrictions[mIndex].reset();
+					mConstraints.reset();
+				}
+
+		FrameAllocator	mConstraints;
+		FrameAllocator	mFrictions[2];
+		PxU32			mIndex;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////
+
+	enum BodyFlag
+	{
+		eBODY_ALIVE		= (1<<0),
+		eBODY_DYNAMIC	= (1<<1)
+	};
+
+	// Cold per-body data, only read when building solver bodies and contacts
+	struct ImmBodyProperties
+	{
+		PxVec3	mInvInertia;
+		PxReal	mInvMass;
+		PxReal	mLinearDamping;
+		PxReal	mAngularDamping;
+		PxReal	mMaxLinearVelocitySq;
+		PxReal	mMaxAngularVelocitySq;
+		PxReal	mMaxDepenetrationVelocity;
+		PxReal	mMaxContactImpulse;
+		PxReal	mStaticFriction;
+		PxReal	mDynamicFriction;
+		PxReal	mRestitution;
+	};
+
+	// A broadphase pair. mBody0 is always dynamic. The cache and friction patches persist for the lifetime of the pair.
+	struct ImmPair
+	{
+		PxU32	mBody0;
+		PxU32	mBody1;
+		PxCache	mCache;
+		PxU8*	mFrictionPatches;
+		PxU32	mNbFrictionPatches;
+
+		// Narrowphase results for the current frame
+		PxU32	mNpChunk;
+		PxU32	mStartContact;
+		PxU32	mNbContacts;
+	};
+
+	struct ImmJoint
+	{
+		PxU32					mBody0;
+		PxU32					mBody1;
+		PxImmediateConstraint	mConstraint;	// Prep is NULL for free entries
+		PxConstraintFlags		mFlags;
+		PxReal					mMinResponseThreshold;
+	};
+
+	// Narrowphase output of a chunk of pairs
+	struct ImmNpChunk : public PxUserAllocated
+	{
+		PxArray<PxContactPoint>	mContacts;
+		ImmCacheAllocator		mCacheAllocator;
+	};
+
+	// A group of islands solved by the same task. The arrays are kept from one frame to the next.
+	struct ImmSolverBatch : public PxUserAllocated
+	{
+		PxU32								mStartBody;
+		PxU32								mNbBodies;
+		PxU32								mStartPair;
+		PxU32								mNbPairs;
+		PxU32								mStartJoint;
+		PxU32								mNbJoints;
+
+		ImmConstraintAllocator				mAllocator;
+
+		PxArray<PxRigidBodyData>			mRigidData;
+		PxArray<PxSolverConstraintDesc>		mDescs;
+		PxArray<PxSolverConstraintDesc>		mOrderedDescs;
+		PxArray<PxConstraintBatchHeader>	mHeaders;
+
+		// PGS
+		PxArray<PxSolverBodyData>			mBodyData;
+		PxArray<PxSolverBody>				mBodies;
+		PxArray<PxVec3>						mMotionLinearVelocities;
+		PxArray<PxVec3>						mMotionAngularVelocities;
+
+		// TGS
+		PxArray<PxTGSSolverBodyVel>			mTGSBodies;
+		PxArray<PxTGSSolverBodyTxInertia>	mTxInertias;
+		PxArray<PxTGSSolverBodyData>		mTGSBodyData;
+		PxArray<PxTransform>				mPoses;
+	};
+
+	struct ImmStepParams
+	{
+		PxReal	mDt;
+		PxReal	mInvDt;
+		PxReal	mStepDt;
+		PxReal	mInvStepDt;
+	};
+
+	class ImmContactRecorder : public PxContactRecorder
+	{
+		PX_NOCOPY(ImmContactRecorder)
+		public:
+						ImmContactRecorder(PxArray<PxContactPoint>& contacts) : mContacts(contacts), mPair(NULL), mStaticFriction(0.0f), mDynamicFriction(0.0f), mRestitution(0.0f)	{}
+
+		virtual	bool	recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 /*index*/)	PX_OVERRIDE
+		{
+			mPair->mStartContact = mContacts.size();
+			mPair->mNbContacts = nbContacts;
+
+			for(PxU32 i=0;i<nbContacts;i++)
+			{
+				// Fill in the solver data that contact generation does not produce
+				PxContactPoint& point = mContacts.insert();
+				point					= contactPoints[i];
+				point.maxImpulse		= PX_MAX_F32;
+				point.targetVel			= PxVec3(0.0f);
+				point.staticFriction	= mStaticFriction;
+				point.dynamicFriction	= mDynamicFriction;
+				point.restitution		= mRestitution;
+				point.damping			= 0.0f;
+				point.materialFlags		= 0;
+			}
+			return true;
+		}
+
+		PxArray<PxContactPoint>&	mContacts;
+		ImmPair*					mPair;
+		PxReal						mStaticFriction;
+		PxReal						mDynamicFriction;
+		PxReal						mRestitution;
+	};
+
+	PX_FORCE_INLINE PxU64 getPairKey(PxU32 id0, PxU32 id1)
+	{
+		if(id0>id1)
+			PxSwap(id0, id1);
+		return PxU64(id0)|(PxU64(id1)<<32);
+	}
+
+	PX_FORCE_INLINE void setupBodies(PxSolverConstraintPrepDescBase& prepDesc, const PxSolverConstraintDesc& desc, const ImmSolverBatch& batch)
+	{
+		prepDesc.body0		= desc.bodyA;
+		prepDesc.body1		= desc.bodyB;
+		prepDesc.data0		= &batch.mBodyData[desc.bodyADataIndex];
+		prepDesc.data1		= &batch.mBodyData[desc.bodyBDataIndex];
+		prepDesc.bodyFrame0	= prepDesc.data0->body2World;
+		prepDesc.bodyFrame1	= prepDesc.data1->body2World;
+	}
+
+	PX_FORCE_INLINE void setupBodies(PxTGSSolverConstraintPrepDescBase& prepDesc, const PxSolverConstraintDesc& desc, const ImmSolverBatch& batch)
+	{
+		prepDesc.body0		= desc.tgsBodyA;
+		prepDesc.body1		= desc.tgsBodyB;
+		prepDesc.bodyData0	= &batch.mTGSBodyData[desc.bodyADataIndex];
+		prepDesc.bodyData1	= &batch.mTGSBodyData[desc.bodyBDataIndex];
+		prepDesc.body0TxI	= &batch.mTxInertias[desc.bodyADataIndex];
+		prepDesc.body1TxI	= &batch.mTxInertias[desc.bodyBDataIndex];
+		prepDesc.bodyFrame0	= batch.mPoses[desc.bodyADataIndex];
+		prepDesc.bodyFrame1	= batch.mPoses[desc.bodyBDataIndex];
+	}
+
+	///////////////////////////////////////////////////////////////////////////////
+
+	class ImmWorld : public PxImmediateWorld, public PxUserAllocated
+	{
+		PX_NOCOPY(ImmWorld)
+		public:
+												ImmWorld(const PxImmediateWorldDesc& desc);
+		virtual									~ImmWorld();
+
+				bool							init();
+
+		// PxImmediateWorld
+		virtual	void							release()	PX_OVERRIDE	PX_FINAL	{ PX_DELETE_THIS;	}
+		virtual	PxImmediateBodyHandle			addBody(const PxImmediateBodyDesc& desc)	PX_OVERRIDE	PX_FINAL;
+		virtual	void							removeBody(PxImmediateBodyHandle body)	PX_OVERRIDE	PX_FINAL;
+		virtual	PxImmediateJointHandle			addJoint(const PxImmediateJointDesc& desc)	PX_OVERRIDE	PX_FINAL;
+		virtual	void							removeJoint(PxImmediateJointHandle joint)	PX_OVERRIDE	PX_FINAL;
+		virtual	PxU32							getNbBodies()			const	PX_OVERRIDE	PX_FINAL	{ return mNbBodies;						}
+		virtual	PxU32							getNbJoints()			const	PX_OVERRIDE	PX_FINAL	{ return mNbJoints;						}
+		virtual	PxU32							getBodyCapacity()		const	PX_OVERRIDE	PX_FINAL	{ return mPoses.size();					}
+		virtual	const PxTransform*				getPoses()				const	PX_OVERRIDE	PX_FINAL	{ return mPoses.begin();				}
+		virtual	const PxVec3*					getLinearVelocities()	const	PX_OVERRIDE	PX_FINAL	{ return mLinearVelocities.begin();		}
+		virtual	const PxVec3*					getAngularVelocities()	const	PX_OVERRIDE	PX_FINAL	{ return mAngularVelocities.begin();	}
+		virtual	void							setPose(PxImmediateBodyHandle body, const PxTransform& pose)	PX_OVERRIDE	PX_FINAL;
+		virtual	void							setVelocities(PxImmediateBodyHandle body, const PxVec3& linearVelocity, const PxVec3& angularVelocity)	PX_OVERRIDE	PX_FINAL;
+		virtual	void*							getUserData(PxImmediateBodyHandle body)	const	PX_OVERRIDE	PX_FINAL;
+		virtual	void							setGravity(const PxVec3& gravity)	PX_OVERRIDE	PX_FINAL	{ mGravity = gravity;	}
+		virtual	PxVec3							getGravity()	const	PX_OVERRIDE	PX_FINAL	{ return mGravity;		}
+		virtual	void							step(PxReal dt)	PX_OVERRIDE	PX_FINAL;
+		virtual	void							getStats(PxImmediateWorldStats& stats)	const	PX_OVERRIDE	PX_FINAL	{ stats = mStats;	}
+		//~PxImmediateWorld
+
+		PX_FORCE_INLINE	bool					isAlive(PxU32 body)		const	{ return body<mBodyFlags.size() && (mBodyFlags[body] & eBODY_ALIVE);	}
+		PX_FORCE_INLINE	bool					isDynamic(PxU32 body)	const	{ return body!=PX_IMMEDIATE_INVALID_HANDLE && (mBodyFlags[body] & eBODY_DYNAMIC);	}
+		PX_FORCE_INLINE	PxTransform				getShapePose(PxU32 body)	const	{ return mPoses[body].transform(mShapeLocalPoses[body]);	}
+
+				void							computeBounds(PxU32 body);
+				void							processNarrowPhaseChunk(PxU32 chunkIndex);
+				void							solveBatch(ImmSolverBatch& batch, const ImmStepParams& params);
+
+		private:
+				void							addPair(PxU32 id0, PxU32 id1);
+				void							removePairAt(PxU32 index);
+				void							purgePairs();
+				void							updateBroadPhase();
+				void							runNarrowPhase();
+				void							buildIslands();
+				void							solveIslands(PxReal dt);
+
+				PxU32							findIsland(PxU32 body);
+				void							uniteIslands(PxU32 body0, PxU32 body1);
+
+				PxU32							getSolverBodyIndex(PxU32 body, PxU32& staticIndex, ImmSolverBatch& batch)	const;
+
+				template<class ContactDescT, class JointDescT>
+				void							createConstraints(ImmSolverBatch& batch, PxU32 nbContactHeaders, PxU32 nbHeaders, const ImmStepParams& params);
+
+				PX_FORCE_INLINE	void			createContacts(PxConstraintBatchHeader& header, PxSolverContactDesc* descs, PxConstraintAllocator& allocator, const ImmStepParams& params)	const
+												{
+													PxCreateContactConstraints(&header, 1, descs, allocator, params.mInvDt, -mBounceThresholdVelocity, mFrictionOffsetThreshold, mFrictionCorrelationDistance);
+												}
+
+				PX_FORCE_INLINE	void			createContacts(PxConstraintBatchHeader& header, PxTGSSolverContactDesc* descs, PxConstraintAllocator& allocator, const ImmStepParams& params)	const
+												{
+													PxCreateContactConstraintsTGS(&header, 1, descs, allocator, params.mInvStepDt, params.mInvDt, -mBounceThresholdVelocity, mFrictionOffsetThreshold, mFrictionCorrelationDistance);
+												}
+
+				PX_FORCE_INLINE	void			createJoints(PxConstraintBatchHeader& header, PxImmediateConstraint* constraints, PxSolverConstraintPrepDesc* descs, PxConstraintAllocator& allocator, const ImmStepParams& params)	const
+												{
+													PxCreateJointConstraintsWithImmediateShaders(&header, 1, constraints, descs, allocator, params.mDt, params.mInvDt);
+												}
+
+				PX_FORCE_INLINE	void			createJoints(PxConstraintBatchHeader& header, PxImmediateConstraint* constraints, PxTGSSolverConstraintPrepDesc* descs, PxConstraintAllocator& allocator, const ImmStepParams& params)	const
+												{
+													PxCreateJointConstraintsWithImmediateShadersTGS(&header, 1, constraints, descs, allocator, params.mStepDt, params.mDt, params.mInvStepDt, params.mInvDt, mToleranceLength);
+												}
+
+				// Parameters
+				PxVec3							mGravity;
+				const PxSolverType::Enum		mSolverType;
+				PxCpuDispatcher*				mDispatcher;
+				const PxU32						mNbPositionIterations;
+				const PxU32						mNbVelocityIterations;
+				const PxReal					mContactDistance;
+				const PxReal					mMeshContactMargin;
+				const PxReal					mToleranceLength;
+				const PxReal					mBounceThresholdVelocity;
+				const PxReal					mFrictionOffsetThreshold;
+				const PxReal					mFrictionCorrelationDistance;
+				const PxU32						mNbPairsPerTask;
+				const PxU32						mNbBodiesPerBatch;
+				const PxU64						mContextID;
+
+				PxBroadPhase*					mBroadPhase;
+				PxAABBManager*					mAABBManager;
+
+				// Body data, indexed by body handle
+				PxArray<PxTransform>			mPoses;
+				PxArray<PxVec3>					mLinearVelocities;
+				PxArray<PxVec3>					mAngularVelocities;
+				PxArray<PxBounds3>				mBounds;
+				PxArray<PxU8>					mBodyFlags;
+				PxArray<PxTransform>			mShapeLocalPoses;
+				PxArray<PxGeometryHolder>		mGeometries;
+				PxArray<ImmBodyProperties>		mProperties;
+				PxArray<void*>					mUserData;
+				PxArray<PxU32>					mFreeBodies;
+				PxArray<PxU32>					mRemovedBodies;	// Handles are only recycled after the broadphase has seen the removal
+				PxU32							mNbBodies;
+				bool							mPurgePairs;
+
+				// Pairs are kept in a dense array, the hash map gives the index of a pair from its key
+				PxArray<ImmPair>				mPairs;
+				PxHashMap<PxU64, PxU32>			mPairMap;
+
+				PxArray<ImmJoint>				mJoints;
+				PxArray<PxU32>					mFreeJoints;
+				PxU32							mNbJoints;
+
+				PxArray<ImmNpChunk*>			mNpChunks;
+
+				// Islands, indexed by body handle
+				PxArray<PxU32>					mIslandParents;
+				PxArray<PxU32>					mBodyIslands;
+				PxArray<PxU32>					mLocalIndices;
+				PxArray<PxU32>					mIslandSizes;
+				PxArray<PxU32>					mIslandBatches;
+
+				// Solver batches, and the bodies / pairs / joints of all batches sorted by batch
+				PxArray<ImmSolverBatch*>		mBatches;
+				PxU32							mNbBatches;
+				PxArray<PxU32>					mBatchBodies;
+				PxArray<PxU32>					mBatchPairs;
+				PxArray<PxU32>					mBatchJoints;
+
+				PxImmediateWorldStats			mStats;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////
+
+	class BoundsWork : public PxParallelForWork
+	{
+		PX_NOCOPY(BoundsWork)
+		public:
+						BoundsWork(ImmWorld& world, PxU32 nbBodies) : mWorld(world), mNbBodies(nbBodies)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 start = index * IMM_WORLD_BOUNDS_CHUNK_SIZE;
+			const PxU32 end = PxMin(start + IMM_WORLD_BOUNDS_CHUNK_SIZE, mNbBodies);
+			for(PxU32 i=start;i<end;i++)
+			{
+				if(mWorld.isAlive(i) && mWorld.isDynamic(i))
+					mWorld.computeBounds(i);
+			}
+		}
+
+		ImmWorld&	mWorld;
+		const PxU32	mNbBodies;
+	};
+
+	class NarrowPhaseWork : public PxParallelForWork
+	{
+		PX_NOCOPY(NarrowPhaseWork)
+		public:
+						NarrowPhaseWork(ImmWorld& world) : mWorld(world)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			mWorld.processNarrowPhaseChunk(index);
+		}
+
+		ImmWorld&	mWorld;
+	};
+
+	class SolveWork : public PxParallelForWork
+	{
+		PX_NOCOPY(SolveWork)
+		public:
+						SolveWork(ImmWorld& world, ImmSolverBatch** batches, const ImmStepParams& params) : mWorld(world), mBatches(batches), mParams(params)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			mWorld.solveBatch(*mBatches[index], mParams);
+		}
+
+		ImmWorld&				mWorld;
+		ImmSolverBatch**		mBatches;
+		const ImmStepParams&	mParams;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ImmWorld::ImmWorld(const PxImmediateWorldDesc& desc) :
+	mGravity					(desc.gravity),
+	mSolverType					(desc.solverType),
+	mDispatcher					(desc.cpuDispatcher),
+	mNbPositionIterations		(desc.nbPositionIterations),
+	mNbVelocityIterations		(desc.nbVelocityIterations),
+	mContactDistance			(desc.contactDistance),
+	mMeshContactMargin			(desc.meshContactMargin),
+	mToleranceLength			(desc.toleranceLength),
+	mBounceThresholdVelocity	(desc.bounceThresholdVelocity),
+	mFrictionOffsetThreshold	(desc.frictionOffsetThreshold),
+	mFrictionCorrelationDistance(desc.frictionCorrelationDistance),
+	mNbPairsPerTask				(desc.nbPairsPerTask),
+	mNbBodiesPerBatch			(desc.nbBodiesPerBatch),
+	mContextID					(desc.contextID),
+	mBroadPhase					(NULL),
+	mAABBManager				(NULL),
+	mNbBodies					(0),
+	mPurgePairs					(false),
+	mNbJoints					(0),
+	mNbBatches					(0)
+{
+	PxMemZero(&mStats, sizeof(PxImmediateWorldStats));
+}
+
+ImmWorld::~ImmWorld()
+{
+	PX_RELEASE(mAABBManager);
+	PX_RELEASE(mBroadPhase);
+
+	const PxU32 nbChunks = mNpChunks.size();
+	for(PxU32 i=0;i<nbChunks;i++)
+		PX_DELETE(mNpChunks[i]);
+
+	const PxU32 nbBatches = mBatches.size();
+	for(PxU32 i=0;i<nbBatches;i++)
+		PX_DELETE(mBatches[i]);
+}
+
+bool ImmWorld::init()
+{
+	PxBroadPhaseDesc bpDesc(PxBroadPhaseType::eABP);
+	bpDesc.mContextID = mContextID;
+	mBroadPhase = PxCreateBroadPhase(bpDesc);
+	if(!mBroadPhase)
+		return false;
+
+	mAABBManager = PxCreateAABBManager(*mBroadPhase);
+	return mAABBManager!=NULL;
+}
+
+void ImmWorld::computeBounds(PxU32 body)
+{
+	PxGeometryQuery::computeGeomBounds(mBounds[body], mGeometries[body].any(), getShapePose(body));
+}
+
+PxImmediateBodyHandle ImmWorld::addBody(const PxImmediateBodyDesc& desc)
+{
+	if(!desc.isValid() || !PxGeometryQuery::isValid(*desc.geometry))
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxImmediateWorld::addBody: invalid body descriptor");
+		return PX_IMMEDIATE_INVALID_HANDLE;
+	}
+
+	const bool isDynamic = desc.invMass!=0.0f;
+	if(isDynamic && desc.geometry->getType()==PxGeometryType::ePLANE)
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxImmediateWorld::addBody: planes must be static");
+		return PX_IMMEDIATE_INVALID_HANDLE;
+	}
+
+	PxU32 handle;
+	if(mFreeBodies.size())
+	{
+		handle = mFreeBodies.popBack();
+	}
+	else
+	{
+		handle = mPoses.size();
+		mPoses.insert();
+		mLinearVelocities.insert();
+		mAngularVelocities.insert();
+		mBounds.insert();
+		mBodyFlags.insert();
+		mShapeLocalPoses.insert();
+		mGeometries.insert();
+		mProperties.insert();
+		mUserData.insert();
+	}
+
+	mPoses[handle]				= desc.pose;
+	mLinearVelocities[handle]	= isDynamic ? desc.linearVelocity : PxVec3(0.0f);
+	mAngularVelocities[handle]	= isDynamic ? desc.angularVelocity : PxVec3(0.0f);
+	mBodyFlags[handle]			= PxU8(isDynamic ? eBODY_ALIVE|eBODY_DYNAMIC : eBODY_ALIVE);
+	mShapeLocalPoses[handle]	= desc.shapeLocalPose;
+	mGeometries[handle].storeAny(*desc.geometry);
+	mUserData[handle]			= desc.userData;
+
+	ImmBodyProperties& props = mProperties[handle];
+	props.mInvInertia				= desc.invInertia;
+	props.mInvMass					= desc.invMass;
+	props.mLinearDamping			= desc.linearDamping;
+	props.mAngularDamping			= desc.angularDamping;
+	props.mMaxLinearVelocitySq		= desc.maxLinearVelocitySq;
+	props.mMaxAngularVelocitySq		= desc.maxAngularVelocitySq;
+	props.mMaxDepenetrationVelocity	= desc.maxDepenetrationVelocity;
+	props.mMaxContactImpulse		= desc.maxContactImpulse;
+	props.mStaticFriction			= desc.staticFriction;
+	props.mDynamicFriction			= desc.dynamicFriction;
+	props.mRestitution				= desc.restitution;
+
+	computeBounds(handle);
+	const PxBpFilterGroup group = isDynamic ? PxGetBroadPhaseDynamicFilterGroup(handle) : PxGetBroadPhaseStaticFilterGroup();
+	mAABBManager->addObject(handle, mBounds[handle], group, mContactDistance);
+
+	mNbBodies++;
+	return handle;
+}
+
+void ImmWorld::removeBody(PxImmediateBodyHandle body)
+{
+	PX_CHECK_AND_RETURN(isAlive(body), "PxImmediateWorld::removeBody: invalid body handle");
+
+	const PxU32 nbJoints = mJoints.size();
+	for(PxU32 i=0;i<nbJoints;i++)
+	{
+		const ImmJoint& joint = mJoints[i];
+		if(joint.mConstraint.prep && (joint.mBody0==body || joint.mBody1==body))
+			removeJoint(i);
+	}
+
+	mAABBManager->removeObject(body);
+	mBodyFlags[body] = 0;
+	mRemovedBodies.pushBack(body);
+	mPurgePairs = true;
+	mNbBodies--;
+}
+
+PxImmediateJointHandle ImmWorld::addJoint(const PxImmediateJointDesc& desc)
+{
+	const bool validBody0 = desc.body0==PX_IMMEDIATE_INVALID_HANDLE || isAlive(desc.body0);
+	const bool validBody1 = desc.body1==PX_IMMEDIATE_INVALID_HANDLE || isAlive(desc.body1);
+	if(!desc.isValid() || !validBody0 || !validBody1 || (!isDynamic(desc.body0) && !isDynamic(desc.body1)))
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxImmediateWorld::addJoint: invalid joint descriptor");
+		return PX_IMMEDIATE_INVALID_HANDLE;
+	}
+
+	PxU32 handle;
+	if(mFreeJoints.size())
+	{
+		handle = mFreeJoints.popBack();
+	}
+	else
+	{
+		handle = mJoints.size();
+		mJoints.insert();
+	}
+
+	ImmJoint& joint = mJoints[handle];
+	joint.mBody0				= desc.body0;
+	joint.mBody1				= desc.body1;
+	joint.mConstraint			= desc.constraint;
+	joint.mFlags				= desc.flags;
+	joint.mMinResponseThreshold	= desc.minResponseThreshold;
+
+	mNbJoints++;
+	return handle;
+}
+
+void ImmWorld::removeJoint(PxImmediateJointHandle joint)
+{
+	PX_CHECK_AND_RETURN(joint<mJoints.size() && mJoints[joint].mConstraint.prep, "PxImmediateWorld::removeJoint: invalid joint handle");
+
+	mJoints[joint].mConstraint.prep = NULL;
+	mFreeJoints.pushBack(joint);
+	mNbJoints--;
+}
+
+void ImmWorld::setPose(PxImmediateBodyHandle body, const PxTransform& pose)
+{
+	PX_CHECK_AND_RETURN(isAlive(body), "PxImmediateWorld::setPose: invalid body handle");
+	PX_CHECK_AND_RETURN(pose.isSane(), "PxImmediateWorld::setPose: invalid pose");
+
+	mPoses[body] = pose;
+
+	// Bounds of dynamic bodies are recomputed in each step anyway
+	if(!isDynamic(body))
+	{
+		computeBounds(body);
+		mAABBManager->updateObject(body, &mBounds[body]);
+	}
+}
+
+void ImmWorld::setVelocities(PxImmediateBodyHandle body, const PxVec3& linearVelocity, const PxVec3& angularVelocity)
+{
+	PX_CHECK_AND_RETURN(isAlive(body) && isDynamic(body), "PxImmediateWorld::setVelocities: invalid body handle");
+	PX_CHECK_AND_RETURN(linearVelocity.isFinite() && angularVelocity.isFinite(), "PxImmediateWorld::setVelocities: invalid velocity");
+
+	mLinearVelocities[body] = linearVelocity;
+	mAngularVelocities[body] = angularVelocity;
+}
+
+void* ImmWorld::getUserData(PxImmediateBodyHandle body) const
+{
+	PX_CHECK_AND_RETURN_NULL(isAlive(body), "PxImmediateWorld::getUserData: invalid body handle");
+
+	return mUserData[body];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ImmWorld::addPair(PxU32 id0, PxU32 id1)
+{
+	// Static-vs-static pairs are filtered out by the broadphase, so one of the bodies is dynamic
+	if(!isDynamic(id0))
+		PxSwap(id0, id1);
+	PX_ASSERT(isDynamic(id0));
+
+	const bool inserted = mPairMap.insert(getPairKey(id0, id1), mPairs.size());
+	PX_ASSERT(inserted);
+	PX_UNUSED(inserted);
+
+	ImmPair& pair = mPairs.insert();
+	pair.mBody0				= id0;
+	pair.mBody1				= id1;
+	pair.mCache				= PxCache();
+	pair.mFrictionPatches	= NULL;
+	pair.mNbFrictionPatches	= 0;
+	pair.mNpChunk			= 0;
+	pair.mStartContact		= 0;
+	pair.mNbContacts		= 0;
+}
+
+void ImmWorld::removePairAt(PxU32 index)
+{
+	mPairMap.erase(getPairKey(mPairs[index].mBody0, mPairs[index].mBody1));
+
+	const PxU32 last = mPairs.size() - 1;
+	if(index!=last)
+	{
+		mPairs[index] = mPairs[last];
+		mPairMap[getPairKey(mPairs[index].mBody0, mPairs[index].mBody1)] = index;
+	}
+	mPairs.popBack();
+}
+
+// Drops the pairs of removed bodies. The broadphase might report them as lost in the next update, these reports are then ignored.
+void ImmWorld::purgePairs()
+{
+	PxU32 i = 0;
+	while(i<mPairs.size())
+	{
+		const ImmPair& pair = mPairs[i];
+		if(!isAlive(pair.mBody0) || !isAlive(pair.mBody1))
+			removePairAt(i);
+		else
+			i++;
+	}
+	mPurgePairs = false;
+}
+
+void ImmWorld::updateBroadPhase()
+{
+	PX_PROFILE_ZONE("PxImmediateWorld.updateBroadPhase", mContextID);
+
+	const PxU32 capacity = mPoses.size();
+	{
+		PX_PROFILE_ZONE("PxImmediateWorld.computeBounds", mContextID);
+
+		BoundsWork work(*this, capacity);
+		PxParallelFor(mDispatcher, work, PxParallelForGetNbChunks(capacity, IMM_WORLD_BOUNDS_CHUNK_SIZE), "PxImmediateWorld.step");
+
+		for(PxU32 i=0;i<capacity;i++)
+		{
+			if(isAlive(i) && isDynamic(i))
+				mAABBManager->updateObject(i, &mBounds[i]);
+		}
+	}
+
+	PxBroadPhaseResults results;
+	mAABBManager->updateAndFetchResults(results);
+
+	{
+		PX_PROFILE_ZONE("PxImmediateWorld.updatePairs", mContextID);
+
+		for(PxU32 i=0;i<results.mNbDeletedPairs;i++)
+		{
+			const PxHashMap<PxU64, PxU32>::Entry* entry = mPairMap.find(getPairKey(results.mDeletedPairs[i].mID0, results.mDeletedPairs[i].mID1));
+			if(entry)
+				removePairAt(entry->second);
+		}
+
+		for(PxU32 i=0;i<results.mNbCreatedPairs;i++)
+			addPair(results.mCreatedPairs[i].mID0, results.mCreatedPairs[i].mID1);
+	}
+
+	// The broadphase is done with the removed handles, they can be recycled
+	const PxU32 nbRemoved = mRemovedBodies.size();
+	for(PxU32 i=0;i<nbRemoved;i++)
+		mFreeBodies.pushBack(mRemovedBodies[i]);
+	mRemovedBodies.clear();
+
+	mStats.nbBroadPhasePairs = mPairs.size();
+}
+
+void ImmWorld::processNarrowPhaseChunk(PxU32 chunkIndex)
+{
+	ImmNpChunk& chunk = *mNpChunks[chunkIndex];
+	chunk.mContacts.forceSize_Unsafe(0);
+
+	ImmContactRecorder recorder(chunk.mContacts);
+
+	const PxU32 start = chunkIndex * mNbPairsPerTask;
+	const PxU32 end = PxMin(start + mNbPairsPerTask, mPairs.size());
+	for(PxU32 i=start;i<end;i++)
+	{
+		ImmPair& pair = mPairs[i];
+		const PxU32 id0 = pair.mBody0;
+		const PxU32 id1 = pair.mBody1;
+
+		const ImmBodyProperties& props0 = mProperties[id0];
+		const ImmBodyProperties& props1 = mProperties[id1];
+
+		// Materials are combined like PxCombineMode::eAVERAGE
+		recorder.mPair				= &pair;
+		recorder.mStaticFriction	= (props0.mStaticFriction + props1.mStaticFriction)*0.5f;
+		recorder.mDynamicFriction	= (props0.mDynamicFriction + props1.mDynamicFriction)*0.5f;
+		recorder.mRestitution		= (props0.mRestitution + props1.mRestitution)*0.5f;
+
+		pair.mNpChunk = chunkIndex;
+		pair.mNbContacts = 0;
+
+		const PxGeometry* geom0 = &mGeometries[id0].any();
+		const PxGeometry* geom1 = &mGeometries[id1].any();
+		const PxTransform pose0 = getShapePose(id0);
+		const PxTransform pose1 = getShapePose(id1);
+
+		PxGenerateContacts(&geom0, &geom1, &pose0, &pose1, &pair.mCache, 1, recorder, mContactDistance, mMeshContactMargin, mToleranceLength, chunk.mCacheAllocator);
+
+		// No touch, so the friction patches are not valid anymore
+		if(!pair.mNbContacts)
+		{
+			pair.mFrictionPatches = NULL;
+			pair.mNbFrictionPatches = 0;
+		}
+	}
+}
+
+void ImmWorld::runNarrowPhase()
+{
+	PX_PROFILE_ZONE("PxImmediateWorld.runNarrowPhase", mContextID);
+
+	// Pairs are split in fixed-size chunks so that the results do not depend on the number of threads
+	const PxU32 nbChunks = PxParallelForGetNbChunks(mPairs.size(), mNbPairsPerTask);
+	while(mNpChunks.size()<nbChunks)
+		mNpChunks.pushBack(PX_NEW(ImmNpChunk));
+
+	NarrowPhaseWork work(*this);
+	PxParallelFor(mDispatcher, work, nbChunks, "PxImmediateWorld.step");
+
+	PxU32 nbTouchingPairs = 0;
+	const PxU32 nbPairs = mPairs.size();
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		if(mPairs[i].mNbContacts)
+			nbTouchingPairs++;
+	}
+
+	PxU32 nbContacts = 0;
+	for(PxU32 i=0;i<nbChunks;i++)
+		nbContacts += mNpChunks[i]->mContacts.size();
+
+	mStats.nbTouchingPairs = nbTouchingPairs;
+	mStats.nbContacts = nbContacts;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxU32 ImmWorld::findIsland(PxU32 body)
+{
+	PxU32* parents = mIslandParents.begin();
+	while(parents[body]!=body)
+	{
+		parents[body] = parents[parents[body]];	// Path halving
+		body = parents[body];
+	}
+	return body;
+}
+
+void ImmWorld::uniteIslands(PxU32 body0, PxU32 body1)
+{
+	const PxU32 root0 = findIsland(body0);
+	const PxU32 root1 = findIsland(body1);
+	if(root0<root1)
+		mIslandParents[root1] = root0;
+	else if(root1<root0)
+		mIslandParents[root0] = root1;
+}
+
+void ImmWorld::buildIslands()
+{
+	PX_PROFILE_ZONE("PxImmediateWorld.buildIslands", mContextID);
+
+	const PxU32 capacity = mPoses.size();
+	mIslandParents.resizeUninitialized(capacity);
+	mBodyIslands.resizeUninitialized(capacity);
+	mLocalIndices.resizeUninitialized(capacity);
+	for(PxU32 i=0;i<capacity;i++)
+	{
+		mIslandParents[i] = i;
+		mBodyIslands[i] = PX_INVALID_U32;
+	}
+
+	// Static bodies do not connect islands
+	const PxU32 nbPairs = mPairs.size();
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const ImmPair& pair = mPairs[i];
+		if(pair.mNbContacts && isDynamic(pair.mBody1))
+			uniteIslands(pair.mBody0, pair.mBody1);
+	}
+
+	const PxU32 nbJointSlots = mJoints.size();
+	for(PxU32 i=0;i<nbJointSlots;i++)
+	{
+		const ImmJoint& joint = mJoints[i];
+		if(joint.mConstraint.prep && isDynamic(joint.mBody0) && isDynamic(joint.mBody1))
+			uniteIslands(joint.mBody0, joint.mBody1);
+	}
+
+	// Island IDs are assigned in body order, which keeps the solver order independent from the union-find internals
+	mIslandSizes.clear();
+	for(PxU32 i=0;i<capacity;i++)
+	{
+		if(!isAlive(i) || !isDynamic(i))
+			continue;
+
+		const PxU32 root = findIsland(i);
+		if(mBodyIslands[root]==PX_INVALID_U32)
+		{
+			mBodyIslands[root] = mIslandSizes.size();
+			mIslandSizes.pushBack(0);
+		}
+		const PxU32 islandID = mBodyIslands[root];
+		mBodyIslands[i] = islandID;
+		mIslandSizes[islandID]++;
+	}
+
+	// Small islands are merged in batches, to amortize the per-task overhead
+	const PxU32 nbIslands = mIslandSizes.size();
+	mIslandBatches.resizeUninitialized(nbIslands);
+	PxU32 nbBatches = 0;
+	PxU32 currentSize = 0;
+	for(PxU32 i=0;i<nbIslands;i++)
+	{
+		if(!nbBatches || currentSize>=mNbBodiesPerBatch)
+		{
+			nbBatches++;
+			currentSize = 0;
+		}
+		mIslandBatches[i] = nbBatches - 1;
+		currentSize += mIslandSizes[i];
+	}
+
+	while(mBatches.size()<nbBatches)
+		mBatches.pushBack(PX_NEW(ImmSolverBatch));
+	mNbBatches = nbBatches;
+
+	for(PxU32 i=0;i<nbBatches;i++)
+	{
+		ImmSolverBatch& batch = *mBatches[i];
+		batch.mNbBodies = 0;
+		batch.mNbPairs = 0;
+		batch.mNbJoints = 0;
+	}
+
+	// Count the bodies, pairs and joints of each batch...
+	for(PxU32 i=0;i<capacity;i++)
+	{
+		if(isAlive(i) && isDynamic(i))
+			mBatches[mIslandBatches[mBodyIslands[i]]]->mNbBodies++;
+	}
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const ImmPair& pair = mPairs[i];
+		if(pair.mNbContacts)
+			mBatches[mIslandBatches[mBodyIslands[pair.mBody0]]]->mNbPairs++;
+	}
+
+	for(PxU32 i=0;i<nbJointSlots;i++)
+	{
+		const ImmJoint& joint = mJoints[i];
+		if(joint.mConstraint.prep)
+		{
+			const PxU32 body = isDynamic(joint.mBody0) ? joint.mBody0 : joint.mBody1;
+			mBatches[mIslandBatches[mBodyIslands[body]]]->mNbJoints++;
+		}
+	}
+
+	// ...compute their start offsets...
+	PxU32 nbBodies = 0, nbBatchPairs = 0, nbBatchJoints = 0;
+	for(PxU32 i=0;i<nbBatches;i++)
+	{
+		ImmSolverBatch& batch = *mBatches[i];
+		batch.mStartBody = nbBodies;
+		batch.mStartPair = nbBatchPairs;
+		batch.mStartJoint = nbBatchJoints;
+		nbBodies += batch.mNbBodies;
+		nbBatchPairs += batch.mNbPairs;
+		nbBatchJoints += batch.mNbJoints;
+		batch.mNbBodies = 0;
+		batch.mNbPairs = 0;
+		batch.mNbJoints = 0;
+	}
+
+	mBatchBodies.resizeUninitialized(nbBodies);
+	mBatchPairs.resizeUninitialized(nbBatchPairs);
+	mBatchJoints.resizeUninitialized(nbBatchJoints);
+
+	// ...and sort them by batch
+	for(PxU32 i=0;i<capacity;i++)
+	{
+		if(isAlive(i) && isDynamic(i))
+		{
+			ImmSolverBatch& batch = *mBatches[mIslandBatches[mBodyIslands[i]]];
+			mLocalIndices[i] = batch.mNbBodies;
+			mBatchBodies[batch.mStartBody + batch.mNbBodies++] = i;
+		}
+	}
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const ImmPair& pair = mPairs[i];
+		if(pair.mNbContacts)
+		{
+			ImmSolverBatch& batch = *mBatches[mIslandBatches[mBodyIslands[pair.mBody0]]];
+			mBatchPairs[batch.mStartPair + batch.mNbPairs++] = i;
+		}
+	}
+
+	for(PxU32 i=0;i<nbJointSlots;i++)
+	{
+		const ImmJoint& joint = mJoints[i];
+		if(joint.mConstraint.prep)
+		{
+			const PxU32 body = isDynamic(joint.mBody0) ? joint.mBody0 : joint.mBody1;
+			ImmSolverBatch& batch = *mBatches[mIslandBatches[mBodyIslands[body]]];
+			mBatchJoints[batch.mStartJoint + batch.mNbJoints++] = i;
+		}
+	}
+
+	mStats.nbIslands = nbIslands;
+	mStats.nbSolverBatches = nbBatches;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Static bodies (and the world frame) get one solver body per constraint, appended after the dynamic bodies of the batch
+PxU32 ImmWorld::getSolverBodyIndex(PxU32 body, PxU32& staticIndex, ImmSolverBatch& batch) const
+{
+	if(isDynamic(body))
+		return mLocalIndices[body];
+
+	const PxTransform pose = body==PX_IMMEDIATE_INVALID_HANDLE ? PxTransform(PxIdentity) : mPoses[body];
+	const PxU32 index = staticIndex++;
+	if(mSolverType==PxSolverType::eTGS)
+	{
+		PxConstructStaticSolverBodyTGS(pose, batch.mTGSBodies[index], batch.mTxInertias[index], batch.mTGSBodyData[index]);
+		batch.mPoses[index] = pose;
+	}
+	else
+	{
+		PxConstructStaticSolverBody(pose, batch.mBodyData[index]);
+	}
+	return index;
+}
+
+template<class ContactDescT, class JointDescT>
+void ImmWorld::createConstraints(ImmSolverBatch& batch, PxU32 nbContactHeaders, PxU32 nbHeaders, const ImmStepParams& params)
+{
+	PxConstraintBatchHeader* headers = batch.mHeaders.begin();
+	PxSolverConstraintDesc* descs = batch.mOrderedDescs.begin();
+
+	for(PxU32 i=0;i<nbContactHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		PX_ASSERT(header.constraintType == PxSolverConstraintDesc::eCONTACT_CONSTRAINT);
+
+		ContactDescT contactDescs[4];
+		ImmPair* pairs[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& desc = descs[header.startIndex + a];
+			ImmPair& pair = *reinterpret_cast<ImmPair*>(desc.constraint);
+			pairs[a] = &pair;
+
+			ContactDescT& contactDesc = contactDescs[a];
+			PxMemZero(&contactDesc, sizeof(ContactDescT));
+			setupBodies(contactDesc, desc, batch);
+			contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+			contactDesc.bodyState1			= isDynamic(pair.mBody1) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			contactDesc.desc				= &desc;
+			contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = 1.0f;
+			contactDesc.shapeInteraction	= NULL;
+			contactDesc.contacts			= mNpChunks[pair.mNpChunk]->mContacts.begin() + pair.mStartContact;
+			contactDesc.numContacts			= pair.mNbContacts;
+			contactDesc.contactForces		= reinterpret_cast<PxReal*>(batch.mAllocator.mConstraints.allocate(sizeof(PxReal)*pair.mNbContacts));
+			contactDesc.frictionPtr			= pair.mFrictionPatches;
+			contactDesc.frictionCount		= PxU8(pair.mNbFrictionPatches);
+			contactDesc.maxCCDSeparation	= PX_MAX_F32;
+		}
+
+		createContacts(header, contactDescs, batch.mAllocator, params);
+
+		// Keep the new friction patches for next frame's friction correlation
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			pairs[a]->mFrictionPatches = contactDescs[a].frictionPtr;
+			pairs[a]->mNbFrictionPatches = contactDescs[a].frictionCount;
+		}
+	}
+
+	for(PxU32 i=nbContactHeaders;i<nbHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		PX_ASSERT(header.constraintType == PxSolverConstraintDesc::eJOINT_CONSTRAINT);
+
+		JointDescT jointDescs[4];
+		PxImmediateConstraint constraints[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& desc = descs[header.startIndex + a];
+			const ImmJoint& joint = *reinterpret_cast<const ImmJoint*>(desc.constraint);
+			constraints[a] = joint.mConstraint;
+
+			JointDescT& jointDesc = jointDescs[a];
+			PxMemZero(&jointDesc, sizeof(JointDescT));
+			setupBodies(jointDesc, desc, batch);
+			jointDesc.bodyState0			= isDynamic(joint.mBody0) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.bodyState1			= isDynamic(joint.mBody1) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.desc					= &desc;
+			jointDesc.invMassScales.linear0 = jointDesc.invMassScales.linear1 = jointDesc.invMassScales.angular0 = jointDesc.invMassScales.angular1 = 1.0f;
+			jointDesc.writeback				= NULL;
+			jointDesc.linBreakForce			= PX_MAX_F32;
+			jointDesc.angBreakForce			= PX_MAX_F32;
+			jointDesc.minResponseThreshold	= joint.mMinResponseThreshold;
+			jointDesc.disablePreprocessing	= joint.mFlags.isSet(PxConstraintFlag::eDISABLE_PREPROCESSING);
+			jointDesc.improvedSlerp			= joint.mFlags.isSet(PxConstraintFlag::eIMPROVED_SLERP);
+			jointDesc.driveLimitsAreForces	= joint.mFlags.isSet(PxConstraintFlag::eDRIVE_LIMITS_ARE_FORCES);
+		}
+
+		createJoints(header, constraints, jointDescs, batch.mAllocator, params);
+	}
+}
+
+void ImmWorld::solveBatch(ImmSolverBatch& batch, const ImmStepParams& params)
+{
+	PX_PROFILE_ZONE("PxImmediateWorld.solveBatch", mContextID);
+
+	const bool isTGS = mSolverType==PxSolverType::eTGS;
+	const PxU32 nbBodies = batch.mNbBodies;
+	const PxU32 nbPairs = batch.mNbPairs;
+	const PxU32 nbJoints = batch.mNbJoints;
+	const PxU32* bodies = mBatchBodies.begin() + batch.mStartBody;
+	const PxU32* pairs = mBatchPairs.begin() + batch.mStartPair;
+	const PxU32* joints = mBatchJoints.begin() + batch.mStartJoint;
+
+	PxU32 nbStatics = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		if(!isDynamic(mPairs[pairs[i]].mBody1))
+			nbStatics++;
+	}
+	for(PxU32 i=0;i<nbJoints;i++)
+	{
+		const ImmJoint& joint = mJoints[joints[i]];
+		if(!isDynamic(joint.mBody0))
+			nbStatics++;
+		if(!isDynamic(joint.mBody1))
+			nbStatics++;
+	}
+	const PxU32 nbSolverBodies = nbBodies + nbStatics;
+	const PxU32 nbConstraints = nbPairs + nbJoints;
+
+	// Solver bodies
+	batch.mRigidData.resizeUninitialized(nbBodies);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const PxU32 body = bodies[i];
+		const ImmBodyProperties& props = mProperties[body];
+
+		PxRigidBodyData& data = batch.mRigidData[i];
+		data.linearVelocity				= mLinearVelocities[body];
+		data.invMass					= props.mInvMass;
+		data.angularVelocity			= mAngularVelocities[body];
+		data.maxDepenetrationVelocity	= props.mMaxDepenetrationVelocity;
+		data.invInertia					= props.mInvInertia;
+		data.maxContactImpulse			= props.mMaxContactImpulse;
+		data.body2World					= mPoses[body];
+		data.linearDamping				= props.mLinearDamping;
+		data.angularDamping				= props.mAngularDamping;
+		data.maxLinearVelocitySq		= props.mMaxLinearVelocitySq;
+		data.maxAngularVelocitySq		= props.mMaxAngularVelocitySq;
+		data.pad						= 0;
+	}
+
+	if(isTGS)
+	{
+		batch.mTGSBodies.resizeUninitialized(nbSolverBodies);
+		batch.mTxInertias.resizeUninitialized(nbSolverBodies);
+		batch.mTGSBodyData.resizeUninitialized(nbSolverBodies);
+		batch.mPoses.resizeUninitialized(nbSolverBodies);
+		PxConstructSolverBodiesTGS(batch.mRigidData.begin(), batch.mTGSBodies.begin(), batch.mTxInertias.begin(), batch.mTGSBodyData.begin(), nbBodies, mGravity, params.mDt);
+		for(PxU32 i=0;i<nbBodies;i++)
+			batch.mPoses[i] = batch.mRigidData[i].body2World;
+	}
+	else
+	{
+		batch.mBodyData.resizeUninitialized(nbSolverBodies);
+		batch.mBodies.resizeUninitialized(nbSolverBodies);
+		PxConstructSolverBodies(batch.mRigidData.begin(), batch.mBodyData.begin(), nbBodies, mGravity, params.mDt);
+		PxMemZero(batch.mBodies.begin(), sizeof(PxSolverBody)*nbSolverBodies);
+	}
+
+	// Constraint descs. The pair or joint is stored in the constraint pointer until the constraints are created.
+	batch.mDescs.resizeUninitialized(nbConstraints);
+	batch.mOrderedDescs.resizeUninitialized(nbConstraints);
+	batch.mHeaders.resizeUninitialized(nbConstraints);
+
+	PxU32 staticIndex = nbBodies;
+	for(PxU32 i=0;i<nbConstraints;i++)
+	{
+		PxU32 body0, body1;
+		PxU8* constraint;
+		if(i<nbPairs)
+		{
+			ImmPair& pair = mPairs[pairs[i]];
+			body0 = pair.mBody0;
+			body1 = pair.mBody1;
+			constraint = reinterpret_cast<PxU8*>(&pair);
+		}
+		else
+		{
+			ImmJoint& joint = mJoints[joints[i - nbPairs]];
+			body0 = joint.mBody0;
+			body1 = joint.mBody1;
+			constraint = reinterpret_cast<PxU8*>(&joint);
+		}
+
+		const PxU32 index0 = getSolverBodyIndex(body0, staticIndex, batch);
+		const PxU32 index1 = getSolverBodyIndex(body1, staticIndex, batch);
+
+		PxSolverConstraintDesc& desc = batch.mDescs[i];
+		PxMemZero(&desc, sizeof(PxSolverConstraintDesc));
+		if(isTGS)
+		{
+			desc.tgsBodyA = &batch.mTGSBodies[index0];
+			desc.tgsBodyB = &batch.mTGSBodies[index1];
+		}
+		else
+		{
+			desc.bodyA = &batch.mBodies[index0];
+			desc.bodyB = &batch.mBodies[index1];
+		}
+		desc.bodyADataIndex	= index0;
+		desc.bodyBDataIndex	= index1;
+		desc.linkIndexA		= PxSolverConstraintDesc::RIGID_BODY;
+		desc.linkIndexB		= PxSolverConstraintDesc::RIGID_BODY;
+		desc.constraint		= constraint;
+		desc.constraintType	= PxU16(i<nbPairs ? PxSolverConstraintDesc::eCONTACT_CONSTRAINT : PxSolverConstraintDesc::eJOINT_CONSTRAINT);
+	}
+	PX_ASSERT(staticIndex==nbSolverBodies);
+
+	// Contacts and joints are batched separately, so that each header only references one constraint type
+	PxConstraintBatchHeader* headers = batch.mHeaders.begin();
+	PxSolverConstraintDesc* orderedDescs = batch.mOrderedDescs.begin();
+	PxU32 nbContactHeaders, nbJointHeaders;
+	if(isTGS)
+	{
+		nbContactHeaders = nbPairs ? PxBatchConstraintsTGS(batch.mDescs.begin(), nbPairs, batch.mTGSBodies.begin(), nbBodies, headers, orderedDescs) : 0;
+		nbJointHeaders = nbJoints ? PxBatchConstraintsTGS(batch.mDescs.begin() + nbPairs, nbJoints, batch.mTGSBodies.begin(), nbBodies, headers + nbContactHeaders, orderedDescs + nbPairs) : 0;
+	}
+	else
+	{
+		nbContactHeaders = nbPairs ? PxBatchConstraints(batch.mDescs.begin(), nbPairs, batch.mBodies.begin(), nbBodies, headers, orderedDescs) : 0;
+		nbJointHeaders = nbJoints ? PxBatchConstraints(batch.mDescs.begin() + nbPairs, nbJoints, batch.mBodies.begin(), nbBodies, headers + nbContactHeaders, orderedDescs + nbPairs) : 0;
+	}
+
+	const PxU32 nbHeaders = nbContactHeaders + nbJointHeaders;
+	for(PxU32 i=nbContactHeaders;i<nbHeaders;i++)
+		headers[i].startIndex += nbPairs;
+
+	if(isTGS)
+		createConstraints<PxTGSSolverContactDesc, PxTGSSolverConstraintPrepDesc>(batch, nbContactHeaders, nbHeaders, params);
+	else
+		createConstraints<PxSolverContactDesc, PxSolverConstraintPrepDesc>(batch, nbContactHeaders, nbHeaders, params);
+
+	// Solve, integrate and write the results back to the world's arrays. Each body belongs to a single batch.
+	if(isTGS)
+	{
+		PxSolveConstraintsTGS(headers, nbHeaders, orderedDescs, batch.mTGSBodies.begin(), batch.mTxInertias.begin(), nbBodies, mNbPositionIterations, mNbVelocityIterations, params.mStepDt, params.mInvStepDt);
+		PxIntegrateSolverBodiesTGS(batch.mTGSBodies.begin(), batch.mTxInertias.begin(), batch.mPoses.begin(), nbBodies, params.mDt);
+
+		for(PxU32 i=0;i<nbBodies;i++)
+		{
+			const PxU32 body = bodies[i];
+			mPoses[body]				= batch.mPoses[i];
+			mLinearVelocities[body]		= batch.mTGSBodies[i].linearVelocity;
+			mAngularVelocities[body]	= batch.mTGSBodies[i].angularVelocity;
+		}
+	}
+	else
+	{
+		// The batching uses the solver bodies as scratch memory, and they must be zero before solving
+		PxMemZero(batch.mBodies.begin(), sizeof(PxSolverBody)*nbSolverBodies);
+
+		batch.mMotionLinearVelocities.resizeUninitialized(nbBodies);
+		batch.mMotionAngularVelocities.resizeUninitialized(nbBodies);
+		PxSolveConstraints(headers, nbHeaders, orderedDescs, batch.mBodies.begin(), batch.mMotionLinearVelocities.begin(), batch.mMotionAngularVelocities.begin(), nbBodies, mNbPositionIterations, mNbVelocityIterations);
+		PxIntegrateSolverBodies(batch.mBodyData.begin(), batch.mBodies.begin(), batch.mMotionLinearVelocities.begin(), batch.mMotionAngularVelocities.begin(), nbBodies, params.mDt);
+
+		for(PxU32 i=0;i<nbBodies;i++)
+		{
+			const PxU32 body = bodies[i];
+			const PxSolverBodyData& data = batch.mBodyData[i];
+			mPoses[body]				= data.body2World;
+			mLinearVelocities[body]		= data.linearVelocity;
+			mAngularVelocities[body]	= data.angularVelocity;
+		}
+	}
+}
+
+void ImmWorld::solveIslands(PxReal dt)
+{
+	PX_PROFILE_ZONE("PxImmediateWorld.solveIslands", mContextID);
+
+	ImmStepParams params;
+	params.mDt			= dt;
+	params.mInvDt		= 1.0f/dt;
+	params.mStepDt		= dt/PxReal(mNbPositionIterations);
+	params.mInvStepDt	= 1.0f/params.mStepDt;
+
+	SolveWork work(*this, mBatches.begin(), params);
+	PxParallelFor(mDispatcher, work, mNbBatches, "PxImmediateWorld.step");
+}
+
+void ImmWorld::step(PxReal dt)
+{
+	PX_CHECK_AND_RETURN(dt>0.0f && PxIsFinite(dt), "PxImmediateWorld::step: invalid timestep");
+
+	PX_PROFILE_ZONE("PxImmediateWorld.step", mContextID);
+
+	// Recycle the memory of the frame before the previous one. Contact caches and friction patches from the previous frame remain valid.
+	const PxU32 nbChunks = mNpChunks.size();
+	for(PxU32 i=0;i<nbChunks;i++)
+		mNpChunks[i]->mCacheAllocator.flip();
+
+	const PxU32 nbBatches = mBatches.size();
+	for(PxU32 i=0;i<nbBatches;i++)
+		mBatches[i]->mAllocator.flip();
+
+	if(mPurgePairs)
+		purgePairs();
+
+	updateBroadPhase();
+	runNarrowPhase();
+	buildIslands();
+	solveIslands(dt);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxImmediateWorld* immediate::PxCreateImmediateWorld(const PxImmediateWorldDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCreateImmediateWorld: invalid world descriptor");
+		return NULL;
+	}
+
+	ImmWorld* world = PX_NEW(ImmWorld)(desc);
+	if(!world->init())
+	{
+		PX_DELETE(world);
+		return NULL;
+	}
+	return world;
+}
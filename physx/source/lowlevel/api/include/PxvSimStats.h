@@ -106,6 +106,9 @@ struct PxvSimStats
 
 	PxU32	mNbPartitions;
 
+	PxU32	mNbDataBlockLockContentions;
+	PxU32	mNbDataBlockReservoirRefills;
+
 	PxU64 	mGpuDynamicsTempBufferCapacity;
 	PxU32	mGpuDynamicsRigidContactCount;
 	PxU32	mGpuDynamicsRigidPatchCount;
@@ -60,8 +60,9 @@ class PxcConstraintBlockStream
 {
 	PX_NOCOPY(PxcConstraintBlockStream)
 public:
-	PxcConstraintBlockStream(PxcNpMemBlockPool & blockPool) :
+	PxcConstraintBlockStream(PxcNpMemBlockPool & blockPool, PxcNpMemBlockReservoir* reservoir = NULL) :
 		mBlockPool	(blockPool),
+		mReservoir	(reservoir),
 		mBlock		(NULL),
 		mUsed		(0)
 	{
@@ -75,7 +76,7 @@ public:
 
 											if(mBlock == NULL || size+mUsed>PxcNpMemBlock::SIZE)
 											{
-												mBlock = mBlockPool.acquireConstraintBlock(manager.mTrackingArray);
+												mBlock = mBlockPool.acquireConstraintBlock(manager.mTrackingArray, mReservoir);
 												PX_ASSERT(0==mBlock || mBlock->data == reinterpret_cast<PxU8*>(mBlock));
 												mUsed = size;
 												return reinterpret_cast<PxU8*>(mBlock);
@@ -96,6 +97,7 @@ public:
 
 private:
 			PxcNpMemBlockPool&			mBlockPool;
+			PxcNpMemBlockReservoir*		mReservoir;	// optional per-thread block cache
 			PxcNpMemBlock*				mBlock;	// current constraint block
 			PxU32						mUsed;	// number of bytes used in constraint block
 			//Tracking peak allocations
@@ -106,8 +108,9 @@ class PxcContactBlockStream
 {
 	PX_NOCOPY(PxcContactBlockStream)
 public:
-	PxcContactBlockStream(PxcNpMemBlockPool & blockPool):
+	PxcContactBlockStream(PxcNpMemBlockPool & blockPool, PxcNpMemBlockReservoir* reservoir = NULL):
 		mBlockPool(blockPool),
+		mReservoir(reservoir),
 		mBlock(NULL),
 		mUsed(0)
 	{
@@ -124,7 +127,7 @@ public:
 
 											if(mBlock == NULL || size+mUsed>PxcNpMemBlock::SIZE)
 											{
-												mBlock = mBlockPool.acquireContactBlock();
+												mBlock = mBlockPool.acquireContactBlock(mReservoir);
 												PX_ASSERT(0==mBlock || mBlock->data == reinterpret_cast<PxU8*>(mBlock));
 												mUsed = size;
 												return reinterpret_cast<PxU8*>(mBlock);
@@ -145,6 +148,7 @@ public:
 
 private:
 			PxcNpMemBlockPool&			mBlockPool;
+			PxcNpMemBlockReservoir*		mReservoir;	// optional per-thread block cache
 			PxcNpMemBlock*				mBlock;	// current constraint block
 			PxU32						mUsed;	// number of bytes used in constraint block
 };
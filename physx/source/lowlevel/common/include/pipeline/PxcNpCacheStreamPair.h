@@ -39,7 +39,7 @@ namespace physx
 	{
 										PX_NOCOPY(PxcNpCacheStreamPair)
 	public:
-										PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool);
+										PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool, PxcNpMemBlockReservoir* reservoir = NULL);
 
 					// reserve can fail and return null.
 					PxU8*				reserve(PxU32 byteCount, bool& sizeTooLarge);
@@ -50,6 +50,7 @@ namespace physx
 										}
 	private:
 					PxcNpMemBlockPool&	mBlockPool;
+					PxcNpMemBlockReservoir*	mReservoir;	// optional per-thread block cache
 					PxcNpMemBlock*		mBlock;
 					PxU32				mUsed;
 	};
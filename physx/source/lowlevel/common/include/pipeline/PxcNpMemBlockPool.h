@@ -48,6 +48,36 @@ struct PxcNpMemBlock
 
 typedef PxArray<PxcNpMemBlock*> PxcNpMemBlockArray;
 
+class PxcNpMemBlockPool;
+
+// Per-thread-context reservoir of 16K blocks. Blocks are moved from the pool to the reservoir in batches
+// so that acquiring a block usually doesn't need the pool's lock. Acquired blocks are tracked locally
+// and given back to the pool when the corresponding stream is released or swapped.
+// A reservoir must only be used by the thread context owning it. The pool can take its free blocks back at any
+// time under the pool's lock, when it runs out of blocks.
+class PxcNpMemBlockReservoir
+{
+	PX_NOCOPY(PxcNpMemBlockReservoir)
+public:
+	enum
+	{
+		CAPACITY = 4
+	};
+
+	PxcNpMemBlockReservoir(PxcNpMemBlockPool& pool);
+	~PxcNpMemBlockReservoir();
+
+private:
+	PxcNpMemBlockPool&		mPool;
+	PxcNpMemBlock*			mBlocks[CAPACITY];	// free blocks, already taken out of the pool
+	volatile PxI32			mNbBlocks;			// popped by the owner with a CAS, emptied by the pool under its lock
+	PxcNpMemBlockArray		mContacts[2];
+	PxcNpMemBlockArray		mFriction[2];
+	PxcNpMemBlockArray		mNpCache[2];
+
+	friend class PxcNpMemBlockPool;
+};
+
 class PxcNpMemBlockPool
 {
 	PX_NOCOPY(PxcNpMemBlockPool)
@@ -64,10 +94,10 @@ public:
 	void			releaseUnusedBlocks();
 
 	PxcNpMemBlock*	acquireConstraintBlock();
-	PxcNpMemBlock*	acquireConstraintBlock(PxcNpMemBlockArray& memBlocks);
-	PxcNpMemBlock*	acquireContactBlock();
-	PxcNpMemBlock*	acquireFrictionBlock();
-	PxcNpMemBlock*	acquireNpCacheBlock();
+	PxcNpMemBlock*	acquireConstraintBlock(PxcNpMemBlockArray& memBlocks, PxcNpMemBlockReservoir* reservoir = NULL);
+	PxcNpMemBlock*	acquireContactBlock(PxcNpMemBlockReservoir* reservoir = NULL);
+	PxcNpMemBlock*	acquireFrictionBlock(PxcNpMemBlockReservoir* reservoir = NULL);
+	PxcNpMemBlock*	acquireNpCacheBlock(PxcNpMemBlockReservoir* reservoir = NULL);
 
 	PxU8*			acquireExceptionalConstraintMemory(PxU32 size);
 
@@ -79,10 +109,19 @@ public:
 	void			swapNpCacheStreams();
 
 	void			flushUnused();
+
+	void			registerReservoir(PxcNpMemBlockReservoir& reservoir);
+	void			unregisterReservoir(PxcNpMemBlockReservoir& reservoir);
+
+	// Lock statistics, cleared by resetLockStats()
+	PX_FORCE_INLINE	PxU32	getNbLockContentions()	const	{ return PxU32(mNbLockContentions);	}
+	PX_FORCE_INLINE	PxU32	getNbReservoirRefills()	const	{ return PxU32(mNbReservoirRefills);	}
+					void	resetLockStats();
 	
 private:
 
 	PxMutex					mLock;
+	PxArray<PxcNpMemBlockReservoir*>	mReservoirs;
 	PxcNpMemBlockArray		mConstraints;
 	PxcNpMemBlockArray		mContacts[2];
 	PxcNpMemBlockArray		mFriction[2];
@@ -99,17 +138,27 @@ private:
 	PxU32					mAllocatedBlocks;
 	PxU32					mMaxBlocks;
 	PxU32					mInitialBlocks;
-	PxU32					mUsedBlocks;
-	PxU32					mMaxUsedBlocks;
+	volatile PxI32			mUsedBlocks;		// blocks handed out, not counting free blocks held by reservoirs
+	volatile PxI32			mMaxUsedBlocks;
 	PxcNpMemBlock*			mScratchBlockAddr;
 	PxU32					mNbScratchBlocks;
 	PxcScratchAllocator&	mScratchAllocator;
 
-	PxU32					mPeakConstraintAllocations;
-	PxU32					mConstraintAllocations;
-
-	PxcNpMemBlock*	acquire(PxcNpMemBlockArray& trackingArray, PxU32* allocationCount = NULL, PxU32* peakAllocationCount = NULL, bool isScratchAllocation = false);
-	void			release(PxcNpMemBlockArray& deadArray, PxU32* allocationCount = NULL);
+	volatile PxI32			mPeakConstraintAllocations;
+	volatile PxI32			mConstraintAllocations;
+
+	volatile PxI32			mNbLockContentions;
+	volatile PxI32			mNbReservoirRefills;
+	volatile bool			mScratchAvailable;	// racy hint, scratch blocks are handed out under the lock only
+
+	PxcNpMemBlock*	acquire(PxcNpMemBlockArray& trackingArray, bool trackConstraintAllocations = false, bool isScratchAllocation = false);
+	PxcNpMemBlock*	acquire(PxcNpMemBlockReservoir& reservoir, PxcNpMemBlockArray& trackingArray, bool trackConstraintAllocations = false, bool isScratchAllocation = false);
+	bool			refill(PxcNpMemBlockReservoir& reservoir);
+	void			flush(PxcNpMemBlockReservoir& reservoir);
+	void			trackUsedBlock();
+	void			lock();
+	void			release(PxcNpMemBlockArray& deadArray);
+	void			trackConstraintAllocation();
 };
 
 }
@@ -150,6 +150,7 @@ public:
 #else
 					PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 #endif
+					PxcNpMemBlockReservoir		mBlockReservoir;			// per-thread 16K blocks, avoids the pool's lock
 					PxcContactBlockStream 		mContactBlockStream;		// constraint block pool
 					PxcNpCacheStreamPair		mNpCacheStreamPair;			// narrow phase pairwise data cache
 
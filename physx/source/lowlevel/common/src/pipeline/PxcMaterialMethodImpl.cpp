@@ -142,13 +142,13 @@ static void PxcGetMaterialSoftBodyMesh(const PxsShapeCore* shape0, const PxsShap
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxU32 getMaterialIndex(const Gu::HeightFieldData* hfData, PxU32 triangleIndex)
+static PxU32 getMaterialIndex(const Gu::HeightField* heightField, PxU32 triangleIndex)
 {
 	const PxU32 sampleIndex = triangleIndex >> 1;
 	const bool isFirstTriangle = (triangleIndex & 0x1) == 0;
 
 	//get sample
-	const PxHeightFieldSample* hf = &hfData->samples[sampleIndex];
+	const PxHeightFieldSample* hf = &heightField->getSample(sampleIndex);
 	return isFirstTriangle ? hf->materialIndex0 : hf->materialIndex1;
 }
 
@@ -165,7 +165,7 @@ static void PxcGetMaterialHeightField(const PxsShapeCore* shape, const PxU32 ind
 		const PxU32 count = contactBuffer.count;
 		const PxU16* materialIndices = hfGeom.materialsLL.indices;
 			
-		const Gu::HeightFieldData* hf = &static_cast<const Gu::HeightField*>(hfGeom.heightField)->getData();
+		const Gu::HeightField* hf = static_cast<const Gu::HeightField*>(hfGeom.heightField);
 		
 		for(PxU32 i=0; i<count; i++)
 		{
@@ -188,7 +188,7 @@ static void PxcGetMaterialShapeHeightField(const PxsShapeCore* shape0, const Pxs
 		const PxU32 count = contactBuffer.count;
 		const PxU16* materialIndices = hfGeom.materialsLL.indices;
 			
-		const Gu::HeightFieldData* hf = &static_cast<const Gu::HeightField*>(hfGeom.heightField)->getData();
+		const Gu::HeightField* hf = static_cast<const Gu::HeightField*>(hfGeom.heightField);
 		
 		for(PxU32 i=0; i<count; i++)
 		{
@@ -215,7 +215,7 @@ static void PxcGetMaterialSoftBodyHeightField(const PxsShapeCore* shape0, const
 		const PxU32 count = contactBuffer.count;
 		const PxU16* materialIndices = hfGeom.materialsLL.indices;
 
-		const Gu::HeightFieldData* hf = &static_cast<const Gu::HeightField*>(hfGeom.heightField)->getData();
+		const Gu::HeightField* hf = static_cast<const Gu::HeightField*>(hfGeom.heightField);
 
 		for(PxU32 i=0; i<count; i++)
 		{
@@ -32,8 +32,9 @@
 
 using namespace physx;
 
-PxcNpCacheStreamPair::PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool) :
+PxcNpCacheStreamPair::PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool, PxcNpMemBlockReservoir* reservoir) :
 	mBlockPool	(blockPool),
+	mReservoir	(reservoir),
 	mBlock		(NULL),
 	mUsed		(0)
 {
@@ -54,7 +55,7 @@ PxU8* PxcNpCacheStreamPair::reserve(PxU32 size, bool& sizeTooLarge)
 
 	if(mBlock == NULL || mUsed + size > PxcNpMemBlock::SIZE)
 	{
-		mBlock = mBlockPool.acquireNpCacheBlock();
+		mBlock = mBlockPool.acquireNpCacheBlock(mReservoir);
 		mUsed = 0;
 	}
 
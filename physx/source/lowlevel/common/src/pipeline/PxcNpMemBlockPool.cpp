@@ -31,10 +31,48 @@
 #include "PxcNpMemBlockPool.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxAtomic.h"
 #include "PxcScratchAllocator.h"
 
 using namespace physx;
 
+namespace
+{
+	// Same as PxMutex::ScopedLock but records whether we had to wait for the lock
+	class ContentionTrackingLock
+	{
+		PX_NOCOPY(ContentionTrackingLock)
+	public:
+		PX_FORCE_INLINE	ContentionTrackingLock(PxMutex& mutex, volatile PxI32& nbContentions) : mMutex(mutex)
+		{
+			if(!mMutex.trylock())
+			{
+				PxAtomicIncrement(&nbContentions);
+				mMutex.lock();
+			}
+		}
+
+		PX_FORCE_INLINE	~ContentionTrackingLock()
+		{
+			mMutex.unlock();
+		}
+	private:
+		PxMutex&	mMutex;
+	};
+}
+
+PxcNpMemBlockReservoir::PxcNpMemBlockReservoir(PxcNpMemBlockPool& pool) :
+	mPool		(pool),
+	mNbBlocks	(0)
+{
+	mPool.registerReservoir(*this);
+}
+
+PxcNpMemBlockReservoir::~PxcNpMemBlockReservoir()
+{
+	mPool.unregisterReservoir(*this);
+}
+
 PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator) :
 	mConstraints("PxcNpMemBlockPool::mConstraints"),
 	mExceptionalConstraints("PxcNpMemBlockPool::mExceptionalConstraints"),
@@ -50,7 +88,10 @@ PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator) :
 	mNbScratchBlocks(0),
 	mScratchAllocator(allocator),
 	mPeakConstraintAllocations(0),
-	mConstraintAllocations(0)  
+	mConstraintAllocations(0),
+	mNbLockContentions(0),
+	mNbReservoirRefills(0),
+	mScratchAvailable(false)
 {
 }
 
@@ -75,17 +116,49 @@ void PxcNpMemBlockPool::init(PxU32 initialBlockCount, PxU32 maxBlocks)
 
 PxU32 PxcNpMemBlockPool::getUsedBlockCount() const
 {
-	return mUsedBlocks;
+	return PxU32(mUsedBlocks);
 }
 
 PxU32 PxcNpMemBlockPool::getMaxUsedBlockCount() const
 {
-	return mMaxUsedBlocks;
+	return PxU32(mMaxUsedBlocks);
 }
 
 PxU32 PxcNpMemBlockPool::getPeakConstraintBlockCount() const
 {
-	return mPeakConstraintAllocations;
+	return PxU32(mPeakConstraintAllocations);
+}
+
+void PxcNpMemBlockPool::resetLockStats()
+{
+	mNbLockContentions = 0;
+	mNbReservoirRefills = 0;
+}
+
+void PxcNpMemBlockPool::registerReservoir(PxcNpMemBlockReservoir& reservoir)
+{
+	PxMutex::ScopedLock lock(mLock);
+	mReservoirs.pushBack(&reservoir);
+}
+
+void PxcNpMemBlockPool::unregisterReservoir(PxcNpMemBlockReservoir& reservoir)
+{
+	PxMutex::ScopedLock lock(mLock);
+
+	// Give everything back. Tracked blocks are still referenced by streams until the next swap, so they
+	// are moved to the pool's own tracking arrays rather than released.
+	for(PxU32 i=0;i<2;i++)
+	{
+		while(reservoir.mContacts[i].size())
+			mContacts[i].pushBack(reservoir.mContacts[i].popBack());
+		while(reservoir.mFriction[i].size())
+			mFriction[i].pushBack(reservoir.mFriction[i].popBack());
+		while(reservoir.mNpCache[i].size())
+			mNpCache[i].pushBack(reservoir.mNpCache[i].popBack());
+	}
+	flush(reservoir);
+
+	mReservoirs.findAndReplaceWithLast(&reservoir);
 }
 
 void PxcNpMemBlockPool::setBlockCount(PxU32 blockCount)
@@ -102,6 +175,10 @@ void PxcNpMemBlockPool::setBlockCount(PxU32 blockCount)
 void PxcNpMemBlockPool::releaseUnusedBlocks()
 {
 	PxMutex::ScopedLock lock(mLock);
+
+	for(PxU32 i=0;i<mReservoirs.size();i++)
+		flush(*mReservoirs[i]);
+
 	while(mUnused.size())
 	{
 		PxcNpMemBlock* ptr = mUnused.popBack();
@@ -124,6 +201,7 @@ PxcNpMemBlockPool::~PxcNpMemBlockPool()
 	releaseContacts();
 
 	PX_ASSERT(mUsedBlocks == 0);
+	PX_ASSERT(mReservoirs.size() == 0);
 
 	flushUnused();
 }
@@ -141,6 +219,8 @@ void PxcNpMemBlockPool::acquireConstraintMemory()
 	mScratchBlocks.resize(mNbScratchBlocks);
 	for(PxU32 i=0;i<mNbScratchBlocks;i++)
 		mScratchBlocks[i] = mScratchBlockAddr+i;
+
+	mScratchAvailable = mNbScratchBlocks!=0;
 }
 
 void PxcNpMemBlockPool::releaseConstraintMemory()
@@ -148,6 +228,7 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 	PxMutex::ScopedLock lock(mLock);
 
 	mPeakConstraintAllocations = mConstraintAllocations = 0;
+	mScratchAvailable = false;
 	
 	while(mConstraints.size())
 	{
@@ -158,7 +239,7 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 		{
 			mUnused.pushBack(block);
 			PX_ASSERT(mUsedBlocks>0);
-			mUsedBlocks--;
+			PxAtomicDecrement(&mUsedBlocks);
 		}
 	}
 
@@ -177,14 +258,23 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 	}
 }
 
-PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU32* allocationCount, PxU32* peakAllocationCount, bool isScratchAllocation)
+void PxcNpMemBlockPool::trackUsedBlock()
 {
-	PxMutex::ScopedLock lock(mLock);
-	if(allocationCount && peakAllocationCount)
-	{
-		*peakAllocationCount = PxMax(*allocationCount + 1, *peakAllocationCount);
-		(*allocationCount)++;
-	}
+	const PxI32 nb = PxAtomicIncrement(&mUsedBlocks);
+	PxAtomicMax(&mMaxUsedBlocks, nb);
+}
+
+void PxcNpMemBlockPool::trackConstraintAllocation()
+{
+	const PxI32 nb = PxAtomicIncrement(&mConstraintAllocations);
+	PxAtomicMax(&mPeakConstraintAllocations, nb);
+}
+
+PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, bool trackConstraintAllocations, bool isScratchAllocation)
+{
+	ContentionTrackingLock lock(mLock, mNbLockContentions);
+	if(trackConstraintAllocations)
+		trackConstraintAllocation();
 
 	// this is a bit of hack - the logic would be better placed in acquireConstraintBlock, but then we'd have to grab the mutex
 	// once there to check the scratch block array and once here if we fail - or, we'd need a larger refactor to separate out
@@ -194,6 +284,8 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	{
 		PxcNpMemBlock* block = mScratchBlocks.popBack();
 		trackingArray.pushBack(block);
+		if(!mScratchBlocks.size())
+			mScratchAvailable = false;
 		return block;
 	}
 	
@@ -201,8 +293,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	{
 		PxcNpMemBlock* block = mUnused.popBack();
 		trackingArray.pushBack(block);
-		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
-		mUsedBlocks++;
+		trackUsedBlock();
 		return block;
 	}	
 
@@ -231,8 +322,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	if(block)
 	{
 		trackingArray.pushBack(block);
-		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
-		mUsedBlocks++;
+		trackUsedBlock();
 	}
 	else
 		mAllocatedBlocks--;
@@ -240,6 +330,101 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	return block;
 }
 
+bool PxcNpMemBlockPool::refill(PxcNpMemBlockReservoir& reservoir)
+{
+	PX_ASSERT(!reservoir.mNbBlocks);
+
+	ContentionTrackingLock lock(mLock, mNbLockContentions);
+	PxAtomicIncrement(&mNbReservoirRefills);
+
+	// Out of blocks: take back the free blocks held by the other reservoirs before giving up, so that
+	// we fail only when the old, reservoir-less pool would have failed as well.
+	if(!mUnused.size() && mAllocatedBlocks>=mMaxBlocks)
+	{
+		for(PxU32 i=0;i<mReservoirs.size();i++)
+			flush(*mReservoirs[i]);
+	}
+
+	PxI32 nb = 0;
+	while(nb<PxcNpMemBlockReservoir::CAPACITY && mUnused.size())
+		reservoir.mBlocks[nb++] = mUnused.popBack();
+
+	if(nb<PxcNpMemBlockReservoir::CAPACITY && mAllocatedBlocks<mMaxBlocks)
+	{
+#if PX_CHECKED
+		if(mInitialBlocks)
+		{
+			PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL,
+				"Number of required 16k memory blocks has exceeded the initial number of blocks. Allocator is being called. Consider increasing the number of pre-allocated 16k blocks.");
+		}
+#endif
+		while(nb<PxcNpMemBlockReservoir::CAPACITY && mAllocatedBlocks<mMaxBlocks)
+		{
+			PxcNpMemBlock* block = reinterpret_cast<PxcNpMemBlock*>(PX_ALLOC(sizeof(PxcNpMemBlock), "PxcNpMemBlock"));
+			if(!block)
+				break;
+			mAllocatedBlocks++;
+			reservoir.mBlocks[nb++] = block;
+		}
+	}
+
+#if PX_CHECKED
+	if(!nb)
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL,
+				"Reached maximum number of allocated blocks so 16k block allocation will fail!");
+	}
+#endif
+
+	// Blocks sitting in a reservoir are not counted as used until they are handed out
+	reservoir.mNbBlocks = nb;
+	return nb!=0;
+}
+
+void PxcNpMemBlockPool::flush(PxcNpMemBlockReservoir& reservoir)
+{
+	if(!reservoir.mNbBlocks)
+		return;
+
+	PxMutex::ScopedLock lock(mLock);
+
+	// The owner may be popping blocks concurrently, the exchange decides who gets which ones
+	PxI32 nb = PxAtomicExchange(&reservoir.mNbBlocks, 0);
+	while(nb)
+		mUnused.pushBack(reservoir.mBlocks[--nb]);
+}
+
+PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockReservoir& reservoir, PxcNpMemBlockArray& trackingArray, bool trackConstraintAllocations, bool isScratchAllocation)
+{
+	// Scratch blocks are preferred when available. They only exist while constraints are being built,
+	// so this is rare and we just take the locked path.
+	if(isScratchAllocation && mScratchAvailable)
+		return acquire(trackingArray, trackConstraintAllocations, true);
+
+	PxcNpMemBlock* block;
+	for(;;)
+	{
+		const PxI32 nb = reservoir.mNbBlocks;
+		if(!nb)
+		{
+			if(!refill(reservoir))
+				return NULL;
+		}
+		else if(PxAtomicCompareExchange(&reservoir.mNbBlocks, nb-1, nb)==nb)
+		{
+			block = reservoir.mBlocks[nb-1];
+			break;
+		}
+	}
+
+	if(trackConstraintAllocations)
+		trackConstraintAllocation();
+	trackUsedBlock();
+
+	trackingArray.pushBack(block);
+	return block;
+}
+
 PxU8* PxcNpMemBlockPool::acquireExceptionalConstraintMemory(PxU32 size)
 {
 	PxU8* memory = reinterpret_cast<PxU8*>(PX_ALLOC(size, "PxcNpExceptionalMemory"));
@@ -251,15 +436,11 @@ PxU8* PxcNpMemBlockPool::acquireExceptionalConstraintMemory(PxU32 size)
 	return memory;
 }
 
-void PxcNpMemBlockPool::release(PxcNpMemBlockArray& deadArray, PxU32* allocationCount)
+void PxcNpMemBlockPool::release(PxcNpMemBlockArray& deadArray)
 {
 	PxMutex::ScopedLock lock(mLock);
-	PX_ASSERT(mUsedBlocks >= deadArray.size());
-	mUsedBlocks -= deadArray.size();
-	if(allocationCount)
-	{
-		*allocationCount -= deadArray.size();
-	}
+	PX_ASSERT(PxU32(mUsedBlocks) >= deadArray.size());
+	PxAtomicAdd(&mUsedBlocks, -PxI32(deadArray.size()));
 	while(deadArray.size())
 	{
 		PxcNpMemBlock* block = deadArray.popBack();
@@ -288,14 +469,18 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquireConstraintBlock()
 	return acquire(mConstraints);
 }
 
-PxcNpMemBlock* PxcNpMemBlockPool::acquireConstraintBlock(PxcNpMemBlockArray& memBlocks)
+PxcNpMemBlock* PxcNpMemBlockPool::acquireConstraintBlock(PxcNpMemBlockArray& memBlocks, PxcNpMemBlockReservoir* reservoir)
 {
-	return acquire(memBlocks, &mConstraintAllocations, &mPeakConstraintAllocations, true);
+	if(reservoir)
+		return acquire(*reservoir, memBlocks, true, true);
+	return acquire(memBlocks, true, true);
 }
 
-PxcNpMemBlock* PxcNpMemBlockPool::acquireContactBlock()
+PxcNpMemBlock* PxcNpMemBlockPool::acquireContactBlock(PxcNpMemBlockReservoir* reservoir)
 {
-	return acquire(mContacts[mContactIndex], NULL, NULL, true);
+	if(reservoir)
+		return acquire(*reservoir, reservoir->mContacts[mContactIndex], false, true);
+	return acquire(mContacts[mContactIndex], false, true);
 }
 
 void PxcNpMemBlockPool::releaseConstraintBlocks(PxcNpMemBlockArray& memBlocks)
@@ -311,7 +496,7 @@ void PxcNpMemBlockPool::releaseConstraintBlocks(PxcNpMemBlockArray& memBlocks)
 		{
 			mUnused.pushBack(block);
 			PX_ASSERT(mUsedBlocks>0);
-			mUsedBlocks--;
+			PxAtomicDecrement(&mUsedBlocks);
 		}
 	}
 }
@@ -319,28 +504,47 @@ void PxcNpMemBlockPool::releaseConstraintBlocks(PxcNpMemBlockArray& memBlocks)
 void PxcNpMemBlockPool::releaseContacts()
 {
 	//releaseConstraintBlocks(mContacts);
+	PxMutex::ScopedLock lock(mLock);
 	release(mContacts[1-mContactIndex]);
+	for(PxU32 i=0;i<mReservoirs.size();i++)
+	{
+		release(mReservoirs[i]->mContacts[1-mContactIndex]);
+		flush(*mReservoirs[i]);
+	}
 	mContactIndex = 1-mContactIndex;
 }
 
-PxcNpMemBlock* PxcNpMemBlockPool::acquireFrictionBlock()
+PxcNpMemBlock* PxcNpMemBlockPool::acquireFrictionBlock(PxcNpMemBlockReservoir* reservoir)
 {
+	if(reservoir)
+		return acquire(*reservoir, reservoir->mFriction[mFrictionActiveStream]);
 	return acquire(mFriction[mFrictionActiveStream]);
 }
 
 void PxcNpMemBlockPool::swapFrictionStreams()
 {
+	PxMutex::ScopedLock lock(mLock);
 	release(mFriction[1-mFrictionActiveStream]);
+	for(PxU32 i=0;i<mReservoirs.size();i++)
+		release(mReservoirs[i]->mFriction[1-mFrictionActiveStream]);
 	mFrictionActiveStream = 1-mFrictionActiveStream;
 }
 
-PxcNpMemBlock* PxcNpMemBlockPool::acquireNpCacheBlock()
+PxcNpMemBlock* PxcNpMemBlockPool::acquireNpCacheBlock(PxcNpMemBlockReservoir* reservoir)
 {
+	if(reservoir)
+		return acquire(*reservoir, reservoir->mNpCache[mNpCacheActiveStream]);
 	return acquire(mNpCache[mNpCacheActiveStream]);
 }
 
 void PxcNpMemBlockPool::swapNpCacheStreams()
 {
+	PxMutex::ScopedLock lock(mLock);
 	release(mNpCache[1-mNpCacheActiveStream]);
+	for(PxU32 i=0;i<mReservoirs.size();i++)
+	{
+		release(mReservoirs[i]->mNpCache[1-mNpCacheActiveStream]);
+		flush(*mReservoirs[i]);
+	}
 	mNpCacheActiveStream = 1-mNpCacheActiveStream;
 }
@@ -33,8 +33,9 @@ using namespace physx;
 
 PxcNpThreadContext::PxcNpThreadContext(PxcNpContext* params) : 
 	mRenderOutput						(params->mRenderBuffer),
-	mContactBlockStream					(params->mNpMemBlockPool),
-	mNpCacheStreamPair					(params->mNpMemBlockPool),
+	mBlockReservoir						(params->mNpMemBlockPool),
+	mContactBlockStream					(params->mNpMemBlockPool, &mBlockReservoir),
+	mNpCacheStreamPair					(params->mNpMemBlockPool, &mBlockReservoir),
 	mNarrowPhaseParams					(0.0f, params->mMeshContactMargin, params->mToleranceLength),
 	mPCM								(false),
 	mContactCache						(false),
@@ -32,6 +32,7 @@
 #include "foundation/PxAssert.h"
 #include "foundation/PxBitMap.h"
 #include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
 #include "CmPriorityQueue.h"
 #include "CmBlockArray.h"
 #include "PxNodeIndex.h"
@@ -46,6 +47,8 @@ namespace IG
 #define IG_INVALID_EDGE 0xFFFFFFFFu
 #define IG_LIMIT_DIRTY_NODES 0
 #define IG_SANITY_CHECKS 0
+#define IG_TEMP_ISLAND_FLAG 0x80000000u	// Tags islands created by a split task but not registered in the island sim yet
+#define IG_MAX_SPLIT_TASKS 64
 
 typedef PxU32 IslandId;
 typedef PxU32 EdgeIndex;
@@ -293,14 +296,14 @@ struct TraversalState
 
 struct QueueElement
 {
-	TraversalState* mState;
+	PxU32 mStateIndex;	// Index in the visited nodes array. Not a pointer, since that array can be resized during the traversal.
 	PxU32 mHopCount;
 
 	QueueElement()
 	{
 	}
 
-	QueueElement(TraversalState* state, PxU32 hopCount) : mState(state), mHopCount(hopCount)
+	QueueElement(PxU32 stateIndex, PxU32 hopCount) : mStateIndex(stateIndex), mHopCount(hopCount)
 	{
 	}
 };
@@ -319,6 +322,32 @@ private:
 	NodeComparator& operator = (const NodeComparator&);
 };
 
+// An island split found by a split task. The new island is stored in TraversalContext::mNewIslands, at the same index.
+struct IslandSplit
+{
+	IslandId	mParentIsland;		//! The island the new island has been split from
+	PxU32		mStaticTouchCount;	//! Static touch count of the new island
+};
+
+// Transient data used for the island-splitting traversals. There is one of these per split task, so that
+// independent islands can be split in parallel (see IslandSim::processIslandSplits).
+struct TraversalContext : public PxUserAllocated
+{
+	Cm::PriorityQueue<QueueElement, NodeComparator>	mPriorityQueue;								//! Priority queue used for graph traversal
+	PxArray<TraversalState>							mVisitedNodes;								//! The list of nodes visited in the current traversal
+	PxArray<EdgeIndex>								mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+
+	// Only used when mDeferredSplits is true. New islands cannot be registered from a split task, so they are kept
+	// here with temporary ids (IG_TEMP_ISLAND_FLAG | index) until IslandSim::finishLostEdges() commits them.
+	PxArray<Island>									mNewIslands;
+	PxArray<IslandSplit>							mSplits;
+	bool											mDeferredSplits;
+
+	TraversalContext() : mVisitedNodes("IslandSim::mVisitedNodes"), mDeferredSplits(false)
+	{
+	}
+};
+
 // PT: island-manager data used by both CPU & GPU code.
 // This is managed by external code (e.g. SimpleIslandManager) and passed as const data to IslandSim.
 class CPUExternalData
@@ -425,12 +454,17 @@ class IslandSim
 	PxArray<PxNodeIndex>							mActivatingNodes;
 	PxArray<EdgeIndex>								mDestroyedEdges;
 
-	//Temporary, transient data used for traversals. TODO - move to PxsSimpleIslandManager. Or if we keep it here, we can 
-	//process multiple island simulations in parallel
-	Cm::PriorityQueue<QueueElement, NodeComparator>	mPriorityQueue;								//! Priority queue used for graph traversal
-	PxArray<TraversalState>							mVisitedNodes;								//! The list of nodes visited in the current traversal
+	//Temporary, transient data used for traversals.
+	TraversalContext								mTraversalContext;							//! Traversal data for the single-threaded code path
 	PxBitMap										mVisitedState;								//! Indicates whether a node has been visited
-	PxArray<EdgeIndex>								mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+
+	//Multithreaded island splitting, see prepareIslandSplits()
+	PxArray<TraversalContext*>						mSplitContexts;								//! Per-task traversal data
+	PxArray<PxU64>									mSplitDirtyNodes;							//! Dirty nodes to process, as (islandId<<32)|nodeIndex, sorted
+	PxArray<PxU32>									mSplitDirtyIslands;							//! Start of each island in mSplitDirtyNodes, plus an end marker
+	PxArray<PxU64>									mSplitOrder;								//! New islands as (rootNode<<32)|(splitIndex<<6)|taskIndex, sorted
+	PxU32											mNbSplitTasks;
+	volatile PxI32									mSplitDirtyIslandIndex;						//! Next island to process, shared by all split tasks
 
 	PxArray<EdgeIndex>								mDeactivatingEdges[Edge::eEDGE_TYPE_COUNT];
 public:
@@ -444,7 +478,7 @@ protected:
 public:
 
 	IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, PxU64 contextID);
-	~IslandSim() {}
+	~IslandSim();
 
 	void addNode(bool isActive, bool isKinematic, Node::NodeType type, PxNodeIndex nodeIndex, void* object);
 
@@ -560,6 +594,15 @@ public:
 	void removeDestroyedEdges();	// PT: this is always followed by a call to processLostEdges(). Merge the two?
 	void processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation, PxU32 dirtyNodeLimit);
 
+	// Multithreaded version of processLostEdges(destroyedNodes, true, permitKinematicDeactivation, dirtyNodeLimit). Independent islands
+	// are split in parallel. The results are the same as the single-threaded version, including island ids.
+	// - prepareIslandSplits() returns the number of tasks that should call processIslandSplits(), or 0 if the splits have already been processed.
+	// - processIslandSplits() can be called in parallel for all task indices.
+	// - finishLostEdges() commits the new islands and does the rest of the work.
+	PxU32 prepareIslandSplits(PxU32 maxNbTasks, PxU32 dirtyNodeLimit);
+	void processIslandSplits(PxU32 taskIndex);
+	void finishLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool permitKinematicDeactivation);
+
 private:
 	void wakeIslandsInternal(bool flag);
 
@@ -575,7 +618,7 @@ private:
 
 	void mergeIslandsInternal(Island& island0, Island& island1, IslandId islandId0, IslandId islandId1, PxNodeIndex node0, PxNodeIndex node1);
 	
-	void unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id);
+	void unwindRoute(TraversalContext& context, PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id);
 
 	void activateIslandInternal(const Island& island);
 
@@ -586,9 +629,17 @@ private:
 #if IG_SANITY_CHECKS
 	bool canFindRoot(PxNodeIndex startNode, PxNodeIndex targetNode, PxArray<PxNodeIndex>* visitedNodes);
 #endif
-	bool tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+	bool tryFastPath(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+
+	bool findRoute(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
 
-	bool findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+	// The different stages of processLostEdges()
+	void setupTraversals();
+	void removeEdgesFromIslands();
+	void findPathsAndBreakIslands(PxU32 dirtyNodeLimit);
+	void processDirtyNode(TraversalContext& context, PxU32 dirtyIdx);
+	void commitIslandSplits();
+	void clearLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation);
 
 #if PX_DEBUG
 	bool isPathTo(PxNodeIndex startNode, PxNodeIndex targetNode)	const;
@@ -83,6 +83,10 @@ public:
 											mNewNarrowPhasePairs			(index, callback),
 											mModifyCallback					(NULL),
 											mIslandSim						(islandSim),
+											mRestoredStates					(NULL),
+											mRestoredStatesCapacity			(0),
+											mRestoredStatesSize				(0),
+											mRetiredRestoredStates			("mRetiredRestoredStates"),
 											mGPU							(gpu)
 											{}
 
@@ -156,6 +160,12 @@ public:
 	virtual const Sc::ShapeInteraction*const*	getShapeInteractionsGPU()	const	PX_OVERRIDE	PX_FINAL	{ return mNarrowPhasePairs.mShapeInteractionsGPU.begin();	}
 	virtual const PxReal*						getRestDistancesGPU()		const	PX_OVERRIDE	PX_FINAL	{ return mNarrowPhasePairs.mRestDistancesGPU.begin();		}
 	virtual const PxsTorsionalFrictionData*		getTorsionalDataGPU()		const	PX_OVERRIDE	PX_FINAL	{ return mNarrowPhasePairs.mTorsionalPropertiesGPU.begin();	}
+	virtual PxU32								getContactManagerStateSize(const PxsContactManager& cm)	const	PX_OVERRIDE	PX_FINAL;
+	virtual void								saveContactManagerState(const PxsContactManager& cm, PxU8* state)	const	PX_OVERRIDE	PX_FINAL;
+	virtual bool								isValidContactManagerState(const PxU8* state, PxU32 size)	const	PX_OVERRIDE	PX_FINAL;
+	virtual void								reserveContactManagerStates(PxU32 totalSize)	PX_OVERRIDE	PX_FINAL;
+	virtual void								restoreContactManagerState(PxsContactManager& cm, const PxU8* state)	PX_OVERRIDE	PX_FINAL;
+	virtual void								releaseRetiredContactManagerStates()	PX_OVERRIDE	PX_FINAL;
 	//~PxvNphaseImplementationFallback
 
 			PxArray<PxU32>					mRemovedContactManagers;
@@ -173,8 +183,16 @@ public:
 			PxArray<PxsContactManagerOutputCounts> mCmFoundLostOutputCounts;
 			PxArray<PxsContactManager*>		mCmFoundLost;
 
+			PxU8*							mRestoredStates;		// cache & friction data of the contact managers restored from a scene snapshot
+			PxU32							mRestoredStatesCapacity;
+			PxU32							mRestoredStatesSize;
+			PxArray<PxU8*>					mRetiredRestoredStates;	// data of the previous restores, until the narrow phase has run
+
 			const bool						mGPU;
 private:
+			Gu::Cache&						getCache(PxU32 npIndex);
+			const Gu::Cache&				getCache(PxU32 npIndex)	const;
+
 			void							unregisterContactManagerInternal(PxU32 npIndex, PxsContactManagers& managers, PxsContactManagerOutput* cmOutputs);
 
 			PX_FORCE_INLINE void			unregisterAndForceSize(PxsContactManagers& cms, PxU32 index)
@@ -98,14 +98,41 @@ namespace IG
 {
 	class SimpleIslandManager;
 
+// Splits some of the dirty islands, see IslandSim::processIslandSplits
+class IslandSplitTask : public Cm::Task, public PxUserAllocated
+{
+	IslandSim& mIslandSim;
+	const PxU32 mTaskIndex;
+
+public:
+
+	IslandSplitTask(PxU64 contextID, IslandSim& islandSim, PxU32 taskIndex);
+
+	virtual void runInternal();
+
+	virtual const char* getName() const
+	{
+		return "IslandSplitTask";
+	}
+
+private:
+	PX_NOCOPY(IslandSplitTask)
+};
+
 class ThirdPassTask : public Cm::Task
 {
 	SimpleIslandManager& mIslandManager;
 	IslandSim& mIslandSim;
 
+	void finishLostEdges(PxBaseTask* continuation);
+
+	PxArray<IslandSplitTask*>	mIslandSplitTasks;
+	Cm::DelegateTask<ThirdPassTask, &ThirdPassTask::finishLostEdges>	mFinishLostEdgesTask;
+
 public:
 
 	ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim);
+	~ThirdPassTask();
 
 	virtual void runInternal();
 
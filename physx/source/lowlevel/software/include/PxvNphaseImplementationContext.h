@@ -196,6 +196,18 @@ public:
 	virtual const Sc::ShapeInteraction*const*	getShapeInteractionsGPU()	const	= 0;
 	virtual const PxReal*						getRestDistancesGPU()		const	= 0;
 	virtual const PxsTorsionalFrictionData*		getTorsionalDataGPU()		const	= 0;
+
+	// Persistent narrow phase state of a contact manager (contact cache & friction patches), for scene snapshots.
+	// The saved state is a position-independent blob of getContactManagerStateSize() bytes (a multiple of 16).
+	// reserveContactManagerStates() must be called with the total size of the states before restoring them. The restored
+	// data is owned by the context. The data of the previous restores stays valid until releaseRetiredContactManagerStates()
+	// is called, once the narrow phase has copied the caches to its own streams.
+	virtual PxU32								getContactManagerStateSize(const PxsContactManager& cm)	const	= 0;
+	virtual void								saveContactManagerState(const PxsContactManager& cm, PxU8* state)	const	= 0;
+	virtual bool								isValidContactManagerState(const PxU8* state, PxU32 size)	const	= 0;
+	virtual void								reserveContactManagerStates(PxU32 totalSize)	= 0;
+	virtual void								restoreContactManagerState(PxsContactManager& cm, const PxU8* state)	= 0;
+	virtual void								releaseRetiredContactManagerStates()	= 0;
 };
 
 PxvNphaseImplementationFallback* createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxVirtualAllocatorCallback* allocator, bool gpuDynamics);
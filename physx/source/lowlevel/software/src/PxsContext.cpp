@@ -427,6 +427,11 @@ void PxsContext::shiftOrigin(const PxVec3& shift)
 void PxsContext::swapStreams()
 {
 	mNpMemBlockPool.swapNpCacheStreams();
+
+	// The narrow phase copied the contact caches restored from scene snapshots to its own streams. Without a fallback
+	// context the narrow phase context is the CPU one, see Sc::Scene::supportsContactCacheSnapshot().
+	if(mNpImplementationContext && !mNpFallbackImplementationContext)
+		static_cast<PxvNphaseImplementationFallback*>(mNpImplementationContext)->releaseRetiredContactManagerStates();
 }
 
 void PxsContext::mergeCMDiscreteUpdateResults(PxBaseTask* /*continuation*/)
@@ -29,6 +29,7 @@
 #include "PxsIslandSim.h"
 #include "foundation/PxSort.h"
 #include "foundation/PxUtilities.h"
+#include "foundation/PxAtomic.h"
 #include "common/PxProfileZone.h"
 
 using namespace physx;
@@ -49,7 +50,8 @@ IslandSim::IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, P
 #endif
 	mActivatingNodes		("IslandSim::mActivatingNodes"),
 	mDestroyedEdges			("IslandSim::mDestroyedEdges"),
-	mVisitedNodes			("IslandSim::mVisitedNodes"),
+	mNbSplitTasks			(0),
+	mSplitDirtyIslandIndex	(0),
 	mCpuData				(cpuData),
 	mGpuData				(gpuData),
 	mContextId				(contextID)
@@ -61,6 +63,12 @@ IslandSim::IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, P
 	}
 }
 
+IslandSim::~IslandSim()
+{
+	for (PxU32 i = 0; i < mSplitContexts.size(); ++i)
+		PX_DELETE(mSplitContexts[i]);
+}
+
 #if PX_ENABLE_ASSERTS
 template <typename Thing>
 static bool contains(PxArray<Thing>& arr, const Thing& thing)
@@ -618,7 +626,7 @@ bool IslandSim::canFindRoot(PxNodeIndex startNode, PxNodeIndex targetNode, PxArr
 }
 #endif
 
-void IslandSim::unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id)
+void IslandSim::unwindRoute(TraversalContext& context, PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id)
 {
 	//We have found either a witness *or* the root node with this traversal. In the event of finding the root node, hopCount will be 0. In the event of finding
 	//a witness, hopCount will be the hopCount that witness reported as being the distance to the root.
@@ -627,7 +635,7 @@ void IslandSim::unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 ho
 	PxU32 hc = hopCount+1; //Add on 1 for the hop to the witness/root node.
 	do
 	{
-		TraversalState& state = mVisitedNodes[currIndex];
+		const TraversalState& state = context.mVisitedNodes[currIndex];
 		mHopCounts[state.mNodeIndex.index()] = hc++;
 		mIslandIds[state.mNodeIndex.index()] = id;
 		mFastRoute[state.mNodeIndex.index()] = lastNode;
@@ -1026,22 +1034,43 @@ bool IslandSim::isPathTo(PxNodeIndex startNode, PxNodeIndex targetNode) const
 }
 #endif
 
-bool IslandSim::tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
+// In the multithreaded code path, different tasks can touch the same words of the visited-state bitmap.
+// Each task only ever tests the bits of its own islands' nodes, so only the writes need to be atomic.
+static PX_FORCE_INLINE void setVisited(PxBitMap& visitedState, PxU32 index, bool atomic)
+{
+	if(atomic)
+		PxAtomicOr(reinterpret_cast<volatile PxI32*>(visitedState.getWords() + (index>>5)), PxI32(1u<<(index&31)));
+	else
+		visitedState.set(index);
+}
+
+static PX_FORCE_INLINE void resetVisited(PxBitMap& visitedState, PxU32 index, bool atomic)
+{
+	if(atomic)
+		PxAtomicAnd(reinterpret_cast<volatile PxI32*>(visitedState.getWords() + (index>>5)), PxI32(~(1u<<(index&31))));
+	else
+		visitedState.reset(index);
+}
+
+bool IslandSim::tryFastPath(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
 {
 	PX_UNUSED(startNode);
 	PX_UNUSED(targetNode);
 
+	PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
+	const bool atomic = context.mDeferredSplits;
+
 	PxNodeIndex currentNode = startNode;
 
-	const PxU32 currentVisitedNodes = mVisitedNodes.size();
+	const PxU32 currentVisitedNodes = visitedNodes.size();
 
 	PxU32 depth = 0;
-	
+
 	bool found = false;
 	do
 	{
 		//Get the fast path from this node...
-		
+
 		if(mVisitedState.test(currentNode.index()))
 		{
 			found = mIslandIds[currentNode.index()] != IG_INVALID_ISLAND; //Already visited and not tagged with invalid island == a witness!
@@ -1053,50 +1082,50 @@ bool IslandSim::tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, Islan
 			break;
 		}
 
-		mVisitedNodes.pushBack(TraversalState(currentNode, mVisitedNodes.size(), mVisitedNodes.size()-1, depth++));
+		visitedNodes.pushBack(TraversalState(currentNode, visitedNodes.size(), visitedNodes.size()-1, depth++));
 
 		PX_ASSERT(mFastRoute[currentNode.index()].index() == PX_INVALID_NODE || isPathTo(currentNode, mFastRoute[currentNode.index()]));
 
 		mIslandIds[currentNode.index()] = IG_INVALID_ISLAND;
-		mVisitedState.set(currentNode.index());
+		setVisited(mVisitedState, currentNode.index(), atomic);
 
 		currentNode = mFastRoute[currentNode.index()];
 	}
 	while(currentNode.index() != PX_INVALID_NODE);
 
-	for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+	for(PxU32 a = currentVisitedNodes; a < visitedNodes.size(); ++a)
 	{
-		const TraversalState& state = mVisitedNodes[a];
+		const TraversalState& state = visitedNodes[a];
 		mIslandIds[state.mNodeIndex.index()] = islandId;
 	}
 
 	if(!found)
 	{
-		for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+		for(PxU32 a = currentVisitedNodes; a < visitedNodes.size(); ++a)
 		{
-			const TraversalState& state = mVisitedNodes[a];
-			mVisitedState.reset(state.mNodeIndex.index());
+			const TraversalState& state = visitedNodes[a];
+			resetVisited(mVisitedState, state.mNodeIndex.index(), atomic);
 		}
 
-		mVisitedNodes.forceSize_Unsafe(currentVisitedNodes);
+		visitedNodes.forceSize_Unsafe(currentVisitedNodes);
 	}
 	return found;
 }
 
-bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
+bool IslandSim::findRoute(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
 {
 	//Firstly, traverse the fast path and tag up witnesses. TryFastPath can fail. In that case, no witnesses are left but this node is permitted to report
 	//that it is still part of the island. Whichever node lost its fast path will be tagged as dirty and will be responsible for recovering the fast path
 	//and tagging up the visited nodes
 	if(mFastRoute[startNode.index()].index() != PX_INVALID_NODE)
 	{
-		if(tryFastPath(startNode, targetNode, islandId))
+		if(tryFastPath(context, startNode, targetNode, islandId))
 			return true;
 
 		//Try fast path can either be successful or not. If it was successful, then we had a valid fast path cached and all nodes on that fast path were tagged
-		//as witness nodes (visited and with a valid island ID). If the fast path was not successful, then no nodes were tagged as witnesses. 
-		//Technically, we need to find a route to the root node but, as an optimization, we can simply return true from here with no witnesses added. 
-		//Whichever node actually broke the "fast path" will also be on the list of dirty nodes and will be processed later. 
+		//as witness nodes (visited and with a valid island ID). If the fast path was not successful, then no nodes were tagged as witnesses.
+		//Technically, we need to find a route to the root node but, as an optimization, we can simply return true from here with no witnesses added.
+		//Whichever node actually broke the "fast path" will also be on the list of dirty nodes and will be processed later.
 		//If that broken edge triggered an island separation, this node will be re-visited and added to that island, otherwise
 		//the path to the root node will be re-established. The end result is the same - the island state is computed - this just saves us some work.
 		//return true;
@@ -1107,17 +1136,23 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 		//These are per-node counts that indicate the expected number of hops from this node to the root node. These are lazily evaluated and updated
 		//as new edges are formed or when traversals occur to re-establish islands. As a result, they may be inaccurate but they still serve the purpose
 		//of guiding our search to minimize the chances of us doing an exhaustive search to find the root node.
+		PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
+		Cm::PriorityQueue<QueueElement, NodeComparator>& priorityQueue = context.mPriorityQueue;
+		const bool atomic = context.mDeferredSplits;
+
 		mIslandIds[startNode.index()] = IG_INVALID_ISLAND;
-		TraversalState* startTraversal = &mVisitedNodes.pushBack(TraversalState(startNode, mVisitedNodes.size(), PX_INVALID_NODE, 0));
-		mVisitedState.set(startNode.index());
+		const PxU32 startTraversal = visitedNodes.size();
+		visitedNodes.pushBack(TraversalState(startNode, startTraversal, PX_INVALID_NODE, 0));
+		setVisited(mVisitedState, startNode.index(), atomic);
 		QueueElement element(startTraversal, mHopCounts[startNode.index()]);
-		mPriorityQueue.push(element);
+		priorityQueue.push(element);
 
 		do
 		{
-			const QueueElement currentQE = mPriorityQueue.pop();
+			const QueueElement currentQE = priorityQueue.pop();
 
-			const TraversalState& currentState = *currentQE.mState;
+			// Copy, since pushing new nodes below can resize the array
+			const TraversalState currentState = visitedNodes[currentQE.mStateIndex];
 
 			const Node& currentNode = mNodes[currentState.mNodeIndex.index()];
 
@@ -1134,35 +1169,36 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 					{
 						if(nextIndex.index() == targetNode.index())
 						{
-							unwindRoute(currentState.mCurrentIndex, nextIndex, 0, islandId);
+							unwindRoute(context, currentState.mCurrentIndex, nextIndex, 0, islandId);
 							return true;
 						}
 
 						if(mVisitedState.test(nextIndex.index()))
 						{
-							//We already visited this node. This means that it's either in the priority queue already or we 
-							//visited in on a previous pass. If it was visited on a previous pass, then it already knows what island it's in. 
+							//We already visited this node. This means that it's either in the priority queue already or we
+							//visited in on a previous pass. If it was visited on a previous pass, then it already knows what island it's in.
 							//We now need to test the island id to find out if this node knows the root.
 							//If it has a valid root id, that id *is* our new root. We can guesstimate our hop count based on the node's properties
-							
+
 							const IslandId visitedIslandId = mIslandIds[nextIndex.index()];
 							if(visitedIslandId != IG_INVALID_ISLAND)
 							{
 								//If we get here, we must have found a node that knows a route to our root node. It must not be a different island
-								//because that would caused me to have been visited already because totally separate islands trigger a full traversal on 
+								//because that would caused me to have been visited already because totally separate islands trigger a full traversal on
 								//the orphaned side.
 								PX_ASSERT(visitedIslandId == islandId);
-								unwindRoute(currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
+								unwindRoute(context, currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
 								return true;
 							}
 						}
 						else
 						{
 							//This node has not been visited yet, so we need to push it into the stack and continue traversing
-							TraversalState* state = &mVisitedNodes.pushBack(TraversalState(nextIndex, mVisitedNodes.size(), currentState.mCurrentIndex, currentState.mDepth+1));
-							QueueElement qe(state, mHopCounts[nextIndex.index()]);
-							mPriorityQueue.push(qe);
-							mVisitedState.set(nextIndex.index());
+							const PxU32 stateIndex = visitedNodes.size();
+							visitedNodes.pushBack(TraversalState(nextIndex, stateIndex, currentState.mCurrentIndex, currentState.mDepth+1));
+							QueueElement qe(stateIndex, mHopCounts[nextIndex.index()]);
+							priorityQueue.push(qe);
+							setVisited(mVisitedState, nextIndex.index(), atomic);
 							PX_ASSERT(mIslandIds[nextIndex.index()] == islandId);
 							mIslandIds[nextIndex.index()] = IG_INVALID_ISLAND; //Flag as invalid island until we know whether we can find root or an island id.
 						}
@@ -1172,7 +1208,7 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 				edge = instance.mNextEdge;
 			}
 		}
-		while(mPriorityQueue.size());
+		while(priorityQueue.size());
 
 		return false;
 	}
@@ -1180,359 +1216,565 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 
 void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation, PxU32 dirtyNodeLimit)
 {
-	PX_UNUSED(dirtyNodeLimit);
 	PX_PROFILE_ZONE("Basic.processLostEdges", mContextId);
-	//At this point, all nodes and edges are activated. 
+	//At this point, all nodes and edges are activated.
+
+	setupTraversals();
 
+	removeEdgesFromIslands();
+
+	if (allowDeactivation)
+		findPathsAndBreakIslands(dirtyNodeLimit);
+
+	clearLostEdges(destroyedNodes, allowDeactivation, permitKinematicDeactivation);
+}
+
+void IslandSim::setupTraversals()
+{
 	//Bit map for visited
 	mVisitedState.resizeAndClear(mNodes.size());
 
 	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
-	mPriorityQueue.reserve(1024);
+	mTraversalContext.mPriorityQueue.reserve(1024);
 
 	for (PxU32 i = 0; i < Edge::eEDGE_TYPE_COUNT; ++i)
-		mIslandSplitEdges[i].reserve(1024);
-	
-	mVisitedNodes.reserve(mNodes.size()); //Make sure we have enough space for all nodes!
+		mTraversalContext.mIslandSplitEdges[i].reserve(1024);
+
+	mTraversalContext.mVisitedNodes.reserve(mNodes.size()); //Make sure we have enough space for all nodes!
+}
 
-	const PxU32 nbDestroyedEdges = mDestroyedEdges.size();
-	PX_UNUSED(nbDestroyedEdges);
+void IslandSim::removeEdgesFromIslands()
+{
+	PX_PROFILE_ZONE("Basic.removeEdgesFromIslands", mContextId);
+	for (PxU32 a = 0; a < mDestroyedEdges.size(); ++a)
 	{
-		PX_PROFILE_ZONE("Basic.removeEdgesFromIslands", mContextId);
-		for (PxU32 a = 0; a < mDestroyedEdges.size(); ++a)
-		{
-			const EdgeIndex lostIndex = mDestroyedEdges[a];
-			Edge& lostEdge = mEdges[lostIndex];
+		const EdgeIndex lostIndex = mDestroyedEdges[a];
+		Edge& lostEdge = mEdges[lostIndex];
 
-			if (lostEdge.isPendingDestroyed() && !lostEdge.isInDirtyList())
+		if (lostEdge.isPendingDestroyed() && !lostEdge.isInDirtyList())
+		{
+			//Process this edge...
+			if (!lostEdge.isReportOnlyDestroy() && lostEdge.isInserted())
 			{
-				//Process this edge...
-				if (!lostEdge.isReportOnlyDestroy() && lostEdge.isInserted())
-				{
-					const PxU32 index1 = mCpuData.mEdgeNodeIndices[mDestroyedEdges[a] * 2].index();
-					const PxU32 index2 = mCpuData.mEdgeNodeIndices[mDestroyedEdges[a] * 2 + 1].index();
+				const PxU32 index1 = mCpuData.mEdgeNodeIndices[mDestroyedEdges[a] * 2].index();
+				const PxU32 index2 = mCpuData.mEdgeNodeIndices[mDestroyedEdges[a] * 2 + 1].index();
 
-					IslandId islandId = IG_INVALID_ISLAND;
-					if (index1 != PX_INVALID_NODE && index2 != PX_INVALID_NODE)
-					{
-						PX_ASSERT(mIslandIds[index1] == IG_INVALID_ISLAND || mIslandIds[index2] == IG_INVALID_ISLAND ||
-							mIslandIds[index1] == mIslandIds[index2]);
-						islandId = mIslandIds[index1] != IG_INVALID_ISLAND ? mIslandIds[index1] : mIslandIds[index2];
-					}
-					else if (index1 != PX_INVALID_NODE)
-					{
-						PX_ASSERT(index2 == PX_INVALID_NODE);
-						Node& node = mNodes[index1];
-						if (!node.isKinematic())
-						{
-							islandId = mIslandIds[index1];
-							node.mStaticTouchCount--;
-							//Island& island = mIslands[islandId];
-							mIslandStaticTouchCount[islandId]--;
-							//island.mStaticTouchCount--;
-						}
-					}
-					else if (index2 != PX_INVALID_NODE)
+				IslandId islandId = IG_INVALID_ISLAND;
+				if (index1 != PX_INVALID_NODE && index2 != PX_INVALID_NODE)
+				{
+					PX_ASSERT(mIslandIds[index1] == IG_INVALID_ISLAND || mIslandIds[index2] == IG_INVALID_ISLAND ||
+						mIslandIds[index1] == mIslandIds[index2]);
+					islandId = mIslandIds[index1] != IG_INVALID_ISLAND ? mIslandIds[index1] : mIslandIds[index2];
+				}
+				else if (index1 != PX_INVALID_NODE)
+				{
+					PX_ASSERT(index2 == PX_INVALID_NODE);
+					Node& node = mNodes[index1];
+					if (!node.isKinematic())
 					{
-						PX_ASSERT(index1 == PX_INVALID_NODE);
-						Node& node = mNodes[index2];
-						if (!node.isKinematic())
-						{
-							islandId = mIslandIds[index2];
-							node.mStaticTouchCount--;
-							//Island& island = mIslands[islandId];
-							mIslandStaticTouchCount[islandId]--;
-							//island.mStaticTouchCount--;
-						}
+						islandId = mIslandIds[index1];
+						node.mStaticTouchCount--;
+						//Island& island = mIslands[islandId];
+						mIslandStaticTouchCount[islandId]--;
+						//island.mStaticTouchCount--;
 					}
-
-					if (islandId != IG_INVALID_ISLAND)
+				}
+				else if (index2 != PX_INVALID_NODE)
+				{
+					PX_ASSERT(index1 == PX_INVALID_NODE);
+					Node& node = mNodes[index2];
+					if (!node.isKinematic())
 					{
-						//We need to remove this edge from the island
-						Island& island = mIslands[islandId];
-						removeEdgeFromIsland(island, lostIndex);
+						islandId = mIslandIds[index2];
+						node.mStaticTouchCount--;
+						//Island& island = mIslands[islandId];
+						mIslandStaticTouchCount[islandId]--;
+						//island.mStaticTouchCount--;
 					}
 				}
 
-				lostEdge.clearInserted();
+				if (islandId != IG_INVALID_ISLAND)
+				{
+					//We need to remove this edge from the island
+					Island& island = mIslands[islandId];
+					removeEdgeFromIsland(island, lostIndex);
+				}
 			}
+
+			lostEdge.clearInserted();
 		}
 	}
+}
 
-	if (allowDeactivation)
-	{
-		PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", mContextId);
+void IslandSim::findPathsAndBreakIslands(PxU32 dirtyNodeLimit)
+{
+	PX_UNUSED(dirtyNodeLimit);
+	PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", mContextId);
 
-		//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames. 
-		//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
-		//than triggering large performance spikes.
+	//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames.
+	//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
+	//than triggering large performance spikes.
 #if IG_LIMIT_DIRTY_NODES
-		PxBitMap::PxCircularIterator iter(mDirtyMap, mLastMapIndex);
-		const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
-		PxU32 lastMapIndex = mLastMapIndex;
-		PxU32 count = 0;
+	PxBitMap::PxCircularIterator iter(mDirtyMap, mLastMapIndex);
+	const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
+	PxU32 lastMapIndex = mLastMapIndex;
+	PxU32 count = 0;
 #else
-		PxBitMap::Iterator iter(mDirtyMap);
+	PxBitMap::Iterator iter(mDirtyMap);
 #endif
 
-		PxU32 dirtyIdx;
+	PxU32 dirtyIdx;
 
 #if IG_LIMIT_DIRTY_NODES
-		while ((dirtyIdx = iter.getNext()) != PxBitMap::PxCircularIterator::DONE
-			&& (count++ < MaxCount)
+	while ((dirtyIdx = iter.getNext()) != PxBitMap::PxCircularIterator::DONE
+		&& (count++ < MaxCount)
 #else
-		while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE
+	while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE
 #endif
-			)
-		{
+		)
+	{
+#if IG_LIMIT_DIRTY_NODES
+		lastMapIndex = dirtyIdx + 1;
+#endif
+		processDirtyNode(mTraversalContext, dirtyIdx);
 #if IG_LIMIT_DIRTY_NODES
-			lastMapIndex = dirtyIdx + 1;
+		mDirtyMap.reset(dirtyIdx);
 #endif
-			//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
+	}
 
-			mPriorityQueue.clear(); //Clear the queue used for traversal
-			mVisitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
-			const PxNodeIndex dirtyNodeIndex(dirtyIdx);
-			Node& dirtyNode = mNodes[dirtyNodeIndex.index()];
+#if IG_LIMIT_DIRTY_NODES
+	mLastMapIndex = lastMapIndex;
+	if (count < MaxCount)
+		mLastMapIndex = 0;
+#else
+	mDirtyMap.clear();
+#endif
 
-			//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable 
-			//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a 
-			//previous pass.
-			if (!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && !mVisitedState.test(dirtyNodeIndex.index()))
-			{
-				//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
-				//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
-				//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
-				//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+	//mDirtyNodes.forceSize_Unsafe(0);
+}
 
-				//Indicate that I've been visited
+void IslandSim::processDirtyNode(TraversalContext& context, PxU32 dirtyIdx)
+{
+	//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
 
-				const IslandId islandId = mIslandIds[dirtyNodeIndex.index()];
-				const Island& findIsland = mIslands[islandId];
+	PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
 
-				const PxNodeIndex searchNode = findIsland.mRootNode;//The node that we're searching for!
+	context.mPriorityQueue.clear(); //Clear the queue used for traversal
+	visitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
+	const PxNodeIndex dirtyNodeIndex(dirtyIdx);
+	Node& dirtyNode = mNodes[dirtyNodeIndex.index()];
 
-				if (searchNode.index() != dirtyNodeIndex.index()) //If we are the root node, we don't need to do anything!
-				{
-					if (findRoute(dirtyNodeIndex, searchNode, islandId))
-					{
-						//We found the root node so let's let every visited node know that we found its root
-						//and we can also update our hop counts because we recorded how many hops it took to reach this
-						//node
+	//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable
+	//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a
+	//previous pass.
+	if (!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && !mVisitedState.test(dirtyNodeIndex.index()))
+	{
+		//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
+		//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
+		//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
+		//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+
+		//Indicate that I've been visited
+
+		const IslandId islandId = mIslandIds[dirtyNodeIndex.index()];
+		const Island& findIsland = mIslands[islandId];
+
+		const PxNodeIndex searchNode = findIsland.mRootNode;//The node that we're searching for!
+
+		if (searchNode.index() != dirtyNodeIndex.index()) //If we are the root node, we don't need to do anything!
+		{
+			if (findRoute(context, dirtyNodeIndex, searchNode, islandId))
+			{
+				//We found the root node so let's let every visited node know that we found its root
+				//and we can also update our hop counts because we recorded how many hops it took to reach this
+				//node
 
-						//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
-						//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
-						//the route we already found.
+				//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
+				//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
+				//the route we already found.
 
-						//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
-						//so the remainder of the paths will just fork from that path.
+				//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
+				//so the remainder of the paths will just fork from that path.
 
-						//Verify state (that we can see the root from this node)...
+				//Verify state (that we can see the root from this node)...
 
 #if IG_SANITY_CHECKS
-						PX_ASSERT(canFindRoot(dirtyNodeIndex, searchNode, NULL)); //Verify that we found the connection
+				PX_ASSERT(canFindRoot(dirtyNodeIndex, searchNode, NULL)); //Verify that we found the connection
 #endif
 
-						for (PxU32 b = 0; b < mVisitedNodes.size(); ++b)
-						{
-							TraversalState& state = mVisitedNodes[b];
-							if (mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
-							{
-								mHopCounts[state.mNodeIndex.index()] = mHopCounts[mVisitedNodes[state.mPrevIndex].mNodeIndex.index()] + 1;
-								mFastRoute[state.mNodeIndex.index()] = mVisitedNodes[state.mPrevIndex].mNodeIndex;
-								mIslandIds[state.mNodeIndex.index()] = islandId;
-							}
-						}
-					}
-					else
+				for (PxU32 b = 0; b < visitedNodes.size(); ++b)
+				{
+					TraversalState& state = visitedNodes[b];
+					if (mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
 					{
-						//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
-						//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
+						mHopCounts[state.mNodeIndex.index()] = mHopCounts[visitedNodes[state.mPrevIndex].mNodeIndex.index()] + 1;
+						mFastRoute[state.mNodeIndex.index()] = visitedNodes[state.mPrevIndex].mNodeIndex;
+						mIslandIds[state.mNodeIndex.index()] = islandId;
+					}
+				}
+			}
+			else
+			{
+				//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
+				//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
 
-						//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the 
-						//first node in that list is the root node.
+				//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the
+				//first node in that list is the root node.
 
 
-						//OK, we need to remove all these actors from their current island, then add them to the new island...
+				//OK, we need to remove all these actors from their current island, then add them to the new island...
 
-						Island& oldIsland = mIslands[islandId];
-						//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
-						//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
-						//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
-						//the island to establish the last node again
+				Island& oldIsland = mIslands[islandId];
+				//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
+				//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
+				//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
+				//the island to establish the last node again
 
 #if IG_SANITY_CHECKS
-						PX_ASSERT(!canFindRoot(dirtyNodeIndex, searchNode, NULL));
+				PX_ASSERT(!canFindRoot(dirtyNodeIndex, searchNode, NULL));
 #endif
 
-						PxU32 totalStaticTouchCount = 0;
-						PxU32 nodeCount[Node::eTYPE_COUNT];
-						for (PxU32 t = 0; t < Node::eTYPE_COUNT; ++t)
-						{
-							nodeCount[t] = 0;
-						}
+				PxU32 totalStaticTouchCount = 0;
+				PxU32 nodeCount[Node::eTYPE_COUNT];
+				for (PxU32 t = 0; t < Node::eTYPE_COUNT; ++t)
+				{
+					nodeCount[t] = 0;
+				}
 
-						for (PxU32 t = 0; t < Edge::eEDGE_TYPE_COUNT; ++t)
-						{
-							mIslandSplitEdges[t].forceSize_Unsafe(0);
-						}
+				for (PxU32 t = 0; t < Edge::eEDGE_TYPE_COUNT; ++t)
+				{
+					context.mIslandSplitEdges[t].forceSize_Unsafe(0);
+				}
 
-						//NodeIndex lastIndex = oldIsland.mLastNode;
+				//NodeIndex lastIndex = oldIsland.mLastNode;
 
-						//nodeCount[node.mType] = 1;
+				//nodeCount[node.mType] = 1;
 
-						for (PxU32 a = 0; a < mVisitedNodes.size(); ++a)
-						{
-							const PxNodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& node = mNodes[index.index()];
+				for (PxU32 a = 0; a < visitedNodes.size(); ++a)
+				{
+					const PxNodeIndex index = visitedNodes[a].mNodeIndex;
+					Node& node = mNodes[index.index()];
 
-							if (node.mNextNode.index() != PX_INVALID_NODE)
-								mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
-							else
-								oldIsland.mLastNode = node.mPrevNode;
-							if (node.mPrevNode.index() != PX_INVALID_NODE)
-								mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
+					if (node.mNextNode.index() != PX_INVALID_NODE)
+						mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
+					else
+						oldIsland.mLastNode = node.mPrevNode;
+					if (node.mPrevNode.index() != PX_INVALID_NODE)
+						mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
 
-							nodeCount[node.mType]++;
+					nodeCount[node.mType]++;
 
-							node.mNextNode.setIndices(PX_INVALID_NODE);
-							node.mPrevNode.setIndices(PX_INVALID_NODE);
+					node.mNextNode.setIndices(PX_INVALID_NODE);
+					node.mPrevNode.setIndices(PX_INVALID_NODE);
 
-							PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
+					PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
 
-							totalStaticTouchCount += node.mStaticTouchCount;
+					totalStaticTouchCount += node.mStaticTouchCount;
 
-							EdgeInstanceIndex idx = node.mFirstEdgeIndex;
+					EdgeInstanceIndex idx = node.mFirstEdgeIndex;
 
-							while (idx != IG_INVALID_EDGE)
-							{
-								const EdgeInstance& instance = mEdgeInstances[idx];
-								const EdgeIndex edgeIndex = idx / 2;
-								const Edge& edge = mEdges[edgeIndex];
-
-								//Only split the island if we're processing the first node or if the first node is infinte-mass
-								if (!(idx & 1) || (mCpuData.mEdgeNodeIndices[idx & (~1)].index() == PX_INVALID_NODE || mNodes[mCpuData.mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
-								{
-									//We will remove this edge from the island...
-									mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
-
-									removeEdgeFromIsland(oldIsland, edgeIndex);
-								}
-								idx = instance.mNextEdge;
-							}
-						}
-
-						//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
-						mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
+					while (idx != IG_INVALID_EDGE)
+					{
+						const EdgeInstance& instance = mEdgeInstances[idx];
+						const EdgeIndex edgeIndex = idx / 2;
+						const Edge& edge = mEdges[edgeIndex];
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+						//Only split the island if we're processing the first node or if the first node is infinte-mass
+						if (!(idx & 1) || (mCpuData.mEdgeNodeIndices[idx & (~1)].index() == PX_INVALID_NODE || mNodes[mCpuData.mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
 						{
-							PX_ASSERT(nodeCount[i] <= oldIsland.mNodeCount[i]);
-							oldIsland.mNodeCount[i] -= nodeCount[i];
+							//We will remove this edge from the island...
+							context.mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
+
+							removeEdgeFromIsland(oldIsland, edgeIndex);
 						}
+						idx = instance.mNextEdge;
+					}
+				}
 
-						//Now add all these nodes to the new island
+				//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
+				mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
 
-						//(1) Create the new island...
-						const IslandId newIslandHandle = mIslandHandles.getHandle();
-						/*if(newIslandHandle == mIslands.capacity())
-						{
-						mIslands.reserve(2*mIslands.capacity() + 1);
-						}*/
-						mIslands.resize(PxMax(newIslandHandle + 1, mIslands.size()));
-						mIslandStaticTouchCount.resize(PxMax(newIslandHandle + 1, mIslandStaticTouchCount.size()));
-						Island& newIsland = mIslands[newIslandHandle];
+				for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+				{
+					PX_ASSERT(nodeCount[i] <= oldIsland.mNodeCount[i]);
+					oldIsland.mNodeCount[i] -= nodeCount[i];
+				}
 
-						if (mIslandAwake.test(islandId))
-						{
-							newIsland.mActiveIndex = mActiveIslands.size();
-							mActiveIslands.pushBack(newIslandHandle);
-							mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
-						}
-						else
-						{
-							mIslandAwake.growAndReset(newIslandHandle);
-						}
+				//Now add all these nodes to the new island
 
-						newIsland.mRootNode = dirtyNodeIndex;
-						mHopCounts[dirtyNodeIndex.index()] = 0;
-						mIslandIds[dirtyNodeIndex.index()] = newIslandHandle;
-						//newIsland.mTotalSize = mVisitedNodes.size();
+				//(1) Create the new island...
+				IslandId newIslandHandle;
+				Island* newIslandPtr;
+				if (context.mDeferredSplits)
+				{
+					//Island handles, the island arrays and the active island list are shared by all split tasks, so we can't create
+					//the island here. We create a temporary one instead, and commitIslandSplits() will register it later.
+					newIslandHandle = IG_TEMP_ISLAND_FLAG | context.mNewIslands.size();
+					newIslandPtr = &context.mNewIslands.insert();
+
+					IslandSplit& split = context.mSplits.insert();
+					split.mParentIsland = islandId;
+					split.mStaticTouchCount = totalStaticTouchCount;
+				}
+				else
+				{
+					newIslandHandle = mIslandHandles.getHandle();
+					/*if(newIslandHandle == mIslands.capacity())
+					{
+					mIslands.reserve(2*mIslands.capacity() + 1);
+					}*/
+					mIslands.resize(PxMax(newIslandHandle + 1, mIslands.size()));
+					mIslandStaticTouchCount.resize(PxMax(newIslandHandle + 1, mIslandStaticTouchCount.size()));
+					newIslandPtr = &mIslands[newIslandHandle];
 
-						mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(PX_INVALID_NODE); //First node so doesn't have a preceding node
-						mFastRoute[dirtyNodeIndex.index()].setIndices(PX_INVALID_NODE);
+					if (mIslandAwake.test(islandId))
+					{
+						newIslandPtr->mActiveIndex = mActiveIslands.size();
+						mActiveIslands.pushBack(newIslandHandle);
+						mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
+					}
+					else
+					{
+						mIslandAwake.growAndReset(newIslandHandle);
+					}
+
+					//newIsland.mStaticTouchCount = totalStaticTouchCount;
+					mIslandStaticTouchCount[newIslandHandle] = totalStaticTouchCount;
+				}
+				Island& newIsland = *newIslandPtr;
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
-							nodeCount[i] = 0;
+				newIsland.mRootNode = dirtyNodeIndex;
+				mHopCounts[dirtyNodeIndex.index()] = 0;
+				mIslandIds[dirtyNodeIndex.index()] = newIslandHandle;
+				//newIsland.mTotalSize = mVisitedNodes.size();
 
-						nodeCount[dirtyNode.mType] = 1;
+				mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(PX_INVALID_NODE); //First node so doesn't have a preceding node
+				mFastRoute[dirtyNodeIndex.index()].setIndices(PX_INVALID_NODE);
 
-						for (PxU32 a = 1; a < mVisitedNodes.size(); ++a)
-						{
-							const PxNodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& thisNode = mNodes[index.index()];
-							const PxNodeIndex prevNodeIndex = mVisitedNodes[a - 1].mNodeIndex;
-							thisNode.mPrevNode = prevNodeIndex;
-							mNodes[prevNodeIndex.index()].mNextNode = index;
-							nodeCount[thisNode.mType]++;
-							mIslandIds[index.index()] = newIslandHandle;
-							mHopCounts[index.index()] = mVisitedNodes[a].mDepth; //How many hops to root
-							mFastRoute[index.index()] = mVisitedNodes[mVisitedNodes[a].mPrevIndex].mNodeIndex;
-						}
+				for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+					nodeCount[i] = 0;
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
-							newIsland.mNodeCount[i] = nodeCount[i];
+				nodeCount[dirtyNode.mType] = 1;
 
-						//Last node in the island
-						const PxNodeIndex lastIndex = mVisitedNodes[mVisitedNodes.size() - 1].mNodeIndex;
-						mNodes[lastIndex.index()].mNextNode.setIndices(PX_INVALID_NODE);
-						newIsland.mLastNode = lastIndex;
-						//newIsland.mStaticTouchCount = totalStaticTouchCount;
-						mIslandStaticTouchCount[newIslandHandle] = totalStaticTouchCount;
+				for (PxU32 a = 1; a < visitedNodes.size(); ++a)
+				{
+					const PxNodeIndex index = visitedNodes[a].mNodeIndex;
+					Node& thisNode = mNodes[index.index()];
+					const PxNodeIndex prevNodeIndex = visitedNodes[a - 1].mNodeIndex;
+					thisNode.mPrevNode = prevNodeIndex;
+					mNodes[prevNodeIndex.index()].mNextNode = index;
+					nodeCount[thisNode.mType]++;
+					mIslandIds[index.index()] = newIslandHandle;
+					mHopCounts[index.index()] = visitedNodes[a].mDepth; //How many hops to root
+					mFastRoute[index.index()] = visitedNodes[visitedNodes[a].mPrevIndex].mNodeIndex;
+				}
+
+				for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+					newIsland.mNodeCount[i] = nodeCount[i];
+
+				//Last node in the island
+				const PxNodeIndex lastIndex = visitedNodes[visitedNodes.size() - 1].mNodeIndex;
+				mNodes[lastIndex.index()].mNextNode.setIndices(PX_INVALID_NODE);
+				newIsland.mLastNode = lastIndex;
 
-						PX_ASSERT(mNodes[newIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
+				PX_ASSERT(mNodes[newIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
 
-						for (PxU32 j = 0; j < IG::Edge::eEDGE_TYPE_COUNT; ++j)
+				for (PxU32 j = 0; j < IG::Edge::eEDGE_TYPE_COUNT; ++j)
+				{
+					PxArray<EdgeIndex>& splitEdges = context.mIslandSplitEdges[j];
+					const PxU32 splitEdgeSize = splitEdges.size();
+					if (splitEdgeSize)
+					{
+						splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
+						mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
+						for (PxU32 a = 1; a < splitEdgeSize; ++a)
 						{
-							PxArray<EdgeIndex>& splitEdges = mIslandSplitEdges[j];
-							const PxU32 splitEdgeSize = splitEdges.size();
-							if (splitEdgeSize)
-							{
-								splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
-								mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
-								for (PxU32 a = 1; a < splitEdgeSize; ++a)
-								{
-									const EdgeIndex edgeIndex = splitEdges[a];
-									Edge& edge = mEdges[edgeIndex];
-									edge.mNextIslandEdge = splitEdges[a + 1];
-									edge.mPrevIslandEdge = splitEdges[a - 1];
-								}
-
-								newIsland.mFirstEdge[j] = splitEdges[0];
-								newIsland.mLastEdge[j] = splitEdges[splitEdgeSize - 1];
-								newIsland.mEdgeCount[j] = splitEdgeSize;
-							}
+							const EdgeIndex edgeIndex = splitEdges[a];
+							Edge& edge = mEdges[edgeIndex];
+							edge.mNextIslandEdge = splitEdges[a + 1];
+							edge.mPrevIslandEdge = splitEdges[a - 1];
 						}
+
+						newIsland.mFirstEdge[j] = splitEdges[0];
+						newIsland.mLastEdge[j] = splitEdges[splitEdgeSize - 1];
+						newIsland.mEdgeCount[j] = splitEdgeSize;
 					}
 				}
 			}
-			dirtyNode.clearDirty();
-#if IG_LIMIT_DIRTY_NODES
-			mDirtyMap.reset(dirtyIdx);
-#endif
 		}
+	}
+	dirtyNode.clearDirty();
+}
 
-#if IG_LIMIT_DIRTY_NODES
-		mLastMapIndex = lastMapIndex;
-		if (count < MaxCount)
-			mLastMapIndex = 0;
+PxU32 IslandSim::prepareIslandSplits(PxU32 maxNbTasks, PxU32 dirtyNodeLimit)
+{
+	PX_PROFILE_ZONE("Basic.prepareIslandSplits", mContextId);
+	//At this point, all nodes and edges are activated.
+
+	setupTraversals();
+
+	removeEdgesFromIslands();
+
+	mNbSplitTasks = 0;
+
+#if !IG_LIMIT_DIRTY_NODES
+	//Islands don't share nodes, edges or traversals, so each dirty island can be repaired independently. We gather the dirty nodes
+	//per island here and the split tasks then process whole islands. Within an island, dirty nodes are processed in the same order
+	//as in the single-threaded code, so each island ends up in the same state.
+	mSplitDirtyNodes.forceSize_Unsafe(0);
+	{
+		PxBitMap::Iterator iter(mDirtyMap);
+		PxU32 dirtyIdx;
+		while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE)
+		{
+			Node& dirtyNode = mNodes[dirtyIdx];
+			if (!dirtyNode.isKinematic() && !dirtyNode.isDeleted())
+				mSplitDirtyNodes.pushBack((PxU64(mIslandIds[dirtyIdx]) << 32) | dirtyIdx);
+			else
+				dirtyNode.clearDirty();	// Same as processDirtyNode() for these
+		}
+	}
+
+	if (maxNbTasks > 1 && mSplitDirtyNodes.size() > 1)
+	{
+		PxSort(mSplitDirtyNodes.begin(), mSplitDirtyNodes.size());
+
+		mSplitDirtyIslands.forceSize_Unsafe(0);
+		IslandId previousIslandId = IG_INVALID_ISLAND;
+		for (PxU32 a = 0; a < mSplitDirtyNodes.size(); ++a)
+		{
+			const IslandId islandId = IslandId(mSplitDirtyNodes[a] >> 32);
+			if (islandId != previousIslandId)
+			{
+				mSplitDirtyIslands.pushBack(a);
+				previousIslandId = islandId;
+			}
+		}
+		const PxU32 nbDirtyIslands = mSplitDirtyIslands.size();
+		mSplitDirtyIslands.pushBack(mSplitDirtyNodes.size());
+
+		mNbSplitTasks = PxMin(PxMin(maxNbTasks, nbDirtyIslands), PxU32(IG_MAX_SPLIT_TASKS));
+	}
+
+	if (mNbSplitTasks > 1)
+	{
+		for (PxU32 i = mSplitContexts.size(); i < mNbSplitTasks; ++i)
+			mSplitContexts.pushBack(PX_NEW(TraversalContext));
+
+		for (PxU32 i = 0; i < mNbSplitTasks; ++i)
+		{
+			TraversalContext& context = *mSplitContexts[i];
+			context.mDeferredSplits = true;
+			context.mNewIslands.forceSize_Unsafe(0);
+			context.mSplits.forceSize_Unsafe(0);
+		}
+
+		mSplitDirtyIslandIndex = 0;
+		return mNbSplitTasks;
+	}
+	mNbSplitTasks = 0;
 #else
-		mDirtyMap.clear();
+	PX_UNUSED(maxNbTasks);
 #endif
 
-		//mDirtyNodes.forceSize_Unsafe(0);
+	// Not worth it, do everything here.
+	findPathsAndBreakIslands(dirtyNodeLimit);
+	return 0;
+}
+
+void IslandSim::processIslandSplits(PxU32 taskIndex)
+{
+	PX_PROFILE_ZONE("Basic.processIslandSplits", mContextId);
+	PX_ASSERT(taskIndex < mNbSplitTasks);
+
+	TraversalContext& context = *mSplitContexts[taskIndex];
+	const PxU32 nbDirtyIslands = mSplitDirtyIslands.size() - 1;
+
+	// Islands are fetched dynamically since their sizes vary a lot. This does not change the results.
+	PxU32 islandIndex;
+	while ((islandIndex = PxU32(PxAtomicIncrement(&mSplitDirtyIslandIndex) - 1)) < nbDirtyIslands)
+	{
+		const PxU32 start = mSplitDirtyIslands[islandIndex];
+		const PxU32 end = mSplitDirtyIslands[islandIndex + 1];
+		for (PxU32 a = start; a < end; ++a)
+			processDirtyNode(context, PxU32(mSplitDirtyNodes[a]));
 	}
+}
+
+void IslandSim::commitIslandSplits()
+{
+	PX_PROFILE_ZONE("Basic.commitIslandSplits", mContextId);
 
+	//The single-threaded code creates new islands in dirty node order, and a new island's root is the dirty node that
+	//found it. So we sort the new islands by root node, to allocate the same island handles and get the same active
+	//island list as the single-threaded code.
+	mSplitOrder.forceSize_Unsafe(0);
+	for (PxU32 i = 0; i < mNbSplitTasks; ++i)
+	{
+		const TraversalContext& context = *mSplitContexts[i];
+		for (PxU32 a = 0; a < context.mNewIslands.size(); ++a)
+			mSplitOrder.pushBack((PxU64(context.mNewIslands[a].mRootNode.index()) << 32) | (a << 6) | i);
+	}
+
+	PxSort(mSplitOrder.begin(), mSplitOrder.size());
+
+	for (PxU32 a = 0; a < mSplitOrder.size(); ++a)
+	{
+		const PxU32 taskIndex = PxU32(mSplitOrder[a]) & 63;
+		const PxU32 splitIndex = PxU32(mSplitOrder[a]) >> 6;
+		const TraversalContext& context = *mSplitContexts[taskIndex];
+		const IslandSplit& split = context.mSplits[splitIndex];
+
+		const IslandId newIslandHandle = mIslandHandles.getHandle();
+		mIslands.resize(PxMax(newIslandHandle + 1, mIslands.size()));
+		mIslandStaticTouchCount.resize(PxMax(newIslandHandle + 1, mIslandStaticTouchCount.size()));
+		Island& newIsland = mIslands[newIslandHandle];
+		newIsland = context.mNewIslands[splitIndex];
+
+		if (mIslandAwake.test(split.mParentIsland))
+		{
+			newIsland.mActiveIndex = mActiveIslands.size();
+			mActiveIslands.pushBack(newIslandHandle);
+			mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
+		}
+		else
+		{
+			mIslandAwake.growAndReset(newIslandHandle);
+		}
+
+		mIslandStaticTouchCount[newIslandHandle] = split.mStaticTouchCount;
+
+		//Replace the temporary island id with the real one
+		PxNodeIndex nodeIndex = newIsland.mRootNode;
+		while (nodeIndex.index() != PX_INVALID_NODE)
+		{
+			PX_ASSERT(mIslandIds[nodeIndex.index()] == (IG_TEMP_ISLAND_FLAG | splitIndex));
+			mIslandIds[nodeIndex.index()] = newIslandHandle;
+			nodeIndex = mNodes[nodeIndex.index()].mNextNode;
+		}
+	}
+}
+
+void IslandSim::finishLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool permitKinematicDeactivation)
+{
+	PX_PROFILE_ZONE("Basic.finishLostEdges", mContextId);
+
+	if (mNbSplitTasks)
+	{
+		commitIslandSplits();
+
+		for (PxU32 i = 0; i < mNbSplitTasks; ++i)
+			mSplitContexts[i]->mDeferredSplits = false;
+		mNbSplitTasks = 0;
+
+		mDirtyMap.clear();
+	}
+
+	clearLostEdges(destroyedNodes, true, permitKinematicDeactivation);
+}
+
+void IslandSim::clearLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation)
+{
 	{
 		PX_PROFILE_ZONE("Basic.clearDestroyedEdges", mContextId);
 		//Now process the lost edges...
@@ -627,6 +627,9 @@ void PxsNphaseImplementationContext::secondPassUpdateContactManager(PxReal dt, P
 
 void PxsNphaseImplementationContext::destroy()
 {
+	releaseRetiredContactManagerStates();
+	PX_FREE(mRestoredStates);
+
 	this->~PxsNphaseImplementationContext();
 	PX_FREE_THIS;
 }
@@ -1018,6 +1021,194 @@ PxsContactManagerOutputIterator PxsNphaseImplementationContext::getContactManage
 	return PxsContactManagerOutputIterator(offsets, 1, mNarrowPhasePairs.mOutputContactManagers.begin());
 }
 
+Gu::Cache& PxsNphaseImplementationContext::getCache(PxU32 npIndex)
+{
+	if(npIndex & PxsContactManagerBase::NEW_CONTACT_MANAGER_MASK)
+		return mNewNarrowPhasePairs.mCaches[PxsContactManagerBase::computeIndexFromId(npIndex & (~PxsContactManagerBase::NEW_CONTACT_MANAGER_MASK))];
+	else
+		return mNarrowPhasePairs.mCaches[PxsContactManagerBase::computeIndexFromId(npIndex)];
+}
+
+const Gu::Cache& PxsNphaseImplementationContext::getCache(PxU32 npIndex) const
+{
+	return const_cast<PxsNphaseImplementationContext*>(this)->getCache(npIndex);
+}
+
+namespace
+{
+	// Header of a saved contact manager state. Followed by the cached data and the friction patches, each padded to 16 bytes.
+	struct PxsContactManagerState
+	{
+		PxU32	cachedDataSize;			// bytes of cached data following the header
+		PxU32	frictionDataSize;		// bytes of friction patches following the cached data
+		PxU16	cachedSize;				// Gu::Cache::mCachedSize
+		PxU8	pairData;				// Gu::Cache::mPairData
+		PxU8	manifoldFlags;			// Gu::Cache::mManifoldFlags
+		PxU8	frictionPatchCount;		// PxcNpWorkUnit::mFrictionPatchCount
+		PxU8	persistentManifold;		// cached data is a copy of the Gu::PersistentContactManifold owned by the cache
+		PxU8	pad[2];
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(PxsContactManagerState) == 16);
+
+	PX_FORCE_INLINE PxU32 align16(PxU32 size)
+	{
+		return (size + 15) & ~15;
+	}
+
+	PX_FORCE_INLINE bool isPersistentManifold(const Gu::Cache& cache)
+	{
+		return cache.isManifold() && !cache.isMultiManifold();
+	}
+
+	PX_FORCE_INLINE PxU32 getPersistentManifoldSize(const Gu::PersistentContactManifold& manifold)
+	{
+		return manifold.mCapacity == GU_SPHERE_MANIFOLD_CACHE_SIZE ? sizeof(Gu::SpherePersistentContactManifold) : sizeof(Gu::LargePersistentContactManifold);
+	}
+
+	PX_FORCE_INLINE PxU32 getCachedDataSize(const Gu::Cache& cache)
+	{
+		if(isPersistentManifold(cache))
+			return getPersistentManifoldSize(const_cast<Gu::Cache&>(cache).getManifold());
+		return cache.mCachedData ? cache.mCachedSize : 0;
+	}
+}
+
+PxU32 PxsNphaseImplementationContext::getContactManagerStateSize(const PxsContactManager& cm) const
+{
+	const PxcNpWorkUnit& unit = cm.getWorkUnit();
+	const Gu::Cache& cache = getCache(unit.mNpIndex);
+
+	const PxU32 frictionDataSize = unit.mFrictionDataPtr ? unit.mFrictionPatchCount * sizeof(PxFrictionPatch) : 0;
+
+	return sizeof(PxsContactManagerState) + align16(getCachedDataSize(cache)) + align16(frictionDataSize);
+}
+
+void PxsNphaseImplementationContext::saveContactManagerState(const PxsContactManager& cm, PxU8* state) const
+{
+	const PxcNpWorkUnit& unit = cm.getWorkUnit();
+	const Gu::Cache& cache = getCache(unit.mNpIndex);
+
+	PxsContactManagerState header;
+	header.cachedDataSize		= getCachedDataSize(cache);
+	header.frictionDataSize		= unit.mFrictionDataPtr ? unit.mFrictionPatchCount * sizeof(PxFrictionPatch) : 0;
+	header.cachedSize			= cache.mCachedSize;
+	header.pairData				= cache.mPairData;
+	header.manifoldFlags		= cache.mManifoldFlags;
+	header.frictionPatchCount	= unit.mFrictionPatchCount;
+	header.persistentManifold	= PxU8(isPersistentManifold(cache));
+	header.pad[0] = header.pad[1] = 0;
+
+	PxMemCopy(state, &header, sizeof(PxsContactManagerState));
+	state += sizeof(PxsContactManagerState);
+
+	if(header.cachedDataSize)
+		PxMemCopy(state, cache.mCachedData, header.cachedDataSize);
+	state += align16(header.cachedDataSize);
+
+	if(header.frictionDataSize)
+		PxMemCopy(state, unit.mFrictionDataPtr, header.frictionDataSize);
+}
+
+bool PxsNphaseImplementationContext::isValidContactManagerState(const PxU8* state, PxU32 size) const
+{
+	if(size < sizeof(PxsContactManagerState))
+		return false;
+
+	PxsContactManagerState header;
+	PxMemCopy(&header, state, sizeof(PxsContactManagerState));
+
+	if(header.frictionDataSize && header.frictionDataSize != header.frictionPatchCount * sizeof(PxFrictionPatch))
+		return false;
+	if(header.cachedDataSize >= size || header.frictionDataSize >= size)
+		return false;
+
+	return size == sizeof(PxsContactManagerState) + align16(header.cachedDataSize) + align16(header.frictionDataSize);
+}
+
+void PxsNphaseImplementationContext::reserveContactManagerStates(PxU32 totalSize)
+{
+	// Contact managers that are not restored again can still point to the previous data, e.g. when their caches are
+	// reset but the narrow phase did not run yet. We keep it until releaseRetiredContactManagerStates().
+	if(mRestoredStates)
+		mRetiredRestoredStates.pushBack(mRestoredStates);
+
+	mRestoredStates = totalSize ? PX_ALLOCATE(PxU8, totalSize, "mRestoredStates") : NULL;
+	mRestoredStatesCapacity = totalSize;
+	mRestoredStatesSize = 0;
+}
+
+void PxsNphaseImplementationContext::releaseRetiredContactManagerStates()
+{
+	const PxU32 nbRetired = mRetiredRestoredStates.size();
+	for(PxU32 i=0; i<nbRetired; i++)
+		PX_FREE(mRetiredRestoredStates[i]);
+	mRetiredRestoredStates.clear();
+}
+
+void PxsNphaseImplementationContext::restoreContactManagerState(PxsContactManager& cm, const PxU8* state)
+{
+	PxcNpWorkUnit& unit = cm.getWorkUnit();
+	Gu::Cache& cache = getCache(unit.mNpIndex);
+
+	PxsContactManagerState header;
+	PxMemCopy(&header, state, sizeof(PxsContactManagerState));
+	state += sizeof(PxsContactManagerState);
+
+	const PxU8* cachedData = state;
+	const PxU8* frictionData = state + align16(header.cachedDataSize);
+
+	if(header.persistentManifold)
+	{
+		// The manifold object belongs to the cache (see PxsContext::createCache) and stays in place. We copy the saved
+		// contacts into it, except for the pointer to its own contact buffer. The geometry types of the pair did not change
+		// so the manifold has the same type as the saved one, unless the caches are not in sync for another reason.
+		if(isPersistentManifold(cache))
+		{
+			Gu::PersistentContactManifold& manifold = cache.getManifold();
+			if(getPersistentManifoldSize(manifold) == header.cachedDataSize)
+			{
+				Gu::PersistentContact* contactPoints = manifold.mContactPoints;
+				PxMemCopy(&manifold, cachedData, header.cachedDataSize);
+				manifold.mContactPoints = contactPoints;
+				cache.mPairData = header.pairData;
+			}
+		}
+	}
+	else if(!isPersistentManifold(cache))
+	{
+		// Stream-based caches (multi-manifolds, legacy contact caches) are position-independent. The narrow phase copies
+		// them to its own cache stream the next time it runs, so they can live in our buffer until then.
+		PxU8* dst = NULL;
+		if(header.cachedDataSize)
+		{
+			PX_ASSERT(mRestoredStatesSize + align16(header.cachedDataSize) <= mRestoredStatesCapacity);
+			dst = mRestoredStates + mRestoredStatesSize;
+			PxMemCopy(dst, cachedData, header.cachedDataSize);
+			mRestoredStatesSize += align16(header.cachedDataSize);
+		}
+		cache.mCachedData		= dst;
+		cache.mCachedSize		= header.cachedSize;
+		cache.mPairData			= header.pairData;
+		cache.mManifoldFlags	= header.manifoldFlags;
+	}
+
+	if(header.frictionDataSize)
+	{
+		PX_ASSERT(mRestoredStatesSize + align16(header.frictionDataSize) <= mRestoredStatesCapacity);
+		PxU8* dst = mRestoredStates + mRestoredStatesSize;
+		PxMemCopy(dst, frictionData, header.frictionDataSize);
+		mRestoredStatesSize += align16(header.frictionDataSize);
+
+		unit.mFrictionDataPtr = dst;
+		unit.mFrictionPatchCount = header.frictionPatchCount;
+	}
+	else
+	{
+		unit.mFrictionDataPtr = NULL;
+		unit.mFrictionPatchCount = 0;
+	}
+}
+
 PxvNphaseImplementationFallback* physx::createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxVirtualAllocatorCallback* allocator, bool gpuDynamics)
 {
 	// PT: TODO: remove useless placement new
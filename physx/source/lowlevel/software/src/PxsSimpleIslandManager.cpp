@@ -38,16 +38,65 @@ using namespace IG;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim)
+IslandSplitTask::IslandSplitTask(PxU64 contextID, IslandSim& islandSim, PxU32 taskIndex) : Cm::Task(contextID), mIslandSim(islandSim), mTaskIndex(taskIndex)
 {
 }
 
+void IslandSplitTask::runInternal()
+{
+	mIslandSim.processIslandSplits(mTaskIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim),
+	mFinishLostEdgesTask(contextID, this, "FinishLostEdgesTask")
+{
+}
+
+ThirdPassTask::~ThirdPassTask()
+{
+	for(PxU32 i=0; i<mIslandSplitTasks.size(); i++)
+		PX_DELETE(mIslandSplitTasks[i]);
+}
+
 void ThirdPassTask::runInternal()
 {
 	PX_PROFILE_ZONE("Basic.thirdPassIslandGen", mContextID);
 
 	mIslandSim.removeDestroyedEdges();
-	mIslandSim.processLostEdges(mIslandManager.mDestroyedNodes, true, true, mIslandManager.mMaxDirtyNodesPerFrame);
+
+	// With worker threads, independent islands are split in parallel. This gives the same results as processLostEdges(),
+	// so we don't need to check the enhanced determinism flag here.
+	const PxU32 nbWorkers = getTaskManager()->getCpuDispatcher()->getWorkerCount();
+	if(nbWorkers > 1)
+	{
+		const PxU32 nbTasks = mIslandSim.prepareIslandSplits(nbWorkers, mIslandManager.mMaxDirtyNodesPerFrame);
+		if(nbTasks)
+		{
+			mFinishLostEdgesTask.setContinuation(mCont);
+
+			for(PxU32 i=0; i<nbTasks; i++)
+			{
+				if(i == mIslandSplitTasks.size())
+					mIslandSplitTasks.pushBack(PX_NEW(IslandSplitTask)(mContextID, mIslandSim, i));
+
+				mIslandSplitTasks[i]->setContinuation(&mFinishLostEdgesTask);
+				mIslandSplitTasks[i]->removeReference();
+			}
+
+			mFinishLostEdgesTask.removeReference();
+		}
+		else
+			mIslandSim.finishLostEdges(mIslandManager.mDestroyedNodes, true);
+	}
+	else
+		mIslandSim.processLostEdges(mIslandManager.mDestroyedNodes, true, true, mIslandManager.mMaxDirtyNodesPerFrame);
+}
+
+void ThirdPassTask::finishLostEdges(PxBaseTask*)
+{
+	mIslandSim.finishLostEdges(mIslandManager.mDestroyedNodes, true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -298,7 +298,7 @@ namespace Bp
 		//ML: we create mGroups and mContactDistance in the AABBManager constructor. PxArray will take PxVirtualAllocator as a parameter. Therefore, if GPU BP is using,
 		//we will passed a pinned host memory allocator, otherwise, we will just pass a normal allocator.
 						GroupsArrayPinned		mGroups;				// NOTE: we stick Bp::FilterGroup::eINVALID in this slot to indicate that the entry is invalid (removed or never inserted.)
-						PxInt32ArrayPinned		mEnvIDs;				// PT: should ideally be in the GPU class
+						PxInt32ArrayPinned		mEnvIDs;				// Environment IDs, lazily allocated. Only supported by the GPU & ABP broadphases.
 						PxFloatArrayPinned& 	mContactDistance;
 						VolumeDataArrayPinned	mVolumeData;
 						BpFilter				mFilters;
@@ -323,6 +323,27 @@ namespace Bp
 													mVolumeData[index].setVolumeType(volumeType);	// PT: must be done after setUserData
 												}
 
+		PX_FORCE_INLINE	void					initEnvEntry(BoundsIndex index, PxU32 envID)
+												{
+													// We avoid allocating anything when the feature is not used, and allocate everything lazily
+													// as soon as a non-default environment ID is needed. We need the bounds array size to make sure
+													// we allocate a large enough array when setEnvironmentID() is called after some objects have
+													// already been created and the scene already simulated. See EnvIDTests_GPU.EnvironmentID_EdgeCase
+													// for why is it needed.
+													const bool validEntry = envID != PX_INVALID_U32;
+
+													const PxU32 currentSize = mEnvIDs.size();
+
+													if(validEntry || currentSize)
+													{
+														if((index + 1) >= currentSize)
+															mEnvIDs.resize(PxMax(mBoundsArray.size(), PxNextPowerOfTwo(index + 1)), PX_INVALID_U32);
+													}
+
+													if(validEntry || index < mEnvIDs.size())
+														mEnvIDs[index] = envID;
+												}
+
 		PX_FORCE_INLINE	void					resetEntry(BoundsIndex index)
 												{
 													mGroups[index] = Bp::FilterGroup::eINVALID;
@@ -106,6 +106,7 @@ static PX_FORCE_INLINE bool shouldPairBeDeleted(const GroupsArrayPinned& groups,
 		public:
 						PersistentSelfCollisionPairs*	mSelfCollisionPairs;
 						PxU32							mDirtyIndex;	// PT: index in mDirtyAggregates
+						PxU32							mEnvID;			// Environment ID, shared by all aggregated shapes
 		private:
 						AABB_Xi*						mInflatedBoundsX;
 						AABB_YZ*						mInflatedBoundsYZ;
@@ -833,6 +834,7 @@ void PersistentSelfCollisionPairs::findOverlaps(PairArray& pairs, const PxBounds
 
 Aggregate::Aggregate(BoundsIndex index, PxAggregateFilterHint filterHint) :
 	mIndex				(index),
+	mEnvID				(PX_INVALID_U32),
 	mInflatedBoundsX	(NULL),
 	mInflatedBoundsYZ	(NULL),
 	mAllocatedSize		(0),
@@ -1098,13 +1100,20 @@ static void removeAggregateFromDirtyArray(Aggregate* aggregate, PxArray<Aggregat
 	}
 }
 
+// Environment IDs are only supported by ABP on the CPU. It shards its boxes per environment, the other CPU broadphases would ignore the IDs.
+static PX_FORCE_INLINE bool supportsEnvIDs(const BroadPhase& bp)
+{
+	const PxBroadPhaseType::Enum type = bp.getType();
+	return type==PxBroadPhaseType::eABP || type==PxBroadPhaseType::ePABP;
+}
+
 // PT: userData = Sc::ElementSim
 bool AABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Bp::FilterGroup::Enum group, void* userData, AggregateHandle aggregateHandle, ElementType::Enum volumeType, PxU32 envID)
 {
-	if(envID!=PX_INVALID_U32)
+	if(envID!=PX_INVALID_U32 && !supportsEnvIDs(mBroadPhase))
 	{
 		envID = PX_INVALID_U32;
-		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "AABBManager::addBounds - environment ID is not supported in CPU broadphases\n");
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "AABBManager::addBounds - environment ID is only supported by the GPU and ABP broadphases\n");
 	}
 
 //	PX_ASSERT(checkID(index));
@@ -1116,6 +1125,8 @@ bool AABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Bp::Filte
 		mVolumeData[index].setSingleActor();
 
 		addBPEntry(index);
+
+		initEnvEntry(index, envID);
 	}
 	else
 	{
@@ -1150,6 +1161,9 @@ bool AABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Bp::Filte
 			// PT: new actor added to aggregate => mark dirty to recompute bounds later
 			aggregate->markAsDirty(mDirtyAggregates);
 		}
+
+		// For aggregates we retrieve the environment ID from the aggregate itself.
+		initEnvEntry(aggregate->mIndex, aggregate->mEnvID);
 	}
 
 	return true;
@@ -1194,13 +1208,14 @@ AggregateHandle AABBManager::createAggregate(BoundsIndex index, Bp::FilterGroup:
 {
 //	PX_ASSERT(checkID(index));
 
-	if(envID!=PX_INVALID_U32)
+	if(envID!=PX_INVALID_U32 && !supportsEnvIDs(mBroadPhase))
 	{
 		envID = PX_INVALID_U32;
-		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "AABBManager::createAggregate - environment ID is not supported in CPU broadphases\n");
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "AABBManager::createAggregate - environment ID is only supported by the GPU and ABP broadphases\n");
 	}
 
 	Aggregate* aggregate = PX_NEW(Aggregate)(index, filterHint);
+	aggregate->mEnvID = envID;
 
 	AggregateHandle handle;
 	if(mFirstFreeAggregate==PX_INVALID_U32)
@@ -1558,7 +1573,7 @@ void AABBManager::updateBPSecondPass(PxcScratchAllocator* scratchAllocator, PxBa
 	const BroadPhaseUpdateData updateData(mAddedHandles.begin(), mAddedHandles.size(),
 		mUpdatedHandles.begin(), mUpdatedHandles.size(),
 		mRemovedHandles.begin(), mRemovedHandles.size(),
-		mBoundsArray.begin(), mGroups.begin(), mContactDistance.begin(), mBoundsArray.size(),
+		mBoundsArray.begin(), mGroups.begin(), mContactDistance.begin(), mEnvIDs.begin(), mBoundsArray.size(),
 		mFilters,
 		// PT: TODO: this could also be removed now. The key to understanding the refactorings is that none of the two bools below are actualy used by the CPU versions.
 		mBoundsArray.hasChanged(),
@@ -33,6 +33,8 @@
 #include "BpBroadPhaseABP.h"
 #include "BpBroadPhaseShared.h"
 #include "foundation/PxVecMath.h"
+#include "foundation/PxVecMathAVX2.h"
+#include "foundation/PxCpuFeatures.h"
 #include "PxcScratchAllocator.h"
 #include "common/PxProfileZone.h"
 #include "CmRadixSort.h"
@@ -41,6 +43,7 @@
 
 #include "foundation/PxThread.h"
 #include "foundation/PxSync.h"
+#include "foundation/PxHashMap.h"
 #include "task/PxTask.h"
 
 using namespace physx;
@@ -68,6 +71,9 @@ PT: to try:
 #define	CODEALIGN16		//_asm	align 16
 #if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
 	#define ABP_SIMD_OVERLAP
+	#if PX_AVX2_SUPPORTED
+		#define ABP_AVX2	// AVX2 box pruning kernels, used when the CPU supports them
+	#endif
 #endif
 
 //#define ABP_BATCHING		128
@@ -2268,6 +2274,99 @@ static PX_FORCE_INLINE void outputPair(ABP_PairManager& pairManager, PxU32 index
 	pairManager.addPair(index0, index1);
 }
 
+#ifdef ABP_AVX2
+// AVX2 versions of the kernels, selected at runtime. Each iteration tests box0 against two boxes with a single
+// 8-wide comparison. Pairs are reported in the same order as with the SSE kernels.
+static PX_FORCE_INLINE PX_AVX2_TARGET Vec8V preloadBox0AVX2(const SIMD_AABB_YZ4& box0)
+{
+	SIMD_OVERLAP_INIT_9c(box0)
+	return V8Broadcast4(b);
+}
+
+// Tests box0 against the boxes starting at index1, until their minX exceeds maxLimit.
+template<class ABP_PairManagerT>
+static PX_FORCE_INLINE PX_AVX2_TARGET void boxPruningRunAVX2(	ABP_PairManagerT* PX_RESTRICT pairManager, PxU32 index0, PxU32 index1, const PosXType2 maxLimit,
+																const SIMD_AABB_X4* PX_RESTRICT boxes_X, const SIMD_AABB_YZ4* PX_RESTRICT boxes_YZ, const Vec8V b)
+{
+	// The X lists end with sentinels so reading the box after the last one is safe. The YZ lists don't, so
+	// we only load the YZ data of boxes whose minX passed the test.
+	while(boxes_X[index1+1].mMinX<=maxLimit)
+	{
+		const PxU32 mask = V8GetMask(V8IsGrtrOrEq(V8LoadU(&boxes_YZ[index1].mMinY), b));
+		if((mask & 0x0f)==0x0f)
+			outputPair(*pairManager, index0, index1);
+		if((mask & 0xf0)==0xf0)
+			outputPair(*pairManager, index0, index1+1);
+		index1 += 2;
+	}
+
+	if(boxes_X[index1].mMinX<=maxLimit)
+	{
+		if(_mm_movemask_ps(_mm_cmpge_ps(_mm_load_ps(&boxes_YZ[index1].mMinY), V8GetLow(b)))==15)
+			outputPair(*pairManager, index0, index1);
+	}
+}
+
+template<const int codepath, class ABP_PairManagerT>
+static PX_NOINLINE PX_AVX2_TARGET void boxPruningKernelAVX2(	PxU32 nb0, PxU32 nb1,
+																const SIMD_AABB_X4* PX_RESTRICT boxes0_X, const SIMD_AABB_X4* PX_RESTRICT boxes1_X,
+																const SIMD_AABB_YZ4* PX_RESTRICT boxes0_YZ, const SIMD_AABB_YZ4* PX_RESTRICT boxes1_YZ,
+																ABP_PairManagerT* PX_RESTRICT pairManager)
+{
+	PxU32 index0 = 0;
+	PxU32 runningIndex1 = 0;
+
+	while(runningIndex1<nb1 && index0<nb0)
+	{
+		const SIMD_AABB_X4& box0_X = boxes0_X[index0];
+		const PosXType2 maxLimit = box0_X.mMaxX;
+
+		const PosXType2 minLimit = box0_X.mMinX;
+		if(!codepath)
+		{
+			while(boxes1_X[runningIndex1].mMinX<minLimit)
+				runningIndex1++;
+		}
+		else
+		{
+			while(boxes1_X[runningIndex1].mMinX<=minLimit)
+				runningIndex1++;
+		}
+
+		boxPruningRunAVX2(pairManager, index0, runningIndex1, maxLimit, boxes1_X, boxes1_YZ, preloadBox0AVX2(boxes0_YZ[index0]));
+
+		index0++;
+	}
+	V8ZeroUpper();
+}
+
+template<class ABP_PairManagerT>
+static PX_NOINLINE PX_AVX2_TARGET void completeBoxPruningKernelAVX2(	ABP_PairManagerT* PX_RESTRICT pairManager, PxU32 nb,
+																		const SIMD_AABB_X4* PX_RESTRICT boxes_X, const SIMD_AABB_YZ4* PX_RESTRICT boxes_YZ)
+{
+	PxU32 index0 = 0;
+	PxU32 runningIndex = 0;
+	while(runningIndex<nb && index0<nb)
+	{
+		const SIMD_AABB_X4& box0_X = boxes_X[index0];
+		const PosXType2 maxLimit = box0_X.mMaxX;
+
+		const PosXType2 minLimit = box0_X.mMinX;
+		while(boxes_X[runningIndex++].mMinX<minLimit);
+
+		boxPruningRunAVX2(pairManager, index0, runningIndex, maxLimit, boxes_X, boxes_YZ, preloadBox0AVX2(boxes_YZ[index0]));
+
+		index0++;
+	}
+	V8ZeroUpper();
+}
+
+static PX_FORCE_INLINE bool useAVX2Kernels()
+{
+	return PxIsCpuFeatureSupported(PxCpuFeature::eAVX2);
+}
+#endif
+
 template<const int codepath, class ABP_PairManagerT>
 static void boxPruningKernel(	PxU32 nb0, PxU32 nb1,
 								const SIMD_AABB_X4* PX_RESTRICT boxes0_X, const SIMD_AABB_X4* PX_RESTRICT boxes1_X,
@@ -2278,6 +2377,14 @@ static void boxPruningKernel(	PxU32 nb0, PxU32 nb1,
 	pairManager->mInToOut0 = inToOut0;
 	pairManager->mInToOut1 = inToOut1;
 
+#ifdef ABP_AVX2
+	if(useAVX2Kernels())
+	{
+		boxPruningKernelAVX2<codepath>(nb0, nb1, boxes0_X, boxes1_X, boxes0_YZ, boxes1_YZ, pairManager);
+		return;
+	}
+#endif
+
 	PxU32 index0 = 0;
 	PxU32 runningIndex1 = 0;
 
@@ -2455,6 +2562,14 @@ static void doCompleteBoxPruning_Leaf(	ABP_PairManagerT* PX_RESTRICT pairManager
 	pairManager->mInToOut0 = remap;
 	pairManager->mInToOut1 = remap;
 
+#ifdef ABP_AVX2
+	if(useAVX2Kernels())
+	{
+		completeBoxPruningKernelAVX2(pairManager, nb, boxes_X, boxes_YZ);
+		return;
+	}
+#endif
+
 	PxU32 index0 = 0;
 	PxU32 runningIndex = 0;
 	while(runningIndex<nb && index0<nb)
@@ -3978,6 +4093,670 @@ void ABP::setTransientData(const PxBounds3* bounds, const PxReal* contactDistanc
 }
 ///////////////////////////////////////////////////////////////////////////////
 
+// These functions pass handles from the AABB manager to an ABP instance. The wrapper below uses them for the main
+// instance. The environment shards use them with their own local handles.
+
+static void removeABPObjects(ABP* PX_RESTRICT abp, const BpHandle* PX_RESTRICT removed, PxU32 nbRemoved)
+{
+	while(nbRemoved--)
+	{
+		const BpHandle index = *removed++;
+		PX_ASSERT(index+1<abp->mShared.mABP_Objects_Capacity);	// We allocated one more box on purpose
+		abp->removeObject(index);
+	}
+}
+
+static void updateABPObjects(ABP* PX_RESTRICT abp, const BpHandle* PX_RESTRICT updated, PxU32 nbUpdated)
+{
+	while(nbUpdated--)
+	{
+		const BpHandle index = *updated++;
+		PX_ASSERT(index+1<abp->mShared.mABP_Objects_Capacity);	// We allocated one more box on purpose
+		abp->updateObject(index);
+	}
+}
+
+static void addABPObjects(ABP* PX_RESTRICT abp, const BpHandle* PX_RESTRICT created, PxU32 nbAdded, const Bp::FilterGroup::Enum* PX_RESTRICT groups)
+{
+	struct Batch
+	{
+		PX_FORCE_INLINE	Batch() : mNb(0), mMaxIndex(0)	{}
+
+		PxU32		mNb;
+		PxU32		mMaxIndex;
+		BpHandle	mIndices[ABP_BATCHING];
+
+		PX_FORCE_INLINE void add(const BpHandle index, ABP* PX_RESTRICT abp_, FilterType::Enum type)
+		{
+			PxU32 nb = mNb;
+			mMaxIndex = PxMax(mMaxIndex, index);
+			mIndices[nb++] = index;
+			if(nb==ABP_BATCHING)
+			{
+				mNb = 0;
+				// PT: TODO: we could use a function ptr here
+				if(type==FilterType::STATIC)
+					abp_->addStaticObjects(mIndices, ABP_BATCHING, mMaxIndex);
+				else if(type==FilterType::KINEMATIC)
+					abp_->addKinematicObjects(mIndices, ABP_BATCHING, mMaxIndex);
+				else
+				{
+					PX_ASSERT(type==FilterType::DYNAMIC || type==FilterType::AGGREGATE);
+					abp_->addDynamicObjects(mIndices, ABP_BATCHING, mMaxIndex);
+				}
+
+				mMaxIndex = 0;
+			}
+			else
+				mNb = nb;
+		}
+	};
+	Batch statics;
+	Batch dynamics;
+	Batch kinematics;
+
+	Batch* batches[FilterType::COUNT] = {NULL};
+	batches[FilterType::STATIC] = &statics;
+	batches[FilterType::DYNAMIC] = &dynamics;
+	batches[FilterType::AGGREGATE] = &dynamics;
+	batches[FilterType::KINEMATIC] = &kinematics;
+
+	while(nbAdded--)
+	{
+		const BpHandle index = *created++;
+		PX_ASSERT(index+1<abp->mShared.mABP_Objects_Capacity);	// We allocated one more box on purpose
+		FilterType::Enum type = FilterType::Enum(groups[index] & BP_FILTERING_TYPE_MASK);
+		if(!batches[type])
+			type = FilterType::DYNAMIC;
+		batches[type]->add(index, abp, type);
+	}
+
+	if(statics.mNb)
+		abp->addStaticObjects(statics.mIndices, statics.mNb, statics.mMaxIndex);
+	if(kinematics.mNb)
+		abp->addKinematicObjects(kinematics.mIndices, kinematics.mNb, kinematics.mMaxIndex);
+	if(dynamics.mNb)
+		abp->addDynamicObjects(dynamics.mIndices, dynamics.mNb, dynamics.mMaxIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Environment shards.
+//
+// An entry with a valid environment ID only collides with entries from the same environment, and with shared entries.
+// Shared entries are the ones with an invalid environment ID, e.g. a ground plane. Each environment gets its own ABP
+// instance (a shard), so the box pruning never sees boxes from two different environments. The cost of the broadphase
+// then grows with the number of entries per environment, not with the total number of entries in the scene.
+//
+// Shared entries stay in the main ABP instance, which finds the shared-vs-shared pairs. They are also mirrored in every
+// shard, which finds the shared-vs-environment pairs. This works best when there are few shared entries and they rarely
+// move, since each shared update is forwarded to all the shards.
+//
+// Shards use local handles. Odd handles are for the environment's own entries. Even handles (2 * shared slot) are for
+// the mirrored shared entries. This keeps the per-shard arrays proportional to the number of entries in the environment.
+
+#define ABP_SHARED_SHARD	INVALID_ID
+#define ABP_NB_SHARD_TASKS	64
+
+	struct ABP_ShardEntry
+	{
+		PxU32	mShard;	// Shard index, or ABP_SHARED_SHARD for shared entries
+		PxU32	mLocal;	// Local handle in the shard, or shared slot for shared entries. INVALID_ID if the handle is not in the BP.
+	};
+
+	class ABP_Shard : public PxUserAllocated
+	{
+												PX_NOCOPY(ABP_Shard)
+		public:
+												ABP_Shard(PxU64 contextID);
+												~ABP_Shard()	{}
+
+						BpHandle				allocLocalHandle();
+						void					addEntry(BpHandle localHandle, BpHandle handle, const PxBounds3& bounds, PxReal contactDistance, Bp::FilterGroup::Enum group);
+						void					updateEntry(BpHandle localHandle, const PxBounds3& bounds, PxReal contactDistance);
+						void					removeEntry(BpHandle localHandle);
+						void					update(PxcScratchAllocator* scratchAllocator, const bool* PX_RESTRICT lut);
+
+						ABP						mABP;
+						PxArray<BpHandle>		mLocalToGlobal;			// Indexed by local handle
+						PxArray<PxBounds3>		mBounds;				// Indexed by local handle, with one more box for SIMD loads
+						PxArray<PxReal>			mContactDistances;		// Indexed by local handle
+				PxArray<Bp::FilterGroup::Enum>	mGroups;				// Indexed by local handle
+						PxArray<BpHandle>		mFreeLocalHandles;
+						PxArray<BpHandle>		mReleasedLocalHandles;	// Only recycled after the update, ABP cannot remove & re-add a handle in the same frame
+						PxU32					mNbLocalHandles;		// Number of odd handles allocated so far
+						PxArray<BpHandle>		mCreated;
+						PxArray<BpHandle>		mUpdated;
+						PxArray<BpHandle>		mRemoved;
+						PxArray<BroadPhasePair>	mCreatedPairs;			// Global handles, after update()
+						PxArray<BroadPhasePair>	mDeletedPairs;			// Global handles, after update()
+						bool					mDirty;
+		private:
+						void					resizeEntries(PxU32 nbEntries);
+	};
+
+ABP_Shard::ABP_Shard(PxU64 contextID) :
+	mABP			(contextID),
+	mNbLocalHandles	(0),
+	mDirty			(false)
+{
+}
+
+BpHandle ABP_Shard::allocLocalHandle()
+{
+	if(mFreeLocalHandles.size())
+		return mFreeLocalHandles.popBack();
+	return (mNbLocalHandles++)*2 + 1;
+}
+
+void ABP_Shard::resizeEntries(PxU32 nbEntries)
+{
+	const PxU32 newSize = PxMax(nbEntries, mLocalToGlobal.size()*2);
+	mLocalToGlobal.resize(newSize, INVALID_ID);
+	mBounds.resize(newSize+1, PxBounds3::empty());
+	mContactDistances.resize(newSize, 0.0f);
+	mGroups.resize(newSize, Bp::FilterGroup::eINVALID);
+}
+
+void ABP_Shard::addEntry(BpHandle localHandle, BpHandle handle, const PxBounds3& bounds, PxReal contactDistance, Bp::FilterGroup::Enum group)
+{
+	if(localHandle>=mLocalToGlobal.size())
+		resizeEntries(localHandle+1);
+
+	mLocalToGlobal[localHandle] = handle;
+	mBounds[localHandle] = bounds;
+	mContactDistances[localHandle] = contactDistance;
+	mGroups[localHandle] = group;
+	mCreated.pushBack(localHandle);
+}
+
+void ABP_Shard::updateEntry(BpHandle localHandle, const PxBounds3& bounds, PxReal contactDistance)
+{
+	PX_ASSERT(localHandle<mLocalToGlobal.size());
+	mBounds[localHandle] = bounds;
+	mContactDistances[localHandle] = contactDistance;
+	mUpdated.pushBack(localHandle);
+}
+
+void ABP_Shard::removeEntry(BpHandle localHandle)
+{
+	PX_ASSERT(localHandle<mLocalToGlobal.size());
+	mRemoved.pushBack(localHandle);
+
+	// Even handles belong to the shared slots, which are recycled by the owner
+	if(localHandle&1)
+		mReleasedLocalHandles.pushBack(localHandle);
+}
+
+// Converts pairs from local to global handles. Shared-vs-shared pairs (both handles even) are dropped here, because
+// the main ABP instance reports them.
+static void remapShardPairs(PxArray<BroadPhasePair>& pairs, const BpHandle* PX_RESTRICT localToGlobal)
+{
+	const PxU32 nbPairs = pairs.size();
+	BroadPhasePair* PX_RESTRICT p = pairs.begin();
+	PxU32 nbKept = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const PxU32 id0 = p[i].mVolA;
+		const PxU32 id1 = p[i].mVolB;
+		if(!((id0|id1)&1))
+			continue;
+
+		PxU32 globalID0 = localToGlobal[id0];
+		PxU32 globalID1 = localToGlobal[id1];
+		if(globalID0>globalID1)
+			PxSwap(globalID0, globalID1);
+
+		p[nbKept].mVolA = globalID0;
+		p[nbKept].mVolB = globalID1;
+		nbKept++;
+	}
+	pairs.forceSize_Unsafe(nbKept);
+}
+
+void ABP_Shard::update(PxcScratchAllocator* scratchAllocator, const bool* PX_RESTRICT lut)
+{
+	mABP.mMM.mScratchAllocator = scratchAllocator;
+	mABP.setTransientData(mBounds.begin(), mContactDistances.begin());
+	mABP.mShared.checkResize(mLocalToGlobal.size());
+
+	removeABPObjects(&mABP, mRemoved.begin(), mRemoved.size());
+	addABPObjects(&mABP, mCreated.begin(), mCreated.size(), mGroups.begin());
+	updateABPObjects(&mABP, mUpdated.begin(), mUpdated.size());
+	mRemoved.clear();
+	mCreated.clear();
+	mUpdated.clear();
+
+	mABP.Region_prepareOverlaps();
+	mABP.findOverlaps(NULL, mGroups.begin(), lut);
+	mABP.finalize(mCreatedPairs, mDeletedPairs);
+	mABP.freeBuffers();
+
+	remapShardPairs(mCreatedPairs, mLocalToGlobal.begin());
+	remapShardPairs(mDeletedPairs, mLocalToGlobal.begin());
+
+	const PxU32 nbReleased = mReleasedLocalHandles.size();
+	for(PxU32 i=0;i<nbReleased;i++)
+		mFreeLocalHandles.pushBack(mReleasedLocalHandles[i]);
+	mReleasedLocalHandles.clear();
+}
+
+#ifdef ABP_MT2
+	class ABP_EnvShards;
+
+	class ABP_ShardTask : public PxLightCpuTask
+	{
+		public:
+							ABP_ShardTask() : mOwner(NULL), mStart(0), mNb(0), mScratchAllocator(NULL), mLUT(NULL)	{}
+
+		virtual	const char* getName()	const	PX_OVERRIDE
+		{
+			return "ABP_ShardTask";
+		}
+
+		virtual void run()	PX_OVERRIDE;
+
+		virtual bool	isHighPriority()	const	PX_OVERRIDE	{ return true; }
+
+		ABP_EnvShards*			mOwner;
+		PxU32					mStart;	// Index in mDirtyShards
+		PxU32					mNb;
+		PxcScratchAllocator*	mScratchAllocator;
+		const bool*				mLUT;
+	};
+
+	class ABP_ShardMergeTask : public PxLightCpuTask
+	{
+		public:
+							ABP_ShardMergeTask() : mOwner(NULL), mBP(NULL)	{}
+
+		virtual	const char* getName()	const	PX_OVERRIDE
+		{
+			return "ABP_ShardMergeTask";
+		}
+
+		virtual void run()	PX_OVERRIDE;
+
+		virtual bool	isHighPriority()	const	PX_OVERRIDE	{ return true; }
+
+		ABP_EnvShards*			mOwner;
+		BroadPhaseABP*			mBP;
+	};
+#endif
+
+	class ABP_EnvShards : public PxUserAllocated
+	{
+												PX_NOCOPY(ABP_EnvShards)
+		public:
+												ABP_EnvShards(PxU64 contextID);
+												~ABP_EnvShards();
+
+						void					addSharedObjects(const ABP& abp);
+						void					dispatch(const BroadPhaseUpdateData& updateData);
+						void					updateShards(PxU32 start, PxU32 nb, PxcScratchAllocator* scratchAllocator, const bool* PX_RESTRICT lut);
+						void					mergeResults(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs);
+#ifdef ABP_MT2
+						PxBaseTask*				startTasks(BroadPhaseABP* bp, PxcScratchAllocator* scratchAllocator, const bool* lut, PxBaseTask* continuation);
+#endif
+#if PX_CHECKED
+						bool					isValid(const BroadPhaseUpdateData& updateData)	const;
+#endif
+						PxArray<ABP_Shard*>		mShards;
+						PxHashMap<PxU32, PxU32>	mEnvToShard;
+						PxArray<ABP_ShardEntry>	mEntries;				// Indexed by BpHandle
+						PxArray<BpHandle>		mSharedObjects;			// Indexed by shared slot, INVALID_ID for free slots
+						PxArray<PxU32>			mFreeSharedSlots;
+						PxArray<PxU32>			mReleasedSharedSlots;	// Recycled in the next dispatch, like local handles
+						PxArray<PxU32>			mDirtyShards;			// Shards with work to do this frame
+						// Shared entries for the main ABP instance
+						PxArray<BpHandle>		mSharedCreated;
+						PxArray<BpHandle>		mSharedUpdated;
+						PxArray<BpHandle>		mSharedRemoved;
+				const	PxU64					mContextID;
+#ifdef ABP_MT2
+						ABP_ShardTask			mShardTasks[ABP_NB_SHARD_TASKS];
+						ABP_ShardMergeTask		mMergeTask;
+#endif
+		private:
+						PxU32					getShard(PxU32 envID, const PxBounds3* PX_RESTRICT bounds, const PxReal* PX_RESTRICT distances, const Bp::FilterGroup::Enum* PX_RESTRICT groups);
+						PxU32					allocSharedSlot();
+
+		PX_FORCE_INLINE	void					markDirty(PxU32 shardIndex)
+												{
+													ABP_Shard* shard = mShards[shardIndex];
+													if(!shard->mDirty)
+													{
+														shard->mDirty = true;
+														mDirtyShards.pushBack(shardIndex);
+													}
+												}
+	};
+
+ABP_EnvShards::ABP_EnvShards(PxU64 contextID) : mContextID(contextID)
+{
+#ifdef ABP_MT2
+	for(PxU32 i=0;i<ABP_NB_SHARD_TASKS;i++)
+	{
+		mShardTasks[i].mOwner = this;
+		mShardTasks[i].setContextId(contextID);
+	}
+	mMergeTask.mOwner = this;
+	mMergeTask.setContextId(contextID);
+#endif
+}
+
+ABP_EnvShards::~ABP_EnvShards()
+{
+	const PxU32 nbShards = mShards.size();
+	for(PxU32 i=0;i<nbShards;i++)
+		PX_DELETE(mShards[i]);
+}
+
+PxU32 ABP_EnvShards::allocSharedSlot()
+{
+	if(mFreeSharedSlots.size())
+		return mFreeSharedSlots.popBack();
+
+	const PxU32 slot = mSharedObjects.size();
+	mSharedObjects.pushBack(INVALID_ID);
+	return slot;
+}
+
+// Entries already in the main ABP instance when the first environment ID shows up become shared entries.
+void ABP_EnvShards::addSharedObjects(const ABP& abp)
+{
+	const PxU32 nbObjects = abp.mShared.mABP_Objects_Capacity;
+	const ABP_Object* PX_RESTRICT objects = abp.mShared.mABP_Objects;
+
+	const ABP_ShardEntry invalidEntry = { INVALID_ID, INVALID_ID };
+	if(mEntries.size()<nbObjects)
+		mEntries.resize(nbObjects, invalidEntry);
+
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		if(objects[i].isValid())
+		{
+			const PxU32 slot = allocSharedSlot();
+			mSharedObjects[slot] = i;
+			mEntries[i].mShard = ABP_SHARED_SHARD;
+			mEntries[i].mLocal = slot;
+		}
+	}
+}
+
+PxU32 ABP_EnvShards::getShard(PxU32 envID, const PxBounds3* PX_RESTRICT bounds, const PxReal* PX_RESTRICT distances, const Bp::FilterGroup::Enum* PX_RESTRICT groups)
+{
+	const PxHashMap<PxU32, PxU32>::Entry* entry = mEnvToShard.find(envID);
+	if(entry)
+		return entry->second;
+
+	const PxU32 shardIndex = mShards.size();
+	ABP_Shard* shard = PX_NEW(ABP_Shard)(mContextID);
+	mShards.pushBack(shard);
+	mEnvToShard.insert(envID, shardIndex);
+
+	// Mirror the current shared entries in the new shard
+	const PxU32 nbSlots = mSharedObjects.size();
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		const BpHandle handle = mSharedObjects[slot];
+		if(handle!=INVALID_ID)
+			shard->addEntry(slot*2, handle, bounds[handle], distances[handle], groups[handle]);
+	}
+	return shardIndex;
+}
+
+void ABP_EnvShards::dispatch(const BroadPhaseUpdateData& updateData)
+{
+	PX_PROFILE_ZONE("ABP - dispatch to shards", mContextID);
+
+	const PxBounds3* PX_RESTRICT bounds = updateData.getAABBs();
+	const PxReal* PX_RESTRICT distances = updateData.getContactDistance();
+	const Bp::FilterGroup::Enum* PX_RESTRICT groups = updateData.getGroups();
+	const PxU32* PX_RESTRICT envIDs = updateData.getEnvIDs();
+
+	const ABP_ShardEntry invalidEntry = { INVALID_ID, INVALID_ID };
+	const PxU32 capacity = updateData.getCapacity();
+	if(mEntries.size()<capacity)
+		mEntries.resize(capacity, invalidEntry);
+
+	mSharedCreated.clear();
+	mSharedUpdated.clear();
+	mSharedRemoved.clear();
+
+	{
+		const PxU32 nbReleased = mReleasedSharedSlots.size();
+		for(PxU32 i=0;i<nbReleased;i++)
+			mFreeSharedSlots.pushBack(mReleasedSharedSlots[i]);
+		mReleasedSharedSlots.clear();
+	}
+
+	const BpHandle* removed = updateData.getRemovedHandles();
+	if(removed)
+	{
+		PxU32 nb = updateData.getNumRemovedHandles();
+		while(nb--)
+		{
+			const BpHandle handle = *removed++;
+			ABP_ShardEntry& entry = mEntries[handle];
+			PX_ASSERT(entry.mLocal!=INVALID_ID);
+			if(entry.mShard==ABP_SHARED_SHARD)
+			{
+				const PxU32 slot = entry.mLocal;
+				mSharedRemoved.pushBack(handle);
+				mSharedObjects[slot] = INVALID_ID;
+				mReleasedSharedSlots.pushBack(slot);
+
+				const PxU32 nbShards = mShards.size();
+				for(PxU32 i=0;i<nbShards;i++)
+				{
+					mShards[i]->removeEntry(slot*2);
+					markDirty(i);
+				}
+			}
+			else
+			{
+				mShards[entry.mShard]->removeEntry(entry.mLocal);
+				markDirty(entry.mShard);
+			}
+			entry = invalidEntry;
+		}
+	}
+
+	// Updated entries are processed before created ones. A shard created in this call mirrors the shared entries with
+	// their current bounds, so it must not also receive them as updated entries.
+	const BpHandle* updated = updateData.getUpdatedHandles();
+	if(updated)
+	{
+		PxU32 nb = updateData.getNumUpdatedHandles();
+		while(nb--)
+		{
+			const BpHandle handle = *updated++;
+			const ABP_ShardEntry& entry = mEntries[handle];
+			PX_ASSERT(entry.mLocal!=INVALID_ID);
+			if(entry.mShard==ABP_SHARED_SHARD)
+			{
+				mSharedUpdated.pushBack(handle);
+
+				const PxU32 nbShards = mShards.size();
+				for(PxU32 i=0;i<nbShards;i++)
+				{
+					mShards[i]->updateEntry(entry.mLocal*2, bounds[handle], distances[handle]);
+					markDirty(i);
+				}
+			}
+			else
+			{
+				mShards[entry.mShard]->updateEntry(entry.mLocal, bounds[handle], distances[handle]);
+				markDirty(entry.mShard);
+			}
+		}
+	}
+
+	const BpHandle* created = updateData.getCreatedHandles();
+	if(created)
+	{
+		PxU32 nb = updateData.getNumCreatedHandles();
+		while(nb--)
+		{
+			const BpHandle handle = *created++;
+			ABP_ShardEntry& entry = mEntries[handle];
+			const PxU32 envID = envIDs ? envIDs[handle] : PX_INVALID_U32;
+			if(envID==PX_INVALID_U32)
+			{
+				const PxU32 slot = allocSharedSlot();
+				mSharedObjects[slot] = handle;
+				mSharedCreated.pushBack(handle);
+				entry.mShard = ABP_SHARED_SHARD;
+				entry.mLocal = slot;
+
+				const PxU32 nbShards = mShards.size();
+				for(PxU32 i=0;i<nbShards;i++)
+				{
+					mShards[i]->addEntry(slot*2, handle, bounds[handle], distances[handle], groups[handle]);
+					markDirty(i);
+				}
+			}
+			else
+			{
+				const PxU32 shardIndex = getShard(envID, bounds, distances, groups);
+				ABP_Shard* shard = mShards[shardIndex];
+				const BpHandle localHandle = shard->allocLocalHandle();
+				shard->addEntry(localHandle, handle, bounds[handle], distances[handle], groups[handle]);
+				markDirty(shardIndex);
+				entry.mShard = shardIndex;
+				entry.mLocal = localHandle;
+			}
+		}
+	}
+}
+
+void ABP_EnvShards::updateShards(PxU32 start, PxU32 nb, PxcScratchAllocator* scratchAllocator, const bool* PX_RESTRICT lut)
+{
+	PX_PROFILE_ZONE("ABP - updateShards", mContextID);
+
+	const PxU32* PX_RESTRICT dirtyShards = mDirtyShards.begin() + start;
+	while(nb--)
+		mShards[*dirtyShards++]->update(scratchAllocator, lut);
+}
+
+// Shards are merged in the order they were first touched in dispatch(), so the results do not depend on the number of threads
+void ABP_EnvShards::mergeResults(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs)
+{
+	PX_PROFILE_ZONE("ABP - mergeResults", mContextID);
+
+	const PxU32 nbDirty = mDirtyShards.size();
+	for(PxU32 i=0;i<nbDirty;i++)
+	{
+		ABP_Shard* shard = mShards[mDirtyShards[i]];
+		shard->mDirty = false;
+
+		const PxU32 nbCreated = shard->mCreatedPairs.size();
+		if(nbCreated)
+		{
+			BroadPhasePair* dst = Cm::reserveContainerMemory(createdPairs, nbCreated);
+			PxMemCopy(dst, shard->mCreatedPairs.begin(), nbCreated*sizeof(BroadPhasePair));
+			shard->mCreatedPairs.clear();
+		}
+
+		const PxU32 nbDeleted = shard->mDeletedPairs.size();
+		if(nbDeleted)
+		{
+			BroadPhasePair* dst = Cm::reserveContainerMemory(deletedPairs, nbDeleted);
+			PxMemCopy(dst, shard->mDeletedPairs.begin(), nbDeleted*sizeof(BroadPhasePair));
+			shard->mDeletedPairs.clear();
+		}
+	}
+	mDirtyShards.clear();
+}
+
+#ifdef ABP_MT2
+PxBaseTask* ABP_EnvShards::startTasks(BroadPhaseABP* bp, PxcScratchAllocator* scratchAllocator, const bool* lut, PxBaseTask* continuation)
+{
+	mMergeTask.mBP = bp;
+	mMergeTask.setContinuation(continuation);
+
+	// Environments are usually all alike so we simply split the dirty shards evenly
+	const PxU32 nbDirty = mDirtyShards.size();
+	const PxU32 nbTasks = PxMin(nbDirty, PxU32(ABP_NB_SHARD_TASKS));
+	PxU32 start = 0;
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		const PxU32 nb = (nbDirty - start)/(nbTasks - i);
+
+		ABP_ShardTask& task = mShardTasks[i];
+		task.mStart = start;
+		task.mNb = nb;
+		task.mScratchAllocator = scratchAllocator;
+		task.mLUT = lut;
+		task.setContinuation(&mMergeTask);
+		task.removeReference();
+
+		start += nb;
+	}
+	PX_ASSERT(start==nbDirty);
+
+	// The caller removes the merge task's reference, once the main ABP instance has also been started
+	return &mMergeTask;
+}
+
+void ABP_ShardTask::run()
+{
+	PX_SIMD_GUARD
+
+	mOwner->updateShards(mStart, mNb, mScratchAllocator, mLUT);
+}
+
+void ABP_ShardMergeTask::run()
+{
+	mOwner->mergeResults(mBP->mCreated, mBP->mDeleted);
+}
+#endif
+
+#if PX_CHECKED
+bool ABP_EnvShards::isValid(const BroadPhaseUpdateData& updateData) const
+{
+	const PxU32 nbEntries = mEntries.size();
+
+	const BpHandle* created = updateData.getCreatedHandles();
+	if(created)
+	{
+		PxU32 nbToGo = updateData.getNumCreatedHandles();
+		while(nbToGo--)
+		{
+			const BpHandle index = *created++;
+			if(index<nbEntries && mEntries[index].mLocal!=INVALID_ID)
+				return false;	// This object has been added already
+		}
+	}
+
+	const BpHandle* updated = updateData.getUpdatedHandles();
+	if(updated)
+	{
+		PxU32 nbToGo = updateData.getNumUpdatedHandles();
+		while(nbToGo--)
+		{
+			const BpHandle index = *updated++;
+			if(index>=nbEntries || mEntries[index].mLocal==INVALID_ID)
+				return false;	// This object has been removed already, or never been added
+		}
+	}
+
+	const BpHandle* removed = updateData.getRemovedHandles();
+	if(removed)
+	{
+		PxU32 nbToGo = updateData.getNumRemovedHandles();
+		while(nbToGo--)
+		{
+			const BpHandle index = *removed++;
+			if(index>=nbEntries || mEntries[index].mLocal==INVALID_ID)
+				return false;	// This object has been removed already, or never been added
+		}
+	}
+	return true;
+}
+#endif
+
 }
 
 // Below is the PhysX wrapper = link between AABBManager and ABP
@@ -3991,6 +4770,7 @@ BroadPhaseABP::BroadPhaseABP(	PxU32 maxNbBroadPhaseOverlaps,
 								PxU32 maxNbDynamicShapes,
 								PxU64 contextID,
 								bool enableMT) :
+	mEnvShards		(NULL),
 	mNbAdded		(0),
 	mNbUpdated		(0),
 	mNbRemoved		(0),
@@ -4013,6 +4793,7 @@ BroadPhaseABP::BroadPhaseABP(	PxU32 maxNbBroadPhaseOverlaps,
 
 BroadPhaseABP::~BroadPhaseABP()
 {
+	PX_DELETE(mEnvShards);
 	PX_DELETE(mABP);
 }
 
@@ -4030,6 +4811,13 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 		const PxU32 newCapacity = updateData.getCapacity();
 		mABP->mShared.checkResize(newCapacity);
 
+		// Switch to environment shards the first time we see environment IDs
+		if(updateData.getEnvIDs() && !mEnvShards)
+		{
+			mEnvShards = PX_NEW(ABP_EnvShards)(mContextID);
+			mEnvShards->addSharedObjects(*mABP);
+		}
+
 #if PX_CHECKED
 		// PT: WARNING: this must be done after the allocateMappingArray call
 		if(!BroadPhaseUpdateData::isValid(updateData, *this, false, mContextID))
@@ -4047,12 +4835,31 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 		mCreatedHandles	= updateData.getCreatedHandles();
 		mUpdatedHandles	= updateData.getUpdatedHandles();
 		mRemovedHandles	= updateData.getRemovedHandles();
+
+		if(mEnvShards)
+		{
+			// Send entries with an environment ID to their shard. Only the shared entries are left for the main ABP instance.
+			mEnvShards->dispatch(updateData);
+
+			mNbAdded		= mEnvShards->mSharedCreated.size();
+			mNbUpdated		= mEnvShards->mSharedUpdated.size();
+			mNbRemoved		= mEnvShards->mSharedRemoved.size();
+			mCreatedHandles	= mEnvShards->mSharedCreated.begin();
+			mUpdatedHandles	= mEnvShards->mSharedUpdated.begin();
+			mRemovedHandles	= mEnvShards->mSharedRemoved.begin();
+		}
 	}
 
 	// PT: run single-threaded if forced to do so
 	if(!mEnableMT)
 		continuation = NULL;
 
+#ifdef ABP_MT2
+	// Shards run in parallel with the main ABP instance. Their results are merged once everything is done.
+	if(continuation && mEnvShards)
+		continuation = mEnvShards->startTasks(this, scratchAllocator, mFilter->getLUT(), continuation);
+#endif
+
 #ifdef ABP_MT2
 	if(continuation)
 	{
@@ -4092,6 +4899,19 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 			mABP->finalize(mCreated, mDeleted);
 		}
 	}
+
+	if(mEnvShards)
+	{
+#ifdef ABP_MT2
+		if(continuation)
+			mEnvShards->mMergeTask.removeReference();
+		else
+#endif
+		{
+			mEnvShards->updateShards(0, mEnvShards->mDirtyShards.size(), scratchAllocator, mFilter->getLUT());
+			mEnvShards->mergeResults(mCreated, mDeleted);
+		}
+	}
 }
 
 #ifdef ABP_MT2
@@ -4146,109 +4966,30 @@ void BroadPhaseABP::removeObjects()
 {
 	PX_PROFILE_ZONE("BroadPhaseABP - removeObjects", mContextID);
 
-	PxU32 nbRemoved = mNbRemoved;
-	const BpHandle* removed = mRemovedHandles;
-
-	if(!nbRemoved || !removed)
+	if(!mNbRemoved || !mRemovedHandles)
 		return;
 
-	while(nbRemoved--)
-	{
-		const BpHandle index = *removed++;
-		PX_ASSERT(index+1<mABP->mShared.mABP_Objects_Capacity);	// PT: we allocated one more box on purpose
-		mABP->removeObject(index);
-	}
+	removeABPObjects(mABP, mRemovedHandles, mNbRemoved);
 }
 
 void BroadPhaseABP::updateObjects()
 {
 	PX_PROFILE_ZONE("BroadPhaseABP - updateObjects", mContextID);
 
-	PxU32 nbUpdated = mNbUpdated;
-	const BpHandle* updated = mUpdatedHandles;
-
-	if(!nbUpdated || !updated)
+	if(!mNbUpdated || !mUpdatedHandles)
 		return;
 
-	while(nbUpdated--)
-	{
-		const BpHandle index = *updated++;
-		PX_ASSERT(index+1<mABP->mShared.mABP_Objects_Capacity);	// PT: we allocated one more box on purpose
-		mABP->updateObject(index);
-	}
+	updateABPObjects(mABP, mUpdatedHandles, mNbUpdated);
 }
 
 void BroadPhaseABP::addObjects()
 {
 	PX_PROFILE_ZONE("BroadPhaseABP - addObjects", mContextID);
 
-	PxU32 nbAdded = mNbAdded;
-	const BpHandle* created = mCreatedHandles;
-
-	if(!nbAdded || !created)
+	if(!mNbAdded || !mCreatedHandles)
 		return;
 
-	const Bp::FilterGroup::Enum* PX_RESTRICT groups = mGroups;
-
-	struct Batch
-	{
-		PX_FORCE_INLINE	Batch() : mNb(0), mMaxIndex(0)	{}
-
-		PxU32		mNb;
-		PxU32		mMaxIndex;
-		BpHandle	mIndices[ABP_BATCHING];
-
-		PX_FORCE_INLINE void add(const BpHandle index, internalABP::ABP* PX_RESTRICT abp, FilterType::Enum type)
-		{
-			PxU32 nb = mNb;
-			mMaxIndex = PxMax(mMaxIndex, index);
-			mIndices[nb++] = index;
-			if(nb==ABP_BATCHING)
-			{
-				mNb = 0;
-				// PT: TODO: we could use a function ptr here
-				if(type==FilterType::STATIC)
-					abp->addStaticObjects(mIndices, ABP_BATCHING, mMaxIndex);
-				else if(type==FilterType::KINEMATIC)
-					abp->addKinematicObjects(mIndices, ABP_BATCHING, mMaxIndex);
-				else
-				{
-					PX_ASSERT(type==FilterType::DYNAMIC || type==FilterType::AGGREGATE);
-					abp->addDynamicObjects(mIndices, ABP_BATCHING, mMaxIndex);
-				}
-
-				mMaxIndex = 0;
-			}
-			else
-				mNb = nb;
-		}
-	};
-	Batch statics;
-	Batch dynamics;
-	Batch kinematics;
-
-	Batch* batches[FilterType::COUNT] = {NULL};
-	batches[FilterType::STATIC] = &statics;
-	batches[FilterType::DYNAMIC] = &dynamics;
-	batches[FilterType::AGGREGATE] = &dynamics;
-	batches[FilterType::KINEMATIC] = &kinematics;
-
-	while(nbAdded--)
-	{
-		const BpHandle index = *created++;
-		PX_ASSERT(index+1<mABP->mShared.mABP_Objects_Capacity);	// PT: we allocated one more box on purpose
-		FilterType::Enum type = FilterType::Enum(groups[index] & BP_FILTERING_TYPE_MASK);
-		if(!batches[type])
-			type = FilterType::DYNAMIC;
-		batches[type]->add(index, mABP, type);
-	}
-
-	if(statics.mNb)
-		mABP->addStaticObjects(statics.mIndices, statics.mNb, statics.mMaxIndex);
-	if(kinematics.mNb)
-		mABP->addKinematicObjects(kinematics.mIndices, kinematics.mNb, kinematics.mMaxIndex);
-	if(dynamics.mNb)
-		mABP->addDynamicObjects(dynamics.mIndices, dynamics.mNb, dynamics.mMaxIndex);
+	addABPObjects(mABP, mCreatedHandles, mNbAdded, mGroups);
 }
 
 const BroadPhasePair* BroadPhaseABP::getCreatedPairs(PxU32& nbCreatedPairs) const
@@ -4289,6 +5030,9 @@ void BroadPhaseABP::freeBuffers()
 #if PX_CHECKED
 bool BroadPhaseABP::isValid(const BroadPhaseUpdateData& updateData) const
 {
+	if(mEnvShards)
+		return mEnvShards->isValid(updateData);
+
 	const PxU32 nbObjects = mABP->mShared.mABP_Objects_Capacity;
 	PX_UNUSED(nbObjects);
 	const ABP_Object* PX_RESTRICT objects = mABP->mShared.mABP_Objects;
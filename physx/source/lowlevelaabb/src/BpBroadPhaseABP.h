@@ -38,6 +38,7 @@
 
 namespace internalABP{
 	class ABP;
+	class ABP_EnvShards;
 }
 
 namespace physx
@@ -71,6 +72,7 @@ namespace Bp
 	//~BroadPhase
 
 		internalABP::ABP*					mABP;		// PT: TODO: aggregate
+		internalABP::ABP_EnvShards*			mEnvShards;	// Per-environment ABP instances, NULL until environment IDs are used
 				PxU32						mNbAdded;
 				PxU32						mNbUpdated;
 				PxU32						mNbRemoved;
@@ -0,0 +1,126 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef DY_ARTICULATION_TOPOLOGY_H
+#define DY_ARTICULATION_TOPOLOGY_H
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxHashMap.h"
+
+namespace physx
+{
+namespace Dy
+{
+	struct ArticulationLink;
+	struct ArticulationJointCoreData;
+	class ArticulationTopologyCache;
+
+	/**
+	\brief Immutable description of an articulation tree: parent of each link, type and dof count of each inbound joint,
+	and the path-to-root elements derived from them.
+
+	Articulations of a context that have the same hierarchy and joint layout reference the same ArticulationTopology,
+	which is what allows the forward dynamics to process several of them at once, one articulation per SIMD lane.
+	Topologies are ref-counted and owned by an ArticulationTopologyCache.
+	*/
+	class ArticulationTopology : public PxUserAllocated
+	{
+		PX_NOCOPY(ArticulationTopology)
+	public:
+		PX_FORCE_INLINE	PxU32			getLinkCount()				const	{ return mLinkCount;				}
+		PX_FORCE_INLINE	PxU32			getDofCount()				const	{ return mDofCount;					}
+		PX_FORCE_INLINE	const PxU32*	getParents()				const	{ return mParents;					}
+		PX_FORCE_INLINE	const PxU8*		getJointTypes()				const	{ return mJointTypes;				}
+		PX_FORCE_INLINE	const PxU8*		getNbDofs()					const	{ return mNbDofs;					}
+		PX_FORCE_INLINE	PxU32*			getPathToRootElements()		const	{ return mPathToRootElements;		}
+		PX_FORCE_INLINE	PxU32			getPathToRootElementCount()	const	{ return mPathToRootElementCount;	}
+
+		// True if every joint is one the batched forward dynamics code supports (see FeatherstoneArticulation::computeUnconstrainedVelocitiesBatch)
+		PX_FORCE_INLINE	bool			isBatchable()				const	{ return mBatchable;				}
+
+		// Releases one reference. The topology removes itself from its cache and is deleted with the last one.
+						void			release();
+
+	private:
+										ArticulationTopology(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount, PxU32 hash);
+										~ArticulationTopology();
+
+						bool			matches(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount)	const;
+
+		PxU32					mLinkCount;
+		PxU32					mDofCount;
+		PxU32					mPathToRootElementCount;
+		PxU32					mHash;
+		PxU32					mRefCount;
+		bool					mBatchable;
+		PxU32*					mParents;
+		PxU8*					mJointTypes;
+		PxU8*					mNbDofs;
+		PxU32*					mPathToRootElements;
+		ArticulationTopology*	mNext;	// Next topology with the same hash
+		ArticulationTopologyCache*	mCache;
+
+		friend class ArticulationTopologyCache;
+	};
+
+	/**
+	\brief Hash-consing table of the articulation topologies used by a context.
+	\note Not thread-safe. Topologies are acquired and released when articulations are added to or removed from a scene.
+	*/
+	class ArticulationTopologyCache
+	{
+		PX_NOCOPY(ArticulationTopologyCache)
+	public:
+										ArticulationTopologyCache() : mNbTopologies(0)	{}
+										~ArticulationTopologyCache();
+
+		/**
+		\brief Returns the topology of an articulation, creating it if no other articulation of the cache has the same one.
+		The returned topology has been addRef'd and must be released with ArticulationTopology::release().
+		\param[in] links is the array of articulation links, with valid parent indices and inbound joints.
+		\param[in] jointData is the array of joint data, with valid dof counts (i.e. jcalc has run).
+		\param[in] linkCount is the number of links.
+		*/
+						ArticulationTopology*	acquire(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount);
+
+		PX_FORCE_INLINE	PxU32					getNbTopologies()	const	{ return mNbTopologies;	}
+
+	private:
+						void					remove(ArticulationTopology* topology);
+
+		PxHashMap<PxU32, ArticulationTopology*>	mTopologies;	// Hash => first topology with that hash
+		PxU32									mNbTopologies;
+
+		friend class ArticulationTopology;
+	};
+
+}
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include "foundation/PxUserAllocated.h"
 #include "PxsRigidBody.h"
 #include "DyResidualAccumulator.h"
+#include "DyArticulationTopology.h"
 
 namespace physx
 {
@@ -135,6 +136,9 @@ public:
 
 
 	PX_FORCE_INLINE bool										isResidualReportingEnabled() const { return mIsResidualReportingEnabled; }
+
+	// Shared by all articulations of this context that have the same tree, see ArticulationTopology
+	PX_FORCE_INLINE ArticulationTopologyCache&					getArticulationTopologies()		{ return mArticulationTopologies;	}
 	
 	/**
 	\brief Destroys this dynamics context
@@ -345,6 +349,8 @@ protected:
 	bool mBodyStateDirty;
 
 	Dy::ErrorAccumulatorEx mTotalContactError; 
+
+	ArticulationTopologyCache mArticulationTopologies;
 };
 
 Context* createDynamicsContext(	PxcNpMemBlockPool* memBlockPool, PxcScratchAllocator& scratchAllocator, Cm::FlushPool& taskPool,
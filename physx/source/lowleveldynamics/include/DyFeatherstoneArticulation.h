@@ -78,6 +78,7 @@ namespace Dy
 	struct SolverConstraint1DStep;
 
 	class FeatherstoneArticulation;
+	class ArticulationTopology;
 	struct SpatialMatrix;
 	struct SpatialTransform;
 	struct Constraint;
@@ -198,7 +199,7 @@ namespace Dy
 	public:
 
 		ArticulationData() :  
-			mPathToRootElements(NULL), mNumPathToRootElements(0), mLinksData(NULL), mJointData(NULL),
+			mPathToRootElements(NULL), mNumPathToRootElements(0), mTopology(NULL), mLinksData(NULL), mJointData(NULL),
 			mSpatialTendons(NULL), mNumSpatialTendons(0), mNumTotalAttachments(0),
 			mFixedTendons(NULL), mNumFixedTendons(0), 
 			mMimicJoints(NULL), mNbMimicJoints(0), mDt(0.f),mDofs(0xffffffff),
@@ -374,6 +375,9 @@ namespace Dy
 		PX_FORCE_INLINE PxU32*	getPathToRootElements() const { return mPathToRootElements; }
 		PX_FORCE_INLINE PxU32	getPathToRootElementCount() const { return mNumPathToRootElements; }
 
+		// NULL for articulations created outside of a context (immediate mode)
+		PX_FORCE_INLINE const ArticulationTopology*	getTopology() const { return mTopology; }
+
 		PX_FORCE_INLINE void incrementSolverSpatialDeltaVel(const PxU32 linkID, const Cm::SpatialVectorF& deltaV) {mSolverLinkSpatialDeltaVels[linkID] += deltaV;}
 
 	private:
@@ -436,6 +440,7 @@ namespace Dy
 		PxU32									mLinkCount;
 		PxU32*									mPathToRootElements;
 		PxU32									mNumPathToRootElements;
+		ArticulationTopology*					mTopology;	// Owns mPathToRootElements when not NULL
 		ArticulationLinkData*					mLinksData;
 		ArticulationJointCoreData*				mJointData;
 		ArticulationSpatialTendon**				mSpatialTendons;
@@ -710,6 +715,26 @@ namespace Dy
 			PxReal dt, const PxVec3& gravity,
 			PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
 
+		/**
+		\brief Batched version of computeUnconstrainedVelocities().
+		Processes the first articulations of the array that share the same batchable topology (see ArticulationTopology), up to
+		one per SIMD lane. Returns the number of processed articulations, which is always at least 1. The number of internal
+		constraints of each processed articulation is written to its descriptor's numInternalConstraints.
+		*/
+		static PxU32 computeUnconstrainedVelocitiesBatch(
+			ArticulationSolverDesc* descs, PxU32 nbDescs,
+			PxReal dt, PxU32& acCount,
+			const PxVec3& gravity,
+			PxReal invLengthScale);
+
+		/**
+		\brief Batched version of computeUnconstrainedVelocitiesTGS(). Same contract as computeUnconstrainedVelocitiesBatch().
+		*/
+		static PxU32 computeUnconstrainedVelocitiesBatchTGS(
+			const ArticulationSolverDesc* descs, PxU32 nbDescs,
+			PxReal dt, const PxVec3& gravity,
+			PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+
 		static PxU32 setupSolverConstraintsTGS(const ArticulationSolverDesc& articDesc,
 			PxReal dt,
 			PxReal invDt, PxReal totalDt);
@@ -857,6 +882,15 @@ namespace Dy
 		void computeUnconstrainedVelocitiesInternal(
 			const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled = false);
 
+		// The stages of computeUnconstrainedVelocitiesInternal() / updateArticulation(), in that order. They are exposed
+		// separately so that the batched code (DyFeatherstoneBatchedForwardDynamic.cpp) can replace the articulated inertia
+		// and response passes with a SIMD version running on several articulations at the same time.
+		void prepareUnconstrainedVelocities();
+		void updateLinkStates(const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+		void updateArticulatedInertiasAndResponses(bool externalForcesEveryTgsIterationEnabled);
+		void updateLinkAccelerations();
+		void finalizeUnconstrainedVelocities();
+
 		//copy joint data from fromJointData to toJointData
 		void copyJointData(const ArticulationData& data, PxReal* toJointData, const PxReal* fromJointData);
 
@@ -1394,6 +1428,11 @@ namespace Dy
 			const Cm::SpatialVector& impulse1,
 			Cm::SpatialVector& deltaV1);
 
+		// Shared part of computeUnconstrainedVelocitiesBatch() and computeUnconstrainedVelocitiesBatchTGS()
+		static void computeUnconstrainedVelocitiesBatchInternal(
+			FeatherstoneArticulation* const* articulations, PxU32 nb,
+			PxReal dt, const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+
 		PxU32 setupSolverConstraints(
 			ArticulationLink* links,
 			const PxU32 linkCount,
@@ -50,6 +50,15 @@ public:
 		return FeatherstoneArticulation::computeUnconstrainedVelocities(desc, dt, acCount, gravity, invLengthScale);
 	}
 
+	static PxU32 computeUnconstrainedVelocitiesBatch(ArticulationSolverDesc* descs, PxU32 nbDescs,
+											PxReal dt,
+											PxU32& acCount,
+											const PxVec3& gravity, 
+											const PxReal invLengthScale)
+	{
+		return FeatherstoneArticulation::computeUnconstrainedVelocitiesBatch(descs, nbDescs, dt, acCount, gravity, invLengthScale);
+	}
+
 	static void	updateBodies(const ArticulationSolverDesc& desc, Cm::SpatialVectorF* tempDeltaV,
 						 PxReal dt)
 	{
@@ -81,6 +90,15 @@ public:
 		FeatherstoneArticulation::computeUnconstrainedVelocitiesTGS(desc, dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
 	}
 
+	static PxU32 computeUnconstrainedVelocitiesBatchTGS(const ArticulationSolverDesc* descs, PxU32 nbDescs,
+		PxReal dt,
+		const PxVec3& gravity,
+		PxReal invLengthScale,
+		bool externalForcesEveryTgsIterationEnabled)
+	{
+		return FeatherstoneArticulation::computeUnconstrainedVelocitiesBatchTGS(descs, nbDescs, dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+	}
+
 	static void	updateDeltaMotion(const ArticulationSolverDesc& desc, const PxReal dt, Cm::SpatialVectorF* DeltaV, const PxReal totalInvDt)
 	{
 		FeatherstoneArticulation::recordDeltaMotion(desc, dt, DeltaV, totalInvDt);
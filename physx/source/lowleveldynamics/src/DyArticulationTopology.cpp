@@ -0,0 +1,231 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "DyArticulationTopology.h"
+#include "DyVArticulation.h"
+#include "DyArticulationJointCore.h"
+#include "DyFeatherstoneArticulationJointData.h"
+#include "foundation/PxHash.h"
+
+using namespace physx;
+using namespace Dy;
+
+static PX_FORCE_INLINE PxU8 getJointType(const ArticulationLink* links, PxU32 linkID)
+{
+	// The root link has no inbound joint
+	return linkID ? links[linkID].inboundJoint->jointType : PxU8(PxArticulationJointType::eUNDEFINED);
+}
+
+static PxU32 computeTopologyHash(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount)
+{
+	PxU32 hash = PxComputeHash(linkCount);
+	for(PxU32 linkID=1; linkID<linkCount; linkID++)
+	{
+		const PxU32 key = (links[linkID].parent<<16) | (PxU32(getJointType(links, linkID))<<8) | jointData[linkID].nbDof;
+		hash = PxComputeHash(hash ^ key);
+	}
+	return hash;
+}
+
+// The batched code handles 1-dof joints, spherical joints and joints without dofs (i.e. the switch cases of
+// computePropagateSpatialInertia_ZA_ZIc). Anything else, e.g. a revolute joint whose only axis is locked, goes
+// through the regular per-articulation path.
+static bool isBatchableJoint(PxU8 jointType, PxU8 nbDofs)
+{
+	switch(jointType)
+	{
+		case PxArticulationJointType::ePRISMATIC:
+		case PxArticulationJointType::eREVOLUTE:
+		case PxArticulationJointType::eREVOLUTE_UNWRAPPED:
+			return nbDofs == 1;
+		case PxArticulationJointType::eSPHERICAL:
+			return nbDofs <= 3;
+		default:
+			return nbDofs == 0;
+	}
+}
+
+ArticulationTopology::ArticulationTopology(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount, PxU32 hash) :
+	mLinkCount	(linkCount),
+	mDofCount	(0),
+	mHash		(hash),
+	mRefCount	(1),
+	mBatchable	(true),
+	mNext		(NULL),
+	mCache		(NULL)
+{
+	mParents = PX_ALLOCATE(PxU32, linkCount, "ArticulationTopology");
+	mJointTypes = PX_ALLOCATE(PxU8, linkCount, "ArticulationTopology");
+	mNbDofs = PX_ALLOCATE(PxU8, linkCount, "ArticulationTopology");
+
+	mParents[0] = 0;
+	mJointTypes[0] = PxU8(PxArticulationJointType::eUNDEFINED);
+	mNbDofs[0] = 0;
+
+	// Same layout as FeatherstoneArticulation::initPathToRoot(), so that the per-link start indices match
+	PxU32 totalPathToRootCount = 1;	// root
+	for(PxU32 linkID=1; linkID<linkCount; linkID++)
+	{
+		const PxU8 jointType = getJointType(links, linkID);
+		const PxU8 nbDofs = jointData[linkID].nbDof;
+		mParents[linkID] = links[linkID].parent;
+		mJointTypes[linkID] = jointType;
+		mNbDofs[linkID] = nbDofs;
+		mDofCount += nbDofs;
+
+		if(!isBatchableJoint(jointType, nbDofs))
+			mBatchable = false;
+
+		PxU32 parent = links[linkID].parent;
+		while(parent != 0)
+		{
+			parent = links[parent].parent;
+			totalPathToRootCount++;
+		}
+		totalPathToRootCount++;
+	}
+
+	mPathToRootElementCount = totalPathToRootCount;
+	mPathToRootElements = PX_ALLOCATE(PxU32, totalPathToRootCount, "ArticulationTopology");
+	mPathToRootElements[0] = 0;
+
+	PxU32 offset = 1;
+	for(PxU32 linkID=1; linkID<linkCount; linkID++)
+	{
+		PxU32 pathToRootCount = 1;
+		PxU32 parent = links[linkID].parent;
+		while(parent != 0)
+		{
+			parent = links[parent].parent;
+			pathToRootCount++;
+		}
+
+		PxU32* pathToRoot = mPathToRootElements + offset;
+		PxU32 numElements = pathToRootCount;
+		pathToRoot[--numElements] = linkID;
+		parent = links[linkID].parent;
+		while(parent != 0)
+		{
+			pathToRoot[--numElements] = parent;
+			parent = links[parent].parent;
+		}
+		offset += pathToRootCount;
+	}
+}
+
+ArticulationTopology::~ArticulationTopology()
+{
+	PX_FREE(mPathToRootElements);
+	PX_FREE(mNbDofs);
+	PX_FREE(mJointTypes);
+	PX_FREE(mParents);
+}
+
+bool ArticulationTopology::matches(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount) const
+{
+	if(linkCount != mLinkCount)
+		return false;
+
+	for(PxU32 linkID=1; linkID<linkCount; linkID++)
+	{
+		if(mParents[linkID] != links[linkID].parent || mJointTypes[linkID] != getJointType(links, linkID) || mNbDofs[linkID] != jointData[linkID].nbDof)
+			return false;
+	}
+	return true;
+}
+
+void ArticulationTopology::release()
+{
+	PX_ASSERT(mRefCount);
+	if(--mRefCount)
+		return;
+
+	if(mCache)
+		mCache->remove(this);
+	PX_DELETE_THIS;
+}
+
+ArticulationTopologyCache::~ArticulationTopologyCache()
+{
+	// Articulations can outlive the context during scene release. Their topologies are detached here
+	// and deleted with their last reference.
+	for(PxHashMap<PxU32, ArticulationTopology*>::Iterator iter = mTopologies.getIterator(); !iter.done(); ++iter)
+	{
+		ArticulationTopology* topology = iter->second;
+		while(topology)
+		{
+			topology->mCache = NULL;
+			topology = topology->mNext;
+		}
+	}
+}
+
+ArticulationTopology* ArticulationTopologyCache::acquire(const ArticulationLink* links, const ArticulationJointCoreData* jointData, PxU32 linkCount)
+{
+	const PxU32 hash = computeTopologyHash(links, jointData, linkCount);
+
+	ArticulationTopology*& head = mTopologies[hash];	// Inserts a NULL head for new hash values
+	for(ArticulationTopology* topology = head; topology; topology = topology->mNext)
+	{
+		if(topology->matches(links, jointData, linkCount))
+		{
+			topology->mRefCount++;
+			return topology;
+		}
+	}
+
+	ArticulationTopology* topology = PX_NEW(ArticulationTopology)(links, jointData, linkCount, hash);
+	topology->mCache = this;
+	topology->mNext = head;
+	head = topology;
+	mNbTopologies++;
+	return topology;
+}
+
+void ArticulationTopologyCache::remove(ArticulationTopology* topology)
+{
+	const PxHashMap<PxU32, ArticulationTopology*>::Entry* entry = mTopologies.find(topology->mHash);
+	PX_ASSERT(entry);
+
+	ArticulationTopology* head = entry->second;
+	if(head == topology)
+	{
+		if(topology->mNext)
+			mTopologies[topology->mHash] = topology->mNext;
+		else
+			mTopologies.erase(topology->mHash);
+	}
+	else
+	{
+		ArticulationTopology* prev = head;
+		while(prev->mNext != topology)
+			prev = prev->mNext;
+		prev->mNext = topology->mNext;
+	}
+	mNbTopologies--;
+}
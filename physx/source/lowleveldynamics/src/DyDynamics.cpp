@@ -680,20 +680,22 @@ public:
 
 		const PxReal invLengthScale = 1.f/mContext.getLengthScale();
 
-		for(PxU32 i=0;i<mNbToProcess; i++)
+		for(PxU32 i=0;i<mNbToProcess;)
 		{
-			FeatherstoneArticulation& a = *(mArticulations[i]);
+			PxU32 acCount;
 
-			PxU32 acCount, descCount;
-			
-			descCount = ArticulationPImpl::computeUnconstrainedVelocities(mArticulationDescArray[i], mContext.mDt,
+			// Consecutive articulations with the same topology are processed together. This also sets numInternalConstraints.
+			const PxU32 nb = ArticulationPImpl::computeUnconstrainedVelocitiesBatch(mArticulationDescArray + i, mNbToProcess - i, mContext.mDt,
 				acCount, mContext.getGravity(), invLengthScale);
 
-			mArticulationDescArray[i].numInternalConstraints = PxTo8(descCount);
+			for(PxU32 j=0;j<nb;j++, i++)
+			{
+				FeatherstoneArticulation& a = *(mArticulations[i]);
 
-			const PxU16 iterWord = a.getIterationCounts();
-			maxVelIters = PxMax<PxU32>(PxU32(iterWord >> 8),	maxVelIters);
-			maxPosIters = PxMax<PxU32>(PxU32(iterWord & 0xff),	maxPosIters);
+				const PxU16 iterWord = a.getIterationCounts();
+				maxVelIters = PxMax<PxU32>(PxU32(iterWord >> 8),	maxVelIters);
+				maxPosIters = PxMax<PxU32>(PxU32(iterWord & 0xff),	maxPosIters);
+			}
 		}
 
 		PxAtomicMax(reinterpret_cast<PxI32*>(&mIslandThreadContext.mMaxSolverPositionIterations), PxI32(maxPosIters));
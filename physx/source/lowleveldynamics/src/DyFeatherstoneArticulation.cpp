@@ -64,7 +64,10 @@ namespace Dy
 	{
 		PX_FREE(mLinksData);
 		PX_FREE(mJointData);
-		PX_FREE(mPathToRootElements);
+		if(mTopology)
+			mTopology->release();
+		else
+			PX_FREE(mPathToRootElements);
 	}
 
 	void ArticulationData::resizeLinkData(const PxU32 linkCount)
@@ -396,6 +399,29 @@ namespace Dy
 			totalPathToRootCount += pathToRootCount;
 		}
 
+		if(mArticulationData.mTopology)
+		{
+			mArticulationData.mTopology->release();
+			mArticulationData.mTopology = NULL;
+			mArticulationData.mPathToRootElements = NULL;
+			mArticulationData.mNumPathToRootElements = 0;
+		}
+
+		// Articulations simulated by a context share their tree data with all the identical ones. The
+		// path-to-root elements are part of it and only computed for the first articulation of each topology.
+		if(mContext)
+		{
+			ArticulationTopology* topology = mContext->getArticulationTopologies().acquire(links, mArticulationData.getJointData(), linkCount);
+			PX_ASSERT(topology->getPathToRootElementCount() == totalPathToRootCount);
+
+			// Replaces a private array allocated by a previous call, if any
+			PX_FREE(mArticulationData.mPathToRootElements);
+			mArticulationData.mTopology = topology;
+			mArticulationData.mPathToRootElements = topology->getPathToRootElements();
+			mArticulationData.mNumPathToRootElements = totalPathToRootCount;
+			return;
+		}
+
 		allocatePathToRootElements(totalPathToRootCount);
 
 		PxU32* pathToRootElements = mArticulationData.getPathToRootElements();
@@ -0,0 +1,907 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "foundation/PxVecMath.h"
+#include "foundation/PxAlloca.h"
+#include "DyFeatherstoneArticulation.h"
+#include "DyFeatherstoneArticulationJointData.h"
+#include "DyArticulationTopology.h"
+#include "DyArticulationJointCore.h"
+
+// Batched version of the articulated inertia and response passes of FeatherstoneArticulation::updateArticulation().
+//
+// Articulations sharing the same ArticulationTopology have the same links, joints and dofs, so these two passes run the
+// exact same sequence of operations for all of them. Here they are processed together, one articulation per SIMD lane,
+// with the per-articulation data transposed to SoA form before the passes and back afterwards. The rest of the pipeline
+// (link states, accelerations, internal constraints) stays per-articulation.
+//
+// Each SIMD operation below mirrors the scalar operation it replaces, in the same order, so that the results are
+// bit-identical to the per-articulation code.
+
+#define DY_ARTICULATION_BATCH_SIZE	4
+
+namespace physx
+{
+namespace Dy
+{
+namespace
+{
+	using namespace aos;
+
+	// One 3D vector per lane
+	struct Vec3V4
+	{
+		Vec4V	x, y, z;
+
+		PX_FORCE_INLINE	Vec4V&			operator[](PxU32 index)			{ return (&x)[index];	}
+		PX_FORCE_INLINE	const Vec4V&	operator[](PxU32 index)	const	{ return (&x)[index];	}
+	};
+
+	// One 3x3 matrix per lane, column-major like PxMat33
+	struct Mat33V4
+	{
+		Vec3V4	col0, col1, col2;
+
+		PX_FORCE_INLINE	Vec3V4&			operator[](PxU32 index)			{ return (&col0)[index];	}
+		PX_FORCE_INLINE	const Vec3V4&	operator[](PxU32 index)	const	{ return (&col0)[index];	}
+	};
+
+	// The following types have the same float layout as their AoS counterpart, so that N objects can be transposed
+	// to and from SoA form 4 floats at a time (see gatherV4 / scatterV4).
+
+	// One Cm::SpatialVectorF per lane
+	struct SpatialVectorV4
+	{
+		Vec3V4	top;
+		Vec4V	pad0;
+		Vec3V4	bottom;
+		Vec4V	pad1;
+	};
+
+	// One SpatialMatrix per lane
+	struct SpatialMatrixV4
+	{
+		Mat33V4	topLeft;
+		Mat33V4	topRight;
+		Mat33V4	bottomLeft;
+		Vec4V	padding;
+	};
+
+	// One TestImpulseResponse per lane
+	struct TestImpulseResponseV4
+	{
+		SpatialVectorV4	linkDeltaVTestImpulseResponses[6];
+	};
+
+	// One InvStIs per lane. Not transposed as a whole, since InvStIs is not a multiple of 4 floats.
+	struct InvStIsV4
+	{
+		Vec4V	invStIs[3][3];
+	};
+
+	PX_COMPILE_TIME_ASSERT(sizeof(SpatialVectorV4) == sizeof(Cm::SpatialVectorF) * DY_ARTICULATION_BATCH_SIZE);
+	PX_COMPILE_TIME_ASSERT(sizeof(SpatialMatrixV4) == sizeof(SpatialMatrix) * DY_ARTICULATION_BATCH_SIZE);
+	PX_COMPILE_TIME_ASSERT(sizeof(TestImpulseResponseV4) == sizeof(TestImpulseResponse) * DY_ARTICULATION_BATCH_SIZE);
+
+	///////////////////////////////////////////////////////////////////////////
+
+	// Transposes element 'index' of the 4 lane arrays to SoA form
+	template<class T, class SoA>
+	PX_FORCE_INLINE void gatherV4(SoA& dst, T* const* arrays, PxU32 index)
+	{
+		PX_COMPILE_TIME_ASSERT(sizeof(SoA) == sizeof(T) * DY_ARTICULATION_BATCH_SIZE);
+		const PxF32* src0 = reinterpret_cast<const PxF32*>(arrays[0] + index);
+		const PxF32* src1 = reinterpret_cast<const PxF32*>(arrays[1] + index);
+		const PxF32* src2 = reinterpret_cast<const PxF32*>(arrays[2] + index);
+		const PxF32* src3 = reinterpret_cast<const PxF32*>(arrays[3] + index);
+		Vec4V* PX_RESTRICT d = reinterpret_cast<Vec4V*>(&dst);
+
+		const PxU32 nbChunks = sizeof(T) / (sizeof(PxF32) * 4);
+		for(PxU32 i=0; i<nbChunks; i++)
+		{
+			Vec4V v0 = V4LoadU(src0 + i*4);
+			Vec4V v1 = V4LoadU(src1 + i*4);
+			Vec4V v2 = V4LoadU(src2 + i*4);
+			Vec4V v3 = V4LoadU(src3 + i*4);
+			V4Transpose(v0, v1, v2, v3);
+			d[i*4+0] = v0;
+			d[i*4+1] = v1;
+			d[i*4+2] = v2;
+			d[i*4+3] = v3;
+		}
+	}
+
+	// Transposes SoA data back to element 'index' of the first nbLanes lane arrays
+	template<class T, class SoA>
+	PX_FORCE_INLINE void scatterV4(T* const* arrays, PxU32 index, const SoA& src, PxU32 nbLanes)
+	{
+		PX_COMPILE_TIME_ASSERT(sizeof(SoA) == sizeof(T) * DY_ARTICULATION_BATCH_SIZE);
+		const Vec4V* s = reinterpret_cast<const Vec4V*>(&src);
+
+		const PxU32 nbChunks = sizeof(T) / (sizeof(PxF32) * 4);
+		for(PxU32 i=0; i<nbChunks; i++)
+		{
+			Vec4V v[4] = { s[i*4+0], s[i*4+1], s[i*4+2], s[i*4+3] };
+			V4Transpose(v[0], v[1], v[2], v[3]);
+			for(PxU32 lane=0; lane<nbLanes; lane++)
+				V4StoreU(v[lane], reinterpret_cast<PxF32*>(arrays[lane] + index) + i*4);
+		}
+	}
+
+	PX_FORCE_INLINE Vec3V4 gatherVec3(const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, const PxVec3& v3)
+	{
+		Vec3V4 r;
+		r.x = V4LoadXYZW(v0.x, v1.x, v2.x, v3.x);
+		r.y = V4LoadXYZW(v0.y, v1.y, v2.y, v3.y);
+		r.z = V4LoadXYZW(v0.z, v1.z, v2.z, v3.z);
+		return r;
+	}
+
+	PX_FORCE_INLINE void scatterReal(const Vec4V v, PxReal* const* dst, PxU32 nbLanes)
+	{
+		PX_ALIGN(16, PxReal tmp[4]);
+		V4StoreA(v, tmp);
+		for(PxU32 lane=0; lane<nbLanes; lane++)
+			*dst[lane] = tmp[lane];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	PX_FORCE_INLINE Vec3V4 zero3()
+	{
+		const Vec4V zero = V4Zero();
+		const Vec3V4 r = { zero, zero, zero };
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 add(const Vec3V4& a, const Vec3V4& b)
+	{
+		const Vec3V4 r = { V4Add(a.x, b.x), V4Add(a.y, b.y), V4Add(a.z, b.z) };
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 scale(const Vec3V4& a, const Vec4V s)
+	{
+		const Vec3V4 r = { V4Mul(a.x, s), V4Mul(a.y, s), V4Mul(a.z, s) };
+		return r;
+	}
+
+	// Same as PxVec3::dot()
+	PX_FORCE_INLINE Vec4V dot(const Vec3V4& a, const Vec3V4& b)
+	{
+		return V4Add(V4Add(V4Mul(a.x, b.x), V4Mul(a.y, b.y)), V4Mul(a.z, b.z));
+	}
+
+	// Same as PxVec3::cross()
+	PX_FORCE_INLINE Vec3V4 cross(const Vec3V4& a, const Vec3V4& b)
+	{
+		const Vec3V4 r =
+		{
+			V4Sub(V4Mul(a.y, b.z), V4Mul(a.z, b.y)),
+			V4Sub(V4Mul(a.z, b.x), V4Mul(a.x, b.z)),
+			V4Sub(V4Mul(a.x, b.y), V4Mul(a.y, b.x))
+		};
+		return r;
+	}
+
+	// Same as PxMat33::transform() and M33MulV3()
+	PX_FORCE_INLINE Vec3V4 transform(const Mat33V4& m, const Vec3V4& v)
+	{
+		return add(add(scale(m.col0, v.x), scale(m.col1, v.y)), scale(m.col2, v.z));
+	}
+
+	// Same as PxMat33::transformTranspose()
+	PX_FORCE_INLINE Vec3V4 transformTranspose(const Mat33V4& m, const Vec3V4& v)
+	{
+		const Vec3V4 r = { dot(m.col0, v), dot(m.col1, v), dot(m.col2, v) };
+		return r;
+	}
+
+	PX_FORCE_INLINE Mat33V4 add(const Mat33V4& a, const Mat33V4& b)
+	{
+		const Mat33V4 r = { add(a.col0, b.col0), add(a.col1, b.col1), add(a.col2, b.col2) };
+		return r;
+	}
+
+	PX_FORCE_INLINE Mat33V4 sub(const Mat33V4& a, const Mat33V4& b)
+	{
+		Mat33V4 r;
+		for(PxU32 i=0; i<3; i++)
+			for(PxU32 j=0; j<3; j++)
+				r[i][j] = V4Sub(a[i][j], b[i][j]);
+		return r;
+	}
+
+	// Same as M33MulM33()
+	PX_FORCE_INLINE Mat33V4 multiply(const Mat33V4& a, const Mat33V4& b)
+	{
+		const Mat33V4 r = { transform(a, b.col0), transform(a, b.col1), transform(a, b.col2) };
+		return r;
+	}
+
+	PX_FORCE_INLINE Mat33V4 transpose(const Mat33V4& m)
+	{
+		const Mat33V4 r =
+		{
+			{ m.col0.x, m.col1.x, m.col2.x },
+			{ m.col0.y, m.col1.y, m.col2.y },
+			{ m.col0.z, m.col1.z, m.col2.z }
+		};
+		return r;
+	}
+
+	// Same as FeatherstoneArticulation::constructSkewSymmetricMatrix()
+	PX_FORCE_INLINE Mat33V4 constructSkewSymmetricMatrix(const Vec3V4& r)
+	{
+		const Vec4V zero = V4Zero();
+		const Vec4V minusOne = V4Load(-1.0f);	// Multiplying by -1 is an exact negation, unlike V4Neg (0 - x) for zeros
+		const Mat33V4 m =
+		{
+			{ zero, r.z, V4Mul(r.y, minusOne) },
+			{ V4Mul(r.z, minusOne), zero, r.x },
+			{ r.y, V4Mul(r.x, minusOne), zero }
+		};
+		return m;
+	}
+
+	// Same as PxMat33::getInverse()
+	PX_FORCE_INLINE Mat33V4 getInverse(const Mat33V4& m)
+	{
+		const Vec4V zero = V4Zero();
+		const Vec4V one = V4One();
+		const Vec4V minusOne = V4Load(-1.0f);
+
+		const Vec4V det = dot(m.col0, cross(m.col1, m.col2));
+		const BoolV isSingular = V4IsEq(det, zero);
+		const Vec4V invDet = V4Div(one, V4Sel(isSingular, one, det));
+
+		Mat33V4 inv;
+		inv.col0.x = V4Mul(invDet, V4Sub(V4Mul(m.col1.y, m.col2.z), V4Mul(m.col2.y, m.col1.z)));
+		inv.col0.y = V4Mul(invDet, V4Mul(V4Sub(V4Mul(m.col0.y, m.col2.z), V4Mul(m.col2.y, m.col0.z)), minusOne));
+		inv.col0.z = V4Mul(invDet, V4Sub(V4Mul(m.col0.y, m.col1.z), V4Mul(m.col0.z, m.col1.y)));
+
+		inv.col1.x = V4Mul(invDet, V4Mul(V4Sub(V4Mul(m.col1.x, m.col2.z), V4Mul(m.col1.z, m.col2.x)), minusOne));
+		inv.col1.y = V4Mul(invDet, V4Sub(V4Mul(m.col0.x, m.col2.z), V4Mul(m.col0.z, m.col2.x)));
+		inv.col1.z = V4Mul(invDet, V4Mul(V4Sub(V4Mul(m.col0.x, m.col1.z), V4Mul(m.col0.z, m.col1.x)), minusOne));
+
+		inv.col2.x = V4Mul(invDet, V4Sub(V4Mul(m.col1.x, m.col2.y), V4Mul(m.col1.y, m.col2.x)));
+		inv.col2.y = V4Mul(invDet, V4Mul(V4Sub(V4Mul(m.col0.x, m.col2.y), V4Mul(m.col0.y, m.col2.x)), minusOne));
+		inv.col2.z = V4Mul(invDet, V4Sub(V4Mul(m.col0.x, m.col1.y), V4Mul(m.col1.x, m.col0.y)));
+
+		for(PxU32 i=0; i<3; i++)
+			for(PxU32 j=0; j<3; j++)
+				inv[i][j] = V4Sel(isSingular, i==j ? one : zero, inv[i][j]);
+		return inv;
+	}
+
+	PX_FORCE_INLINE SpatialVectorV4 spatialVector(const Vec3V4& top, const Vec3V4& bottom)
+	{
+		const Vec4V zero = V4Zero();
+		const SpatialVectorV4 r = { top, zero, bottom, zero };
+		return r;
+	}
+
+	PX_FORCE_INLINE SpatialVectorV4 add(const SpatialVectorV4& a, const SpatialVectorV4& b)
+	{
+		return spatialVector(add(a.top, b.top), add(a.bottom, b.bottom));
+	}
+
+	PX_FORCE_INLINE SpatialVectorV4 scale(const SpatialVectorV4& a, const Vec4V s)
+	{
+		return spatialVector(scale(a.top, s), scale(a.bottom, s));
+	}
+
+	// Same as Cm::SpatialVectorF::innerProduct() and Cm::UnAlignedSpatialVector::innerProduct()
+	PX_FORCE_INLINE Vec4V innerProduct(const SpatialVectorV4& a, const SpatialVectorV4& b)
+	{
+		return V4Add(dot(a.bottom, b.top), dot(a.top, b.bottom));
+	}
+
+	// Same as FeatherstoneArticulation::translateSpatialVector()
+	PX_FORCE_INLINE SpatialVectorV4 translateSpatialVector(const Vec3V4& offset, const SpatialVectorV4& v)
+	{
+		return spatialVector(v.top, add(v.bottom, cross(offset, v.top)));
+	}
+
+	// Same as SpatialMatrix::operator*(const Cm::SpatialVectorF&)
+	PX_FORCE_INLINE SpatialVectorV4 multiply(const SpatialMatrixV4& m, const SpatialVectorV4& s)
+	{
+		const Vec3V4 top = add(transform(m.topLeft, s.top), transform(m.topRight, s.bottom));
+		const Vec3V4 bottom = add(transform(m.bottomLeft, s.top), transformTranspose(m.topLeft, s.bottom));
+		return spatialVector(top, bottom);
+	}
+
+	PX_FORCE_INLINE void addTo(SpatialMatrixV4& dst, const SpatialMatrixV4& m)
+	{
+		dst.topLeft = add(dst.topLeft, m.topLeft);
+		dst.topRight = add(dst.topRight, m.topRight);
+		dst.bottomLeft = add(dst.bottomLeft, m.bottomLeft);
+	}
+
+	// Same as FeatherstoneArticulation::translateInertia()
+	PX_FORCE_INLINE void translateInertia(const Mat33V4& sTod, SpatialMatrixV4& inertia)
+	{
+		const Mat33V4 dTos = transpose(sTod);
+
+		const Mat33V4& tL = inertia.topLeft;
+		const Mat33V4& tR = inertia.topRight;
+		const Mat33V4& bL = inertia.bottomLeft;
+
+		const Mat33V4 bl = add(multiply(sTod, tL), bL);
+		const Mat33V4 br = add(multiply(sTod, tR), transpose(tL));
+		const Mat33V4 bottomLeft = add(bl, multiply(br, dTos));
+
+		inertia.topLeft = add(tL, multiply(tR, dTos));
+
+		const Mat33V4 sum = add(bottomLeft, transpose(bottomLeft));
+		const Vec4V half = V4Load(0.5f);
+		for(PxU32 i=0; i<3; i++)
+			inertia.bottomLeft[i] = scale(sum[i], half);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	// Per-lane pointers to the data of each articulation of a batch. Lanes beyond the batch size alias the first
+	// articulation, so that gathers always read valid data. Scatters only write the first nbLanes lanes.
+	struct BatchLanes
+	{
+		ArticulationData*				data[DY_ARTICULATION_BATCH_SIZE];
+		ArticulationLink*				links[DY_ARTICULATION_BATCH_SIZE];
+		const PxVec3*					linkRsW[DY_ARTICULATION_BATCH_SIZE];
+		Cm::UnAlignedSpatialVector*		jointDofMotionMatricesW[DY_ARTICULATION_BATCH_SIZE];
+		Cm::SpatialVectorF*				linkCoriolisVectorsW[DY_ARTICULATION_BATCH_SIZE];
+		PxReal*							jointDofForces[DY_ARTICULATION_BATCH_SIZE];
+		Cm::SpatialVectorF*				jointDofISW[DY_ARTICULATION_BATCH_SIZE];
+		InvStIs*						linkInvStISW[DY_ARTICULATION_BATCH_SIZE];
+		Cm::SpatialVectorF*				jointDofISInvStISW[DY_ARTICULATION_BATCH_SIZE];
+		PxReal*							jointDofMinusStZExtW[DY_ARTICULATION_BATCH_SIZE];
+		PxReal*							jointDofQStZIntIcW[DY_ARTICULATION_BATCH_SIZE];
+		Cm::SpatialVectorF*				linkZAForcesExtW[DY_ARTICULATION_BATCH_SIZE];
+		Cm::SpatialVectorF*				linkZAForcesIntW[DY_ARTICULATION_BATCH_SIZE];
+		SpatialMatrix*					linkSpatialInertiasW[DY_ARTICULATION_BATCH_SIZE];
+		TestImpulseResponse*			linkImpulseResponseMatricesW[DY_ARTICULATION_BATCH_SIZE];
+		PxU32							nbLanes;
+
+		void	init(FeatherstoneArticulation* const* articulations, PxU32 nb, bool externalForcesEveryTgsIterationEnabled)
+		{
+			nbLanes = nb;
+			for(PxU32 lane=0; lane<DY_ARTICULATION_BATCH_SIZE; lane++)
+			{
+				ArticulationData& d = articulations[lane < nb ? lane : 0]->getArticulationData();
+				data[lane] = &d;
+				links[lane] = d.getLinks();
+				linkRsW[lane] = d.getRw();
+				jointDofMotionMatricesW[lane] = d.getWorldMotionMatrix();
+				linkCoriolisVectorsW[lane] = d.getCorioliseVectors();
+				jointDofForces[lane] = externalForcesEveryTgsIterationEnabled ? NULL : d.getJointForces();
+				jointDofISW[lane] = d.getIsW();
+				linkInvStISW[lane] = d.getInvStIS();
+				jointDofISInvStISW[lane] = d.getISInvStIS();
+				jointDofMinusStZExtW[lane] = d.getMinusStZExt();
+				jointDofQStZIntIcW[lane] = d.getQStZIntIc();
+				linkZAForcesExtW[lane] = d.getSpatialZAVectors();
+				linkZAForcesIntW[lane] = d.getSpatialZAInternalVectors();
+				linkSpatialInertiasW[lane] = d.getWorldSpatialArticulatedInertia();
+				linkImpulseResponseMatricesW[lane] = d.getImpulseResponseMatrixWorld();
+			}
+		}
+
+		PX_FORCE_INLINE	Vec3V4	getRw(PxU32 linkID)	const
+		{
+			return gatherVec3(linkRsW[0][linkID], linkRsW[1][linkID], linkRsW[2][linkID], linkRsW[3][linkID]);
+		}
+
+		PX_FORCE_INLINE	SpatialVectorV4	getMotionMatrix(PxU32 dofId)	const
+		{
+			return spatialVector(
+				gatherVec3(jointDofMotionMatricesW[0][dofId].top, jointDofMotionMatricesW[1][dofId].top, jointDofMotionMatricesW[2][dofId].top, jointDofMotionMatricesW[3][dofId].top),
+				gatherVec3(jointDofMotionMatricesW[0][dofId].bottom, jointDofMotionMatricesW[1][dofId].bottom, jointDofMotionMatricesW[2][dofId].bottom, jointDofMotionMatricesW[3][dofId].bottom));
+		}
+
+		PX_FORCE_INLINE	Vec4V	getJointDofForce(PxU32 dofId)	const
+		{
+			return jointDofForces[0] ? V4LoadXYZW(jointDofForces[0][dofId], jointDofForces[1][dofId], jointDofForces[2][dofId], jointDofForces[3][dofId]) : V4Zero();
+		}
+
+		PX_FORCE_INLINE	Vec4V	getArmature(PxU32 linkID, PxU32 ind)	const
+		{
+			const ArticulationJointCore* j0 = links[0][linkID].inboundJoint;
+			const ArticulationJointCore* j1 = links[1][linkID].inboundJoint;
+			const ArticulationJointCore* j2 = links[2][linkID].inboundJoint;
+			const ArticulationJointCore* j3 = links[3][linkID].inboundJoint;
+			return V4LoadXYZW(j0->armature[j0->dofIds[ind]], j1->armature[j1->dofIds[ind]], j2->armature[j2->dofIds[ind]], j3->armature[j3->dofIds[ind]]);
+		}
+
+		PX_FORCE_INLINE	void	scatterDofReal(PxReal* const* arrays, PxU32 dofId, const Vec4V v)	const
+		{
+			PxReal* dst[DY_ARTICULATION_BATCH_SIZE];
+			for(PxU32 lane=0; lane<DY_ARTICULATION_BATCH_SIZE; lane++)
+				dst[lane] = arrays[lane] + dofId;
+			scatterReal(v, dst, nbLanes);
+		}
+
+		PX_FORCE_INLINE	void	scatterInvStIs(PxU32 linkID, PxU32 ind, PxU32 ind2, const Vec4V v)	const
+		{
+			PxReal* dst[DY_ARTICULATION_BATCH_SIZE];
+			for(PxU32 lane=0; lane<DY_ARTICULATION_BATCH_SIZE; lane++)
+				dst[lane] = &linkInvStISW[lane][linkID].invStIs[ind][ind2];
+			scatterReal(v, dst, nbLanes);
+		}
+	};
+
+	// SoA scratch buffers for a batch
+	struct BatchScratch
+	{
+		SpatialMatrixV4*		linkSpatialInertiasW;	// linkCount
+		SpatialVectorV4*		linkZAForcesExtW;		// linkCount
+		SpatialVectorV4*		linkZAForcesIntW;		// linkCount
+		InvStIsV4*				linkInvStISW;			// linkCount
+		TestImpulseResponseV4*	linkResponsesW;			// linkCount
+		SpatialVectorV4*		jointDofMotionMatricesW;// dofCount
+		SpatialVectorV4*		jointDofISW;			// dofCount
+		SpatialVectorV4*		jointDofISInvStISW;		// dofCount
+
+		static PxU32	getNbVec4V(PxU32 linkCount, PxU32 dofCount)
+		{
+			const PxU32 perLink = (sizeof(SpatialMatrixV4) + sizeof(SpatialVectorV4)*2 + sizeof(InvStIsV4) + sizeof(TestImpulseResponseV4)) / sizeof(Vec4V);
+			const PxU32 perDof = (sizeof(SpatialVectorV4)*3) / sizeof(Vec4V);
+			return linkCount * perLink + dofCount * perDof;
+		}
+
+		void	init(Vec4V* buffer, PxU32 linkCount, PxU32 dofCount)
+		{
+			linkSpatialInertiasW = reinterpret_cast<SpatialMatrixV4*>(buffer);
+			linkZAForcesExtW = reinterpret_cast<SpatialVectorV4*>(linkSpatialInertiasW + linkCount);
+			linkZAForcesIntW = linkZAForcesExtW + linkCount;
+			linkInvStISW = reinterpret_cast<InvStIsV4*>(linkZAForcesIntW + linkCount);
+			linkResponsesW = reinterpret_cast<TestImpulseResponseV4*>(linkInvStISW + linkCount);
+			jointDofMotionMatricesW = reinterpret_cast<SpatialVectorV4*>(linkResponsesW + linkCount);
+			jointDofISW = jointDofMotionMatricesW + dofCount;
+			jointDofISInvStISW = jointDofISW + dofCount;
+			PX_ASSERT(reinterpret_cast<Vec4V*>(jointDofISInvStISW + dofCount) == buffer + getNbVec4V(linkCount, dofCount));
+		}
+	};
+
+	// Batched version of FeatherstoneArticulation::computeArticulatedSpatialInertiaAndZ(), without the final inversion
+	// of the root inertia. See computePropagateSpatialInertia_ZA_ZIc() for the maths, which are mirrored here.
+	void computeArticulatedSpatialInertiaAndZBatch(const ArticulationTopology& topology, const BatchLanes& lanes, const BatchScratch& scratch)
+	{
+		const PxU32 linkCount = topology.getLinkCount();
+		const PxU32* parents = topology.getParents();
+		const PxU8* jointTypes = topology.getJointTypes();
+		const PxU8* nbDofs = topology.getNbDofs();
+		const ArticulationJointCoreData* jointData = lanes.data[0]->getJointData();	// Dof layout is part of the topology
+
+		const Vec4V zero = V4Zero();
+		const Vec4V one = V4One();
+		const Vec4V minusOne = V4Load(-1.0f);
+
+		for(PxU32 linkID=0; linkID<linkCount; linkID++)
+		{
+			gatherV4(scratch.linkSpatialInertiasW[linkID], lanes.linkSpatialInertiasW, linkID);
+			gatherV4(scratch.linkZAForcesExtW[linkID], lanes.linkZAForcesExtW, linkID);
+			gatherV4(scratch.linkZAForcesIntW[linkID], lanes.linkZAForcesIntW, linkID);
+		}
+
+		for(PxU32 linkID=linkCount-1; linkID>0; linkID--)
+		{
+			const PxU32 jointOffset = jointData[linkID].jointOffset;
+			const PxU32 nbJointDofs = nbDofs[linkID];
+			PX_ASSERT(nbJointDofs == jointData[linkID].nbDof);
+
+			const SpatialMatrixV4& linkArticulatedInertiaW = scratch.linkSpatialInertiasW[linkID];
+			const SpatialVectorV4* jointMotionMatricesW = scratch.jointDofMotionMatricesW + jointOffset;
+			SpatialVectorV4* jointISW = scratch.jointDofISW + jointOffset;
+			SpatialVectorV4* jointDofISInvStISW = scratch.jointDofISInvStISW + jointOffset;
+			InvStIsV4& linkInvStISW = scratch.linkInvStISW[linkID];
+
+			for(PxU32 ind=0; ind<nbJointDofs; ind++)
+			{
+				scratch.jointDofMotionMatricesW[jointOffset + ind] = lanes.getMotionMatrix(jointOffset + ind);
+				jointISW[ind] = multiply(linkArticulatedInertiaW, jointMotionMatricesW[ind]);
+			}
+
+			SpatialVectorV4 linkCoriolisW;
+			gatherV4(linkCoriolisW, lanes.linkCoriolisVectorsW, linkID);
+			const SpatialVectorV4 linkZExtW = scratch.linkZAForcesExtW[linkID];
+			const SpatialVectorV4 linkZIntIcW = add(scratch.linkZAForcesIntW[linkID], multiply(linkArticulatedInertiaW, linkCoriolisW));
+
+			SpatialVectorV4 deltaZAExtParent = linkZExtW;
+			SpatialVectorV4 deltaZAIntIcParent = linkZIntIcW;
+
+			SpatialMatrixV4 spatialInertiaW;
+			switch(jointTypes[linkID])
+			{
+			case PxArticulationJointType::ePRISMATIC:
+			case PxArticulationJointType::eREVOLUTE:
+			case PxArticulationJointType::eREVOLUTE_UNWRAPPED:
+			{
+				const SpatialVectorV4& sa = jointMotionMatricesW[0];
+				const SpatialVectorV4& Is = jointISW[0];
+
+				// stIs > 0 ? 1/stIs : 0
+				const Vec4V stIs = V4Add(innerProduct(sa, Is), lanes.getArmature(linkID, 0));
+				const BoolV isPositive = V4IsGrtr(stIs, zero);
+				const Vec4V invStIS = V4Sel(isPositive, V4Div(one, V4Sel(isPositive, stIs, one)), zero);
+				linkInvStISW.invStIs[0][0] = invStIS;
+
+				const SpatialVectorV4 isID = scale(Is, invStIS);
+				jointDofISInvStISW[0] = isID;
+
+				// SpatialMatrix::constructSpatialMatrix(isID, stI) with stI = (Is.bottom, Is.top)
+				for(PxU32 i=0; i<3; i++)
+				{
+					spatialInertiaW.topLeft[i] = scale(isID.top, Is.bottom[i]);
+					spatialInertiaW.topRight[i] = scale(isID.top, Is.top[i]);
+					spatialInertiaW.bottomLeft[i] = scale(isID.bottom, Is.bottom[i]);
+				}
+
+				const Vec4V diff = V4Mul(innerProduct(sa, linkZExtW), minusOne);
+				lanes.scatterDofReal(lanes.jointDofMinusStZExtW, jointOffset, diff);
+				deltaZAExtParent = add(deltaZAExtParent, scale(isID, diff));
+
+				const Vec4V diffInt = V4Sub(lanes.getJointDofForce(jointOffset), innerProduct(sa, linkZIntIcW));
+				lanes.scatterDofReal(lanes.jointDofQStZIntIcW, jointOffset, diffInt);
+				deltaZAIntIcParent = add(deltaZAIntIcParent, scale(isID, diffInt));
+
+				spatialInertiaW.topLeft = sub(linkArticulatedInertiaW.topLeft, spatialInertiaW.topLeft);
+				spatialInertiaW.topRight = sub(linkArticulatedInertiaW.topRight, spatialInertiaW.topRight);
+				spatialInertiaW.bottomLeft = sub(linkArticulatedInertiaW.bottomLeft, spatialInertiaW.bottomLeft);
+				break;
+			}
+			case PxArticulationJointType::eSPHERICAL:
+			{
+				Mat33V4 D;
+				for(PxU32 ind=0; ind<3; ind++)
+					for(PxU32 ind2=0; ind2<3; ind2++)
+						D[ind][ind2] = ind==ind2 ? one : zero;
+
+				for(PxU32 ind=0; ind<nbJointDofs; ind++)
+				{
+					for(PxU32 ind2=0; ind2<nbJointDofs; ind2++)
+						D[ind][ind2] = innerProduct(jointMotionMatricesW[ind2], jointISW[ind]);
+					D[ind][ind] = V4Add(D[ind][ind], lanes.getArmature(linkID, ind));
+				}
+
+				const Mat33V4 invD = getInverse(D);
+				for(PxU32 ind=0; ind<nbJointDofs; ind++)
+					for(PxU32 ind2=0; ind2<nbJointDofs; ind2++)
+						linkInvStISW.invStIs[ind][ind2] = invD[ind][ind2];
+
+				const SpatialVectorV4 zeroV = spatialVector(zero3(), zero3());
+				SpatialVectorV4 columns[6] = { zeroV, zeroV, zeroV, zeroV, zeroV, zeroV };
+				for(PxU32 ind=0; ind<nbJointDofs; ind++)
+				{
+					const SpatialVectorV4& sa = jointMotionMatricesW[ind];
+
+					const Vec4V localQstZ = V4Mul(innerProduct(sa, linkZExtW), minusOne);
+					const Vec4V localQstZInt = V4Sub(lanes.getJointDofForce(jointOffset + ind), innerProduct(sa, linkZIntIcW));
+					lanes.scatterDofReal(lanes.jointDofMinusStZExtW, jointOffset + ind, localQstZ);
+					lanes.scatterDofReal(lanes.jointDofQStZIntIcW, jointOffset + ind, localQstZInt);
+
+					SpatialVectorV4 isID = zeroV;
+					for(PxU32 ind2=0; ind2<nbJointDofs; ind2++)
+						isID = add(isID, scale(jointISW[ind2], invD[ind][ind2]));
+
+					columns[0] = add(columns[0], scale(isID, jointISW[ind].bottom.x));
+					columns[1] = add(columns[1], scale(isID, jointISW[ind].bottom.y));
+					columns[2] = add(columns[2], scale(isID, jointISW[ind].bottom.z));
+					columns[3] = add(columns[3], scale(isID, jointISW[ind].top.x));
+					columns[4] = add(columns[4], scale(isID, jointISW[ind].top.y));
+					columns[5] = add(columns[5], scale(isID, jointISW[ind].top.z));
+					jointDofISInvStISW[ind] = isID;
+
+					deltaZAExtParent = add(deltaZAExtParent, scale(isID, localQstZ));
+					deltaZAIntIcParent = add(deltaZAIntIcParent, scale(isID, localQstZInt));
+				}
+
+				// SpatialMatrix::constructSpatialMatrix(columns)
+				for(PxU32 i=0; i<3; i++)
+				{
+					spatialInertiaW.topLeft[i] = columns[i].top;
+					spatialInertiaW.bottomLeft[i] = columns[i].bottom;
+					spatialInertiaW.topRight[i] = columns[3+i].top;
+				}
+
+				spatialInertiaW.topLeft = sub(linkArticulatedInertiaW.topLeft, spatialInertiaW.topLeft);
+				spatialInertiaW.topRight = sub(linkArticulatedInertiaW.topRight, spatialInertiaW.topRight);
+				spatialInertiaW.bottomLeft = sub(linkArticulatedInertiaW.bottomLeft, spatialInertiaW.bottomLeft);
+				break;
+			}
+			default:
+				PX_ASSERT(!nbJointDofs);
+				spatialInertiaW = linkArticulatedInertiaW;
+				break;
+			}
+
+			const Vec3V4 linkRW = lanes.getRw(linkID);
+			const PxU32 parent = parents[linkID];
+
+			//Accumulate the spatial inertia on the parent link.
+			{
+				translateInertia(constructSkewSymmetricMatrix(linkRW), spatialInertiaW);
+
+				// Make sure we do not propagate up negative inertias around the principal inertial axes
+				// due to numerical rounding errors. V4Max(x, 0) returns 0 for NaNs and -0, like PxMax(0.0f, x).
+				spatialInertiaW.bottomLeft.col0.x = V4Max(spatialInertiaW.bottomLeft.col0.x, zero);
+				spatialInertiaW.bottomLeft.col1.y = V4Max(spatialInertiaW.bottomLeft.col1.y, zero);
+				spatialInertiaW.bottomLeft.col2.z = V4Max(spatialInertiaW.bottomLeft.col2.z, zero);
+
+				addTo(scratch.linkSpatialInertiasW[parent], spatialInertiaW);
+			}
+
+			//Accumulate the articulated z.a force on the parent link.
+			{
+				scratch.linkZAForcesExtW[parent] = add(scratch.linkZAForcesExtW[parent], translateSpatialVector(linkRW, deltaZAExtParent));
+				scratch.linkZAForcesIntW[parent] = add(scratch.linkZAForcesIntW[parent], translateSpatialVector(linkRW, deltaZAIntIcParent));
+			}
+
+			for(PxU32 ind=0; ind<nbJointDofs; ind++)
+			{
+				scatterV4(lanes.jointDofISW, jointOffset + ind, jointISW[ind], lanes.nbLanes);
+				scatterV4(lanes.jointDofISInvStISW, jointOffset + ind, jointDofISInvStISW[ind], lanes.nbLanes);
+			}
+
+			// Only the dofs x dofs part of InvStIs is written, as in the scalar code
+			for(PxU32 ind=0; ind<nbJointDofs; ind++)
+				for(PxU32 ind2=0; ind2<nbJointDofs; ind2++)
+					lanes.scatterInvStIs(linkID, ind, ind2, linkInvStISW.invStIs[ind][ind2]);
+		}
+
+		for(PxU32 linkID=0; linkID<linkCount; linkID++)
+		{
+			scatterV4(lanes.linkSpatialInertiasW, linkID, scratch.linkSpatialInertiasW[linkID], lanes.nbLanes);
+			scatterV4(lanes.linkZAForcesExtW, linkID, scratch.linkZAForcesExtW[linkID], lanes.nbLanes);
+			scatterV4(lanes.linkZAForcesIntW, linkID, scratch.linkZAForcesIntW[linkID], lanes.nbLanes);
+		}
+	}
+
+	// Batched version of the non-root part of FeatherstoneArticulation::computeArticulatedResponseMatrix(). The root
+	// responses must have been computed per articulation beforehand. The cfm scaling is left to the caller.
+	void computeArticulatedResponseMatrixBatch(const ArticulationTopology& topology, const BatchLanes& lanes, const BatchScratch& scratch)
+	{
+		const PxU32 linkCount = topology.getLinkCount();
+		const PxU32* parents = topology.getParents();
+		const PxU8* nbDofs = topology.getNbDofs();
+		const ArticulationJointCoreData* jointData = lanes.data[0]->getJointData();
+
+		const Vec4V zero = V4Zero();
+		const Vec4V minusOne = V4Load(-1.0f);
+
+		gatherV4(scratch.linkResponsesW[0], lanes.linkImpulseResponseMatricesW, 0);
+
+		for(PxU32 linkID=1; linkID<linkCount; linkID++)
+		{
+			const Vec3V4 parentLinkToChildLink = lanes.getRw(linkID);
+			const Vec3V4 childLinkToParentLink = scale(parentLinkToChildLink, minusOne);
+			const PxU32 jointOffset = jointData[linkID].jointOffset;
+			const PxU32 dofCount = nbDofs[linkID];
+			const TestImpulseResponseV4& parentResponse = scratch.linkResponsesW[parents[linkID]];
+			const SpatialVectorV4* jointDofMotionMatricesW = scratch.jointDofMotionMatricesW + jointOffset;
+			const SpatialVectorV4* jointDofISW = scratch.jointDofISW + jointOffset;
+			const SpatialVectorV4* jointDofIsInvDW = scratch.jointDofISInvStISW + jointOffset;
+			const InvStIsV4& linkInvStISW = scratch.linkInvStISW[linkID];
+			TestImpulseResponseV4& response = scratch.linkResponsesW[linkID];
+
+			for(PxU32 i=0; i<6; i++)
+			{
+				// The test impulse, already negated
+				SpatialVectorV4 testLinkImpulse = spatialVector(zero3(), zero3());
+				if(i<3)
+					testLinkImpulse.top[i] = minusOne;
+				else
+					testLinkImpulse.bottom[i-3] = minusOne;
+
+				//(1) Propagate child link impulse (and zero joint impulse) to parent, as in propagateImpulseW()
+				Vec4V QMinusStZ[3];
+				SpatialVectorV4 YParentW = spatialVector(zero3(), zero3());
+				for(PxU32 ind=0; ind<dofCount; ind++)
+				{
+					const Vec4V QMinusStY = V4Sub(zero, innerProduct(jointDofMotionMatricesW[ind], testLinkImpulse));
+					YParentW = add(YParentW, scale(jointDofIsInvDW[ind], QMinusStY));
+					QMinusStZ[ind] = V4Add(zero, QMinusStY);
+				}
+				YParentW = add(YParentW, testLinkImpulse);
+				const SpatialVectorV4 Zp = translateSpatialVector(parentLinkToChildLink, YParentW);
+
+				//(2) Get deltaV response for parent, as in TestImpulseResponse::getLinkDeltaVImpulseResponse()
+				const SpatialVectorV4* rows = parentResponse.linkDeltaVTestImpulseResponses;
+				SpatialVectorV4 deltaVParent = scale(rows[0], Zp.top.x);
+				deltaVParent = add(deltaVParent, scale(rows[1], Zp.top.y));
+				deltaVParent = add(deltaVParent, scale(rows[2], Zp.top.z));
+				deltaVParent = add(deltaVParent, scale(rows[3], Zp.bottom.x));
+				deltaVParent = add(deltaVParent, scale(rows[4], Zp.bottom.y));
+				deltaVParent = add(deltaVParent, scale(rows[5], Zp.bottom.z));
+				deltaVParent = scale(deltaVParent, minusOne);
+
+				//(3) Propagate deltaV to child and apply test impulse (encoded in QMinusStZ), as in propagateAccelerationW()
+				SpatialVectorV4 motionAccelerationW = translateSpatialVector(childLinkToParentLink, deltaVParent);
+
+				Vec4V tJAccel[3];
+				for(PxU32 ind=0; ind<dofCount; ind++)
+					tJAccel[ind] = V4Sub(QMinusStZ[ind], innerProduct(jointDofISW[ind], motionAccelerationW));
+
+				for(PxU32 ind=0; ind<dofCount; ind++)
+				{
+					Vec4V jVel = zero;
+					for(PxU32 ind2=0; ind2<dofCount; ind2++)
+						jVel = V4Add(jVel, V4Mul(linkInvStISW.invStIs[ind2][ind], tJAccel[ind2]));
+
+					motionAccelerationW.top = add(motionAccelerationW.top, scale(jointDofMotionMatricesW[ind].top, jVel));
+					motionAccelerationW.bottom = add(motionAccelerationW.bottom, scale(jointDofMotionMatricesW[ind].bottom, jVel));
+				}
+
+				response.linkDeltaVTestImpulseResponses[i] = motionAccelerationW;
+			}
+
+			scatterV4(lanes.linkImpulseResponseMatricesW, linkID, response, lanes.nbLanes);
+		}
+	}
+
+	// Returns the number of articulations at the start of the array that can be processed as a batch
+	PxU32 getBatchSize(const ArticulationSolverDesc* descs, PxU32 nbDescs)
+	{
+		const ArticulationTopology* topology = descs[0].articulation->getArticulationData().getTopology();
+		if(!topology || !topology->isBatchable() || topology->getLinkCount() < 2)
+			return 1;
+
+		const PxU32 maxNb = PxMin(nbDescs, PxU32(DY_ARTICULATION_BATCH_SIZE));
+		PxU32 nb = 1;
+		while(nb<maxNb && descs[nb].articulation->getArticulationData().getTopology() == topology)
+			nb++;
+		return nb;
+	}
+}
+
+	void FeatherstoneArticulation::computeUnconstrainedVelocitiesBatchInternal(
+		FeatherstoneArticulation* const* articulations, PxU32 nb,
+		PxReal dt, const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled)
+	{
+		PX_ASSERT(nb && nb <= DY_ARTICULATION_BATCH_SIZE);
+
+		for(PxU32 i=0; i<nb; i++)
+		{
+			FeatherstoneArticulation* articulation = articulations[i];
+			ArticulationData& data = articulation->mArticulationData;
+			data.setDt(dt);
+
+			if (articulation->mJcalcDirty)
+			{
+				articulation->mJcalcDirty = false;
+				articulation->jcalc(data);
+			}
+
+			articulation->prepareUnconstrainedVelocities();
+			articulation->updateLinkStates(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+		}
+
+		const ArticulationTopology& topology = *articulations[0]->mArticulationData.getTopology();
+		const PxU32 linkCount = topology.getLinkCount();
+		const PxU32 dofCount = topology.getDofCount();
+
+		BatchLanes lanes;
+		lanes.init(articulations, nb, externalForcesEveryTgsIterationEnabled);
+
+		// PxTempAllocator and x64 stack allocations are 16-byte aligned
+		PX_ALLOCA(buffer, PxF32, BatchScratch::getNbVec4V(linkCount, dofCount) * 4);
+		PX_ASSERT(!(size_t(buffer.mPointer) & 15));
+		BatchScratch scratch;
+		scratch.init(reinterpret_cast<Vec4V*>(buffer.mPointer), linkCount, dofCount);
+
+		computeArticulatedSpatialInertiaAndZBatch(topology, lanes, scratch);
+
+		// The root inertia inversion and root responses are not worth batching
+		for(PxU32 i=0; i<nb; i++)
+		{
+			ArticulationData& data = articulations[i]->mArticulationData;
+			SpatialMatrix& baseInvSpatialArticulatedInertiaW = data.getBaseInvSpatialArticulatedInertiaW();
+			data.getWorldSpatialArticulatedInertia()[0].invertInertiaV(baseInvSpatialArticulatedInertiaW);
+
+			computeArticulatedResponseMatrix(
+				data.getArticulationFlags(), 1,
+				data.getJointData(), baseInvSpatialArticulatedInertiaW,
+				data.getRw(), data.getWorldMotionMatrix(),
+				data.getIsW(), data.getInvStIS(), data.getISInvStIS(),
+				data.getLinks(), data.getImpulseResponseMatrixWorld());
+		}
+
+		computeArticulatedResponseMatrixBatch(topology, lanes, scratch);
+
+		for(PxU32 i=0; i<nb; i++)
+		{
+			FeatherstoneArticulation* articulation = articulations[i];
+			ArticulationData& data = articulation->mArticulationData;
+
+			ArticulationLink* links = data.getLinks();
+			const TestImpulseResponse* responses = data.getImpulseResponseMatrixWorld();
+			for(PxU32 linkID=1; linkID<linkCount; linkID++)
+			{
+				const Cm::SpatialVectorF* r = responses[linkID].linkDeltaVTestImpulseResponses;
+				links[linkID].cfm *= PxMax(r[0].bottom.x, PxMax(r[1].bottom.y, r[2].bottom.z));
+			}
+
+			articulation->updateLinkAccelerations();
+			articulation->finalizeUnconstrainedVelocities();
+		}
+	}
+
+	PxU32 FeatherstoneArticulation::computeUnconstrainedVelocitiesBatch(
+		ArticulationSolverDesc* descs, PxU32 nbDescs,
+		PxReal dt,
+		PxU32& acCount,
+		const PxVec3& gravity,
+		PxReal invLengthScale)
+	{
+		PX_ASSERT(nbDescs);
+
+		const PxU32 nb = getBatchSize(descs, nbDescs);
+		if(nb == 1)
+		{
+			descs[0].numInternalConstraints = PxTo8(computeUnconstrainedVelocities(descs[0], dt, acCount, gravity, invLengthScale));
+			return 1;
+		}
+
+		FeatherstoneArticulation* articulations[DY_ARTICULATION_BATCH_SIZE];
+		for(PxU32 i=0; i<nb; i++)
+			articulations[i] = descs[i].articulation;
+
+		computeUnconstrainedVelocitiesBatchInternal(articulations, nb, dt, gravity, invLengthScale, false);
+
+		for(PxU32 i=0; i<nb; i++)
+		{
+			FeatherstoneArticulation* articulation = articulations[i];
+			ArticulationData& data = articulation->mArticulationData;
+			const bool fixBase = data.getArticulationFlags() & PxArticulationFlag::eFIX_BASE;
+			descs[i].numInternalConstraints = PxTo8(articulation->setupSolverConstraints(data.getLinks(), data.getLinkCount(), fixBase, data, acCount));
+		}
+		return nb;
+	}
+
+	PxU32 FeatherstoneArticulation::computeUnconstrainedVelocitiesBatchTGS(
+		const ArticulationSolverDesc* descs, PxU32 nbDescs,
+		PxReal dt, const PxVec3& gravity,
+		PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled)
+	{
+		PX_ASSERT(nbDescs);
+
+		const PxU32 nb = getBatchSize(descs, nbDescs);
+		if(nb == 1)
+		{
+			computeUnconstrainedVelocitiesTGS(descs[0], dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+			return 1;
+		}
+
+		FeatherstoneArticulation* articulations[DY_ARTICULATION_BATCH_SIZE];
+		for(PxU32 i=0; i<nb; i++)
+			articulations[i] = descs[i].articulation;
+
+		computeUnconstrainedVelocitiesBatchInternal(articulations, nb, dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+		return nb;
+	}
+}
+}
@@ -1580,6 +1580,13 @@ namespace Dy
 	//}
 
 	void FeatherstoneArticulation::updateArticulation(const PxVec3& gravity, const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
+	{
+		updateLinkStates(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+		updateArticulatedInertiasAndResponses(externalForcesEveryTgsIterationEnabled);
+		updateLinkAccelerations();
+	}
+
+	void FeatherstoneArticulation::updateLinkStates(const PxVec3& gravity, const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
 	{
 		//Copy the link poses into a handy array.
 		//Update the link separation vectors with the latest link poses.
@@ -1654,7 +1661,10 @@ namespace Dy
 				}
 			}
 		}
-		
+	}
+
+	void FeatherstoneArticulation::updateArticulatedInertiasAndResponses(const bool externalForcesEveryTgsIterationEnabled)
+	{
 		{	
 			//Constant inputs.
 			const ArticulationLink* links = mArticulationData.getLinks();
@@ -1711,7 +1721,10 @@ namespace Dy
 				jointDofISW, linkInvStIsW, jointDofISInvDW, 		//constants
 				links, linkImpulseResponseMatricesW);				//outputs
 		}
+	}
 
+	void FeatherstoneArticulation::updateLinkAccelerations()
+	{
 		{
 			//Constant terms.
 			const bool doIC = false;
@@ -1807,6 +1820,15 @@ namespace Dy
 	{
 		//PX_PROFILE_ZONE("Articulations:computeUnconstrainedVelocities", 0);
 
+		prepareUnconstrainedVelocities();
+
+		updateArticulation(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+
+		finalizeUnconstrainedVelocities();
+	}
+
+	void FeatherstoneArticulation::prepareUnconstrainedVelocities()
+	{
 		//mStaticConstraints.forceSize_Unsafe(0);
 		mStatic1DConstraints.forceSize_Unsafe(0);
 		mStaticContactConstraints.forceSize_Unsafe(0);
@@ -1816,9 +1838,10 @@ namespace Dy
 		//const PxU32 linkCount = mArticulationData.getLinkCount();
 
 		mArticulationData.init();
+	}
 
-		updateArticulation(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
-
+	void FeatherstoneArticulation::finalizeUnconstrainedVelocities()
+	{
 		ScratchData scratchData;
 		scratchData.motionVelocities = mArticulationData.getMotionVelocities();
 		scratchData.motionAccelerations = mArticulationData.getMotionAccelerations();
@@ -56,7 +56,7 @@ namespace physx
 class FrictionPatchStreamPair
 {
 public:
-	FrictionPatchStreamPair(PxcNpMemBlockPool& blockPool);
+	FrictionPatchStreamPair(PxcNpMemBlockPool& blockPool, PxcNpMemBlockReservoir* reservoir = NULL);
 
 	// reserve can fail and return null. Read should never fail
 	template<class FrictionPatch>
@@ -69,14 +69,15 @@ public:
 	PxcNpMemBlockPool& getBlockPool() { return mBlockPool;}
 private:
 	PxcNpMemBlockPool&	mBlockPool;
+	PxcNpMemBlockReservoir*	mReservoir;	// optional per-thread block cache
 	PxcNpMemBlock*		mBlock;
 	PxU32				mUsed;
 
 	FrictionPatchStreamPair& operator=(const FrictionPatchStreamPair&);
 };
 
-PX_FORCE_INLINE FrictionPatchStreamPair::FrictionPatchStreamPair(PxcNpMemBlockPool& blockPool):
-  mBlockPool(blockPool), mBlock(NULL), mUsed(0)
+PX_FORCE_INLINE FrictionPatchStreamPair::FrictionPatchStreamPair(PxcNpMemBlockPool& blockPool, PxcNpMemBlockReservoir* reservoir):
+  mBlockPool(blockPool), mReservoir(reservoir), mBlock(NULL), mUsed(0)
 {
 }
 
@@ -101,7 +102,7 @@ FrictionPatch* FrictionPatchStreamPair::reserve(const PxU32 size)
 
 	if(mBlock == NULL || mUsed + size > PxcNpMemBlock::SIZE)
 	{
-		mBlock = mBlockPool.acquireFrictionBlock();
+		mBlock = mBlockPool.acquireFrictionBlock(mReservoir);
 		mUsed = 0;
 	}
 
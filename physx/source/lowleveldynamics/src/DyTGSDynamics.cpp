@@ -1657,9 +1657,10 @@ public:
 
 		const PxReal invLengthScale = 1.f / mContext.getLengthScale();
 
-		for (PxU32 a = 0; a < mNbDescs; ++a)
+		// Consecutive articulations with the same topology are processed together
+		for (PxU32 a = 0; a < mNbDescs;)
 		{			
-			ArticulationPImpl::computeUnconstrainedVelocitiesTGS(mDescs[a], mDt, 
+			a += ArticulationPImpl::computeUnconstrainedVelocitiesBatchTGS(mDescs + a, mNbDescs - a, mDt, 
 				mGravity, invLengthScale, mExternalForcesEveryTgsIterationEnabled);
 		}
 
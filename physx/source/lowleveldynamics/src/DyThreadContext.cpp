@@ -35,9 +35,10 @@ namespace Dy
 {
 
 ThreadContext::ThreadContext(PxcNpMemBlockPool* memBlockPool) :
-	mFrictionPatchStreamPair				(*memBlockPool),
+	mBlockReservoir							(*memBlockPool),
+	mFrictionPatchStreamPair				(*memBlockPool, &mBlockReservoir),
 	mConstraintBlockManager					(*memBlockPool),
-	mConstraintBlockStream					(*memBlockPool),
+	mConstraintBlockStream					(*memBlockPool, &mBlockReservoir),
 	mNumDifferentBodyConstraints			(0),
 	mNumStaticConstraints					(0),
 	mHasOverflowPartitions					(false),
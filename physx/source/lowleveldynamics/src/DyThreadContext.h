@@ -110,6 +110,7 @@ public:
 		// temporary buffer for correlation
 	PX_ALIGN(16, CorrelationBuffer				mCorrelationBuffer); 
 
+	PxcNpMemBlockReservoir						mBlockReservoir;			// per-thread 16K blocks, avoids the pool's lock
 	FrictionPatchStreamPair						mFrictionPatchStreamPair;	// patch streams
 
 	PxsConstraintBlockManager					mConstraintBlockManager;	// for when this thread context is "lead" on an island
@@ -3325,6 +3325,22 @@ PxU32 NpScene::getContactReportStreamBufferSize() const
 	return mScene.getDefaultContactReportStreamBufferSize();
 }
 
+void NpScene::setContactPairAggregateBuffers(const PxContactPairAggregateBuffers* buffers)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(this, "PxScene::setContactPairAggregateBuffers() not allowed while simulation is running. Call will be ignored.")
+
+	mScene.setContactPairAggregateBuffers(buffers);
+}
+
+PxU32 NpScene::getNbContactPairAggregates() const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::getNbContactPairAggregates() not allowed while simulation is running.", 0);
+
+	return mScene.getNbContactPairAggregates();
+}
+
 #if PX_CHECKED
 void NpScene::checkPositionSanity(const PxRigidActor& a, const PxTransform& pose, const char* fnName) const
 {
@@ -280,6 +280,8 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual         PxU32							getMaxNbContactDataBlocksUsed() const	PX_OVERRIDE PX_FINAL;
 
 	virtual			PxU32							getContactReportStreamBufferSize() const	PX_OVERRIDE PX_FINAL;
+	virtual			void							setContactPairAggregateBuffers(const PxContactPairAggregateBuffers* buffers)	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getNbContactPairAggregates() const	PX_OVERRIDE PX_FINAL;
 
 	virtual			PxU32							getTimestamp()	const	PX_OVERRIDE PX_FINAL;
 
@@ -307,6 +309,10 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 
 	virtual			void							shiftOrigin(const PxVec3& shift)	PX_OVERRIDE PX_FINAL;
 
+	virtual			PxU32							getSnapshotSize(PxSceneSnapshotFlags flags) const	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							saveSnapshot(void* buffer, PxU32 bufferSize, PxSceneSnapshotFlags flags) const	PX_OVERRIDE PX_FINAL;
+	virtual			bool							restoreSnapshot(const void* buffer, PxU32 bufferSize)	PX_OVERRIDE PX_FINAL;
+
 	virtual         PxPvdSceneClient*				getScenePvdClient()	PX_OVERRIDE PX_FINAL;
 	
 	PX_DEPRECATED	virtual	void					copySoftBodyData(void** data, void* dataSizes, void* softBodyIndices, PxSoftBodyGpuDataFlag::Enum flag, const PxU32 nbCopySoftBodies, const PxU32 maxSize, CUevent copyEvent)	PX_OVERRIDE	PX_FINAL;
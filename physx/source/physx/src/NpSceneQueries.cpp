@@ -460,6 +460,9 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
+// Revisit the switch below (and the ones in ExtSceneQuerySystem / ExtCustomSceneQuerySystem) when adding a pruning structure type
+PX_COMPILE_TIME_ASSERT(PxPruningStructureType::eLAST == 5);
+
 static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
 {
 	// PT: to force testing the bucket pruner
@@ -475,7 +478,10 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
 		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
 		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
+		case PxPruningStructureType::eSTATIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
 		// PT: for tests
+		// Tests must pass the enumerator, its value changes when structure types are added.
 		case PxPruningStructureType::eLAST:					{ pruner = createIncrementalPruner(contextID);									break;	}
 //		case PxPruningStructureType::eLAST:					break;
 	}
@@ -493,6 +499,11 @@ static PxSceneQuerySystem* getPxSQ(const PxSceneDesc& desc, PVDCapture* pvd, PxU
 	{
 		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
 		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+		if(desc.treeBuildDispatcher)
+		{
+			staticPruner->setBuildDispatcher(desc.treeBuildDispatcher);
+			dynamicPruner->setBuildDispatcher(desc.treeBuildDispatcher);
+		}
 		return PX_NEW(InternalPxSQ)(desc, pvd, contextID, staticPruner, dynamicPruner);
 	}
 }
@@ -796,3 +807,17 @@ bool NpScene::fetchQueries(bool block)
 	}
 	return true;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SqQueryCandidateCache.h"
+
+PxQueryCandidateCache* physx::PxCreateQueryCandidateCache(PxReal inflation)
+{
+	if(!(inflation > 0.0f) || !PxIsFinite(inflation))
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCreateQueryCandidateCache: inflation must be positive and finite.");
+		return NULL;
+	}
+	return PX_NEW(Sq::QueryCandidateCache)(inflation);
+}
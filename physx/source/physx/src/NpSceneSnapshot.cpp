@@ -0,0 +1,410 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "NpScene.h"
+#include "NpRigidDynamic.h"
+#include "NpArticulationReducedCoordinate.h"
+#include "NpArticulationLink.h"
+#include "NpPruningStructure.h"
+#include "ScScene.h"
+#include "common/PxProfileZone.h"
+
+using namespace physx;
+
+///////////////////////////////////////////////////////////////////////////////
+
+PX_IMPLEMENT_OUTPUT_ERROR
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A snapshot is a header followed by one record per rigid dynamic, one record per articulation, and the
+// contact caches. All records are multiples of 16 bytes. The snapshot stores the actor pointers, it is only
+// meant to be restored in the scene it has been saved from, as long as no actor has been added or removed.
+
+namespace
+{
+	const PxU32 gSnapshotMagic = 0x53535850;	// 'PXSS'
+	const PxU32 gSnapshotVersion = 1;
+
+	struct SnapshotHeader
+	{
+		PxU32	magic;
+		PxU32	version;
+		PxU32	size;
+		PxU32	flags;
+		PxU32	nbRigidDynamics;
+		PxU32	nbArticulations;
+		PxU32	articulationDataSize;
+		PxU32	contactCacheDataSize;
+	};
+	PX_COMPILE_TIME_ASSERT((sizeof(SnapshotHeader)&15) == 0);
+
+	struct RigidDynamicState
+	{
+		const void*				actor;
+		PxTransform				body2World;
+		PxVec3					linearVelocity;
+		PxReal					wakeCounter;
+		PxVec3					angularVelocity;
+		PxU32					isSleeping;
+		Sc::BodyInternalState	internalState;
+	};
+
+	PX_FORCE_INLINE PxU32 align16(PxU32 size)
+	{
+		return (size + 15) & ~15;
+	}
+
+	const PxU32 gRigidDynamicStateSize = align16(sizeof(RigidDynamicState));
+
+	// Followed by the joint velocities, joint positions (dofs each) and the root link data
+	struct ArticulationState
+	{
+		const void*	articulation;
+		PxU32		nbDofs;
+		PxU32		isSleeping;
+		PxReal		wakeCounter;
+		PxU32		pad;
+	};
+
+	const PxArticulationCacheFlags gArticulationCacheFlags = PxArticulationCacheFlag::eVELOCITY | PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eROOT_TRANSFORM | PxArticulationCacheFlag::eROOT_VELOCITIES;
+
+	PX_FORCE_INLINE PxU32 getArticulationDataSize(PxU32 nbDofs)
+	{
+		return sizeof(PxReal) * nbDofs * 2 + sizeof(PxArticulationRootLinkData);
+	}
+
+	PX_FORCE_INLINE PxU32 getArticulationStateSize(PxU32 nbDofs)
+	{
+		return align16(sizeof(ArticulationState) + getArticulationDataSize(nbDofs));
+	}
+
+	// The cache arrays point to the articulation data, which must be 4-byte aligned
+	PX_FORCE_INLINE void setupArticulationCache(PxArticulationCache& cache, PxU8* data, PxU32 nbDofs, PxU32 version)
+	{
+		cache.jointVelocity	= reinterpret_cast<PxReal*>(data);
+		cache.jointPosition	= reinterpret_cast<PxReal*>(data) + nbDofs;
+		cache.rootLinkData	= reinterpret_cast<PxArticulationRootLinkData*>(data + sizeof(PxReal) * nbDofs * 2);
+		cache.version		= version;
+	}
+}
+
+PxU32 NpScene::getSnapshotSize(PxSceneSnapshotFlags flags) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::getSnapshotSize() not allowed while simulation is running.", 0);
+
+	PxU32 size = sizeof(SnapshotHeader) + mRigidDynamics.size() * gRigidDynamicStateSize;
+
+	PxArticulationReducedCoordinate*const* articulations = mArticulations.getEntries();
+	const PxU32 nbArticulations = mArticulations.size();
+	for(PxU32 i=0; i<nbArticulations; i++)
+		size += getArticulationStateSize(articulations[i]->getDofs());
+
+	if(flags & PxSceneSnapshotFlag::eCONTACT_CACHES)
+		size += mScene.getContactCacheSnapshotSize();
+
+	return size;
+}
+
+PxU32 NpScene::saveSnapshot(void* buffer, PxU32 bufferSize, PxSceneSnapshotFlags flags) const
+{
+	PX_PROFILE_ZONE("API.saveSnapshot", getContextId());
+	NP_READ_CHECK(this);
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::saveSnapshot() not allowed while simulation is running.", 0);
+	PX_CHECK_AND_RETURN_VAL(buffer, "PxScene::saveSnapshot(): buffer is NULL.", 0);
+
+	if(getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::saveSnapshot(): not allowed when direct-GPU API is used.");
+		return 0;
+	}
+
+	if((flags & PxSceneSnapshotFlag::eCONTACT_CACHES) && !mScene.supportsContactCacheSnapshot())
+	{
+		outputError<PxErrorCode::eDEBUG_WARNING>(__LINE__, "PxScene::saveSnapshot(): PxSceneSnapshotFlag::eCONTACT_CACHES is not supported with GPU narrow phase and will be ignored.");
+		flags.clear(PxSceneSnapshotFlag::eCONTACT_CACHES);
+	}
+
+	const PxU32 size = getSnapshotSize(flags);
+	if(bufferSize < size)
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::saveSnapshot(): buffer is too small, see PxScene::getSnapshotSize().");
+		return 0;
+	}
+
+	PxArticulationReducedCoordinate*const* articulations = mArticulations.getEntries();
+	const PxU32 nbArticulations = mArticulations.size();
+
+	PxU8* current = reinterpret_cast<PxU8*>(buffer);
+
+	SnapshotHeader header;
+	header.magic				= gSnapshotMagic;
+	header.version				= gSnapshotVersion;
+	header.size					= size;
+	header.flags				= flags;
+	header.nbRigidDynamics		= mRigidDynamics.size();
+	header.nbArticulations		= nbArticulations;
+	header.articulationDataSize	= 0;
+	header.contactCacheDataSize	= 0;
+	PxU8* headerPtr = current;
+	current += sizeof(SnapshotHeader);
+
+	{
+		PX_PROFILE_ZONE("saveSnapshot.rigidDynamics", getContextId());
+
+		const PxU32 nbRigidDynamics = mRigidDynamics.size();
+		for(PxU32 i=0; i<nbRigidDynamics; i++)
+		{
+			const NpRigidDynamic* actor = mRigidDynamics[i];
+			const Sc::BodyCore& core = actor->getCore();
+
+			RigidDynamicState state;
+			PxMemZero(&state, sizeof(RigidDynamicState));
+			state.actor				= actor;
+			state.body2World		= core.getBody2World();
+			state.linearVelocity	= core.getLinearVelocity();
+			state.wakeCounter		= core.getWakeCounter();
+			state.angularVelocity	= core.getAngularVelocity();
+			state.isSleeping		= PxU32(core.isSleeping());
+			core.getInternalState(state.internalState);
+
+			PxMemCopy(current, &state, sizeof(RigidDynamicState));
+			current += gRigidDynamicStateSize;
+		}
+	}
+
+	{
+		PX_PROFILE_ZONE("saveSnapshot.articulations", getContextId());
+
+		PxU8* start = current;
+		for(PxU32 i=0; i<nbArticulations; i++)
+		{
+			const NpArticulationReducedCoordinate* articulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+			const PxU32 nbDofs = articulation->getDofs();
+
+			ArticulationState state;
+			state.articulation	= articulation;
+			state.nbDofs		= nbDofs;
+			state.isSleeping	= PxU32(articulation->isSleeping());
+			state.wakeCounter	= articulation->getWakeCounter();
+			state.pad			= 0;
+			PxMemCopy(current, &state, sizeof(ArticulationState));
+
+			PxArticulationCache cache;
+			setupArticulationCache(cache, current + sizeof(ArticulationState), nbDofs, articulation->mCacheVersion);
+			articulation->copyInternalStateToCache(cache, gArticulationCacheFlags);
+
+			current += getArticulationStateSize(nbDofs);
+		}
+		header.articulationDataSize = PxU32(current - start);
+	}
+
+	if(flags & PxSceneSnapshotFlag::eCONTACT_CACHES)
+	{
+		PX_PROFILE_ZONE("saveSnapshot.contactCaches", getContextId());
+
+		header.contactCacheDataSize = mScene.getContactCacheSnapshotSize();
+		mScene.saveContactCacheSnapshot(current);
+		current += header.contactCacheDataSize;
+	}
+
+	PX_ASSERT(PxU32(current - reinterpret_cast<PxU8*>(buffer)) == size);
+	PxMemCopy(headerPtr, &header, sizeof(SnapshotHeader));
+	return size;
+}
+
+bool NpScene::restoreSnapshot(const void* buffer, PxU32 bufferSize)
+{
+	PX_PROFILE_ZONE("API.restoreSnapshot", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(buffer, "PxScene::restoreSnapshot(): buffer is NULL.", false);
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::restoreSnapshot() not allowed while simulation is running. Call will be ignored.", false)
+
+	if(getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): not allowed when direct-GPU API is used.");
+		return false;
+	}
+
+	const PxU8* data = reinterpret_cast<const PxU8*>(buffer);
+
+	// Validate everything first, so that an invalid snapshot leaves the scene untouched
+	SnapshotHeader header;
+	if(bufferSize < sizeof(SnapshotHeader))
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+	PxMemCopy(&header, data, sizeof(SnapshotHeader));
+
+	if(header.magic != gSnapshotMagic || header.version != gSnapshotVersion || header.size > bufferSize)
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+
+	PxArticulationReducedCoordinate*const* articulations = mArticulations.getEntries();
+	const PxU32 nbArticulations = mArticulations.size();
+
+	if(header.nbRigidDynamics != mRigidDynamics.size() || header.nbArticulations != nbArticulations)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): the actors of the scene do not match the snapshot.");
+
+	const PxU8* rigidDynamicData = data + sizeof(SnapshotHeader);
+	const PxU8* articulationData = rigidDynamicData + header.nbRigidDynamics * gRigidDynamicStateSize;
+	const PxU8* contactCacheData = articulationData + header.articulationDataSize;
+
+	if(PxU32(contactCacheData - data) + header.contactCacheDataSize != header.size)
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+
+	for(PxU32 i=0; i<header.nbRigidDynamics; i++)
+	{
+		const void* actor;
+		PxMemCopy(&actor, rigidDynamicData + i * gRigidDynamicStateSize + PX_OFFSET_OF_RT(RigidDynamicState, actor), sizeof(const void*));
+		if(actor != mRigidDynamics[i])
+			return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): the actors of the scene do not match the snapshot.");
+	}
+
+	{
+		PxU32 articulationDataSize = 0;
+		for(PxU32 i=0; i<nbArticulations; i++)
+		{
+			const NpArticulationReducedCoordinate* articulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+			const PxU32 nbDofs = articulation->getDofs();
+
+			ArticulationState state;
+			if(articulationDataSize + sizeof(ArticulationState) > header.articulationDataSize)
+				return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+			PxMemCopy(&state, articulationData + articulationDataSize, sizeof(ArticulationState));
+
+			if(state.articulation != articulation || state.nbDofs != nbDofs)
+				return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): the articulations of the scene do not match the snapshot.");
+
+			articulationDataSize += getArticulationStateSize(nbDofs);
+		}
+		if(articulationDataSize != header.articulationDataSize)
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+	}
+
+	if(header.contactCacheDataSize)
+	{
+		if(!mScene.supportsContactCacheSnapshot())
+			return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): the snapshot contains contact caches, which this scene does not support.");
+
+		if(!mScene.validateContactCacheSnapshot(contactCacheData, header.contactCacheDataSize))
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxScene::restoreSnapshot(): invalid snapshot.");
+	}
+
+	PX_SIMD_GUARD;
+
+	{
+		PX_PROFILE_ZONE("restoreSnapshot.rigidDynamics", getContextId());
+
+		PxSceneQuerySystem& sq = getSQAPI();
+		for(PxU32 i=0; i<header.nbRigidDynamics; i++)
+		{
+			RigidDynamicState state;
+			PxMemCopy(&state, rigidDynamicData + i * gRigidDynamicStateSize, sizeof(RigidDynamicState));
+
+			NpRigidDynamic* actor = mRigidDynamics[i];
+			Sc::BodyCore& core = actor->getCore();
+
+			// We write body2World directly to avoid the round trip through the actor pose, which is not bit-exact.
+			// This also resets the contact caches of the actor's pairs, and the scene query structures are updated in place.
+			actor->scSetBody2World(state.body2World);
+			actor->getShapeManager().markActorForSQUpdate(sq, *actor);
+			if(actor->getShapeManager().getPruningStructure())
+			{
+				outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::restoreSnapshot(): Actor is part of a pruning structure, pruning structure is now invalid!");
+				actor->getShapeManager().getPruningStructure()->invalidate(actor);
+			}
+
+			if((core.getFlags() & PxRigidBodyFlag::eKINEMATIC) || core.getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION))
+				continue;
+
+			if(state.isSleeping)
+			{
+				if(!core.isSleeping())
+					actor->scPutToSleepInternal();
+			}
+			else
+			{
+				actor->scSetLinearVelocity(state.linearVelocity);
+				actor->scSetAngularVelocity(state.angularVelocity);
+				if(core.isSleeping())
+					actor->scWakeUpInternal(state.wakeCounter);
+				else
+					actor->scSetWakeCounter(state.wakeCounter);
+			}
+
+			// Last, since waking up or putting to sleep resets some of it
+			core.setInternalState(state.internalState);
+		}
+	}
+
+	{
+		PX_PROFILE_ZONE("restoreSnapshot.articulations", getContextId());
+
+		// applyCache() reads the joint data from the cache arrays, so we copy it out of the (const) snapshot first
+		PxArray<PxU8> scratch;
+
+		PxSceneQuerySystem& sq = getSQAPI();
+		const PxU8* current = articulationData;
+		for(PxU32 i=0; i<nbArticulations; i++)
+		{
+			NpArticulationReducedCoordinate* articulation = static_cast<NpArticulationReducedCoordinate*>(articulations[i]);
+
+			ArticulationState state;
+			PxMemCopy(&state, current, sizeof(ArticulationState));
+
+			const PxU32 dataSize = getArticulationDataSize(state.nbDofs);
+			scratch.resizeUninitialized(dataSize);
+			PxMemCopy(scratch.begin(), current + sizeof(ArticulationState), dataSize);
+
+			PxArticulationCache cache;
+			setupArticulationCache(cache, scratch.begin(), state.nbDofs, articulation->mCacheVersion);
+			articulation->applyCache(cache, gArticulationCacheFlags, false);
+
+			NpArticulationLink*const* links = articulation->getLinks();
+			const PxU32 nbLinks = articulation->getNbLinks();
+			for(PxU32 j=0; j<nbLinks; j++)
+				links[j]->getShapeManager().markActorForSQUpdate(sq, *links[j]);
+
+			if(state.isSleeping)
+				articulation->putToSleep();
+			else
+				articulation->setWakeCounter(state.wakeCounter);
+
+			current += getArticulationStateSize(state.nbDofs);
+		}
+	}
+
+	if(header.contactCacheDataSize)
+	{
+		PX_PROFILE_ZONE("restoreSnapshot.contactCaches", getContextId());
+
+		// After the poses, since setting them resets the contact caches
+		mScene.restoreContactCacheSnapshot(contactCacheData, header.contactCacheDataSize);
+	}
+
+	return true;
+}
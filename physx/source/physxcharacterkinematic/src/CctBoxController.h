@@ -54,6 +54,7 @@ namespace Cct
 		virtual	PxF32								getHalfHeightInternal()				const		PX_OVERRIDE	PX_FINAL	{ return mHalfHeight;					}
 		virtual	bool								getWorldBox(PxExtendedBounds3& box) const		PX_OVERRIDE	PX_FINAL;
 		virtual	PxController*						getPxController()								PX_OVERRIDE	PX_FINAL	{ return this;							}
+		virtual	PxControllerCollisionFlags			moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveAllContext* moveAllContext)	PX_OVERRIDE	PX_FINAL;
 		//~Controller
 
 		// PxController
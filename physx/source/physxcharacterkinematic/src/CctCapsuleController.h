@@ -52,6 +52,7 @@ namespace Cct
 		virtual	PxF32								getHalfHeightInternal()				const	PX_OVERRIDE	PX_FINAL		{ return mRadius+mHeight*0.5f;			}
 		virtual	bool								getWorldBox(PxExtendedBounds3& box) const	PX_OVERRIDE	PX_FINAL;
 		virtual	PxController*						getPxController()							PX_OVERRIDE	PX_FINAL		{ return this;							}
+		virtual	PxControllerCollisionFlags			moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveAllContext* moveAllContext)	PX_OVERRIDE	PX_FINAL;
 		//~Controller
 
 		// PxController
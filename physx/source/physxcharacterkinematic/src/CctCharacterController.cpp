@@ -2283,7 +2283,7 @@ bool Controller::rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirect
 	return standingOnMoving;
 }
 
-PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
+PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode, MoveAllContext* moveAllContext)
 {
 	const bool lockWrite = mManager->mLockingEnabled;
 	if(lockWrite)
@@ -2381,10 +2381,10 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 //	printf("standingOnMoving: %d\n", standingOnMoving);
 
 	///////////
-	PxArray<const void*>&		boxUserData		= mManager->mBoxUserData;
-	PxArray<PxExtendedBox>&		boxes			= mManager->mBoxes;
-	PxArray<const void*>&		capsuleUserData	= mManager->mCapsuleUserData;
-	PxArray<PxExtendedCapsule>&	capsules		= mManager->mCapsules;
+	PxArray<const void*>&		boxUserData		= moveAllContext ? moveAllContext->mBoxUserData : mManager->mBoxUserData;
+	PxArray<PxExtendedBox>&		boxes			= moveAllContext ? moveAllContext->mBoxes : mManager->mBoxes;
+	PxArray<const void*>&		capsuleUserData	= moveAllContext ? moveAllContext->mCapsuleUserData : mManager->mCapsuleUserData;
+	PxArray<PxExtendedCapsule>&	capsules		= moveAllContext ? moveAllContext->mCapsules : mManager->mCapsules;
 	PX_ASSERT(!boxUserData.size());
 	PX_ASSERT(!boxes.size());
 	PX_ASSERT(!capsuleUserData.size());
@@ -2412,9 +2412,11 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				if(currentController->mType==PxControllerShapeType::eBOX)
 				{
 					// PT: TODO: optimize this
-					BoxController* BC = static_cast<BoxController*>(currentController);
 					PxExtendedBox obb;
-					BC->getOBB(obb);
+					if(moveAllContext)
+						obb = moveAllContext->mCCTBoxes[i];
+					else
+						static_cast<BoxController*>(currentController)->getOBB(obb);
 
 					boxes.pushBack(obb);
 
@@ -2434,11 +2436,12 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				}
 				else if(currentController->mType==PxControllerShapeType::eCAPSULE)
 				{
-					CapsuleController* CC = static_cast<CapsuleController*>(currentController);
-
 					// PT: TODO: optimize this
 					PxExtendedCapsule worldCapule;
-					CC->getCapsule(worldCapule);
+					if(moveAllContext)
+						worldCapule = moveAllContext->mCCTCapsules[i];
+					else
+						static_cast<CapsuleController*>(currentController)->getCapsule(worldCapule);
 					capsules.pushBack(worldCapule);
 
 					const size_t code = encodeUserObject(i, USER_OBJECT_CCT);
@@ -2533,6 +2536,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	findGeomData.scene				= mScene;
 	findGeomData.renderBuffer		= renderBuffer;
 	findGeomData.cctShapeHashSet	= &mManager->mCCTShapes;
+	findGeomData.sharedCell			= moveAllContext ? moveAllContext->mCell : NULL;
 
 	mCctModule.mFlags &= ~STF_WALK_EXPERIMENT;
 
@@ -2568,8 +2572,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	// Copy results back
 	mPosition = volume.mCenter;
 
-	// Update kinematic actor
-	if(mKineActor)
+	// Update kinematic actor. MoveAll() does this afterwards from the calling thread, since it writes to the scene.
+	if(mKineActor && !moveAllContext)
 	{
 		const PxVec3 delta = diff(Backup, volume.mCenter);
 		const PxF32 deltaM2 = delta.magnitudeSquared();
@@ -2582,7 +2586,15 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 		}
 	}
 
-	mManager->resetObstaclesBuffers();
+	if(moveAllContext)
+	{
+		moveAllContext->mBoxUserData.clear();
+		moveAllContext->mBoxes.clear();
+		moveAllContext->mCapsuleUserData.clear();
+		moveAllContext->mCapsules.clear();
+	}
+	else
+		mManager->resetObstaclesBuffers();
 
 	if (lockWrite)
 		mWriteLock.unlock();
@@ -2592,6 +2604,11 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 
 
 PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, NULL);
+}
+
+PxControllerCollisionFlags BoxController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveAllContext* moveAllContext)
 {
 	PX_PROFILE_ZONE("CharacterController.move", getContextId());
 
@@ -2602,10 +2619,15 @@ PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist
 	sweptBox.mCenter		= mPosition;
 	sweptBox.mExtents		= PxVec3(mHalfHeight, mHalfSideExtent, mHalfForwardExtent);
 	sweptBox.mHalfHeight	= mHalfHeight;	// UBI
-	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false);
+	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false, moveAllContext);
 }
 
 PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, NULL);
+}
+
+PxControllerCollisionFlags CapsuleController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveAllContext* moveAllContext)
 {
 	PX_PROFILE_ZONE("CharacterController.move", getContextId());
 
@@ -2617,6 +2639,6 @@ PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 min
 	sweptCapsule.mRadius		= mRadius;
 	sweptCapsule.mHeight		= mHeight;
 	sweptCapsule.mHalfHeight	= mHeight*0.5f + mRadius;	// UBI
-	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED);
+	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED, moveAllContext);
 }
 
@@ -35,6 +35,7 @@
 #include "geometry/PxHeightFieldGeometry.h"
 #include "geometry/PxConvexMesh.h"
 #include "geometry/PxMeshQuery.h"
+#include "geometry/PxGeometryQuery.h"
 #include "common/PxRenderBuffer.h"
 #include "common/PxRenderOutput.h"
 #include "foundation/PxMathUtils.h"
@@ -925,6 +926,36 @@ PxU32 Cct::getSceneTimestamp(const InternalCBData_FindTouchedGeom* userData)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static void outputShapeToStream(	PxShape* shape, const PxRigidActor* actor, const PxInternalCBData_FindTouchedGeom* internalData, IntArray& geomStream, TriArray& worldTriangles, IntArray& triIndicesArray,
+									const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, PxRenderBuffer* renderBuffer, PxU16& nbTessellation)
+{
+	// Filtering
+
+	// Discard all CCT shapes, i.e. kinematic actors we created ourselves. We don't need to collide with them since they're surrounded
+	// by the real CCT volume - and collisions with those are handled elsewhere.
+	if(internalData->cctShapeHashSet->contains(shape))
+		return;
+
+	// Ubi (EA) : Discarding Triggers :
+	if(shape->getFlags() & PxShapeFlag::eTRIGGER_SHAPE)
+		return;
+
+	// PT: here you might want to disable kinematic objects.
+
+	// Output shape to stream
+	const PxTransform globalPose = getShapeGlobalPose(*shape, *actor);
+
+	const PxGeometryType::Enum type = shape->getGeometry().getType();	// ### VIRTUAL!
+	if(type==PxGeometryType::eSPHERE)				outputSphereToStream		(shape, actor, globalPose, geomStream, origin);
+	else	if(type==PxGeometryType::eCAPSULE)		outputCapsuleToStream		(shape, actor, globalPose, geomStream, origin);
+	else	if(type==PxGeometryType::eBOX)			outputBoxToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, origin, tmpBounds, params, nbTessellation);
+	else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, origin, tmpBounds, params, renderBuffer, nbTessellation);
+	else	if(type==PxGeometryType::eHEIGHTFIELD)	outputHeightFieldToStream	(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, origin, tmpBounds, params, renderBuffer, nbTessellation);
+	else	if(type==PxGeometryType::eCONVEXMESH)	outputConvexToStream		(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, origin, tmpBounds, params, renderBuffer, nbTessellation);
+	else	if(type==PxGeometryType::ePLANE)		outputPlaneToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, origin, tmpBounds, params, renderBuffer);
+	else	if(type==PxGeometryType::eCUSTOM)		outputCustomToStream		(shape, actor, globalPose, geomStream, origin);
+}
+
 void Cct::findTouchedGeometry(
 	const InternalCBData_FindTouchedGeom* userData,
 	const PxExtendedBounds3& worldBounds,		// ### we should also accept other volumes
@@ -970,7 +1001,35 @@ void Cct::findTouchedGeometry(
 	const PxVec3 center = tmpBounds.getCenter();
 	const PxVec3 extents = tmpBounds.getExtents();
 
+	// Max number of shapes returned by the scene query
 	const PxU32 size = 100;
+
+	// Static shapes around controllers moved by PxControllerManager::moveAll() have been gathered once for the whole cell.
+	// The cell's list contains every shape the scene query below could return, in the same order, so testing them against
+	// the query box and stopping at the same number of hits gives the same shapes as the scene query.
+	const SharedGeomCell* cell = internalData->sharedCell;
+	if(cell && filter.mStaticShapes && !filter.mDynamicShapes && tmpBounds.isInside(cell->mBounds))
+	{
+		if(extents.x > 0.0f && extents.y > 0.0f && extents.z > 0.0f)
+		{
+			const PxBoxGeometry queryBox(extents);
+			const PxTransform queryPose(center);
+
+			PxU32 numberHits = 0;
+			const PxU32 nbCellHits = cell->mHits.size();
+			for(PxU32 i=0;i<nbCellHits && numberHits<size;i++)
+			{
+				const SharedGeomHit& hit = cell->mHits[i];
+				if(!hit.bounds.intersects(tmpBounds) || !PxGeometryQuery::overlap(queryBox, queryPose, hit.shape->getGeometry(), hit.pose))
+					continue;
+
+				numberHits++;
+				outputShapeToStream(hit.shape, hit.actor, internalData, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
+			}
+		}
+		return;
+	}
+
 	PxOverlapHit hits[size];
 
 	PxQueryFilterData sceneQueryFilterData = filter.mFilterData ? PxQueryFilterData(*filter.mFilterData, sqFilterFlags) : PxQueryFilterData(sqFilterFlags);
@@ -991,31 +1050,7 @@ void Cct::findTouchedGeometry(
 		if(!shape || !actor)
 			continue;
 
-		// Filtering
-
-		// Discard all CCT shapes, i.e. kinematic actors we created ourselves. We don't need to collide with them since they're surrounded
-		// by the real CCT volume - and collisions with those are handled elsewhere.
-		if(internalData->cctShapeHashSet->contains(shape))
-			continue;
-
-		// Ubi (EA) : Discarding Triggers :
-		if(shape->getFlags() & PxShapeFlag::eTRIGGER_SHAPE)
-			continue;
-
-		// PT: here you might want to disable kinematic objects.
-
-		// Output shape to stream
-		const PxTransform globalPose = getShapeGlobalPose(*shape, *actor);
-
-		const PxGeometryType::Enum type = shape->getGeometry().getType();	// ### VIRTUAL!
-		if(type==PxGeometryType::eSPHERE)				outputSphereToStream		(shape, actor, globalPose, geomStream, Origin);
-		else	if(type==PxGeometryType::eCAPSULE)		outputCapsuleToStream		(shape, actor, globalPose, geomStream, Origin);
-		else	if(type==PxGeometryType::eBOX)			outputBoxToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, nbTessellation);
-		else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
-		else	if(type==PxGeometryType::eHEIGHTFIELD)	outputHeightFieldToStream	(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
-		else	if(type==PxGeometryType::eCONVEXMESH)	outputConvexToStream		(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
-		else	if(type==PxGeometryType::ePLANE)		outputPlaneToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer);
-		else	if(type==PxGeometryType::eCUSTOM)		outputCustomToStream		(shape, actor, globalPose, geomStream, Origin);
+		outputShapeToStream(shape, actor, internalData, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
 	}
 }
 
@@ -32,7 +32,13 @@
 #include "CctObstacleContext.h"
 #include "GuDistanceSegmentSegment.h"
 #include "GuDistanceSegmentBox.h"
+#include "common/PxProfileZone.h"
 #include "foundation/PxUtilities.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxInlineArray.h"
+#include "task/PxParallelFor.h"
+#include "extensions/PxShapeExt.h"
 #include "PxRigidDynamic.h"
 #include "PxScene.h"
 #include "PxPhysics.h"
@@ -55,7 +61,8 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 	mOverlapRecovery						(true),
 	mPreciseSweeps							(true),
 	mPreventVerticalSlidingAgainstCeiling	(false),
-	mLockingEnabled							(lockingEnabled)
+	mLockingEnabled							(lockingEnabled),
+	mMoveAllInProgress						(false)
 {
 	// PT: register ourself as a deletion listener, to be called by the SDK whenever an object is deleted	
 	PxPhysics& physics = scene.getPhysics();
@@ -64,6 +71,10 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 
 CharacterControllerManager::~CharacterControllerManager()
 {
+	const PxU32 nbContexts = mMoveAllContexts.size();
+	for(PxU32 i=0;i<nbContexts;i++)
+		PX_DELETE(mMoveAllContexts[i]);
+
 	PX_DELETE(mRenderBuffer);
 }
 
@@ -280,18 +291,20 @@ void CharacterControllerManager::onRelease(const PxBase* observed, void* , PxDel
 
 void CharacterControllerManager::registerObservedObject(const PxBase* obj)
 {	
-	if(mLockingEnabled)
+	const bool lock = mLockingEnabled || mMoveAllInProgress;
+	if(lock)
 		mWriteLock.lock();
 
 	mObservedRefCountMap[obj].refCount++;	
 
-	if(mLockingEnabled)
+	if(lock)
 		mWriteLock.unlock();
 }
 
 void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 {
-	if(mLockingEnabled)
+	const bool lock = mLockingEnabled || mMoveAllInProgress;
+	if(lock)
 		mWriteLock.lock();
 
 	ObservedRefCounter& refCounter = mObservedRefCountMap[obj];
@@ -300,7 +313,7 @@ void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 	if(!refCounter.refCount)
 		mObservedRefCountMap.erase(obj);
 
-	if(mLockingEnabled)
+	if(lock)
 		mWriteLock.unlock();
 }
 
@@ -668,39 +681,74 @@ static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>
 	PX_FREE(PosList);
 }
 
-void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)
+namespace
 {
-	PxU32 nbControllers = mControllers.size();
-	Controller** controllers = mControllers.begin();
+	// Interactions between all characters, filtered by the user's callback
+	struct ControllerPairFilter
+	{
+		ControllerPairFilter(PxControllerFilterCallback* cctFilterCb, PxF32 elapsedTime) : mCCTFilterCallback(cctFilterCb), mElapsedTime(elapsedTime)	{}
 
-	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, nbControllers, "CharacterControllerManager::computeInteractions");	// PT: TODO: get rid of alloc
-	PxBounds3* runningBoxes = boxes;
+		PX_FORCE_INLINE	bool	operator()(const Controller* ctrl0, const Controller* ctrl1, PxControllerFilterCallback*& cctFilterCb, PxF32& elapsedTime)	const
+		{
+			PX_UNUSED(ctrl0);
+			PX_UNUSED(ctrl1);
+			cctFilterCb = mCCTFilterCallback;
+			elapsedTime = mElapsedTime;
+			return true;
+		}
 
-	while(nbControllers--)
+		PxControllerFilterCallback*	mCCTFilterCallback;
+		const PxF32					mElapsedTime;
+	};
+
+	// Interactions involving at least one character moved by moveAll(), using that move's filter & time step
+	struct MoveAllPairFilter
 	{
-		Controller* current = *controllers++;
+		MoveAllPairFilter(const PxControllerMoveDesc* descs) : mDescs(descs)	{}
 
-		PxExtendedBounds3 extBox;
-		current->getWorldBox(extBox);
+		PX_FORCE_INLINE	bool	operator()(const Controller* ctrl0, const Controller* ctrl1, PxControllerFilterCallback*& cctFilterCb, PxF32& elapsedTime)	const
+		{
+			// PX_INVALID_U32 is the largest index, so this picks a moved controller
+			const PxU32 descIndex = PxMin(ctrl0->mMoveAllIndex, ctrl1->mMoveAllIndex);
+			if(descIndex==PX_INVALID_U32)
+				return false;
+
+			const PxControllerMoveDesc& desc = mDescs[descIndex];
+			cctFilterCb = desc.filters.mCCTFilterCallback;
+			elapsedTime = desc.elapsedTime;
+			return true;
+		}
 
-		*runningBoxes++ = PxBounds3(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
-	}
+		const PxControllerMoveDesc*	mDescs;
+	};
+}
 
-	//
+template<class PairFilterT>
+static void computeControllerInteractions(Controller** controllers, PxU32 nbControllers, const PairFilterT& pairFilter)
+{
+	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, nbControllers, "computeControllerInteractions");	// TODO: get rid of alloc
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		PxExtendedBounds3 extBox;
+		controllers[i]->getWorldBox(extBox);
 
-	const PxU32 nbEntities = PxU32(runningBoxes - boxes);
+		boxes[i] = PxBounds3(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
+	}
 
 	PxArray<PxU32> pairs;	// PT: TODO: get rid of alloc
-	completeBoxPruning(boxes, nbEntities, pairs);
+	completeBoxPruning(boxes, nbControllers, pairs);
 
 	PxU32 nbPairs = pairs.size()>>1;
 	const PxU32* indices = pairs.begin();
 	while(nbPairs--)
 	{
-		const PxU32 index0 = *indices++;
-		const PxU32 index1 = *indices++;
-		Controller* ctrl0 = mControllers[index0];
-		Controller* ctrl1 = mControllers[index1];
+		Controller* ctrl0 = controllers[*indices++];
+		Controller* ctrl1 = controllers[*indices++];
+
+		PxControllerFilterCallback* cctFilterCb;
+		PxF32 elapsedTime;
+		if(!pairFilter(ctrl0, ctrl1, cctFilterCb, elapsedTime))
+			continue;
 
 		bool keep=true;
 		if(cctFilterCb)
@@ -713,3 +761,348 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 	PX_FREE(boxes);
 }
 
+void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)
+{
+	computeControllerInteractions(mControllers.begin(), mControllers.size(), ControllerPairFilter(cctFilterCb, elapsedTime));
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CCT_MOVE_ALL_BATCH_SIZE		8		// Moves per batch
+#define CCT_MOVE_ALL_CELL_HIT_BATCH	64		// Static shapes reported to a cell per overlap callback
+#define CCT_MOVE_ALL_MAX_NB_GROUPS	255		// Max number of distinct filter data shared by cells
+#define CCT_MOVE_ALL_CELL_BITS		18		// Bits per cell coordinate in sort keys
+#define CCT_MOVE_ALL_NO_CELL		PxU64(-1)	// Sort key of moves that cannot use a shared cell
+
+namespace
+{
+	// Appends all the static shapes touching a cell to its list. There is no limit on their number: the cell must contain
+	// every shape the scene query of a move could return, in the same order.
+	class GatherCellCallback : public PxOverlapCallback
+	{
+		PX_NOCOPY(GatherCellCallback)
+		public:
+							GatherCellCallback(SharedGeomCell& cell) : PxOverlapCallback(mBuffer, CCT_MOVE_ALL_CELL_HIT_BATCH), mCell(cell)	{}
+
+		virtual	PxAgain		processTouches(const PxOverlapHit* buffer, PxU32 nbHits)	PX_OVERRIDE
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+			{
+				const PxOverlapHit& hit = buffer[i];
+				if(!hit.shape || !hit.actor)
+					continue;
+
+				SharedGeomHit& sharedHit = mCell.mHits.insert();
+				sharedHit.bounds	= PxShapeExt::getWorldBounds(*hit.shape, *hit.actor);
+				sharedHit.pose		= PxShapeExt::getGlobalPose(*hit.shape, *hit.actor);
+				sharedHit.shape		= hit.shape;
+				sharedHit.actor		= hit.actor;
+			}
+			return true;
+		}
+
+				SharedGeomCell&	mCell;
+				PxOverlapHit	mBuffer[CCT_MOVE_ALL_CELL_HIT_BATCH];
+	};
+
+	// Gathers the static shapes touched by each cell
+	class GatherCellsWork : public PxParallelForWork
+	{
+		PX_NOCOPY(GatherCellsWork)
+		public:
+							GatherCellsWork(PxScene& scene, SharedGeomCell* cells) : mScene(scene), mCells(cells)	{}
+
+		virtual	void		process(PxU32 index)	PX_OVERRIDE
+		{
+			SharedGeomCell& cell = mCells[index];
+
+			// Same query as findTouchedGeometry() for static shapes. Moves using filter callbacks never share cells.
+			GatherCellCallback callback(cell);
+			const PxQueryFilterData sceneQueryFilterData(cell.mFilterData, PxQueryFlag::eSTATIC|PxQueryFlag::eNO_BLOCK);
+			mScene.overlap(PxBoxGeometry(cell.mBounds.getExtents()), PxTransform(cell.mBounds.getCenter()), callback, sceneQueryFilterData);
+		}
+
+				PxScene&		mScene;
+				SharedGeomCell*	mCells;
+	};
+
+	// Each work item borrows one of the scratch contexts for its duration. There is one context per thread running the
+	// work, so a free one is always found, and the scratch arrays of a context are only used by one thread at a time.
+	class MoveControllersWork : public PxParallelForWork
+	{
+		PX_NOCOPY(MoveControllersWork)
+		public:
+							MoveControllersWork(PxControllerMoveDesc* descs, const MoveAllEntry* entries, PxU32 nbEntries, const SharedGeomCell* cells, MoveAllContext* const* contexts, PxU32 nbContexts) :
+								mDescs(descs), mEntries(entries), mNbEntries(nbEntries), mCells(cells), mContexts(contexts), mNbContexts(nbContexts)
+							{
+								PX_ASSERT(nbContexts && nbContexts<=PX_PARALLEL_FOR_MAX_NB_HELPERS+1);
+								for(PxU32 i=0;i<nbContexts;i++)
+									mContextInUse[i] = 0;
+							}
+
+		virtual	void		process(PxU32 index)	PX_OVERRIDE
+		{
+			PxU32 contextIndex = 0;
+			while(PxAtomicCompareExchange(&mContextInUse[contextIndex], 1, 0))
+				contextIndex = contextIndex+1<mNbContexts ? contextIndex+1 : 0;
+			MoveAllContext& context = *mContexts[contextIndex];
+
+			const PxU32 start = index * CCT_MOVE_ALL_BATCH_SIZE;
+			const PxU32 end = PxMin(start + CCT_MOVE_ALL_BATCH_SIZE, mNbEntries);
+			for(PxU32 i=start;i<end;i++)
+			{
+				const MoveAllEntry& entry = mEntries[i];
+				PxControllerMoveDesc& desc = mDescs[entry.mDescIndex];
+
+				context.mCell = entry.mCellIndex!=PX_INVALID_U32 ? mCells + entry.mCellIndex : NULL;
+
+				Controller* controller = getInternalController(desc.controller);
+				desc.collisionFlags = controller->moveInternal(desc.disp, desc.minDist, desc.elapsedTime, desc.filters, desc.obstacles, &context);
+			}
+
+			PxAtomicExchange(&mContextInUse[contextIndex], 0);
+		}
+
+		static	Controller*	getInternalController(PxController* controller)
+		{
+			if(controller->getType()==PxControllerShapeType::eBOX)
+				return static_cast<BoxController*>(controller);
+			PX_ASSERT(controller->getType()==PxControllerShapeType::eCAPSULE);
+			return static_cast<CapsuleController*>(controller);
+		}
+
+				PxControllerMoveDesc*	mDescs;
+		const	MoveAllEntry*			mEntries;
+		const	PxU32					mNbEntries;
+		const	SharedGeomCell*			mCells;
+				MoveAllContext* const*	mContexts;
+		const	PxU32					mNbContexts;
+				volatile PxI32			mContextInUse[PX_PARALLEL_FOR_MAX_NB_HELPERS+1];
+	};
+}
+
+// Conservative estimate of the volume queried by a move. This does not need to be exact: controllers whose query
+// does not fit in their cell's bounds fall back to their own scene query.
+static PxBounds3 computeMoveBounds(const Controller& controller, const PxControllerMoveDesc& desc)
+{
+	PxExtendedBounds3 extBox;
+	controller.getWorldBox(extBox);
+
+	PxBounds3 box(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
+	box.fattenFast(controller.mUserParams.mContactOffset + controller.mUserParams.mStepOffset);
+
+	const PxVec3 disp = desc.disp + controller.mOverlapRecover;
+	PxBounds3 moveBox(box.minimum + disp, box.maximum + disp);
+	if(controller.mUserParams.mMaxJumpHeight!=0.0f)
+	{
+		const PxVec3 jump = controller.mUserParams.mUpDirection * controller.mUserParams.mMaxJumpHeight;
+		moveBox.include(PxBounds3(box.minimum - jump, box.maximum - jump));
+	}
+	box.include(moveBox);
+
+	// The cached volume is grown by mVolumeGrowth and offset sideways by SweepTest::updateTouchedGeoms()
+	box.scaleFast(controller.mCctModule.mVolumeGrowth * 2.0f);
+	return box;
+}
+
+static PX_FORCE_INLINE PxU64 encodeCellCoord(PxReal coord)
+{
+	const PxI32 halfRange = 1<<(CCT_MOVE_ALL_CELL_BITS-1);
+	const PxI32 c = PxClamp(PxI32(PxFloor(coord)), -halfRange, halfRange-1);
+	return PxU64(c + halfRange);
+}
+
+void CharacterControllerManager::moveAll(PxU32 nbDescs, PxControllerMoveDesc* descs, PxCpuDispatcher* dispatcher, PxReal cellSize)
+{
+	PX_PROFILE_ZONE("CharacterControllerManager.moveAll", PxU64(&mScene));
+
+	if(!nbDescs)
+		return;
+
+	if(!descs)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveAll(): NULL descriptors.");
+		return;
+	}
+
+	// Flag the moved controllers. This also catches invalid & duplicate entries.
+	for(PxU32 i=0;i<nbDescs;i++)
+	{
+		PxController* pxController = descs[i].controller;
+		Controller* controller = pxController ? MoveControllersWork::getInternalController(pxController) : NULL;
+		if(!controller || controller->getCctManager()!=this || controller->mMoveAllIndex!=PX_INVALID_U32)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveAll(): invalid or duplicate controller.");
+			while(i--)
+				MoveControllersWork::getInternalController(descs[i].controller)->mMoveAllIndex = PX_INVALID_U32;
+			return;
+		}
+		controller->mMoveAllIndex = i;
+	}
+
+	const PxU32 nbControllers = mControllers.size();
+	Controller** controllers = mControllers.begin();
+
+	// Snapshot of all volumes. Each move collides against the other controllers as they were before any of them moved.
+	{
+		mMoveAllBoxes.resize(nbControllers);
+		mMoveAllCapsules.resize(nbControllers);
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			if(controllers[i]->mType==PxControllerShapeType::eBOX)
+				static_cast<BoxController*>(controllers[i])->getOBB(mMoveAllBoxes[i]);
+			else
+				static_cast<CapsuleController*>(controllers[i])->getCapsule(mMoveAllCapsules[i]);
+		}
+	}
+
+	// Assign moves to cells. Moves whose static geometry query can be shared are sorted by filter data & cell.
+	PxU32 nbCells = 0;
+	{
+		PX_PROFILE_ZONE("CharacterControllerManager.moveAll.buildCells", PxU64(&mScene));
+
+		mMoveAllEntries.resize(nbDescs);
+
+		// Default cell size, large enough for cells to be shared by a few controllers
+		if(cellSize<=0.0f)
+		{
+			PxReal maxSize = 0.0f;
+			for(PxU32 i=0;i<nbDescs;i++)
+			{
+				PxExtendedBounds3 extBox;
+				MoveControllersWork::getInternalController(descs[i].controller)->getWorldBox(extBox);
+				PxVec3 extents;
+				getExtents(extBox, extents);
+				maxSize = PxMax(maxSize, extents.maxElement()*2.0f);
+			}
+			cellSize = maxSize * 8.0f;
+		}
+		const PxReal invCellSize = cellSize>0.0f ? 1.0f/cellSize : 0.0f;
+
+		PxInlineArray<PxFilterData, 8> groups;
+		for(PxU32 i=0;i<nbDescs;i++)
+		{
+			const PxControllerMoveDesc& desc = descs[i];
+			const Controller* controller = MoveControllersWork::getInternalController(desc.controller);
+
+			MoveAllEntry& entry = mMoveAllEntries[i];
+			entry.mKey			= CCT_MOVE_ALL_NO_CELL;
+			entry.mDescIndex	= i;
+			entry.mCellIndex	= PX_INVALID_U32;
+			entry.mStartPos		= controller->mPosition;
+			entry.mBounds		= computeMoveBounds(*controller, desc);
+
+			// Filter callbacks can depend on the moved controller, so their results cannot be shared
+			const PxQueryFlags flags = desc.filters.mFilterFlags;
+			const bool usesCallback = desc.filters.mFilterCallback && (flags & (PxQueryFlag::ePREFILTER|PxQueryFlag::ePOSTFILTER));
+			if(invCellSize==0.0f || !(flags & PxQueryFlag::eSTATIC) || usesCallback)
+				continue;
+
+			const PxFilterData filterData = desc.filters.mFilterData ? *desc.filters.mFilterData : PxFilterData();
+			PxU32 group = 0;
+			while(group<groups.size() && !(groups[group]==filterData))
+				group++;
+			if(group==groups.size())
+			{
+				if(group==CCT_MOVE_ALL_MAX_NB_GROUPS)
+					continue;
+				groups.pushBack(filterData);
+			}
+
+			const PxVec3 center = entry.mBounds.getCenter() * invCellSize;
+			entry.mKey =	(PxU64(group)<<(CCT_MOVE_ALL_CELL_BITS*3))
+						|	(encodeCellCoord(center.x)<<(CCT_MOVE_ALL_CELL_BITS*2))
+						|	(encodeCellCoord(center.y)<<CCT_MOVE_ALL_CELL_BITS)
+						|	encodeCellCoord(center.z);
+		}
+
+		PxSort(mMoveAllEntries.begin(), nbDescs);
+
+		PxU64 currentKey = CCT_MOVE_ALL_NO_CELL;
+		for(PxU32 i=0;i<nbDescs;i++)
+		{
+			MoveAllEntry& entry = mMoveAllEntries[i];
+			if(entry.mKey==CCT_MOVE_ALL_NO_CELL)
+				break;	// Sorted last
+
+			if(entry.mKey!=currentKey)
+			{
+				currentKey = entry.mKey;
+				if(nbCells==mMoveAllCells.size())
+					mMoveAllCells.insert();
+
+				SharedGeomCell& cell = mMoveAllCells[nbCells++];
+				cell.mBounds		= entry.mBounds;
+				cell.mFilterData	= groups[PxU32(entry.mKey>>(CCT_MOVE_ALL_CELL_BITS*3))];
+				cell.mHits.clear();
+			}
+			else
+				mMoveAllCells[nbCells-1].mBounds.include(entry.mBounds);
+
+			entry.mCellIndex = nbCells-1;
+		}
+	}
+
+	// Debug rendering writes to a single render buffer, so in that case everything runs on the calling thread
+	if(mRenderBuffer)
+		dispatcher = NULL;
+
+	// Scratch contexts, one per thread running the moves: PxParallelFor() uses the calling thread and at most one helper task per worker
+	const PxU32 nbContexts = (dispatcher ? PxMin(dispatcher->getWorkerCount(), PxU32(PX_PARALLEL_FOR_MAX_NB_HELPERS)) : 0) + 1;
+	while(mMoveAllContexts.size()<nbContexts)
+		mMoveAllContexts.pushBack(PX_NEW(MoveAllContext));
+	for(PxU32 i=0;i<nbContexts;i++)
+	{
+		MoveAllContext& context = *mMoveAllContexts[i];
+		context.mCCTBoxes		= mMoveAllBoxes.begin();
+		context.mCCTCapsules	= mMoveAllCapsules.begin();
+		context.mCell			= NULL;
+	}
+
+	mMoveAllInProgress = true;
+
+	{
+		PX_PROFILE_ZONE("CharacterControllerManager.moveAll.gatherCells", PxU64(&mScene));
+
+		GatherCellsWork work(mScene, mMoveAllCells.begin());
+		PxParallelFor(dispatcher, work, nbCells, "PxControllerManager::moveAll");
+	}
+
+	{
+		PX_PROFILE_ZONE("CharacterControllerManager.moveAll.move", PxU64(&mScene));
+
+		MoveControllersWork work(descs, mMoveAllEntries.begin(), nbDescs, mMoveAllCells.begin(), mMoveAllContexts.begin(), nbContexts);
+		PxParallelFor(dispatcher, work, PxParallelForGetNbChunks(nbDescs, CCT_MOVE_ALL_BATCH_SIZE), "PxControllerManager::moveAll");
+	}
+
+	mMoveAllInProgress = false;
+
+	// Update kinematic actors, as in Controller::move()
+	for(PxU32 i=0;i<nbDescs;i++)
+	{
+		const MoveAllEntry& entry = mMoveAllEntries[i];
+		Controller* controller = MoveControllersWork::getInternalController(descs[entry.mDescIndex].controller);
+		if(controller->mKineActor)
+		{
+			const PxVec3 delta = diff(entry.mStartPos, controller->mPosition);
+			if(delta.magnitudeSquared()!=0.0f)
+			{
+				PxTransform targetPose = controller->mKineActor->getGlobalPose();
+				targetPose.p = toVec3(controller->mPosition);
+				targetPose.q = controller->mUserParams.mQuatFromUp;
+				controller->mKineActor->setKinematicTarget(targetPose);
+			}
+		}
+	}
+
+	// Second pass, for overlaps between characters that moved at the same time. This runs on the calling thread from the
+	// final positions only, so the results do not depend on the number of threads.
+	{
+		PX_PROFILE_ZONE("CharacterControllerManager.moveAll.interactions", PxU64(&mScene));
+		computeControllerInteractions(controllers, nbControllers, MoveAllPairFilter(descs));
+	}
+
+	for(PxU32 i=0;i<nbDescs;i++)
+		MoveControllersWork::getInternalController(descs[i].controller)->mMoveAllIndex = PX_INVALID_U32;
+}
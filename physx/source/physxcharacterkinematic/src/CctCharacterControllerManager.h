@@ -50,6 +50,7 @@ namespace Cct
 {
 	class Controller;
 	class ObstacleContext;
+	struct MoveAllContext;
 
 	struct ObservedRefCounter
 	{
@@ -62,6 +63,39 @@ namespace Cct
 
 	typedef PxHashMap<const PxBase*, ObservedRefCounter>	ObservedRefCountMap;
 
+	struct SharedGeomHit
+	{
+		PxBounds3				bounds;			// World bounds of the shape
+		PxTransform				pose;			// World pose of the shape
+		PxShape*				shape;
+		PxRigidActor*			actor;
+	};
+
+	// Static shapes gathered once by PxControllerManager::moveAll() for all the controllers moved from the same cell.
+	// Only queries fully contained in mBounds can be answered from the cell.
+	struct SharedGeomCell
+	{
+		PxBounds3				mBounds;
+		PxFilterData			mFilterData;	// Filter data shared by all the moves of the cell
+		PxArray<SharedGeomHit>	mHits;			// In the order in which the scene query returned them
+	};
+
+	// One entry per move in PxControllerManager::moveAll(). Entries are sorted by cell so that moves sharing static
+	// geometry are processed together.
+	struct MoveAllEntry
+	{
+		PxU64			mKey;			// Filter group & cell coordinates, or all bits set for moves that cannot use a shared cell
+		PxU32			mDescIndex;
+		PxU32			mCellIndex;
+		PxExtendedVec3	mStartPos;
+		PxBounds3		mBounds;		// Estimated volume touched by the move
+
+		PX_FORCE_INLINE	bool	operator<(const MoveAllEntry& other)	const
+		{
+			return mKey<other.mKey || (mKey==other.mKey && mDescIndex<other.mDescIndex);
+		}
+	};
+
 	//Implements the PxControllerManager interface, this class used to be called ControllerManager
 	class CharacterControllerManager : public PxControllerManager, public PxUserAllocated, public PxDeletionListener
 	{
@@ -86,6 +120,7 @@ namespace Cct
 		virtual			PxObstacleContext*				getObstacleContext(PxU32 index)	PX_OVERRIDE	PX_FINAL;
 		virtual			PxObstacleContext*				createObstacleContext()	PX_OVERRIDE	PX_FINAL;
 		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							moveAll(PxU32 nbDescs, PxControllerMoveDesc* descs, PxCpuDispatcher* dispatcher, PxReal cellSize)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setTessellation(bool flag, float maxEdgeLength)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setOverlapRecoveryModule(bool flag)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setPreciseSweeps(bool flag)	PX_OVERRIDE	PX_FINAL;
@@ -133,7 +168,15 @@ namespace Cct
 						bool							mPreventVerticalSlidingAgainstCeiling;
 
 						bool							mLockingEnabled;						
+						bool							mMoveAllInProgress;	// Controllers can register observed objects from several threads
 	private:
+		// Scratch data for moveAll()
+						PxArray<PxExtendedBox>			mMoveAllBoxes;
+						PxArray<PxExtendedCapsule>		mMoveAllCapsules;
+						PxArray<MoveAllEntry>			mMoveAllEntries;
+						PxArray<SharedGeomCell>			mMoveAllCells;
+						PxArray<MoveAllContext*>		mMoveAllContexts;	// One per thread running the moves
+
 						ObservedRefCountMap				mObservedRefCountMap;
 						mutable	PxMutex					mWriteLock;			// Lock used for guarding pointers in observedrefcountmap
 	};
@@ -54,6 +54,7 @@ Controller::Controller(const PxControllerDesc& desc, PxScene* s) :
 	mProxyScaleCoeff		(0.0f),
 	mCollisionFlags			(0),
 	mCachedStandingOnMoving	(false),
+	mMoveAllIndex			(PX_INVALID_U32),
 	mManager				(NULL)
 {
 	mType								= PxControllerShapeType::eFORCE_DWORD;
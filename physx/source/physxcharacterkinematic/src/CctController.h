@@ -35,6 +35,7 @@
 #include "CctCharacterController.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxMutex.h"
+#include "foundation/PxArray.h"
 
 namespace physx
 {
@@ -48,6 +49,20 @@ class PxMaterial;
 namespace Cct
 {
 	class CharacterControllerManager;
+	struct SharedGeomCell;
+
+	// Per-task data for PxControllerManager::moveAll(). Controllers moved in parallel can neither share the manager's
+	// obstacle buffers nor read each other's volumes while they are being updated, so they use these instead.
+	struct MoveAllContext : public PxUserAllocated
+	{
+		const PxExtendedBox*		mCCTBoxes;			// Volumes of all controllers when moveAll() was called, indexed like the manager's array
+		const PxExtendedCapsule*	mCCTCapsules;
+		const SharedGeomCell*		mCell;				// Static geometry shared by the controllers of the current cell, or NULL
+		PxArray<const void*>		mBoxUserData;
+		PxArray<PxExtendedBox>		mBoxes;
+		PxArray<const void*>		mCapsuleUserData;
+		PxArray<PxExtendedCapsule>	mCapsules;
+	};
 
 	class Controller : public PxUserAllocated
 	{
@@ -63,6 +78,7 @@ namespace Cct
 		virtual		PxF32							getHalfHeightInternal()				const	= 0;
 		virtual		bool							getWorldBox(PxExtendedBounds3& box)	const	= 0;
 		virtual		PxController*					getPxController()							= 0;
+		virtual		PxControllerCollisionFlags		moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveAllContext* moveAllContext)	= 0;
 
 					void							onOriginShift(const PxVec3& shift);
 
@@ -98,6 +114,7 @@ namespace Cct
 					PxControllerCollisionFlags		mCollisionFlags;	// Last known collision flags (PxControllerCollisionFlag)
 					bool							mCachedStandingOnMoving;
 					bool							mRegisterDeletionListener;
+					PxU32							mMoveAllIndex;		// Index of the controller's descriptor during moveAll(), PX_INVALID_U32 otherwise
 		mutable		PxMutex							mWriteLock;			// Lock used for guarding touched pointers and cache data from overwriting 
 																			// during onRelease call.
 	protected:
@@ -108,7 +125,7 @@ namespace Cct
 					bool							setPos(const PxExtendedVec3& pos);
 					void							findTouchedObject(const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, const PxVec3& upDirection);
 					bool							rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirection, PxVec3& disp, const PxObstacleContext* obstacleContext);
-					PxControllerCollisionFlags		move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode);
+					PxControllerCollisionFlags		move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode, MoveAllContext* moveAllContext);
 					bool							filterTouchedShape(const PxControllerFilters& filters);
 
 	PX_FORCE_INLINE	float							computeTimeCoeff()
@@ -77,6 +77,7 @@ namespace Cct
 		PxRenderBuffer*			renderBuffer;	// Render buffer from controller manager, not the one from the scene
 
 		PxHashSet<PxShape*>*	cctShapeHashSet;
+		const SharedGeomCell*	sharedCell;		// Only set by PxControllerManager::moveAll()
 	};
 }
 }
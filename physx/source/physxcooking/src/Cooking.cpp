@@ -83,11 +83,21 @@ bool PxCookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& des
 	return immediateCooking::cookConvexMesh(params, desc, stream, condition);
 }
 
+bool PxCookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions, PxCookingCache* cache)
+{
+	return immediateCooking::cookConvexMeshes(params, nbMeshes, descs, streams, conditions, cache);
+}
+
 PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
 {
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
 }
 
+bool PxCreateConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::createConvexMeshes(params, nbMeshes, descs, insertionCallback, meshes, conditions);
+}
+
 bool PxValidateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	return immediateCooking::validateConvexMesh(params, desc);
@@ -113,6 +123,11 @@ bool PxCookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc&
 	return immediateCooking::cookTriangleMesh(params, desc, stream, condition);
 }
 
+bool PxCookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions, PxCookingCache* cache)
+{
+	return immediateCooking::cookTriangleMeshes(params, nbMeshes, descs, streams, conditions, cache);
+}
+
 bool PxCookTetrahedronMesh(const PxCookingParams& params, const PxTetrahedronMeshDesc& meshDesc, PxOutputStream& stream)
 {
 	return immediateCooking::cookTetrahedronMesh(params, meshDesc, stream);
@@ -0,0 +1,479 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "foundation/PxAssert.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxString.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxUtilities.h"
+#include "foundation/PxIO.h"
+#include "PxScene.h"
+#include "PxSimulationStatistics.h"
+#include "ExtChromeTraceProfiler.h"
+
+#include <stdarg.h>
+
+using namespace physx;
+using namespace Ext;
+
+static const PxU32 gMinNbEventsPerThread = 1024;
+static const PxU32 gOutputBufferSize = 65536;
+
+PX_COMPILE_TIME_ASSERT(sizeof(ChromeTraceEvent) == 40);
+
+PxChromeTraceProfiler* physx::PxChromeTraceProfilerCreate(PxOutputStream& outputStream, PxU32 maxNbThreads, PxU32 nbEventsPerThread)
+{
+	return PX_NEW(ChromeTraceProfiler)(outputStream, maxNbThreads, nbEventsPerThread);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ChromeTraceThreadBuffer::ChromeTraceThreadBuffer(PxU32 capacity, PxU32 index) :
+	mMask				(capacity - 1),
+	mIndex				(index),
+	mHead				(0),
+	mTail				(0),
+	mNbDropped			(0),
+	mZoneDepth			(0),
+	mThreadId			(PxThread::getId()),
+	mMetadataWritten	(false)
+{
+	PX_ASSERT(PxIsPowerOfTwo(capacity));
+	mEvents = PX_ALLOCATE(ChromeTraceEvent, capacity, "ChromeTraceEvent");
+}
+
+ChromeTraceThreadBuffer::~ChromeTraceThreadBuffer()
+{
+	PX_FREE(mEvents);
+}
+
+void ChromeTraceThreadBuffer::commit()
+{
+	// The event must be visible to flush() before the new head.
+	PxMemoryBarrier();
+	mHead = mHead + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ChromeTraceProfiler::ChromeTraceProfiler(PxOutputStream& outputStream, PxU32 maxNbThreads, PxU32 nbEventsPerThread) :
+	mOutputStream			(outputStream),
+	mMaxNbThreads			(PxMax(maxNbThreads, 1u)),
+	mNbThreads				(0),
+	mNbEventsPerThread		(PxNextPowerOfTwo(PxMax(nbEventsPerThread, gMinNbEventsPerThread) - 1)),
+	mNbDroppedThreadEvents	(0),
+	mNbReportedDroppedEvents(0),
+	mFirstEvent				(true)
+{
+	mTlsSlotId = PxTlsAlloc();
+
+	mThreadBuffers = PX_ALLOCATE(ChromeTraceThreadBuffer*, mMaxNbThreads, "ChromeTraceThreadBuffer");
+	for(PxU32 i=0; i<mMaxNbThreads; i++)
+		mThreadBuffers[i] = NULL;
+
+	mOutputBuffer.reserve(gOutputBufferSize);
+
+	mStartTime = PxTime::getCurrentTimeInTensOfNanoSeconds();
+
+	writeJson("{\"traceEvents\":[\n");
+	writeJson("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"PhysX\"}}");
+	mFirstEvent = false;
+	writeOutputBuffer();
+}
+
+ChromeTraceProfiler::~ChromeTraceProfiler()
+{
+	flush();
+
+	writeJson("\n],\"displayTimeUnit\":\"ns\"}\n");
+	writeOutputBuffer();
+
+	for(PxU32 i=0; i<mMaxNbThreads; i++)
+		PX_DELETE(mThreadBuffers[i]);
+	PX_FREE(mThreadBuffers);
+
+	PxTlsFree(mTlsSlotId);
+}
+
+void ChromeTraceProfiler::release()
+{
+	PX_DELETE_THIS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The TLS slot stores the thread index + 1, so that threads above the limit are only registered once.
+ChromeTraceThreadBuffer* ChromeTraceProfiler::getThreadBuffer()
+{
+	size_t slot = PxTlsGetValue(mTlsSlotId);
+	if(!slot)
+	{
+		const PxU32 index = PxU32(PxAtomicIncrement(&mNbThreads) - 1);
+		if(index < mMaxNbThreads)
+		{
+			ChromeTraceThreadBuffer* buffer = PX_NEW(ChromeTraceThreadBuffer)(mNbEventsPerThread, index);
+			PxMemoryBarrier();
+			mThreadBuffers[index] = buffer;
+		}
+		slot = size_t(index) + 1;
+		PxTlsSetValue(mTlsSlotId, slot);
+	}
+
+	return slot <= mMaxNbThreads ? mThreadBuffers[slot - 1] : NULL;
+}
+
+void ChromeTraceProfiler::writeEvent(PxU32 type, const char* name, PxU64 data, PxU64 contextId)
+{
+	ChromeTraceThreadBuffer* buffer = getThreadBuffer();
+	if(!buffer)
+	{
+		PxAtomicIncrement(&mNbDroppedThreadEvents);
+		return;
+	}
+
+	ChromeTraceEvent* event = buffer->reserve();
+	if(event)
+	{
+		event->mTime = PxTime::getCurrentTimeInTensOfNanoSeconds();
+		event->mData = data;
+		event->mName = name;
+		event->mContextId = contextId;
+		event->mType = type;
+		event->mPadding = 0;
+		buffer->commit();
+	}
+}
+
+void* ChromeTraceProfiler::zoneStart(const char* eventName, bool detached, uint64_t contextId)
+{
+	if(detached)
+	{
+		writeEvent(ChromeTraceEventType::eASYNC_BEGIN, eventName, 0, contextId);
+		return NULL;
+	}
+
+	ChromeTraceThreadBuffer* buffer = getThreadBuffer();
+	if(buffer)
+	{
+		// Zones are written when they end, as complete events. Zones nested deeper than the stack are dropped in zoneEnd.
+		const PxU32 depth = buffer->mZoneDepth++;
+		if(depth < CHROME_TRACE_MAX_ZONE_DEPTH)
+		{
+			buffer->mZoneStack[depth].mTime = PxTime::getCurrentTimeInTensOfNanoSeconds();
+			buffer->mZoneStack[depth].mName = eventName;
+		}
+	}
+	return NULL;
+}
+
+void ChromeTraceProfiler::zoneEnd(void*, const char* eventName, bool detached, uint64_t contextId)
+{
+	if(detached)
+	{
+		writeEvent(ChromeTraceEventType::eASYNC_END, eventName, 0, contextId);
+		return;
+	}
+
+	ChromeTraceThreadBuffer* buffer = getThreadBuffer();
+	if(!buffer)
+	{
+		PxAtomicIncrement(&mNbDroppedThreadEvents);
+		return;
+	}
+
+	if(!buffer->mZoneDepth)
+		return;	// Unbalanced zoneEnd, e.g. the profiler was set while a zone was open.
+
+	const PxU32 depth = --buffer->mZoneDepth;
+	if(depth >= CHROME_TRACE_MAX_ZONE_DEPTH)
+	{
+		buffer->mNbDropped = buffer->mNbDropped + 1;
+		return;
+	}
+
+	const ChromeTraceThreadBuffer::ZoneStart& start = buffer->mZoneStack[depth];
+	PX_ASSERT(start.mName == eventName || Pxstrcmp(start.mName, eventName) == 0);
+	PX_UNUSED(eventName);
+
+	ChromeTraceEvent* event = buffer->reserve();
+	if(event)
+	{
+		const PxU64 time = PxTime::getCurrentTimeInTensOfNanoSeconds();
+		event->mTime = start.mTime;
+		event->mData = time - start.mTime;
+		event->mName = start.mName;
+		event->mContextId = contextId;
+		event->mType = ChromeTraceEventType::eZONE;
+		event->mPadding = 0;
+		buffer->commit();
+	}
+}
+
+void ChromeTraceProfiler::recordData(int32_t value, const char* valueName, uint64_t contextId)
+{
+	writeEvent(ChromeTraceEventType::eVALUE_INT, valueName, PxU64(PxI64(value)), contextId);
+}
+
+void ChromeTraceProfiler::recordData(float value, const char* valueName, uint64_t contextId)
+{
+	PxU32 bits;
+	PxMemCopy(&bits, &value, sizeof(PxU32));
+	writeEvent(ChromeTraceEventType::eVALUE_FLOAT, valueName, bits, contextId);
+}
+
+void ChromeTraceProfiler::recordFrame(const char* name, uint64_t contextId)
+{
+	writeEvent(ChromeTraceEventType::eFRAME, name, 0, contextId);
+}
+
+namespace
+{
+	struct StatisticsCounter
+	{
+		const char*	mName;
+		PxU32		mOffset;
+	};
+}
+
+#define STATISTICS_COUNTER(x)	{ "PxSimulationStatistics." #x, PxU32(PX_OFFSET_OF(PxSimulationStatistics, x)) }
+
+static const StatisticsCounter gStatisticsCounters[] =
+{
+	STATISTICS_COUNTER(nbActiveConstraints),
+	STATISTICS_COUNTER(nbActiveDynamicBodies),
+	STATISTICS_COUNTER(nbActiveKinematicBodies),
+	STATISTICS_COUNTER(nbStaticBodies),
+	STATISTICS_COUNTER(nbDynamicBodies),
+	STATISTICS_COUNTER(nbKinematicBodies),
+	STATISTICS_COUNTER(nbAggregates),
+	STATISTICS_COUNTER(nbArticulations),
+	STATISTICS_COUNTER(nbAxisSolverConstraints),
+	STATISTICS_COUNTER(compressedContactSize),
+	STATISTICS_COUNTER(requiredContactConstraintMemory),
+	STATISTICS_COUNTER(peakConstraintMemory),
+	STATISTICS_COUNTER(nbDiscreteContactPairsTotal),
+	STATISTICS_COUNTER(nbDiscreteContactPairsWithCacheHits),
+	STATISTICS_COUNTER(nbDiscreteContactPairsWithContacts),
+	STATISTICS_COUNTER(nbNewPairs),
+	STATISTICS_COUNTER(nbLostPairs),
+	STATISTICS_COUNTER(nbNewTouches),
+	STATISTICS_COUNTER(nbLostTouches),
+	STATISTICS_COUNTER(nbPartitions),
+	STATISTICS_COUNTER(nbBroadPhaseAdds),
+	STATISTICS_COUNTER(nbBroadPhaseRemoves),
+};
+
+#undef STATISTICS_COUNTER
+
+void ChromeTraceProfiler::recordSimulationStatistics(const PxScene& scene)
+{
+	PxSimulationStatistics stats;
+	scene.getSimulationStatistics(stats);
+
+	const PxU64 contextId = PxU64(size_t(&scene));
+	const PxU8* data = reinterpret_cast<const PxU8*>(&stats);
+	for(PxU32 i=0; i<PX_ARRAY_SIZE(gStatisticsCounters); i++)
+	{
+		PxU32 value;
+		PxMemCopy(&value, data + gStatisticsCounters[i].mOffset, sizeof(PxU32));
+		writeEvent(ChromeTraceEventType::eVALUE_INT, gStatisticsCounters[i].mName, value, contextId);
+	}
+}
+
+PxU64 ChromeTraceProfiler::getNbDroppedEvents() const
+{
+	PxU64 nbDropped = PxU64(PxU32(mNbDroppedThreadEvents));
+	const PxU32 nbThreads = PxMin(PxU32(mNbThreads), mMaxNbThreads);
+	for(PxU32 i=0; i<nbThreads; i++)
+	{
+		const ChromeTraceThreadBuffer* buffer = mThreadBuffers[i];
+		if(buffer)
+			nbDropped += buffer->mNbDropped;
+	}
+	return nbDropped;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ChromeTraceProfiler::writeOutputBuffer()
+{
+	if(mOutputBuffer.size())
+	{
+		mOutputStream.write(mOutputBuffer.begin(), mOutputBuffer.size());
+		mOutputBuffer.forceSize_Unsafe(0);
+	}
+}
+
+void ChromeTraceProfiler::writeJson(const char* format, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, format);
+	const PxI32 length = Pxvsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	PX_ASSERT(length >= 0 && PxU32(length) < sizeof(buffer));
+
+	const PxU32 size = mOutputBuffer.size();
+	mOutputBuffer.resizeUninitialized(size + PxU32(length));
+	PxMemCopy(mOutputBuffer.begin() + size, buffer, PxU32(length));
+
+	if(mOutputBuffer.size() >= gOutputBufferSize)
+		writeOutputBuffer();
+}
+
+// Returns the JSON string for a name, escaped and quoted. Names are interned, so this is only done once per name.
+const char* ChromeTraceProfiler::getJsonName(const char* name)
+{
+	if(!name)
+		name = "(null)";
+
+	const PxHashMap<const char*, PxU32>::Entry* entry = mJsonNames.find(name);
+	if(entry)
+		return mJsonNameData.begin() + entry->second;
+
+	const PxU32 offset = mJsonNameData.size();
+	mJsonNameData.pushBack('"');
+	for(const char* c = name; *c; c++)
+	{
+		const unsigned char ch = static_cast<unsigned char>(*c);
+		if(ch == '"' || ch == '\\')
+		{
+			mJsonNameData.pushBack('\\');
+			mJsonNameData.pushBack(char(ch));
+		}
+		else if(ch < 0x20)
+		{
+			char escaped[8];
+			Pxsnprintf(escaped, sizeof(escaped), "\\u%04x", PxU32(ch));
+			for(PxU32 i=0; i<6; i++)
+				mJsonNameData.pushBack(escaped[i]);
+		}
+		else
+			mJsonNameData.pushBack(char(ch));
+
+		// Keep the names short enough for writeJson's buffer.
+		if(mJsonNameData.size() - offset >= 256)
+			break;
+	}
+	mJsonNameData.pushBack('"');
+	mJsonNameData.pushBack('\0');
+
+	mJsonNames.insert(name, offset);
+	return mJsonNameData.begin() + offset;
+}
+
+void ChromeTraceProfiler::writeJsonEvent(const ChromeTraceEvent& event, PxU32 tid)
+{
+	// Timestamps are in microseconds, relative to the creation of the profiler.
+	const PxU64 time = event.mTime > mStartTime ? event.mTime - mStartTime : 0;
+	const unsigned long long us = (unsigned long long)(time / 100);
+	const PxU32 fraction = PxU32(time % 100);
+	const char* name = getJsonName(event.mName);
+
+	switch(event.mType)
+	{
+	case ChromeTraceEventType::eZONE:
+		writeJson(",\n{\"name\":%s,\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%llu.%02u,\"dur\":%llu.%02u,\"args\":{\"contextId\":%llu}}",
+			name, tid, us, fraction, (unsigned long long)(event.mData / 100), PxU32(event.mData % 100), (unsigned long long)event.mContextId);
+		break;
+	case ChromeTraceEventType::eASYNC_BEGIN:
+	case ChromeTraceEventType::eASYNC_END:
+		writeJson(",\n{\"name\":%s,\"cat\":\"PhysX\",\"ph\":\"%c\",\"id\":\"0x%llx\",\"pid\":0,\"tid\":%u,\"ts\":%llu.%02u}",
+			name, event.mType == ChromeTraceEventType::eASYNC_BEGIN ? 'b' : 'e', (unsigned long long)event.mContextId, tid, us, fraction);
+		break;
+	case ChromeTraceEventType::eVALUE_INT:
+		writeJson(",\n{\"name\":%s,\"ph\":\"C\",\"pid\":0,\"ts\":%llu.%02u,\"args\":{\"value\":%lld}}",
+			name, us, fraction, (long long)PxI64(event.mData));
+		break;
+	case ChromeTraceEventType::eVALUE_FLOAT:
+	{
+		const PxU32 bits = PxU32(event.mData);
+		float value;
+		PxMemCopy(&value, &bits, sizeof(float));
+		if(!PxIsFinite(value))
+			value = 0.0f;	// Not representable in JSON
+		writeJson(",\n{\"name\":%s,\"ph\":\"C\",\"pid\":0,\"ts\":%llu.%02u,\"args\":{\"value\":%.9g}}",
+			name, us, fraction, double(value));
+	}
+	break;
+	case ChromeTraceEventType::eFRAME:
+		writeJson(",\n{\"name\":%s,\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%u,\"ts\":%llu.%02u}",
+			name, tid, us, fraction);
+		break;
+	default:
+		PX_ASSERT(0);
+		break;
+	}
+}
+
+void ChromeTraceProfiler::flush()
+{
+	PxMutex::ScopedLock lock(mFlushMutex);
+
+	const PxU32 nbThreads = PxMin(PxU32(mNbThreads), mMaxNbThreads);
+	for(PxU32 i=0; i<nbThreads; i++)
+	{
+		ChromeTraceThreadBuffer* buffer = mThreadBuffers[i];
+		if(!buffer)
+			continue;	// Still being registered
+
+		if(!buffer->mMetadataWritten)
+		{
+			writeJson(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %llu\"}}",
+				buffer->mIndex, (unsigned long long)buffer->mThreadId);
+			buffer->mMetadataWritten = true;
+		}
+
+		// Events up to head are complete, see ChromeTraceThreadBuffer::commit. The owner thread can keep recording
+		// while we read, it only reuses the slots once the new tail is published.
+		const PxU32 head = buffer->mHead;
+		PxMemoryBarrier();
+		for(PxU32 index = buffer->mTail; index != head; index++)
+			writeJsonEvent(buffer->mEvents[index & buffer->mMask], buffer->mIndex);
+		PxMemoryBarrier();
+		buffer->mTail = head;
+	}
+
+	const PxU64 nbDropped = getNbDroppedEvents();
+	if(nbDropped != mNbReportedDroppedEvents)
+	{
+		ChromeTraceEvent event;
+		event.mTime = PxTime::getCurrentTimeInTensOfNanoSeconds();
+		event.mData = nbDropped;
+		event.mName = "PxChromeTraceProfiler.droppedEvents";
+		event.mContextId = 0;
+		event.mType = ChromeTraceEventType::eVALUE_INT;
+		event.mPadding = 0;
+		writeJsonEvent(event, 0);
+		mNbReportedDroppedEvents = nbDropped;
+	}
+
+	writeOutputBuffer();
+}
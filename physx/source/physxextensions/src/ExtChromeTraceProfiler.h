@@ -0,0 +1,167 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef EXT_CHROME_TRACE_PROFILER_H
+#define EXT_CHROME_TRACE_PROFILER_H
+
+#include "extensions/PxChromeTraceProfiler.h"
+
+#include "foundation/PxHashMap.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+
+#define CHROME_TRACE_MAX_ZONE_DEPTH		64
+
+namespace physx
+{
+namespace Ext
+{
+
+struct ChromeTraceEventType
+{
+	enum Enum
+	{
+		eZONE,				// Complete event: mTime is the start time, mData the duration
+		eASYNC_BEGIN,
+		eASYNC_END,
+		eVALUE_INT,
+		eVALUE_FLOAT,
+		eFRAME
+	};
+};
+
+struct ChromeTraceEvent
+{
+	PxU64		mTime;		// In tens of nanoseconds
+	PxU64		mData;		// Duration, or value
+	const char*	mName;
+	PxU64		mContextId;
+	PxU32		mType;		// ChromeTraceEventType
+	PxU32		mPadding;
+};
+
+// Single-producer / single-consumer ring buffer. Events are written by the owner thread only, and read by flush() only.
+class ChromeTraceThreadBuffer : public PxUserAllocated
+{
+	PX_NOCOPY(ChromeTraceThreadBuffer)
+public:
+	ChromeTraceThreadBuffer(PxU32 capacity, PxU32 index);
+	~ChromeTraceThreadBuffer();
+
+	struct ZoneStart
+	{
+		PxU64		mTime;
+		const char*	mName;
+	};
+
+	ChromeTraceEvent*	mEvents;
+	const PxU32			mMask;
+	const PxU32			mIndex;			// Used as tid in the trace
+	volatile PxU32		mHead;			// Written by the owner thread
+	volatile PxU32		mTail;			// Written by flush()
+	volatile PxU32		mNbDropped;		// Written by the owner thread
+	PxU32				mZoneDepth;		// Owner thread only
+	ZoneStart			mZoneStack[CHROME_TRACE_MAX_ZONE_DEPTH];
+	PxU64				mThreadId;
+	bool				mMetadataWritten;	// flush() only
+
+	PX_FORCE_INLINE	ChromeTraceEvent* reserve()
+	{
+		const PxU32 head = mHead;
+		if(head - mTail > mMask)
+		{
+			mNbDropped = mNbDropped + 1;
+			return NULL;
+		}
+		return mEvents + (head & mMask);
+	}
+
+	void	commit();
+};
+
+class ChromeTraceProfiler : public PxChromeTraceProfiler, public PxUserAllocated
+{
+	PX_NOCOPY(ChromeTraceProfiler)
+
+private:
+	~ChromeTraceProfiler();
+
+public:
+	ChromeTraceProfiler(PxOutputStream& outputStream, PxU32 maxNbThreads, PxU32 nbEventsPerThread);
+
+	// PxDefaultProfiler
+	virtual void release() PX_OVERRIDE;
+	virtual void flush() PX_OVERRIDE;
+	//~PxDefaultProfiler
+
+	// PxProfilerCallback
+	virtual void* zoneStart(const char* eventName, bool detached, uint64_t contextId) PX_OVERRIDE;
+	virtual void zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId) PX_OVERRIDE;
+	virtual void recordData(int32_t value, const char* valueName, uint64_t contextId) PX_OVERRIDE;
+	virtual void recordData(float value, const char* valueName, uint64_t contextId) PX_OVERRIDE;
+	virtual void recordFrame(const char* name, uint64_t contextId) PX_OVERRIDE;
+	//~PxProfilerCallback
+
+	// PxChromeTraceProfiler
+	virtual void recordSimulationStatistics(const PxScene& scene) PX_OVERRIDE;
+	virtual PxU64 getNbDroppedEvents() const PX_OVERRIDE;
+	//~PxChromeTraceProfiler
+
+protected:
+	ChromeTraceThreadBuffer*	getThreadBuffer();
+	void						writeEvent(PxU32 type, const char* name, PxU64 data, PxU64 contextId);
+
+	// Flush-side helpers, called with mFlushMutex locked.
+	const char*					getJsonName(const char* name);
+	void						writeJsonEvent(const ChromeTraceEvent& event, PxU32 tid);
+	void						writeJson(const char* format, ...);
+	void						writeOutputBuffer();
+
+	PxOutputStream&					mOutputStream;
+
+	// Thread buffers. Registered lock-free, never removed.
+	ChromeTraceThreadBuffer**		mThreadBuffers;
+	const PxU32						mMaxNbThreads;
+	volatile PxI32					mNbThreads;
+	const PxU32						mNbEventsPerThread;
+	PxU32							mTlsSlotId;
+	volatile PxI32					mNbDroppedThreadEvents;	// Events from threads above mMaxNbThreads
+
+	// Flush-side data.
+	PxMutex							mFlushMutex;
+	PxHashMap<const char*, PxU32>	mJsonNames;				// Interned names, as offsets in mJsonNameData
+	PxArray<char>					mJsonNameData;
+	PxArray<char>					mOutputBuffer;
+	PxU64							mNbReportedDroppedEvents;
+	PxU64							mStartTime;
+	bool							mFirstEvent;
+};
+
+} // namespace Ext
+}
+
+#endif
@@ -30,10 +30,11 @@
 #include "ExtCpuWorkerThread.h"
 #include "ExtDefaultCpuDispatcher.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxTempAllocator.h"
 
 using namespace physx;
 
-Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0)
+Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0), mRandomState(0)
 {
 }
 
@@ -44,11 +45,21 @@ Ext::CpuWorkerThread::~CpuWorkerThread()
 #define HighPriority	true
 #define RegularPriority	false
 
+// Number of failed search rounds before an idle worker parks itself, in work-stealing mode
+#define DEFAULT_WORK_STEALING_SPIN_COUNT	256
+
 void Ext::CpuWorkerThread::execute()
 {
 	mThreadId = getId();
 
+	PxTempAllocatorAcquireThreadCache();
+
 	const PxDefaultCpuDispatcherWaitForWorkMode::Enum ownerWaitForWorkMode = mOwner->getWaitForWorkMode();
+	if(PxDefaultCpuDispatcherWaitForWorkMode::eWORK_STEALING == ownerWaitForWorkMode)
+	{
+		executeWorkStealing();
+		return;
+	}
 
 	while(!quitIsSignalled())
     {
@@ -88,5 +99,76 @@ void Ext::CpuWorkerThread::execute()
 		}
 	}
 
+	PxTempAllocatorReleaseThreadCache();
+
+	quit();
+}
+
+PxBaseTask* Ext::CpuWorkerThread::fetchWorkStealing()
+{
+	// High priority tasks first, then our own deque (LIFO), then the shared queue, then steal (FIFO)
+	PxBaseTask* task = mOwner->fetchSharedTask(HighPriority);
+	if(!task)
+		task = popLocalJob();
+	if(!task)
+		task = mOwner->fetchSharedTask(RegularPriority);
+	if(!task)
+	{
+		// xorshift32, randomized victim selection avoids all idle threads hammering the same deque
+		PxU32 x = mRandomState;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		mRandomState = x;
+		task = mOwner->stealTask(this, x);
+	}
+	return task;
+}
+
+void Ext::CpuWorkerThread::executeWorkStealing()
+{
+	// Any non-zero seed works, make it different per thread
+	mRandomState = PxU32(size_t(this) >> 4) | 1;
+
+	PxTlsSet(mOwner->getTlsIndex(), this);
+
+	const PxU32 yieldCount = mOwner->getYieldProcessorCount();
+	const PxU32 spinCount = yieldCount ? yieldCount : DEFAULT_WORK_STEALING_SPIN_COUNT;
+	PxU32 nbFailedRounds = 0;
+
+	while(!quitIsSignalled())
+	{
+		PxBaseTask* task = fetchWorkStealing();
+		if(!task)
+		{
+			if(++nbFailedRounds < spinCount)
+			{
+				PxThread::yieldProcesor();
+				continue;
+			}
+			nbFailedRounds = 0;
+
+			// Park. We must look for work again after registering as parked, otherwise a task
+			// submitted between the last fetch and the wait could be missed (see submitTaskWorkStealing).
+			mOwner->resetWakeSignal();
+			mOwner->parkWorker();
+			task = fetchWorkStealing();
+			if(!task)
+				mOwner->waitForWork();
+			mOwner->unparkWorker();
+		}
+
+		if(task)
+		{
+			nbFailedRounds = 0;
+			mOwner->runTask(*task);
+			task->release();
+		}
+	}
+
+	PxTlsSet(mOwner->getTlsIndex(), NULL);
+
+	PxTempAllocatorReleaseThreadCache();
+
 	quit();
 }
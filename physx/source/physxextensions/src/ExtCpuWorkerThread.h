@@ -32,6 +32,7 @@
 #include "foundation/PxThread.h"
 #include "ExtTaskQueueHelper.h"
 #include "ExtSharedQueueEntryPool.h"
+#include "ExtWorkStealingDeque.h"
 
 namespace physx
 {
@@ -56,6 +57,11 @@ class DefaultCpuDispatcher;
 		template<const bool highPriorityT>
 		PX_FORCE_INLINE	PxBaseTask*				getJob()	{ return mHelper.fetchTask<highPriorityT>();	}
 
+		// Work-stealing mode. Only the owner thread pushes & pops, other workers steal.
+		PX_FORCE_INLINE	bool					pushLocalJob(PxBaseTask& task)	{ return mDeque.push(task);	}
+		PX_FORCE_INLINE	PxBaseTask*				popLocalJob()					{ return mDeque.pop();		}
+		PX_FORCE_INLINE	PxBaseTask*				stealJob()						{ return mDeque.steal();	}
+
 						void					execute();
 
 		PX_FORCE_INLINE	bool					tryAcceptJobToLocalQueue(PxBaseTask& task, PxThread::Id taskSubmitionThread)
@@ -65,9 +71,14 @@ class DefaultCpuDispatcher;
 													return false;
 												}
 	protected:
+						void					executeWorkStealing();
+						PxBaseTask*				fetchWorkStealing();
+
 						DefaultCpuDispatcher*	mOwner;
 						TaskQueueHelper			mHelper;
+						WorkStealingDeque		mDeque;
 						PxThread::Id			mThreadId;
+						PxU32					mRandomState;
 	};
 
 #if PX_VC
@@ -78,6 +78,9 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
+// Revisit the switch below (and the one in NpSceneQueries) when adding a pruning structure type
+PX_COMPILE_TIME_ASSERT(PxPruningStructureType::eLAST == 5);
+
 static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
 {
 //	if(0)
@@ -92,6 +95,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
 		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
 		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
+		case PxPruningStructureType::eSTATIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -202,11 +207,12 @@ namespace
 	{
 		public:
 												CustomPxSQ(const PxCustomSceneQuerySystemAdapter& adapter, ExtPVDCapture* pvd, PxU64 contextID,
-													PxSceneQueryUpdateMode::Enum mode, bool usesTreeOfPruners) :
-													mExtAdapter	(adapter),
-													mQueries	(pvd, contextID, EXT_PRUNER_EPSILON, mExtAdapter, usesTreeOfPruners),
-													mUpdateMode	(mode),
-													mRefCount	(1)
+													PxSceneQueryUpdateMode::Enum mode, bool usesTreeOfPruners, PxCpuDispatcher* treeBuildDispatcher) :
+													mExtAdapter				(adapter),
+													mQueries				(pvd, contextID, EXT_PRUNER_EPSILON, mExtAdapter, usesTreeOfPruners),
+													mUpdateMode				(mode),
+													mTreeBuildDispatcher	(treeBuildDispatcher),
+													mRefCount				(1)
 													{}
 		virtual									~CustomPxSQ()	{}
 
@@ -262,6 +268,7 @@ namespace
 				ExtSqAdapter					mExtAdapter;
 				ExtSceneQueries					mQueries;
 				PxSceneQueryUpdateMode::Enum	mUpdateMode;
+				PxCpuDispatcher*				mTreeBuildDispatcher;
 				PxU32							mRefCount;
 	};
 }
@@ -478,6 +485,8 @@ void CustomPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const
 PxU32 CustomPxSQ::addPruner(PxPruningStructureType::Enum primaryType, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxU32 preallocated)
 {
 	Pruner* pruner = create(primaryType, mQueries.getContextId(), secondaryType, PxBVHBuildStrategy::eFAST, 4);
+	if(pruner && mTreeBuildDispatcher)
+		pruner->setBuildDispatcher(mTreeBuildDispatcher);
 	return mQueries.mSQManager.addPruner(pruner, preallocated);
 }
 
@@ -498,10 +507,10 @@ void CustomPxSQ::finishCustomBuildstep()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-PxCustomSceneQuerySystem* physx::PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners)
+PxCustomSceneQuerySystem* physx::PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners, PxCpuDispatcher* treeBuildDispatcher)
 {
 	ExtPVDCapture* pvd = NULL;
-	CustomPxSQ* pxsq = PX_NEW(CustomPxSQ)(adapter, pvd, contextID, sceneQueryUpdateMode, usesTreeOfPruners);
+	CustomPxSQ* pxsq = PX_NEW(CustomPxSQ)(adapter, pvd, contextID, sceneQueryUpdateMode, usesTreeOfPruners, treeBuildDispatcher);
 
 	addExternalSQ(pxsq);
 
@@ -0,0 +1,106 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "extensions/PxDefaultCookingCache.h"
+#include "extensions/PxDefaultStreams.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxString.h"
+#include "foundation/PxThread.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace physx;
+
+// Big enough for the separator, the 32 hex digits of the key and the longest extension
+#define MAX_FILENAME_SUFFIX	64
+
+PxDefaultCookingCache::PxDefaultCookingCache(const char* directory)
+{
+	const PxU32 length = PxU32(strlen(directory));
+	mDirectory.resize(length + 1);
+	PxMemCopy(mDirectory.begin(), directory, length + 1);
+}
+
+PxDefaultCookingCache::~PxDefaultCookingCache()
+{
+}
+
+void PxDefaultCookingCache::getFilename(PxArray<char>& filename, const PxCookingCacheKey& key, const char* extension) const
+{
+	const PxU32 size = mDirectory.size() + MAX_FILENAME_SUFFIX;
+	filename.resize(size);
+	Pxsnprintf(filename.begin(), size, "%s/%08x%08x%08x%08x%s", mDirectory.begin(),
+		PxU32(key.hash[0]>>32), PxU32(key.hash[0]), PxU32(key.hash[1]>>32), PxU32(key.hash[1]), extension);
+}
+
+bool PxDefaultCookingCache::load(const PxCookingCacheKey& key, PxOutputStream& stream)
+{
+	PxArray<char> filename;
+	getFilename(filename, key, ".bin");
+
+	PxDefaultFileInputData file(filename.begin());
+	if(!file.isValid())
+		return false;
+
+	PxU8 buffer[4096];
+	PxU32 remaining = file.getLength();
+	while(remaining)
+	{
+		const PxU32 size = file.read(buffer, PxMin(remaining, PxU32(sizeof(buffer))));
+		if(!size)
+			return false;
+		stream.write(buffer, size);
+		remaining -= size;
+	}
+	return true;
+}
+
+void PxDefaultCookingCache::store(const PxCookingCacheKey& key, const void* data, PxU32 size)
+{
+	PxArray<char> filename;
+	getFilename(filename, key, ".bin");
+
+	// The thread id makes the temporary name unique among the threads storing the same entry
+	char extension[MAX_FILENAME_SUFFIX/2];
+	Pxsnprintf(extension, sizeof(extension), ".%llx.tmp", static_cast<unsigned long long>(PxThread::getId()));
+
+	PxArray<char> tmpFilename;
+	getFilename(tmpFilename, key, extension);
+
+	bool written;
+	{
+		PxDefaultFileOutputStream file(tmpFilename.begin());
+		written = file.isValid() && file.write(data, size)==size;
+	}
+
+	// If the rename fails, another thread already stored the same data
+	if(!written || rename(tmpFilename.begin(), filename.begin()))
+		remove(tmpFilename.begin());
+}
@@ -48,7 +48,7 @@ void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 thr
 }
 #endif
 
-Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount) : mNumThreads(numThreads), mShuttingDown(false)
+Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount) : mNumThreads(numThreads), mTlsIndex(0xffffffff), mNbParkedThreads(0), mShuttingDown(false)
 #if PX_PROFILE
 	,mRunProfiled(true)
 #else
@@ -58,7 +58,12 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 	, mYieldProcessorCount(yieldProcessorCount)
 {
 	PX_CHECK_MSG((((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode) && (mYieldProcessorCount > 0)) ||
-					(((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode) || (PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)) && (0 == mYieldProcessorCount))), "Illegal yield processor count for chosen execute mode");
+					(((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode) || (PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)) && (0 == mYieldProcessorCount)) ||
+					(PxDefaultCpuDispatcherWaitForWorkMode::eWORK_STEALING == mWaitForWorkMode)), "Illegal yield processor count for chosen execute mode");
+
+	// In work-stealing mode workers register themselves in TLS so that submitTask() can find the local deque without a search
+	if(PxDefaultCpuDispatcherWaitForWorkMode::eWORK_STEALING == mWaitForWorkMode)
+		mTlsIndex = PxTlsAlloc();
 
 	PxU32* defaultAffinityMasks = NULL;
 
@@ -110,7 +115,7 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 		mWorkerThreads[i].signalQuit();
 
 	mShuttingDown = true;
-	if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+	if(usesWakeSignal())
 		mWorkReady.set();
 	for(PxU32 i = 0; i < mNumThreads; ++i)
 		mWorkerThreads[i].waitForQuit();
@@ -120,6 +125,9 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 
 	PX_FREE(mWorkerThreads);
 	PX_FREE(mThreadNames);
+
+	if(mTlsIndex != 0xffffffff)
+		PxTlsFree(mTlsIndex);
 }
 
 void Ext::DefaultCpuDispatcher::release()
@@ -137,6 +145,12 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 		return;
 	}	
 
+	if(PxDefaultCpuDispatcherWaitForWorkMode::eWORK_STEALING == mWaitForWorkMode)
+	{
+		submitTaskWorkStealing(task);
+		return;
+	}
+
 	// TODO: Could use TLS to make this more efficient
 	const PxThread::Id currentThread = PxThread::getId();
 	const PxU32 nbThreads = mNumThreads;
@@ -159,9 +173,45 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 	}
 }
 
+void Ext::DefaultCpuDispatcher::submitTaskWorkStealing(PxBaseTask& task)
+{
+	CpuWorkerThread* worker = reinterpret_cast<CpuWorkerThread*>(PxTlsGet(mTlsIndex));
+
+	// High priority tasks always go to the shared queue, which all workers check first. Regular tasks
+	// spawned by a worker stay in its deque, where they are popped LIFO while the data is still in cache.
+	bool accepted = false;
+	if(worker && !task.isHighPriority())
+		accepted = worker->pushLocalJob(task);
+
+	if(!accepted)
+		mHelper.tryAcceptJobToQueue(task);
+
+	// Only pay for the wake-up when somebody is actually parked. The barrier pairs with the
+	// increment in parkWorker(): either the parked thread sees the new task or we see the parked thread.
+	PxMemoryBarrier();
+	if(mNbParkedThreads)
+		mWorkReady.set();
+}
+
+PxBaseTask* Ext::DefaultCpuDispatcher::stealTask(const CpuWorkerThread* thief, PxU32 startIndex)
+{
+	const PxU32 nbThreads = mNumThreads;
+	for(PxU32 i=0; i<nbThreads; ++i)
+	{
+		CpuWorkerThread& victim = mWorkerThreads[(startIndex + i) % nbThreads];
+		if(&victim == thief)
+			continue;
+
+		PxBaseTask* task = victim.stealJob();
+		if(task)
+			return task;
+	}
+	return NULL;
+}
+
 void Ext::DefaultCpuDispatcher::resetWakeSignal()
 {
-	PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode);
+	PX_ASSERT(usesWakeSignal());
 	mWorkReady.reset();
 	
 	// The code below is necessary to avoid deadlocks on shut down.
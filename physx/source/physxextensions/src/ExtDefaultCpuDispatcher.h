@@ -97,20 +97,42 @@ namespace Ext
 																				task.run();
 																		}
 
-    					void											waitForWork()						{ PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode); mWorkReady.wait(); }
+		// Work-stealing mode. High priority tasks and tasks submitted from external threads go to the shared queue,
+		// everything else goes to the submitting worker's deque. Idle workers steal from randomly selected victims.
+		PX_FORCE_INLINE	PxBaseTask*										fetchSharedTask(bool highPriority)
+																		{
+																			return highPriority ? mHelper.fetchTask<true>() : mHelper.fetchTask<false>();
+																		}
+
+						PxBaseTask*										stealTask(const CpuWorkerThread* thief, PxU32 startIndex);
+
+		PX_FORCE_INLINE	void											parkWorker()						{ PxAtomicIncrement(&mNbParkedThreads);	}
+		PX_FORCE_INLINE	void											unparkWorker()						{ PxAtomicDecrement(&mNbParkedThreads);	}
+		PX_FORCE_INLINE	PxU32											getTlsIndex()		const			{ return mTlsIndex;				}
+
+    					void											waitForWork()						{ PX_ASSERT(usesWakeSignal()); mWorkReady.wait(); }
 						void											resetWakeSignal();
 
 		static			void											getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount);
 
 		PX_FORCE_INLINE	PxDefaultCpuDispatcherWaitForWorkMode::Enum		getWaitForWorkMode()		const	{ return mWaitForWorkMode;		}
 		PX_FORCE_INLINE	PxU32											getYieldProcessorCount()	const	{ return mYieldProcessorCount;	}
+		PX_FORCE_INLINE	bool											usesWakeSignal()			const
+																		{
+																			return mWaitForWorkMode == PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK
+																				|| mWaitForWorkMode == PxDefaultCpuDispatcherWaitForWorkMode::eWORK_STEALING;
+																		}
 
 	protected:
+						void											submitTaskWorkStealing(PxBaseTask& task);
+
 						CpuWorkerThread*								mWorkerThreads;
 						TaskQueueHelper									mHelper;
 						PxSync											mWorkReady;
 						PxU8*											mThreadNames;
 						PxU32											mNumThreads;
+						PxU32											mTlsIndex;
+						volatile PxI32									mNbParkedThreads;
 						bool											mShuttingDown;
 						bool											mRunProfiled;
 		const			PxDefaultCpuDispatcherWaitForWorkMode::Enum		mWaitForWorkMode;
@@ -31,6 +31,10 @@
 #include "foundation/PxAllocatorCallback.h"
 #include "CmUtils.h"
 #include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "task/PxCpuDispatcher.h"
+#include "task/PxParallelFor.h"
 
 using namespace physx;
 
@@ -250,6 +254,43 @@ struct NpOverflowBuffer : PxHitBuffer<HitType>
 	}
 };
 
+class ExtBatchQuery;
+
+// Task running a range of the queued queries of one type for PxBatchQueryExt::executeAsync().
+class ExtBatchQueryChunk : public PxBaseTask
+{
+public:
+	enum Type
+	{
+		eRAYCAST,
+		eSWEEP,
+		eOVERLAP
+	};
+
+	ExtBatchQueryChunk(ExtBatchQuery* owner, PxU32 type, PxU32 start, PxU32 nbQueries, PxU32 scratchStart, PxU32 nbScratchTouches) :
+		mOwner				(owner),
+		mType				(type),
+		mStart				(start),
+		mNbQueries			(nbQueries),
+		mScratchStart		(scratchStart),
+		mNbScratchTouches	(nbScratchTouches)
+	{
+	}
+
+	virtual void		run();
+	virtual void		release();
+	virtual const char*	getName()		const	{ return "PxBatchQueryExt.executeChunk";	}
+	virtual void		addReference()			{}
+	virtual void		removeReference()		{}
+	virtual int32_t		getReference()	const	{ return 1;									}
+
+	ExtBatchQuery*	mOwner;
+	PxU32			mType;
+	PxU32			mStart;
+	PxU32			mNbQueries;
+	PxU32			mScratchStart;
+	PxU32			mNbScratchTouches;
+};
 
 class ExtBatchQuery : public PxBatchQueryExt
 {
@@ -287,8 +328,12 @@ public:
 
 	virtual void execute();
 
+	virtual void executeAsync(PxCpuDispatcher& dispatcher, PxBaseTask* continuation);
+
 private:
 
+	friend class ExtBatchQueryChunk;
+
 	template<typename HitType, typename QueryType> struct Query
 	{
 		PxHitBuffer<HitType>* mBuffers;
@@ -299,6 +344,10 @@ private:
 
 		PxU32 mBufferTide;
 
+		// Scratch touch buffers of the chunks and overflow flags of the queries, for executeAsync().
+		PxArray<HitType> mAsyncTouches;
+		PxArray<bool> mAsyncOverflows;
+
 		Query()
 			: mBuffers(NULL),
 			mQueries(NULL),
@@ -375,66 +424,166 @@ private:
 				query.cache);
 		}
 
+		// Runs query i with the touch buffer space left after touchesTide, returns the updated tide.
+		PxU32 executeQuery(const PxScene& scene, PxQueryFilterCallback* qfcb, const PxU32 i, PxU32 touchesTide)
+		{
+			PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
+			PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
+			PX_ASSERT(!mBuffers[i].touches);
+
+			bool noTouchesRemaining = false;
+			if (mBuffers[i].maxNbTouches > 0)
+			{
+				if (touchesTide >= mMaxNbTouches)
+				{
+					//No resources left.
+					mBuffers[i].maxNbTouches = 0;
+					mBuffers[i].touches = NULL;
+					noTouchesRemaining = true;
+				}
+				else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
+				{
+					//Some resources left but not enough to match requested number.
+					//This might be enough but it depends on the number of hits generated by the query.
+					mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+				else
+				{
+					//Enough resources left to match request.
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+			}
+
+			bool overflow = false;
+			{
+				PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
+				performQuery(scene, mQueries[i], overflowBuffer, qfcb);
+				overflow = overflowBuffer.overflow || noTouchesRemaining;
+				mBuffers[i].hasBlock = overflowBuffer.hasBlock;
+				mBuffers[i].block = overflowBuffer.block;
+				mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+			}
+
+			if(overflow)
+			{
+				mBuffers[i].maxNbTouches = 0xffffffff;
+			}
+			return touchesTide + mBuffers[i].nbTouches;
+		}
+
 		void execute(const PxScene& scene, PxQueryFilterCallback* qfcb)
 		{
 			PxU32 touchesTide = 0;
 			for (PxU32 i = 0; i < mBufferTide; i++)
+				touchesTide = executeQuery(scene, qfcb, i, touchesTide);
+
+			mBufferTide = 0;
+		}
+
+		// Splits the queued queries into chunks of chunkSize queries. Each chunk gets a scratch touch buffer large enough
+		// for the requests of its queries, capped to the size of the batch touch buffer since the serial execution can never
+		// hand out more than that either.
+		template<class ChunkArray>
+		void prepareAsync(ChunkArray& chunks, ExtBatchQuery* owner, const PxU32 type, const PxU32 chunkSize)
+		{
+			mAsyncOverflows.resizeUninitialized(mBufferTide);
+
+			PxU32 nbScratchTouches = 0;
+			for (PxU32 start = 0; start < mBufferTide; start += chunkSize)
 			{
-				PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
-				PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
-				PX_ASSERT(!mBuffers[i].touches);
+				const PxU32 nb = PxMin(chunkSize, mBufferTide - start);
+				PxU32 nbRequestedTouches = 0;
+				for (PxU32 i = start; i < start + nb; i++)
+					nbRequestedTouches += mBuffers[i].maxNbTouches;
+				const PxU32 nbChunkTouches = PxMin(nbRequestedTouches, mMaxNbTouches);
+
+				chunks.pushBack(ExtBatchQueryChunk(owner, type, start, nb, nbScratchTouches, nbChunkTouches));
+				nbScratchTouches += nbChunkTouches;
+			}
+			mAsyncTouches.resizeUninitialized(nbScratchTouches);
+		}
 
-				bool noTouchesRemaining = false;
-				if (mBuffers[i].maxNbTouches > 0)
-				{
-					if (touchesTide >= mMaxNbTouches)
-					{
-						//No resources left.
-						mBuffers[i].maxNbTouches = 0;
-						mBuffers[i].touches = NULL;
-						noTouchesRemaining = true;
-					}
-					else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
-					{
-						//Some resources left but not enough to match requested number.
-						//This might be enough but it depends on the number of hits generated by the query.
-						mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
-					else
-					{
-						//Enough resources left to match request.
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
-				}
+		// Runs a chunk of queries on a worker thread. Queries are given the touch buffer space they requested. Queries for
+		// which the chunk's scratch buffer is too small are skipped and left to finalizeAsync(), which re-runs them with
+		// the space the serial execution would have given them.
+		void executeChunk(const PxScene& scene, PxQueryFilterCallback* qfcb, const ExtBatchQueryChunk& chunk)
+		{
+			HitType* scratchTouches = mAsyncTouches.begin() + chunk.mScratchStart;
+			PxU32 scratchTide = 0;
+			for (PxU32 i = chunk.mStart; i < chunk.mStart + chunk.mNbQueries; i++)
+			{
+				PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
+				const PxU32 maxNbTouches = mBuffers[i].maxNbTouches;
+				if ((scratchTide + maxNbTouches) > chunk.mNbScratchTouches)
+					continue;
+
+				HitType* touches = maxNbTouches ? scratchTouches + scratchTide : NULL;
+				PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(touches, maxNbTouches);
+				performQuery(scene, mQueries[i], overflowBuffer, qfcb);
+				mBuffers[i].hasBlock = overflowBuffer.hasBlock;
+				mBuffers[i].block = overflowBuffer.block;
+				mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+				mBuffers[i].touches = touches;
+				mAsyncOverflows[i] = overflowBuffer.overflow;
+				scratchTide += overflowBuffer.nbTouches;
+			}
+		}
 
-				bool overflow = false;
+		// Walks the queries in order and hands out touch buffer space exactly like execute(). A query that ran with the
+		// space the serial execution would have given it keeps its result and has its touches moved to the batch touch
+		// buffer. Any other query is re-run here.
+		void finalizeAsync(const PxScene& scene, PxQueryFilterCallback* qfcb)
+		{
+			PxU32 touchesTide = 0;
+			for (PxU32 i = 0; i < mBufferTide; i++)
+			{
+				PxHitBuffer<HitType>& buffer = mBuffers[i];
+				const PxU32 maxNbTouches = buffer.maxNbTouches;
+				const bool sameTouchSpace = (0 == maxNbTouches) || ((touchesTide + maxNbTouches) <= mMaxNbTouches);
+				if (0xffffffff == buffer.nbTouches || !sameTouchSpace)
 				{
-					PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
-					performQuery(scene, mQueries[i], overflowBuffer, qfcb);
-					overflow = overflowBuffer.overflow || noTouchesRemaining;
-					mBuffers[i].hasBlock = overflowBuffer.hasBlock;
-					mBuffers[i].block = overflowBuffer.block;
-					mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+					buffer.hasBlock = false;
+					buffer.nbTouches = 0xffffffff;
+					buffer.touches = NULL;
+					touchesTide = executeQuery(scene, qfcb, i, touchesTide);
+					continue;
 				}
 
-				if(overflow)
+				if (maxNbTouches)
 				{
-					mBuffers[i].maxNbTouches = 0xffffffff;
+					HitType* touches = mTouches + touchesTide;
+					for (PxU32 j = 0; j < buffer.nbTouches; j++)
+						touches[j] = buffer.touches[j];
+					buffer.touches = touches;
 				}
-				touchesTide += mBuffers[i].nbTouches;
+				if (mAsyncOverflows[i])
+					buffer.maxNbTouches = 0xffffffff;
+				touchesTide += buffer.nbTouches;
 			}
 
 			mBufferTide = 0;
 		}
 	};
 
+	void executeChunk(const ExtBatchQueryChunk& chunk);
+	void finalizeAsync();
+	void chunkCompleted();
+
+	// Chunks target a few tasks per worker thread, without going below a size where the task overhead dominates.
+	static const PxU32 MIN_ASYNC_CHUNK_SIZE = 32;
+	static const PxU32 ASYNC_CHUNKS_PER_WORKER = 4;
+
 	const PxScene& mScene;
 	PxQueryFilterCallback* mQueryFilterCallback;
 
 	Query<PxRaycastHit, Raycast> mRaycasts;
 	Query<PxSweepHit, Sweep> mSweeps;
 	Query<PxOverlapHit, Overlap> mOverlaps;
+
+	PxArray<ExtBatchQueryChunk> mAsyncChunks;
+	PxBaseTask* mAsyncContinuation;
+	volatile PxI32 mNbPendingChunks;
 };
 
 template<typename HitType>
@@ -632,7 +781,9 @@ ExtBatchQuery::ExtBatchQuery
  PxSweepBuffer* sweepBuffers, Sweep* sweepQueries, const PxU32 maxNbSweeps, PxSweepHit* sweepTouches, const PxU32 maxNbSweepTouches,
  PxOverlapBuffer* overlapBuffers, Overlap* overlapQueries, const PxU32 maxNbOverlaps, PxOverlapHit* overlapTouches, const PxU32 maxNbOverlapTouches)
 	: mScene(scene),
-	  mQueryFilterCallback(queryFilterCallback)
+	  mQueryFilterCallback(queryFilterCallback),
+	  mAsyncContinuation(NULL),
+	  mNbPendingChunks(0)
 {
 	typedef Query<PxRaycastHit, Raycast> QueryRaycast;
 	typedef Query<PxSweepHit, Sweep> QuerySweep;
@@ -644,6 +795,8 @@ ExtBatchQuery::ExtBatchQuery
 
 void ExtBatchQuery::release()
 {
+	PX_CHECK_MSG(0 == mNbPendingChunks, "PxBatchQueryExt::release - released while executeAsync() is in progress");
+	this->~ExtBatchQuery();
 	PxGetAllocatorCallback()->deallocate(this);
 }
 
@@ -694,3 +847,94 @@ void ExtBatchQuery::execute()
 	mSweeps.execute(mScene, mQueryFilterCallback);
 	mOverlaps.execute(mScene, mQueryFilterCallback);
 }
+
+void ExtBatchQuery::executeAsync(PxCpuDispatcher& dispatcher, PxBaseTask* continuation)
+{
+	PX_CHECK_AND_RETURN(0 == mNbPendingChunks, "PxBatchQueryExt::executeAsync - previous executeAsync() still in progress");
+
+	const PxU32 nbQueries = mRaycasts.mBufferTide + mSweeps.mBufferTide + mOverlaps.mBufferTide;
+	const PxU32 nbTargetChunks = PxMax(dispatcher.getWorkerCount(), 1u) * ASYNC_CHUNKS_PER_WORKER;
+	const PxU32 chunkSize = PxMax((nbQueries + nbTargetChunks - 1) / nbTargetChunks, MIN_ASYNC_CHUNK_SIZE);
+
+	mAsyncChunks.clear();
+	mRaycasts.prepareAsync(mAsyncChunks, this, ExtBatchQueryChunk::eRAYCAST, chunkSize);
+	mSweeps.prepareAsync(mAsyncChunks, this, ExtBatchQueryChunk::eSWEEP, chunkSize);
+	mOverlaps.prepareAsync(mAsyncChunks, this, ExtBatchQueryChunk::eOVERLAP, chunkSize);
+
+	const PxU32 nbChunks = mAsyncChunks.size();
+	if(!nbChunks)
+		return;
+
+	if(!continuation)
+	{
+		// Blocking call: the calling thread runs chunks as well, so that this can be called from a worker thread of the
+		// dispatcher without waiting on tasks that might never be scheduled.
+		struct ChunkWork : public PxParallelForWork
+		{
+			ChunkWork(ExtBatchQuery& owner) : mOwner(owner)	{}
+			virtual void process(PxU32 index)	PX_OVERRIDE	{ mOwner.executeChunk(mOwner.mAsyncChunks[index]);	}
+			ExtBatchQuery& mOwner;
+			PX_NOCOPY(ChunkWork)
+		};
+
+		ChunkWork work(*this);
+		mNbPendingChunks = PxI32(nbChunks);
+		PxParallelFor(&dispatcher, work, nbChunks, "PxBatchQueryExt.executeChunk");
+		finalizeAsync();
+		mNbPendingChunks = 0;
+		return;
+	}
+
+	mAsyncContinuation = continuation;
+	continuation->addReference();
+
+	// Chunks can complete while later ones are still being submitted, the counter must be set beforehand.
+	mNbPendingChunks = PxI32(nbChunks);
+	PxMemoryBarrier();
+
+	// The array is not resized until all chunks have completed.
+	for(PxU32 i = 0; i < nbChunks; i++)
+		dispatcher.submitTask(mAsyncChunks[i]);
+}
+
+void ExtBatchQuery::executeChunk(const ExtBatchQueryChunk& chunk)
+{
+	switch(chunk.mType)
+	{
+		case ExtBatchQueryChunk::eRAYCAST:	mRaycasts.executeChunk(mScene, mQueryFilterCallback, chunk);	break;
+		case ExtBatchQueryChunk::eSWEEP:	mSweeps.executeChunk(mScene, mQueryFilterCallback, chunk);		break;
+		case ExtBatchQueryChunk::eOVERLAP:	mOverlaps.executeChunk(mScene, mQueryFilterCallback, chunk);	break;
+		default:							PX_ASSERT(0);
+	}
+}
+
+void ExtBatchQuery::finalizeAsync()
+{
+	// Compact the results in query order, as execute() would have produced them.
+	mRaycasts.finalizeAsync(mScene, mQueryFilterCallback);
+	mSweeps.finalizeAsync(mScene, mQueryFilterCallback);
+	mOverlaps.finalizeAsync(mScene, mQueryFilterCallback);
+}
+
+void ExtBatchQuery::chunkCompleted()
+{
+	if(PxAtomicDecrement(&mNbPendingChunks))
+		return;
+
+	finalizeAsync();
+
+	// The batch query may be released as soon as the continuation is released, do not touch it afterwards.
+	PxBaseTask* continuation = mAsyncContinuation;
+	mAsyncContinuation = NULL;
+	continuation->removeReference();
+}
+
+void ExtBatchQueryChunk::run()
+{
+	mOwner->executeChunk(*this);
+}
+
+void ExtBatchQueryChunk::release()
+{
+	mOwner->chunkCompleted();
+}
@@ -436,6 +436,9 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
+// Revisit the switch below (and the one in NpSceneQueries) when adding a pruning structure type
+PX_COMPILE_TIME_ASSERT(PxPruningStructureType::eLAST == 5);
+
 static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
 {
 //	if(0)
@@ -450,6 +453,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
 		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
 		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
+		case PxPruningStructureType::eSTATIC_WIDE_AABB_TREE:	{ pruner = createWideAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -460,6 +465,11 @@ PxSceneQuerySystem* physx::PxCreateExternalSceneQuerySystem(const PxSceneQueryDe
 	PVDCapture* pvd = NULL;
 	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
 	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+	if(desc.treeBuildDispatcher)
+	{
+		staticPruner->setBuildDispatcher(desc.treeBuildDispatcher);
+		dynamicPruner->setBuildDispatcher(desc.treeBuildDispatcher);
+	}
 
 	ExternalPxSQ* pxsq = PX_NEW(ExternalPxSQ)(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, desc.sceneQueryUpdateMode, PxSceneLimits());
 
@@ -923,7 +923,10 @@ bool ExtSceneQueries::multiQuery(
 			"NpSceneQueries multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
 	}
 
-	PX_CHECK_MSG(!cache || (cache && cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
+	// #MODIFIED
+	// Candidate caches (PxQueryCandidateCache) are not supported with an arbitrary number of pruners, so only the single hit cache is used here
+	PX_CHECK_MSG(!cache || (cache->candidateCache && !cache->shape) || (cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
+	//~#MODIFIED
 	PrunerCompoundId cachedCompoundId = INVALID_COMPOUND_ID;
 	// PT: this is similar to the code in the SqRefFinder so we could share that code maybe. But here we later retrieve the payload from the PrunerData,
 	// i.e. we basically go back to the same pointers we started from. I suppose it's to make sure they get properly invalidated when an object is deleted etc,
@@ -932,7 +935,7 @@ bool ExtSceneQueries::multiQuery(
 	// how can this work anyway? if the actor has been deleted the lookup won't work either => doc says it's up to users to manage that....
 	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
 	PxU32 prunerIndex = 0xffffffff;
-	const PrunerHandle cacheData = cache ? adapter.findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	const PrunerHandle cacheData = cache && cache->shape ? adapter.findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
 
 	// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 	// internally however, flushUpdates() changes the states of the Pruners in mSQManager
@@ -2401,6 +2401,8 @@ template<> struct PxEnumTraits< physx::PxGeometryQueryFlag::Enum > { PxEnumTrait
 		{ "eNONE", static_cast<PxU32>( physx::PxPruningStructureType::eNONE ) },
 		{ "eDYNAMIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eDYNAMIC_AABB_TREE ) },
 		{ "eSTATIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eSTATIC_AABB_TREE ) },
+		{ "eDYNAMIC_WIDE_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eDYNAMIC_WIDE_AABB_TREE ) },
+		{ "eSTATIC_WIDE_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eSTATIC_WIDE_AABB_TREE ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxPruningStructureType::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -0,0 +1,1486 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxVecMath.h"
+
+#include "common/PxProfileZone.h"
+#include "task/PxParallelFor.h"
+
+#include "extensions/PxRigidBodyExt.h"
+#include "extensions/PxSceneQueryExt.h"
+
+#include "PxMaterial.h"
+#include "PxRigidActor.h"
+#include "PxScene.h"
+#include "PxShape.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/batch/PxVehicleBatch.h"
+
+#include "vehicle2/braking/PxVehicleBrakingFunctions.h"
+
+#include "vehicle2/commands/PxVehicleCommandStates.h"
+
+#include "vehicle2/drivetrain/PxVehicleDrivetrainFunctions.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+
+#include "vehicle2/steering/PxVehicleSteeringFunctions.h"
+
+#include "vehicle2/suspension/PxVehicleSuspensionFunctions.h"
+#include "vehicle2/suspension/PxVehicleSuspensionHelpers.h"
+#include "vehicle2/suspension/PxVehicleSuspensionStates.h"
+
+#include "vehicle2/tire/PxVehicleTireFunctions.h"
+#include "vehicle2/tire/PxVehicleTireStates.h"
+
+#include "vehicle2/wheel/PxVehicleWheelHelpers.h"
+#include "vehicle2/wheel/PxVehicleWheelStates.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+using namespace aos;
+
+//Same value as VH_SUSPENSION_NO_INTERSECTION_MARKER: the wheel does not touch the ground.
+#define VH_BATCH_NO_INTERSECTION_MARKER	FLT_MIN
+
+#define VH_BATCH_NB_LANES				4
+#define VH_BATCH_GROUPS_PER_TASK		8		//Vehicle groups simulated by each parallel task (32 vehicles)
+
+////////////////////////////////////////////////////////////////////////////
+//Storage.
+//The vehicles are stored in groups of 4. Each group is a contiguous block
+//of floats with one entry of 4 lanes (one per vehicle) for each per-wheel
+//quantity and each wheel, followed by one entry of 4 lanes for each
+//per-vehicle quantity. Vectors are stored as 3 consecutive quantities.
+////////////////////////////////////////////////////////////////////////////
+
+struct WheelQuantity
+{
+	enum Enum
+	{
+		//Road geometry.
+		eROAD_NORMAL_X, eROAD_NORMAL_Y, eROAD_NORMAL_Z, eROAD_D,
+		eROAD_FRICTION,
+		eROAD_VELOCITY_X, eROAD_VELOCITY_Y, eROAD_VELOCITY_Z,
+		eROAD_HIT,
+
+		//Command responses.
+		eSTEER,
+		eBRAKE_TORQUE,
+		eDRIVE_TORQUE,
+
+		//Suspension state.
+		eJOUNCE,
+		eJOUNCE_SPEED,
+		eSEPARATION,
+
+		//Wheel geometry in the world frame.
+		eSUSP_DIR_X, eSUSP_DIR_Y, eSUSP_DIR_Z,						//suspension direction
+		eSUSP_ATTACHMENT_X, eSUSP_ATTACHMENT_Y, eSUSP_ATTACHMENT_Z,	//suspension attachment relative to the rigid body
+		eSUSP_APP_POINT_X, eSUSP_APP_POINT_Y, eSUSP_APP_POINT_Z,	//suspension force application point relative to the rigid body
+		eTIRE_APP_POINT_X, eTIRE_APP_POINT_Y, eTIRE_APP_POINT_Z,	//tire force application point relative to the rigid body
+		eWHEEL_BOTTOM_X, eWHEEL_BOTTOM_Y, eWHEEL_BOTTOM_Z,			//bottom of the wheel relative to the rigid body
+		eLNG_DIR_X, eLNG_DIR_Y, eLNG_DIR_Z,
+		eLAT_DIR_X, eLAT_DIR_Y, eLAT_DIR_Z,
+		eCAMBER_ANGLE,
+
+		//Suspension force.
+		eSUSP_FORCE_X, eSUSP_FORCE_Y, eSUSP_FORCE_Z,
+		eSUSP_TORQUE_X, eSUSP_TORQUE_Y, eSUSP_TORQUE_Z,
+		eNORMAL_FORCE,
+
+		//Tire states.
+		eLNG_SPEED, eLAT_SPEED,
+		eLNG_SLIP, eLAT_SLIP,
+		eLOAD, eFRICTION,
+		eLNG_LOW_SPEED_TIME, eLAT_LOW_SPEED_TIME,
+		eLNG_FORCE, eLAT_FORCE,
+		eALIGNING_MOMENT,
+		eWHEEL_TORQUE,
+
+		//Wheel state.
+		eROTATION_SPEED,
+		eCORRECTED_ROTATION_SPEED,
+		eROTATION_ANGLE,
+
+		eCOUNT
+	};
+};
+
+struct BodyQuantity
+{
+	enum Enum
+	{
+		ePOS_X, ePOS_Y, ePOS_Z,
+		eROT_X, eROT_Y, eROT_Z, eROT_W,
+		eLIN_VEL_X, eLIN_VEL_Y, eLIN_VEL_Z,
+		eANG_VEL_X, eANG_VEL_Y, eANG_VEL_Z,
+		ePREV_LIN_VEL_X, ePREV_LIN_VEL_Y, ePREV_LIN_VEL_Z,
+		ePREV_ANG_VEL_X, ePREV_ANG_VEL_Y, ePREV_ANG_VEL_Z,
+		eEXT_FORCE_X, eEXT_FORCE_Y, eEXT_FORCE_Z,
+		eEXT_TORQUE_X, eEXT_TORQUE_Y, eEXT_TORQUE_Z,
+		eACCEL_INTENT,		//1 if a drive torque is applied to any wheel
+		eBRAKE_INTENT,		//1 if a brake torque is applied to any wheel
+		eACTIVE,			//1 if the lane holds a vehicle
+
+		eCOUNT
+	};
+};
+
+namespace
+{
+	class GroupData
+	{
+	public:
+		PX_FORCE_INLINE	GroupData(PxF32* data, const PxU32 nbWheelSlots) : mData(data), mNbWheelSlots(nbWheelSlots)	{}
+
+		PX_FORCE_INLINE	PxF32*	wheel(const PxU32 q, const PxU32 wheelId)	const	{ return mData + ((q*mNbWheelSlots + wheelId) * VH_BATCH_NB_LANES);	}
+		PX_FORCE_INLINE	PxF32*	body(const PxU32 q)							const	{ return mData + ((WheelQuantity::eCOUNT*mNbWheelSlots + q) * VH_BATCH_NB_LANES);	}
+
+		PX_FORCE_INLINE	Vec4V	loadWheel(const PxU32 q, const PxU32 wheelId)				const	{ return V4LoadA(wheel(q, wheelId));	}
+		PX_FORCE_INLINE	void	storeWheel(const PxU32 q, const PxU32 wheelId, const Vec4V v)	const	{ V4StoreA(v, wheel(q, wheelId));		}
+		PX_FORCE_INLINE	Vec4V	loadBody(const PxU32 q)										const	{ return V4LoadA(body(q));				}
+		PX_FORCE_INLINE	void	storeBody(const PxU32 q, const Vec4V v)						const	{ V4StoreA(v, body(q));					}
+
+		PX_FORCE_INLINE	PxVec3	readWheelVec(const PxU32 q, const PxU32 wheelId, const PxU32 lane)	const
+		{
+			return PxVec3(wheel(q, wheelId)[lane], wheel(q + 1, wheelId)[lane], wheel(q + 2, wheelId)[lane]);
+		}
+		PX_FORCE_INLINE	void	writeWheelVec(const PxU32 q, const PxU32 wheelId, const PxU32 lane, const PxVec3& v)	const
+		{
+			wheel(q, wheelId)[lane] = v.x;
+			wheel(q + 1, wheelId)[lane] = v.y;
+			wheel(q + 2, wheelId)[lane] = v.z;
+		}
+		PX_FORCE_INLINE	PxVec3	readBodyVec(const PxU32 q, const PxU32 lane)	const
+		{
+			return PxVec3(body(q)[lane], body(q + 1)[lane], body(q + 2)[lane]);
+		}
+		PX_FORCE_INLINE	void	writeBodyVec(const PxU32 q, const PxU32 lane, const PxVec3& v)	const
+		{
+			body(q)[lane] = v.x;
+			body(q + 1)[lane] = v.y;
+			body(q + 2)[lane] = v.z;
+		}
+		PX_FORCE_INLINE	PxTransform	readPose(const PxU32 lane)	const
+		{
+			return PxTransform(readBodyVec(BodyQuantity::ePOS_X, lane),
+				PxQuat(body(BodyQuantity::eROT_X)[lane], body(BodyQuantity::eROT_Y)[lane], body(BodyQuantity::eROT_Z)[lane], body(BodyQuantity::eROT_W)[lane]));
+		}
+
+		PxF32* const	mData;
+		const PxU32		mNbWheelSlots;
+	};
+
+	//Three vectors, one per lane, in structure-of-arrays form.
+	struct Vec3V4
+	{
+		Vec4V x, y, z;
+	};
+
+	PX_FORCE_INLINE Vec3V4 loadWheelVec(const GroupData& g, const PxU32 q, const PxU32 wheelId)
+	{
+		Vec3V4 r;
+		r.x = g.loadWheel(q, wheelId);
+		r.y = g.loadWheel(q + 1, wheelId);
+		r.z = g.loadWheel(q + 2, wheelId);
+		return r;
+	}
+
+	PX_FORCE_INLINE void storeWheelVec(const GroupData& g, const PxU32 q, const PxU32 wheelId, const Vec3V4& v)
+	{
+		g.storeWheel(q, wheelId, v.x);
+		g.storeWheel(q + 1, wheelId, v.y);
+		g.storeWheel(q + 2, wheelId, v.z);
+	}
+
+	PX_FORCE_INLINE Vec3V4 loadBodyVec(const GroupData& g, const PxU32 q)
+	{
+		Vec3V4 r;
+		r.x = g.loadBody(q);
+		r.y = g.loadBody(q + 1);
+		r.z = g.loadBody(q + 2);
+		return r;
+	}
+
+	PX_FORCE_INLINE void storeBodyVec(const GroupData& g, const PxU32 q, const Vec3V4& v)
+	{
+		g.storeBody(q, v.x);
+		g.storeBody(q + 1, v.y);
+		g.storeBody(q + 2, v.z);
+	}
+
+	PX_FORCE_INLINE Vec3V4 splat3(const PxVec3& v)
+	{
+		Vec3V4 r;
+		r.x = V4Load(v.x);
+		r.y = V4Load(v.y);
+		r.z = V4Load(v.z);
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 zero3()
+	{
+		Vec3V4 r;
+		r.x = r.y = r.z = V4Zero();
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 add3(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 r;
+		r.x = V4Add(a.x, b.x);
+		r.y = V4Add(a.y, b.y);
+		r.z = V4Add(a.z, b.z);
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 sub3(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 r;
+		r.x = V4Sub(a.x, b.x);
+		r.y = V4Sub(a.y, b.y);
+		r.z = V4Sub(a.z, b.z);
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 scale3(const Vec3V4& a, const Vec4V s)
+	{
+		Vec3V4 r;
+		r.x = V4Mul(a.x, s);
+		r.y = V4Mul(a.y, s);
+		r.z = V4Mul(a.z, s);
+		return r;
+	}
+
+	PX_FORCE_INLINE Vec3V4 sel3(const BoolV c, const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 r;
+		r.x = V4Sel(c, a.x, b.x);
+		r.y = V4Sel(c, a.y, b.y);
+		r.z = V4Sel(c, a.z, b.z);
+		return r;
+	}
+
+	//Same evaluation order as PxVec3::dot()
+	PX_FORCE_INLINE Vec4V dot3(const Vec3V4& a, const Vec3V4& b)
+	{
+		return V4Add(V4Add(V4Mul(a.x, b.x), V4Mul(a.y, b.y)), V4Mul(a.z, b.z));
+	}
+
+	//Same evaluation order as PxVec3::cross()
+	PX_FORCE_INLINE Vec3V4 cross3(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 r;
+		r.x = V4Sub(V4Mul(a.y, b.z), V4Mul(a.z, b.y));
+		r.y = V4Sub(V4Mul(a.z, b.x), V4Mul(a.x, b.z));
+		r.z = V4Sub(V4Mul(a.x, b.y), V4Mul(a.y, b.x));
+		return r;
+	}
+
+	//Sign as computed by PxVehicleComputeSign(): -1, 0 or 1.
+	PX_FORCE_INLINE Vec4V sign4(const Vec4V a)
+	{
+		const Vec4V zero = V4Zero();
+		const Vec4V one = V4One();
+		return V4Sel(V4IsGrtr(a, zero), one, V4Sel(V4IsGrtr(zero, a), V4Neg(one), zero));
+	}
+
+	//Truncation towards zero, as done by a cast to PxI32.
+	PX_FORCE_INLINE Vec4V trunc4(const Vec4V a)
+	{
+		return Vec4V_From_VecI32V(VecI32V_From_Vec4V(a));
+	}
+
+	//The vector math library has no accurate transcendental functions, so these are evaluated per lane
+	//with the same functions as the scalar code.
+	PX_FORCE_INLINE Vec4V atan4(const Vec4V a)
+	{
+		PX_ALIGN(16, PxF32 v[VH_BATCH_NB_LANES]);
+		V4StoreA(a, v);
+		for(PxU32 i = 0; i < VH_BATCH_NB_LANES; i++)
+			v[i] = PxAtan(v[i]);
+		return V4LoadA(v);
+	}
+
+	PX_FORCE_INLINE Vec4V tan4(const Vec4V a)
+	{
+		PX_ALIGN(16, PxF32 v[VH_BATCH_NB_LANES]);
+		V4StoreA(a, v);
+		for(PxU32 i = 0; i < VH_BATCH_NB_LANES; i++)
+			v[i] = PxTan(v[i]);
+		return V4LoadA(v);
+	}
+
+	PX_FORCE_INLINE Vec4V cos4(const Vec4V a)
+	{
+		PX_ALIGN(16, PxF32 v[VH_BATCH_NB_LANES]);
+		V4StoreA(a, v);
+		for(PxU32 i = 0; i < VH_BATCH_NB_LANES; i++)
+			v[i] = PxCos(v[i]);
+		return V4LoadA(v);
+	}
+
+	//Flag quantities are stored as 0 or 1.
+	PX_FORCE_INLINE BoolV isSet4(const Vec4V a)
+	{
+		return V4IsGrtr(a, V4Zero());
+	}
+
+	PX_FORCE_INLINE Vec4V flag4(const BoolV b)
+	{
+		return V4Sel(b, V4One(), V4Zero());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////
+//The batch.
+////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct RoadGeometryQuery
+	{
+		PxVec3				start;
+		PxVec3				dir;
+		PxReal				dist;
+		PxRaycastBuffer*	result;
+	};
+}
+
+class VehicleBatch : public PxVehicleBatch
+{
+public:
+
+	VehicleBatch(const PxVehicleBatchParams& params, const PxU32 maxNbVehicles, PxAllocatorCallback& allocator);
+	virtual ~VehicleBatch();
+
+	virtual void release() PX_OVERRIDE;
+	virtual const PxVehicleBatchParams& getParams() const PX_OVERRIDE { return mParams; }
+	virtual PxU32 getNbVehicles() const PX_OVERRIDE { return mNbVehicles; }
+	virtual PxU32 getMaxNbVehicles() const PX_OVERRIDE { return mMaxNbVehicles; }
+	virtual PxU32 addVehicle(const PxVehicleRigidBodyState& rigidBodyState) PX_OVERRIDE;
+	virtual void removeVehicle(PxU32 vehicleIndex) PX_OVERRIDE;
+	virtual void setCommands(PxU32 vehicleIndex, const PxVehicleCommandState& commands,
+		const PxVehicleDirectDriveTransmissionCommandState& transmissionCommands) PX_OVERRIDE;
+	virtual void setRigidBodyState(PxU32 vehicleIndex, const PxVehicleRigidBodyState& rigidBodyState) PX_OVERRIDE;
+	virtual void getRigidBodyState(PxU32 vehicleIndex, PxVehicleRigidBodyState& rigidBodyState) const PX_OVERRIDE;
+	virtual void setRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, const PxVehicleRoadGeometryState& roadGeometryState) PX_OVERRIDE;
+	virtual void getRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleRoadGeometryState& roadGeometryState) const PX_OVERRIDE;
+	virtual void getSuspensionState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionState& suspensionState) const PX_OVERRIDE;
+	virtual void getSuspensionForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionForce& suspensionForce) const PX_OVERRIDE;
+	virtual void getTireForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleTireForce& tireForce) const PX_OVERRIDE;
+	virtual void getWheelRigidBody1dState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleWheelRigidBody1dState& wheelState) const PX_OVERRIDE;
+	virtual void update(const PxReal dt, const PxVehiclePhysXSimulationContext& context, PxCpuDispatcher* dispatcher) PX_OVERRIDE;
+
+	//Per group stages, called from the parallel tasks.
+	void prepareGroup(const PxU32 group, const PxVehicleSimulationContext& context);
+	void simulateGroup(const PxU32 group, const PxReal dt, const PxVehicleSimulationContext& context);
+
+private:
+
+	PX_FORCE_INLINE GroupData getGroup(const PxU32 group) const
+	{
+		return GroupData(mData + group*mGroupStride, mNbWheelSlots);
+	}
+	PX_FORCE_INLINE PxU32 getNbActiveLanes(const PxU32 group) const
+	{
+		return PxMin(mNbVehicles - group*VH_BATCH_NB_LANES, PxU32(VH_BATCH_NB_LANES));
+	}
+
+	void setLaneToDefault(const GroupData& g, const PxU32 lane, const bool active);
+
+	void computeCommandResponses(const GroupData& g, const PxU32 group, const PxU32 nbActive, const PxVehicleSimulationContext& context);
+	void prepareRoadGeometryQueries(const GroupData& g, const PxU32 group, const PxU32 nbActive, const PxVehicleSimulationContext& context);
+	void processRoadGeometryQueries(const GroupData& g, const PxU32 group, const PxU32 nbActive);
+
+	void updateSuspensionStates(const GroupData& g, const PxU32 nbActive, const PxReal dt, const PxVehicleSimulationContext& context);
+	void updateSuspensionForces(const GroupData& g, const PxVehicleSimulationContext& context);
+	void updateTires(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context);
+	void updateDirectDrive(const GroupData& g, const PxReal dt);
+	void updateRigidBodies(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context);
+	void updateWheelRotationAngles(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context);
+
+	PxVehicleBatchParams mParams;
+	PxAllocatorCallback& mAllocator;
+
+	PxU32 mMaxNbVehicles;
+	PxU32 mNbVehicles;
+	PxU32 mNbGroups;		//Number of groups of 4 vehicles for mMaxNbVehicles.
+	PxU32 mNbWheelSlots;	//Largest wheel id plus one.
+	PxU32 mGroupStride;		//Number of floats per group.
+
+	PxF32* mData;
+	PxVehicleCommandState* mCommands;
+	PxVehicleDirectDriveTransmissionCommandState* mTransmissionCommands;
+	RoadGeometryQuery* mRoadGeometryQueries;	//One per wheel, in axle order, for each vehicle.
+
+	PxBatchQueryExt* mBatchQuery;
+	const PxScene* mBatchQueryScene;
+};
+
+VehicleBatch::VehicleBatch(const PxVehicleBatchParams& params, const PxU32 maxNbVehicles, PxAllocatorCallback& allocator)
+	: mParams(params),
+	  mAllocator(allocator),
+	  mMaxNbVehicles(maxNbVehicles),
+	  mNbVehicles(0),
+	  mBatchQuery(NULL),
+	  mBatchQueryScene(NULL)
+{
+	mNbGroups = (maxNbVehicles + VH_BATCH_NB_LANES - 1) / VH_BATCH_NB_LANES;
+
+	mNbWheelSlots = 0;
+	for (PxU32 i = 0; i < params.axleDescription.nbWheels; i++)
+		mNbWheelSlots = PxMax(mNbWheelSlots, params.axleDescription.wheelIdsInAxleOrder[i] + 1);
+
+	mGroupStride = (WheelQuantity::eCOUNT*mNbWheelSlots + BodyQuantity::eCOUNT) * VH_BATCH_NB_LANES;
+
+	mData = reinterpret_cast<PxF32*>(allocator.allocate(sizeof(PxF32)*mGroupStride*mNbGroups, "PxVehicleBatch", PX_FL));
+	mCommands = reinterpret_cast<PxVehicleCommandState*>(allocator.allocate(sizeof(PxVehicleCommandState)*maxNbVehicles, "PxVehicleBatch", PX_FL));
+	mTransmissionCommands = reinterpret_cast<PxVehicleDirectDriveTransmissionCommandState*>(
+		allocator.allocate(sizeof(PxVehicleDirectDriveTransmissionCommandState)*maxNbVehicles, "PxVehicleBatch", PX_FL));
+	mRoadGeometryQueries = NULL;
+	if (PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == params.roadGeometryQueryParams.roadGeometryQueryType)
+	{
+		mRoadGeometryQueries = reinterpret_cast<RoadGeometryQuery*>(
+			allocator.allocate(sizeof(RoadGeometryQuery)*maxNbVehicles*params.axleDescription.nbWheels, "PxVehicleBatch", PX_FL));
+	}
+
+	for (PxU32 i = 0; i < mNbGroups; i++)
+	{
+		const GroupData g = getGroup(i);
+		for (PxU32 j = 0; j < VH_BATCH_NB_LANES; j++)
+			setLaneToDefault(g, j, false);
+	}
+}
+
+VehicleBatch::~VehicleBatch()
+{
+	if (mBatchQuery)
+		mBatchQuery->release();
+	if (mRoadGeometryQueries)
+		mAllocator.deallocate(mRoadGeometryQueries);
+	mAllocator.deallocate(mTransmissionCommands);
+	mAllocator.deallocate(mCommands);
+	mAllocator.deallocate(mData);
+}
+
+void VehicleBatch::release()
+{
+	PxAllocatorCallback& allocator = mAllocator;
+	this->~VehicleBatch();
+	allocator.deallocate(this);
+}
+
+void VehicleBatch::setLaneToDefault(const GroupData& g, const PxU32 lane, const bool active)
+{
+	for (PxU32 q = 0; q < WheelQuantity::eCOUNT; q++)
+	{
+		for (PxU32 w = 0; w < mNbWheelSlots; w++)
+			g.wheel(q, w)[lane] = 0.0f;
+	}
+	for (PxU32 q = 0; q < BodyQuantity::eCOUNT; q++)
+		g.body(q)[lane] = 0.0f;
+
+	for (PxU32 w = 0; w < mNbWheelSlots; w++)
+	{
+		//Lanes without a vehicle keep their wheels in the air and are never integrated. Vehicles start
+		//with the default suspension state, as set by PxVehicleSuspensionState::setToDefault().
+		g.wheel(WheelQuantity::eJOUNCE, w)[lane] = active ? PX_VEHICLE_UNSPECIFIED_JOUNCE : 0.0f;
+		g.wheel(WheelQuantity::eSEPARATION, w)[lane] = active ? PX_VEHICLE_UNSPECIFIED_SEPARATION : VH_BATCH_NO_INTERSECTION_MARKER;
+	}
+	g.body(BodyQuantity::eROT_W)[lane] = 1.0f;
+	g.body(BodyQuantity::eACTIVE)[lane] = active ? 1.0f : 0.0f;
+}
+
+PxU32 VehicleBatch::addVehicle(const PxVehicleRigidBodyState& rigidBodyState)
+{
+	PX_CHECK_AND_RETURN_VAL(mNbVehicles < mMaxNbVehicles, "PxVehicleBatch::addVehicle: the batch is full", 0xffffffff);
+
+	const PxU32 vehicleIndex = mNbVehicles++;
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	setLaneToDefault(g, vehicleIndex % VH_BATCH_NB_LANES, true);
+	setRigidBodyState(vehicleIndex, rigidBodyState);
+
+	mCommands[vehicleIndex].setToDefault();
+	mTransmissionCommands[vehicleIndex].setToDefault();
+	return vehicleIndex;
+}
+
+void VehicleBatch::removeVehicle(PxU32 vehicleIndex)
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles, "PxVehicleBatch::removeVehicle: invalid vehicle index");
+
+	const PxU32 lastIndex = --mNbVehicles;
+	const GroupData last = getGroup(lastIndex / VH_BATCH_NB_LANES);
+	const PxU32 lastLane = lastIndex % VH_BATCH_NB_LANES;
+	if (vehicleIndex != lastIndex)
+	{
+		const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+		const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+		for (PxU32 q = 0; q < WheelQuantity::eCOUNT; q++)
+		{
+			for (PxU32 w = 0; w < mNbWheelSlots; w++)
+				g.wheel(q, w)[lane] = last.wheel(q, w)[lastLane];
+		}
+		for (PxU32 q = 0; q < BodyQuantity::eCOUNT; q++)
+			g.body(q)[lane] = last.body(q)[lastLane];
+
+		mCommands[vehicleIndex] = mCommands[lastIndex];
+		mTransmissionCommands[vehicleIndex] = mTransmissionCommands[lastIndex];
+	}
+	setLaneToDefault(last, lastLane, false);
+}
+
+void VehicleBatch::setCommands(PxU32 vehicleIndex, const PxVehicleCommandState& commands,
+	const PxVehicleDirectDriveTransmissionCommandState& transmissionCommands)
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles, "PxVehicleBatch::setCommands: invalid vehicle index");
+	mCommands[vehicleIndex] = commands;
+	mTransmissionCommands[vehicleIndex] = transmissionCommands;
+}
+
+void VehicleBatch::setRigidBodyState(PxU32 vehicleIndex, const PxVehicleRigidBodyState& rigidBodyState)
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles, "PxVehicleBatch::setRigidBodyState: invalid vehicle index");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	g.writeBodyVec(BodyQuantity::ePOS_X, lane, rigidBodyState.pose.p);
+	g.body(BodyQuantity::eROT_X)[lane] = rigidBodyState.pose.q.x;
+	g.body(BodyQuantity::eROT_Y)[lane] = rigidBodyState.pose.q.y;
+	g.body(BodyQuantity::eROT_Z)[lane] = rigidBodyState.pose.q.z;
+	g.body(BodyQuantity::eROT_W)[lane] = rigidBodyState.pose.q.w;
+	g.writeBodyVec(BodyQuantity::eLIN_VEL_X, lane, rigidBodyState.linearVelocity);
+	g.writeBodyVec(BodyQuantity::eANG_VEL_X, lane, rigidBodyState.angularVelocity);
+	g.writeBodyVec(BodyQuantity::ePREV_LIN_VEL_X, lane, rigidBodyState.linearVelocity);
+	g.writeBodyVec(BodyQuantity::ePREV_ANG_VEL_X, lane, rigidBodyState.angularVelocity);
+	g.writeBodyVec(BodyQuantity::eEXT_FORCE_X, lane, rigidBodyState.externalForce);
+	g.writeBodyVec(BodyQuantity::eEXT_TORQUE_X, lane, rigidBodyState.externalTorque);
+}
+
+void VehicleBatch::getRigidBodyState(PxU32 vehicleIndex, PxVehicleRigidBodyState& rigidBodyState) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles, "PxVehicleBatch::getRigidBodyState: invalid vehicle index");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	rigidBodyState.pose = g.readPose(lane);
+	rigidBodyState.linearVelocity = g.readBodyVec(BodyQuantity::eLIN_VEL_X, lane);
+	rigidBodyState.angularVelocity = g.readBodyVec(BodyQuantity::eANG_VEL_X, lane);
+	rigidBodyState.previousLinearVelocity = g.readBodyVec(BodyQuantity::ePREV_LIN_VEL_X, lane);
+	rigidBodyState.previousAngularVelocity = g.readBodyVec(BodyQuantity::ePREV_ANG_VEL_X, lane);
+	rigidBodyState.externalForce = g.readBodyVec(BodyQuantity::eEXT_FORCE_X, lane);
+	rigidBodyState.externalTorque = g.readBodyVec(BodyQuantity::eEXT_TORQUE_X, lane);
+}
+
+void VehicleBatch::setRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, const PxVehicleRoadGeometryState& roadGeometryState)
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::setRoadGeometryState: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	g.writeWheelVec(WheelQuantity::eROAD_NORMAL_X, wheelId, lane, roadGeometryState.plane.n);
+	g.wheel(WheelQuantity::eROAD_D, wheelId)[lane] = roadGeometryState.plane.d;
+	g.wheel(WheelQuantity::eROAD_FRICTION, wheelId)[lane] = roadGeometryState.friction;
+	g.writeWheelVec(WheelQuantity::eROAD_VELOCITY_X, wheelId, lane, roadGeometryState.velocity);
+	g.wheel(WheelQuantity::eROAD_HIT, wheelId)[lane] = roadGeometryState.hitState ? 1.0f : 0.0f;
+}
+
+void VehicleBatch::getRoadGeometryState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleRoadGeometryState& roadGeometryState) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::getRoadGeometryState: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	roadGeometryState.plane = PxPlane(g.readWheelVec(WheelQuantity::eROAD_NORMAL_X, wheelId, lane), g.wheel(WheelQuantity::eROAD_D, wheelId)[lane]);
+	roadGeometryState.friction = g.wheel(WheelQuantity::eROAD_FRICTION, wheelId)[lane];
+	roadGeometryState.velocity = g.readWheelVec(WheelQuantity::eROAD_VELOCITY_X, wheelId, lane);
+	roadGeometryState.hitState = g.wheel(WheelQuantity::eROAD_HIT, wheelId)[lane] != 0.0f;
+}
+
+void VehicleBatch::getSuspensionState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionState& suspensionState) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::getSuspensionState: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	suspensionState.jounce = g.wheel(WheelQuantity::eJOUNCE, wheelId)[lane];
+	suspensionState.jounceSpeed = g.wheel(WheelQuantity::eJOUNCE_SPEED, wheelId)[lane];
+	suspensionState.separation = g.wheel(WheelQuantity::eSEPARATION, wheelId)[lane];
+}
+
+void VehicleBatch::getSuspensionForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleSuspensionForce& suspensionForce) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::getSuspensionForce: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	suspensionForce.force = g.readWheelVec(WheelQuantity::eSUSP_FORCE_X, wheelId, lane);
+	suspensionForce.torque = g.readWheelVec(WheelQuantity::eSUSP_TORQUE_X, wheelId, lane);
+	suspensionForce.normalForce = g.wheel(WheelQuantity::eNORMAL_FORCE, wheelId)[lane];
+}
+
+void VehicleBatch::getTireForce(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleTireForce& tireForce) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::getTireForce: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	const PxVec3 r = g.readWheelVec(WheelQuantity::eTIRE_APP_POINT_X, wheelId, lane);
+	const PxVec3 lngForce = g.readWheelVec(WheelQuantity::eLNG_DIR_X, wheelId, lane) * g.wheel(WheelQuantity::eLNG_FORCE, wheelId)[lane];
+	const PxVec3 latForce = g.readWheelVec(WheelQuantity::eLAT_DIR_X, wheelId, lane) * g.wheel(WheelQuantity::eLAT_FORCE, wheelId)[lane];
+	tireForce.forces[PxVehicleTireDirectionModes::eLONGITUDINAL] = lngForce;
+	tireForce.forces[PxVehicleTireDirectionModes::eLATERAL] = latForce;
+	tireForce.torques[PxVehicleTireDirectionModes::eLONGITUDINAL] = r.cross(lngForce);
+	tireForce.torques[PxVehicleTireDirectionModes::eLATERAL] = r.cross(latForce);
+	tireForce.aligningMoment = g.wheel(WheelQuantity::eALIGNING_MOMENT, wheelId)[lane];
+	tireForce.wheelTorque = g.wheel(WheelQuantity::eWHEEL_TORQUE, wheelId)[lane];
+}
+
+void VehicleBatch::getWheelRigidBody1dState(PxU32 vehicleIndex, PxU32 wheelId, PxVehicleWheelRigidBody1dState& wheelState) const
+{
+	PX_CHECK_AND_RETURN(vehicleIndex < mNbVehicles && wheelId < mNbWheelSlots, "PxVehicleBatch::getWheelRigidBody1dState: invalid vehicle index or wheel id");
+	const GroupData g = getGroup(vehicleIndex / VH_BATCH_NB_LANES);
+	const PxU32 lane = vehicleIndex % VH_BATCH_NB_LANES;
+	wheelState.rotationSpeed = g.wheel(WheelQuantity::eROTATION_SPEED, wheelId)[lane];
+	wheelState.correctedRotationSpeed = g.wheel(WheelQuantity::eCORRECTED_ROTATION_SPEED, wheelId)[lane];
+	wheelState.rotationAngle = g.wheel(WheelQuantity::eROTATION_ANGLE, wheelId)[lane];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Command responses and road geometry queries.
+//These run once per update, before the substeps.
+////////////////////////////////////////////////////////////////////////////
+
+void VehicleBatch::computeCommandResponses(const GroupData& g, const PxU32 group, const PxU32 nbActive, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+
+	PxVehicleSizedArrayData<const PxVehicleBrakeCommandResponseParams> brakeResponseParams;
+	brakeResponseParams.setDataAndCount(mParams.brakeResponseParams, 2);
+	PxVehicleSizedArrayData<const PxVehicleAckermannParams> ackermannParams;
+	ackermannParams.setDataAndCount(mParams.ackermannParams, mParams.nbAckermannParams);
+
+	for (PxU32 lane = 0; lane < nbActive; lane++)
+	{
+		const PxU32 vehicleIndex = group*VH_BATCH_NB_LANES + lane;
+		const PxVehicleCommandState& commands = mCommands[vehicleIndex];
+		const PxVehicleDirectDriveTransmissionCommandState& transmissionCommands = mTransmissionCommands[vehicleIndex];
+
+		//The velocities at the start of the update are recorded for PxVehicleRigidBodyState::previousLinearVelocity etc.
+		const PxVec3 linVel = g.readBodyVec(BodyQuantity::eLIN_VEL_X, lane);
+		g.writeBodyVec(BodyQuantity::ePREV_LIN_VEL_X, lane, linVel);
+		g.writeBodyVec(BodyQuantity::ePREV_ANG_VEL_X, lane, g.readBodyVec(BodyQuantity::eANG_VEL_X, lane));
+
+		const PxTransform pose = g.readPose(lane);
+		const PxReal longitudinalSpeed = linVel.dot(pose.q.rotate(context.frame.getLngAxis()));
+
+		PxReal brakeResponseStates[PxVehicleLimits::eMAX_NB_WHEELS];
+		PxReal throttleResponseStates[PxVehicleLimits::eMAX_NB_WHEELS];
+		PxReal steerResponseStates[PxVehicleLimits::eMAX_NB_WHEELS];
+		for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+
+			PxVehicleBrakeCommandResponseUpdate(
+				commands.brakes, commands.nbBrakes, longitudinalSpeed,
+				wheelId, brakeResponseParams,
+				brakeResponseStates[wheelId]);
+
+			PxVehicleDirectDriveThrottleCommandResponseUpdate(
+				commands.throttle, transmissionCommands, longitudinalSpeed,
+				wheelId, mParams.throttleResponseParams,
+				throttleResponseStates[wheelId]);
+
+			PxVehicleSteerCommandResponseUpdate(
+				commands.steer, longitudinalSpeed,
+				wheelId, mParams.steerResponseParams,
+				steerResponseStates[wheelId]);
+		}
+		if (ackermannParams.size > 0)
+		{
+			PxVehicleArrayData<PxReal> steerStates(steerResponseStates);
+			PxVehicleAckermannSteerUpdate(
+				commands.steer,
+				mParams.steerResponseParams, ackermannParams,
+				steerStates);
+		}
+
+		//Actuation states, as computed by PxVehicleDirectDriveActuationStateUpdate(), are derived from the
+		//torques when needed. The intentions are shared by all wheels of a vehicle.
+		bool isIntentionToAccelerate = false;
+		bool isIntentionToBrake = false;
+		for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+			g.wheel(WheelQuantity::eBRAKE_TORQUE, wheelId)[lane] = brakeResponseStates[wheelId];
+			g.wheel(WheelQuantity::eDRIVE_TORQUE, wheelId)[lane] = throttleResponseStates[wheelId];
+			g.wheel(WheelQuantity::eSTEER, wheelId)[lane] = steerResponseStates[wheelId];
+			if (throttleResponseStates[wheelId] != 0.0f)
+				isIntentionToAccelerate = true;
+			if (brakeResponseStates[wheelId] != 0.0f)
+				isIntentionToBrake = true;
+		}
+		g.body(BodyQuantity::eACCEL_INTENT)[lane] = isIntentionToAccelerate ? 1.0f : 0.0f;
+		g.body(BodyQuantity::eBRAKE_INTENT)[lane] = isIntentionToBrake ? 1.0f : 0.0f;
+	}
+}
+
+void VehicleBatch::prepareRoadGeometryQueries(const GroupData& g, const PxU32 group, const PxU32 nbActive, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	for (PxU32 lane = 0; lane < nbActive; lane++)
+	{
+		const PxTransform pose = g.readPose(lane);
+		RoadGeometryQuery* queries = mRoadGeometryQueries + (group*VH_BATCH_NB_LANES + lane)*axleDesc.nbWheels;
+		for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+			PxVehicleComputeSuspensionRaycast(context.frame, mParams.wheelParams[wheelId], mParams.suspensionParams[wheelId],
+				g.wheel(WheelQuantity::eSTEER, wheelId)[lane], pose,
+				queries[i].start, queries[i].dir, queries[i].dist);
+			queries[i].result = NULL;
+		}
+	}
+}
+
+//Same as the raycast branch of PxVehiclePhysXRoadGeometryQueryUpdate().
+void VehicleBatch::processRoadGeometryQueries(const GroupData& g, const PxU32 group, const PxU32 nbActive)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	for (PxU32 lane = 0; lane < nbActive; lane++)
+	{
+		const RoadGeometryQuery* queries = mRoadGeometryQueries + (group*VH_BATCH_NB_LANES + lane)*axleDesc.nbWheels;
+		for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+			const PxRaycastBuffer* buff = queries[i].result;
+
+			PxVehicleRoadGeometryState roadGeomState;
+			roadGeomState.setToDefault();
+			if (buff && buff->hasBlock && buff->block.distance != 0.0f)
+			{
+				roadGeomState.plane = PxPlane(queries[i].start + queries[i].dir * buff->block.distance, buff->block.normal);
+				roadGeomState.hitState = true;
+
+				const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams = mParams.materialFrictionParams[wheelId];
+				const PxBaseMaterial* hitMaterial = buff->block.shape->getMaterialFromInternalFaceIndex(buff->block.faceIndex);
+				roadGeomState.friction = materialFrictionParams.defaultFriction;
+				for (PxU32 j = 0; j < materialFrictionParams.nbMaterialFrictions; j++)
+				{
+					if (materialFrictionParams.materialFrictions[j].material == hitMaterial)
+					{
+						roadGeomState.friction = materialFrictionParams.materialFrictions[j].friction;
+						break;
+					}
+				}
+
+				const PxRigidBody* hitBody = buff->block.actor->is<PxRigidBody>();
+				roadGeomState.velocity = hitBody ? PxRigidBodyExt::getVelocityAtPos(*hitBody, buff->block.position) : PxVec3(PxZero);
+			}
+
+			g.writeWheelVec(WheelQuantity::eROAD_NORMAL_X, wheelId, lane, roadGeomState.plane.n);
+			g.wheel(WheelQuantity::eROAD_D, wheelId)[lane] = roadGeomState.plane.d;
+			g.wheel(WheelQuantity::eROAD_FRICTION, wheelId)[lane] = roadGeomState.friction;
+			g.writeWheelVec(WheelQuantity::eROAD_VELOCITY_X, wheelId, lane, roadGeomState.velocity);
+			g.wheel(WheelQuantity::eROAD_HIT, wheelId)[lane] = roadGeomState.hitState ? 1.0f : 0.0f;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Substep stages.
+//The jounce, compliance, tire directions and camber angles depend on the
+//steer angle and on the compliance curves, so they are computed per vehicle
+//with the same functions as PxVehicleSuspensionComponent and
+//PxVehicleTireComponent. Everything that follows is evaluated 4 vehicles at
+//a time, in the same order of operations as the scalar functions.
+////////////////////////////////////////////////////////////////////////////
+
+void VehicleBatch::updateSuspensionStates(const GroupData& g, const PxU32 nbActive, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	for (PxU32 lane = 0; lane < nbActive; lane++)
+	{
+		PxVehicleRigidBodyState rigidBodyState;
+		rigidBodyState.pose = g.readPose(lane);
+
+		for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+			const PxVehicleWheelParams& wheelParams = mParams.wheelParams[wheelId];
+			const PxVehicleSuspensionParams& suspParams = mParams.suspensionParams[wheelId];
+			const PxVehicleSuspensionForceParams& suspForceParams = mParams.suspensionForceParams[wheelId];
+			const PxReal steer = g.wheel(WheelQuantity::eSTEER, wheelId)[lane];
+
+			PxVehicleRoadGeometryState roadGeomState;
+			roadGeomState.plane = PxPlane(g.readWheelVec(WheelQuantity::eROAD_NORMAL_X, wheelId, lane), g.wheel(WheelQuantity::eROAD_D, wheelId)[lane]);
+			roadGeomState.friction = g.wheel(WheelQuantity::eROAD_FRICTION, wheelId)[lane];
+			roadGeomState.velocity = g.readWheelVec(WheelQuantity::eROAD_VELOCITY_X, wheelId, lane);
+			roadGeomState.hitState = g.wheel(WheelQuantity::eROAD_HIT, wheelId)[lane] != 0.0f;
+
+			PxVehicleSuspensionState suspState;
+			suspState.jounce = g.wheel(WheelQuantity::eJOUNCE, wheelId)[lane];
+			suspState.jounceSpeed = g.wheel(WheelQuantity::eJOUNCE_SPEED, wheelId)[lane];
+			suspState.separation = g.wheel(WheelQuantity::eSEPARATION, wheelId)[lane];
+
+			PxVehicleSuspensionStateUpdate(
+				wheelParams, suspParams, mParams.suspensionStateCalculationParams,
+				suspForceParams.stiffness, suspForceParams.damping,
+				steer, roadGeomState, rigidBodyState,
+				dt, context.frame, context.gravity,
+				suspState);
+
+			PxVehicleSuspensionComplianceState complianceState;
+			PxVehicleSuspensionComplianceUpdate(
+				suspParams, mParams.suspensionComplianceParams[wheelId],
+				suspState,
+				complianceState);
+
+			const bool isWheelOnGround = PxVehicleIsWheelOnGround(suspState);
+
+			PxVehicleTireDirectionState tireDirectionState;
+			PxVehicleTireDirsUpdate(
+				suspParams, steer,
+				roadGeomState.plane.n, isWheelOnGround,
+				complianceState, rigidBodyState,
+				context.frame,
+				tireDirectionState);
+
+			PxVehicleTireCamberAngleState tireCamberAngleState;
+			PxVehicleTireCamberAnglesUpdate(
+				suspParams, steer,
+				roadGeomState.plane.n, isWheelOnGround,
+				complianceState, rigidBodyState,
+				context.frame,
+				tireCamberAngleState);
+
+			//Bottom of the wheel placed on the ground plane, as in PxVehicleTireSlipSpeedsUpdate().
+			PxVec3 wheelBottomPos;
+			{
+				PxVec3 v, w;
+				PxF32 dist;
+				PxVehicleComputeSuspensionRaycast(context.frame, wheelParams, suspParams, steer, rigidBodyState.pose, v, w, dist);
+				wheelBottomPos = v + w*(dist - suspState.jounce);
+			}
+
+			const PxTransform& pose = rigidBodyState.pose;
+			g.wheel(WheelQuantity::eJOUNCE, wheelId)[lane] = suspState.jounce;
+			g.wheel(WheelQuantity::eJOUNCE_SPEED, wheelId)[lane] = suspState.jounceSpeed;
+			g.wheel(WheelQuantity::eSEPARATION, wheelId)[lane] = suspState.separation;
+			g.writeWheelVec(WheelQuantity::eSUSP_DIR_X, wheelId, lane, PxVehicleComputeSuspensionDirection(suspParams, pose));
+			g.writeWheelVec(WheelQuantity::eSUSP_ATTACHMENT_X, wheelId, lane, pose.rotate(suspParams.suspensionAttachment.p));
+			g.writeWheelVec(WheelQuantity::eSUSP_APP_POINT_X, wheelId, lane, pose.rotate(suspParams.suspensionAttachment.transform(complianceState.suspForceAppPoint)));
+			g.writeWheelVec(WheelQuantity::eTIRE_APP_POINT_X, wheelId, lane, pose.rotate(suspParams.suspensionAttachment.transform(complianceState.tireForceAppPoint)));
+			g.writeWheelVec(WheelQuantity::eWHEEL_BOTTOM_X, wheelId, lane, wheelBottomPos - pose.p);
+			g.writeWheelVec(WheelQuantity::eLNG_DIR_X, wheelId, lane, tireDirectionState.directions[PxVehicleTireDirectionModes::eLONGITUDINAL]);
+			g.writeWheelVec(WheelQuantity::eLAT_DIR_X, wheelId, lane, tireDirectionState.directions[PxVehicleTireDirectionModes::eLATERAL]);
+			g.wheel(WheelQuantity::eCAMBER_ANGLE, wheelId)[lane] = tireCamberAngleState.camberAngle;
+		}
+	}
+}
+
+//Same as PxVehicleSuspensionForceUpdate().
+void VehicleBatch::updateSuspensionForces(const GroupData& g, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	const PxReal vehicleMass = mParams.rigidBodyParams.mass;
+	const Vec4V zero = V4Zero();
+
+	const Vec3V4 externalForce = loadBodyVec(g, BodyQuantity::eEXT_FORCE_X);
+	const Vec3V4 externalTorque = loadBodyVec(g, BodyQuantity::eEXT_TORQUE_X);
+	const Vec3V4 externalForceLin = add3(splat3(context.gravity * vehicleMass), externalForce);
+
+	for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+	{
+		const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+		const PxVehicleSuspensionForceParams& suspForceParams = mParams.suspensionForceParams[wheelId];
+
+		const BoolV isWheelOnGround = V4IsGrtrOrEq(zero, g.loadWheel(WheelQuantity::eSEPARATION, wheelId));
+
+		const Vec3V4 n = loadWheelVec(g, WheelQuantity::eROAD_NORMAL_X, wheelId);
+		const Vec3V4 suspDirWorld = loadWheelVec(g, WheelQuantity::eSUSP_DIR_X, wheelId);
+		const Vec4V jounce = g.loadWheel(WheelQuantity::eJOUNCE, wheelId);
+		const Vec4V jounceSpeed = g.loadWheel(WheelQuantity::eJOUNCE_SPEED, wheelId);
+
+		const Vec4V springForceMag = V4Neg(V4Add(V4Mul(jounce, V4Load(suspForceParams.stiffness)), V4Mul(jounceSpeed, V4Load(suspForceParams.damping))));
+		const Vec3V4 suspSpringForce = scale3(suspDirWorld, springForceMag);
+		Vec4V suspForceMagnitude = dot3(n, suspSpringForce);
+
+		const Vec3V4 comToSuspWorld = loadWheelVec(g, WheelQuantity::eSUSP_ATTACHMENT_X, wheelId);
+		const Vec4V comToSuspDistSqr = dot3(comToSuspWorld, comToSuspWorld);
+		const BoolV hasLeverArm = V4IsGrtr(comToSuspDistSqr, zero);
+		const Vec4V invDistSqr = V4Div(V4One(), V4Sel(hasLeverArm, comToSuspDistSqr, V4One()));
+		const Vec3V4 externalForceAng = sel3(hasLeverArm, scale3(cross3(externalTorque, comToSuspWorld), invDistSqr), zero3());
+
+		const Vec3V4 externalForceSusp = scale3(add3(externalForceLin, externalForceAng), V4Load(suspForceParams.sprungMass / vehicleMass));
+		const BoolV isPushedToGround = V4IsGrtr(zero, dot3(n, externalForceSusp));
+		{
+			const Vec4V suspDirExternalForceMagn = dot3(suspDirWorld, externalForceSusp);
+			const Vec3V4 collisionForce = sub3(externalForceSusp, scale3(suspDirWorld, suspDirExternalForceMagn));
+			const Vec4V suspCollisionForceProjected = V4Neg(dot3(n, collisionForce));
+			suspForceMagnitude = V4Add(suspForceMagnitude, V4Sel(isPushedToGround, suspCollisionForceProjected, zero));
+		}
+
+		suspForceMagnitude = V4Sel(isWheelOnGround, suspForceMagnitude, zero);
+		const Vec3V4 f = scale3(n, suspForceMagnitude);
+		const Vec3V4 r = loadWheelVec(g, WheelQuantity::eSUSP_APP_POINT_X, wheelId);
+		storeWheelVec(g, WheelQuantity::eSUSP_FORCE_X, wheelId, f);
+		storeWheelVec(g, WheelQuantity::eSUSP_TORQUE_X, wheelId, cross3(r, f));
+		g.storeWheel(WheelQuantity::eNORMAL_FORCE, wheelId, suspForceMagnitude);
+	}
+}
+
+#define ONE_TWENTYSEVENTH 0.037037f
+#define ONE_THIRD 0.33333f
+
+namespace
+{
+	//Same as smoothingFunction1() in VhTireFunctions.cpp
+	PX_FORCE_INLINE Vec4V smoothingFunction1(const Vec4V K)
+	{
+		return V4Min(V4One(), V4Add(V4Sub(K, V4Mul(V4Mul(V4Load(ONE_THIRD), K), K)), V4Mul(V4Mul(V4Mul(V4Load(ONE_TWENTYSEVENTH), K), K), K)));
+	}
+
+	//Same as smoothingFunction2() in VhTireFunctions.cpp
+	PX_FORCE_INLINE Vec4V smoothingFunction2(const Vec4V K)
+	{
+		const Vec4V a = V4Sub(K, V4Mul(K, K));
+		const Vec4V b = V4Mul(V4Mul(V4Mul(V4Load(ONE_THIRD), K), K), K);
+		const Vec4V c = V4Mul(V4Mul(V4Mul(V4Mul(V4Load(ONE_TWENTYSEVENTH), K), K), K), K);
+		return V4Sub(V4Add(a, b), c);
+	}
+
+	//Same as computeFilteredNormalisedTireLoad() in VhTireFunctions.cpp
+	PX_FORCE_INLINE Vec4V computeFilteredNormalisedTireLoad(const PxReal xmin, const PxReal ymin, const PxReal xmax, const PxReal ymax, const Vec4V x)
+	{
+		const Vec4V lerp = V4Add(V4Load(ymin), V4Div(V4Mul(V4Sub(x, V4Load(xmin)), V4Load(ymax - ymin)), V4Load(xmax - xmin)));
+		return V4Sel(V4IsGrtrOrEq(V4Load(xmin), x), V4Load(ymin), V4Sel(V4IsGrtrOrEq(x, V4Load(xmax)), V4Load(ymax), lerp));
+	}
+
+	//Same as computeTireFriction() in VhTireFunctions.cpp
+	PX_FORCE_INLINE Vec4V computeTireFrictionMultiplier(const PxVehicleTireForceParams& params, const Vec4V longSlipAbs)
+	{
+		const PxF32 x0 = params.frictionVsSlip[0][0];
+		const PxF32 y0 = params.frictionVsSlip[0][1];
+		const PxF32 x1 = params.frictionVsSlip[1][0];
+		const PxF32 y1 = params.frictionVsSlip[1][1];
+		const PxF32 x2 = params.frictionVsSlip[2][0];
+		const PxF32 y2 = params.frictionVsSlip[2][1];
+		const Vec4V mu0 = V4Add(V4Load(y0), V4Div(V4Mul(V4Load(y1 - y0), V4Sub(longSlipAbs, V4Load(x0))), V4Load(x1 - x0)));
+		const Vec4V mu1 = V4Add(V4Load(y1), V4Div(V4Mul(V4Load(y2 - y1), V4Sub(longSlipAbs, V4Load(x1))), V4Load(x2 - x1)));
+		return V4Sel(V4IsGrtr(V4Load(x1), longSlipAbs), mu0, V4Sel(V4IsGrtr(V4Load(x2), longSlipAbs), mu1, V4Load(y2)));
+	}
+}
+
+//Same as PxVehicleTireSlipSpeedsUpdate(), PxVehicleTireSlipsUpdate(), PxVehicleTireGripUpdate(), PxVehicleTireStickyStateUpdate(),
+//PxVehicleTireSlipsAccountingForStickyStatesUpdate() and PxVehicleTireForcesUpdate(), in the order of PxVehicleTireComponent.
+void VehicleBatch::updateTires(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	const PxVehicleTireSlipParams& slipParams = context.tireSlipParams;
+	const PxVehicleTireStickyParams& stickyParams = context.tireStickyParams;
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	const Vec3V4 linVel = loadBodyVec(g, BodyQuantity::eLIN_VEL_X);
+	const Vec3V4 angVel = loadBodyVec(g, BodyQuantity::eANG_VEL_X);
+	const BoolV isIntentionToAccelerate = isSet4(g.loadBody(BodyQuantity::eACCEL_INTENT));
+	const BoolV isIntentionToBrake = isSet4(g.loadBody(BodyQuantity::eBRAKE_INTENT));
+
+	const Vec4V lngThresholdSpeed = V4Load(stickyParams.stickyParams[PxVehicleTireDirectionModes::eLONGITUDINAL].thresholdSpeed);
+	const Vec4V lngThresholdTime = V4Load(stickyParams.stickyParams[PxVehicleTireDirectionModes::eLONGITUDINAL].thresholdTime);
+	const Vec4V latThresholdSpeed = V4Load(stickyParams.stickyParams[PxVehicleTireDirectionModes::eLATERAL].thresholdSpeed);
+	const Vec4V latThresholdTime = V4Load(stickyParams.stickyParams[PxVehicleTireDirectionModes::eLATERAL].thresholdTime);
+	const Vec4V dtV = V4Load(dt);
+	const Vec4V minimumSlipThreshold = V4Load(1e-5f);
+
+	for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+	{
+		const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+		const PxVehicleWheelParams& wheelParams = mParams.wheelParams[wheelId];
+		const PxVehicleTireForceParams& tireParams = mParams.tireForceParams[wheelId];
+		const Vec4V wheelRadius = V4Load(wheelParams.radius);
+
+		const BoolV isWheelOnGround = V4IsGrtrOrEq(zero, g.loadWheel(WheelQuantity::eSEPARATION, wheelId));
+		const BoolV isBrakeApplied = BNot(V4IsEq(g.loadWheel(WheelQuantity::eBRAKE_TORQUE, wheelId), zero));
+		const BoolV isDriveApplied = BNot(V4IsEq(g.loadWheel(WheelQuantity::eDRIVE_TORQUE, wheelId), zero));
+		const Vec4V wheelOmega = g.loadWheel(WheelQuantity::eROTATION_SPEED, wheelId);
+
+		//Slip speeds.
+		const Vec3V4 r = loadWheelVec(g, WheelQuantity::eWHEEL_BOTTOM_X, wheelId);
+		const Vec3V4 wheelBottomVel = sub3(add3(linVel, cross3(angVel, r)), loadWheelVec(g, WheelQuantity::eROAD_VELOCITY_X, wheelId));
+		const Vec4V lngSpeed = dot3(wheelBottomVel, loadWheelVec(g, WheelQuantity::eLNG_DIR_X, wheelId));
+		const Vec4V latSpeed = dot3(wheelBottomVel, loadWheelVec(g, WheelQuantity::eLAT_DIR_X, wheelId));
+		const Vec4V lngSpeedAbs = V4Abs(lngSpeed);
+
+		//Slips.
+		Vec4V latSlip = atan4(V4Div(latSpeed, V4Add(lngSpeedAbs, V4Load(slipParams.minLatSlipDenominator))));
+		Vec4V lngSlip;
+		{
+			const Vec4V wheelSpeed = V4Mul(wheelOmega, wheelRadius);
+			const Vec4V minDenominator = V4Sel(BOr(isBrakeApplied, isDriveApplied),
+				V4Load(slipParams.minActiveLongSlipDenominator), V4Load(slipParams.minPassiveLongSlipDenominator));
+			const BoolV isAtRest = BAnd(V4IsEq(lngSpeed, zero), V4IsEq(wheelOmega, zero));
+			lngSlip = V4Sel(isAtRest, zero, V4Div(V4Sub(wheelSpeed, lngSpeed), V4Add(lngSpeedAbs, minDenominator)));
+		}
+
+		//Grip.
+		Vec4V load;
+		Vec4V friction;
+		{
+			const PxF32 restLoad = tireParams.restLoad;
+			const Vec4V normalisedLoad = V4Div(g.loadWheel(WheelQuantity::eNORMAL_FORCE, wheelId), V4Load(restLoad));
+			const Vec4V filteredNormalisedLoad = computeFilteredNormalisedTireLoad(
+				tireParams.loadFilter[0][0], tireParams.loadFilter[0][1], tireParams.loadFilter[1][0], tireParams.loadFilter[1][1],
+				normalisedLoad);
+			load = V4Sel(isWheelOnGround, V4Mul(V4Load(restLoad), filteredNormalisedLoad), zero);
+			const Vec4V mu = computeTireFrictionMultiplier(tireParams, V4Abs(lngSlip));
+			friction = V4Sel(isWheelOnGround, V4Mul(g.loadWheel(WheelQuantity::eROAD_FRICTION, wheelId), mu), zero);
+		}
+		const BoolV canGenerateForce = BNot(V4IsEq(V4Mul(load, friction), zero));
+
+		//Sticky states.
+		{
+			const Vec4V lngLowSpeedTime = g.loadWheel(WheelQuantity::eLNG_LOW_SPEED_TIME, wheelId);
+			const BoolV isLngSlow = BAnd(BAnd(V4IsGrtr(lngThresholdSpeed, lngSpeedAbs), V4IsGrtr(lngThresholdSpeed, V4Abs(V4Mul(wheelOmega, wheelRadius)))),
+				BNot(isIntentionToAccelerate));
+			const Vec4V newLngLowSpeedTime = V4Sel(BAnd(canGenerateForce, isLngSlow), V4Add(lngLowSpeedTime, dtV), zero);
+			const BoolV lngTimerActive = V4IsGrtr(newLngLowSpeedTime, zero);
+			const BoolV isLngActive = BAnd(canGenerateForce,
+				BOr(BAnd(BAnd(V4IsGrtr(lngThresholdSpeed, lngSpeedAbs), V4IsEq(wheelOmega, zero)), isIntentionToBrake), V4IsGrtr(newLngLowSpeedTime, lngThresholdTime)));
+
+			const Vec4V latLowSpeedTime = g.loadWheel(WheelQuantity::eLAT_LOW_SPEED_TIME, wheelId);
+			const BoolV isLatSlow = BAnd(V4IsGrtr(latThresholdSpeed, V4Abs(latSpeed)), BNot(isIntentionToAccelerate));
+			const Vec4V newLatLowSpeedTime = V4Sel(BAnd(canGenerateForce, isLatSlow), V4Add(latLowSpeedTime, dtV), zero);
+			const BoolV isLatActive = BAnd(canGenerateForce, BAnd(lngTimerActive, V4IsGrtr(newLatLowSpeedTime, latThresholdTime)));
+
+			g.storeWheel(WheelQuantity::eLNG_LOW_SPEED_TIME, wheelId, newLngLowSpeedTime);
+			g.storeWheel(WheelQuantity::eLAT_LOW_SPEED_TIME, wheelId, newLatLowSpeedTime);
+
+			lngSlip = V4Sel(isLngActive, zero, lngSlip);
+			latSlip = V4Sel(isLatActive, zero, latSlip);
+		}
+
+		g.storeWheel(WheelQuantity::eLNG_SPEED, wheelId, lngSpeed);
+		g.storeWheel(WheelQuantity::eLAT_SPEED, wheelId, latSpeed);
+		g.storeWheel(WheelQuantity::eLNG_SLIP, wheelId, lngSlip);
+		g.storeWheel(WheelQuantity::eLAT_SLIP, wheelId, latSlip);
+		g.storeWheel(WheelQuantity::eLOAD, wheelId, load);
+		g.storeWheel(WheelQuantity::eFRICTION, wheelId, friction);
+
+		//Tire forces (Michigan tire model, see computeTireForceMichiganModel() in VhTireFunctions.cpp).
+		//Lanes that generate no force are computed with a unit load and friction and discarded at the end.
+		{
+			const Vec4V tireFriction = V4Sel(canGenerateForce, friction, one);
+			const Vec4V tireLoad = V4Sel(canGenerateForce, load, one);
+			const Vec4V camberUnclamped = g.loadWheel(WheelQuantity::eCAMBER_ANGLE, wheelId);
+
+			const Vec4V latSlipC = V4Sel(V4IsGrtrOrEq(V4Abs(latSlip), minimumSlipThreshold), latSlip, zero);
+			const Vec4V longSlip = V4Sel(V4IsGrtrOrEq(V4Abs(lngSlip), minimumSlipThreshold), lngSlip, zero);
+			const Vec4V camber = V4Sel(V4IsGrtrOrEq(V4Abs(camberUnclamped), minimumSlipThreshold), camberUnclamped, zero);
+
+			const Vec4V normalisedTireLoad = V4Div(tireLoad, V4Load(tireParams.restLoad));
+			const Vec4V latStiff = (0.0f == tireParams.latStiffX) ? V4Load(tireParams.latStiffY) :
+				V4Mul(V4Load(tireParams.latStiffY), smoothingFunction1(V4Div(V4Mul(normalisedTireLoad, V4Load(3.0f)), V4Load(tireParams.latStiffX))));
+			const Vec4V longStiff = V4Load(tireParams.longStiff);
+			const Vec4V camberStiff = V4Load(tireParams.camberStiff);
+
+			const BoolV isZeroForce = BAnd(BAnd(V4IsEq(V4Mul(latSlipC, latStiff), zero), V4IsEq(V4Mul(longSlip, longStiff), zero)),
+				V4IsEq(V4Mul(camber, camberStiff), zero));
+			const BoolV hasForce = BAnd(canGenerateForce, BNot(isZeroForce));
+
+			//Lanes without force may have a zero lateral stiffness.
+			const Vec4V safeLatStiff = V4Sel(hasForce, latStiff, one);
+			const Vec4V TEff = tan4(V4Sel(hasForce, V4Add(latSlipC, V4Div(V4Mul(camber, camberStiff), safeLatStiff)), zero));
+			const Vec4V latTerm = V4Mul(V4Mul(V4Mul(latStiff, TEff), latStiff), TEff);
+			const Vec4V lngTerm = V4Mul(V4Mul(V4Mul(longStiff, longSlip), longStiff), longSlip);
+			const Vec4V K = V4Div(V4Sqrt(V4Add(latTerm, lngTerm)), V4Mul(tireFriction, tireLoad));
+			const Vec4V FBar = smoothingFunction1(K);
+			const Vec4V MBar = smoothingFunction2(K);
+
+			Vec4V nu;
+			{
+				const BoolV useNu = V4IsGrtrOrEq(V4Load(2.0f*PxPi), K);
+				const Vec4V latOverLong = V4Div(latStiff, longStiff);
+				const Vec4V cosK = cos4(V4Sel(useNu, V4Mul(K, V4Load(0.5f)), zero));
+				const Vec4V nuLow = V4Mul(V4Load(0.5f), V4Sub(V4Add(one, latOverLong), V4Mul(V4Sub(one, latOverLong), cosK)));
+				nu = V4Sel(useNu, nuLow, one);
+			}
+
+			const Vec4V nuTEff = V4Mul(nu, TEff);
+			const Vec4V FZero = V4Div(V4Mul(tireFriction, tireLoad), V4Sqrt(V4Add(V4Mul(longSlip, longSlip), V4Mul(V4Mul(nuTEff, nu), TEff))));
+			const Vec4V fz = V4Mul(V4Mul(longSlip, FBar), FZero);
+			const Vec4V fx = V4Mul(V4Mul(V4Mul(V4Neg(nu), TEff), FBar), FZero);
+			const Vec4V fMy = V4Mul(V4Mul(nuTEff, MBar), FZero);
+			const Vec4V wheelTorque = V4Mul(V4Neg(fz), wheelRadius);
+
+			g.storeWheel(WheelQuantity::eLNG_FORCE, wheelId, V4Sel(hasForce, fz, zero));
+			g.storeWheel(WheelQuantity::eLAT_FORCE, wheelId, V4Sel(hasForce, fx, zero));
+			g.storeWheel(WheelQuantity::eALIGNING_MOMENT, wheelId, V4Sel(hasForce, fMy, zero));
+			g.storeWheel(WheelQuantity::eWHEEL_TORQUE, wheelId, V4Sel(hasForce, wheelTorque, zero));
+		}
+	}
+}
+
+#undef ONE_THIRD
+#undef ONE_TWENTYSEVENTH
+
+//Same as PxVehicleDirectDriveUpdate().
+void VehicleBatch::updateDirectDrive(const GroupData& g, const PxReal dt)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	const Vec4V zero = V4Zero();
+	for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+	{
+		const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+		const PxVehicleWheelParams& wheelParams = mParams.wheelParams[wheelId];
+
+		const Vec4V wheelRotSpeed = g.loadWheel(WheelQuantity::eROTATION_SPEED, wheelId);
+		const PxF32 dtOverMOI = dt/wheelParams.moi;
+		const Vec4V brakeTorque = g.loadWheel(WheelQuantity::eBRAKE_TORQUE, wheelId);
+		const Vec4V appliedBrakeTorque = V4Neg(V4Mul(brakeTorque, sign4(wheelRotSpeed)));
+		const Vec4V driveTorque = g.loadWheel(WheelQuantity::eDRIVE_TORQUE, wheelId);
+		const Vec4V tireTorque = g.loadWheel(WheelQuantity::eWHEEL_TORQUE, wheelId);
+
+		const Vec4V newRotSpeedNoBrakelock = V4Div(
+			V4Add(wheelRotSpeed, V4Mul(V4Load(dtOverMOI), V4Add(V4Add(tireTorque, driveTorque), appliedBrakeTorque))),
+			V4Load(1.0f + wheelParams.dampingRate*dtOverMOI));
+		const BoolV isBrakeLocked = BAnd(BNot(V4IsEq(brakeTorque, zero)), V4IsGrtrOrEq(zero, V4Mul(wheelRotSpeed, newRotSpeedNoBrakelock)));
+		g.storeWheel(WheelQuantity::eROTATION_SPEED, wheelId, V4Sel(isBrakeLocked, zero, newRotSpeedNoBrakelock));
+	}
+}
+
+//Same as PxVehicleRigidBodyUpdate() without anti-roll torque.
+void VehicleBatch::updateRigidBodies(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	const PxVehicleRigidBodyParams& rigidBodyParams = mParams.rigidBodyParams;
+
+	//Sum all the forces and torques.
+	Vec3V4 force = zero3();
+	Vec3V4 torque = zero3();
+	for (PxU32 i = 0; i < axleDesc.getNbAxles(); i++)
+	{
+		Vec3V4 axleSuspForce = zero3();
+		Vec3V4 axleTireLongForce = zero3();
+		Vec3V4 axleTireLatForce = zero3();
+		Vec3V4 axleSuspTorque = zero3();
+		Vec3V4 axleTireLongTorque = zero3();
+		Vec3V4 axleTireLatTorque = zero3();
+		for (PxU32 j = 0; j < axleDesc.getNbWheelsOnAxle(i); j++)
+		{
+			const PxU32 wheelId = axleDesc.getWheelOnAxle(j, i);
+			const Vec3V4 r = loadWheelVec(g, WheelQuantity::eTIRE_APP_POINT_X, wheelId);
+			const Vec3V4 tireLongForce = scale3(loadWheelVec(g, WheelQuantity::eLNG_DIR_X, wheelId), g.loadWheel(WheelQuantity::eLNG_FORCE, wheelId));
+			const Vec3V4 tireLatForce = scale3(loadWheelVec(g, WheelQuantity::eLAT_DIR_X, wheelId), g.loadWheel(WheelQuantity::eLAT_FORCE, wheelId));
+			axleSuspForce = add3(axleSuspForce, loadWheelVec(g, WheelQuantity::eSUSP_FORCE_X, wheelId));
+			axleTireLongForce = add3(axleTireLongForce, tireLongForce);
+			axleTireLatForce = add3(axleTireLatForce, tireLatForce);
+			axleSuspTorque = add3(axleSuspTorque, loadWheelVec(g, WheelQuantity::eSUSP_TORQUE_X, wheelId));
+			axleTireLongTorque = add3(axleTireLongTorque, cross3(r, tireLongForce));
+			axleTireLatTorque = add3(axleTireLatTorque, cross3(r, tireLatForce));
+		}
+		force = add3(force, add3(add3(axleSuspForce, axleTireLongForce), axleTireLatForce));
+		torque = add3(torque, add3(add3(axleSuspTorque, axleTireLongTorque), axleTireLatTorque));
+	}
+	force = add3(force, splat3(context.gravity * rigidBodyParams.mass));
+	force = add3(force, loadBodyVec(g, BodyQuantity::eEXT_FORCE_X));
+	torque = add3(torque, loadBodyVec(g, BodyQuantity::eEXT_TORQUE_X));
+
+	//Integrate, as in integrateBody() in VhRigidBodyFunctions.cpp.
+	const Vec4V dtV = V4Load(dt);
+	const BoolV isActive = isSet4(g.loadBody(BodyQuantity::eACTIVE));
+
+	const Vec3V4 linVel0 = loadBodyVec(g, BodyQuantity::eLIN_VEL_X);
+	const Vec3V4 angVel0 = loadBodyVec(g, BodyQuantity::eANG_VEL_X);
+	const Vec3V4 pos0 = loadBodyVec(g, BodyQuantity::ePOS_X);
+	const Vec4V qx = g.loadBody(BodyQuantity::eROT_X);
+	const Vec4V qy = g.loadBody(BodyQuantity::eROT_Y);
+	const Vec4V qz = g.loadBody(BodyQuantity::eROT_Z);
+	const Vec4V qw = g.loadBody(BodyQuantity::eROT_W);
+
+	//Integrate linear velocity.
+	const Vec3V4 linVel = add3(linVel0, scale3(force, V4Load((1.0f/rigidBodyParams.mass)*dt)));
+
+	//Integrate angular velocity with the inverse inertia in the world frame.
+	Vec3V4 angVel;
+	{
+		//PxMat33(q)
+		const Vec4V x2 = V4Add(qx, qx);
+		const Vec4V y2 = V4Add(qy, qy);
+		const Vec4V z2 = V4Add(qz, qz);
+		const Vec4V xx = V4Mul(x2, qx);
+		const Vec4V yy = V4Mul(y2, qy);
+		const Vec4V zz = V4Mul(z2, qz);
+		const Vec4V xy = V4Mul(x2, qy);
+		const Vec4V xz = V4Mul(x2, qz);
+		const Vec4V xw = V4Mul(x2, qw);
+		const Vec4V yz = V4Mul(y2, qz);
+		const Vec4V yw = V4Mul(y2, qw);
+		const Vec4V zw = V4Mul(z2, qw);
+		const Vec4V one = V4One();
+
+		//M(row, column)
+		const Vec4V m00 = V4Sub(V4Sub(one, yy), zz), m10 = V4Add(xy, zw), m20 = V4Sub(xz, yw);
+		const Vec4V m01 = V4Sub(xy, zw), m11 = V4Sub(V4Sub(one, xx), zz), m21 = V4Add(yz, xw);
+		const Vec4V m02 = V4Add(xz, yw), m12 = V4Sub(yz, xw), m22 = V4Sub(V4Sub(one, xx), yy);
+
+		//transformInertiaTensor()
+		const Vec4V invDx = V4Load(1.0f/rigidBodyParams.moi.x);
+		const Vec4V invDy = V4Load(1.0f/rigidBodyParams.moi.y);
+		const Vec4V invDz = V4Load(1.0f/rigidBodyParams.moi.z);
+		const Vec4V axx = V4Mul(invDx, m00), axy = V4Mul(invDx, m10), axz = V4Mul(invDx, m20);
+		const Vec4V byx = V4Mul(invDy, m01), byy = V4Mul(invDy, m11), byz = V4Mul(invDy, m21);
+		const Vec4V czx = V4Mul(invDz, m02), czy = V4Mul(invDz, m12), czz = V4Mul(invDz, m22);
+
+		const Vec4V i00 = V4Add(V4Add(V4Mul(axx, m00), V4Mul(byx, m01)), V4Mul(czx, m02));
+		const Vec4V i11 = V4Add(V4Add(V4Mul(axy, m10), V4Mul(byy, m11)), V4Mul(czy, m12));
+		const Vec4V i22 = V4Add(V4Add(V4Mul(axz, m20), V4Mul(byz, m21)), V4Mul(czz, m22));
+		const Vec4V i01 = V4Add(V4Add(V4Mul(axx, m10), V4Mul(byx, m11)), V4Mul(czx, m12));
+		const Vec4V i02 = V4Add(V4Add(V4Mul(axx, m20), V4Mul(byx, m21)), V4Mul(czx, m22));
+		const Vec4V i12 = V4Add(V4Add(V4Mul(axy, m20), V4Mul(byy, m21)), V4Mul(czy, m22));
+
+		const Vec3V4 t = scale3(torque, dtV);
+		Vec3V4 dw;
+		dw.x = V4Add(V4Add(V4Mul(i00, t.x), V4Mul(i01, t.y)), V4Mul(i02, t.z));
+		dw.y = V4Add(V4Add(V4Mul(i01, t.x), V4Mul(i11, t.y)), V4Mul(i12, t.z));
+		dw.z = V4Add(V4Add(V4Mul(i02, t.x), V4Mul(i12, t.y)), V4Mul(i22, t.z));
+		angVel = add3(angVel0, dw);
+	}
+
+	//Integrate position.
+	const Vec3V4 pos = add3(pos0, scale3(linVel, dtV));
+
+	//Integrate quaternion: q += (w*q)*(dt/2) with w = (angVel, 0), then normalize.
+	Vec4V nqx, nqy, nqz, nqw;
+	{
+		const Vec4V halfDt = V4Load(dt*0.5f);
+		const Vec4V dqx = V4Sub(V4Add(V4Mul(qw, angVel.x), V4Mul(angVel.y, qz)), V4Mul(qy, angVel.z));
+		const Vec4V dqy = V4Sub(V4Add(V4Mul(qw, angVel.y), V4Mul(angVel.z, qx)), V4Mul(qz, angVel.x));
+		const Vec4V dqz = V4Sub(V4Add(V4Mul(qw, angVel.z), V4Mul(angVel.x, qy)), V4Mul(qx, angVel.y));
+		const Vec4V dqw = V4Sub(V4Sub(V4Neg(V4Mul(angVel.x, qx)), V4Mul(angVel.y, qy)), V4Mul(angVel.z, qz));
+		nqx = V4Add(qx, V4Mul(dqx, halfDt));
+		nqy = V4Add(qy, V4Mul(dqy, halfDt));
+		nqz = V4Add(qz, V4Mul(dqz, halfDt));
+		nqw = V4Add(qw, V4Mul(dqw, halfDt));
+
+		const Vec4V mag = V4Sqrt(V4Add(V4Add(V4Add(V4Mul(nqx, nqx), V4Mul(nqy, nqy)), V4Mul(nqz, nqz)), V4Mul(nqw, nqw)));
+		const BoolV isNonZero = BNot(V4IsEq(mag, V4Zero()));
+		const Vec4V imag = V4Sel(isNonZero, V4Div(V4One(), V4Sel(isNonZero, mag, V4One())), V4One());
+		nqx = V4Mul(nqx, imag);
+		nqy = V4Mul(nqy, imag);
+		nqz = V4Mul(nqz, imag);
+		nqw = V4Mul(nqw, imag);
+	}
+
+	//Lanes without a vehicle keep their identity pose.
+	storeBodyVec(g, BodyQuantity::eLIN_VEL_X, sel3(isActive, linVel, linVel0));
+	storeBodyVec(g, BodyQuantity::eANG_VEL_X, sel3(isActive, angVel, angVel0));
+	storeBodyVec(g, BodyQuantity::ePOS_X, sel3(isActive, pos, pos0));
+	g.storeBody(BodyQuantity::eROT_X, V4Sel(isActive, nqx, qx));
+	g.storeBody(BodyQuantity::eROT_Y, V4Sel(isActive, nqy, qy));
+	g.storeBody(BodyQuantity::eROT_Z, V4Sel(isActive, nqz, qz));
+	g.storeBody(BodyQuantity::eROT_W, V4Sel(isActive, nqw, qw));
+
+	//Reset the accumulated external forces after using them.
+	storeBodyVec(g, BodyQuantity::eEXT_FORCE_X, zero3());
+	storeBodyVec(g, BodyQuantity::eEXT_TORQUE_X, zero3());
+}
+
+//Same as PxVehicleWheelRotationAngleUpdate().
+void VehicleBatch::updateWheelRotationAngles(const GroupData& g, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	const PxVehicleAxleDescription& axleDesc = mParams.axleDescription;
+	const Vec4V zero = V4Zero();
+	const Vec4V thresholdV = V4Load(context.thresholdForwardSpeedForWheelAngleIntegration);
+	for (PxU32 i = 0; i < axleDesc.nbWheels; i++)
+	{
+		const PxU32 wheelId = axleDesc.wheelIdsInAxleOrder[i];
+		const Vec4V lngSpeed = g.loadWheel(WheelQuantity::eLNG_SPEED, wheelId);
+		const Vec4V absLngSpeed = V4Abs(lngSpeed);
+		const Vec4V rotationSpeed = g.loadWheel(WheelQuantity::eROTATION_SPEED, wheelId);
+
+		const BoolV blend = BAnd(BAnd(V4IsGrtr(g.loadWheel(WheelQuantity::eJOUNCE, wheelId), zero),
+			BAnd(V4IsEq(g.loadWheel(WheelQuantity::eBRAKE_TORQUE, wheelId), zero), V4IsEq(g.loadWheel(WheelQuantity::eDRIVE_TORQUE, wheelId), zero))),
+			V4IsGrtr(thresholdV, absLngSpeed));
+		const Vec4V alpha = V4Div(absLngSpeed, thresholdV);
+		const Vec4V blended = V4Add(V4Mul(V4Div(lngSpeed, V4Load(mParams.wheelParams[wheelId].radius)), V4Sub(V4One(), alpha)), V4Mul(rotationSpeed, alpha));
+		const Vec4V wheelOmega = V4Sel(blend, blended, rotationSpeed);
+		g.storeWheel(WheelQuantity::eCORRECTED_ROTATION_SPEED, wheelId, wheelOmega);
+
+		//Integrate the angle and clamp it in range (-2*Pi,2*Pi).
+		const Vec4V twoPi = V4Load(PxTwoPi);
+		const Vec4V newRotAngle = V4Add(g.loadWheel(WheelQuantity::eROTATION_ANGLE, wheelId), V4Mul(wheelOmega, V4Load(dt)));
+		g.storeWheel(WheelQuantity::eROTATION_ANGLE, wheelId, V4Sub(newRotAngle, V4Mul(trunc4(V4Div(newRotAngle, twoPi)), twoPi)));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Update.
+////////////////////////////////////////////////////////////////////////////
+
+void VehicleBatch::prepareGroup(const PxU32 group, const PxVehicleSimulationContext& context)
+{
+	const GroupData g = getGroup(group);
+	const PxU32 nbActive = getNbActiveLanes(group);
+	computeCommandResponses(g, group, nbActive, context);
+	if (mRoadGeometryQueries)
+		prepareRoadGeometryQueries(g, group, nbActive, context);
+}
+
+void VehicleBatch::simulateGroup(const PxU32 group, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	const GroupData g = getGroup(group);
+	const PxU32 nbActive = getNbActiveLanes(group);
+	if (mRoadGeometryQueries)
+		processRoadGeometryQueries(g, group, nbActive);
+
+	const PxReal subDt = dt/PxReal(mParams.nbSubsteps);
+	for (PxU32 i = 0; i < mParams.nbSubsteps; i++)
+	{
+		updateSuspensionStates(g, nbActive, subDt, context);
+		updateSuspensionForces(g, context);
+		updateTires(g, subDt, context);
+		updateDirectDrive(g, subDt);
+		updateRigidBodies(g, subDt, context);
+	}
+
+	updateWheelRotationAngles(g, dt, context);
+}
+
+namespace
+{
+	class PrepareWork : public PxParallelForWork
+	{
+	public:
+		PrepareWork(VehicleBatch& batch, const PxU32 nbGroups, const PxVehicleSimulationContext& context) :
+			mBatch(batch), mNbGroups(nbGroups), mContext(context)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 last = PxMin(mNbGroups, (index + 1)*VH_BATCH_GROUPS_PER_TASK);
+			for (PxU32 i = index*VH_BATCH_GROUPS_PER_TASK; i < last; i++)
+				mBatch.prepareGroup(i, mContext);
+		}
+
+		VehicleBatch&						mBatch;
+		const PxU32							mNbGroups;
+		const PxVehicleSimulationContext&	mContext;
+		PX_NOCOPY(PrepareWork)
+	};
+
+	class SimulateWork : public PxParallelForWork
+	{
+	public:
+		SimulateWork(VehicleBatch& batch, const PxU32 nbGroups, const PxReal dt, const PxVehicleSimulationContext& context) :
+			mBatch(batch), mNbGroups(nbGroups), mDt(dt), mContext(context)	{}
+
+		virtual	void	process(PxU32 index)	PX_OVERRIDE
+		{
+			const PxU32 last = PxMin(mNbGroups, (index + 1)*VH_BATCH_GROUPS_PER_TASK);
+			for (PxU32 i = index*VH_BATCH_GROUPS_PER_TASK; i < last; i++)
+				mBatch.simulateGroup(i, mDt, mContext);
+		}
+
+		VehicleBatch&						mBatch;
+		const PxU32							mNbGroups;
+		const PxReal						mDt;
+		const PxVehicleSimulationContext&	mContext;
+		PX_NOCOPY(SimulateWork)
+	};
+}
+
+void VehicleBatch::update(const PxReal dt, const PxVehiclePhysXSimulationContext& context, PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehicleBatch::update", 0);
+
+	if (!mNbVehicles)
+		return;
+	PX_CHECK_AND_RETURN(!mRoadGeometryQueries || context.physxScene, "PxVehicleBatch::update: context.physxScene must be set for raycast road geometry queries");
+
+	const PxU32 nbGroups = (mNbVehicles + VH_BATCH_NB_LANES - 1) / VH_BATCH_NB_LANES;
+	const PxU32 nbTasks = (nbGroups + VH_BATCH_GROUPS_PER_TASK - 1) / VH_BATCH_GROUPS_PER_TASK;
+
+	//Command responses and query setup.
+	{
+		PrepareWork work(*this, nbGroups, context);
+		PxParallelFor(dispatcher, work, nbTasks, "PxVehicleBatch::update", &mAllocator);
+	}
+
+	//All the suspension raycasts of the batch are issued as a single batched scene query.
+	if (mRoadGeometryQueries)
+	{
+		PX_PROFILE_ZONE("PxVehicleBatch::roadGeometryQueries", 0);
+
+		const PxVehiclePhysXRoadGeometryQueryParams& queryParams = mParams.roadGeometryQueryParams;
+		const PxU32 nbWheels = mParams.axleDescription.nbWheels;
+		if (!mBatchQuery || mBatchQueryScene != context.physxScene)
+		{
+			if (mBatchQuery)
+				mBatchQuery->release();
+			mBatchQuery = PxCreateBatchQueryExt(*context.physxScene, queryParams.filterCallback, mMaxNbVehicles*nbWheels, 0, 0, 0, 0, 0);
+			mBatchQueryScene = context.physxScene;
+		}
+
+		const PxU32 nbQueries = mNbVehicles*nbWheels;
+		for (PxU32 i = 0; i < nbQueries; i++)
+		{
+			RoadGeometryQuery& query = mRoadGeometryQueries[i];
+			const PxU32 wheelId = mParams.axleDescription.wheelIdsInAxleOrder[i % nbWheels];
+			const PxQueryFilterData& filterData = queryParams.filterDataEntries ? queryParams.filterDataEntries[wheelId] : queryParams.defaultFilterData;
+			query.result = mBatchQuery->raycast(query.start, query.dir, query.dist, 0, PxHitFlags(PxHitFlag::eDEFAULT), filterData);
+		}
+
+		if (dispatcher)
+			mBatchQuery->executeAsync(*dispatcher, NULL);
+		else
+			mBatchQuery->execute();
+	}
+
+	//Road geometry and substeps.
+	{
+		SimulateWork work(*this, nbGroups, dt, context);
+		PxParallelFor(dispatcher, work, nbTasks, "PxVehicleBatch::update", &mAllocator);
+	}
+}
+
+PxVehicleBatch* PxVehicleBatchCreate(const PxVehicleBatchParams& params, const PxU32 maxNbVehicles, PxAllocatorCallback& allocator)
+{
+	if (!params.isValid())
+		return NULL;
+	PX_CHECK_AND_RETURN_NULL(maxNbVehicles > 0, "PxVehicleBatchCreate: maxNbVehicles must be greater than zero");
+
+	return PX_PLACEMENT_NEW(allocator.allocate(sizeof(VehicleBatch), "PxVehicleBatch", PX_FL), VehicleBatch)(params, maxNbVehicles, allocator);
+}
+
+} //namespace vehicle2
+} //namespace physx
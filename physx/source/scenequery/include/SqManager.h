@@ -171,13 +171,16 @@ namespace Sq
 
 						void							flushMemory();
 		PX_FORCE_INLINE PxU32							getStaticTimestamp()	const	{ return mStaticTimestamp;	}
+		PX_FORCE_INLINE PxU32							getUniqueID()			const	{ return mUniqueID;			}
 		PX_FORCE_INLINE const Adapter&					getAdapter()			const	{ return mAdapter;			}
+		PX_FORCE_INLINE float							getInflation()			const	{ return mInflation;		}
 	private:
 						const Adapter&					mAdapter;
 						PrunerExt						mPrunerExt[PruningIndex::eCOUNT];
 						CompoundPrunerExt				mCompoundPrunerExt;
 
 						const PxU64						mContextID;
+						const PxU32						mUniqueID;	// Never reused, unlike the manager's address
 						PxU32							mStaticTimestamp;
 						PxU32							mRebuildRateHint;
 						const float						mInflation;	// SQ_PRUNER_EPSILON
@@ -0,0 +1,89 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SQ_QUERY_CANDIDATE_CACHE_H
+#define SQ_QUERY_CANDIDATE_CACHE_H
+
+#include "PxQueryCandidateCache.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxTransform.h"
+#include "foundation/PxUserAllocated.h"
+#include "GuPrunerPayload.h"
+
+namespace physx
+{
+namespace Sq
+{
+	class PrunerManager;
+
+	// Implementation of PxQueryCandidateCache. For each query ID we keep the static objects touching an inflated version
+	// of the query bounds, so that following queries with the same ID can skip the static pruner traversal. The candidates are
+	// stored in the same format as in the static pruner, i.e. the payload/transform arrays can be passed to the pruner callbacks.
+	class QueryCandidateCache : public PxQueryCandidateCache, public PxUserAllocated
+	{
+													PX_NOCOPY(QueryCandidateCache)
+		public:
+													QueryCandidateCache(float inflation);
+		virtual										~QueryCandidateCache();
+
+		// PxQueryCandidateCache
+		virtual			void						release()							PX_OVERRIDE;
+		virtual			void						invalidate(PxU32 queryID)			PX_OVERRIDE;
+		virtual			void						invalidateAll()						PX_OVERRIDE;
+		virtual			PxU32						getNbHits()					const	PX_OVERRIDE	{ return mNbHits;		}
+		virtual			PxU32						getNbMisses()				const	PX_OVERRIDE	{ return mNbMisses;		}
+		virtual			void						resetStats()						PX_OVERRIDE	{ mNbHits = mNbMisses = 0;	}
+		//~PxQueryCandidateCache
+
+		struct Entry : public PxUserAllocated
+		{
+													Entry() : mManagerID(0), mTimestamp(0)	{}
+
+						PxBounds3					mRegion;		// Candidates are all static objects touching these bounds
+						PxU32						mManagerID;		// Unique ID of the manager owning the static pruner the candidates come from
+						PxU32						mTimestamp;		// Static timestamp of that manager when the candidates were gathered
+						PxArray<Gu::PrunerPayload>	mPayloads;
+						PxArray<PxTransform>		mTransforms;
+						PxArray<PxBounds3>			mBounds;
+		};
+
+		// Returns the static candidates for a query, gathering them again from the static pruner if the cached ones cannot
+		// be used anymore. Returns NULL when the query cannot use the cache, in which case the static pruner must be traversed.
+						const Entry*				getStaticCandidates(PxU32 queryID, const PrunerManager& manager, const PxBounds3& queryBounds);
+		private:
+						PxHashMap<PxU32, Entry*>	mEntries;
+						const float					mInflation;
+						PxU32						mNbHits;
+						PxU32						mNbMisses;
+	};
+}
+}
+
+#endif
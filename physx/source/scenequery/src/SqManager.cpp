@@ -33,6 +33,7 @@
 #include "SqManager.h"
 #include "GuSqInternal.h"
 #include "GuBounds.h"
+#include "foundation/PxAtomic.h"
 
 using namespace physx;
 using namespace Sq;
@@ -246,11 +247,14 @@ namespace
 	};
 }
 
+static volatile PxI32 gPrunerManagerID = 0;
+
 PrunerManager::PrunerManager(	PxU64 contextID, Pruner* staticPruner, Pruner* dynamicPruner,
 								PxU32 dynamicTreeRebuildRateHint, float inflation,
 								const PxSceneLimits& limits, const Adapter& adapter) :
 	mAdapter			(adapter),
 	mContextID			(contextID),
+	mUniqueID			(PxU32(PxAtomicIncrement(&gPrunerManagerID))),
 	mStaticTimestamp	(0),
 	mInflation			(inflation)
 {
@@ -505,6 +509,9 @@ void PrunerManager::shiftOrigin(const PxVec3& shift)
 		mPrunerExt[i].pruner()->shiftOrigin(shift);
 
 	mCompoundPrunerExt.pruner()->shiftOrigin(shift);
+
+	// Static transforms and bounds changed, so anything cached against the static pruner is now invalid
+	invalidateStaticTimestamp();
 }
 
 void PrunerManager::addCompoundShape(const PxBVH& pxbvh, PrunerCompoundId compoundId, const PxTransform& compoundTransform, PrunerData* prunerData, const PrunerPayload* payloads, const PxTransform* transforms, bool isDynamic)
@@ -31,6 +31,7 @@
 // PT: this should really be at Np level but moving it to Sq allows us to share it.
 
 #include "SqQuery.h"
+#include "SqQueryCandidateCache.h"
 
 using namespace physx;
 using namespace Sq;
@@ -756,6 +757,12 @@ private:
 template<typename HitType>
 static bool doQueryVsCached(const PrunerHandle cacheData, PxU32 prunerIndex, const PrunerCompoundId cachedCompoundId, const PrunerManager& manager, MultiQueryCallback<HitType>& pcb, const MultiQueryInput& input);
 
+template<typename HitType>
+static bool doQueryVsCandidates(const QueryCandidateCache::Entry& candidates, MultiQueryCallback<HitType>& pcb, const MultiQueryInput& input);
+
+template<typename HitType>
+static PxBounds3 computeQueryBounds(const MultiQueryInput& input, const ShapeData* sd, PxReal distance);
+
 static PX_FORCE_INLINE PxCompoundPrunerQueryFlags convertFlags(PxQueryFlags	inFlags)
 {
 	PxCompoundPrunerQueryFlags outFlags(0);
@@ -807,7 +814,7 @@ bool SceneQueries::multiQuery(
 			"NpSceneQueries multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
 	}
 
-	PX_CHECK_MSG(!cache || (cache && cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
+	PX_CHECK_MSG(!cache || (cache->candidateCache && !cache->shape) || (cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
 	PrunerCompoundId cachedCompoundId = INVALID_COMPOUND_ID;
 	// PT: this is similar to the code in the SqRefFinder so we could share that code maybe. But here we later retrieve the payload from the PrunerData,
 	// i.e. we basically go back to the same pointers we started from. I suppose it's to make sure they get properly invalidated when an object is deleted etc,
@@ -815,7 +822,7 @@ bool SceneQueries::multiQuery(
 	//
 	// how can this work anyway? if the actor has been deleted the lookup won't work either => doc says it's up to users to manage that....
 	PxU32 prunerIndex = 0xffffffff;
-	const PrunerHandle cacheData = cache ? static_cast<const QueryAdapter&>(mSQManager.getAdapter()).findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	const PrunerHandle cacheData = cache && cache->shape ? static_cast<const QueryAdapter&>(mSQManager.getAdapter()).findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
 
 	// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 	// internally however, flushUpdates() changes the states of the Pruners in mSQManager
@@ -851,9 +858,14 @@ bool SceneQueries::multiQuery(
 
 	const PxCompoundPrunerQueryFlags compoundPrunerQueryFlags = convertFlags(filterData.flags);
 
+	// Static candidates from the user's candidate cache. When available they replace the static pruner traversal.
+	QueryCandidateCache* candidateCache = doStatics && cache ? static_cast<QueryCandidateCache*>(cache->candidateCache) : NULL;
+
 	if(HitTypeSupport<HitType>::IsRaycast)
 	{
-		bool again = doStatics ? staticPruner->raycast(input.getOrigin(), input.getDir(), pcb.mShrunkDistance, pcb) : true;
+		const QueryCandidateCache::Entry* candidates = candidateCache ? candidateCache->getStaticCandidates(cache->queryID, mSQManager, computeQueryBounds<HitType>(input, NULL, pcb.mShrunkDistance)) : NULL;
+
+		bool again = doStatics ? (candidates ? doQueryVsCandidates(*candidates, pcb, input) : staticPruner->raycast(input.getOrigin(), input.getDir(), pcb.mShrunkDistance, pcb)) : true;
 		if(!again)
 			return hits.hasAnyHits();
 		
@@ -872,7 +884,10 @@ bool SceneQueries::multiQuery(
 
 		const ShapeData sd(*input.geometry, *input.pose, input.inflation);
 		pcb.mShapeData = &sd;
-		bool again = doStatics ? staticPruner->overlap(sd, pcb) : true;
+
+		const QueryCandidateCache::Entry* candidates = candidateCache ? candidateCache->getStaticCandidates(cache->queryID, mSQManager, computeQueryBounds<HitType>(input, &sd, 0.0f)) : NULL;
+
+		bool again = doStatics ? (candidates ? doQueryVsCandidates(*candidates, pcb, input) : staticPruner->overlap(sd, pcb)) : true;
 		if(!again) // && (filterData.flags & PxQueryFlag::eANY_HIT))
 			return hits.hasAnyHits();
 		
@@ -893,7 +908,10 @@ bool SceneQueries::multiQuery(
 		const ShapeData sd(*input.geometry, *input.pose, input.inflation);
 		pcb.mQueryShapeBounds = &sd.getPrunerInflatedWorldAABB();
 		pcb.mShapeData = &sd;
-		bool again = doStatics ? staticPruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb) : true;
+
+		const QueryCandidateCache::Entry* candidates = candidateCache ? candidateCache->getStaticCandidates(cache->queryID, mSQManager, computeQueryBounds<HitType>(input, &sd, pcb.mShrunkDistance)) : NULL;
+
+		bool again = doStatics ? (candidates ? doQueryVsCandidates(*candidates, pcb, input) : staticPruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb)) : true;
 		if(!again)
 			return hits.hasAnyHits();
 		
@@ -1043,6 +1061,59 @@ static bool doQueryVsCached(const PrunerHandle handle, PxU32 prunerIndex, const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// World bounds of a query, for a given (possibly shrunk) max distance. Raycasts don't have shape data.
+template<typename HitType>
+static PxBounds3 computeQueryBounds(const MultiQueryInput& input, const ShapeData* sd, PxReal distance)
+{
+	if(HitTypeSupport<HitType>::IsRaycast)
+		return PxBounds3::boundsOfPoints(input.getOrigin(), input.getOrigin() + input.getDir() * distance);
+
+	PX_ASSERT(sd);
+	PxBounds3 bounds = sd->getPrunerInflatedWorldAABB();
+	if(HitTypeSupport<HitType>::IsSweep)
+	{
+		const PxVec3 offset = input.getDir() * distance;
+		bounds.include(bounds.minimum + offset);
+		bounds.include(bounds.maximum + offset);
+	}
+	return bounds;
+}
+
+// Runs the query against the static candidates of a candidate cache entry, instead of traversing the static pruner.
+// Like the pruners, we cull candidates against their bounds before calling the callback. For raycasts and sweeps the
+// query bounds are recomputed with the current shrunk distance.
+template<typename HitType>
+static bool doQueryVsCandidates(const QueryCandidateCache::Entry& candidates, MultiQueryCallback<HitType>& pcb, const MultiQueryInput& input)
+{
+	const PxU32 nbCandidates = candidates.mPayloads.size();
+	const PrunerPayload* payloads = candidates.mPayloads.begin();
+	const PxTransform* transforms = candidates.mTransforms.begin();
+	const PxBounds3* bounds = candidates.mBounds.begin();
+
+	const bool isOverlap = HitTypeSupport<HitType>::IsOverlap != 0;
+	PxBounds3 queryBounds = computeQueryBounds<HitType>(input, pcb.mShapeData, isOverlap ? 0.0f : pcb.mShrunkDistance);
+	PxReal queryDistance = pcb.mShrunkDistance;
+
+	for(PxU32 i=0;i<nbCandidates;i++)
+	{
+		if(!isOverlap && pcb.mShrunkDistance != queryDistance)
+		{
+			queryDistance = pcb.mShrunkDistance;
+			queryBounds = computeQueryBounds<HitType>(input, pcb.mShapeData, queryDistance);
+		}
+
+		if(!bounds[i].intersects(queryBounds))
+			continue;
+
+		PxReal dist = pcb.mShrunkDistance;
+		if(!pcb.template _invoke<false>(dist, i, payloads, transforms, NULL))
+			return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 SceneQueries::SceneQueries(	PVDCapture* pvd, PxU64 contextID, Pruner* staticPruner, Pruner* dynamicPruner,
 							PxU32 dynamicTreeRebuildRateHint, float inflation,
 							const PxSceneLimits& limits, const QueryAdapter& adapter) :
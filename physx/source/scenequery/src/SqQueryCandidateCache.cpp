@@ -0,0 +1,147 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// SQ-API LEVEL 2 (Level 1 = SqPruner.h)
+// This file is part of a "high-level" set of files within Sq. The SqPruner API doesn't rely on them.
+// This should really be at Np level but moving it to Sq allows us to share it.
+
+#include "SqQueryCandidateCache.h"
+#include "SqManager.h"
+#include "GuBounds.h"
+#include "geometry/PxBoxGeometry.h"
+
+using namespace physx;
+using namespace Sq;
+using namespace Gu;
+
+namespace
+{
+	// Captures the static objects touching the cached region, with the same bounds as in the pruner
+	struct GatherCallback : public PrunerOverlapCallback
+	{
+		GatherCallback(QueryCandidateCache::Entry& entry, const Adapter& adapter, float inflation) :
+			mEntry(entry), mAdapter(adapter), mInflation(inflation)	{}
+
+		virtual bool invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)	PX_OVERRIDE PX_FINAL
+		{
+			const PrunerPayload& payload = payloads[primIndex];
+			const PxTransform& transform = transforms[primIndex];
+
+			mEntry.mPayloads.pushBack(payload);
+			mEntry.mTransforms.pushBack(transform);
+			computeBounds(mEntry.mBounds.insert(), mAdapter.getGeometry(payload), transform, 0.0f, mInflation);
+			return true;
+		}
+
+		QueryCandidateCache::Entry&	mEntry;
+		const Adapter&				mAdapter;
+		const float					mInflation;
+
+		PX_NOCOPY(GatherCallback)
+	};
+}
+
+QueryCandidateCache::QueryCandidateCache(float inflation) : mInflation(inflation), mNbHits(0), mNbMisses(0)
+{
+}
+
+QueryCandidateCache::~QueryCandidateCache()
+{
+	invalidateAll();
+}
+
+void QueryCandidateCache::release()
+{
+	PX_DELETE_THIS;
+}
+
+void QueryCandidateCache::invalidate(PxU32 queryID)
+{
+	PxHashMap<PxU32, Entry*>::Entry removed;
+	if(mEntries.erase(queryID, removed))
+		PX_DELETE(removed.second);
+}
+
+void QueryCandidateCache::invalidateAll()
+{
+	for(PxHashMap<PxU32, Entry*>::Iterator iter = mEntries.getIterator(); !iter.done(); ++iter)
+		PX_DELETE(iter->second);
+	mEntries.clear();
+}
+
+const QueryCandidateCache::Entry* QueryCandidateCache::getStaticCandidates(PxU32 queryID, const PrunerManager& manager, const PxBounds3& queryBounds)
+{
+	// Unbounded queries (e.g. raycasts with an infinite max distance) would capture the whole static pruner
+	if(!queryBounds.isFinite())
+		return NULL;
+
+	const Pruner* staticPruner = manager.getPruner(PruningIndex::eSTATIC);
+	if(!staticPruner)
+		return NULL;
+
+	Entry* entry;
+	{
+		const PxHashMap<PxU32, Entry*>::Entry* e = mEntries.find(queryID);
+		if(e)
+		{
+			entry = e->second;
+		}
+		else
+		{
+			entry = PX_NEW(Entry);
+			mEntries.insert(queryID, entry);
+		}
+	}
+
+	// The static timestamp changes each time a static object is added, removed or moved. As long as it doesn't change,
+	// and as long as the query remains within the region we captured, the captured objects are exactly the static objects
+	// whose bounds can touch the query. Managers are identified by their unique ID rather than by address, since a new
+	// scene can be allocated where a released one was, with its timestamp back to the same value.
+	const PxU32 managerID = manager.getUniqueID();
+	const PxU32 timestamp = manager.getStaticTimestamp();
+	if(entry->mManagerID == managerID && entry->mTimestamp == timestamp && queryBounds.isInside(entry->mRegion))
+	{
+		mNbHits++;
+		return entry;
+	}
+	mNbMisses++;
+
+	entry->mRegion = queryBounds;
+	entry->mRegion.fattenFast(mInflation);
+	entry->mManagerID = managerID;
+	entry->mTimestamp = timestamp;
+	entry->mPayloads.clear();
+	entry->mTransforms.clear();
+	entry->mBounds.clear();
+
+	GatherCallback cb(*entry, manager.getAdapter(), manager.getInflation());
+	const ShapeData sd(PxBoxGeometry(entry->mRegion.getExtents()), PxTransform(entry->mRegion.getCenter()), 0.0f);
+	staticPruner->overlap(sd, cb);
+
+	return entry;
+}
@@ -41,6 +41,19 @@ namespace Sc
 {
 	class BodySim;
 
+	// Internal simulation state that is not exposed through the public API but which affects the
+	// next simulation steps (sleep filters, freeze counter, solver wake counter). Used by scene snapshots.
+	struct BodyInternalState
+	{
+		PxVec3	sleepLinVelAcc;
+		PxReal	freezeCount;
+		PxVec3	sleepAngVelAcc;
+		PxReal	accelScale;
+		PxReal	solverWakeCounter;
+		PxU8	isFastMoving;
+		PxU8	pad[3];
+	};
+
 	class BodyCore : public RigidCore
 	{
 	public:
@@ -177,6 +190,9 @@ namespace Sc
 		}
 
 						void				setFixedBaseLink(bool value);
+
+						void				getInternalState(BodyInternalState& state)	const;
+						void				setInternalState(const BodyInternalState& state);
 	private:
 						PX_ALIGN_PREFIX(16) PxsBodyCore mCore PX_ALIGN_SUFFIX(16);
 	};
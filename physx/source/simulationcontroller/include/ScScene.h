@@ -397,6 +397,9 @@ namespace Sc
 					void						setSimulationEventCallback(PxSimulationEventCallback* callback);
 					PxSimulationEventCallback*	getSimulationEventCallback() const;
 
+					void						setContactPairAggregateBuffers(const PxContactPairAggregateBuffers* buffers);
+	PX_FORCE_INLINE	PxU32						getNbContactPairAggregates()	const	{ return mNbContactPairAggregates;	}
+
 					void						setCCDContactModifyCallback(PxCCDContactModifyCallback* callback);
 					PxCCDContactModifyCallback*	getCCDContactModifyCallback() const;
 
@@ -431,6 +434,14 @@ namespace Sc
 					void						fireTriggerCallbacks();
 					void						fireQueuedContactCallbacks();
 					void						fireOnAdvanceCallback();
+					void						exportContactPairAggregates(PxBaseTask* continuation);
+
+		// Scene snapshots
+					bool						supportsContactCacheSnapshot()	const;
+					PxU32						getContactCacheSnapshotSize()	const;
+					void						saveContactCacheSnapshot(PxU8* buffer)	const;
+					bool						validateContactCacheSnapshot(const PxU8* buffer, PxU32 size)	const;
+					void						restoreContactCacheSnapshot(const PxU8* buffer, PxU32 size);
 
 					const PxArray<PxContactPairHeader>&
 												getQueuedContactPairHeaders();
@@ -804,6 +815,11 @@ namespace Sc
 
 						PxSimulationEventCallback*	mSimulationEventCallback;
 
+						PxContactPairAggregateBuffers	mContactPairAggregateBuffers;	// user buffers for the flat contact pair export, see PxScene::setContactPairAggregateBuffers()
+						PxArray<PxU32>					mContactPairAggregateOffsets;	// per contact report actor pair: index of its first shape pair in the export buffers
+						PxU32							mNbContactPairAggregates;
+						bool							mExportContactPairAggregates;
+
 					SimStats*					mStats;
 					PxU32						mInternalFlags;	// PT: combination of ::SceneInternalFlag, looks like only 2 bits are needed
 					PxSceneFlags				mPublicFlags;	// Copy of PxSceneDesc::flags, of type PxSceneFlag
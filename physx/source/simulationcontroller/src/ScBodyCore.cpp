@@ -547,6 +547,48 @@ void Sc::BodyCore::onOriginShift(const PxVec3& shift)
 		b->onOriginShift(shift, getFlags() & PxRigidBodyFlag::eKINEMATIC);  // BodySim might not exist if actor has simulation disabled (PxActorFlag::eDISABLE_SIMULATION)
 }
 
+void Sc::BodyCore::getInternalState(BodyInternalState& state) const
+{
+	state.solverWakeCounter = mCore.solverWakeCounter;
+	state.isFastMoving = mCore.isFastMoving;
+	state.pad[0] = state.pad[1] = state.pad[2] = 0;
+
+	const BodySim* sim = getSim();
+	if(sim)
+	{
+		const PxsRigidBody& llBody = sim->getLowLevelBody();
+		state.sleepLinVelAcc = llBody.mSleepLinVelAcc;
+		state.freezeCount = llBody.mFreezeCount;
+		state.sleepAngVelAcc = llBody.mSleepAngVelAcc;
+		state.accelScale = llBody.mAccelScale;
+	}
+	else
+	{
+		state.sleepLinVelAcc = PxVec3(0.0f);
+		state.freezeCount = 0.0f;
+		state.sleepAngVelAcc = PxVec3(0.0f);
+		state.accelScale = 1.0f;
+	}
+}
+
+void Sc::BodyCore::setInternalState(const BodyInternalState& state)
+{
+	mCore.solverWakeCounter = state.solverWakeCounter;
+	mCore.isFastMoving = state.isFastMoving;
+
+	BodySim* sim = getSim();
+	if(sim)
+	{
+		PxsRigidBody& llBody = sim->getLowLevelBody();
+		llBody.mSleepLinVelAcc = state.sleepLinVelAcc;
+		llBody.mFreezeCount = state.freezeCount;
+		llBody.mSleepAngVelAcc = state.sleepAngVelAcc;
+		llBody.mAccelScale = state.accelScale;
+
+		sim->getScene().updateBodySim(*sim);
+	}
+}
+
 // PT: TODO: why do we test against NULL everywhere but not in 'isFrozen' ?
 PxIntBool Sc::BodyCore::isFrozen() const
 {
@@ -2528,6 +2528,9 @@ void Sc::Scene::postSolver(PxBaseTask* /*continuation*/)
 
 #if PX_ENABLE_SIM_STATS
 	mLLContext->getSimStats().mPeakConstraintBlockAllocations = blockPool.getPeakConstraintBlockCount();
+	mLLContext->getSimStats().mNbDataBlockLockContentions = blockPool.getNbLockContentions();
+	mLLContext->getSimStats().mNbDataBlockReservoirRefills = blockPool.getNbReservoirRefills();
+	blockPool.resetLockStats();
 #else
 	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 #endif
@@ -2766,7 +2769,7 @@ void Sc::Scene::fireOnAdvanceCallback()
 	}
 }
 
-void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
+void Sc::Scene::finalizationPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sim.sceneFinalization", mContextId);
 
@@ -2802,6 +2805,8 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 
 	mTaskPool.clear();
 
+	exportContactPairAggregates(continuation);	// After the CCD passes and the solver, so that the contact report streams are complete
+
 	mReportShapePairTimeStamp++;	// important to do this before fetchResults() is called to make sure that delayed deleted actors/shapes get
 									// separate pair entries in contact reports
 
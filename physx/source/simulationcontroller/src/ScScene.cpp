@@ -654,6 +654,9 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mClientPosePreviewBodies		("clientPosePreviewBodies"),
 	mClientPosePreviewBuffer		("clientPosePreviewBuffer"),
 	mSimulationEventCallback		(NULL),
+	mContactPairAggregateOffsets	("contactPairAggregateOffsets"),
+	mNbContactPairAggregates		(0),
+	mExportContactPairAggregates	(false),
 	mInternalFlags					(SceneInternalFlag::eSCENE_DEFAULT),
 	mPublicFlags					(desc.flags),
 	mAnchorCore						(PxTransform(PxIdentity)),
@@ -1665,6 +1668,22 @@ PxSimulationEventCallback* Sc::Scene::getSimulationEventCallback() const
 	return mSimulationEventCallback;
 }
 
+void Sc::Scene::setContactPairAggregateBuffers(const PxContactPairAggregateBuffers* buffers)
+{
+	if(buffers)
+	{
+		mContactPairAggregateBuffers = *buffers;
+		mExportContactPairAggregates = true;
+	}
+	else
+	{
+		mContactPairAggregateBuffers = PxContactPairAggregateBuffers();
+		mExportContactPairAggregates = false;
+		mContactPairAggregateOffsets.reset();
+	}
+	mNbContactPairAggregates = 0;
+}
+
 void Sc::Scene::removeBody(BodySim& body)	//this also notifies any connected joints!
 {
 	BodyCore& core = body.getBodyCore();
@@ -2030,6 +2049,379 @@ void Sc::Scene::fireQueuedContactCallbacks()
 	}
 }
 
+namespace
+{
+	// Reduces the contact stream of a reported shape pair to the aggregate record of PxContactPairAggregateBuffers.
+	// The decoding mirrors PxContactPair::extractContacts().
+	static void writeContactPairAggregate(const PxContactPairAggregateBuffers& dst, PxU32 index, PxActor* actor0, PxActor* actor1, const PxContactPair& pair, const PxsMaterialManager& materialManager)
+	{
+		if(dst.actors0)
+			dst.actors0[index] = actor0;
+		if(dst.actors1)
+			dst.actors1[index] = actor1;
+		if(dst.shapes0)
+			dst.shapes0[index] = pair.shapes[0];
+		if(dst.shapes1)
+			dst.shapes1[index] = pair.shapes[1];
+		if(dst.events)
+			dst.events[index] = pair.events;
+		if(dst.flags)
+			dst.flags[index] = pair.flags;
+
+		PxVec3 totalImpulse(0.0f);
+		PxVec3 pointSum(0.0f);
+		PxVec3 normalSum(0.0f);
+		PxReal maxImpulse = 0.0f;
+		PxU32 nbContacts = 0;
+		PxU16 materialIndex0 = PX_INVALID_U16;
+		PxU16 materialIndex1 = PX_INVALID_U16;
+
+		if(pair.contactCount)
+		{
+			PxContactStreamIterator iter(pair.contactPatches, pair.contactPoints, pair.getInternalFaceIndices(), pair.patchCount, pair.contactCount);
+
+			const PxReal* impulses = pair.contactImpulses;
+
+			const bool flippedContacts = pair.flags & PxContactPairFlag::eINTERNAL_CONTACTS_ARE_FLIPPED;
+			const bool hasImpulses = pair.flags & PxContactPairFlag::eINTERNAL_HAS_IMPULSES;
+
+			PxReal bestPatchImpulse = -1.0f;
+			while(iter.hasNextPatch())
+			{
+				iter.nextPatch();
+
+				PxReal patchImpulse = 0.0f;
+				while(iter.hasNextContact())
+				{
+					iter.nextContact();
+
+					const PxVec3& normal = iter.getContactNormal();
+					pointSum += iter.getContactPoint();
+					normalSum += normal;
+
+					if(hasImpulses)
+					{
+						const PxReal impulse = impulses[nbContacts];
+						totalImpulse += normal * impulse;
+						maxImpulse = PxMax(maxImpulse, PxAbs(impulse));
+						patchImpulse += impulse;
+					}
+					nbContacts++;
+				}
+
+				// The first patch always wins when there are no impulses
+				if(patchImpulse > bestPatchImpulse)
+				{
+					bestPatchImpulse = patchImpulse;
+					materialIndex0 = iter.getMaterialIndex0();
+					materialIndex1 = iter.getMaterialIndex1();
+					if(flippedContacts)
+						PxSwap(materialIndex0, materialIndex1);
+				}
+			}
+		}
+
+		if(dst.nbContacts)
+			dst.nbContacts[index] = nbContacts;
+		if(dst.totalImpulses)
+			dst.totalImpulses[index] = totalImpulse;
+		if(dst.maxImpulses)
+			dst.maxImpulses[index] = maxImpulse;
+		if(dst.averagePoints)
+			dst.averagePoints[index] = nbContacts ? pointSum / PxReal(nbContacts) : PxVec3(0.0f);
+		if(dst.averageNormals)
+		{
+			normalSum.normalizeSafe();
+			dst.averageNormals[index] = normalSum;
+		}
+		if(dst.materials0)
+		{
+			const PxsMaterialCore* material = materialIndex0 != PX_INVALID_U16 ? materialManager.getMaterial(materialIndex0) : NULL;
+			dst.materials0[index] = material ? material->mMaterial : NULL;
+		}
+		if(dst.materials1)
+		{
+			const PxsMaterialCore* material = materialIndex1 != PX_INVALID_U16 ? materialManager.getMaterial(materialIndex1) : NULL;
+			dst.materials1[index] = material ? material->mMaterial : NULL;
+		}
+	}
+
+	class ScContactPairAggregateTask : public Cm::Task
+	{
+	public:
+		ScContactPairAggregateTask(const Sc::Scene& scene, const PxContactPairAggregateBuffers& buffers, ActorPairReport*const* actorPairs, PxU32 nbActorPairs, const PxU32* offsets, PxU64 contextID) :
+			Cm::Task		(contextID),
+			mScene			(scene),
+			mBuffers		(buffers),
+			mActorPairs		(actorPairs),
+			mNbActorPairs	(nbActorPairs),
+			mOffsets		(offsets)
+		{
+		}
+
+		virtual void runInternal()
+		{
+			PX_PROFILE_ZONE("Sim.exportContactPairAggregates", mContextID);
+
+			const PxsMaterialManager& materialManager = mScene.getMaterialManager();
+			NPhaseCore* nphaseCore = mScene.getNPhaseCore();
+
+			for(PxU32 i=0; i<mNbActorPairs; i++)
+			{
+				const PxU32 start = mOffsets[i];
+				const PxU32 nbPairs = mOffsets[i+1] - start;
+				if(!nbPairs)
+					continue;
+
+				const ActorPairReport& aPair = *mActorPairs[i];
+				const ContactStreamManager& cs = aPair.getContactStreamManager();
+				const PxContactPair* pairs = reinterpret_cast<const PxContactPair*>(cs.getShapePairs(nphaseCore->getContactReportPairData(cs.bufferIndex)));
+
+				PxActor* actor0 = aPair.getPxActorA();
+				PxActor* actor1 = aPair.getPxActorB();
+				for(PxU32 j=0; j<nbPairs; j++)
+					writeContactPairAggregate(mBuffers, start + j, actor0, actor1, pairs[j], materialManager);
+			}
+		}
+
+		virtual const char* getName() const
+		{
+			return "ScScene.exportContactPairAggregates";
+		}
+
+	private:
+		const Sc::Scene&						mScene;
+		const PxContactPairAggregateBuffers&	mBuffers;
+		ActorPairReport*const*					mActorPairs;
+		const PxU32								mNbActorPairs;
+		const PxU32*							mOffsets;
+
+		PX_NOCOPY(ScContactPairAggregateTask)
+	};
+}
+
+/*
+Threading: called from the finalization phase, after the solver and all CCD passes have written to the contact report streams
+*/
+void Sc::Scene::exportContactPairAggregates(PxBaseTask* continuation)
+{
+	mNbContactPairAggregates = 0;
+	if(!mExportContactPairAggregates)
+		return;
+
+	PX_PROFILE_ZONE("Sim.exportContactPairAggregates", mContextId);
+
+	ActorPairReport*const* actorPairs = mNPhaseCore->getContactReportActorPairs();
+	const PxU32 nbActorPairs = mNPhaseCore->getNbContactReportActorPairs();
+	if(!nbActorPairs)
+		return;
+
+	// Serial prefix sum over the actor pairs, so that the tasks can write their shape pairs without synchronization.
+	// Pairs that do not fit in the user buffers are dropped here.
+	mContactPairAggregateOffsets.resizeUninitialized(nbActorPairs + 1);
+	PxU32* offsets = mContactPairAggregateOffsets.begin();
+
+	const PxU32 maxNbPairs = mContactPairAggregateBuffers.maxNbPairs;
+	PxU32 nbPairs = 0;
+	PxU32 nbDropped = 0;
+	for(PxU32 i=0; i<nbActorPairs; i++)
+	{
+		offsets[i] = nbPairs;
+
+		const ContactStreamManager& cs = actorPairs[i]->getContactStreamManager();
+		if(cs.getFlags() & ContactStreamManagerFlag::eINVALID_STREAM)
+			continue;
+
+		const PxU32 nbShapePairs = cs.currentPairCount;
+		const PxU32 nbFitting = PxMin(nbShapePairs, maxNbPairs - nbPairs);
+		nbPairs += nbFitting;
+		nbDropped += nbShapePairs - nbFitting;
+	}
+	offsets[nbActorPairs] = nbPairs;
+	mNbContactPairAggregates = nbPairs;
+
+	if(nbDropped)
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxContactPairAggregateBuffers: buffers too small, %u contact pairs have been dropped.", nbDropped);
+
+	// PT: TASK-CREATION TAG
+	const PxU32 nbPairsPerTask = 256;
+	Cm::FlushPool& flushPool = mLLContext->getTaskPool();
+
+	PxU32 first = 0;
+	while(first < nbActorPairs)
+	{
+		PxU32 last = first + 1;
+		while(last < nbActorPairs && offsets[last] - offsets[first] < nbPairsPerTask)
+			last++;
+
+		if(continuation)
+		{
+			ScContactPairAggregateTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(ScContactPairAggregateTask)), ScContactPairAggregateTask(*this, mContactPairAggregateBuffers, actorPairs + first, last - first, offsets + first, mContextId));
+			startTask(task, continuation);
+		}
+		else
+		{
+			ScContactPairAggregateTask task(*this, mContactPairAggregateBuffers, actorPairs + first, last - first, offsets + first, mContextId);
+			task.runInternal();
+		}
+		first = last;
+	}
+}
+
+namespace
+{
+	// Record of a contact cache in a scene snapshot. Followed by stateSize bytes of narrow phase state.
+	struct ContactCacheRecord
+	{
+		PxU32	shapeID0;
+		PxU32	shapeID1;
+		PxU32	stateSize;
+		PxU32	pad;
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(ContactCacheRecord) == 16);
+
+	PX_FORCE_INLINE PxU64 getContactCacheKey(PxU32 shapeID0, PxU32 shapeID1)
+	{
+		return (PxU64(shapeID0)<<32) | PxU64(shapeID1);
+	}
+}
+
+// The contact caches live in the CPU narrow phase context. With GPU narrow phase the "fallback" context only
+// handles a subset of the pairs and the GPU caches are not accessible, so snapshots do not support them.
+static PxvNphaseImplementationFallback* getSnapshotNphaseContext(PxsContext* llContext)
+{
+	if(llContext->getNphaseFallbackImplementationContext())
+		return NULL;
+	return static_cast<PxvNphaseImplementationFallback*>(llContext->getNphaseImplementationContext());
+}
+
+bool Sc::Scene::supportsContactCacheSnapshot() const
+{
+	return getSnapshotNphaseContext(mLLContext) != NULL;
+}
+
+PxU32 Sc::Scene::getContactCacheSnapshotSize() const
+{
+	const PxvNphaseImplementationFallback* context = getSnapshotNphaseContext(mLLContext);
+	if(!context)
+		return 0;
+
+	const PxU32 nbInteractions = getNbInteractions(InteractionType::eOVERLAP);
+	const ElementSimInteraction*const* interactions = mInteractions[InteractionType::eOVERLAP].begin();
+
+	PxU32 size = 0;
+	for(PxU32 i=0; i<nbInteractions; i++)
+	{
+		const ShapeInteraction* si = static_cast<const ShapeInteraction*>(interactions[i]);
+		const PxsContactManager* cm = si->getContactManager();
+		if(cm)
+			size += sizeof(ContactCacheRecord) + context->getContactManagerStateSize(*cm);
+	}
+	return size;
+}
+
+void Sc::Scene::saveContactCacheSnapshot(PxU8* buffer) const
+{
+	const PxvNphaseImplementationFallback* context = getSnapshotNphaseContext(mLLContext);
+	if(!context)
+		return;
+
+	const PxU32 nbInteractions = getNbInteractions(InteractionType::eOVERLAP);
+	const ElementSimInteraction*const* interactions = mInteractions[InteractionType::eOVERLAP].begin();
+
+	for(PxU32 i=0; i<nbInteractions; i++)
+	{
+		const ShapeInteraction* si = static_cast<const ShapeInteraction*>(interactions[i]);
+		const PxsContactManager* cm = si->getContactManager();
+		if(!cm)
+			continue;
+
+		ContactCacheRecord record;
+		record.shapeID0		= si->getShape0().getElementID();
+		record.shapeID1		= si->getShape1().getElementID();
+		record.stateSize	= context->getContactManagerStateSize(*cm);
+		record.pad			= 0;
+		PxMemCopy(buffer, &record, sizeof(ContactCacheRecord));
+		buffer += sizeof(ContactCacheRecord);
+
+		context->saveContactManagerState(*cm, buffer);
+		buffer += record.stateSize;
+	}
+}
+
+/*
+Checks that the contact caches of a snapshot can be restored, without modifying anything.
+*/
+bool Sc::Scene::validateContactCacheSnapshot(const PxU8* buffer, PxU32 size) const
+{
+	const PxvNphaseImplementationFallback* context = getSnapshotNphaseContext(mLLContext);
+	if(!context)
+		return false;
+
+	PxU32 offset = 0;
+	while(offset < size)
+	{
+		if(size - offset < sizeof(ContactCacheRecord))
+			return false;
+
+		ContactCacheRecord record;
+		PxMemCopy(&record, buffer + offset, sizeof(ContactCacheRecord));
+		offset += sizeof(ContactCacheRecord);
+
+		if(size - offset < record.stateSize || !context->isValidContactManagerState(buffer + offset, record.stateSize))
+			return false;
+		offset += record.stateSize;
+	}
+	return true;
+}
+
+/*
+Restores the contact caches of the pairs that existed when the snapshot was taken. Other pairs get their caches
+reset, as if they were new. Must be called after the poses have been restored, since setting a pose resets the caches.
+The snapshot must have been validated with validateContactCacheSnapshot().
+*/
+void Sc::Scene::restoreContactCacheSnapshot(const PxU8* buffer, PxU32 size)
+{
+	PX_ASSERT(validateContactCacheSnapshot(buffer, size));
+	PxvNphaseImplementationFallback* context = getSnapshotNphaseContext(mLLContext);
+
+	PxHashMap<PxU64, const PxU8*> states;
+	PxU32 totalStateSize = 0;
+	{
+		const PxU8* current = buffer;
+		const PxU8* end = buffer + size;
+		while(current < end)
+		{
+			ContactCacheRecord record;
+			PxMemCopy(&record, current, sizeof(ContactCacheRecord));
+			current += sizeof(ContactCacheRecord);
+
+			states.insert(getContactCacheKey(record.shapeID0, record.shapeID1), current);
+			current += record.stateSize;
+			totalStateSize += record.stateSize;
+		}
+	}
+
+	context->reserveContactManagerStates(totalStateSize);
+
+	const PxU32 nbInteractions = getNbInteractions(InteractionType::eOVERLAP);
+	ElementSimInteraction** interactions = getInteractions(InteractionType::eOVERLAP);
+
+	for(PxU32 i=0; i<nbInteractions; i++)
+	{
+		ShapeInteraction* si = static_cast<ShapeInteraction*>(interactions[i]);
+		PxsContactManager* cm = si->getContactManager();
+		if(!cm)
+			continue;
+
+		const PxHashMap<PxU64, const PxU8*>::Entry* entry = states.find(getContactCacheKey(si->getShape0().getElementID(), si->getShape1().getElementID()));
+		if(entry)
+			context->restoreContactManagerState(*cm, entry->second);
+		else
+			si->resetManagerCachedState();
+	}
+}
+
 PX_FORCE_INLINE void markDeletedShapes(Sc::ObjectIDTracker& idTracker, Sc::TriggerPairExtraData& tped, PxTriggerPair& pair)
 {
 	PxTriggerPairFlags::InternalType flags = 0;
@@ -132,6 +132,8 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.nbNewTouches = simStats.mNbNewTouches;
 	s.nbLostTouches = simStats.mNbLostTouches;
 	s.nbPartitions = simStats.mNbPartitions;
+	s.nbDataBlockLockContentions = simStats.mNbDataBlockLockContentions;
+	s.nbDataBlockReservoirRefills = simStats.mNbDataBlockReservoirRefills;
 
 	s.gpuDynamicsMemoryConfigStatistics.tempBufferCapacity = simStats.mGpuDynamicsTempBufferCapacity;
 	s.gpuDynamicsMemoryConfigStatistics.rigidContactCount = simStats.mGpuDynamicsRigidContactCount;
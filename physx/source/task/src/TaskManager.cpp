@@ -33,6 +33,8 @@
 #include "foundation/PxArray.h"
 
 #include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxIntrinsics.h"
 
 #define LOCK()  PxMutex::ScopedLock _lock_(mMutex)
 
@@ -51,7 +53,7 @@ namespace physx
 	class PxTaskTableRow
 	{
 	public:
-		PxTaskTableRow() : mRefCount( 1 ), mStartDep(EOL), mLastDep(EOL) {}
+		PxTaskTableRow() : mRefCount( 1 ), mDispatched( 0 ), mStartDep(EOL), mLastDep(EOL) {}
 		void addDependency( PxTaskDepTable& depTable, PxTaskID taskID )
 		{
 			int newDep = int(depTable.size());
@@ -73,6 +75,7 @@ namespace physx
 
 		PxTask *    mTask;
 		volatile int mRefCount;
+		volatile PxI32 mDispatched;	// only used by frozen task graphs, see PxTaskMgr::dispatchTask
 		PxTaskType::Enum mType;
 		int       mStartDep;
 		int       mLastDep;
@@ -108,8 +111,17 @@ public:
 	PxTaskID  submitUnnamedTask( PxTask& task, PxTaskType::Enum type = PxTaskType::eCPU );
 	PxTask*   getTaskFromID( PxTaskID );
 
+	void	freezeDependencies();
+	bool	isFrozen() const	{ return mFrozen;	}
+	PxU32	getSuccessors( PxTaskID taskID, const PxTaskID*& successors ) const;
+
+	void	setTimingCallback( PxTaskTimingCallback* callback )	{ mTimingCallback = callback;	}
+	PxTaskTimingCallback*	getTimingCallback() const	{ return mTimingCallback;	}
+
 	void    dispatchTask( PxTaskID taskID );
 	void    resolveRow( PxTaskID taskID );
+	void    resolveRowFrozen( PxTaskID taskID );
+	bool    checkNotFrozen( const char* function ) const;
 
 	void    release();
 
@@ -133,6 +145,13 @@ public:
 	PxTaskTable			mTaskTable;
 
 	PxArray<PxTaskID>	mStartDispatch;
+
+	// Frozen task graph: successors of task i are mSuccessors[mSuccessorStart[i]..mSuccessorStart[i+1]-1]
+	PxArray<PxU32>		mSuccessorStart;
+	PxArray<PxTaskID>	mSuccessors;
+	bool				mFrozen;
+
+	PxTaskTimingCallback*	mTimingCallback;
 	};
 
 PxTaskManager* PxTaskManager::createTaskManager(PxErrorCallback& errorCallback, PxCpuDispatcher* cpuDispatcher)
@@ -147,6 +166,10 @@ PxTaskMgr::PxTaskMgr(PxErrorCallback& errorCallback, PxCpuDispatcher* cpuDispatc
 	, mDepTable("PxTaskDepTable")
 	, mTaskTable("PxTaskTable")
 	, mStartDispatch("StartDispatch")
+	, mSuccessorStart("PxTaskSuccessorStart")
+	, mSuccessors("PxTaskSuccessors")
+	, mFrozen(false)
+	, mTimingCallback(NULL)
 {
 }
 
@@ -193,9 +216,62 @@ void PxTaskMgr::resetDependencies()
     mTaskTable.clear();
     mDepTable.clear();
     mName2IDmap.clear();
+    mSuccessorStart.clear();
+    mSuccessors.clear();
+    mFrozen = false;
     mPendingTasks = 0;
 }
 
+/*
+ * Called by the owner once the task graph is complete. Flattens the
+ * dependency lists into successor arrays, after which dependencies are
+ * resolved without taking the lock.
+ */
+void PxTaskMgr::freezeDependencies()
+{
+	LOCK();
+	if( mFrozen )
+		return;
+
+	const PxU32 nbTasks = mTaskTable.size();
+	mSuccessorStart.resize( nbTasks + 1 );
+	mSuccessors.reserve( mDepTable.size() );
+	mSuccessors.forceSize_Unsafe( 0 );
+	for( PxTaskID i = 0 ; i < nbTasks ; i++ )
+	{
+		mSuccessorStart[ i ] = mSuccessors.size();
+		for( int depRow = mTaskTable[ i ].mStartDep ; depRow != EOL ; depRow = mDepTable[ uint32_t(depRow) ].mNextDep )
+			mSuccessors.pushBack( mDepTable[ uint32_t(depRow) ].mTaskID );
+	}
+	mSuccessorStart[ nbTasks ] = mSuccessors.size();
+
+	// The successor arrays must be visible to all threads before any task is dispatched
+	PxMemoryBarrier();
+	mFrozen = true;
+}
+
+PxU32 PxTaskMgr::getSuccessors( PxTaskID taskID, const PxTaskID*& successors ) const
+{
+	if( !mFrozen || taskID >= mTaskTable.size() )
+	{
+		successors = NULL;
+		return 0;
+	}
+	const PxU32 start = mSuccessorStart[ taskID ];
+	successors = mSuccessors.begin() + start;
+	return mSuccessorStart[ taskID + 1 ] - start;
+}
+
+bool PxTaskMgr::checkNotFrozen( const char* function ) const
+{
+	if( mFrozen )
+	{
+		mErrorCallback.reportError( PxErrorCode::eINVALID_OPERATION, function, PX_FL );
+		return false;
+	}
+	return true;
+}
+
 /* 
  * Called by the owner (Scene) to start simulating the task graph.
  * Dispatch all tasks with refCount == 1
@@ -234,6 +310,17 @@ void PxTaskMgr::stopSimulation()
 PxTaskID PxTaskMgr::getNamedTask( const char *name )
 {
 	const PxTaskNameToIDMap::Entry *ret;
+	if( mFrozen )
+	{
+		/* The name map is read-only once frozen */
+		ret = mName2IDmap.find( name );
+		if( ret )
+			return ret->second;
+
+		checkNotFrozen( "PxTaskManager::getNamedTask(): unknown task name, the task graph is frozen." );
+		return PX_INVALID_TASK_ID;
+	}
+
     {
         LOCK();
 		ret = mName2IDmap.find( name );
@@ -251,6 +338,9 @@ PxTaskID PxTaskMgr::getNamedTask( const char *name )
 
 PxTask* PxTaskMgr::getTaskFromID( PxTaskID id )
 {
+	if( mFrozen )
+		return mTaskTable[ id ].mTask;
+
 	LOCK(); // todo: reader lock necessary?
 	return mTaskTable[ id ].mTask;
 }
@@ -258,6 +348,9 @@ PxTask* PxTaskMgr::getTaskFromID( PxTaskID id )
 /* If called at runtime, must be thread-safe */
 PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType::Enum type )
 {
+	if( !checkNotFrozen( "PxTaskManager::submitNamedTask(): the task graph is frozen." ) )
+		return PX_INVALID_TASK_ID;
+
     if( task )
     {
         task->mTm = this;
@@ -303,6 +396,9 @@ PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType:
  */
 PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
 {
+	if( !checkNotFrozen( "PxTaskManager::submitUnnamedTask(): the task graph is frozen." ) )
+		return PX_INVALID_TASK_ID;
+
     PxAtomicIncrement(&mPendingTasks);
 
 	task.mTm = this;
@@ -324,6 +420,15 @@ PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
  */
 void PxTaskMgr::taskCompleted( PxTask& task )
 {
+	if( mTimingCallback )
+		mTimingCallback->taskCompleted( task, PxTime::getCurrentCounterValue() );
+
+	if( mFrozen )
+	{
+		resolveRowFrozen( task.mTaskID );
+		return;
+	}
+
     LOCK();
 	resolveRow(task.mTaskID);
 }
@@ -336,6 +441,9 @@ void PxTaskMgr::taskCompleted( PxTask& task )
  */
 void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
 {
+	if( !checkNotFrozen( "PxTask::finishBefore(): the task graph is frozen." ) )
+		return;
+
     LOCK();
 	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
 
@@ -349,6 +457,9 @@ void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
  */
 void PxTaskMgr::startAfter( PxTask& task, PxTaskID taskID )
 {
+	if( !checkNotFrozen( "PxTask::startAfter(): the task graph is frozen." ) )
+		return;
+
     LOCK();
 	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
 
@@ -358,6 +469,12 @@ void PxTaskMgr::startAfter( PxTask& task, PxTaskID taskID )
 
 void PxTaskMgr::addReference( PxTaskID taskID )
 {
+	if( mFrozen )
+	{
+		PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
+		return;
+	}
+
     LOCK();
     PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
 }
@@ -367,6 +484,13 @@ void PxTaskMgr::addReference( PxTaskID taskID )
  */
 void PxTaskMgr::decrReference( PxTaskID taskID )
 {
+	if( mFrozen )
+	{
+		if( !PxAtomicDecrement( &mTaskTable[ taskID ].mRefCount ) )
+			dispatchTask( taskID );
+		return;
+	}
+
     LOCK();
 
     if( !PxAtomicDecrement( &mTaskTable[ taskID ].mRefCount ) )
@@ -405,11 +529,61 @@ void PxTaskMgr::resolveRow( PxTaskID taskID )
     PxAtomicDecrement( &mPendingTasks );
 }
 
+/*
+ * Same as resolveRow() for frozen task graphs. The successor arrays are
+ * read-only and the ref counts are atomic, so no lock is needed.
+ */
+void PxTaskMgr::resolveRowFrozen( PxTaskID taskID )
+{
+	const PxU32 start = mSuccessorStart[ taskID ];
+	const PxU32 end = mSuccessorStart[ taskID + 1 ];
+	for( PxU32 i = start ; i < end ; i++ )
+	{
+		const PxTaskID successor = mSuccessors[ i ];
+		if( !PxAtomicDecrement( &mTaskTable[ successor ].mRefCount ) )
+		{
+			dispatchTask( successor );
+		}
+	}
+
+	PxAtomicDecrement( &mPendingTasks );
+}
+
 /*
  * Submit a ready task to its appropriate dispatcher.
  */
 void PxTaskMgr::dispatchTask( PxTaskID taskID )
 {
+	if( mFrozen )
+	{
+		PxTaskTableRow& tt = mTaskTable[ taskID ];
+
+		// prevent re-submission, only one thread can win the exchange
+		if( PxAtomicExchange( &tt.mDispatched, 1 ) )
+		{
+			mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "PxTask dispatched twice", PX_FL);
+			return;
+		}
+
+		const PxTaskType::Enum type = tt.mType;
+		// mark the task completed before submitting it, it might complete and be released immediately
+		tt.mType = PxTaskType::eCOMPLETED;
+		if( type == PxTaskType::eCPU )
+		{
+			if( mTimingCallback )
+				mTimingCallback->taskReady( *tt.mTask, PxTime::getCurrentCounterValue() );
+			mCpuDispatcher->submitTask( *tt.mTask );
+		}
+		else
+		{
+			if( type != PxTaskType::eNOT_PRESENT )
+				mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "Unknown task type", PX_FL);
+			/* No task registered with this taskID, resolve its dependencies */
+			resolveRowFrozen( taskID );
+		}
+		return;
+	}
+
 	LOCK(); // todo: reader lock necessary?
     PxTaskTableRow& tt = mTaskTable[ taskID ];
 
@@ -423,6 +597,8 @@ void PxTaskMgr::dispatchTask( PxTaskID taskID )
     switch ( tt.mType )
     {
     case PxTaskType::eCPU:
+		if( mTimingCallback )
+			mTimingCallback->taskReady( *tt.mTask, PxTime::getCurrentCounterValue() );
         mCpuDispatcher->submitTask( *tt.mTask );
         break;
     case PxTaskType::eNOT_PRESENT: